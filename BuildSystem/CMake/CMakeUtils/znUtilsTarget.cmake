@@ -49,4 +49,33 @@ function(zenith_apply_coverage target)
 		target_link_options(${target} PRIVATE ${ZENITH_COVERAGE_LINK_FLAGS})
 		message(STATUS "Applied coverage to: ${target}")
 	endif()
-endfunction()
\ No newline at end of file
+endfunction()
+# Cooks a project's asset registry into a .zpak with Zenith-AssetPacker
+function(zenith_add_asset_pack target project_file output)
+	get_filename_component(output_dir ${output} DIRECTORY)
+
+	add_custom_target(${target}
+			COMMAND ${CMAKE_COMMAND} -E make_directory ${output_dir}
+			COMMAND Zenith-AssetPacker --project ${CMAKE_SOURCE_DIR}/${project_file} --output ${output}
+			DEPENDS Zenith-AssetPacker
+			WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+			COMMENT "Packing ${project_file} into ${output}"
+			VERBATIM
+	)
+endfunction()
+
+# Compiles the shaders in the given directories, relative to the runtime target's directory, into a .zsp next to the runtime target
+function(zenith_add_shader_pack target runtime_target output)
+	set(shader_dirs)
+	foreach(dir ${ARGN})
+		list(APPEND shader_dirs --shaders ${dir})
+	endforeach()
+
+	add_custom_target(${target}
+			COMMAND Zenith-ShaderPacker ${shader_dirs} --output ${output}
+			DEPENDS Zenith-ShaderPacker ${runtime_target}
+			WORKING_DIRECTORY $<TARGET_FILE_DIR:${runtime_target}>
+			COMMENT "Compiling shaders into ${output}"
+			VERBATIM
+	)
+endfunction()
@@ -1,51 +1,148 @@
 #version 450 core
 #pragma stage : vert
 
-layout(push_constant) uniform PushConstants {
-	mat4 u_Model;
+#include <Bindless.glslh>
+
+struct DrawInstance
+{
+	mat4 Model;
+	mat4 NormalMatrix;
+	vec4 DequantizeScale;  // xyz, positions are offset + position * scale
+	vec4 DequantizeOffset; // xyz
+};
+
+// Written by the renderer into the frame's transient buffer. Indirect draws pick their instance with the first
+// instance of their command, direct draws come with a single one.
+layout(std430, set = 2, binding = 1) readonly buffer DrawData {
 	mat4 u_ViewProjection;
-	mat4 u_NormalMatrix;
-	vec4 u_CameraPosition;
-} pc;
+	vec4 u_CameraPosition; // w: 1 when normal/tangent are packed (VertexFormat::Compact*)
+	DrawInstance u_Draws[];
+};
 
+// Standard vertices provide float3 attributes. Packed vertices provide octahedral SNORM16 normal/tangent (xy)
+// with the bitangent sign folded into the tangent, half texcoords and optionally UNORM16 positions relative to the
+// submesh bounds.
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec3 a_Normal;
 layout(location = 2) in vec3 a_Tangent;
-layout(location = 3) in vec3 a_Binormal;
-layout(location = 4) in vec2 a_TexCoord;
+layout(location = 3) in vec2 a_TexCoord;
 
 layout(location = 0) out vec3 v_WorldPosition;
 layout(location = 1) out vec3 v_Normal;
+layout(location = 2) out vec3 v_Tangent;
+layout(location = 3) out vec3 v_Binormal;
+layout(location = 4) out vec2 v_TexCoord;
+
+#if __ZN_BINDLESS
+// Pushed by the renderer for every draw, the material parameters are in u_Materials
+layout(push_constant) uniform BindlessDraw {
+	uint u_MaterialIndex;
+} u_Renderer;
+
+layout(location = 5) flat out uint v_MaterialIndex;
+#endif
+
+vec3 DecodeOctahedral(vec2 e)
+{
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+	return normalize(n);
+}
+
+// xyz = tangent, w = bitangent sign
+vec4 DecodeTangent(vec2 e)
+{
+	float bitangentSign = e.y >= 0.0 ? 1.0 : -1.0;
+	vec2 octahedral = vec2(e.x, (abs(e.y) - 0.5) * 4.0 - 1.0);
+	return vec4(DecodeOctahedral(clamp(octahedral, -1.0, 1.0)), bitangentSign);
+}
 
 void main()
 {
-	vec4 worldPosition = pc.u_Model * vec4(a_Position, 1.0);
+	DrawInstance draw = u_Draws[gl_InstanceIndex];
+
+	vec3 normal = a_Normal;
+	vec4 tangent = vec4(a_Tangent, 1.0); // Standard vertices are assumed right-handed
+	if (u_CameraPosition.w > 0.5)
+	{
+		normal = DecodeOctahedral(a_Normal.xy);
+		tangent = DecodeTangent(a_Tangent.xy);
+	}
+
+	vec3 position = draw.DequantizeOffset.xyz + a_Position * draw.DequantizeScale.xyz;
+	vec4 worldPosition = draw.Model * vec4(position, 1.0);
 	v_WorldPosition = worldPosition.xyz;
 
-	gl_Position = pc.u_ViewProjection * worldPosition;
+	gl_Position = u_ViewProjection * worldPosition;
 	gl_Position.y = -gl_Position.y;
 
-	v_Normal = normalize((pc.u_NormalMatrix * vec4(a_Normal, 0.0)).xyz);
+	v_Normal = normalize((draw.NormalMatrix * vec4(normal, 0.0)).xyz);
+	// Tangents are surface directions, they go through the model matrix and are kept perpendicular to the normal
+	vec3 worldTangent = mat3(draw.Model) * tangent.xyz;
+	v_Tangent = normalize(worldTangent - v_Normal * dot(v_Normal, worldTangent));
+	v_Binormal = cross(v_Normal, v_Tangent) * tangent.w;
+	v_TexCoord = a_TexCoord;
+
+#if __ZN_BINDLESS
+	v_MaterialIndex = u_Renderer.u_MaterialIndex;
+#endif
 }
 
 #version 450 core
 #pragma stage : frag
 
-layout(push_constant) uniform PushConstants {
-	mat4 u_Model;
+#include <Bindless.glslh>
+
+struct DrawInstance
+{
+	mat4 Model;
+	mat4 NormalMatrix;
+	vec4 DequantizeScale;  // xyz, positions are offset + position * scale
+	vec4 DequantizeOffset; // xyz
+};
+
+layout(std430, set = 2, binding = 1) readonly buffer DrawData {
 	mat4 u_ViewProjection;
-	mat4 u_NormalMatrix;
 	vec4 u_CameraPosition;
-} pc;
+	DrawInstance u_Draws[];
+};
+
+// Material parameters, named like the ones MaterialAsset sets
+#if __ZN_BINDLESS
+struct MaterialData
+{
+	vec3 u_AlbedoColor;
+	float u_Shininess;
+	uint u_AlbedoTexture;
+	vec4 _Padding[14]; // to BINDLESS_MATERIAL_STRIDE
+};
+
+ZN_BINDLESS_MATERIALS(MaterialData);
+#else
+// Without bindless only the texture comes from the material, color and shininess are the defaults
+layout(set = 0, binding = 0) uniform sampler2D u_AlbedoTexture;
+#endif
 
 layout(location = 0) in vec3 v_WorldPosition;
 layout(location = 1) in vec3 v_Normal;
+layout(location = 4) in vec2 v_TexCoord;
+#if __ZN_BINDLESS
+layout(location = 5) flat in uint v_MaterialIndex;
+#endif
+
 layout(location = 0) out vec4 color;
 
 void main()
 {
-	vec3 albedo = vec3(0.2, 0.3, 0.8);
+#if __ZN_BINDLESS
+	vec3 albedo = u_Materials[v_MaterialIndex].u_AlbedoColor * SampleBindless(u_Materials[v_MaterialIndex].u_AlbedoTexture, v_TexCoord).rgb;
+	float shininess = u_Materials[v_MaterialIndex].u_Shininess;
+#else
+	vec3 albedo = vec3(0.2, 0.3, 0.8) * texture(u_AlbedoTexture, v_TexCoord).rgb;
 	float shininess = 18.0;
+#endif
 
 	vec3 lightPosition = vec3(10.0, 10.0, 10.0);
 	vec3 lightColor = vec3(1.0, 1.0, 1.0);
@@ -53,7 +150,7 @@ void main()
 
 	vec3 normal = normalize(v_Normal);
 	vec3 lightDir = normalize(lightPosition - v_WorldPosition);
-	vec3 viewDir = normalize(pc.u_CameraPosition.xyz - v_WorldPosition);
+	vec3 viewDir = normalize(u_CameraPosition.xyz - v_WorldPosition);
 
 	vec3 ambient = ambientColor * albedo;
 
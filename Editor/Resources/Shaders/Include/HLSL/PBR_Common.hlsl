@@ -45,9 +45,9 @@ float3x3 CreateTBN(float3 normal, float3 tangent, float3 bitangent)
 
 float3 SampleNormalMap(Texture2D normalTexture, SamplerState sampler, float2 uv, float3x3 TBN)
 {
-    float3 normalSample = normalTexture.Sample(sampler, uv).xyz;
-
-    normalSample = normalSample * 2.0 - 1.0;
+    // Only X/Y are used, Z is reconstructed so two-channel (BC5) normal maps work too
+    float2 normalXY = normalTexture.Sample(sampler, uv).xy * 2.0 - 1.0;
+    float3 normalSample = float3(normalXY, sqrt(saturate(1.0 - dot(normalXY, normalXY))));
 
     normalSample = normalize(normalSample);
 
@@ -24,6 +24,7 @@ namespace Zenith {
 		{ ".png", AssetType::Texture },
 		{ ".jpg", AssetType::Texture },
 		{ ".jpeg", AssetType::Texture },
+		{ ".ktx2", AssetType::Texture },
 
 		// Fonts
 		{ ".ttf", AssetType::Font },
@@ -17,6 +17,11 @@ namespace Zenith {
 		s_Serializers[AssetType::Font] = CreateScope<FontSerializer>();
 	}
 
+	void AssetImporter::RegisterSerializer(AssetType type, Scope<AssetSerializer> serializer)
+	{
+		s_Serializers[type] = std::move(serializer);
+	}
+
 	void AssetImporter::Serialize(const AssetMetadata& metadata, const Ref<Asset>& asset)
 	{
 		if (s_Serializers.find(metadata.Type) == s_Serializers.end())
@@ -48,6 +53,17 @@ namespace Zenith {
 		return s_Serializers[metadata.Type]->TryLoadData(metadata, asset);
 	}
 
+	bool AssetImporter::TryLoadDataFromMemory(const AssetMetadata& metadata, Buffer data, Ref<Asset>& asset)
+	{
+		ZN_PROFILE_FUNC("AssetImporter::TryLoadDataFromMemory");
+
+		auto it = s_Serializers.find(metadata.Type);
+		if (it == s_Serializers.end())
+			return false;
+
+		return it->second->TryLoadDataFromMemory(metadata, data, asset);
+	}
+
 	void AssetImporter::RegisterDependencies(const AssetMetadata& metadata)
 	{
 		if (s_Serializers.find(metadata.Type) == s_Serializers.end())
@@ -59,6 +75,30 @@ namespace Zenith {
 		s_Serializers[metadata.Type]->RegisterDependencies(metadata);
 	}
 
+	uint32_t AssetImporter::GetVersion(AssetType type)
+	{
+		auto it = s_Serializers.find(type);
+		return it != s_Serializers.end() ? it->second->GetVersion() : 0;
+	}
+
+	void AssetImporter::RecordSourceState(AssetMetadata& metadata, const std::filesystem::path& filepath)
+	{
+		metadata.FileLastWriteTime = FileSystem::GetLastWriteTime(filepath);
+		metadata.ContentHash = FileSystem::GetContentHash(filepath);
+		metadata.ImporterVersion = GetVersion(metadata.Type);
+	}
+
+	bool AssetImporter::IsSourceUnchanged(const AssetMetadata& metadata, const std::filesystem::path& filepath, uint64_t lastWriteTime)
+	{
+		if (lastWriteTime == metadata.FileLastWriteTime)
+			return true;
+
+		if (metadata.ContentHash == 0 || metadata.ImporterVersion != GetVersion(metadata.Type))
+			return false;
+
+		return FileSystem::GetContentHash(filepath) == metadata.ContentHash;
+	}
+
 	std::unordered_map<AssetType, Scope<AssetSerializer>> AssetImporter::s_Serializers;
 
 }
\ No newline at end of file
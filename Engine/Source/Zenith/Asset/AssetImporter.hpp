@@ -10,10 +10,23 @@ namespace Zenith {
 	{
 	public:
 		static void Init();
+
+		// Adds or replaces the serializer for a type, e.g. for asset types defined outside the engine
+		static void RegisterSerializer(AssetType type, Scope<AssetSerializer> serializer);
+
 		static void Serialize(const AssetMetadata& metadata, const Ref<Asset>& asset);
 		static void Serialize(const Ref<Asset>& asset);
 		static bool TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset);
+		static bool TryLoadDataFromMemory(const AssetMetadata& metadata, Buffer data, Ref<Asset>& asset);
 		static void RegisterDependencies(const AssetMetadata& metadata);
+		static uint32_t GetVersion(AssetType type);
+
+		// Records the write time, content hash and importer version of the file an asset was just loaded from
+		static void RecordSourceState(AssetMetadata& metadata, const std::filesystem::path& filepath);
+
+		// True if the file still has the contents the asset was loaded from.
+		// The file is only hashed when its write time differs from the recorded one (touched, checked out again, ...)
+		static bool IsSourceUnchanged(const AssetMetadata& metadata, const std::filesystem::path& filepath, uint64_t lastWriteTime);
 
 	private:
 		static std::unordered_map<AssetType, Scope<AssetSerializer>> s_Serializers;
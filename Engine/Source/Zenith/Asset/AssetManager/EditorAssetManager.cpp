@@ -10,13 +10,12 @@
 #include "Zenith/Project/Project.hpp"
 #include "Zenith/Utilities/StringUtils.hpp"
 
-#include <nlohmann/json.hpp>
-
 namespace Zenith {
 
 	static AssetMetadata s_NullMetadata;
 
-	EditorAssetManager::EditorAssetManager(ApplicationContext& context) : m_Context(context)
+	EditorAssetManager::EditorAssetManager(ApplicationContext& context)
+		: m_RegistrySerializer(Project::GetAssetRegistryPath()), m_Context(context)
 	{
 #if ASYNC_ASSETS
 		m_AssetThread = Ref<EditorAssetSystem>::Create();
@@ -89,7 +88,7 @@ namespace Zenith {
 			auto metadataLoad = metadata;
 			metadataLoad.Status = AssetStatus::Loading;
 			SetMetadata(assetHandle, metadataLoad);
-			m_AssetThread->QueueAssetLoad(metadata);
+			m_AssetThread->QueueAssetLoad(metadata, AssetLoadPriority::Visible);
 		}
 
 		return AssetManager::GetPlaceholderAsset(metadata.Type);
@@ -150,6 +149,12 @@ namespace Zenith {
 	void EditorAssetManager::SetMetadata(AssetHandle handle, const AssetMetadata& metadata)
 	{
 		std::unique_lock lock(m_AssetRegistryMutex);
+
+		// Status changes are not persisted and do not need journaling
+		const bool isNew = !m_AssetRegistry.Contains(handle);
+		if (isNew || !AssetRegistrySerializer::IsPersistedStateEqual(m_AssetRegistry.Get(handle), metadata))
+			m_RegistrySerializer.RecordSet(metadata, isNew);
+
 		m_AssetRegistry.Set(handle, metadata);
 	}
 
@@ -158,14 +163,7 @@ namespace Zenith {
 	{
 		const auto relativePath = GetRelativePath(filepath);
 		std::shared_lock lock(m_AssetRegistryMutex);
-		for (auto& [handle, metadata] : m_AssetRegistry)
-		{
-			if (metadata.FilePath == relativePath)
-			{
-				return metadata.Handle;
-			}
-		}
-		return AssetHandle();
+		return m_AssetRegistry.GetHandle(relativePath);
 	}
 
 
@@ -229,6 +227,21 @@ namespace Zenith {
 	}
 
 	bool EditorAssetManager::ReloadData(AssetHandle assetHandle)
+	{
+		if (DeferToReloadBatch(assetHandle))
+			return true;
+
+		if (!ReloadDataWithoutDependents(assetHandle))
+			return false;
+
+		UpdateDependents(assetHandle);
+		// TODO: Consider using a callback system or event dispatcher injection
+		// auto event = std::make_unique<AssetReloadedEvent>(assetHandle);
+		// Application::Get().GetEventBus().Dispatch(*event);
+		return true;
+	}
+
+	bool EditorAssetManager::ReloadDataWithoutDependents(AssetHandle assetHandle)
 	{
 		auto metadata = GetMetadata(assetHandle);
 		if (!metadata.IsValid())
@@ -244,14 +257,10 @@ namespace Zenith {
 		if (metadata.IsDataLoaded)
 		{
 			auto absolutePath = GetFileSystemPath(metadata);
-			metadata.FileLastWriteTime = FileSystem::GetLastWriteTime(absolutePath);
+			AssetImporter::RecordSourceState(metadata, absolutePath);
 			m_LoadedAssets[assetHandle] = asset;
 			SetMetadata(assetHandle, metadata);
 			ZN_CORE_INFO_TAG("AssetManager", "Finished reloading asset {}", metadata.FilePath.string());
-			UpdateDependents(assetHandle);
-			// TODO: Consider using a callback system or event dispatcher injection
-			// auto event = std::make_unique<AssetReloadedEvent>(assetHandle);
-			// Application::Get().GetEventBus().Dispatch(*event);
 		}
 		else
 		{
@@ -263,6 +272,9 @@ namespace Zenith {
 
 	void EditorAssetManager::ReloadDataAsync(AssetHandle assetHandle)
 	{
+		if (DeferToReloadBatch(assetHandle))
+			return;
+
 #if ASYNC_ASSETS
 		// Queue load (if not already)
 		auto metadata = GetMetadata(assetHandle);
@@ -285,6 +297,11 @@ namespace Zenith {
 
 	// Returns true if asset was reloaded
 	bool EditorAssetManager::EnsureCurrent(AssetHandle assetHandle)
+	{
+		return HasSourceChanged(assetHandle) && ReloadData(assetHandle);
+	}
+
+	bool EditorAssetManager::HasSourceChanged(AssetHandle assetHandle)
 	{
 		const auto& metadata = GetMetadata(assetHandle);
 		auto absolutePath = GetFileSystemPath(metadata);
@@ -298,19 +315,126 @@ namespace Zenith {
 		if (actualLastWriteTime == recordedLastWriteTime)
 			return false;
 
-		return ReloadData(assetHandle);
+		// Touched but not modified (e.g. a branch switch): remember the new time so the file is not hashed again
+		if (AssetImporter::IsSourceUnchanged(metadata, absolutePath, actualLastWriteTime))
+		{
+			AssetMetadata touched = metadata;
+			touched.FileLastWriteTime = actualLastWriteTime;
+			SetMetadata(assetHandle, touched);
+			return false;
+		}
+
+		return true;
 	}
 
 	bool EditorAssetManager::EnsureAllLoadedCurrent()
 	{
 		ZN_PROFILE_FUNC();
 
-		bool loaded = false;
 		for (const auto& [handle, asset] : m_LoadedAssets)
 		{
-			loaded |= EnsureCurrent(handle);
+			if (HasSourceChanged(handle))
+				m_ReloadBatcher.AddChange(handle);
+		}
+
+		if (!m_ReloadBatcher.IsReady())
+			return false;
+
+		ProcessReloadBatch();
+		return true;
+	}
+
+	void EditorAssetManager::ProcessReloadBatch()
+	{
+		ZN_PROFILE_FUNC();
+
+		AssetReloadBatcher::Batch batch = m_ReloadBatcher.TakeBatch([this](AssetHandle handle)
+		{
+			std::shared_lock lock(m_AssetDependenciesMutex);
+			auto it = m_AssetDependents.find(handle);
+			return it != m_AssetDependents.end() ? it->second : std::unordered_set<AssetHandle>{};
+		});
+
+		ZN_CORE_INFO_TAG("AssetManager", "Reloading {} changed assets ({} affected)", batch.Changed.size(), batch.GetAssetCount());
+
+		m_ReloadBatchRequests = std::move(batch.Changed);
+		for (const auto& level : batch.Levels)
+			m_ReloadBatchRemaining.insert(level.begin(), level.end());
+
+		std::vector<AssetHandle> updated;
+		for (const auto& level : batch.Levels)
+		{
+			std::vector<AssetHandle> reloads;
+			for (AssetHandle handle : level)
+			{
+				m_ReloadBatchRemaining.erase(handle);
+
+				// Assets that are not loaded will be loaded from the new files anyway
+				if (!IsAssetLoaded(handle))
+					continue;
+
+				updated.push_back(handle);
+				if (m_ReloadBatchRequests.contains(handle))
+					reloads.push_back(handle);
+			}
+
+			// Dependents are in later levels: their reload requests are collected, not executed
+			for (AssetHandle handle : ReloadIndependentAssets(reloads))
+				UpdateDependents(handle);
+		}
+
+		m_ReloadBatchRemaining.clear();
+		m_ReloadBatchRequests.clear();
+
+		if (!updated.empty())
+		{
+			AssetsReloadedEvent event(std::move(updated));
+			m_Context.GetEventBus().Dispatch(event);
 		}
-		return loaded;
+	}
+
+	std::vector<AssetHandle> EditorAssetManager::ReloadIndependentAssets(const std::vector<AssetHandle>& handles)
+	{
+		std::vector<AssetHandle> reloaded;
+		if (handles.empty())
+			return reloaded;
+
+#if ASYNC_ASSETS
+		std::vector<std::shared_future<Ref<Asset>>> loads;
+		loads.reserve(handles.size());
+		for (AssetHandle handle : handles)
+			loads.push_back(m_AssetThread->QueueAssetLoad(GetMetadata(handle), AssetLoadPriority::Visible));
+
+		for (size_t i = 0; i < handles.size(); i++)
+		{
+			if (loads[i].get())
+				reloaded.push_back(handles[i]);
+		}
+
+		// Other loads may have finished meanwhile, those update their dependents as usual
+		const std::unordered_set<AssetHandle> batchAssets(handles.begin(), handles.end());
+		for (AssetHandle handle : ApplyReadyAssets())
+		{
+			if (!batchAssets.contains(handle))
+				UpdateDependents(handle);
+		}
+#else
+		for (AssetHandle handle : handles)
+		{
+			if (ReloadDataWithoutDependents(handle))
+				reloaded.push_back(handle);
+		}
+#endif
+		return reloaded;
+	}
+
+	bool EditorAssetManager::DeferToReloadBatch(AssetHandle assetHandle)
+	{
+		if (!m_ReloadBatchRemaining.contains(assetHandle))
+			return false;
+
+		m_ReloadBatchRequests.insert(assetHandle);
+		return true;
 	}
 
 	Ref<Zenith::Asset> EditorAssetManager::GetMemoryAsset(AssetHandle handle)
@@ -372,8 +496,8 @@ namespace Zenith {
 
 		{
 			std::scoped_lock lock(m_AssetRegistryMutex);
-			if (m_AssetRegistry.Contains(handle))
-				m_AssetRegistry.Remove(handle);
+			if (m_AssetRegistry.Remove(handle))
+				m_RegistrySerializer.RecordRemove(handle);
 		}
 	}
 
@@ -480,10 +604,29 @@ namespace Zenith {
 	}
 
 	void EditorAssetManager::SyncWithAssetThread()
+	{
+		std::vector<AssetHandle> changedAssets;
+		m_AssetThread->RetrieveChangedAssets(changedAssets);
+		for (AssetHandle handle : changedAssets)
+			m_ReloadBatcher.AddChange(handle);
+
+		// Update dependencies after syncing everything
+		for (AssetHandle handle : ApplyReadyAssets())
+		{
+			UpdateDependents(handle);
+		}
+
+		if (m_ReloadBatcher.IsReady())
+			ProcessReloadBatch();
+	}
+
+	std::vector<AssetHandle> EditorAssetManager::ApplyReadyAssets()
 	{
 		std::vector<EditorAssetLoadResponse> freshAssets;
 
 		m_AssetThread->RetrieveReadyAssets(freshAssets);
+		std::vector<AssetHandle> handles;
+		handles.reserve(freshAssets.size());
 		for (auto& alr : freshAssets)
 		{
 			ZN_CORE_ASSERT(alr.Asset->Handle == alr.Metadata.Handle, "AssetHandle mismatch in AssetLoadResponse");
@@ -491,15 +634,11 @@ namespace Zenith {
 			alr.Metadata.Status = AssetStatus::Ready;
 			alr.Metadata.IsDataLoaded = true;
 			SetMetadata(alr.Metadata.Handle, alr.Metadata);
+			handles.push_back(alr.Metadata.Handle);
 		}
 
 		m_AssetThread->UpdateLoadedAssetList(m_LoadedAssets);
-
-		// Update dependencies after syncing everything
-		for (const auto& alr : freshAssets)
-		{
-			UpdateDependents(alr.Metadata.Handle);
-		}
+		return handles;
 	}
 
 	AssetHandle EditorAssetManager::ImportAsset(const std::filesystem::path& filepath)
@@ -553,7 +692,7 @@ namespace Zenith {
 						auto metadataLoaded = metadata;
 						metadataLoaded.IsDataLoaded = true;
 						auto absolutePath = GetFileSystemPath(metadata);
-						metadataLoaded.FileLastWriteTime = FileSystem::GetLastWriteTime(absolutePath);
+						AssetImporter::RecordSourceState(metadataLoaded, absolutePath);
 						m_LoadedAssets[assetHandle] = asset;
 						SetMetadata(assetHandle, metadataLoaded);
 						ZN_CORE_INFO_TAG("AssetManager", "Finished loading asset {}", metadata.FilePath.string());
@@ -566,8 +705,8 @@ namespace Zenith {
 				else
 				{
 					// Not main thread -> ask AssetThread for the asset
-					// If the asset needs to be loaded, this will load the asset.
-					// The load will happen on this thread (which is probably asset thread, but occasionally might be audio thread).
+					// If the asset needs to be loaded, this will load the asset (or wait for a worker that is already loading it).
+					// The load will happen on this thread (which is probably an asset worker, but occasionally might be audio thread).
 					// The asset will get synced into main thread at next asset sync point.
 					asset = m_AssetThread->GetAsset(metadata);
 				}
@@ -580,93 +719,29 @@ namespace Zenith {
 	{
 		ZN_CORE_INFO("[AssetManager] Loading Asset Registry");
 
-		const auto& assetRegistryPath = Project::GetAssetRegistryPath();
-		if (!FileSystem::Exists(assetRegistryPath))
-		{
-			ZN_CORE_INFO("[AssetManager] Asset Registry file does not exist, will be created on first save");
-			return;
-		}
-
-		std::ifstream stream(assetRegistryPath);
-		if (!stream.is_open())
-		{
-			ZN_CORE_ERROR("[AssetManager] Failed to open Asset Registry file: {}", assetRegistryPath.string());
-			return;
-		}
-
-		// Check if file is empty
-		stream.seekg(0, std::ios::end);
-		std::streampos fileSize = stream.tellg();
-		stream.seekg(0, std::ios::beg);
-
-		if (fileSize == 0)
-		{
-			ZN_CORE_INFO("[AssetManager] Asset Registry file is empty, will be populated on asset scan");
-			return;
-		}
-
-		nlohmann::json data;
-		try
+		std::vector<AssetMetadata> entries;
+		if (!m_RegistrySerializer.Deserialize(entries))
 		{
-			stream >> data;
-		}
-		catch (const nlohmann::json::exception& e)
-		{
-			ZN_CORE_ERROR("[AssetManager] Failed to parse Asset Registry JSON: {}", e.what());
 			ZN_CORE_WARN("[AssetManager] Asset Registry may be corrupted, will be regenerated");
 			return;
 		}
 
-		if (!data.contains("Assets"))
-		{
-			ZN_CORE_WARN("[AssetManager] Asset Registry missing 'Assets' node, treating as empty");
-			return;
-		}
-
-		if (!data["Assets"].is_array())
-		{
-			ZN_CORE_ERROR("[AssetManager] Asset Registry 'Assets' is not an array, regenerating registry");
-			return;
-		}
-
 		size_t loadedCount = 0;
-		for (const auto& entry : data["Assets"])
 		{
-			if (!entry.contains("FilePath") || !entry.contains("Handle") || !entry.contains("Type"))
+			// Straight into the registry: these entries are already persisted
+			std::unique_lock lock(m_AssetRegistryMutex);
+			for (const AssetMetadata& metadata : entries)
 			{
-				ZN_CORE_WARN("[AssetManager] Skipping malformed asset entry in registry");
-				continue;
-			}
-
-			try
-			{
-				std::string filepath = entry["FilePath"].get<std::string>();
-
-				AssetMetadata metadata;
-				metadata.Handle = AssetHandle(entry["Handle"].get<uint64_t>());
-				metadata.FilePath = filepath;
-				metadata.Type = (AssetType)Utils::AssetTypeFromString(entry["Type"].get<std::string>());
-
-				if (metadata.Type == AssetType::None)
-				{
-					ZN_CORE_WARN("[AssetManager] Unknown asset type in registry: {}", entry["Type"].get<std::string>());
-					continue;
-				}
-
-				if (metadata.Type != GetAssetTypeFromPath(filepath))
+				if (metadata.Type != GetAssetTypeFromPath(metadata.FilePath))
 				{
 					ZN_CORE_WARN_TAG("AssetManager", "Mismatch between stored AssetType and extension type when reading asset registry: {}", metadata.FilePath.string());
+					m_RegistrySerializer.RecordRemove(metadata.Handle);
 					continue;
 				}
 
-				SetMetadata(metadata.Handle, metadata);
+				m_AssetRegistry.Set(metadata.Handle, metadata);
 				loadedCount++;
 			}
-			catch (const std::exception& e)
-			{
-				ZN_CORE_WARN("[AssetManager] Failed to parse asset entry: {}", e.what());
-				continue;
-			}
 		}
 
 		ZN_CORE_INFO("[AssetManager] Loaded {} asset entries from registry", loadedCount);
@@ -691,109 +766,46 @@ namespace Zenith {
 
 	void EditorAssetManager::WriteRegistryToFile()
 	{
-		struct AssetRegistryEntry
-		{
-			std::string FilePath;
-			AssetType Type;
-		};
-		std::map<UUID, AssetRegistryEntry> sortedMap;
+		ZN_PROFILE_FUNC();
 
-		for (auto& [filepath, metadata] : m_AssetRegistry)
+		if (!m_RegistrySerializer.NeedsCompaction(m_AssetRegistry.Count()))
 		{
-			if (!FileSystem::Exists(GetFileSystemPath(metadata)))
-			{
-				ZN_CORE_TRACE("[AssetManager] Skipping missing asset: {}", metadata.FilePath.string());
-				continue;
-			}
-
-			std::string pathToSerialize = metadata.FilePath.string();
-			// Normalize path separators for cross-platform compatibility
-			std::replace(pathToSerialize.begin(), pathToSerialize.end(), '\\', '/');
-
-			if (pathToSerialize.empty())
-			{
-				ZN_CORE_WARN("[AssetManager] Skipping asset with empty path, handle: {}", static_cast<uint64_t>(metadata.Handle));
-				continue;
-			}
-
-			sortedMap[metadata.Handle] = { pathToSerialize, metadata.Type };
+			m_RegistrySerializer.Flush();
+			return;
 		}
 
-		ZN_CORE_INFO("[AssetManager] Serializing asset registry with {} entries", sortedMap.size());
-
-		nlohmann::json jsonData;
-		jsonData["Assets"] = nlohmann::json::array();
-
-		for (const auto& [handle, entry] : sortedMap)
+		std::vector<AssetMetadata> entries;
+		entries.reserve(m_AssetRegistry.Count());
+		for (const auto& [handle, metadata] : m_AssetRegistry)
 		{
-			try
+			if (metadata.FilePath.empty())
 			{
-				nlohmann::json assetEntry;
-				assetEntry["Handle"] = static_cast<uint64_t>(handle);
-				assetEntry["FilePath"] = entry.FilePath;
-				assetEntry["Type"] = Utils::AssetTypeToString(entry.Type);
-
-				if (assetEntry["FilePath"].get<std::string>().empty())
-				{
-					ZN_CORE_WARN("[AssetManager] Skipping asset entry with empty file path");
-					continue;
-				}
-
-				jsonData["Assets"].push_back(assetEntry);
-			}
-			catch (const std::exception& e)
-			{
-				ZN_CORE_ERROR("[AssetManager] Failed to serialize asset entry {}: {}", static_cast<uint64_t>(handle), e.what());
+				ZN_CORE_WARN("[AssetManager] Skipping asset with empty path, handle: {}", static_cast<uint64_t>(metadata.Handle));
 				continue;
 			}
-		}
 
-		const std::string& assetRegistryPath = Project::GetAssetRegistryPath().string();
-
-		try
-		{
-			std::string jsonString = jsonData.dump(2);
-			auto testParse = nlohmann::json::parse(jsonString);
-
-			std::ofstream fout(assetRegistryPath);
-			if (!fout.is_open())
-			{
-				ZN_CORE_ERROR("[AssetManager] Failed to open asset registry file for writing: {}", assetRegistryPath);
-				return;
-			}
-
-			fout << jsonString;
-			fout.close();
-
-			if (fout.fail())
+			if (!FileSystem::Exists(GetFileSystemPath(metadata)))
 			{
-				ZN_CORE_ERROR("[AssetManager] Failed to write asset registry file: {}", assetRegistryPath);
-				return;
+				ZN_CORE_TRACE("[AssetManager] Skipping missing asset: {}", metadata.FilePath.string());
+				continue;
 			}
 
-			ZN_CORE_INFO("[AssetManager] Asset registry saved successfully with {} entries", jsonData["Assets"].size());
+			entries.push_back(metadata);
 		}
-		catch (const std::exception& e)
-		{
-			ZN_CORE_ERROR("[AssetManager] Failed to write asset registry: {}", e.what());
 
-			try
-			{
-				nlohmann::json fallbackData;
-				fallbackData["Assets"] = nlohmann::json::array();
+		m_RegistrySerializer.Compact(entries);
+	}
 
-				std::ofstream fallbackOut(assetRegistryPath);
-				if (fallbackOut.is_open())
-				{
-					fallbackOut << fallbackData.dump(2);
-					ZN_CORE_WARN("[AssetManager] Created empty asset registry as fallback");
-				}
-			}
-			catch (...)
-			{
-				ZN_CORE_ERROR("[AssetManager] Failed to create fallback asset registry");
-			}
+	bool EditorAssetManager::ExportRegistryJSON(const std::filesystem::path& filepath)
+	{
+		std::vector<AssetMetadata> entries;
+		{
+			std::shared_lock lock(m_AssetRegistryMutex);
+			entries.reserve(m_AssetRegistry.Count());
+			for (const auto& [handle, metadata] : m_AssetRegistry)
+				entries.push_back(metadata);
 		}
+		return AssetRegistrySerializer::ExportJSON(entries, filepath);
 	}
 
 	void EditorAssetManager::OnAssetRenamed(AssetHandle assetHandle, const std::filesystem::path& newFilePath)
@@ -7,6 +7,8 @@
 
 #include "Zenith/Asset/AssetImporter.hpp"
 #include "Zenith/Asset/AssetRegistry.hpp"
+#include "Zenith/Asset/AssetRegistrySerializer.hpp"
+#include "Zenith/Asset/AssetSystem/AssetReloadBatcher.hpp"
 #include "Zenith/Asset/AssetSystem/EditorAssetSystem.hpp"
 #include "Zenith/Events/EditorEvent.hpp"
 #include "Zenith/Utilities/FileSystem.hpp"
@@ -57,6 +59,9 @@ namespace Zenith {
 
 		const AssetRegistry& GetAssetRegistry() const { return m_AssetRegistry; }
 
+		// Writes the registry in the readable JSON format, e.g. for diffing. The project itself uses the binary registry.
+		bool ExportRegistryJSON(const std::filesystem::path& filepath);
+
 		// Get all memory-only assets.
 		// Returned by value so that caller need not hold a lock on m_MemoryAssetsMutex
 		std::unordered_map<AssetHandle, Ref<Asset>> GetMemoryAssets();
@@ -128,9 +133,9 @@ namespace Zenith {
 			m_LoadedAssets[asset->Handle] = asset;
 			AssetImporter::Serialize(metadata, asset);
 
-			// Read serialized timestamp
+			// Read serialized timestamp and contents
 			auto absolutePath = GetFileSystemPath(metadata);
-			metadata.FileLastWriteTime = FileSystem::GetLastWriteTime(absolutePath);
+			AssetImporter::RecordSourceState(metadata, absolutePath);
 			SetMetadata(metadata.Handle, metadata);
 
 			if (replaceAsset)
@@ -163,6 +168,19 @@ namespace Zenith {
 
 		void UpdateDependents(AssetHandle handle);
 
+		// True if the asset's file has different contents from the ones loaded
+		bool HasSourceChanged(AssetHandle assetHandle);
+		bool ReloadDataWithoutDependents(AssetHandle assetHandle);
+		// Syncs the assets loaded by the asset thread, returns their handles
+		std::vector<AssetHandle> ApplyReadyAssets();
+
+		// Reloads the settled batch of changed assets and their dependents in dependency order, then dispatches one AssetsReloadedEvent
+		void ProcessReloadBatch();
+		// Reloads assets that do not depend on each other, in parallel on the asset thread's workers. Returns the handles that reloaded.
+		std::vector<AssetHandle> ReloadIndependentAssets(const std::vector<AssetHandle>& handles);
+		// While a batch is processed, reload requests for its later assets (e.g. from OnDependencyUpdated()) are deferred to their level
+		bool DeferToReloadBatch(AssetHandle assetHandle);
+
 	private:
 		// TODO: move to AssetSystem
 		// NOTE: this collection is accessed only from the main thread, and so does not need
@@ -186,6 +204,14 @@ namespace Zenith {
 		AssetRegistry m_AssetRegistry;
 		std::shared_mutex m_AssetRegistryMutex;
 
+		// Persists registry changes as they happen (see WriteRegistryToFile())
+		AssetRegistrySerializer m_RegistrySerializer;
+
+		// Hot reloads. Main thread only.
+		AssetReloadBatcher m_ReloadBatcher;
+		std::unordered_set<AssetHandle> m_ReloadBatchRemaining; // assets of the batch being processed, in levels not yet reached
+		std::unordered_set<AssetHandle> m_ReloadBatchRequests;  // assets of the batch that need their data reloaded
+
 		ApplicationContext& m_Context;
 
 		friend class EditorAssetSystem;
@@ -0,0 +1,413 @@
+#include "znpch.hpp"
+#include "RuntimeAssetManager.hpp"
+
+#include "Zenith/Asset/AssetImporter.hpp"
+#include "Zenith/Asset/AssetManager.hpp"
+#include "Zenith/Debug/Profiler.hpp"
+#include "Zenith/Project/Project.hpp"
+#include "Zenith/Utilities/FileSystem.hpp"
+
+namespace Zenith {
+
+	RuntimeAssetManager::RuntimeAssetManager(const std::filesystem::path& assetPackPath)
+	{
+		AssetImporter::Init();
+
+		m_AssetPack = AssetPack::Open(assetPackPath);
+		if (!m_AssetPack)
+			ZN_CORE_ERROR_TAG("AssetManager", "Failed to open asset pack {}, only memory assets will be available", assetPackPath.string());
+	}
+
+	RuntimeAssetManager::~RuntimeAssetManager()
+	{
+		Shutdown();
+	}
+
+	void RuntimeAssetManager::Shutdown()
+	{
+		for (Shard& shard : m_Shards)
+		{
+			std::unique_lock lock(shard.Mutex);
+			shard.Assets.clear();
+			shard.Dependencies.clear();
+		}
+
+		for (auto& bytes : m_ResidentBytes)
+			bytes = 0;
+
+		m_LoadedAssetsSnapshot.clear();
+	}
+
+	AssetType RuntimeAssetManager::GetAssetType(AssetHandle assetHandle)
+	{
+		if (Ref<Asset> asset = GetMemoryAsset(assetHandle))
+			return asset->GetAssetType();
+
+		return m_AssetPack ? m_AssetPack->GetAssetType(assetHandle) : AssetType::None;
+	}
+
+	Ref<Asset> RuntimeAssetManager::GetAsset(AssetHandle assetHandle)
+	{
+		ZN_PROFILE_FUNC();
+
+		Shard& shard = GetShard(assetHandle);
+		{
+			std::shared_lock lock(shard.Mutex);
+			if (auto it = shard.Assets.find(assetHandle); it != shard.Assets.end())
+			{
+				it->second.LastUsed.store(++m_UseCounter, std::memory_order_relaxed);
+				return it->second.Instance->IsValid() ? it->second.Instance : nullptr;
+			}
+		}
+
+		AssetMetadata metadata = GetMetadata(assetHandle);
+		if (!metadata.IsValid())
+			return nullptr;
+
+		// Loaded without holding the shard lock, serializers may request their dependencies.
+		// If another thread wins the race, its asset is kept and ours is dropped.
+		Ref<Asset> asset = LoadAsset(metadata);
+		if (!asset)
+			return nullptr;
+
+		bool inserted = false;
+		{
+			std::unique_lock lock(shard.Mutex);
+			auto [it, emplaced] = shard.Assets.try_emplace(assetHandle);
+			if (emplaced)
+			{
+				it->second.Instance = asset;
+				it->second.Size = m_AssetPack->GetEntry(assetHandle)->UncompressedSize;
+				m_ResidentBytes[(uint16_t)metadata.Type] += it->second.Size;
+				inserted = true;
+			}
+			it->second.LastUsed.store(++m_UseCounter, std::memory_order_relaxed);
+			asset = it->second.Instance;
+		}
+
+		if (inserted)
+			TrimResidency(metadata.Type);
+
+		return asset->IsValid() ? asset : nullptr;
+	}
+
+	AsyncAssetResult<Asset> RuntimeAssetManager::GetAssetAsync(AssetHandle assetHandle)
+	{
+		return { GetAsset(assetHandle), true };
+	}
+
+	void RuntimeAssetManager::AddMemoryOnlyAsset(Ref<Asset> asset)
+	{
+		Shard& shard = GetShard(asset->Handle);
+		std::unique_lock lock(shard.Mutex);
+
+		AssetSlot& slot = shard.Assets[asset->Handle];
+		if (!slot.IsMemoryAsset && slot.Size)
+			m_ResidentBytes[(uint16_t)asset->GetAssetType()] -= slot.Size;
+
+		slot.Instance = asset;
+		slot.Size = 0;
+		slot.IsMemoryAsset = true;
+	}
+
+	bool RuntimeAssetManager::ReloadData(AssetHandle assetHandle)
+	{
+		AssetMetadata metadata = GetMetadata(assetHandle);
+		if (!metadata.IsValid())
+		{
+			ZN_CORE_ERROR_TAG("AssetManager", "Trying to reload invalid asset {}", assetHandle);
+			return false;
+		}
+
+		Ref<Asset> asset = LoadAsset(metadata);
+		if (!asset)
+			return false;
+
+		Shard& shard = GetShard(assetHandle);
+		{
+			std::unique_lock lock(shard.Mutex);
+			auto [it, emplaced] = shard.Assets.try_emplace(assetHandle);
+			if (emplaced)
+			{
+				it->second.Size = m_AssetPack->GetEntry(assetHandle)->UncompressedSize;
+				m_ResidentBytes[(uint16_t)metadata.Type] += it->second.Size;
+			}
+			it->second.Instance = asset;
+			it->second.LastUsed.store(++m_UseCounter, std::memory_order_relaxed);
+		}
+
+		UpdateDependents(assetHandle);
+		return true;
+	}
+
+	bool RuntimeAssetManager::IsAssetHandleValid(AssetHandle assetHandle)
+	{
+		return (m_AssetPack && m_AssetPack->Contains(assetHandle)) || IsMemoryAsset(assetHandle);
+	}
+
+	Ref<Asset> RuntimeAssetManager::GetMemoryAsset(AssetHandle handle)
+	{
+		Shard& shard = GetShard(handle);
+		std::shared_lock lock(shard.Mutex);
+		if (auto it = shard.Assets.find(handle); it != shard.Assets.end() && it->second.IsMemoryAsset)
+			return it->second.Instance;
+
+		return nullptr;
+	}
+
+	bool RuntimeAssetManager::IsAssetLoaded(AssetHandle handle)
+	{
+		Shard& shard = GetShard(handle);
+		std::shared_lock lock(shard.Mutex);
+		auto it = shard.Assets.find(handle);
+		return it != shard.Assets.end() && !it->second.IsMemoryAsset;
+	}
+
+	bool RuntimeAssetManager::IsAssetValid(AssetHandle handle)
+	{
+		ZN_PROFILE_FUNC();
+
+		return GetAsset(handle) != nullptr;
+	}
+
+	bool RuntimeAssetManager::IsAssetMissing(AssetHandle handle)
+	{
+		return !IsAssetHandleValid(handle);
+	}
+
+	bool RuntimeAssetManager::IsMemoryAsset(AssetHandle handle)
+	{
+		return GetMemoryAsset(handle) != nullptr;
+	}
+
+	bool RuntimeAssetManager::IsPhysicalAsset(AssetHandle handle)
+	{
+		return !IsMemoryAsset(handle);
+	}
+
+	void RuntimeAssetManager::RemoveAsset(AssetHandle handle)
+	{
+		Shard& shard = GetShard(handle);
+		std::unique_lock lock(shard.Mutex);
+		if (auto it = shard.Assets.find(handle); it != shard.Assets.end())
+		{
+			if (!it->second.IsMemoryAsset)
+				m_ResidentBytes[(uint16_t)GetMetadata(handle).Type] -= it->second.Size;
+			shard.Assets.erase(it);
+		}
+	}
+
+	void RuntimeAssetManager::RegisterDependency(AssetHandle dependency, AssetHandle handle)
+	{
+		Shard& shard = GetShard(handle);
+		std::unique_lock lock(shard.Mutex);
+
+		auto& dependencies = shard.Dependencies[handle];
+		if (dependency)
+			dependencies.insert(dependency);
+	}
+
+	void RuntimeAssetManager::DeregisterDependency(AssetHandle dependency, AssetHandle handle)
+	{
+		Shard& shard = GetShard(handle);
+		std::unique_lock lock(shard.Mutex);
+		if (auto it = shard.Dependencies.find(handle); it != shard.Dependencies.end())
+			it->second.erase(dependency);
+	}
+
+	void RuntimeAssetManager::DeregisterDependencies(AssetHandle handle)
+	{
+		Shard& shard = GetShard(handle);
+		std::unique_lock lock(shard.Mutex);
+		shard.Dependencies.erase(handle);
+	}
+
+	std::unordered_set<AssetHandle> RuntimeAssetManager::GetDependencies(AssetHandle handle)
+	{
+		Shard& shard = GetShard(handle);
+		std::shared_lock lock(shard.Mutex);
+		if (auto it = shard.Dependencies.find(handle); it != shard.Dependencies.end())
+			return it->second;
+
+		return {};
+	}
+
+	std::unordered_set<AssetHandle> RuntimeAssetManager::GetAllAssetsWithType(AssetType type)
+	{
+		std::unordered_set<AssetHandle> result;
+
+		if (m_AssetPack)
+		{
+			for (const AssetPackFile::TOCEntry& entry : *m_AssetPack)
+			{
+				if ((AssetType)entry.Type == type)
+					result.insert(AssetHandle(entry.Handle));
+			}
+		}
+
+		for (Shard& shard : m_Shards)
+		{
+			std::shared_lock lock(shard.Mutex);
+			for (const auto& [handle, slot] : shard.Assets)
+			{
+				if (slot.IsMemoryAsset && slot.Instance->GetAssetType() == type)
+					result.insert(handle);
+			}
+		}
+
+		return result;
+	}
+
+	const std::unordered_map<AssetHandle, Ref<Asset>>& RuntimeAssetManager::GetLoadedAssets()
+	{
+		m_LoadedAssetsSnapshot.clear();
+		for (Shard& shard : m_Shards)
+		{
+			std::shared_lock lock(shard.Mutex);
+			for (const auto& [handle, slot] : shard.Assets)
+			{
+				if (!slot.IsMemoryAsset)
+					m_LoadedAssetsSnapshot[handle] = slot.Instance;
+			}
+		}
+		return m_LoadedAssetsSnapshot;
+	}
+
+	void RuntimeAssetManager::SetMemoryBudget(AssetType type, uint64_t bytes)
+	{
+		ZN_CORE_ASSERT((uint16_t)type < MaxAssetTypes);
+		m_Budgets[(uint16_t)type] = bytes;
+	}
+
+	uint64_t RuntimeAssetManager::GetMemoryBudget(AssetType type) const
+	{
+		return m_Budgets[(uint16_t)type];
+	}
+
+	uint64_t RuntimeAssetManager::GetResidentBytes(AssetType type) const
+	{
+		return m_ResidentBytes[(uint16_t)type];
+	}
+
+	void RuntimeAssetManager::TrimResidency()
+	{
+		for (uint16_t type = 0; type < MaxAssetTypes; type++)
+			TrimResidency((AssetType)type);
+	}
+
+	AssetMetadata RuntimeAssetManager::GetMetadata(AssetHandle handle) const
+	{
+		AssetMetadata metadata;
+
+		const AssetPackFile::TOCEntry* entry = m_AssetPack ? m_AssetPack->GetEntry(handle) : nullptr;
+		if (!entry)
+			return metadata;
+
+		metadata.Handle = handle;
+		metadata.Type = (AssetType)entry->Type;
+		metadata.FilePath = m_AssetPack->GetAssetPath(handle);
+		metadata.Status = AssetStatus::Ready;
+		return metadata;
+	}
+
+	Ref<Asset> RuntimeAssetManager::LoadAsset(const AssetMetadata& metadata)
+	{
+		ZN_PROFILE_FUNC();
+
+		Ref<Asset> asset;
+
+		Buffer data = m_AssetPack->ReadAsset(metadata.Handle);
+		bool loaded = data && AssetImporter::TryLoadDataFromMemory(metadata, data, asset);
+		data.Release();
+
+		// Importers that only read from disk (e.g. MeshSource) fall back to the loose file
+		if (!loaded && FileSystem::Exists(Project::GetActiveAssetDirectory() / metadata.FilePath))
+			loaded = AssetImporter::TryLoadData(metadata, asset);
+
+		if (!loaded)
+		{
+			ZN_CORE_ERROR_TAG("AssetManager", "Failed to load asset {} ({})", metadata.FilePath.string(), metadata.Handle);
+			return nullptr;
+		}
+
+		return asset;
+	}
+
+	void RuntimeAssetManager::TrimResidency(AssetType type)
+	{
+		const uint64_t budget = m_Budgets[(uint16_t)type];
+		if (budget == 0 || m_ResidentBytes[(uint16_t)type] <= budget)
+			return;
+
+		ZN_PROFILE_FUNC();
+
+		struct Candidate
+		{
+			AssetHandle Handle;
+			uint64_t LastUsed;
+		};
+		std::vector<Candidate> candidates;
+
+		for (Shard& shard : m_Shards)
+		{
+			std::shared_lock lock(shard.Mutex);
+			for (const auto& [handle, slot] : shard.Assets)
+			{
+				// The table holding the only reference means nothing is using the asset
+				if (!slot.IsMemoryAsset && slot.Instance->GetRefCount() == 1 && slot.Instance->GetAssetType() == type)
+					candidates.push_back({ handle, slot.LastUsed.load(std::memory_order_relaxed) });
+			}
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.LastUsed < b.LastUsed; });
+
+		uint32_t evictedCount = 0;
+		for (const Candidate& candidate : candidates)
+		{
+			if (m_ResidentBytes[(uint16_t)type] <= budget)
+				break;
+
+			Shard& shard = GetShard(candidate.Handle);
+			Ref<Asset> evicted;
+			{
+				std::unique_lock lock(shard.Mutex);
+				auto it = shard.Assets.find(candidate.Handle);
+				if (it == shard.Assets.end() || it->second.Instance->GetRefCount() != 1 || it->second.LastUsed != candidate.LastUsed)
+					continue; // Picked up again since the scan
+
+				evicted = std::move(it->second.Instance);
+				m_ResidentBytes[(uint16_t)type] -= it->second.Size;
+				shard.Assets.erase(it);
+			}
+			// evicted is destroyed here, outside the shard lock
+			evictedCount++;
+		}
+
+		if (evictedCount)
+			ZN_CORE_TRACE_TAG("AssetManager", "Evicted {} {} assets ({} / {} bytes resident)", evictedCount, Utils::AssetTypeToString(type), m_ResidentBytes[(uint16_t)type].load(), budget);
+	}
+
+	void RuntimeAssetManager::UpdateDependents(AssetHandle handle)
+	{
+		std::vector<AssetHandle> dependents;
+		for (Shard& shard : m_Shards)
+		{
+			std::shared_lock lock(shard.Mutex);
+			for (const auto& [dependent, dependencies] : shard.Dependencies)
+			{
+				if (dependencies.contains(handle))
+					dependents.push_back(dependent);
+			}
+		}
+
+		for (AssetHandle dependent : dependents)
+		{
+			if (IsAssetLoaded(dependent))
+			{
+				if (Ref<Asset> asset = GetAsset(dependent))
+					asset->OnDependencyUpdated(handle);
+			}
+		}
+	}
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "AssetManagerBase.hpp"
+
+#include "Zenith/Asset/AssetMetadata.hpp"
+#include "Zenith/Asset/AssetPack/AssetPack.hpp"
+
+#include <array>
+#include <atomic>
+#include <shared_mutex>
+#include <vector>
+
+namespace Zenith {
+
+	//////////////////////////////////////////////////////////////////
+	// RuntimeAssetManager ///////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////
+	// Shipping-build asset manager, selected with ZENITH_RUNTIME_ASSETS.
+	// Metadata comes from an immutable AssetPack (lock-free lookups), loaded assets live in a
+	// sharded table. There is no registry file and no file-time polling: packs do not change.
+	//
+	// Residency is refcount-driven: an asset is only evictable while the table holds the last reference.
+	// When an asset type goes over its memory budget, evictable assets of that type are released
+	// least-recently-used first. Costs are the asset's packed (uncompressed) size.
+	//////////////////////////////////////////////////////////////////
+	class RuntimeAssetManager : public AssetManagerBase
+	{
+	public:
+		explicit RuntimeAssetManager(const std::filesystem::path& assetPackPath);
+		virtual ~RuntimeAssetManager();
+
+		virtual void Shutdown() override;
+
+		virtual AssetType GetAssetType(AssetHandle assetHandle) override;
+		virtual Ref<Asset> GetAsset(AssetHandle assetHandle) override;
+		virtual AsyncAssetResult<Asset> GetAssetAsync(AssetHandle assetHandle) override;
+
+		virtual void AddMemoryOnlyAsset(Ref<Asset> asset) override;
+
+		virtual bool ReloadData(AssetHandle assetHandle) override;
+		virtual void ReloadDataAsync(AssetHandle assetHandle) override { ReloadData(assetHandle); }
+		virtual bool EnsureCurrent(AssetHandle assetHandle) override { return false; }
+		virtual bool EnsureAllLoadedCurrent() override { return false; }
+		virtual bool IsAssetHandleValid(AssetHandle assetHandle) override;
+		virtual Ref<Asset> GetMemoryAsset(AssetHandle handle) override;
+		virtual bool IsAssetLoaded(AssetHandle handle) override;
+		virtual bool IsAssetValid(AssetHandle handle) override;
+		virtual bool IsAssetMissing(AssetHandle handle) override;
+		virtual bool IsMemoryAsset(AssetHandle handle) override;
+		virtual bool IsPhysicalAsset(AssetHandle handle) override;
+		virtual void RemoveAsset(AssetHandle handle) override;
+
+		virtual void RegisterDependency(AssetHandle dependency, AssetHandle handle) override;
+		virtual void DeregisterDependency(AssetHandle dependency, AssetHandle handle) override;
+		virtual void DeregisterDependencies(AssetHandle handle) override;
+		virtual std::unordered_set<AssetHandle> GetDependencies(AssetHandle handle) override;
+
+		virtual void SyncWithAssetThread() override {}
+
+		virtual std::unordered_set<AssetHandle> GetAllAssetsWithType(AssetType type) override;
+
+		// Snapshot of the sharded table, rebuilt on every call. Not for per-frame use.
+		virtual const std::unordered_map<AssetHandle, Ref<Asset>>& GetLoadedAssets() override;
+
+		// ------------- Runtime-only ----------------
+
+		// 0 = unlimited (default). Takes effect on the next load of that type, or TrimResidency()
+		void SetMemoryBudget(AssetType type, uint64_t bytes);
+		uint64_t GetMemoryBudget(AssetType type) const;
+		uint64_t GetResidentBytes(AssetType type) const;
+
+		// Evicts unreferenced assets of every type that is over budget
+		void TrimResidency();
+
+		Ref<AssetPack> GetAssetPack() const { return m_AssetPack; }
+
+	private:
+		struct AssetSlot
+		{
+			Ref<Asset> Instance;
+			uint64_t Size = 0;
+			bool IsMemoryAsset = false;
+			std::atomic<uint64_t> LastUsed = 0;
+		};
+
+		struct Shard
+		{
+			mutable std::shared_mutex Mutex;
+			std::unordered_map<AssetHandle, AssetSlot> Assets;
+			std::unordered_map<AssetHandle, std::unordered_set<AssetHandle>> Dependencies; // asset handle -> assets that it depends on
+		};
+
+		static constexpr uint32_t ShardCount = 64;
+		static constexpr uint32_t MaxAssetTypes = 16;
+
+		Shard& GetShard(AssetHandle handle) { return m_Shards[(uint64_t(handle) * 0x9E3779B97F4A7C15ull) >> 58]; }
+
+		AssetMetadata GetMetadata(AssetHandle handle) const;
+		Ref<Asset> LoadAsset(const AssetMetadata& metadata);
+		void TrimResidency(AssetType type);
+		void UpdateDependents(AssetHandle handle);
+
+	private:
+		Ref<AssetPack> m_AssetPack;
+		std::array<Shard, ShardCount> m_Shards;
+
+		std::atomic<uint64_t> m_UseCounter = 0;
+		std::array<std::atomic<uint64_t>, MaxAssetTypes> m_ResidentBytes{};
+		std::array<std::atomic<uint64_t>, MaxAssetTypes> m_Budgets{};
+
+		std::unordered_map<AssetHandle, Ref<Asset>> m_LoadedAssetsSnapshot;
+	};
+
+}
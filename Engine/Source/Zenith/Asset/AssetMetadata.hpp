@@ -20,6 +20,8 @@ namespace Zenith {
 		AssetStatus Status = AssetStatus::None;
 
 		uint64_t FileLastWriteTime = 0; // TODO: this is the last write time of the file WE LOADED
+		uint64_t ContentHash = 0;       // xxHash64 of the file we loaded, 0 = unknown
+		uint32_t ImporterVersion = 0;   // AssetSerializer::GetVersion() of the serializer that loaded it
 		bool IsDataLoaded = false;
 
 		bool IsValid() const { return Handle != 0; }
@@ -0,0 +1,155 @@
+#include "znpch.hpp"
+#include "AssetPack.hpp"
+
+#include "Zenith/Core/Hash.hpp"
+#include "Zenith/Utilities/Compression.hpp"
+
+namespace Zenith {
+
+	Ref<AssetPack> AssetPack::Open(const std::filesystem::path& filepath)
+	{
+		Ref<AssetPack> pack = Ref<AssetPack>::Create();
+		if (!pack->Load(filepath))
+			return nullptr;
+
+		ZN_CORE_INFO_TAG("AssetManager", "Opened asset pack {} ({} assets)", filepath.string(), pack->GetAssetCount());
+		return pack;
+	}
+
+	bool AssetPack::Load(const std::filesystem::path& filepath)
+	{
+		ZN_PROFILE_FUNC();
+
+		m_FilePath = filepath;
+		if (!m_File.Open(filepath))
+			return false;
+
+		const byte* data = m_File.GetData();
+		const uint64_t size = m_File.GetSize();
+
+		AssetPackFile::FileHeader expected;
+		if (size < sizeof(AssetPackFile::FileHeader))
+		{
+			ZN_CORE_ERROR_TAG("AssetManager", "Asset pack {} is truncated", filepath.string());
+			return false;
+		}
+
+		memcpy(&m_Header, data, sizeof(AssetPackFile::FileHeader));
+		if (memcmp(m_Header.HEADER, expected.HEADER, sizeof(expected.HEADER)) != 0 || m_Header.Version != expected.Version)
+		{
+			ZN_CORE_ERROR_TAG("AssetManager", "{} is not a supported asset pack (version {})", filepath.string(), m_Header.Version);
+			return false;
+		}
+
+		const uint64_t tocSize = uint64_t(m_Header.EntryCount) * sizeof(AssetPackFile::TOCEntry);
+		const uint64_t slotSize = uint64_t(m_Header.SlotCount) * sizeof(uint32_t);
+		const bool slotCountValid = m_Header.SlotCount > m_Header.EntryCount && (m_Header.SlotCount & (m_Header.SlotCount - 1)) == 0;
+		if (!slotCountValid
+			|| m_Header.TOCOffset + tocSize > size
+			|| m_Header.SlotOffset + slotSize > size
+			|| m_Header.StringTableOffset + m_Header.StringTableSize > size
+			|| m_Header.TOCOffset % alignof(AssetPackFile::TOCEntry) != 0
+			|| m_Header.SlotOffset % alignof(uint32_t) != 0)
+		{
+			ZN_CORE_ERROR_TAG("AssetManager", "Asset pack {} has a corrupt table of contents", filepath.string());
+			return false;
+		}
+
+		m_Entries = reinterpret_cast<const AssetPackFile::TOCEntry*>(data + m_Header.TOCOffset);
+		m_Slots = reinterpret_cast<const uint32_t*>(data + m_Header.SlotOffset);
+		m_StringTable = reinterpret_cast<const char*>(data + m_Header.StringTableOffset);
+
+		for (const AssetPackFile::TOCEntry& entry : *this)
+		{
+			if (entry.Offset + entry.Size > size || entry.PathOffset >= m_Header.StringTableSize)
+			{
+				ZN_CORE_ERROR_TAG("AssetManager", "Asset pack {} references data outside the file", filepath.string());
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	const AssetPackFile::TOCEntry* AssetPack::GetEntry(AssetHandle handle) const
+	{
+		if (!m_Entries)
+			return nullptr;
+
+		// Bounded, a damaged slot table may have no empty slot
+		const uint32_t mask = m_Header.SlotCount - 1;
+		uint32_t slot = AssetPackFile::GetSlot(handle, m_Header.SlotCount);
+		for (uint32_t probe = 0; probe < m_Header.SlotCount; probe++, slot = (slot + 1) & mask)
+		{
+			const uint32_t index = m_Slots[slot];
+			if (index == AssetPackFile::EmptySlot || index >= m_Header.EntryCount)
+				return nullptr;
+
+			if (m_Entries[index].Handle == (uint64_t)handle)
+				return &m_Entries[index];
+		}
+		return nullptr;
+	}
+
+	AssetType AssetPack::GetAssetType(AssetHandle handle) const
+	{
+		const AssetPackFile::TOCEntry* entry = GetEntry(handle);
+		return entry ? (AssetType)entry->Type : AssetType::None;
+	}
+
+	std::string_view AssetPack::GetAssetPath(AssetHandle handle) const
+	{
+		const AssetPackFile::TOCEntry* entry = GetEntry(handle);
+		return entry ? std::string_view(m_StringTable + entry->PathOffset) : std::string_view();
+	}
+
+	Buffer AssetPack::GetMappedData(AssetHandle handle) const
+	{
+		const AssetPackFile::TOCEntry* entry = GetEntry(handle);
+		if (!entry || (CompressionType)entry->Compression != CompressionType::None)
+			return {};
+
+		return Buffer(m_File.GetData() + entry->Offset, entry->Size);
+	}
+
+	Buffer AssetPack::ReadAsset(AssetHandle handle) const
+	{
+		ZN_PROFILE_FUNC();
+
+		const AssetPackFile::TOCEntry* entry = GetEntry(handle);
+		if (!entry)
+			return {};
+
+		const byte* stored = m_File.GetData() + entry->Offset;
+
+		Buffer buffer;
+		switch ((CompressionType)entry->Compression)
+		{
+			case CompressionType::None:
+				buffer = Buffer::Copy(stored, entry->Size);
+				break;
+			case CompressionType::LZ:
+				buffer.Allocate(entry->UncompressedSize);
+				if (!Compression::DecompressLZ(stored, entry->Size, buffer.Data, buffer.Size))
+				{
+					ZN_CORE_ERROR_TAG("AssetManager", "Failed to decompress asset {} from {}", handle, m_FilePath.string());
+					buffer.Release();
+					return {};
+				}
+				break;
+			default:
+				ZN_CORE_ERROR_TAG("AssetManager", "Unknown compression for asset {} in {}", handle, m_FilePath.string());
+				return {};
+		}
+
+		if (CRC32Hash::compute(std::string_view(buffer.As<const char>(), buffer.Size)) != entry->Checksum)
+		{
+			ZN_CORE_ERROR_TAG("AssetManager", "Checksum mismatch for asset {} in {}", handle, m_FilePath.string());
+			buffer.Release();
+			return {};
+		}
+
+		return buffer;
+	}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "AssetPackFile.hpp"
+
+#include "Zenith/Asset/Asset.hpp"
+#include "Zenith/Asset/AssetTypes.hpp"
+#include "Zenith/Core/Buffer.hpp"
+#include "Zenith/Utilities/MappedFile.hpp"
+
+#include <string_view>
+
+namespace Zenith {
+
+	// Memory-mapped .zpak reader. Lookups never touch the disk, blob pages are read on demand.
+	// All queries are const and safe to call from any thread.
+	class AssetPack : public RefCounted
+	{
+	public:
+		// Returns nullptr if the file is missing or not a valid pack
+		static Ref<AssetPack> Open(const std::filesystem::path& filepath);
+
+		bool Contains(AssetHandle handle) const { return GetEntry(handle) != nullptr; }
+		const AssetPackFile::TOCEntry* GetEntry(AssetHandle handle) const;
+
+		AssetType GetAssetType(AssetHandle handle) const;
+		std::string_view GetAssetPath(AssetHandle handle) const;
+
+		// Non-owning view into the mapping, only valid for uncompressed entries and while the pack is alive
+		Buffer GetMappedData(AssetHandle handle) const;
+
+		// Owned copy of the asset data, decompressed and checksum-verified. Caller releases.
+		Buffer ReadAsset(AssetHandle handle) const;
+
+		uint32_t GetAssetCount() const { return m_Header.EntryCount; }
+		const AssetPackFile::TOCEntry* begin() const { return m_Entries; }
+		const AssetPackFile::TOCEntry* end() const { return m_Entries + m_Header.EntryCount; }
+
+		const std::filesystem::path& GetFilePath() const { return m_FilePath; }
+
+	private:
+		bool Load(const std::filesystem::path& filepath);
+
+	private:
+		std::filesystem::path m_FilePath;
+		MappedFile m_File;
+
+		AssetPackFile::FileHeader m_Header;
+		const AssetPackFile::TOCEntry* m_Entries = nullptr;
+		const uint32_t* m_Slots = nullptr;
+		const char* m_StringTable = nullptr;
+	};
+
+}
@@ -0,0 +1,59 @@
+#include "znpch.hpp"
+#include "AssetPackBuilder.hpp"
+
+#include "Zenith/Asset/AssetRegistrySerializer.hpp"
+#include "Zenith/Project/Project.hpp"
+#include "Zenith/Project/ProjectSerializer.hpp"
+#include "Zenith/Utilities/FileSystem.hpp"
+
+namespace Zenith {
+
+	bool AssetPackBuilder::BuildFromProject(const std::filesystem::path& projectFile, const std::filesystem::path& outputPath, const AssetPackSettings& settings)
+	{
+		Ref<Project> project = Ref<Project>::Create();
+		ProjectSerializer serializer(project);
+		if (!serializer.Deserialize(projectFile))
+			return false;
+
+		const ProjectConfig& config = project->GetConfig();
+		return BuildFromRegistry(std::filesystem::path(config.ProjectDirectory) / config.AssetRegistryPath, project->GetAssetDirectory(), outputPath, settings);
+	}
+
+	bool AssetPackBuilder::BuildFromRegistry(const std::filesystem::path& registryPath, const std::filesystem::path& assetDirectory,
+		const std::filesystem::path& outputPath, const AssetPackSettings& settings)
+	{
+		ZN_PROFILE_FUNC();
+
+		std::vector<AssetMetadata> entries;
+		AssetRegistrySerializer registry(registryPath);
+		if (!FileSystem::Exists(registryPath) || !registry.Deserialize(entries))
+		{
+			ZN_CORE_ERROR_TAG("AssetManager", "Failed to read asset registry {}", registryPath.string());
+			return false;
+		}
+
+		AssetPackWriter writer(settings);
+		uint32_t missingCount = 0;
+
+		for (const AssetMetadata& metadata : entries)
+		{
+			const std::filesystem::path absolutePath = assetDirectory / metadata.FilePath;
+			if (metadata.Type == AssetType::None || !FileSystem::Exists(absolutePath))
+			{
+				ZN_CORE_WARN_TAG("AssetManager", "Skipping {} asset {} ({})", Utils::AssetTypeToString(metadata.Type), metadata.Handle, metadata.FilePath.string());
+				missingCount++;
+				continue;
+			}
+
+			Buffer buffer = FileSystem::ReadBytes(absolutePath);
+			writer.AddAsset(metadata.Handle, metadata.Type, metadata.FilePath.generic_string(), buffer);
+			buffer.Release();
+		}
+
+		if (missingCount)
+			ZN_CORE_WARN_TAG("AssetManager", "{} registry entries could not be packed", missingCount);
+
+		return writer.Write(outputPath);
+	}
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "AssetPackWriter.hpp"
+
+namespace Zenith {
+
+	// Cooks a project's asset registry into a .zpak, keeping the registry handles and asset-relative paths
+	class AssetPackBuilder
+	{
+	public:
+		static bool BuildFromProject(const std::filesystem::path& projectFile, const std::filesystem::path& outputPath, const AssetPackSettings& settings = {});
+		static bool BuildFromRegistry(const std::filesystem::path& registryPath, const std::filesystem::path& assetDirectory,
+			const std::filesystem::path& outputPath, const AssetPackSettings& settings = {});
+	};
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Zenith/Core/Base.hpp"
+
+namespace Zenith {
+
+	// .zpak layout: FileHeader | blobs (each at a multiple of Alignment) | TOCEntry[EntryCount] sorted by handle
+	//               | uint32_t slots[SlotCount] (open addressing, entry index or EmptySlot) | string table
+	struct AssetPackFile
+	{
+		enum class EntryFlags : uint16_t
+		{
+			Compressed = BIT(0)
+		};
+
+		static constexpr uint32_t EmptySlot = 0xffffffff;
+
+		struct TOCEntry
+		{
+			uint64_t Handle;
+			uint64_t Offset;           // From the start of the file, deduplicated blobs share it
+			uint64_t Size;             // Stored size
+			uint64_t UncompressedSize;
+			uint32_t PathOffset;       // Null-terminated asset path in the string table
+			uint32_t Checksum;         // CRC32 of the uncompressed data
+			uint16_t Type;             // AssetType
+			uint16_t Flags;            // EntryFlags
+			uint8_t Compression;       // CompressionType
+			uint8_t Padding[3];
+		};
+
+		struct FileHeader
+		{
+			const char HEADER[4] = { 'Z','P','A','K' };
+			uint32_t Version = 1;
+			uint32_t Alignment = 64;
+			uint32_t EntryCount = 0;
+			uint32_t SlotCount = 0;    // Power of two
+			uint32_t Padding = 0;
+			uint64_t TOCOffset = 0;
+			uint64_t SlotOffset = 0;
+			uint64_t StringTableOffset = 0;
+			uint64_t StringTableSize = 0;
+		};
+
+		static_assert(sizeof(TOCEntry) == 48);
+
+		static uint32_t GetSlot(uint64_t handle, uint32_t slotCount)
+		{
+			// Handles are random, the multiply only guards against sequential ones
+			return static_cast<uint32_t>((handle * 0x9E3779B97F4A7C15ull) >> 32) & (slotCount - 1);
+		}
+	};
+
+}
@@ -0,0 +1,220 @@
+#include "znpch.hpp"
+#include "AssetPackWriter.hpp"
+
+#include "Zenith/Serialization/FileStream.hpp"
+#include "Zenith/Utilities/FileSystem.hpp"
+
+namespace Zenith {
+
+	namespace Utils {
+
+		static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		static void PadTo(StreamWriter& stream, uint64_t position)
+		{
+			const uint64_t current = stream.GetStreamPosition();
+			if (position > current)
+				stream.WriteZero(position - current);
+		}
+
+	}
+
+	AssetPackWriter::AssetPackWriter(const AssetPackSettings& settings)
+		: m_Settings(settings)
+	{
+		ZN_CORE_ASSERT(settings.Alignment && (settings.Alignment & (settings.Alignment - 1)) == 0, "Asset pack alignment must be a power of two");
+	}
+
+	AssetPackWriter::~AssetPackWriter()
+	{
+		for (Blob& blob : m_Blobs)
+			blob.Data.Release();
+	}
+
+	void AssetPackWriter::AddAsset(AssetHandle handle, AssetType type, const std::string& path, const Buffer& data)
+	{
+		ZN_PROFILE_FUNC();
+
+		const SHA256Hash::HashValue contentHash = SHA256Hash::compute(static_cast<const uint8_t*>(data.Data), data.Size);
+
+		uint32_t blobIndex;
+		if (auto it = m_BlobLookup.find(contentHash); it != m_BlobLookup.end())
+		{
+			blobIndex = it->second;
+		}
+		else
+		{
+			Blob& blob = m_Blobs.emplace_back();
+			blob.UncompressedSize = data.Size;
+			blob.Checksum = CRC32Hash::compute(std::string_view(data.As<const char>(), data.Size));
+
+			if (m_Settings.Compress)
+			{
+				Buffer compressed = Compression::CompressLZ(data.Data, data.Size);
+				if (compressed && compressed.Size <= data.Size * (1.0f - m_Settings.MinCompressionSavings))
+				{
+					blob.Data = compressed;
+					blob.Compression = CompressionType::LZ;
+				}
+				else
+				{
+					compressed.Release();
+				}
+			}
+
+			if (blob.Compression == CompressionType::None)
+				blob.Data = Buffer::Copy(data);
+
+			blobIndex = static_cast<uint32_t>(m_Blobs.size() - 1);
+			m_BlobLookup[contentHash] = blobIndex;
+		}
+
+		Entry entry{ handle, type, path, blobIndex };
+		if (auto it = m_EntryLookup.find(handle); it != m_EntryLookup.end())
+		{
+			m_SourceBytes -= m_Blobs[m_Entries[it->second].BlobIndex].UncompressedSize;
+			m_Entries[it->second] = std::move(entry);
+		}
+		else
+		{
+			m_EntryLookup[handle] = m_Entries.size();
+			m_Entries.push_back(std::move(entry));
+		}
+		m_SourceBytes += data.Size;
+	}
+
+	bool AssetPackWriter::Write(const std::filesystem::path& filepath)
+	{
+		ZN_PROFILE_FUNC();
+
+		std::vector<Entry> entries = m_Entries;
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return (uint64_t)a.Handle < (uint64_t)b.Handle; });
+
+		std::vector<char> stringTable;
+		std::vector<AssetPackFile::TOCEntry> toc(entries.size());
+
+		AssetPackFile::FileHeader header;
+		header.Alignment = m_Settings.Alignment;
+		header.EntryCount = static_cast<uint32_t>(entries.size());
+		header.SlotCount = 1;
+		while (header.SlotCount < header.EntryCount * 2)
+			header.SlotCount <<= 1;
+		if (header.SlotCount <= header.EntryCount)
+			header.SlotCount <<= 1;
+
+		std::filesystem::path tempPath = filepath;
+		tempPath += ".tmp";
+
+		{
+			FileStreamWriter stream(tempPath);
+			if (!stream.IsStreamGood())
+			{
+				ZN_CORE_ERROR_TAG("AssetManager", "Failed to open {} for writing", tempPath.string());
+				return false;
+			}
+
+			stream.WriteRaw(header);
+
+			for (Blob& blob : m_Blobs)
+			{
+				blob.Offset = Utils::AlignUp(stream.GetStreamPosition(), m_Settings.Alignment);
+				Utils::PadTo(stream, blob.Offset);
+				stream.WriteData(blob.Data.As<const char>(), blob.Data.Size);
+			}
+
+			for (size_t i = 0; i < entries.size(); i++)
+			{
+				const Entry& entry = entries[i];
+				const Blob& blob = m_Blobs[entry.BlobIndex];
+
+				AssetPackFile::TOCEntry& tocEntry = toc[i];
+				memset(&tocEntry, 0, sizeof(tocEntry));
+				tocEntry.Handle = entry.Handle;
+				tocEntry.Offset = blob.Offset;
+				tocEntry.Size = blob.Data.Size;
+				tocEntry.UncompressedSize = blob.UncompressedSize;
+				tocEntry.PathOffset = static_cast<uint32_t>(stringTable.size());
+				tocEntry.Checksum = blob.Checksum;
+				tocEntry.Type = (uint16_t)entry.Type;
+				tocEntry.Compression = (uint8_t)blob.Compression;
+				if (blob.Compression != CompressionType::None)
+					tocEntry.Flags |= (uint16_t)AssetPackFile::EntryFlags::Compressed;
+
+				stringTable.insert(stringTable.end(), entry.Path.begin(), entry.Path.end());
+				stringTable.push_back('\0');
+			}
+			if (stringTable.empty())
+				stringTable.push_back('\0');
+
+			std::vector<uint32_t> slots(header.SlotCount, AssetPackFile::EmptySlot);
+			for (uint32_t i = 0; i < header.EntryCount; i++)
+			{
+				uint32_t slot = AssetPackFile::GetSlot(toc[i].Handle, header.SlotCount);
+				while (slots[slot] != AssetPackFile::EmptySlot)
+					slot = (slot + 1) & (header.SlotCount - 1);
+				slots[slot] = i;
+			}
+
+			header.TOCOffset = Utils::AlignUp(stream.GetStreamPosition(), alignof(AssetPackFile::TOCEntry));
+			Utils::PadTo(stream, header.TOCOffset);
+			stream.WriteData(reinterpret_cast<const char*>(toc.data()), toc.size() * sizeof(AssetPackFile::TOCEntry));
+
+			header.SlotOffset = stream.GetStreamPosition();
+			stream.WriteData(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(uint32_t));
+
+			header.StringTableOffset = stream.GetStreamPosition();
+			header.StringTableSize = stringTable.size();
+			stream.WriteData(stringTable.data(), stringTable.size());
+
+			stream.SetStreamPosition(0);
+			stream.WriteRaw(header);
+
+			if (!stream.IsStreamGood())
+			{
+				ZN_CORE_ERROR_TAG("AssetManager", "Failed to write asset pack {}", tempPath.string());
+				return false;
+			}
+		}
+
+		if (!FileSystem::FlushToDisk(tempPath))
+		{
+			ZN_CORE_ERROR_TAG("AssetManager", "Failed to flush {} to disk", tempPath.string());
+			return false;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, filepath, error);
+		if (error)
+		{
+			ZN_CORE_ERROR_TAG("AssetManager", "Failed to move {} into place: {}", tempPath.string(), error.message());
+			return false;
+		}
+
+		if (!FileSystem::FlushToDisk(filepath.parent_path()))
+			ZN_CORE_WARN_TAG("AssetManager", "Failed to flush the directory of {} to disk", filepath.string());
+
+		const Statistics stats = GetStatistics();
+		ZN_CORE_INFO_TAG("AssetManager", "Wrote asset pack {}: {} assets, {} unique blobs ({} compressed), {} -> {} bytes",
+			filepath.string(), stats.AssetCount, stats.BlobCount, stats.CompressedBlobCount, stats.SourceBytes, stats.StoredBytes);
+		return true;
+	}
+
+	AssetPackWriter::Statistics AssetPackWriter::GetStatistics() const
+	{
+		Statistics stats;
+		stats.AssetCount = static_cast<uint32_t>(m_Entries.size());
+		stats.BlobCount = static_cast<uint32_t>(m_Blobs.size());
+		stats.SourceBytes = m_SourceBytes;
+		for (const Blob& blob : m_Blobs)
+		{
+			stats.StoredBytes += blob.Data.Size;
+			if (blob.Compression != CompressionType::None)
+				stats.CompressedBlobCount++;
+		}
+		return stats;
+	}
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "AssetPackFile.hpp"
+
+#include "Zenith/Asset/Asset.hpp"
+#include "Zenith/Asset/AssetTypes.hpp"
+#include "Zenith/Core/Buffer.hpp"
+#include "Zenith/Core/Hash.hpp"
+#include "Zenith/Utilities/Compression.hpp"
+
+#include <filesystem>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace Zenith {
+
+	struct AssetPackSettings
+	{
+		uint32_t Alignment = 64;            // Blob alignment, power of two
+		bool Compress = true;
+		float MinCompressionSavings = 0.1f; // Blobs that shrink less than this are stored uncompressed
+	};
+
+	// Builds a .zpak. Identical asset data is stored once, whatever handle it is added under.
+	class AssetPackWriter
+	{
+	public:
+		struct Statistics
+		{
+			uint32_t AssetCount = 0;
+			uint32_t BlobCount = 0;
+			uint32_t CompressedBlobCount = 0;
+			uint64_t SourceBytes = 0;  // Sum over all assets, before deduplication
+			uint64_t StoredBytes = 0;  // Sum over unique blobs as written
+		};
+
+		explicit AssetPackWriter(const AssetPackSettings& settings = {});
+		~AssetPackWriter();
+
+		AssetPackWriter(const AssetPackWriter&) = delete;
+		AssetPackWriter& operator=(const AssetPackWriter&) = delete;
+
+		// Copies data. Adding a handle twice replaces the earlier entry.
+		void AddAsset(AssetHandle handle, AssetType type, const std::string& path, const Buffer& data);
+
+		// Writes to a temporary file first so an existing pack is only replaced once complete
+		bool Write(const std::filesystem::path& filepath);
+
+		Statistics GetStatistics() const;
+
+	private:
+		struct Blob
+		{
+			Buffer Data;
+			uint64_t UncompressedSize = 0;
+			uint32_t Checksum = 0;
+			CompressionType Compression = CompressionType::None;
+			uint64_t Offset = 0;
+		};
+
+		struct Entry
+		{
+			AssetHandle Handle;
+			AssetType Type;
+			std::string Path;
+			uint32_t BlobIndex;
+		};
+
+		AssetPackSettings m_Settings;
+
+		std::vector<Blob> m_Blobs;
+		std::map<SHA256Hash::HashValue, uint32_t> m_BlobLookup;
+
+		std::vector<Entry> m_Entries;
+		std::unordered_map<AssetHandle, size_t> m_EntryLookup;
+		uint64_t m_SourceBytes = 0;
+	};
+
+}
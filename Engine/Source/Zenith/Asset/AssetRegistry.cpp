@@ -12,6 +12,18 @@ namespace Zenith {
 #define ASSET_LOG(...)
 #endif
 
+	namespace Utils {
+
+		// Same key for "a/b", "a\\b" and "a/./b" on every platform (the registry file always uses '/')
+		static std::string NormalizeAssetPath(const std::filesystem::path& filepath)
+		{
+			std::string path = filepath.generic_string();
+			std::replace(path.begin(), path.end(), '\\', '/');
+			return std::filesystem::path(path).lexically_normal().generic_string();
+		}
+
+	}
+
 	const AssetMetadata& AssetRegistry::Get(const AssetHandle handle) const
 	{
 		ZN_CORE_ASSERT(m_AssetRegistry.find(handle) != m_AssetRegistry.end());
@@ -24,7 +36,21 @@ namespace Zenith {
 		ZN_CORE_ASSERT(metadata.Handle == handle);
 		ZN_CORE_ASSERT(handle != 0);
 		// ZN_CORE_ASSERT(Application::IsMainThread(), "AssetRegistry::Set() has been called from other than the main thread!"); // Refer comments in EditorAssetManager
-		m_AssetRegistry[handle] = metadata;
+
+		auto [it, inserted] = m_AssetRegistry.try_emplace(handle, metadata);
+		if (!inserted)
+		{
+			if (it->second.FilePath != metadata.FilePath)
+			{
+				auto indexed = m_PathIndex.find(Utils::NormalizeAssetPath(it->second.FilePath));
+				if (indexed != m_PathIndex.end() && indexed->second == handle)
+					m_PathIndex.erase(indexed);
+			}
+			it->second = metadata;
+		}
+
+		if (!metadata.FilePath.empty())
+			m_PathIndex[Utils::NormalizeAssetPath(metadata.FilePath)] = handle;
 	}
 
 	bool AssetRegistry::Contains(const AssetHandle handle) const
@@ -33,16 +59,32 @@ namespace Zenith {
 		return m_AssetRegistry.find(handle) != m_AssetRegistry.end();
 	}
 
+	AssetHandle AssetRegistry::GetHandle(const std::filesystem::path& filepath) const
+	{
+		auto it = m_PathIndex.find(Utils::NormalizeAssetPath(filepath));
+		return it != m_PathIndex.end() ? it->second : AssetHandle::null();
+	}
+
 	size_t AssetRegistry::Remove(const AssetHandle handle)
 	{
 		ASSET_LOG("Removing handle", handle);
-		return m_AssetRegistry.erase(handle);
+		auto it = m_AssetRegistry.find(handle);
+		if (it == m_AssetRegistry.end())
+			return 0;
+
+		auto indexed = m_PathIndex.find(Utils::NormalizeAssetPath(it->second.FilePath));
+		if (indexed != m_PathIndex.end() && indexed->second == handle)
+			m_PathIndex.erase(indexed);
+
+		m_AssetRegistry.erase(it);
+		return 1;
 	}
 
 	void AssetRegistry::Clear()
 	{
 		ASSET_LOG("Clearing registry");
 		m_AssetRegistry.clear();
+		m_PathIndex.clear();
 	}
 
 }
\ No newline at end of file
@@ -21,6 +21,9 @@ namespace Zenith {
 
 		size_t Count() const { return m_AssetRegistry.size(); }
 		bool Contains(const AssetHandle handle) const;
+
+		// O(1) lookup through the path index. Returns a null handle if no asset has this (relative) path.
+		AssetHandle GetHandle(const std::filesystem::path& filepath) const;
 		size_t Remove(const AssetHandle handle);
 		void Clear();
 
@@ -30,6 +33,7 @@ namespace Zenith {
 		auto end() const { return m_AssetRegistry.cend(); }
 	private:
 		std::unordered_map<AssetHandle, AssetMetadata> m_AssetRegistry;
+		std::unordered_map<std::string, AssetHandle> m_PathIndex; // normalized file path -> handle, kept in step by Set()/Remove()/Clear()
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Zenith/Core/Base.hpp"
+
+namespace Zenith {
+
+	// Registry snapshot layout: FileHeader | Entry[EntryCount] sorted by handle | path string table
+	// Journal layout (<registry>.journal): JournalHeader | (RecordHeader | record payload)...
+	// Record payload: JournalOp (1 byte) | handle (8 bytes) | AssetType (2 bytes) | content hash (8 bytes) | last write time (8 bytes)
+	//                | importer version (4 bytes) | path bytes. Remove has only the op and handle.
+	// Version 1 files have no hash, write time or importer version and are still read.
+	struct AssetRegistryFile
+	{
+		enum class JournalOp : uint8_t
+		{
+			Add = 1, Modify = 2, Remove = 3
+		};
+
+		struct FileHeader
+		{
+			const char HEADER[4] = { 'Z','N','R','G' };
+			uint32_t Version = 2;
+			uint32_t EntryCount = 0;
+			uint32_t Checksum = 0;      // CRC32 of everything after the header
+			uint64_t StringTableSize = 0;
+		};
+
+		struct Entry
+		{
+			uint64_t Handle;
+			uint64_t ContentHash;       // xxHash64 of the file when it was last loaded, 0 = unknown
+			uint64_t FileLastWriteTime;
+			uint32_t PathOffset;
+			uint32_t PathLength;
+			uint32_t ImporterVersion;
+			uint16_t Type;              // AssetType
+			uint16_t Padding;
+		};
+
+		struct EntryV1
+		{
+			uint64_t Handle;
+			uint32_t PathOffset;
+			uint32_t PathLength;
+			uint16_t Type;
+			uint16_t Padding[3];
+		};
+
+		struct JournalHeader
+		{
+			const char HEADER[4] = { 'Z','N','R','J' };
+			uint32_t Version = 2;
+		};
+
+		struct RecordHeader
+		{
+			uint32_t PayloadSize;
+			uint32_t Checksum;          // CRC32 of the payload, a torn write at the end of the journal fails this
+		};
+
+		static_assert(sizeof(Entry) == 40);
+		static_assert(sizeof(EntryV1) == 24);
+	};
+
+}
@@ -0,0 +1,540 @@
+#include "znpch.hpp"
+#include "AssetRegistrySerializer.hpp"
+
+#include "Zenith/Core/Hash.hpp"
+#include "Zenith/Serialization/FileStream.hpp"
+#include "Zenith/Utilities/FileSystem.hpp"
+
+#include <nlohmann/json.hpp>
+
+namespace Zenith {
+
+	namespace Utils {
+
+		// Rewriting the snapshot is O(registry), so let the journal grow to a fraction of it first
+		static constexpr uint64_t MinJournalRecordsBeforeCompaction = 1024;
+
+		// Offsets into a journal record payload
+		static constexpr size_t RecordHandleOffset = sizeof(uint8_t);
+		static constexpr size_t RecordTypeOffset = RecordHandleOffset + sizeof(uint64_t);
+		static constexpr size_t RecordContentHashOffset = RecordTypeOffset + sizeof(uint16_t);
+		static constexpr size_t RecordWriteTimeOffset = RecordContentHashOffset + sizeof(uint64_t);
+		static constexpr size_t RecordImporterVersionOffset = RecordWriteTimeOffset + sizeof(uint64_t);
+		static constexpr size_t RecordPathOffset = RecordImporterVersionOffset + sizeof(uint32_t);
+		static constexpr size_t RecordPathOffsetV1 = RecordContentHashOffset;
+
+		static std::string SerializablePath(const std::filesystem::path& filepath)
+		{
+			// Normalize path separators for cross-platform compatibility
+			std::string path = filepath.generic_string();
+			std::replace(path.begin(), path.end(), '\\', '/');
+			return path;
+		}
+
+		template<typename T>
+		static void Append(std::vector<char>& out, const T& value)
+		{
+			const char* bytes = reinterpret_cast<const char*>(&value);
+			out.insert(out.end(), bytes, bytes + sizeof(T));
+		}
+
+		template<typename T>
+		static T Read(const byte* data)
+		{
+			T value;
+			memcpy(&value, data, sizeof(T));
+			return value;
+		}
+
+	}
+
+	AssetRegistrySerializer::AssetRegistrySerializer(const std::filesystem::path& registryPath)
+		: m_RegistryPath(registryPath)
+	{
+		m_JournalPath = registryPath;
+		m_JournalPath += ".journal";
+	}
+
+	bool AssetRegistrySerializer::Deserialize(std::vector<AssetMetadata>& outEntries)
+	{
+		ZN_PROFILE_FUNC();
+
+		std::scoped_lock lock(m_Mutex);
+		outEntries.clear();
+		m_JournalRecordCount = 0;
+		m_SnapshotOutdated = false;
+
+		if (FileSystem::Exists(m_RegistryPath))
+		{
+			Buffer data = FileSystem::ReadBytes(m_RegistryPath);
+
+			AssetRegistryFile::FileHeader expected;
+			bool success = true;
+			if (data.Size >= sizeof(expected.HEADER) && memcmp(data.Data, expected.HEADER, sizeof(expected.HEADER)) == 0)
+			{
+				success = DeserializeSnapshot(data, outEntries);
+			}
+			else if (data.Size > 0)
+			{
+				success = DeserializeJSON(data, outEntries);
+				m_SnapshotOutdated = true;
+			}
+			data.Release();
+
+			if (!success)
+			{
+				outEntries.clear();
+				m_SnapshotOutdated = true;
+				return false;
+			}
+		}
+		else
+		{
+			ZN_CORE_INFO("[AssetManager] Asset Registry file does not exist, will be created on first save");
+			m_SnapshotOutdated = true;
+		}
+
+		ReplayJournal(outEntries);
+		return true;
+	}
+
+	bool AssetRegistrySerializer::DeserializeSnapshot(const Buffer& data, std::vector<AssetMetadata>& outEntries)
+	{
+		AssetRegistryFile::FileHeader header;
+		if (data.Size < sizeof(header))
+		{
+			ZN_CORE_ERROR("[AssetManager] Asset Registry {} is truncated", m_RegistryPath.string());
+			return false;
+		}
+
+		memcpy(&header, data.Data, sizeof(header));
+		const bool isV1 = header.Version == 1;
+		if (header.Version != AssetRegistryFile::FileHeader().Version && !isV1)
+		{
+			ZN_CORE_ERROR("[AssetManager] Asset Registry {} has unsupported version {}", m_RegistryPath.string(), header.Version);
+			return false;
+		}
+
+		// Version 1 has no source state, rewrite it with the next save
+		if (isV1)
+			m_SnapshotOutdated = true;
+
+		const uint64_t entrySize = isV1 ? sizeof(AssetRegistryFile::EntryV1) : sizeof(AssetRegistryFile::Entry);
+		const uint64_t entriesSize = uint64_t(header.EntryCount) * entrySize;
+		const byte* body = data.As<const byte>() + sizeof(header);
+		const uint64_t bodySize = data.Size - sizeof(header);
+		if (entriesSize + header.StringTableSize != bodySize
+			|| CRC32Hash::compute(std::string_view(reinterpret_cast<const char*>(body), bodySize)) != header.Checksum)
+		{
+			ZN_CORE_ERROR("[AssetManager] Asset Registry {} is corrupt", m_RegistryPath.string());
+			return false;
+		}
+
+		const char* stringTable = reinterpret_cast<const char*>(body + entriesSize);
+
+		outEntries.reserve(header.EntryCount);
+		for (uint32_t i = 0; i < header.EntryCount; i++)
+		{
+			AssetRegistryFile::Entry entry = {};
+			if (isV1)
+			{
+				const auto entryV1 = Utils::Read<AssetRegistryFile::EntryV1>(body + i * entrySize);
+				entry.Handle = entryV1.Handle;
+				entry.PathOffset = entryV1.PathOffset;
+				entry.PathLength = entryV1.PathLength;
+				entry.Type = entryV1.Type;
+			}
+			else
+			{
+				entry = Utils::Read<AssetRegistryFile::Entry>(body + i * entrySize);
+			}
+
+			if (uint64_t(entry.PathOffset) + entry.PathLength > header.StringTableSize)
+			{
+				ZN_CORE_ERROR("[AssetManager] Asset Registry {} is corrupt", m_RegistryPath.string());
+				return false;
+			}
+
+			AssetMetadata& metadata = outEntries.emplace_back();
+			metadata.Handle = AssetHandle(entry.Handle);
+			metadata.Type = (AssetType)entry.Type;
+			metadata.FilePath = std::string(stringTable + entry.PathOffset, entry.PathLength);
+			metadata.ContentHash = entry.ContentHash;
+			metadata.FileLastWriteTime = entry.FileLastWriteTime;
+			metadata.ImporterVersion = entry.ImporterVersion;
+		}
+
+		return true;
+	}
+
+	bool AssetRegistrySerializer::DeserializeJSON(const Buffer& data, std::vector<AssetMetadata>& outEntries)
+	{
+		nlohmann::json root;
+		try
+		{
+			root = nlohmann::json::parse(data.As<const char>(), data.As<const char>() + data.Size);
+		}
+		catch (const nlohmann::json::exception& e)
+		{
+			ZN_CORE_ERROR("[AssetManager] Failed to parse Asset Registry JSON: {}", e.what());
+			return false;
+		}
+
+		if (!root.contains("Assets") || !root["Assets"].is_array())
+		{
+			ZN_CORE_WARN("[AssetManager] Asset Registry missing 'Assets' array, treating as empty");
+			return true;
+		}
+
+		for (const auto& entry : root["Assets"])
+		{
+			if (!entry.contains("FilePath") || !entry.contains("Handle") || !entry.contains("Type"))
+			{
+				ZN_CORE_WARN("[AssetManager] Skipping malformed asset entry in registry");
+				continue;
+			}
+
+			try
+			{
+				AssetMetadata metadata;
+				metadata.Handle = AssetHandle(entry["Handle"].get<uint64_t>());
+				metadata.FilePath = entry["FilePath"].get<std::string>();
+				metadata.Type = Utils::AssetTypeFromString(entry["Type"].get<std::string>());
+
+				if (metadata.Type == AssetType::None)
+				{
+					ZN_CORE_WARN("[AssetManager] Unknown asset type in registry: {}", entry["Type"].get<std::string>());
+					continue;
+				}
+
+				outEntries.push_back(std::move(metadata));
+			}
+			catch (const std::exception& e)
+			{
+				ZN_CORE_WARN("[AssetManager] Failed to parse asset entry: {}", e.what());
+			}
+		}
+
+		ZN_CORE_INFO("[AssetManager] Read JSON asset registry, it will be converted to the binary format on next save");
+		return true;
+	}
+
+	void AssetRegistrySerializer::ReplayJournal(std::vector<AssetMetadata>& entries)
+	{
+		if (!FileSystem::Exists(m_JournalPath))
+			return;
+
+		Buffer data = FileSystem::ReadBytes(m_JournalPath);
+		const byte* bytes = data.As<const byte>();
+
+		AssetRegistryFile::JournalHeader expected;
+		const uint32_t version = data.Size >= sizeof(expected) ? Utils::Read<AssetRegistryFile::JournalHeader>(bytes).Version : 0;
+		if (data.Size < sizeof(expected)
+			|| memcmp(bytes, expected.HEADER, sizeof(expected.HEADER)) != 0
+			|| (version != expected.Version && version != 1))
+		{
+			if (data.Size > 0)
+				ZN_CORE_WARN("[AssetManager] Ignoring unreadable asset registry journal {}", m_JournalPath.string());
+			data.Release();
+			m_SnapshotOutdated = true;
+			return;
+		}
+
+		// New records must not be appended to a version 1 journal, compacting on the next save starts a new one
+		if (version != expected.Version)
+			m_SnapshotOutdated = true;
+		const size_t pathOffset = version == 1 ? Utils::RecordPathOffsetV1 : Utils::RecordPathOffset;
+
+		std::unordered_map<AssetHandle, size_t> indices;
+		indices.reserve(entries.size());
+		for (size_t i = 0; i < entries.size(); i++)
+			indices[entries[i].Handle] = i;
+
+		uint64_t offset = sizeof(expected);
+		uint64_t recordCount = 0;
+		while (offset + sizeof(AssetRegistryFile::RecordHeader) <= data.Size)
+		{
+			const auto record = Utils::Read<AssetRegistryFile::RecordHeader>(bytes + offset);
+			const byte* payload = bytes + offset + sizeof(record);
+			if (record.PayloadSize < Utils::RecordTypeOffset || offset + sizeof(record) + record.PayloadSize > data.Size
+				|| CRC32Hash::compute(std::string_view(reinterpret_cast<const char*>(payload), record.PayloadSize)) != record.Checksum)
+				break;
+
+			const auto op = (AssetRegistryFile::JournalOp)payload[0];
+			const AssetHandle handle = AssetHandle(Utils::Read<uint64_t>(payload + Utils::RecordHandleOffset));
+
+			if (op == AssetRegistryFile::JournalOp::Remove)
+			{
+				if (auto it = indices.find(handle); it != indices.end())
+				{
+					const size_t index = it->second;
+					indices.erase(it);
+					if (index != entries.size() - 1)
+					{
+						entries[index] = std::move(entries.back());
+						indices[entries[index].Handle] = index;
+					}
+					entries.pop_back();
+				}
+			}
+			else if ((op == AssetRegistryFile::JournalOp::Add || op == AssetRegistryFile::JournalOp::Modify) && record.PayloadSize >= pathOffset)
+			{
+				AssetMetadata metadata;
+				metadata.Handle = handle;
+				metadata.Type = (AssetType)Utils::Read<uint16_t>(payload + Utils::RecordTypeOffset);
+				metadata.FilePath = std::string(reinterpret_cast<const char*>(payload + pathOffset), record.PayloadSize - pathOffset);
+				if (version != 1)
+				{
+					metadata.ContentHash = Utils::Read<uint64_t>(payload + Utils::RecordContentHashOffset);
+					metadata.FileLastWriteTime = Utils::Read<uint64_t>(payload + Utils::RecordWriteTimeOffset);
+					metadata.ImporterVersion = Utils::Read<uint32_t>(payload + Utils::RecordImporterVersionOffset);
+				}
+
+				if (auto it = indices.find(handle); it != indices.end())
+				{
+					entries[it->second] = std::move(metadata);
+				}
+				else
+				{
+					indices[handle] = entries.size();
+					entries.push_back(std::move(metadata));
+				}
+			}
+			else
+			{
+				break;
+			}
+
+			offset += sizeof(record) + record.PayloadSize;
+			recordCount++;
+		}
+
+		const uint64_t journalSize = data.Size;
+		data.Release();
+
+		if (offset != journalSize)
+		{
+			// Most likely a write that was cut short. Drop it so new records are not appended after garbage.
+			ZN_CORE_WARN("[AssetManager] Discarding {} unreadable bytes at the end of {}", journalSize - offset, m_JournalPath.string());
+			std::error_code error;
+			std::filesystem::resize_file(m_JournalPath, offset, error);
+			if (error)
+				m_SnapshotOutdated = true;
+		}
+
+		m_JournalRecordCount = recordCount;
+		ZN_CORE_INFO("[AssetManager] Replayed {} asset registry journal records", recordCount);
+	}
+
+	void AssetRegistrySerializer::RecordSet(const AssetMetadata& metadata, bool isNew)
+	{
+		std::scoped_lock lock(m_Mutex);
+		AppendRecord(isNew ? AssetRegistryFile::JournalOp::Add : AssetRegistryFile::JournalOp::Modify, metadata);
+	}
+
+	void AssetRegistrySerializer::RecordRemove(AssetHandle handle)
+	{
+		std::scoped_lock lock(m_Mutex);
+		AssetMetadata metadata;
+		metadata.Handle = handle;
+		AppendRecord(AssetRegistryFile::JournalOp::Remove, metadata);
+	}
+
+	bool AssetRegistrySerializer::IsPersistedStateEqual(const AssetMetadata& a, const AssetMetadata& b)
+	{
+		return a.Handle == b.Handle && a.Type == b.Type && a.FilePath == b.FilePath
+			&& a.ContentHash == b.ContentHash && a.FileLastWriteTime == b.FileLastWriteTime && a.ImporterVersion == b.ImporterVersion;
+	}
+
+	void AssetRegistrySerializer::AppendRecord(AssetRegistryFile::JournalOp op, const AssetMetadata& metadata)
+	{
+		std::vector<char> payload;
+		Utils::Append(payload, (uint8_t)op);
+		Utils::Append(payload, (uint64_t)metadata.Handle);
+		if (op != AssetRegistryFile::JournalOp::Remove)
+		{
+			const std::string path = Utils::SerializablePath(metadata.FilePath);
+			payload.reserve(Utils::RecordPathOffset + path.size());
+			Utils::Append(payload, (uint16_t)metadata.Type);
+			Utils::Append(payload, metadata.ContentHash);
+			Utils::Append(payload, metadata.FileLastWriteTime);
+			Utils::Append(payload, metadata.ImporterVersion);
+			payload.insert(payload.end(), path.begin(), path.end());
+		}
+
+		AssetRegistryFile::RecordHeader record;
+		record.PayloadSize = (uint32_t)payload.size();
+		record.Checksum = CRC32Hash::compute(std::string_view(payload.data(), payload.size()));
+
+		Utils::Append(m_PendingRecords, record);
+		m_PendingRecords.insert(m_PendingRecords.end(), payload.begin(), payload.end());
+		m_PendingRecordCount++;
+	}
+
+	bool AssetRegistrySerializer::HasPendingChanges() const
+	{
+		std::scoped_lock lock(m_Mutex);
+		return m_PendingRecordCount > 0;
+	}
+
+	bool AssetRegistrySerializer::Flush()
+	{
+		ZN_PROFILE_FUNC();
+
+		std::scoped_lock lock(m_Mutex);
+		if (m_PendingRecordCount == 0)
+			return true;
+
+		std::error_code error;
+		const bool writeHeader = std::filesystem::file_size(m_JournalPath, error) < sizeof(AssetRegistryFile::JournalHeader) || error;
+
+		std::ofstream stream(m_JournalPath, std::ios::binary | std::ios::app);
+		if (writeHeader)
+		{
+			AssetRegistryFile::JournalHeader header;
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		}
+		stream.write(m_PendingRecords.data(), m_PendingRecords.size());
+		stream.flush();
+
+		if (!stream.good())
+		{
+			ZN_CORE_ERROR("[AssetManager] Failed to append to asset registry journal {}", m_JournalPath.string());
+			return false;
+		}
+
+		ZN_CORE_TRACE("[AssetManager] Appended {} asset registry changes", m_PendingRecordCount);
+		m_JournalRecordCount += m_PendingRecordCount;
+		m_PendingRecords.clear();
+		m_PendingRecordCount = 0;
+		return true;
+	}
+
+	bool AssetRegistrySerializer::NeedsCompaction(size_t entryCount) const
+	{
+		std::scoped_lock lock(m_Mutex);
+		const uint64_t journalRecords = m_JournalRecordCount + m_PendingRecordCount;
+		return m_SnapshotOutdated || journalRecords > std::max<uint64_t>(Utils::MinJournalRecordsBeforeCompaction, entryCount / 2);
+	}
+
+	bool AssetRegistrySerializer::Compact(const std::vector<AssetMetadata>& entries)
+	{
+		ZN_PROFILE_FUNC();
+
+		std::vector<const AssetMetadata*> sorted;
+		sorted.reserve(entries.size());
+		for (const AssetMetadata& metadata : entries)
+			sorted.push_back(&metadata);
+		std::sort(sorted.begin(), sorted.end(), [](const AssetMetadata* a, const AssetMetadata* b) { return (uint64_t)a->Handle < (uint64_t)b->Handle; });
+
+		std::vector<char> body(sorted.size() * sizeof(AssetRegistryFile::Entry));
+		for (size_t i = 0; i < sorted.size(); i++)
+		{
+			const std::string path = Utils::SerializablePath(sorted[i]->FilePath);
+
+			AssetRegistryFile::Entry entry = {};
+			entry.Handle = (uint64_t)sorted[i]->Handle;
+			entry.PathOffset = (uint32_t)(body.size() - sorted.size() * sizeof(AssetRegistryFile::Entry));
+			entry.PathLength = (uint32_t)path.size();
+			entry.ContentHash = sorted[i]->ContentHash;
+			entry.FileLastWriteTime = sorted[i]->FileLastWriteTime;
+			entry.ImporterVersion = sorted[i]->ImporterVersion;
+			entry.Type = (uint16_t)sorted[i]->Type;
+			memcpy(body.data() + i * sizeof(entry), &entry, sizeof(entry));
+
+			body.insert(body.end(), path.begin(), path.end());
+		}
+
+		AssetRegistryFile::FileHeader header;
+		header.EntryCount = (uint32_t)sorted.size();
+		header.StringTableSize = body.size() - sorted.size() * sizeof(AssetRegistryFile::Entry);
+		header.Checksum = CRC32Hash::compute(std::string_view(body.data(), body.size()));
+
+		std::scoped_lock lock(m_Mutex);
+
+		std::filesystem::path tempPath = m_RegistryPath;
+		tempPath += ".tmp";
+		{
+			FileStreamWriter stream(tempPath);
+			if (!stream.IsStreamGood())
+			{
+				ZN_CORE_ERROR("[AssetManager] Failed to open {} for writing", tempPath.string());
+				return false;
+			}
+
+			stream.WriteRaw(header);
+			stream.WriteData(body.data(), body.size());
+			if (!stream.IsStreamGood())
+			{
+				ZN_CORE_ERROR("[AssetManager] Failed to write asset registry {}", tempPath.string());
+				return false;
+			}
+		}
+
+		if (!FileSystem::FlushToDisk(tempPath))
+		{
+			ZN_CORE_ERROR("[AssetManager] Failed to flush {} to disk", tempPath.string());
+			return false;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, m_RegistryPath, error);
+		if (error)
+		{
+			ZN_CORE_ERROR("[AssetManager] Failed to move {} into place: {}", tempPath.string(), error.message());
+			return false;
+		}
+
+		if (!FileSystem::FlushToDisk(m_RegistryPath.parent_path()))
+			ZN_CORE_WARN("[AssetManager] Failed to flush the directory of {} to disk", m_RegistryPath.string());
+
+		// The snapshot now holds everything, start a new journal
+		{
+			std::ofstream journal(m_JournalPath, std::ios::binary | std::ios::trunc);
+			AssetRegistryFile::JournalHeader journalHeader;
+			journal.write(reinterpret_cast<const char*>(&journalHeader), sizeof(journalHeader));
+			if (!journal.good())
+				ZN_CORE_WARN("[AssetManager] Failed to reset asset registry journal {}", m_JournalPath.string());
+		}
+
+		m_PendingRecords.clear();
+		m_PendingRecordCount = 0;
+		m_JournalRecordCount = 0;
+		m_SnapshotOutdated = false;
+
+		ZN_CORE_INFO("[AssetManager] Asset registry compacted with {} entries", header.EntryCount);
+		return true;
+	}
+
+	bool AssetRegistrySerializer::ExportJSON(const std::vector<AssetMetadata>& entries, const std::filesystem::path& filepath)
+	{
+		std::vector<const AssetMetadata*> sorted;
+		sorted.reserve(entries.size());
+		for (const AssetMetadata& metadata : entries)
+			sorted.push_back(&metadata);
+		std::sort(sorted.begin(), sorted.end(), [](const AssetMetadata* a, const AssetMetadata* b) { return (uint64_t)a->Handle < (uint64_t)b->Handle; });
+
+		nlohmann::json jsonData;
+		jsonData["Assets"] = nlohmann::json::array();
+		for (const AssetMetadata* metadata : sorted)
+		{
+			nlohmann::json assetEntry;
+			assetEntry["Handle"] = static_cast<uint64_t>(metadata->Handle);
+			assetEntry["FilePath"] = Utils::SerializablePath(metadata->FilePath);
+			assetEntry["Type"] = Utils::AssetTypeToString(metadata->Type);
+			jsonData["Assets"].push_back(assetEntry);
+		}
+
+		std::ofstream fout(filepath);
+		fout << jsonData.dump(2);
+		fout.close();
+
+		if (fout.fail())
+		{
+			ZN_CORE_ERROR("[AssetManager] Failed to export asset registry to {}", filepath.string());
+			return false;
+		}
+		return true;
+	}
+
+}
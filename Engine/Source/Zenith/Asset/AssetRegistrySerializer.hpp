@@ -0,0 +1,68 @@
+#pragma once
+
+#include "AssetMetadata.hpp"
+#include "AssetRegistryFile.hpp"
+
+#include "Zenith/Core/Buffer.hpp"
+
+#include <mutex>
+#include <vector>
+
+namespace Zenith {
+
+	// Persists the editor asset registry as a compact binary snapshot plus an append-only journal of changes.
+	// Changes are recorded as they happen and appended by Flush(), so saving costs time proportional to the change.
+	// Compact() folds the journal back into a new snapshot (written to a temp file and renamed into place).
+	//
+	// Journal records are idempotent (full entries, not deltas), so a crash between replacing the snapshot
+	// and resetting the journal only replays changes the snapshot already has.
+	class AssetRegistrySerializer
+	{
+	public:
+		explicit AssetRegistrySerializer(const std::filesystem::path& registryPath);
+
+		// Reads the snapshot and replays the journal on top of it. Also reads the older JSON registry format.
+		// Returns false if the registry exists but cannot be read.
+		bool Deserialize(std::vector<AssetMetadata>& outEntries);
+
+		// Handle, Type, FilePath and the source state (write time, content hash, importer version) are persisted
+		void RecordSet(const AssetMetadata& metadata, bool isNew);
+		void RecordRemove(AssetHandle handle);
+		bool HasPendingChanges() const;
+
+		// Appends the recorded changes to the journal
+		bool Flush();
+
+		// True once the journal is large relative to the registry (or the snapshot needs rewriting anyway)
+		bool NeedsCompaction(size_t entryCount) const;
+
+		// Writes entries as the new snapshot and resets the journal. Pending changes are dropped: entries must already include them.
+		bool Compact(const std::vector<AssetMetadata>& entries);
+
+		// Human-readable dump in the old registry format, for diffing
+		static bool ExportJSON(const std::vector<AssetMetadata>& entries, const std::filesystem::path& filepath);
+
+		// False if a and b differ in anything that is persisted
+		static bool IsPersistedStateEqual(const AssetMetadata& a, const AssetMetadata& b);
+
+		const std::filesystem::path& GetRegistryPath() const { return m_RegistryPath; }
+		const std::filesystem::path& GetJournalPath() const { return m_JournalPath; }
+
+	private:
+		bool DeserializeSnapshot(const Buffer& data, std::vector<AssetMetadata>& outEntries);
+		bool DeserializeJSON(const Buffer& data, std::vector<AssetMetadata>& outEntries);
+		void ReplayJournal(std::vector<AssetMetadata>& entries);
+		void AppendRecord(AssetRegistryFile::JournalOp op, const AssetMetadata& metadata);
+
+	private:
+		std::filesystem::path m_RegistryPath;
+		std::filesystem::path m_JournalPath;
+
+		std::vector<char> m_PendingRecords;
+		uint32_t m_PendingRecordCount = 0;
+		uint64_t m_JournalRecordCount = 0;
+		bool m_SnapshotOutdated = false; // legacy JSON, or a journal that had to be truncated
+		mutable std::mutex m_Mutex;
+	};
+
+}
@@ -2,10 +2,14 @@
 #include "AssetSerializer.hpp"
 
 #include "AssetManager.hpp"
+#include "KTX2.hpp"
+#include "TextureCooker.hpp"
+#include "TextureImporter.hpp"
 
 #include "Zenith/Renderer/MaterialAsset.hpp"
 #include "Zenith/Renderer/Mesh.hpp"
 #include "Zenith/Renderer/Renderer.hpp"
+#include "Zenith/Renderer/TextureStreamer.hpp"
 // #include "Zenith/Renderer/Font.hpp"
 
 #include "Zenith/Utilities/FileSystem.hpp"
@@ -21,9 +25,59 @@ namespace Zenith {
 	// TextureSerializer
 	//////////////////////////////////////////////////////////////////////////////////
 
+	namespace Utils {
+
+		// Without BC support textures are still cooked for their mip chain, so loading never generates mips on the GPU
+		static TextureCookQuality GetTextureCookQuality()
+		{
+			return Renderer::GetCapabilities().SupportsBlockCompression ? TextureCookQuality::Normal : TextureCookQuality::Uncompressed;
+		}
+
+		// Largest mip loaded with a texture, the streamer brings in the rest when something draws it (0 = all)
+		static uint32_t GetTextureInitialSize()
+		{
+			const RendererConfig& config = Renderer::GetConfig();
+			return config.TextureStreaming ? config.TextureStreamingInitialSize : 0;
+		}
+
+		// Releases the cooked data, the texture has its own copy
+		static bool CreateCookedTexture(CookedTexture& cooked, const AssetMetadata& metadata, Ref<Asset>& asset)
+		{
+			Ref<Texture2D> texture;
+			if (IsBlockCompressed(cooked.Format) && !Renderer::GetCapabilities().SupportsBlockCompression)
+				ZN_CORE_ERROR_TAG("AssetManager", "{} is block compressed, which this device does not support", metadata.FilePath.string());
+			else
+				texture = TextureCooker::CreateTexture(cooked, metadata.FilePath.string());
+			cooked.Data.Release();
+
+			if (!texture)
+				return false;
+
+			// The streamer tracks textures by handle
+			texture->Handle = metadata.Handle;
+			if (!cooked.FilePath.empty())
+				TextureStreamer::Register(texture, cooked.FilePath);
+
+			asset = texture;
+			return true;
+		}
+
+	}
+
 	bool TextureSerializer::TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset) const
 	{
-		asset = Texture2D::Create(TextureSpecification(), Project::GetEditorAssetManager()->GetFileSystemPathString(metadata));
+		const std::filesystem::path filepath = Project::GetActiveAssetDirectory() / metadata.FilePath;
+		if (metadata.FilePath.extension() == ".ktx2")
+		{
+			CookedTexture texture = KTX2::Read(filepath, Utils::GetTextureInitialSize());
+			return Utils::CreateCookedTexture(texture, metadata, asset);
+		}
+
+		CookedTexture cooked = TextureCooker::CookFile(filepath, TextureCooker::GetUsageFromPath(metadata.FilePath), Utils::GetTextureCookQuality(), Utils::GetTextureInitialSize());
+		if (Utils::CreateCookedTexture(cooked, metadata, asset))
+			return true;
+
+		asset = Texture2D::Create(TextureSpecification(), filepath.string());
 		asset->Handle = metadata.Handle;
 
 		bool result = asset.As<Texture2D>()->Loaded();
@@ -33,6 +87,30 @@ namespace Zenith {
 		return result;
 	}
 
+	bool TextureSerializer::TryLoadDataFromMemory(const AssetMetadata& metadata, Buffer data, Ref<Asset>& asset) const
+	{
+		if (KTX2::IsKTX2(data))
+		{
+			CookedTexture texture = KTX2::Decode(data);
+			return Utils::CreateCookedTexture(texture, metadata, asset);
+		}
+
+		CookedTexture cooked = TextureCooker::CookFromMemory(data, TextureCooker::GetUsageFromPath(metadata.FilePath), Utils::GetTextureCookQuality(), Utils::GetTextureInitialSize());
+		if (Utils::CreateCookedTexture(cooked, metadata, asset))
+			return true;
+
+		TextureData textureData = TextureImporter::LoadTextureData(data);
+		Ref<Texture2D> texture = TextureImporter::CreateTexture(textureData, metadata.FilePath.string());
+		textureData.ImageData.Release();
+
+		if (!texture)
+			return false;
+
+		asset = texture;
+		asset->Handle = metadata.Handle;
+		return true;
+	}
+
 	//////////////////////////////////////////////////////////////////////////////////
 	// FontSerializer
 	//////////////////////////////////////////////////////////////////////////////////
@@ -64,16 +142,26 @@ namespace Zenith {
 
 		std::string jsonString = SerializeToJSON(materialAsset);
 
-		std::ofstream fout(Project::GetEditorAssetManager()->GetFileSystemPath(metadata));
+		std::ofstream fout(Project::GetActiveAssetDirectory() / metadata.FilePath);
 		fout << jsonString;
 	}
 
 	bool MaterialAssetSerializer::TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset) const
+	{
+		return TryLoadDataFromJSON(metadata, GetJSON(metadata), asset);
+	}
+
+	bool MaterialAssetSerializer::TryLoadDataFromMemory(const AssetMetadata& metadata, Buffer data, Ref<Asset>& asset) const
+	{
+		return TryLoadDataFromJSON(metadata, std::string(data.As<const char>(), data.Size), asset);
+	}
+
+	bool MaterialAssetSerializer::TryLoadDataFromJSON(const AssetMetadata& metadata, const std::string& jsonString, Ref<Asset>& asset) const
 	{
 		try
 		{
 			Ref<MaterialAsset> materialAsset;
-			if (!DeserializeFromJSON(GetJSON(metadata), materialAsset, metadata.Handle))
+			if (!DeserializeFromJSON(jsonString, materialAsset, metadata.Handle))
 			{
 				return false;
 			}
@@ -167,7 +255,7 @@ namespace Zenith {
 
 	std::string MaterialAssetSerializer::GetJSON(const AssetMetadata& metadata) const
 	{
-		std::ifstream stream(Project::GetEditorAssetManager()->GetFileSystemPath(metadata));
+		std::ifstream stream(Project::GetActiveAssetDirectory() / metadata.FilePath);
 		if (!stream.is_open())
 			return std::string();
 
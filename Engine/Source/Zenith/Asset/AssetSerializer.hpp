@@ -20,6 +20,13 @@ namespace Zenith {
 		virtual void Serialize(const AssetMetadata& metadata, const Ref<Asset>& asset) const = 0;
 		virtual bool TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset) const = 0;
 		virtual void RegisterDependencies(const AssetMetadata& metadata) const;
+
+		// Loads from the file contents already in memory (e.g. an AssetPack blob).
+		// Serializers that can only import from disk keep the default and are loaded through TryLoadData().
+		virtual bool TryLoadDataFromMemory(const AssetMetadata& metadata, Buffer data, Ref<Asset>& asset) const { return false; }
+
+		// Bump when the loaded result changes for the same file, so that recorded content hashes stop matching
+		virtual uint32_t GetVersion() const { return 1; }
 	};
 
 	class TextureSerializer : public AssetSerializer
@@ -27,6 +34,7 @@ namespace Zenith {
 	public:
 		virtual void Serialize(const AssetMetadata& metadata, const Ref<Asset>& asset) const override{}
 		virtual bool TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset) const override;
+		virtual bool TryLoadDataFromMemory(const AssetMetadata& metadata, Buffer data, Ref<Asset>& asset) const override;
 	};
 
 	class FontSerializer : public AssetSerializer
@@ -42,9 +50,11 @@ namespace Zenith {
 		virtual void Serialize(const AssetMetadata& metadata, const Ref<Asset>& asset) const override;
 		virtual bool TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset) const override;
 		virtual void RegisterDependencies(const AssetMetadata& metadata) const override;
+		virtual bool TryLoadDataFromMemory(const AssetMetadata& metadata, Buffer data, Ref<Asset>& asset) const override;
 	private:
 		std::string SerializeToJSON(Ref<MaterialAsset> materialAsset) const;
 		std::string GetJSON(const AssetMetadata& metadata) const;
+		bool TryLoadDataFromJSON(const AssetMetadata& metadata, const std::string& jsonString, Ref<Asset>& asset) const;
 		void RegisterDependenciesFromJSON(const std::string& yamlString, AssetHandle handle) const;
 		bool DeserializeFromJSON(const std::string& yamlString, Ref<MaterialAsset>& targetMaterialAsset, AssetHandle handle) const;
 	};
@@ -0,0 +1,122 @@
+#include "znpch.hpp"
+#include "AssetReloadBatcher.hpp"
+
+#include "Zenith/Debug/Profiler.hpp"
+
+#include <unordered_map>
+
+namespace Zenith {
+
+	size_t AssetReloadBatcher::Batch::GetAssetCount() const
+	{
+		size_t count = 0;
+		for (const auto& level : Levels)
+			count += level.size();
+		return count;
+	}
+
+	AssetReloadBatcher::AssetReloadBatcher(Clock::duration settleTime, Clock::duration maxDelay)
+		: m_SettleTime(settleTime), m_MaxDelay(maxDelay)
+	{
+	}
+
+	bool AssetReloadBatcher::AddChange(AssetHandle handle, Clock::time_point now)
+	{
+		if (!m_Pending.insert(handle).second)
+			return false;
+
+		if (m_Pending.size() == 1)
+			m_FirstChange = now;
+		m_LastChange = now;
+		return true;
+	}
+
+	bool AssetReloadBatcher::IsReady(Clock::time_point now) const
+	{
+		if (m_Pending.empty())
+			return false;
+
+		return now - m_LastChange >= m_SettleTime || now - m_FirstChange >= m_MaxDelay;
+	}
+
+	AssetReloadBatcher::Batch AssetReloadBatcher::TakeBatch(const DependentsFn& getDependents)
+	{
+		ZN_PROFILE_FUNC();
+
+		Batch batch;
+		batch.Changed = std::move(m_Pending);
+		m_Pending.clear();
+
+		// Transitive dependents, each asset's dependents are looked up once
+		std::unordered_map<AssetHandle, std::unordered_set<AssetHandle>> dependents;
+		std::vector<AssetHandle> open(batch.Changed.begin(), batch.Changed.end());
+		while (!open.empty())
+		{
+			const AssetHandle handle = open.back();
+			open.pop_back();
+			if (dependents.contains(handle))
+				continue;
+
+			auto& direct = dependents[handle] = getDependents(handle);
+			for (AssetHandle dependent : direct)
+			{
+				if (!dependents.contains(dependent))
+					open.push_back(dependent);
+			}
+		}
+
+		// Kahn's algorithm, a level at a time
+		std::unordered_map<AssetHandle, uint32_t> pendingDependencies;
+		pendingDependencies.reserve(dependents.size());
+		for (const auto& [handle, direct] : dependents)
+		{
+			pendingDependencies.try_emplace(handle, 0);
+			for (AssetHandle dependent : direct)
+			{
+				if (dependent != handle)
+					pendingDependencies[dependent]++;
+			}
+		}
+
+		std::vector<AssetHandle> level;
+		for (const auto& [handle, count] : pendingDependencies)
+		{
+			if (count == 0)
+				level.push_back(handle);
+		}
+
+		size_t ordered = 0;
+		while (!level.empty())
+		{
+			std::vector<AssetHandle> next;
+			for (AssetHandle handle : level)
+			{
+				for (AssetHandle dependent : dependents[handle])
+				{
+					if (dependent != handle && --pendingDependencies[dependent] == 0)
+						next.push_back(dependent);
+				}
+			}
+
+			ordered += level.size();
+			batch.Levels.push_back(std::move(level));
+			level = std::move(next);
+		}
+
+		if (ordered != pendingDependencies.size())
+		{
+			std::vector<AssetHandle> cyclic;
+			for (const auto& [handle, count] : pendingDependencies)
+			{
+				if (count > 0)
+					cyclic.push_back(handle);
+			}
+
+			ZN_CORE_WARN_TAG("AssetManager", "{} assets with cyclic dependencies are reloaded last", cyclic.size());
+			batch.Levels.push_back(std::move(cyclic));
+		}
+
+		return batch;
+	}
+
+}
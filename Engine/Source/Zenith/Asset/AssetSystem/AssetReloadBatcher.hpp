@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Zenith/Asset/Asset.hpp"
+
+#include <chrono>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+namespace Zenith {
+
+	// Collects changed asset files until the changes settle, then orders everything they affect for reloading.
+	// A source-control sync touches many files within a short time. Batching them means every affected asset
+	// is reloaded once, after all of the assets in the batch that it depends on.
+	// Not thread-safe, the editor asset manager uses it on the main thread only.
+	class AssetReloadBatcher
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+		using DependentsFn = std::function<std::unordered_set<AssetHandle>(AssetHandle)>;
+
+		struct Batch
+		{
+			std::unordered_set<AssetHandle> Changed;      // assets whose own files changed
+			std::vector<std::vector<AssetHandle>> Levels; // changed assets and their transitive dependents. Assets in a level do not depend on each other,
+			                                              // and only on assets in earlier levels. Dependency cycles end up together in the last level.
+			size_t GetAssetCount() const;
+		};
+
+		// settleTime: how long no new change has to arrive before the batch is ready
+		// maxDelay: upper bound from the first change, so that a file that keeps changing does not hold up the batch forever
+		explicit AssetReloadBatcher(Clock::duration settleTime = std::chrono::milliseconds(250), Clock::duration maxDelay = std::chrono::seconds(2));
+
+		// Returns false if the asset already has a pending change
+		bool AddChange(AssetHandle handle, Clock::time_point now = Clock::now());
+		bool HasPendingChanges() const { return !m_Pending.empty(); }
+		bool IsReady(Clock::time_point now = Clock::now()) const;
+
+		// Takes the pending changes. getDependents returns the assets that directly depend on an asset.
+		Batch TakeBatch(const DependentsFn& getDependents);
+
+	private:
+		Clock::duration m_SettleTime;
+		Clock::duration m_MaxDelay;
+
+		std::unordered_set<AssetHandle> m_Pending;
+		Clock::time_point m_FirstChange;
+		Clock::time_point m_LastChange;
+	};
+
+}
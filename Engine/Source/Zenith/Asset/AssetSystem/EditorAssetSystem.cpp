@@ -2,6 +2,7 @@
 #include "EditorAssetSystem.hpp"
 
 #include "Zenith/Asset/AssetImporter.hpp"
+#include "Zenith/Asset/AssetManager/EditorAssetManager.hpp"
 #include "Zenith/Project/Project.hpp"
 #include "Zenith/Core/Application.hpp"
 #include "Zenith/Events/EditorEvent.hpp"
@@ -10,10 +11,24 @@
 
 namespace Zenith {
 
-	EditorAssetSystem::EditorAssetSystem()
-		: m_Thread("Asset Thread")
+	EditorAssetSystem::EditorAssetSystem(uint32_t workerCount)
+		: m_MonitorThread("Asset Monitor")
 	{
-		m_Thread.Dispatch([this]() { AssetThreadFunc(); });
+		if (workerCount == 0)
+		{
+			// Leave the main and render threads a core each
+			const uint32_t cores = std::thread::hardware_concurrency();
+			workerCount = cores > 3 ? cores - 2 : 1;
+		}
+
+		m_Workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; i++)
+		{
+			m_Workers.emplace_back("Asset Worker " + std::to_string(i));
+			m_Workers.back().Dispatch([this]() { WorkerThreadFunc(); });
+		}
+
+		m_MonitorThread.Dispatch([this]() { MonitorThreadFunc(); });
 	}
 
 	EditorAssetSystem::~EditorAssetSystem()
@@ -23,14 +38,36 @@ namespace Zenith {
 
 	void EditorAssetSystem::Stop()
 	{
-		m_Running = false;
-		m_AssetLoadingQueueCV.notify_one();
+		{
+			std::scoped_lock lock(m_AssetLoadingQueueMutex, m_MonitorMutex);
+			m_Running = false;
+		}
+		m_AssetLoadingQueueCV.notify_all();
+		m_MonitorCV.notify_all();
 	}
 
 	void EditorAssetSystem::StopAndWait()
 	{
 		Stop();
-		m_Thread.Join();
+		for (Thread& worker : m_Workers)
+			worker.Join();
+		m_MonitorThread.Join();
+
+		// Nothing will pick up the remaining requests, release anyone still holding a future to them
+		std::scoped_lock lock(m_AssetLoadingQueueMutex);
+		for (auto it = m_InFlightLoads.begin(); it != m_InFlightLoads.end();)
+		{
+			if (it->second->State != LoadState::Loading)
+			{
+				it->second->Promise.set_value(nullptr);
+				it = m_InFlightLoads.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+		m_AssetLoadingQueue = {};
 	}
 
 	void EditorAssetSystem::AssetMonitorUpdate()
@@ -40,108 +77,271 @@ namespace Zenith {
 		m_AssetUpdatePerf = timer.ElapsedMillis();
 	}
 
-	void EditorAssetSystem::AssetThreadFunc()
+	void EditorAssetSystem::WorkerThreadFunc()
 	{
-		ZN_PROFILE_THREAD("Asset Thread");
+		ZN_PROFILE_THREAD("Asset Worker");
 
 		while (m_Running)
 		{
-			ZN_PROFILE_SCOPE("Asset Thread Queue");
+			std::shared_ptr<LoadTask> task;
+			{
+				std::unique_lock<std::mutex> lock(m_AssetLoadingQueueMutex);
+				m_AssetLoadingQueueCV.wait(lock, [this] {
+					return !m_Running || !m_AssetLoadingQueue.empty();
+				});
 
-			AssetMonitorUpdate();
+				if (!m_Running)
+					break;
 
-			bool queueEmptyOrStop = false;
-			while (!queueEmptyOrStop)
-			{
-				AssetMetadata metadata;
+				QueueEntry entry = m_AssetLoadingQueue.top();
+				m_AssetLoadingQueue.pop();
+
+				auto it = m_InFlightLoads.find(entry.Handle);
+				if (it == m_InFlightLoads.end())
+					continue;
+
+				// Stale entry: the task was claimed by GetAsset(), or re-queued at a higher priority
+				task = it->second;
+				if (task->State != LoadState::Queued || task->Priority != entry.Priority)
+					continue;
+
+				if (!task->DependenciesScheduled)
 				{
-					std::scoped_lock<std::mutex> lock(m_AssetLoadingQueueMutex);
-					if (m_AssetLoadingQueue.empty() || !m_Running)
-					{
-						queueEmptyOrStop = true;
-					}
-					else
+					task->DependenciesScheduled = true;
+
+					// Reading dependencies can touch the disk, don't hold up the other workers
+					lock.unlock();
+					std::vector<AssetMetadata> dependencies = GetLoadDependencies(task->Metadata);
+					lock.lock();
+
+					if (task->State != LoadState::Queued)
+						continue;
+
+					ScheduleDependenciesLocked(task, dependencies);
+					if (task->PendingDependencies > 0)
 					{
-						metadata = m_AssetLoadingQueue.front();
-						m_AssetLoadingQueue.pop();
+						// Re-queued by RunTask() once the last dependency has finished
+						task->State = LoadState::WaitingForDependencies;
+						continue;
 					}
 				}
 
-				// If queueEmptyOrStop then metadata will be invalid (Handle == 0)
-				// We check metadata here (instead of just breaking straight away on queueEmptyOrStop)
-				// to deal with the edge case that other thread might queue requests for invalid assets.
-				// This way, we just pop those requests and ignore them.
-				if (metadata.IsValid())
-				{
-					TryLoadData(metadata);
-				}
+				task->State = LoadState::Loading;
+				task->LoadingThread = std::this_thread::get_id();
 			}
 
-			std::unique_lock<std::mutex> lock(m_AssetLoadingQueueMutex);
-			// need to check conditions again, since other thread could have changed them between releasing the lock (in the while loop above)
-			// and re-acquiring the lock here
-			if (m_AssetLoadingQueue.empty() && m_Running)
-			{
-				// need to wake periodically (here 100ms) so that AssetMonitorUpdate() is called regularly to check for updated file timestamps
-				// (which kinda makes condition variable redundant. may as well just sleep(100ms))
-				m_AssetLoadingQueueCV.wait_for(lock, std::chrono::milliseconds(100), [this] {
-					return !m_Running || !m_AssetLoadingQueue.empty();
-				});
-			}
+			ZN_PROFILE_SCOPE("Asset Worker Load");
+			RunTask(task);
 		}
 	}
 
-	void EditorAssetSystem::QueueAssetLoad(const AssetMetadata& request)
+	void EditorAssetSystem::MonitorThreadFunc()
 	{
+		ZN_PROFILE_THREAD("Asset Monitor");
+
+		while (m_Running)
+		{
+			AssetMonitorUpdate();
+
+			// Wake periodically (here 100ms) so that AssetMonitorUpdate() is called regularly to check for updated file timestamps
+			std::unique_lock<std::mutex> lock(m_MonitorMutex);
+			m_MonitorCV.wait_for(lock, std::chrono::milliseconds(100), [this] { return !m_Running; });
+		}
+	}
+
+	std::shared_future<Ref<Asset>> EditorAssetSystem::QueueAssetLoad(const AssetMetadata& request, AssetLoadPriority priority)
+	{
+		std::shared_future<Ref<Asset>> future;
 		{
 			std::scoped_lock<std::mutex> lock(m_AssetLoadingQueueMutex);
-			m_AssetLoadingQueue.push(request);
+			future = EnqueueLocked(request, priority)->Future;
 		}
 		m_AssetLoadingQueueCV.notify_one();
+		return future;
 	}
 
-	Ref<Asset> EditorAssetSystem::GetAsset(const AssetMetadata& request)
+	std::shared_ptr<EditorAssetSystem::LoadTask> EditorAssetSystem::EnqueueLocked(const AssetMetadata& metadata, AssetLoadPriority priority)
+	{
+		if (auto it = m_InFlightLoads.find(metadata.Handle); it != m_InFlightLoads.end())
+		{
+			std::shared_ptr<LoadTask> task = it->second;
+			if (priority > task->Priority)
+			{
+				task->Priority = priority;
+				if (task->State == LoadState::Queued)
+					m_AssetLoadingQueue.push({ priority, m_NextSequence++, metadata.Handle });
+			}
+			return task;
+		}
+
+		std::shared_ptr<LoadTask> task = std::make_shared<LoadTask>();
+		task->Metadata = metadata;
+		task->Priority = priority;
+		task->Future = task->Promise.get_future().share();
+		m_InFlightLoads[metadata.Handle] = task;
+		m_AssetLoadingQueue.push({ priority, m_NextSequence++, metadata.Handle });
+		return task;
+	}
+
+	void EditorAssetSystem::ScheduleDependenciesLocked(const std::shared_ptr<LoadTask>& task, const std::vector<AssetMetadata>& dependencies)
+	{
+		const AssetHandle handle = task->Metadata.Handle;
+		for (const AssetMetadata& dependency : dependencies)
+		{
+			if (dependency.Handle == handle || FindLoadedAssetLocked(dependency.Handle))
+				continue;
+
+			// A task that is itself waiting might be waiting on us (a dependency cycle).
+			// Don't wait on it here, the serializer's own GetAsset() call resolves it.
+			if (auto it = m_InFlightLoads.find(dependency.Handle); it != m_InFlightLoads.end() && it->second->State == LoadState::WaitingForDependencies)
+				continue;
+
+			std::shared_ptr<LoadTask> dependencyTask = EnqueueLocked(dependency, task->Priority);
+			dependencyTask->Dependents.push_back(handle);
+			task->PendingDependencies++;
+		}
+
+		if (task->PendingDependencies > 1)
+			m_AssetLoadingQueueCV.notify_all();
+		else if (task->PendingDependencies == 1)
+			m_AssetLoadingQueueCV.notify_one();
+	}
+
+	Ref<Asset> EditorAssetSystem::FindLoadedAssetLocked(AssetHandle handle)
 	{
 		// Check if asset is already loaded in main asset manager
 		{
 			std::scoped_lock<std::mutex> lock(m_AMLoadedAssetsMutex);
-			if (auto it = m_AMLoadedAssets.find(request.Handle); it != m_AMLoadedAssets.end())
-			{
+			if (auto it = m_AMLoadedAssets.find(handle); it != m_AMLoadedAssets.end())
 				return it->second;
-			}
 		}
 
 		// Check if asset has already been loaded but is pending sync back to asset manager.
+		std::scoped_lock<std::mutex> lock(m_LoadedAssetsMutex);
+		for (const auto& [metadata, asset] : m_LoadedAssets)
+		{
+			if (metadata.Handle == handle)
+				return asset;
+		}
+
+		return nullptr;
+	}
+
+	bool EditorAssetSystem::WouldDeadlockLocked(const std::shared_ptr<LoadTask>& task) const
+	{
+		// Follow the chain of "loading thread is blocked on another load" back to ourselves
+		std::thread::id owner = task->LoadingThread;
+		for (size_t i = 0; i <= m_BlockedThreads.size(); i++)
+		{
+			if (owner == std::this_thread::get_id())
+				return true;
+
+			auto blocked = m_BlockedThreads.find(owner);
+			if (blocked == m_BlockedThreads.end())
+				return false;
+
+			auto it = m_InFlightLoads.find(blocked->second);
+			if (it == m_InFlightLoads.end() || it->second->State != LoadState::Loading)
+				return false;
+
+			owner = it->second->LoadingThread;
+		}
+		return false;
+	}
+
+	Ref<Asset> EditorAssetSystem::RunTask(const std::shared_ptr<LoadTask>& task)
+	{
+		// TryLoadData() publishes to m_LoadedAssets before the task leaves m_InFlightLoads,
+		// so GetAsset() always finds the asset in one or the other
+		Ref<Asset> asset = TryLoadData(task->Metadata);
+
+		{
+			std::scoped_lock<std::mutex> lock(m_AssetLoadingQueueMutex);
+			if (auto it = m_InFlightLoads.find(task->Metadata.Handle); it != m_InFlightLoads.end() && it->second == task)
+				m_InFlightLoads.erase(it);
+
+			for (AssetHandle dependent : task->Dependents)
+			{
+				auto it = m_InFlightLoads.find(dependent);
+				if (it == m_InFlightLoads.end())
+					continue;
+
+				LoadTask& dependentTask = *it->second;
+				if (dependentTask.PendingDependencies > 0 && --dependentTask.PendingDependencies == 0 && dependentTask.State == LoadState::WaitingForDependencies)
+				{
+					dependentTask.State = LoadState::Queued;
+					m_AssetLoadingQueue.push({ dependentTask.Priority, m_NextSequence++, dependent });
+					m_AssetLoadingQueueCV.notify_one();
+				}
+			}
+		}
+
+		task->Promise.set_value(asset);
+		return asset;
+	}
+
+	Ref<Asset> EditorAssetSystem::GetAsset(const AssetMetadata& request)
+	{
+		const std::thread::id thisThread = std::this_thread::get_id();
+
+		std::shared_ptr<LoadTask> task;
+		std::shared_future<Ref<Asset>> pendingLoad;
 		{
-			std::scoped_lock<std::mutex> lock(m_LoadedAssetsMutex);
-			for (const auto& [metadata, asset] : m_LoadedAssets)
+			std::scoped_lock<std::mutex> lock(m_AssetLoadingQueueMutex);
+			if (Ref<Asset> asset = FindLoadedAssetLocked(request.Handle))
+				return asset;
+
+			if (auto it = m_InFlightLoads.find(request.Handle); it != m_InFlightLoads.end())
 			{
-				if (metadata.Handle == request.Handle)
+				if (it->second->State != LoadState::Loading)
+				{
+					// Nobody has started on it yet: load it here rather than wait for a worker
+					task = it->second;
+					task->State = LoadState::Loading;
+					task->LoadingThread = thisThread;
+				}
+				else if (WouldDeadlockLocked(it->second))
 				{
-					return asset;
+					ZN_CORE_ERROR_TAG("AssetSystem", "Cyclic asset dependency while loading {} ({})", request.Handle, request.FilePath);
+					return nullptr;
 				}
+				else
+				{
+					pendingLoad = it->second->Future;
+					m_BlockedThreads[thisThread] = request.Handle;
+				}
+			}
+			else
+			{
+				task = std::make_shared<LoadTask>();
+				task->Metadata = request;
+				task->State = LoadState::Loading;
+				task->LoadingThread = thisThread;
+				task->Future = task->Promise.get_future().share();
+				m_InFlightLoads[request.Handle] = task;
 			}
 		}
 
-		// Note: There is a race condition here
-		// Another thread could try to GetAsset() the same asset while we are still in the process of
-		// loading it (i.e. _before_ it's put into m_LoadedAssets).
-		// This is a problem because each thread will end up with its own independently reference counted
-		// copy of the asset, and if that asset in turn has dependent in-memory assets, there will be 
-		// multiple copies of those assets (with different handles).
-		//
-		// At the moment, I don't *think* there is ever a situation where two non-main thread threads
-		// can try to GetAsset() at the same time.
-		// Maybe it could happen if you were trying to update assets on-disk at the same time that you
-		// are building an asset pack, and you have the content-browser open at same directory
-		// of changed asset.. !?
-		return TryLoadData(request);
+		if (pendingLoad.valid())
+		{
+			Ref<Asset> asset = pendingLoad.get();
+			std::scoped_lock<std::mutex> lock(m_AssetLoadingQueueMutex);
+			m_BlockedThreads.erase(thisThread);
+			return asset;
+		}
+
+		return RunTask(task);
 	}
 
 	bool EditorAssetSystem::RetrieveReadyAssets(std::vector<EditorAssetLoadResponse>& outAssetList)
 	{
 		ZN_CORE_ASSERT(outAssetList.empty(), "outAssetList should be empty prior to retrieval of ready assets");
-		std::scoped_lock lock(m_LoadedAssetsMutex);
+		std::scoped_lock lock(m_LoadedAssetsMutex, m_AMLoadedAssetsMutex);
+
+		// Keep the assets visible to GetAsset() until the asset manager's next UpdateLoadedAssetList()
+		for (const auto& [metadata, asset] : m_LoadedAssets)
+			m_AMLoadedAssets[metadata.Handle] = asset;
+
 		std::swap(outAssetList, m_LoadedAssets);
 
 		return !outAssetList.empty();
@@ -153,6 +353,44 @@ namespace Zenith {
 		m_AMLoadedAssets = loadedAssets;
 	}
 
+	std::vector<AssetMetadata> EditorAssetSystem::GetLoadDependencies(const AssetMetadata& metadata)
+	{
+		Ref<EditorAssetManager> assetManager = Project::GetEditorAssetManager();
+
+		auto findDependencies = [&](std::unordered_set<AssetHandle>& outDependencies)
+		{
+			std::shared_lock lock(assetManager->m_AssetDependenciesMutex);
+			if (auto it = assetManager->m_AssetDependencies.find(metadata.Handle); it != assetManager->m_AssetDependencies.end())
+			{
+				outDependencies = it->second;
+				return true;
+			}
+			return false;
+		};
+
+		std::unordered_set<AssetHandle> dependencies;
+		if (!findDependencies(dependencies))
+		{
+			// Serializers register dependencies from the file header/JSON without loading the asset
+			AssetImporter::RegisterDependencies(metadata);
+			findDependencies(dependencies);
+		}
+
+		std::vector<AssetMetadata> result;
+		result.reserve(dependencies.size());
+		for (AssetHandle dependency : dependencies)
+		{
+			if (dependency == 0)
+				continue;
+
+			// Memory-only assets have no metadata and never need loading
+			AssetMetadata dependencyMetadata = assetManager->GetMetadata(dependency);
+			if (dependencyMetadata.IsValid() && !dependencyMetadata.IsDataLoaded)
+				result.push_back(std::move(dependencyMetadata));
+		}
+		return result;
+	}
+
 	std::filesystem::path EditorAssetSystem::GetFileSystemPath(const AssetMetadata& metadata)
 	{
 		// TODO (0x): This is not safe.  Project asset directory can be modified by other threads
@@ -163,10 +401,16 @@ namespace Zenith {
 	{
 		ZN_PROFILE_FUNC();
 
-		// This is a long time to hold a lock.
-		// However, copying the list of assets to iterate (so that we could then release the lock before iterating) is also expensive, so hard to tell which is better.
-		std::scoped_lock<std::mutex> lock(m_AMLoadedAssetsMutex);
-		for (const auto& [handle, asset] : m_AMLoadedAssets)
+		// Copy the handles rather than hold the lock: EnsureCurrent() queues loads, and the workers need this lock to finish them
+		std::vector<AssetHandle> loadedAssets;
+		{
+			std::scoped_lock<std::mutex> lock(m_AMLoadedAssetsMutex);
+			loadedAssets.reserve(m_AMLoadedAssets.size());
+			for (const auto& [handle, asset] : m_AMLoadedAssets)
+				loadedAssets.push_back(handle);
+		}
+
+		for (AssetHandle handle : loadedAssets)
 		{
 			EnsureCurrent(handle);
 		}
@@ -193,8 +437,26 @@ namespace Zenith {
 		if (actualLastWriteTime == 0 || recordedLastWriteTime == 0)
 			return;
 
-		// Queue here rather than TryLoad(), as we are holding a lock (in EnsureAllLoadedCurrent()) and want this function to return as quickly as possible
-		return QueueAssetLoad(metadata);
+		// Metadata is only written on the main thread, so write times that have been dealt with are remembered here
+		// instead, to hash and report each of them once rather than on every poll
+		auto checked = m_CheckedWriteTimes.find(assetHandle);
+		if (checked != m_CheckedWriteTimes.end() && checked->second == actualLastWriteTime)
+			return;
+
+		m_CheckedWriteTimes[assetHandle] = actualLastWriteTime;
+		if (AssetImporter::IsSourceUnchanged(metadata, absolutePath, actualLastWriteTime))
+			return;
+
+		std::scoped_lock<std::mutex> lock(m_ChangedAssetsMutex);
+		m_ChangedAssets.push_back(assetHandle);
+	}
+
+	bool EditorAssetSystem::RetrieveChangedAssets(std::vector<AssetHandle>& outAssetList)
+	{
+		std::scoped_lock<std::mutex> lock(m_ChangedAssetsMutex);
+		outAssetList.insert(outAssetList.end(), m_ChangedAssets.begin(), m_ChangedAssets.end());
+		m_ChangedAssets.clear();
+		return !outAssetList.empty();
 	}
 
 
@@ -226,7 +488,7 @@ namespace Zenith {
 			//            GetLastWriteTime() then blocks until the write has finished, but now we have a new write time - not the one that was relevent for TryLoadData()
 			//            To resolve this, you bascially need to lock the metadata until both the TryLoadData() _and_ the GetLastWriteTime() have completed.
 			//            Or you need to update the last write time while you still have the file locked during TryLoadData()
-			metadata.FileLastWriteTime = FileSystem::GetLastWriteTime(absolutePath);
+			AssetImporter::RecordSourceState(metadata, absolutePath);
 			{
 				std::scoped_lock<std::mutex> lock(m_LoadedAssetsMutex);
 				m_LoadedAssets.emplace_back(metadata, asset);
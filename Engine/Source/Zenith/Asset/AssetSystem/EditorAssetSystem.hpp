@@ -4,21 +4,33 @@
 #include "Zenith/Core/Thread.hpp"
 
 #include <atomic>
+#include <future>
 #include <mutex>
 #include <queue>
 
 namespace Zenith {
 
+	enum class AssetLoadPriority : uint8_t
+	{
+		Background = 0, // e.g. hot-reload of changed files
+		Normal = 1,
+		Visible = 2     // something is waiting to draw this asset
+	};
+
 	class EditorAssetSystem : public RefCounted
 	{
 	public:
-		EditorAssetSystem();
+		// workerCount = 0 picks one worker per core not already taken by the main and render threads
+		explicit EditorAssetSystem(uint32_t workerCount = 0);
 		~EditorAssetSystem();
 
-		// Queue an asset to be loaded on asset thread later
-		void QueueAssetLoad(const AssetMetadata& request);
+		// Queue an asset to be loaded on a worker later.
+		// Requests for an asset that is already queued or loading share the same future (and raise its priority).
+		// Dependencies of the asset are loaded in parallel before the asset itself.
+		std::shared_future<Ref<Asset>> QueueAssetLoad(const AssetMetadata& request, AssetLoadPriority priority = AssetLoadPriority::Normal);
 
-		// Get an asset immediately (on asset thread).
+		// Get an asset immediately (on the calling thread, which must not be the main thread).
+		// If the asset is already being loaded by a worker, waits for that load rather than loading a second copy.
 		// If the asset needs to be loaded, it will be loaded into "ready assets" and transfered back to main thread
 		// at next asset sync.
 		Ref<Asset> GetAsset(const AssetMetadata& request);
@@ -30,30 +42,93 @@ namespace Zenith {
 		// This effectively takes a "thread local" snapshot of the asset manager's loaded assets.
 		void UpdateLoadedAssetList(const std::unordered_map<AssetHandle, Ref<Asset>>& loadedAssets);
 
+		uint32_t GetWorkerCount() const { return (uint32_t)m_Workers.size(); }
+
 		void Stop();
 		void StopAndWait();
 
-		// Monitor for updated assets, and if any are found queue them for reload
+		// Monitor for updated assets. Changed assets are reported through RetrieveChangedAssets(), the asset manager
+		// batches and orders their reloads.
 		void AssetMonitorUpdate();
 
+		// Handles of loaded assets whose files changed since the last call
+		bool RetrieveChangedAssets(std::vector<AssetHandle>& outAssetList);
+
+	protected:
+		// Virtual so that tests can drive the scheduling without a project.
+		// The workers call these, overrides must StopAndWait() in their destructor.
+
+		// Dependencies of the asset that are not loaded yet
+		virtual std::vector<AssetMetadata> GetLoadDependencies(const AssetMetadata& metadata);
+		virtual Ref<Asset> TryLoadData(AssetMetadata metadata);
+
 	private:
-		// The asset thread's mainline
-		void AssetThreadFunc();
+		enum class LoadState : uint8_t
+		{
+			Queued, WaitingForDependencies, Loading
+		};
+
+		struct LoadTask
+		{
+			AssetMetadata Metadata;
+			AssetLoadPriority Priority = AssetLoadPriority::Normal;
+			LoadState State = LoadState::Queued;
+			bool DependenciesScheduled = false;
+			uint32_t PendingDependencies = 0;
+			std::vector<AssetHandle> Dependents; // in-flight tasks waiting for this one
+			std::thread::id LoadingThread;
+
+			std::promise<Ref<Asset>> Promise;
+			std::shared_future<Ref<Asset>> Future;
+		};
+
+		struct QueueEntry
+		{
+			AssetLoadPriority Priority;
+			uint64_t Sequence;
+			AssetHandle Handle;
+
+			// Highest priority first, FIFO within a priority
+			bool operator<(const QueueEntry& other) const
+			{
+				return Priority != other.Priority ? Priority < other.Priority : Sequence > other.Sequence;
+			}
+		};
+
+		// The asset workers' mainline
+		void WorkerThreadFunc();
+		// Periodically checks loaded assets for changes on disk
+		void MonitorThreadFunc();
+
+		// All of these require m_AssetLoadingQueueMutex to be held
+		std::shared_ptr<LoadTask> EnqueueLocked(const AssetMetadata& metadata, AssetLoadPriority priority);
+		void ScheduleDependenciesLocked(const std::shared_ptr<LoadTask>& task, const std::vector<AssetMetadata>& dependencies);
+		Ref<Asset> FindLoadedAssetLocked(AssetHandle handle);
+		bool WouldDeadlockLocked(const std::shared_ptr<LoadTask>& task) const;
+
+		// Loads the task's asset on the calling thread, and releases anything that was waiting on it
+		Ref<Asset> RunTask(const std::shared_ptr<LoadTask>& task);
 
 		std::filesystem::path GetFileSystemPath(const AssetMetadata& metadata);
 
 		void EnsureAllLoadedCurrent();
 		void EnsureCurrent(AssetHandle assetHandle);
-		Ref<Asset> TryLoadData(AssetMetadata metadata);
 
 	private:
-		Thread m_Thread;
-		std::atomic<bool> m_Running = true;  // not false. This ensures that if Stop() is called after the thread is dispatched but before it actually starts running, then the thread is correctly stopped.
-
-		std::queue<AssetMetadata> m_AssetLoadingQueue;
+		std::vector<Thread> m_Workers;
+		Thread m_MonitorThread;
+		std::atomic<bool> m_Running = true;  // not false. This ensures that if Stop() is called after the threads are dispatched but before they actually start running, then the threads are correctly stopped.
+
+		std::priority_queue<QueueEntry> m_AssetLoadingQueue;
+		std::unordered_map<AssetHandle, std::shared_ptr<LoadTask>> m_InFlightLoads;
+		std::unordered_map<std::thread::id, AssetHandle> m_BlockedThreads; // thread -> asset it is waiting for in GetAsset()
+		uint64_t m_NextSequence = 0;
 		std::mutex m_AssetLoadingQueueMutex;
 		std::condition_variable m_AssetLoadingQueueCV;
 
+		std::mutex m_MonitorMutex;
+		std::condition_variable m_MonitorCV;
+
 		std::vector<EditorAssetLoadResponse> m_LoadedAssets; // Assets that have been loaded asynchronously and are waiting for sync back to Asset Manager
 		std::mutex m_LoadedAssetsMutex;
 
@@ -62,6 +137,9 @@ namespace Zenith {
 
 		// Asset Monitoring
 		float m_AssetUpdatePerf = 0.0f;
+		std::unordered_map<AssetHandle, uint64_t> m_CheckedWriteTimes; // monitor thread only: write times already reported, or whose content matched the loaded file
+		std::vector<AssetHandle> m_ChangedAssets;
+		std::mutex m_ChangedAssetsMutex;
 	};
 
-}
\ No newline at end of file
+}
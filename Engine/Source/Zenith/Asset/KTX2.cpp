@@ -0,0 +1,525 @@
+#include "znpch.hpp"
+#include "KTX2.hpp"
+
+#include "Zenith/Debug/Profiler.hpp"
+
+#include <stb/stb_image.h>
+
+#include <numeric>
+
+// Part of stb_image_write's implementation, but not declared in its header
+extern "C" unsigned char* stbi_zlib_compress(unsigned char* data, int dataLength, int* outLength, int quality);
+
+namespace Zenith {
+
+	namespace Utils {
+
+		static constexpr uint8_t KTX2Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+		struct KTX2Header
+		{
+			uint8_t Identifier[12];
+			uint32_t VkFormat;
+			uint32_t TypeSize;
+			uint32_t PixelWidth;
+			uint32_t PixelHeight;
+			uint32_t PixelDepth;
+			uint32_t LayerCount;
+			uint32_t FaceCount;
+			uint32_t LevelCount;
+			uint32_t SupercompressionScheme;
+
+			uint32_t DFDByteOffset;
+			uint32_t DFDByteLength;
+			uint32_t KVDByteOffset;
+			uint32_t KVDByteLength;
+			uint64_t SGDByteOffset;
+			uint64_t SGDByteLength;
+		};
+		static_assert(sizeof(KTX2Header) == 80);
+
+		struct KTX2LevelIndex
+		{
+			uint64_t ByteOffset;
+			uint64_t ByteLength;
+			uint64_t UncompressedByteLength;
+		};
+
+		// VkFormat values, so this does not depend on the Vulkan headers
+		static uint32_t GetKTX2VkFormat(ImageFormat format)
+		{
+			switch (format)
+			{
+				case ImageFormat::RGBA:     return 37;  // VK_FORMAT_R8G8B8A8_UNORM
+				case ImageFormat::SRGBA:    return 43;  // VK_FORMAT_R8G8B8A8_SRGB
+				case ImageFormat::RGBA32F:  return 109; // VK_FORMAT_R32G32B32A32_SFLOAT
+				case ImageFormat::BC1:      return 133; // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+				case ImageFormat::BC1_SRGB: return 134;
+				case ImageFormat::BC3:      return 137;
+				case ImageFormat::BC3_SRGB: return 138;
+				case ImageFormat::BC4:      return 139;
+				case ImageFormat::BC5:      return 141;
+				case ImageFormat::BC6H:     return 143; // VK_FORMAT_BC6H_UFLOAT_BLOCK
+				case ImageFormat::BC7:      return 145;
+				case ImageFormat::BC7_SRGB: return 146;
+			}
+			return 0;
+		}
+
+		static ImageFormat GetImageFormatFromKTX2(uint32_t vkFormat)
+		{
+			for (ImageFormat format : { ImageFormat::RGBA, ImageFormat::SRGBA, ImageFormat::RGBA32F, ImageFormat::BC1, ImageFormat::BC1_SRGB,
+				ImageFormat::BC3, ImageFormat::BC3_SRGB, ImageFormat::BC4, ImageFormat::BC5, ImageFormat::BC6H, ImageFormat::BC7, ImageFormat::BC7_SRGB })
+			{
+				if (GetKTX2VkFormat(format) == vkFormat)
+					return format;
+			}
+			return ImageFormat::None;
+		}
+
+		static bool IsSRGB(ImageFormat format)
+		{
+			return format == ImageFormat::SRGBA || format == ImageFormat::BC1_SRGB || format == ImageFormat::BC3_SRGB || format == ImageFormat::BC7_SRGB;
+		}
+
+		// Bytes per pixel, or per 4x4 block
+		static uint32_t GetTexelBlockSize(ImageFormat format)
+		{
+			if (IsBlockCompressed(format))
+				return GetBlockSize(format);
+			return format == ImageFormat::RGBA32F ? 16 : 4;
+		}
+
+		static uint64_t GetLevelSize(ImageFormat format, uint32_t width, uint32_t height, uint32_t level)
+		{
+			return GetImageMemorySize(format, std::max(width >> level, 1u), std::max(height >> level, 1u));
+		}
+
+		// Basic data format descriptor (Khronos Data Format Specification 1.3), as the uint32 words after dfdTotalSize
+		static std::vector<uint32_t> GetDataFormatDescriptor(ImageFormat format, bool supercompressed)
+		{
+			enum : uint8_t
+			{
+				ModelRGBSDA = 1, ModelBC1A = 128, ModelBC3 = 130, ModelBC4 = 131, ModelBC5 = 132, ModelBC6H = 133, ModelBC7 = 134,
+				QualifierLinear = 0x10, QualifierSigned = 0x40, QualifierFloat = 0x80
+			};
+
+			struct Sample
+			{
+				uint32_t BitOffset, BitLength, Channel, Qualifiers, Lower, Upper;
+			};
+
+			const bool srgb = IsSRGB(format);
+			const bool blockCompressed = IsBlockCompressed(format);
+			uint8_t colorModel = ModelRGBSDA;
+			std::vector<Sample> samples;
+
+			switch (format)
+			{
+				case ImageFormat::RGBA:
+				case ImageFormat::SRGBA:
+					for (uint32_t c = 0; c < 4; c++)
+						samples.push_back({ c * 8, 8, c == 3 ? 15u : c, c == 3 && srgb ? (uint32_t)QualifierLinear : 0u, 0, 255 });
+					break;
+				case ImageFormat::RGBA32F:
+					for (uint32_t c = 0; c < 4; c++)
+						samples.push_back({ c * 32, 32, c == 3 ? 15u : c, QualifierFloat | QualifierSigned, 0xBF800000, 0x3F800000 });
+					break;
+				case ImageFormat::BC1:
+				case ImageFormat::BC1_SRGB:
+					colorModel = ModelBC1A;
+					samples.push_back({ 0, 64, 0, 0, 0, 0xFFFFFFFF });
+					samples.push_back({ 0, 64, 1, 0, 0, 0xFFFFFFFF }); // alpha present
+					break;
+				case ImageFormat::BC3:
+				case ImageFormat::BC3_SRGB:
+					colorModel = ModelBC3;
+					samples.push_back({ 0, 64, 15, srgb ? (uint32_t)QualifierLinear : 0u, 0, 0xFFFFFFFF });
+					samples.push_back({ 64, 64, 0, 0, 0, 0xFFFFFFFF });
+					break;
+				case ImageFormat::BC4:
+					colorModel = ModelBC4;
+					samples.push_back({ 0, 64, 0, 0, 0, 0xFFFFFFFF });
+					break;
+				case ImageFormat::BC5:
+					colorModel = ModelBC5;
+					samples.push_back({ 0, 64, 0, 0, 0, 0xFFFFFFFF });
+					samples.push_back({ 64, 64, 1, 0, 0, 0xFFFFFFFF });
+					break;
+				case ImageFormat::BC6H:
+					colorModel = ModelBC6H;
+					samples.push_back({ 0, 128, 0, QualifierFloat, 0, 0x3F800000 });
+					break;
+				case ImageFormat::BC7:
+				case ImageFormat::BC7_SRGB:
+					colorModel = ModelBC7;
+					samples.push_back({ 0, 128, 0, 0, 0, 0xFFFFFFFF });
+					break;
+			}
+
+			const uint32_t blockDimension = blockCompressed ? 3 : 0; // stored as size - 1
+			const uint32_t bytesPlane0 = supercompressed ? 0 : GetTexelBlockSize(format);
+
+			std::vector<uint32_t> words;
+			words.push_back(0); // vendor: Khronos, descriptor type: basic
+			words.push_back(2 | ((24 + 16 * (uint32_t)samples.size()) << 16)); // version 1.3, block size
+			words.push_back(colorModel | (1u << 8) | ((srgb ? 2u : 1u) << 16)); // BT.709 primaries, sRGB or linear transfer, straight alpha
+			words.push_back(blockDimension | (blockDimension << 8));
+			words.push_back(bytesPlane0);
+			words.push_back(0);
+			for (const Sample& sample : samples)
+			{
+				words.push_back(sample.BitOffset | ((sample.BitLength - 1) << 16) | ((sample.Channel | sample.Qualifiers) << 24));
+				words.push_back(0); // sample position
+				words.push_back(sample.Lower);
+				words.push_back(sample.Upper);
+			}
+			return words;
+		}
+
+		static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		struct KTX2Layout
+		{
+			KTX2Header Header;
+			ImageFormat Format = ImageFormat::None;
+			KTX2Supercompression Supercompression = KTX2Supercompression::None;
+			std::vector<KTX2LevelIndex> Levels;
+		};
+
+		// data is the start of a file of fileSize bytes and holds at least the header and level index
+		static bool ReadLayout(const uint8_t* data, uint64_t dataSize, uint64_t fileSize, KTX2Layout& layout)
+		{
+			if (dataSize < sizeof(KTX2Header))
+			{
+				ZN_CORE_ERROR_TAG("KTX2", "Not a KTX2 file");
+				return false;
+			}
+
+			KTX2Header& header = layout.Header;
+			memcpy(&header, data, sizeof(header));
+
+			layout.Format = GetImageFormatFromKTX2(header.VkFormat);
+			if (layout.Format == ImageFormat::None)
+			{
+				ZN_CORE_ERROR_TAG("KTX2", "Unsupported VkFormat {}", header.VkFormat);
+				return false;
+			}
+
+			if (header.PixelWidth == 0 || header.PixelHeight == 0 || header.PixelDepth > 1 || header.LayerCount > 1 || header.FaceCount != 1)
+			{
+				ZN_CORE_ERROR_TAG("KTX2", "Only single 2D textures are supported");
+				return false;
+			}
+
+			layout.Supercompression = (KTX2Supercompression)header.SupercompressionScheme;
+			if (layout.Supercompression != KTX2Supercompression::None && layout.Supercompression != KTX2Supercompression::ZLIB)
+			{
+				ZN_CORE_ERROR_TAG("KTX2", "Unsupported supercompression scheme {}", header.SupercompressionScheme);
+				return false;
+			}
+
+			// A level count of 0 asks the loader to generate mips, only the base level is stored
+			const uint32_t levelCount = std::max(header.LevelCount, 1u);
+			if (levelCount > (uint32_t)std::bit_width(std::max(header.PixelWidth, header.PixelHeight))
+				|| dataSize < sizeof(header) + levelCount * sizeof(KTX2LevelIndex))
+			{
+				ZN_CORE_ERROR_TAG("KTX2", "Invalid level index");
+				return false;
+			}
+
+			layout.Levels.resize(levelCount);
+			memcpy(layout.Levels.data(), data + sizeof(header), levelCount * sizeof(KTX2LevelIndex));
+
+			for (uint32_t level = 0; level < levelCount; level++)
+			{
+				const KTX2LevelIndex& index = layout.Levels[level];
+				const uint64_t expectedSize = GetLevelSize(layout.Format, header.PixelWidth, header.PixelHeight, level);
+				if (index.ByteOffset > fileSize || index.ByteLength > fileSize - index.ByteOffset || index.UncompressedByteLength != expectedSize
+					|| (layout.Supercompression == KTX2Supercompression::None && index.ByteLength != expectedSize))
+				{
+					ZN_CORE_ERROR_TAG("KTX2", "Invalid level {}", level);
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Levels [firstLevel, end), uninitialized
+		static CookedTexture AllocateLevels(const KTX2Layout& layout, uint32_t firstLevel)
+		{
+			uint64_t dataSize = 0;
+			for (uint32_t level = firstLevel; level < (uint32_t)layout.Levels.size(); level++)
+				dataSize += layout.Levels[level].UncompressedByteLength;
+
+			CookedTexture result;
+			result.Width = layout.Header.PixelWidth;
+			result.Height = layout.Header.PixelHeight;
+			result.MipCount = (uint32_t)layout.Levels.size();
+			result.FirstMip = firstLevel;
+			result.Format = layout.Format;
+			result.Data.Allocate(dataSize);
+			return result;
+		}
+
+		static bool DecodeLevel(const KTX2Layout& layout, uint32_t level, const uint8_t* source, uint8_t* destination)
+		{
+			const KTX2LevelIndex& index = layout.Levels[level];
+			if (layout.Supercompression == KTX2Supercompression::ZLIB)
+			{
+				const int decodedSize = stbi_zlib_decode_buffer((char*)destination, (int)index.UncompressedByteLength, (const char*)source, (int)index.ByteLength);
+				if (decodedSize != (int)index.UncompressedByteLength)
+				{
+					ZN_CORE_ERROR_TAG("KTX2", "Failed to inflate level {}", level);
+					return false;
+				}
+			}
+			else
+			{
+				memcpy(destination, source, index.ByteLength);
+			}
+			return true;
+		}
+
+	}
+
+	bool KTX2::IsKTX2(Buffer data)
+	{
+		return data.Data && data.Size >= sizeof(Utils::KTX2Identifier) && memcmp(data.Data, Utils::KTX2Identifier, sizeof(Utils::KTX2Identifier)) == 0;
+	}
+
+	bool KTX2::IsFormatSupported(ImageFormat format)
+	{
+		return Utils::GetKTX2VkFormat(format) != 0;
+	}
+
+	Buffer KTX2::Encode(const CookedTexture& texture, KTX2Supercompression supercompression)
+	{
+		ZN_PROFILE_FUNC();
+
+		if (!texture.IsValid() || !IsFormatSupported(texture.Format) || texture.FirstMip != 0)
+		{
+			ZN_CORE_ERROR_TAG("KTX2", "Can't encode texture with format {} from mip {}", (int)texture.Format, texture.FirstMip);
+			return {};
+		}
+
+		const bool supercompressed = supercompression != KTX2Supercompression::None;
+		const uint32_t levelCount = texture.MipCount;
+
+		// Level payloads, largest first like the cooked data
+		std::vector<Buffer> levels(levelCount);
+		std::vector<uint64_t> uncompressedSizes(levelCount);
+		uint64_t levelOffset = 0;
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			uncompressedSizes[level] = Utils::GetLevelSize(texture.Format, texture.Width, texture.Height, level);
+			if (levelOffset + uncompressedSizes[level] > texture.Data.Size)
+			{
+				ZN_CORE_ERROR_TAG("KTX2", "Texture data is smaller than its mip chain");
+				for (Buffer& buffer : levels)
+					buffer.Release();
+				return {};
+			}
+
+			uint8_t* levelData = texture.Data.As<uint8_t>() + levelOffset;
+			if (supercompressed)
+			{
+				int compressedSize = 0;
+				unsigned char* compressed = stbi_zlib_compress(levelData, (int)uncompressedSizes[level], &compressedSize, 8);
+				levels[level] = Buffer::Copy(compressed, compressedSize);
+				free(compressed);
+			}
+			else
+			{
+				levels[level] = Buffer(levelData, uncompressedSizes[level]); // not owned
+			}
+			levelOffset += uncompressedSizes[level];
+		}
+
+		const std::vector<uint32_t> dfd = Utils::GetDataFormatDescriptor(texture.Format, supercompressed);
+		const uint32_t dfdOffset = sizeof(Utils::KTX2Header) + levelCount * sizeof(Utils::KTX2LevelIndex);
+		const uint32_t dfdLength = sizeof(uint32_t) * (1 + (uint32_t)dfd.size());
+
+		// Smallest level first in the file, so a streaming reader gets a usable texture early
+		const uint32_t texelBlockSize = Utils::GetTexelBlockSize(texture.Format);
+		const uint64_t alignment = supercompressed ? 1 : std::lcm<uint64_t>(texelBlockSize, 4);
+		std::vector<Utils::KTX2LevelIndex> levelIndex(levelCount);
+		uint64_t fileSize = dfdOffset + dfdLength;
+		for (uint32_t level = levelCount; level-- > 0;)
+		{
+			fileSize = Utils::AlignUp(fileSize, alignment);
+			levelIndex[level] = { fileSize, levels[level].Size, uncompressedSizes[level] };
+			fileSize += levels[level].Size;
+		}
+
+		Utils::KTX2Header header = {};
+		memcpy(header.Identifier, Utils::KTX2Identifier, sizeof(Utils::KTX2Identifier));
+		header.VkFormat = Utils::GetKTX2VkFormat(texture.Format);
+		header.TypeSize = texture.Format == ImageFormat::RGBA32F ? 4 : 1;
+		header.PixelWidth = texture.Width;
+		header.PixelHeight = texture.Height;
+		header.FaceCount = 1;
+		header.LevelCount = levelCount;
+		header.SupercompressionScheme = (uint32_t)supercompression;
+		header.DFDByteOffset = dfdOffset;
+		header.DFDByteLength = dfdLength;
+
+		Buffer result;
+		result.Allocate(fileSize);
+		result.ZeroInitialize();
+
+		uint8_t* data = result.As<uint8_t>();
+		memcpy(data, &header, sizeof(header));
+		memcpy(data + sizeof(header), levelIndex.data(), levelCount * sizeof(Utils::KTX2LevelIndex));
+		memcpy(data + dfdOffset, &dfdLength, sizeof(uint32_t));
+		memcpy(data + dfdOffset + sizeof(uint32_t), dfd.data(), dfd.size() * sizeof(uint32_t));
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			memcpy(data + levelIndex[level].ByteOffset, levels[level].Data, levels[level].Size);
+			if (supercompressed)
+				levels[level].Release();
+		}
+
+		return result;
+	}
+
+	CookedTexture KTX2::Decode(Buffer data)
+	{
+		ZN_PROFILE_FUNC();
+
+		if (!IsKTX2(data))
+		{
+			ZN_CORE_ERROR_TAG("KTX2", "Not a KTX2 file");
+			return {};
+		}
+
+		Utils::KTX2Layout layout;
+		if (!Utils::ReadLayout(data.As<uint8_t>(), data.Size, data.Size, layout))
+			return {};
+
+		CookedTexture result = Utils::AllocateLevels(layout, 0);
+		uint64_t offset = 0;
+		for (uint32_t level = 0; level < result.MipCount; level++)
+		{
+			const Utils::KTX2LevelIndex& index = layout.Levels[level];
+			if (!Utils::DecodeLevel(layout, level, data.As<uint8_t>() + index.ByteOffset, result.Data.As<uint8_t>() + offset))
+			{
+				result.Data.Release();
+				return {};
+			}
+			offset += index.UncompressedByteLength;
+		}
+
+		return result;
+	}
+
+	bool KTX2::Write(const std::filesystem::path& path, const CookedTexture& texture, KTX2Supercompression supercompression)
+	{
+		Buffer data = Encode(texture, supercompression);
+		if (!data)
+			return false;
+
+		std::error_code error;
+		if (path.has_parent_path())
+			std::filesystem::create_directories(path.parent_path(), error);
+
+		std::filesystem::path temporaryPath = path;
+		temporaryPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+		{
+			std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+			stream.write(data.As<char>(), data.Size);
+			if (!stream)
+			{
+				ZN_CORE_WARN_TAG("KTX2", "Failed to write {}", path.string());
+				stream.close();
+				std::filesystem::remove(temporaryPath, error);
+				data.Release();
+				return false;
+			}
+		}
+		data.Release();
+
+		std::filesystem::rename(temporaryPath, path, error);
+		if (error)
+		{
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+		return true;
+	}
+
+	CookedTexture KTX2::Read(const std::filesystem::path& path, uint32_t maxSize)
+	{
+		return ReadFile(path, 0, maxSize);
+	}
+
+	CookedTexture KTX2::ReadMips(const std::filesystem::path& path, uint32_t firstMip)
+	{
+		return ReadFile(path, firstMip, 0);
+	}
+
+	CookedTexture KTX2::ReadFile(const std::filesystem::path& path, uint32_t firstMip, uint32_t maxSize)
+	{
+		ZN_PROFILE_FUNC();
+
+		std::ifstream stream(path, std::ios::binary | std::ios::ate);
+		if (!stream)
+			return {};
+
+		const uint64_t fileSize = (uint64_t)stream.tellg();
+		stream.seekg(0, std::ios::beg);
+
+		// Header and level index, the index can't be larger than this
+		Buffer prefix;
+		prefix.Allocate(std::min<uint64_t>(fileSize, sizeof(Utils::KTX2Header) + 32 * sizeof(Utils::KTX2LevelIndex)));
+		stream.read(prefix.As<char>(), prefix.Size);
+
+		Utils::KTX2Layout layout;
+		const bool valid = stream && IsKTX2(prefix) && Utils::ReadLayout(prefix.As<uint8_t>(), prefix.Size, fileSize, layout);
+		prefix.Release();
+		if (!valid)
+			return {};
+
+		const uint32_t levelCount = (uint32_t)layout.Levels.size();
+		firstMip = std::max(firstMip, TextureCooker::GetFirstMipForSize(layout.Header.PixelWidth, layout.Header.PixelHeight, levelCount, maxSize));
+		if (firstMip >= levelCount)
+		{
+			ZN_CORE_ERROR_TAG("KTX2", "{} has no mip {}", path.string(), firstMip);
+			return {};
+		}
+
+		// Only the requested levels are read from disk
+		CookedTexture result = Utils::AllocateLevels(layout, firstMip);
+		result.FilePath = path;
+
+		Buffer levelData;
+		uint64_t offset = 0;
+		for (uint32_t level = firstMip; level < levelCount; level++)
+		{
+			const Utils::KTX2LevelIndex& index = layout.Levels[level];
+			if (levelData.Size < index.ByteLength)
+			{
+				levelData.Release();
+				levelData.Allocate(index.ByteLength);
+			}
+
+			stream.seekg(index.ByteOffset, std::ios::beg);
+			stream.read(levelData.As<char>(), index.ByteLength);
+			if (!stream || !Utils::DecodeLevel(layout, level, levelData.As<uint8_t>(), result.Data.As<uint8_t>() + offset))
+			{
+				ZN_CORE_ERROR_TAG("KTX2", "Failed to read level {} of {}", level, path.string());
+				levelData.Release();
+				result.Data.Release();
+				return {};
+			}
+			offset += index.UncompressedByteLength;
+		}
+		levelData.Release();
+
+		return result;
+	}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Zenith/Asset/TextureCooker.hpp"
+
+#include <filesystem>
+
+namespace Zenith {
+
+	// Level payload compression of a KTX2 file. Zstandard and Basis Universal are not supported.
+	enum class KTX2Supercompression : uint32_t
+	{
+		None = 0,
+		ZLIB = 3
+	};
+
+	// KTX 2.0 container for a single 2D texture and its mip chain (no arrays, cube maps or 3D textures)
+	class KTX2
+	{
+	public:
+		static bool IsKTX2(Buffer data);
+		static bool IsFormatSupported(ImageFormat format);
+
+		static Buffer Encode(const CookedTexture& texture, KTX2Supercompression supercompression = KTX2Supercompression::ZLIB);
+		static CookedTexture Decode(Buffer data);
+
+		// Written to a temporary file and renamed, so readers never see a partial file
+		static bool Write(const std::filesystem::path& path, const CookedTexture& texture, KTX2Supercompression supercompression = KTX2Supercompression::ZLIB);
+		// Only the levels that are kept are read from disk
+		static CookedTexture Read(const std::filesystem::path& path, uint32_t maxSize = 0); // mips larger than maxSize are skipped (0 = none)
+		static CookedTexture ReadMips(const std::filesystem::path& path, uint32_t firstMip);
+
+	private:
+		static CookedTexture ReadFile(const std::filesystem::path& path, uint32_t firstMip, uint32_t maxSize);
+	};
+
+}
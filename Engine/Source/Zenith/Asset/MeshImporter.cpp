@@ -4,6 +4,8 @@
 #include "Zenith/Asset/AssetManager.hpp"
 #include "Zenith/Renderer/Renderer.hpp"
 #include "Zenith/Asset/TextureImporter.hpp"
+#include "Zenith/Core/Hash.hpp"
+#include "Zenith/Debug/Profiler.hpp"
 #include "Zenith/Math/Math.hpp"
 
 #include <ufbx.h>
@@ -27,8 +29,12 @@ namespace Zenith {
 #define ZN_MESH_ERROR(...)
 #endif
 
-	MeshImporter::MeshImporter(const std::filesystem::path& path)
-		: m_Path(path), m_Format(DetectFormat())
+	// Textures decoded by earlier imports, by content hash (seeded with the color space)
+	static std::unordered_map<uint64_t, AssetHandle> s_DecodedImages;
+	static std::mutex s_DecodedImagesMutex;
+
+	MeshImporter::MeshImporter(const std::filesystem::path& path, const MeshImportSettings& settings)
+		: m_Path(path), m_Format(DetectFormat()), m_Settings(settings)
 	{
 	}
 
@@ -61,13 +67,8 @@ namespace Zenith {
 
 	void MeshImporter::CreateMeshBuffers(Ref<MeshSource> meshSource)
 	{
-		if (!meshSource->m_Vertices.empty())
-			meshSource->m_VertexBuffer = VertexBuffer::Create(meshSource->m_Vertices.data(),
-				static_cast<uint32_t>(meshSource->m_Vertices.size() * sizeof(Vertex)));
-
-		if (!meshSource->m_Indices.empty())
-			meshSource->m_IndexBuffer = IndexBuffer::Create(meshSource->m_Indices.data(),
-				static_cast<uint32_t>(meshSource->m_Indices.size() * sizeof(uint32_t)));
+		meshSource->m_VertexFormat = m_Settings.Format;
+		meshSource->CreateBuffers();
 	}
 
 	Ref<MeshSource> MeshImporter::ImportToMeshSource()
@@ -221,6 +222,7 @@ namespace Zenith {
 
 		ProcessMaterials(meshSource, scene, MeshFormat::FBX);
 
+		meshSource->BuildMeshlets();
 		CreateMeshBuffers(meshSource);
 
 		ZN_MESH_LOG("FBX Import complete: {} vertices, {} indices, {} submeshes",
@@ -502,6 +504,7 @@ namespace Zenith {
 
 		//ProcessMaterials(meshSource, &asset, MeshFormat::GLTF);
 
+		meshSource->BuildMeshlets();
 		CreateMeshBuffers(meshSource);
 
 		ZN_MESH_LOG("glTF Import complete: {} vertices, {} indices, {} submeshes, {} nodes",
@@ -539,6 +542,8 @@ namespace Zenith {
 				size_t matCount = gltfAsset->materials.size();
 				meshSource->m_Materials.resize(matCount);
 
+				DecodeGLTFImages(*gltfAsset);
+
 				for (size_t i = 0; i < matCount; i++)
 				{
 					Ref<MaterialAsset> materialAsset = CreateMaterialFromGLTF(*gltfAsset, i);
@@ -657,6 +662,9 @@ namespace Zenith {
 
 		ImageFormat textureFormat = (debugName == "Normal") ? ImageFormat::RGBA : ImageFormat::SRGBA;
 
+		if (auto it = m_GLTFImageTextures.find(GetGLTFImageKey(imageIndex, textureFormat == ImageFormat::SRGBA)); it != m_GLTFImageTextures.end())
+			return it->second;
+
 		auto CreateTextureFromData = [&](const TextureData& textureData) -> Ref<Texture2D> {
 			if (!textureData.IsValid())
 			{
@@ -725,6 +733,154 @@ namespace Zenith {
 		return resultHandle;
 	}
 
+	Buffer MeshImporter::GetGLTFImageData(const fastgltf::Asset& asset, size_t imageIndex)
+	{
+		const auto& gltfImage = asset.images[imageIndex];
+		if (auto vector = std::get_if<fastgltf::sources::Vector>(&gltfImage.data))
+			return Buffer(vector->bytes.data(), vector->bytes.size());
+
+		if (auto array = std::get_if<fastgltf::sources::Array>(&gltfImage.data))
+			return Buffer(array->bytes.data(), array->bytes.size());
+
+		if (auto bufferView = std::get_if<fastgltf::sources::BufferView>(&gltfImage.data))
+		{
+			if (bufferView->bufferViewIndex >= asset.bufferViews.size())
+				return {};
+
+			const auto& view = asset.bufferViews[bufferView->bufferViewIndex];
+			if (view.bufferIndex >= asset.buffers.size())
+				return {};
+
+			if (auto data = std::get_if<fastgltf::sources::Array>(&asset.buffers[view.bufferIndex].data))
+				return Buffer(reinterpret_cast<const uint8_t*>(data->bytes.data()) + view.byteOffset, view.byteLength);
+		}
+
+		return {};
+	}
+
+	void MeshImporter::DecodeGLTFImages(const fastgltf::Asset& asset)
+	{
+		ZN_PROFILE_FUNC();
+
+		// Images used by the materials, in the color space they are used with (matches LoadImageFromGLTF())
+		std::vector<std::pair<size_t, bool>> images;
+		auto addTexture = [&](size_t textureIndex, bool sRGB)
+		{
+			if (textureIndex < asset.textures.size() && asset.textures[textureIndex].imageIndex.has_value() && asset.textures[textureIndex].imageIndex.value() < asset.images.size())
+				images.emplace_back(asset.textures[textureIndex].imageIndex.value(), sRGB);
+		};
+
+		for (const auto& material : asset.materials)
+		{
+			if (material.pbrData.baseColorTexture.has_value())
+				addTexture(material.pbrData.baseColorTexture->textureIndex, true);
+			if (material.pbrData.metallicRoughnessTexture.has_value())
+				addTexture(material.pbrData.metallicRoughnessTexture->textureIndex, true);
+			if (material.normalTexture.has_value())
+				addTexture(material.normalTexture->textureIndex, false);
+		}
+
+		// Hashing reads image files, it runs without the lock
+		struct ImageSource
+		{
+			uint64_t ImageKey;
+			uint64_t ContentKey;
+			TextureDecodeRequest Request;
+		};
+		std::vector<ImageSource> sources;
+		for (const auto& [imageIndex, sRGB] : images)
+		{
+			const uint64_t imageKey = GetGLTFImageKey(imageIndex, sRGB);
+			if (m_GLTFImageTextures.contains(imageKey))
+				continue;
+
+			TextureDecodeRequest request;
+			request.PreferredFormat = sRGB ? ImageFormat::SRGBA : ImageFormat::RGBA;
+			request.EncodedData = GetGLTFImageData(asset, imageIndex);
+
+			uint64_t contentKey;
+			if (request.EncodedData)
+			{
+				contentKey = XXHash64::compute(request.EncodedData.Data, request.EncodedData.Size, sRGB);
+			}
+			else if (auto uri = std::get_if<fastgltf::sources::URI>(&asset.images[imageIndex].data))
+			{
+				request.Path = m_Path.parent_path() / uri->uri.path();
+				const uint64_t fileHash = FileSystem::GetContentHash(request.Path);
+				contentKey = XXHash64::compute(&fileHash, sizeof(fileHash), sRGB);
+			}
+			else
+			{
+				continue;
+			}
+
+			sources.push_back({ imageKey, contentKey, std::move(request) });
+		}
+
+		std::vector<AssetHandle> cachedHandles(sources.size(), AssetHandle{ 0 });
+		{
+			std::scoped_lock lock(s_DecodedImagesMutex);
+			for (size_t i = 0; i < sources.size(); i++)
+			{
+				if (auto it = s_DecodedImages.find(sources[i].ContentKey); it != s_DecodedImages.end())
+					cachedHandles[i] = it->second;
+			}
+		}
+
+		std::vector<TextureDecodeRequest> requests;
+		std::vector<uint64_t> requestContentKeys;
+		std::vector<std::vector<uint64_t>> requestImageKeys;
+		std::unordered_map<uint64_t, size_t> requestIndices; // content key -> request
+		for (size_t i = 0; i < sources.size(); i++)
+		{
+			ImageSource& source = sources[i];
+			if (cachedHandles[i] && Project::GetAssetManager()->GetMemoryAsset(cachedHandles[i]))
+			{
+				m_GLTFImageTextures[source.ImageKey] = cachedHandles[i];
+				continue;
+			}
+
+			auto [it, inserted] = requestIndices.try_emplace(source.ContentKey, requests.size());
+			if (inserted)
+			{
+				requests.push_back(std::move(source.Request));
+				requestContentKeys.push_back(source.ContentKey);
+				requestImageKeys.emplace_back();
+			}
+			requestImageKeys[it->second].push_back(source.ImageKey);
+		}
+
+		if (requests.empty())
+			return;
+
+		ZN_MESH_LOG("Decoding {} unique images ({} referenced)", requests.size(), images.size());
+		std::vector<TextureData> decoded = TextureImporter::LoadTextureDataParallel(requests);
+
+		std::vector<std::pair<uint64_t, AssetHandle>> created; // content key -> texture
+		for (size_t i = 0; i < decoded.size(); i++)
+		{
+			if (!decoded[i].IsValid())
+			{
+				ZN_CORE_ERROR_TAG("Mesh", "Failed to decode glTF image");
+				continue;
+			}
+
+			Ref<Texture2D> texture = TextureImporter::CreateTexture(decoded[i], m_Path.filename().string());
+			decoded[i].ImageData.Release();
+			if (!texture)
+				continue;
+
+			const AssetHandle handle = AssetManager::AddMemoryOnlyAsset(texture);
+			created.emplace_back(requestContentKeys[i], handle);
+			for (uint64_t imageKey : requestImageKeys[i])
+				m_GLTFImageTextures[imageKey] = handle;
+		}
+
+		std::scoped_lock lock(s_DecodedImagesMutex);
+		for (const auto& [contentKey, handle] : created)
+			s_DecodedImages[contentKey] = handle;
+	}
+
 	AssetHandle MeshImporter::CreateMaterialFromTexture(const std::string& texturePath, const std::string& name)
 	{
 		ZN_MESH_LOG("Texture reference found but PBR materials disabled: {0}", texturePath);
@@ -35,10 +35,16 @@ namespace Zenith {
 		GLB
 	};
 
+	struct MeshImportSettings
+	{
+		// GPU vertex encoding, the CPU side vertices are always kept at full precision
+		VertexFormat Format = VertexFormat::Standard;
+	};
+
 	class MeshImporter
 	{
 	public:
-		MeshImporter(const std::filesystem::path& path);
+		MeshImporter(const std::filesystem::path& path, const MeshImportSettings& settings = {});
 
 		Ref<MeshSource> ImportToMeshSource();
 
@@ -59,6 +65,12 @@ namespace Zenith {
 		AssetHandle ProcessGLTFTexture(const fastgltf::Asset& asset, size_t textureIndex, const std::string& semanticName);
 		AssetHandle LoadImageFromGLTF(const fastgltf::Asset& asset, size_t imageIndex, const std::string& debugName);
 
+		// Decodes every image the materials use up front, in parallel. Identical images (also from earlier imports) share a texture.
+		void DecodeGLTFImages(const fastgltf::Asset& asset);
+		// Encoded bytes of an embedded image (not owned), empty for images stored in separate files
+		static Buffer GetGLTFImageData(const fastgltf::Asset& asset, size_t imageIndex);
+		static uint64_t GetGLTFImageKey(size_t imageIndex, bool sRGB) { return (uint64_t(imageIndex) << 1) | (sRGB ? 1 : 0); }
+
 		void CreateMeshBuffers(Ref<MeshSource> meshSource);
 
 		static glm::mat4 ToGLMMat4(const float* matrix);
@@ -68,6 +80,9 @@ namespace Zenith {
 	private:
 		const std::filesystem::path m_Path;
 		MeshFormat m_Format;
+		MeshImportSettings m_Settings;
+
+		std::unordered_map<uint64_t, AssetHandle> m_GLTFImageTextures; // GetGLTFImageKey() -> texture
 	};
 
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 
 #include "Zenith/Asset/AssetManager.hpp"
 #include "Zenith/Project/Project.hpp"
+#include "Zenith/Renderer/Renderer.hpp"
 
 #include "MeshImporter.hpp"
 
@@ -66,7 +67,7 @@ namespace Zenith {
 
 	void RegisterStaticMeshDependenciesFromJSON(const json& data, AssetHandle handle)
 	{
-		Project::GetEditorAssetManager()->DeregisterDependencies(handle);
+		AssetManager::DeregisterDependencies(handle);
 		AssetHandle meshSourceHandle = AssetHandle{0};
 
 		if (data.contains("Mesh"))
@@ -77,14 +78,17 @@ namespace Zenith {
 		}
 
 		// must always register something, even if it's 0
-		Project::GetEditorAssetManager()->RegisterDependency(meshSourceHandle, handle);
+		AssetManager::RegisterDependency(meshSourceHandle, handle);
 	}
 
 	bool MeshSourceSerializer::TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset) const
 	{
 		ZN_PROFILE_FUNC("MeshSourceSerializer::TryLoadData");
 
-		MeshImporter importer(Project::GetEditorAssetManager()->GetFileSystemPathString(metadata));
+		MeshImportSettings settings;
+		settings.Format = Renderer::GetConfig().MeshVertexFormat;
+
+		MeshImporter importer((Project::GetActiveAssetDirectory() / metadata.FilePath).string(), settings);
 		Ref<MeshSource> meshSource = importer.ImportToMeshSource();
 		if (!meshSource)
 			return false;
@@ -108,13 +112,22 @@ namespace Zenith {
 	}
 
 	bool StaticMeshSerializer::TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset) const
+	{
+		return TryLoadDataFromJSON(metadata, GetJSONFromFile(metadata), asset);
+	}
+
+	bool StaticMeshSerializer::TryLoadDataFromMemory(const AssetMetadata& metadata, Buffer data, Ref<Asset>& asset) const
+	{
+		return TryLoadDataFromJSON(metadata, std::string(data.As<const char>(), data.Size), asset);
+	}
+
+	bool StaticMeshSerializer::TryLoadDataFromJSON(const AssetMetadata& metadata, const std::string& jsonString, Ref<Asset>& asset) const
 	{
 		Ref<StaticMesh> staticMesh;
-		std::string jsonStr = GetJSONFromFile(metadata);
 
 		try
 		{
-			json data = json::parse(jsonStr);
+			json data = json::parse(jsonString);
 			bool success = DeserializeFromJSON(data, staticMesh);
 			if (!success)
 				return false;
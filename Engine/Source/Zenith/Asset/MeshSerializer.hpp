@@ -19,6 +19,9 @@ namespace Zenith {
 		virtual void Serialize(const AssetMetadata& metadata, const Ref<Asset>& asset) const override;
 		virtual bool TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset) const override;
 		virtual void RegisterDependencies(const AssetMetadata& metadata) const override;
+		virtual bool TryLoadDataFromMemory(const AssetMetadata& metadata, Buffer data, Ref<Asset>& asset) const override;
+	private:
+		bool TryLoadDataFromJSON(const AssetMetadata& metadata, const std::string& jsonString, Ref<Asset>& asset) const;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,1367 @@
+#include "znpch.hpp"
+#include "TextureCooker.hpp"
+
+#include "KTX2.hpp"
+
+#include "Zenith/Core/Hash.hpp"
+#include "Zenith/Core/Thread.hpp"
+#include "Zenith/Debug/Profiler.hpp"
+#include "Zenith/Utilities/FileSystem.hpp"
+
+#include <array>
+#include <atomic>
+#include <numbers>
+
+namespace Zenith {
+
+	namespace Utils {
+
+		// Bump when the encoders or mip filter change, so stale cache entries are not used
+		static constexpr uint32_t CookerVersion = 3;
+
+		template<uint32_t N>
+		using Color = std::array<float, N>;
+
+		static float SRGBToLinear(float value)
+		{
+			return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+		}
+
+		static float LinearToSRGB(float value)
+		{
+			return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+		}
+
+		static uint16_t FloatToHalf(float value)
+		{
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(float));
+
+			const uint32_t sign = (bits >> 16) & 0x8000;
+			const int32_t exponent = int32_t((bits >> 23) & 0xff) - 127 + 15;
+			uint32_t mantissa = bits & 0x7fffff;
+
+			if (((bits >> 23) & 0xff) == 0xff)
+				return uint16_t(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+			if (exponent >= 31)
+				return uint16_t(sign | 0x7c00);
+			if (exponent <= 0)
+			{
+				if (exponent < -10)
+					return uint16_t(sign);
+
+				mantissa |= 0x800000;
+				const uint32_t shift = uint32_t(14 - exponent);
+				uint32_t half = mantissa >> shift;
+				if ((mantissa >> (shift - 1)) & 1)
+					half++;
+				return uint16_t(sign | half);
+			}
+
+			uint32_t half = sign | (uint32_t(exponent) << 10) | (mantissa >> 13);
+			if (mantissa & 0x1000)
+				half++; // may carry into the exponent, which rounds up correctly
+			return uint16_t(half);
+		}
+
+		static float HalfToFloat(uint16_t half)
+		{
+			const uint32_t sign = uint32_t(half & 0x8000) << 16;
+			uint32_t exponent = (half >> 10) & 0x1f;
+			uint32_t mantissa = half & 0x3ff;
+
+			uint32_t bits;
+			if (exponent == 0)
+			{
+				if (mantissa == 0)
+				{
+					bits = sign;
+				}
+				else
+				{
+					exponent = 127 - 15 + 1;
+					while (!(mantissa & 0x400))
+					{
+						mantissa <<= 1;
+						exponent--;
+					}
+					bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+				}
+			}
+			else if (exponent == 31)
+			{
+				bits = sign | 0x7f800000 | (mantissa << 13);
+			}
+			else
+			{
+				bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+			}
+
+			float value;
+			memcpy(&value, &bits, sizeof(float));
+			return value;
+		}
+
+		// Packs fields LSB first, the bit order of all BCn formats
+		class BlockWriter
+		{
+		public:
+			explicit BlockWriter(uint8_t* block, uint32_t size) : m_Block(block) { memset(block, 0, size); }
+
+			void Write(uint32_t value, uint32_t bitCount)
+			{
+				for (uint32_t i = 0; i < bitCount; i++, m_Bit++)
+				{
+					if ((value >> i) & 1)
+						m_Block[m_Bit >> 3] |= uint8_t(1u << (m_Bit & 7));
+				}
+			}
+
+		private:
+			uint8_t* m_Block;
+			uint32_t m_Bit = 0;
+		};
+
+		class BlockReader
+		{
+		public:
+			explicit BlockReader(const uint8_t* block) : m_Block(block) {}
+
+			uint32_t Read(uint32_t bitCount)
+			{
+				uint32_t value = 0;
+				for (uint32_t i = 0; i < bitCount; i++, m_Bit++)
+					value |= uint32_t((m_Block[m_Bit >> 3] >> (m_Bit & 7)) & 1) << i;
+				return value;
+			}
+
+		private:
+			const uint8_t* m_Block;
+			uint32_t m_Bit = 0;
+		};
+
+		//////////////////////////////////////////////////////////////////////////////////
+		// Endpoint fitting
+		//////////////////////////////////////////////////////////////////////////////////
+
+		template<uint32_t N>
+		static void FitEndpoints(const Color<N>* pixels, TextureCookQuality quality, Color<N>& outEndpoint0, Color<N>& outEndpoint1)
+		{
+			if (quality == TextureCookQuality::Fast || N == 1)
+			{
+				outEndpoint0 = pixels[0];
+				outEndpoint1 = pixels[0];
+				for (uint32_t i = 1; i < 16; i++)
+				{
+					for (uint32_t c = 0; c < N; c++)
+					{
+						outEndpoint0[c] = std::min(outEndpoint0[c], pixels[i][c]);
+						outEndpoint1[c] = std::max(outEndpoint1[c], pixels[i][c]);
+					}
+				}
+				return;
+			}
+
+			Color<N> mean{};
+			for (uint32_t i = 0; i < 16; i++)
+				for (uint32_t c = 0; c < N; c++)
+					mean[c] += pixels[i][c] / 16.0f;
+
+			float covariance[N][N] = {};
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				for (uint32_t a = 0; a < N; a++)
+					for (uint32_t b = 0; b < N; b++)
+						covariance[a][b] += (pixels[i][a] - mean[a]) * (pixels[i][b] - mean[b]);
+			}
+
+			// Principal axis by power iteration, starting from the bounding box diagonal
+			Color<N> axis{};
+			{
+				Color<N> minColor = pixels[0], maxColor = pixels[0];
+				for (uint32_t i = 1; i < 16; i++)
+				{
+					for (uint32_t c = 0; c < N; c++)
+					{
+						minColor[c] = std::min(minColor[c], pixels[i][c]);
+						maxColor[c] = std::max(maxColor[c], pixels[i][c]);
+					}
+				}
+				for (uint32_t c = 0; c < N; c++)
+					axis[c] = maxColor[c] - minColor[c];
+			}
+
+			for (uint32_t iteration = 0; iteration < 8; iteration++)
+			{
+				Color<N> next{};
+				float length = 0.0f;
+				for (uint32_t a = 0; a < N; a++)
+				{
+					for (uint32_t b = 0; b < N; b++)
+						next[a] += covariance[a][b] * axis[b];
+					length = std::max(length, std::abs(next[a]));
+				}
+
+				if (length < 1e-6f)
+					break;
+
+				for (uint32_t c = 0; c < N; c++)
+					axis[c] = next[c] / length;
+			}
+
+			float axisLengthSquared = 0.0f;
+			for (uint32_t c = 0; c < N; c++)
+				axisLengthSquared += axis[c] * axis[c];
+
+			if (axisLengthSquared < 1e-12f)
+			{
+				outEndpoint0 = mean;
+				outEndpoint1 = mean;
+				return;
+			}
+
+			float minT = FLT_MAX, maxT = -FLT_MAX;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				float t = 0.0f;
+				for (uint32_t c = 0; c < N; c++)
+					t += (pixels[i][c] - mean[c]) * axis[c];
+				t /= axisLengthSquared;
+				minT = std::min(minT, t);
+				maxT = std::max(maxT, t);
+			}
+
+			for (uint32_t c = 0; c < N; c++)
+			{
+				outEndpoint0[c] = mean[c] + axis[c] * minT;
+				outEndpoint1[c] = mean[c] + axis[c] * maxT;
+			}
+		}
+
+		// Least squares endpoints for fixed interpolation weights (0 = endpoint0, 1 = endpoint1)
+		template<uint32_t N>
+		static bool RefineEndpoints(const Color<N>* pixels, const float* weights, Color<N>& endpoint0, Color<N>& endpoint1)
+		{
+			float a = 0.0f, b = 0.0f, c = 0.0f;
+			Color<N> x0{}, x1{};
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				const float w = weights[i];
+				a += (1.0f - w) * (1.0f - w);
+				b += (1.0f - w) * w;
+				c += w * w;
+				for (uint32_t channel = 0; channel < N; channel++)
+				{
+					x0[channel] += (1.0f - w) * pixels[i][channel];
+					x1[channel] += w * pixels[i][channel];
+				}
+			}
+
+			const float determinant = a * c - b * b;
+			if (std::abs(determinant) < 1e-6f)
+				return false;
+
+			for (uint32_t channel = 0; channel < N; channel++)
+			{
+				endpoint0[channel] = (c * x0[channel] - b * x1[channel]) / determinant;
+				endpoint1[channel] = (a * x1[channel] - b * x0[channel]) / determinant;
+			}
+			return true;
+		}
+
+		template<uint32_t N>
+		static float GetDistanceSquared(const Color<N>& a, const Color<N>& b)
+		{
+			float distance = 0.0f;
+			for (uint32_t c = 0; c < N; c++)
+				distance += (a[c] - b[c]) * (a[c] - b[c]);
+			return distance;
+		}
+
+		template<uint32_t N, uint32_t PaletteSize>
+		static float SelectIndices(const Color<N>* pixels, const Color<N> (&palette)[PaletteSize], uint8_t* outIndices)
+		{
+			float error = 0.0f;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				float bestDistance = FLT_MAX;
+				for (uint32_t p = 0; p < PaletteSize; p++)
+				{
+					const float distance = GetDistanceSquared<N>(pixels[i], palette[p]);
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						outIndices[i] = uint8_t(p);
+					}
+				}
+				error += bestDistance;
+			}
+			return error;
+		}
+
+		// Fits, quantizes and (for High quality) refines one block. Encoding is one of the block encodings below.
+		template<uint32_t N, typename Encoding>
+		static Encoding FitAndQuantize(const Color<N>* pixels, TextureCookQuality quality)
+		{
+			Color<N> endpoint0, endpoint1;
+			FitEndpoints<N>(pixels, quality, endpoint0, endpoint1);
+
+			Encoding best = Encoding::Quantize(pixels, endpoint0, endpoint1);
+			if (quality != TextureCookQuality::High)
+				return best;
+
+			for (uint32_t iteration = 0; iteration < 2 && best.Error > 0.0f; iteration++)
+			{
+				float weights[16];
+				best.GetWeights(weights);
+				best.GetEndpoints(endpoint0, endpoint1);
+				if (!RefineEndpoints<N>(pixels, weights, endpoint0, endpoint1))
+					break;
+
+				Encoding candidate = Encoding::Quantize(pixels, endpoint0, endpoint1);
+				if (candidate.Error >= best.Error)
+					break;
+
+				best = candidate;
+			}
+			return best;
+		}
+
+		//////////////////////////////////////////////////////////////////////////////////
+		// BC1 color (also the color half of BC3). Pixels are 0-255.
+		//////////////////////////////////////////////////////////////////////////////////
+
+		struct BC1ColorEncoding
+		{
+			uint16_t Endpoints[2] = {};
+			uint8_t Indices[16] = {};
+			float Error = 0.0f;
+
+			static uint16_t Pack565(const Color<3>& color)
+			{
+				const uint32_t r = (uint32_t)std::clamp(std::round(color[0] * 31.0f / 255.0f), 0.0f, 31.0f);
+				const uint32_t g = (uint32_t)std::clamp(std::round(color[1] * 63.0f / 255.0f), 0.0f, 63.0f);
+				const uint32_t b = (uint32_t)std::clamp(std::round(color[2] * 31.0f / 255.0f), 0.0f, 31.0f);
+				return uint16_t((r << 11) | (g << 5) | b);
+			}
+
+			static Color<3> Unpack565(uint16_t packed)
+			{
+				const uint32_t r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+				return { float((r << 3) | (r >> 2)), float((g << 2) | (g >> 4)), float((b << 3) | (b >> 2)) };
+			}
+
+			static BC1ColorEncoding Quantize(const Color<3>* pixels, const Color<3>& endpoint0, const Color<3>& endpoint1)
+			{
+				BC1ColorEncoding encoding;
+				encoding.Endpoints[0] = Pack565(endpoint0);
+				encoding.Endpoints[1] = Pack565(endpoint1);
+
+				// Endpoint0 > endpoint1 selects the four color mode
+				if (encoding.Endpoints[0] < encoding.Endpoints[1])
+					std::swap(encoding.Endpoints[0], encoding.Endpoints[1]);
+
+				const Color<3> color0 = Unpack565(encoding.Endpoints[0]);
+				const Color<3> color1 = Unpack565(encoding.Endpoints[1]);
+				if (encoding.Endpoints[0] == encoding.Endpoints[1])
+				{
+					for (uint32_t i = 0; i < 16; i++)
+						encoding.Error += GetDistanceSquared<3>(pixels[i], color0);
+					return encoding;
+				}
+
+				Color<3> palette[4] = { color0, color1 };
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					palette[2][c] = (2.0f * color0[c] + color1[c]) / 3.0f;
+					palette[3][c] = (color0[c] + 2.0f * color1[c]) / 3.0f;
+				}
+
+				encoding.Error = SelectIndices<3>(pixels, palette, encoding.Indices);
+				return encoding;
+			}
+
+			void GetWeights(float* weights) const
+			{
+				static constexpr float IndexWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+				for (uint32_t i = 0; i < 16; i++)
+					weights[i] = IndexWeights[Indices[i]];
+			}
+
+			void GetEndpoints(Color<3>& endpoint0, Color<3>& endpoint1) const
+			{
+				endpoint0 = Unpack565(Endpoints[0]);
+				endpoint1 = Unpack565(Endpoints[1]);
+			}
+
+			void Write(uint8_t* block) const
+			{
+				BlockWriter writer(block, 8);
+				writer.Write(Endpoints[0], 16);
+				writer.Write(Endpoints[1], 16);
+				for (uint32_t i = 0; i < 16; i++)
+					writer.Write(Indices[i], 2);
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////////////
+		// BC4 (one channel, also BC3 alpha and both halves of BC5). Pixels are 0-255.
+		//////////////////////////////////////////////////////////////////////////////////
+
+		struct BC4Encoding
+		{
+			uint8_t Endpoints[2] = {};
+			uint8_t Indices[16] = {};
+			float Error = 0.0f;
+
+			static BC4Encoding Quantize(const Color<1>* pixels, const Color<1>& endpoint0, const Color<1>& endpoint1)
+			{
+				BC4Encoding encoding;
+
+				// Endpoint0 > endpoint1 selects the eight value mode
+				const float high = std::max(endpoint0[0], endpoint1[0]);
+				const float low = std::min(endpoint0[0], endpoint1[0]);
+				encoding.Endpoints[0] = (uint8_t)std::clamp(std::round(high), 0.0f, 255.0f);
+				encoding.Endpoints[1] = (uint8_t)std::clamp(std::round(low), 0.0f, 255.0f);
+
+				const float value0 = encoding.Endpoints[0], value1 = encoding.Endpoints[1];
+				if (encoding.Endpoints[0] == encoding.Endpoints[1])
+				{
+					for (uint32_t i = 0; i < 16; i++)
+						encoding.Error += (pixels[i][0] - value0) * (pixels[i][0] - value0);
+					return encoding;
+				}
+
+				Color<1> palette[8] = { { value0 }, { value1 } };
+				for (uint32_t p = 2; p < 8; p++)
+					palette[p][0] = (float(8 - p) * value0 + float(p - 1) * value1) / 7.0f;
+
+				encoding.Error = SelectIndices<1>(pixels, palette, encoding.Indices);
+				return encoding;
+			}
+
+			void GetWeights(float* weights) const
+			{
+				for (uint32_t i = 0; i < 16; i++)
+					weights[i] = Indices[i] == 0 ? 0.0f : Indices[i] == 1 ? 1.0f : float(Indices[i] - 1) / 7.0f;
+			}
+
+			void GetEndpoints(Color<1>& endpoint0, Color<1>& endpoint1) const
+			{
+				endpoint0[0] = Endpoints[0];
+				endpoint1[0] = Endpoints[1];
+			}
+
+			void Write(uint8_t* block) const
+			{
+				BlockWriter writer(block, 8);
+				writer.Write(Endpoints[0], 8);
+				writer.Write(Endpoints[1], 8);
+				for (uint32_t i = 0; i < 16; i++)
+					writer.Write(Indices[i], 3);
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////////////
+		// BC7, mode 6 only: one subset, RGBA 7.7.7.7 endpoints with a p-bit each, 4-bit indices.
+		// Pixels are 0-255.
+		//////////////////////////////////////////////////////////////////////////////////
+
+		static constexpr uint32_t BC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		struct BC7Mode6Encoding
+		{
+			uint8_t Endpoints[2][4] = {}; // 7 bits
+			uint8_t PBits[2] = {};
+			uint8_t Indices[16] = {};
+			float Error = 0.0f;
+
+			static uint32_t Expand(uint8_t value, uint8_t pBit) { return (uint32_t(value) << 1) | pBit; }
+
+			static void QuantizeEndpoint(const Color<4>& endpoint, uint8_t* outValues, uint8_t& outPBit)
+			{
+				float bestError = FLT_MAX;
+				for (uint8_t pBit = 0; pBit < 2; pBit++)
+				{
+					uint8_t values[4];
+					float error = 0.0f;
+					for (uint32_t c = 0; c < 4; c++)
+					{
+						values[c] = (uint8_t)std::clamp(std::round((endpoint[c] - pBit) / 2.0f), 0.0f, 127.0f);
+						const float difference = float(Expand(values[c], pBit)) - endpoint[c];
+						error += difference * difference;
+					}
+
+					if (error < bestError)
+					{
+						bestError = error;
+						outPBit = pBit;
+						memcpy(outValues, values, sizeof(values));
+					}
+				}
+			}
+
+			static BC7Mode6Encoding Quantize(const Color<4>* pixels, const Color<4>& endpoint0, const Color<4>& endpoint1)
+			{
+				BC7Mode6Encoding encoding;
+				QuantizeEndpoint(endpoint0, encoding.Endpoints[0], encoding.PBits[0]);
+				QuantizeEndpoint(endpoint1, encoding.Endpoints[1], encoding.PBits[1]);
+
+				Color<4> palette[16];
+				for (uint32_t p = 0; p < 16; p++)
+				{
+					for (uint32_t c = 0; c < 4; c++)
+					{
+						const uint32_t value0 = Expand(encoding.Endpoints[0][c], encoding.PBits[0]);
+						const uint32_t value1 = Expand(encoding.Endpoints[1][c], encoding.PBits[1]);
+						palette[p][c] = float(((64 - BC7Weights4[p]) * value0 + BC7Weights4[p] * value1 + 32) >> 6);
+					}
+				}
+
+				encoding.Error = SelectIndices<4>(pixels, palette, encoding.Indices);
+
+				// The first index's top bit is implied 0, the palette is symmetric so swapping endpoints flips the indices
+				if (encoding.Indices[0] & 8)
+				{
+					std::swap(encoding.Endpoints[0], encoding.Endpoints[1]);
+					std::swap(encoding.PBits[0], encoding.PBits[1]);
+					for (uint32_t i = 0; i < 16; i++)
+						encoding.Indices[i] = 15 - encoding.Indices[i];
+				}
+				return encoding;
+			}
+
+			void GetWeights(float* weights) const
+			{
+				for (uint32_t i = 0; i < 16; i++)
+					weights[i] = float(BC7Weights4[Indices[i]]) / 64.0f;
+			}
+
+			void GetEndpoints(Color<4>& endpoint0, Color<4>& endpoint1) const
+			{
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					endpoint0[c] = float(Expand(Endpoints[0][c], PBits[0]));
+					endpoint1[c] = float(Expand(Endpoints[1][c], PBits[1]));
+				}
+			}
+
+			void Write(uint8_t* block) const
+			{
+				BlockWriter writer(block, 16);
+				writer.Write(1 << 6, 7); // mode 6
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					writer.Write(Endpoints[0][c], 7);
+					writer.Write(Endpoints[1][c], 7);
+				}
+				writer.Write(PBits[0], 1);
+				writer.Write(PBits[1], 1);
+				for (uint32_t i = 0; i < 16; i++)
+					writer.Write(Indices[i], i == 0 ? 3 : 4);
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////////////
+		// BC6H unsigned, mode 11 only: one region, 10-bit untransformed endpoints, 4-bit indices.
+		// Pixels are half float bit patterns (0 - 0x7bff), which interpolate roughly logarithmically.
+		//////////////////////////////////////////////////////////////////////////////////
+
+		struct BC6HMode11Encoding
+		{
+			uint16_t Endpoints[2][3] = {}; // 10 bits
+			uint8_t Indices[16] = {};
+			float Error = 0.0f;
+
+			static int32_t Unquantize(uint32_t value)
+			{
+				if (value == 0)
+					return 0;
+				if (value == 1023)
+					return 0xffff;
+				return int32_t(((value << 16) + 0x8000) >> 10);
+			}
+
+			static float FinishUnquantize(int32_t value) { return float((value * 31) >> 6); }
+
+			static uint16_t QuantizeValue(float half)
+			{
+				const float target = std::clamp(half, 0.0f, float(0x7bff));
+				const int32_t guess = (int32_t)std::round((target * 64.0f / 31.0f - 32.0f) / 64.0f);
+
+				uint16_t best = 0;
+				float bestError = FLT_MAX;
+				for (int32_t candidate = guess - 1; candidate <= guess + 1; candidate++)
+				{
+					if (candidate < 0 || candidate > 1023)
+						continue;
+
+					const float error = std::abs(FinishUnquantize(Unquantize(candidate)) - target);
+					if (error < bestError)
+					{
+						bestError = error;
+						best = uint16_t(candidate);
+					}
+				}
+				return best;
+			}
+
+			static BC6HMode11Encoding Quantize(const Color<3>* pixels, const Color<3>& endpoint0, const Color<3>& endpoint1)
+			{
+				BC6HMode11Encoding encoding;
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					encoding.Endpoints[0][c] = QuantizeValue(endpoint0[c]);
+					encoding.Endpoints[1][c] = QuantizeValue(endpoint1[c]);
+				}
+
+				Color<3> palette[16];
+				for (uint32_t p = 0; p < 16; p++)
+				{
+					for (uint32_t c = 0; c < 3; c++)
+					{
+						const int32_t value0 = Unquantize(encoding.Endpoints[0][c]);
+						const int32_t value1 = Unquantize(encoding.Endpoints[1][c]);
+						palette[p][c] = FinishUnquantize((value0 * int32_t(64 - BC7Weights4[p]) + value1 * int32_t(BC7Weights4[p]) + 32) >> 6);
+					}
+				}
+
+				encoding.Error = SelectIndices<3>(pixels, palette, encoding.Indices);
+
+				if (encoding.Indices[0] & 8)
+				{
+					std::swap(encoding.Endpoints[0], encoding.Endpoints[1]);
+					for (uint32_t i = 0; i < 16; i++)
+						encoding.Indices[i] = 15 - encoding.Indices[i];
+				}
+				return encoding;
+			}
+
+			void GetWeights(float* weights) const
+			{
+				for (uint32_t i = 0; i < 16; i++)
+					weights[i] = float(BC7Weights4[Indices[i]]) / 64.0f;
+			}
+
+			void GetEndpoints(Color<3>& endpoint0, Color<3>& endpoint1) const
+			{
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					endpoint0[c] = FinishUnquantize(Unquantize(Endpoints[0][c]));
+					endpoint1[c] = FinishUnquantize(Unquantize(Endpoints[1][c]));
+				}
+			}
+
+			void Write(uint8_t* block) const
+			{
+				BlockWriter writer(block, 16);
+				writer.Write(0x03, 5); // mode 11
+				for (uint32_t endpoint = 0; endpoint < 2; endpoint++)
+					for (uint32_t c = 0; c < 3; c++)
+						writer.Write(Endpoints[endpoint][c], 10);
+				for (uint32_t i = 0; i < 16; i++)
+					writer.Write(Indices[i], i == 0 ? 3 : 4);
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////////////
+		// Blocks
+		//////////////////////////////////////////////////////////////////////////////////
+
+		// 16 pixels in encoding space: 0-255 for the LDR formats, half float bits for BC6H
+		using BlockPixels = std::array<Color<4>, 16>;
+
+		template<uint32_t N>
+		static std::array<Color<N>, 16> GetChannels(const BlockPixels& pixels, uint32_t firstChannel)
+		{
+			std::array<Color<N>, 16> result;
+			for (uint32_t i = 0; i < 16; i++)
+				for (uint32_t c = 0; c < N; c++)
+					result[i][c] = pixels[i][firstChannel + c];
+			return result;
+		}
+
+		static void EncodeBlock(ImageFormat format, TextureCookQuality quality, const BlockPixels& pixels, uint8_t* block)
+		{
+			switch (format)
+			{
+				case ImageFormat::BC1:
+				case ImageFormat::BC1_SRGB:
+					FitAndQuantize<3, BC1ColorEncoding>(GetChannels<3>(pixels, 0).data(), quality).Write(block);
+					return;
+				case ImageFormat::BC3:
+				case ImageFormat::BC3_SRGB:
+					FitAndQuantize<1, BC4Encoding>(GetChannels<1>(pixels, 3).data(), quality).Write(block);
+					FitAndQuantize<3, BC1ColorEncoding>(GetChannels<3>(pixels, 0).data(), quality).Write(block + 8);
+					return;
+				case ImageFormat::BC4:
+					FitAndQuantize<1, BC4Encoding>(GetChannels<1>(pixels, 0).data(), quality).Write(block);
+					return;
+				case ImageFormat::BC5:
+					FitAndQuantize<1, BC4Encoding>(GetChannels<1>(pixels, 0).data(), quality).Write(block);
+					FitAndQuantize<1, BC4Encoding>(GetChannels<1>(pixels, 1).data(), quality).Write(block + 8);
+					return;
+				case ImageFormat::BC6H:
+					FitAndQuantize<3, BC6HMode11Encoding>(GetChannels<3>(pixels, 0).data(), quality).Write(block);
+					return;
+				case ImageFormat::BC7:
+				case ImageFormat::BC7_SRGB:
+					FitAndQuantize<4, BC7Mode6Encoding>(pixels.data(), quality).Write(block);
+					return;
+			}
+			ZN_CORE_ASSERT(false, "Not a block compressed format");
+		}
+
+		static void DecodeBC1Color(const uint8_t* block, uint8_t (*outPixels)[4], bool allowTransparent)
+		{
+			BlockReader reader(block);
+			const uint16_t endpoint0 = (uint16_t)reader.Read(16);
+			const uint16_t endpoint1 = (uint16_t)reader.Read(16);
+			const Color<3> color0 = BC1ColorEncoding::Unpack565(endpoint0);
+			const Color<3> color1 = BC1ColorEncoding::Unpack565(endpoint1);
+
+			uint8_t palette[4][4];
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				const uint32_t value0 = (uint32_t)color0[c], value1 = (uint32_t)color1[c];
+				palette[0][c] = uint8_t(value0);
+				palette[1][c] = uint8_t(value1);
+				if (endpoint0 > endpoint1 || !allowTransparent)
+				{
+					palette[2][c] = uint8_t((2 * value0 + value1 + 1) / 3);
+					palette[3][c] = uint8_t((value0 + 2 * value1 + 1) / 3);
+				}
+				else
+				{
+					palette[2][c] = uint8_t((value0 + value1 + 1) / 2);
+					palette[3][c] = 0;
+				}
+			}
+			for (uint32_t p = 0; p < 4; p++)
+				palette[p][3] = 255;
+			if (endpoint0 <= endpoint1 && allowTransparent)
+				palette[3][3] = 0;
+
+			for (uint32_t i = 0; i < 16; i++)
+				memcpy(outPixels[i], palette[reader.Read(2)], 4);
+		}
+
+		static void DecodeBC4(const uint8_t* block, uint8_t (*outPixels)[4], uint32_t channel)
+		{
+			BlockReader reader(block);
+			const uint32_t value0 = reader.Read(8);
+			const uint32_t value1 = reader.Read(8);
+
+			uint8_t palette[8] = { uint8_t(value0), uint8_t(value1) };
+			if (value0 > value1)
+			{
+				for (uint32_t p = 2; p < 8; p++)
+					palette[p] = uint8_t(((8 - p) * value0 + (p - 1) * value1 + 3) / 7);
+			}
+			else
+			{
+				for (uint32_t p = 2; p < 6; p++)
+					palette[p] = uint8_t(((6 - p) * value0 + (p - 1) * value1 + 2) / 5);
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+
+			for (uint32_t i = 0; i < 16; i++)
+				outPixels[i][channel] = palette[reader.Read(3)];
+		}
+
+		static bool DecodeBC7Mode6(const uint8_t* block, uint8_t (*outPixels)[4])
+		{
+			BlockReader reader(block);
+			if (reader.Read(7) != (1 << 6))
+				return false;
+
+			uint32_t endpoints[2][4];
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				endpoints[0][c] = reader.Read(7);
+				endpoints[1][c] = reader.Read(7);
+			}
+			const uint32_t pBits[2] = { reader.Read(1), reader.Read(1) };
+
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				const uint32_t weight = BC7Weights4[reader.Read(i == 0 ? 3 : 4)];
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					const uint32_t value0 = (endpoints[0][c] << 1) | pBits[0];
+					const uint32_t value1 = (endpoints[1][c] << 1) | pBits[1];
+					outPixels[i][c] = uint8_t(((64 - weight) * value0 + weight * value1 + 32) >> 6);
+				}
+			}
+			return true;
+		}
+
+		static bool DecodeBC6HMode11(const uint8_t* block, float (*outPixels)[4])
+		{
+			BlockReader reader(block);
+			if (reader.Read(5) != 0x03)
+				return false;
+
+			uint32_t endpoints[2][3];
+			for (uint32_t endpoint = 0; endpoint < 2; endpoint++)
+				for (uint32_t c = 0; c < 3; c++)
+					endpoints[endpoint][c] = reader.Read(10);
+
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				const int32_t weight = int32_t(BC7Weights4[reader.Read(i == 0 ? 3 : 4)]);
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					const int32_t value0 = BC6HMode11Encoding::Unquantize(endpoints[0][c]);
+					const int32_t value1 = BC6HMode11Encoding::Unquantize(endpoints[1][c]);
+					const int32_t half = ((value0 * (64 - weight) + value1 * weight + 32) >> 6) * 31 >> 6;
+					outPixels[i][c] = HalfToFloat(uint16_t(half));
+				}
+				outPixels[i][3] = 1.0f;
+			}
+			return true;
+		}
+
+		//////////////////////////////////////////////////////////////////////////////////
+		// Mips
+		//////////////////////////////////////////////////////////////////////////////////
+
+		// RGBA, filtered in linear space
+		struct FloatImage
+		{
+			uint32_t Width = 0;
+			uint32_t Height = 0;
+			std::vector<float> Pixels;
+
+			const float* GetPixel(uint32_t x, uint32_t y) const { return &Pixels[(uint64_t(y) * Width + x) * 4]; }
+		};
+
+		static FloatImage ToFloatImage(const TextureData& source, TextureUsage usage)
+		{
+			FloatImage image;
+			image.Width = source.Width;
+			image.Height = source.Height;
+			image.Pixels.resize(uint64_t(source.Width) * source.Height * 4);
+
+			const uint64_t valueCount = image.Pixels.size();
+			if (source.Format == ImageFormat::RGBA32F)
+			{
+				memcpy(image.Pixels.data(), source.ImageData.Data, valueCount * sizeof(float));
+			}
+			else
+			{
+				float srgbToLinear[256];
+				for (uint32_t i = 0; i < 256; i++)
+					srgbToLinear[i] = usage == TextureUsage::Albedo ? SRGBToLinear(i / 255.0f) : i / 255.0f;
+
+				const uint8_t* pixels = source.ImageData.As<uint8_t>();
+				for (uint64_t i = 0; i < valueCount; i++)
+					image.Pixels[i] = (i % 4) == 3 ? pixels[i] / 255.0f : srgbToLinear[pixels[i]];
+			}
+			return image;
+		}
+
+		static constexpr float LanczosRadius = 3.0f;
+
+		static float Lanczos(float x)
+		{
+			x = std::abs(x);
+			if (x < 1e-5f)
+				return 1.0f;
+			if (x >= LanczosRadius)
+				return 0.0f;
+
+			const float piX = std::numbers::pi_v<float> * x;
+			return LanczosRadius * std::sin(piX) * std::sin(piX / LanczosRadius) / (piX * piX);
+		}
+
+		// Normalized filter taps for resampling one axis, source indices clamped to the edge
+		struct FilterKernel
+		{
+			uint32_t TapCount = 0;
+			std::vector<uint32_t> Indices; // TapCount per destination pixel
+			std::vector<float> Weights;
+		};
+
+		static FilterKernel GetFilterKernel(uint32_t sourceSize, uint32_t destinationSize)
+		{
+			const float scale = float(sourceSize) / float(destinationSize);
+			const float support = LanczosRadius * scale;
+
+			FilterKernel kernel;
+			kernel.TapCount = uint32_t(std::ceil(support * 2.0f)) + 1;
+			kernel.Indices.reserve(uint64_t(destinationSize) * kernel.TapCount);
+			kernel.Weights.reserve(uint64_t(destinationSize) * kernel.TapCount);
+
+			for (uint32_t i = 0; i < destinationSize; i++)
+			{
+				const float center = (float(i) + 0.5f) * scale;
+				const int32_t first = int32_t(std::floor(center - support));
+
+				const size_t start = kernel.Weights.size();
+				float total = 0.0f;
+				for (uint32_t tap = 0; tap < kernel.TapCount; tap++)
+				{
+					const int32_t source = first + int32_t(tap);
+					const float weight = Lanczos((float(source) + 0.5f - center) / scale);
+					kernel.Indices.push_back(uint32_t(std::clamp(source, 0, int32_t(sourceSize) - 1)));
+					kernel.Weights.push_back(weight);
+					total += weight;
+				}
+
+				for (size_t tap = start; tap < kernel.Weights.size(); tap++)
+					kernel.Weights[tap] /= total;
+			}
+			return kernel;
+		}
+
+		// Half size with a separable Lanczos3 filter. Ringing is clamped away and normals are renormalized.
+		static FloatImage Downsample(const FloatImage& image, TextureUsage usage)
+		{
+			FloatImage result;
+			result.Width = std::max(image.Width >> 1, 1u);
+			result.Height = std::max(image.Height >> 1, 1u);
+			result.Pixels.resize(uint64_t(result.Width) * result.Height * 4);
+
+			const FilterKernel horizontal = GetFilterKernel(image.Width, result.Width);
+			const FilterKernel vertical = GetFilterKernel(image.Height, result.Height);
+
+			FloatImage intermediate;
+			intermediate.Width = result.Width;
+			intermediate.Height = image.Height;
+			intermediate.Pixels.resize(uint64_t(intermediate.Width) * intermediate.Height * 4);
+
+			const size_t minRowsPerThread = std::max<size_t>(1, 65536 / result.Width);
+			ParallelFor("Texture Cook", intermediate.Height, minRowsPerThread, [&](size_t y)
+			{
+				for (uint32_t x = 0; x < intermediate.Width; x++)
+				{
+					float* pixel = &intermediate.Pixels[(uint64_t(y) * intermediate.Width + x) * 4];
+					for (uint32_t tap = 0; tap < horizontal.TapCount; tap++)
+					{
+						const uint64_t index = uint64_t(x) * horizontal.TapCount + tap;
+						const float* source = image.GetPixel(horizontal.Indices[index], (uint32_t)y);
+						for (uint32_t c = 0; c < 4; c++)
+							pixel[c] += source[c] * horizontal.Weights[index];
+					}
+				}
+			});
+
+			const float maxValue = usage == TextureUsage::HDR ? std::numeric_limits<float>::max() : 1.0f;
+			ParallelFor("Texture Cook", result.Height, minRowsPerThread, [&](size_t y)
+			{
+				for (uint32_t x = 0; x < result.Width; x++)
+				{
+					float* pixel = &result.Pixels[(uint64_t(y) * result.Width + x) * 4];
+					for (uint32_t tap = 0; tap < vertical.TapCount; tap++)
+					{
+						const uint64_t index = uint64_t(y) * vertical.TapCount + tap;
+						const float* source = intermediate.GetPixel(x, vertical.Indices[index]);
+						for (uint32_t c = 0; c < 4; c++)
+							pixel[c] += source[c] * vertical.Weights[index];
+					}
+
+					for (uint32_t c = 0; c < 4; c++)
+						pixel[c] = std::clamp(pixel[c], 0.0f, c == 3 ? 1.0f : maxValue);
+
+					if (usage == TextureUsage::Normal)
+					{
+						float normal[3], length = 0.0f;
+						for (uint32_t c = 0; c < 3; c++)
+						{
+							normal[c] = pixel[c] * 2.0f - 1.0f;
+							length += normal[c] * normal[c];
+						}
+
+						length = std::sqrt(length);
+						if (length > 1e-6f)
+						{
+							for (uint32_t c = 0; c < 3; c++)
+								pixel[c] = normal[c] / length * 0.5f + 0.5f;
+						}
+					}
+				}
+			});
+			return result;
+		}
+
+		// Reads a 4x4 block (edges clamped) and converts it to the encoder's value space
+		static BlockPixels GetBlockPixels(const FloatImage& image, uint32_t blockX, uint32_t blockY, ImageFormat format, TextureUsage usage)
+		{
+			const bool hdr = format == ImageFormat::BC6H;
+			const bool srgb = usage == TextureUsage::Albedo && !hdr;
+
+			BlockPixels pixels;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				const uint32_t x = std::min(blockX * 4 + i % 4, image.Width - 1);
+				const uint32_t y = std::min(blockY * 4 + i / 4, image.Height - 1);
+				const float* pixel = image.GetPixel(x, y);
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					if (hdr)
+						pixels[i][c] = float(FloatToHalf(std::clamp(pixel[c], 0.0f, 65504.0f)));
+					else if (srgb && c < 3)
+						pixels[i][c] = LinearToSRGB(std::clamp(pixel[c], 0.0f, 1.0f)) * 255.0f;
+					else
+						pixels[i][c] = std::clamp(pixel[c], 0.0f, 1.0f) * 255.0f;
+				}
+			}
+			return pixels;
+		}
+
+		static void EncodePixel(const float* pixel, ImageFormat format, TextureUsage usage, uint8_t* destination)
+		{
+			if (format == ImageFormat::RGBA32F)
+			{
+				memcpy(destination, pixel, 4 * sizeof(float));
+				return;
+			}
+
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				float value = std::clamp(pixel[c], 0.0f, 1.0f);
+				if (usage == TextureUsage::Albedo && c < 3)
+					value = LinearToSRGB(value);
+				destination[c] = uint8_t(value * 255.0f + 0.5f);
+			}
+		}
+
+		static bool HasAlpha(const TextureData& source)
+		{
+			const uint64_t pixelCount = uint64_t(source.Width) * source.Height;
+			for (uint64_t i = 0; i < pixelCount; i++)
+			{
+				const bool opaque = source.Format == ImageFormat::RGBA32F ? source.ImageData.As<float>()[i * 4 + 3] >= 1.0f : source.ImageData.As<uint8_t>()[i * 4 + 3] == 255;
+				if (!opaque)
+					return true;
+			}
+			return false;
+		}
+
+		static std::string GetCacheFileName(uint64_t key)
+		{
+			std::stringstream stream;
+			stream << std::hex << std::setw(16) << std::setfill('0') << key << ".ktx2";
+			return stream.str();
+		}
+
+		// Drops the mips before firstMip from the data
+		static void SkipMips(CookedTexture& texture, uint32_t firstMip)
+		{
+			if (firstMip <= texture.FirstMip)
+				return;
+
+			uint64_t offset = 0;
+			for (uint32_t mip = texture.FirstMip; mip < firstMip; mip++)
+				offset += GetImageMemorySize(texture.Format, std::max(texture.Width >> mip, 1u), std::max(texture.Height >> mip, 1u));
+
+			Buffer data = Buffer::Copy(texture.Data.As<uint8_t>() + offset, texture.Data.Size - offset);
+			texture.Data.Release();
+			texture.Data = data;
+			texture.FirstMip = firstMip;
+		}
+
+	}
+
+	ImageFormat TextureCooker::SelectFormat(TextureUsage usage, TextureCookQuality quality, bool hasAlpha, bool sRGB)
+	{
+		sRGB &= usage == TextureUsage::Albedo;
+		if (quality == TextureCookQuality::Uncompressed)
+		{
+			if (usage == TextureUsage::HDR)
+				return ImageFormat::RGBA32F;
+			return sRGB ? ImageFormat::SRGBA : ImageFormat::RGBA;
+		}
+
+		const bool fast = quality == TextureCookQuality::Fast;
+		switch (usage)
+		{
+			case TextureUsage::Albedo:
+				if (fast && hasAlpha)
+					return sRGB ? ImageFormat::BC3_SRGB : ImageFormat::BC3;
+				if (fast)
+					return sRGB ? ImageFormat::BC1_SRGB : ImageFormat::BC1;
+				return sRGB ? ImageFormat::BC7_SRGB : ImageFormat::BC7;
+			case TextureUsage::Normal:         return ImageFormat::BC5;
+			case TextureUsage::RoughnessMetal: return fast ? ImageFormat::BC1 : ImageFormat::BC7;
+			case TextureUsage::Mask:           return ImageFormat::BC4;
+			case TextureUsage::HDR:            return ImageFormat::BC6H;
+		}
+		ZN_CORE_ASSERT(false, "Unknown texture usage");
+		return ImageFormat::None;
+	}
+
+	TextureUsage TextureCooker::GetUsageFromPath(const std::filesystem::path& path)
+	{
+		std::string extension = path.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		if (extension == ".hdr" || extension == ".exr")
+			return TextureUsage::HDR;
+
+		std::string name = path.stem().string();
+		std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+
+		auto hasSuffix = [&name](std::string_view suffix)
+		{
+			return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+		};
+
+		auto contains = [&name](std::string_view token) { return name.find(token) != std::string::npos; };
+
+		if (contains("normal") || hasSuffix("_n") || hasSuffix("_nrm") || hasSuffix("_nor"))
+			return TextureUsage::Normal;
+		if (contains("rough") || contains("metal") || hasSuffix("_orm") || hasSuffix("_mr") || hasSuffix("_rma"))
+			return TextureUsage::RoughnessMetal;
+		if (contains("occlusion") || contains("height") || contains("mask") || hasSuffix("_ao") || hasSuffix("_disp"))
+			return TextureUsage::Mask;
+
+		return TextureUsage::Albedo;
+	}
+
+	CookedTexture TextureCooker::Cook(const TextureData& source, TextureUsage usage, TextureCookQuality quality)
+	{
+		ZN_PROFILE_FUNC();
+
+		if (!source.IsValid() || (source.Format != ImageFormat::RGBA && source.Format != ImageFormat::SRGBA && source.Format != ImageFormat::RGBA32F))
+		{
+			ZN_CORE_ERROR_TAG("TextureCooker", "Can only cook RGBA8 and RGBA32F images");
+			return {};
+		}
+
+		CookedTexture result;
+		result.Width = source.Width;
+		result.Height = source.Height;
+		result.MipCount = Utils::CalculateMipCount(source.Width, source.Height);
+		result.Format = SelectFormat(usage, quality, usage == TextureUsage::Albedo && Utils::HasAlpha(source), source.Format == ImageFormat::SRGBA);
+
+		std::vector<Utils::FloatImage> mips;
+		mips.reserve(result.MipCount);
+		mips.push_back(Utils::ToFloatImage(source, usage));
+		for (uint32_t mip = 1; mip < result.MipCount; mip++)
+			mips.push_back(Utils::Downsample(mips.back(), usage));
+
+		// Uncompressed formats are encoded as 1x1 "blocks"
+		const bool blockCompressed = Utils::IsBlockCompressed(result.Format);
+		const uint32_t blockDimension = blockCompressed ? 4 : 1;
+		const uint32_t blockSize = blockCompressed ? Utils::GetBlockSize(result.Format) : (result.Format == ImageFormat::RGBA32F ? 16 : 4);
+
+		// The source already is the base level when only the mips are cooked
+		const bool copyBaseLevel = !blockCompressed && (source.Format == ImageFormat::RGBA32F) == (result.Format == ImageFormat::RGBA32F);
+
+		struct BlockRow
+		{
+			uint32_t Mip;
+			uint32_t Row;
+			uint64_t Offset;
+		};
+
+		std::vector<BlockRow> rows;
+		uint64_t dataSize = 0;
+		for (uint32_t mip = 0; mip < result.MipCount; mip++)
+		{
+			const uint32_t blocksX = (mips[mip].Width + blockDimension - 1) / blockDimension;
+			const uint32_t blocksY = (mips[mip].Height + blockDimension - 1) / blockDimension;
+			if (mip > 0 || !copyBaseLevel)
+			{
+				for (uint32_t row = 0; row < blocksY; row++)
+					rows.push_back({ mip, row, dataSize + uint64_t(row) * blocksX * blockSize });
+			}
+			dataSize += uint64_t(blocksX) * blocksY * blockSize;
+		}
+
+		result.Data.Allocate(dataSize);
+		if (copyBaseLevel)
+			memcpy(result.Data.Data, source.ImageData.Data, uint64_t(source.Width) * source.Height * blockSize);
+
+		const size_t minRowsPerThread = blockCompressed ? 1 : std::max<size_t>(1, 65536 / source.Width);
+		ParallelFor("Texture Cook", rows.size(), minRowsPerThread, [&](size_t i)
+		{
+			const BlockRow& row = rows[i];
+			const Utils::FloatImage& image = mips[row.Mip];
+			const uint32_t blocksX = (image.Width + blockDimension - 1) / blockDimension;
+			for (uint32_t blockX = 0; blockX < blocksX; blockX++)
+			{
+				uint8_t* destination = result.Data.As<uint8_t>() + row.Offset + uint64_t(blockX) * blockSize;
+				if (blockCompressed)
+					Utils::EncodeBlock(result.Format, quality, Utils::GetBlockPixels(image, blockX, row.Row, result.Format, usage), destination);
+				else
+					Utils::EncodePixel(image.GetPixel(blockX, row.Row), result.Format, usage, destination);
+			}
+		});
+
+		return result;
+	}
+
+	CookedTexture TextureCooker::CookFile(const std::filesystem::path& path, TextureUsage usage, TextureCookQuality quality, uint32_t maxSize)
+	{
+		const uint64_t sourceHash = FileSystem::GetContentHash(path);
+		if (sourceHash == 0)
+			return {};
+
+		return CookCached(sourceHash, usage, quality, maxSize, [&path]() { return TextureImporter::LoadTextureData(path); });
+	}
+
+	CookedTexture TextureCooker::CookFromMemory(Buffer encodedData, TextureUsage usage, TextureCookQuality quality, uint32_t maxSize)
+	{
+		if (!encodedData)
+			return {};
+
+		const uint64_t sourceHash = XXHash64::compute(encodedData.Data, encodedData.Size, 0);
+		return CookCached(sourceHash, usage, quality, maxSize, [encodedData]() { return TextureImporter::LoadTextureData(encodedData); });
+	}
+
+	CookedTexture TextureCooker::CookCached(uint64_t sourceHash, TextureUsage usage, TextureCookQuality quality, uint32_t maxSize, const std::function<TextureData()>& loadSource)
+	{
+		const uint64_t settings = (uint64_t(Utils::CookerVersion) << 16) | (uint64_t(usage) << 8) | uint64_t(quality);
+		const uint64_t key = XXHash64::compute(&sourceHash, sizeof(sourceHash), settings);
+		const std::filesystem::path cachePath = GetCacheDirectory() / Utils::GetCacheFileName(key);
+
+		CookedTexture cooked;
+		if (std::filesystem::exists(cachePath))
+		{
+			cooked = KTX2::Read(cachePath, maxSize);
+			if (cooked.IsValid())
+				return cooked;
+		}
+
+		TextureData source = loadSource();
+		cooked = Cook(source, usage, quality);
+		source.ImageData.Release();
+
+		if (cooked.IsValid() && KTX2::Write(cachePath, cooked))
+		{
+			cooked.FilePath = cachePath;
+			Utils::SkipMips(cooked, GetFirstMipForSize(cooked.Width, cooked.Height, cooked.MipCount, maxSize));
+		}
+
+		return cooked;
+	}
+
+	uint32_t TextureCooker::GetFirstMipForSize(uint32_t width, uint32_t height, uint32_t mipCount, uint32_t maxSize)
+	{
+		uint32_t mip = 0;
+		if (maxSize > 0)
+		{
+			while (mip + 1 < mipCount && std::max(width >> mip, height >> mip) > maxSize)
+				mip++;
+		}
+		return mip;
+	}
+
+	TextureData TextureCooker::Decompress(const CookedTexture& texture)
+	{
+		TextureData result;
+		if (!texture.IsValid() || texture.FirstMip != 0)
+			return result;
+
+		if (!Utils::IsBlockCompressed(texture.Format))
+		{
+			result.Width = texture.Width;
+			result.Height = texture.Height;
+			result.Format = texture.Format == ImageFormat::RGBA32F ? ImageFormat::RGBA32F : ImageFormat::RGBA;
+			result.ImageData = Buffer::Copy(texture.Data.Data, Utils::GetImageMemorySize(texture.Format, texture.Width, texture.Height));
+			return result;
+		}
+
+		const bool hdr = texture.Format == ImageFormat::BC6H;
+		const uint32_t bytesPerPixel = hdr ? 4 * sizeof(float) : 4;
+		const uint32_t blockSize = Utils::GetBlockSize(texture.Format);
+		const uint32_t blocksX = (texture.Width + 3) / 4;
+		const uint32_t blocksY = (texture.Height + 3) / 4;
+
+		result.Width = texture.Width;
+		result.Height = texture.Height;
+		result.Format = hdr ? ImageFormat::RGBA32F : ImageFormat::RGBA;
+		result.ImageData.Allocate(uint64_t(texture.Width) * texture.Height * bytesPerPixel);
+
+		for (uint32_t blockY = 0; blockY < blocksY; blockY++)
+		{
+			for (uint32_t blockX = 0; blockX < blocksX; blockX++)
+			{
+				const uint8_t* block = texture.Data.As<uint8_t>() + (uint64_t(blockY) * blocksX + blockX) * blockSize;
+
+				uint8_t pixels[16][4] = {};
+				float hdrPixels[16][4] = {};
+				for (uint32_t i = 0; i < 16; i++)
+					pixels[i][3] = 255;
+
+				bool decoded = true;
+				switch (texture.Format)
+				{
+					case ImageFormat::BC1:
+					case ImageFormat::BC1_SRGB:
+						Utils::DecodeBC1Color(block, pixels, true);
+						break;
+					case ImageFormat::BC3:
+					case ImageFormat::BC3_SRGB:
+						Utils::DecodeBC1Color(block + 8, pixels, false);
+						Utils::DecodeBC4(block, pixels, 3);
+						break;
+					case ImageFormat::BC4:
+						Utils::DecodeBC4(block, pixels, 0);
+						break;
+					case ImageFormat::BC5:
+						Utils::DecodeBC4(block, pixels, 0);
+						Utils::DecodeBC4(block + 8, pixels, 1);
+						break;
+					case ImageFormat::BC6H:
+						decoded = Utils::DecodeBC6HMode11(block, hdrPixels);
+						break;
+					case ImageFormat::BC7:
+					case ImageFormat::BC7_SRGB:
+						decoded = Utils::DecodeBC7Mode6(block, pixels);
+						break;
+					default:
+						decoded = false;
+						break;
+				}
+
+				if (!decoded)
+				{
+					ZN_CORE_ERROR_TAG("TextureCooker", "Can only decompress blocks written by the cooker");
+					result.ImageData.Release();
+					return {};
+				}
+
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					const uint32_t x = blockX * 4 + i % 4, y = blockY * 4 + i / 4;
+					if (x >= texture.Width || y >= texture.Height)
+						continue;
+
+					uint8_t* destination = result.ImageData.As<uint8_t>() + (uint64_t(y) * texture.Width + x) * bytesPerPixel;
+					if (hdr)
+						memcpy(destination, hdrPixels[i], bytesPerPixel);
+					else
+						memcpy(destination, pixels[i], bytesPerPixel);
+				}
+			}
+		}
+
+		return result;
+	}
+
+	Ref<Texture2D> TextureCooker::CreateTexture(const CookedTexture& texture, const std::string& debugName)
+	{
+		if (!texture.IsValid())
+			return nullptr;
+
+		TextureSpecification spec;
+		spec.Width = texture.Width;
+		spec.Height = texture.Height;
+		spec.Format = texture.Format;
+		spec.Mips = texture.MipCount;
+		spec.ResidentMip = texture.FirstMip;
+		spec.GenerateMips = false;
+		spec.DebugName = debugName;
+		return Texture2D::Create(spec, texture.Data);
+	}
+
+	std::filesystem::path TextureCooker::GetCacheDirectory()
+	{
+		return "Resources/Cache/Texture";
+	}
+
+}
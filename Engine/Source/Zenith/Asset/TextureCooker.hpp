@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Zenith/Asset/TextureImporter.hpp"
+
+#include <filesystem>
+#include <functional>
+
+namespace Zenith {
+
+	enum class TextureUsage : uint8_t
+	{
+		Albedo = 0,     // color kept in the source's sRGB encoding, mips filtered in linear space. SRGBA sources get sRGB
+		                // formats so sampling decodes them like before cooking, RGBA sources UNORM formats
+		Normal,         // tangent-space normal, only X/Y are stored
+		RoughnessMetal, // linear packed channels (glTF: G = roughness, B = metalness)
+		Mask,           // single linear channel (R)
+		HDR             // float RGB
+	};
+
+	enum class TextureCookQuality : uint8_t
+	{
+		Fast = 0,    // bounding box endpoints, BC1/BC3 instead of BC7
+		Normal,      // principal axis endpoints
+		High,        // principal axis endpoints refined with least squares
+		Uncompressed // RGBA8 (RGBA32F for HDR), only the mip chain is cooked
+	};
+
+	// A texture with its mips from FirstMip to the smallest, largest first and tightly packed
+	struct CookedTexture
+	{
+		Buffer Data;
+		uint32_t Width = 0; // of mip 0
+		uint32_t Height = 0;
+		uint32_t MipCount = 0;
+		uint32_t FirstMip = 0;
+		ImageFormat Format = ImageFormat::None;
+
+		std::filesystem::path FilePath; // KTX2 file the skipped mips can be streamed from
+
+		bool IsValid() const { return Data.Data != nullptr && Width > 0 && Height > 0 && MipCount > 0; }
+	};
+
+	class TextureCooker
+	{
+	public:
+		static ImageFormat SelectFormat(TextureUsage usage, TextureCookQuality quality, bool hasAlpha, bool sRGB = false);
+
+		// Best guess from the file name, e.g. "Brick_Normal.png" or "Helmet_ORM.png"
+		static TextureUsage GetUsageFromPath(const std::filesystem::path& path);
+
+		// Compresses an RGBA8 or RGBA32F image and its mip chain. Mips are Lanczos filtered, both are done on all cores.
+		static CookedTexture Cook(const TextureData& source, TextureUsage usage, TextureCookQuality quality = TextureCookQuality::Normal);
+
+		// Same as Cook(), but the result is cached on disk as KTX2, keyed by the source's content and the cook settings.
+		// Mips larger than maxSize are skipped (0 = none), they can be read from the cache file later.
+		static CookedTexture CookFile(const std::filesystem::path& path, TextureUsage usage, TextureCookQuality quality = TextureCookQuality::Normal, uint32_t maxSize = 0);
+		static CookedTexture CookFromMemory(Buffer encodedData, TextureUsage usage, TextureCookQuality quality = TextureCookQuality::Normal, uint32_t maxSize = 0);
+
+		// First mip no larger than maxSize on either side (0 = mip 0), at most the smallest mip
+		static uint32_t GetFirstMipForSize(uint32_t width, uint32_t height, uint32_t mipCount, uint32_t maxSize);
+
+		// Decodes mip 0 back to RGBA8 (RGBA32F for BC6H and RGBA32F textures)
+		static TextureData Decompress(const CookedTexture& texture);
+
+		static Ref<Texture2D> CreateTexture(const CookedTexture& texture, const std::string& debugName = "");
+
+		static std::filesystem::path GetCacheDirectory();
+
+	private:
+		static CookedTexture CookCached(uint64_t sourceHash, TextureUsage usage, TextureCookQuality quality, uint32_t maxSize, const std::function<TextureData()>& loadSource);
+	};
+
+}
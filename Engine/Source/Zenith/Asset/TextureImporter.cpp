@@ -1,13 +1,45 @@
 #include "znpch.hpp"
 #include "TextureImporter.hpp"
 
+#include "TextureCooker.hpp"
+
 #include "Zenith/Renderer/Texture.hpp"
 #include "Zenith/Utilities/FileSystem.hpp"
 
+#include "Zenith/Core/Thread.hpp"
+#include "Zenith/Debug/Profiler.hpp"
+
 #include <stb/stb_image.h>
 
 namespace Zenith {
 
+	namespace Utils {
+
+		// Textures are stored bottom row first. stb_image's own flip is a process-wide setting, which
+		// is not safe with several threads decoding, so flip while copying out of stb's buffer instead.
+		static Buffer CopyFlipped(const void* pixels, uint32_t width, uint32_t height, uint32_t bytesPerPixel)
+		{
+			const uint64_t rowSize = uint64_t(width) * bytesPerPixel;
+
+			Buffer buffer;
+			buffer.Allocate(rowSize * height);
+			const byte* source = static_cast<const byte*>(pixels);
+			for (uint32_t row = 0; row < height; row++)
+				memcpy(buffer.As<byte>() + (height - 1 - row) * rowSize, source + row * rowSize, rowSize);
+
+			return buffer;
+		}
+
+		static TextureData ApplyPreferredFormat(TextureData data, ImageFormat preferredFormat)
+		{
+			if (data.IsValid() && data.Format == ImageFormat::RGBA && (preferredFormat == ImageFormat::SRGBA || preferredFormat == ImageFormat::SRGB))
+				data.Format = ImageFormat::SRGBA;
+
+			return data;
+		}
+
+	}
+
 	TextureData TextureImporter::LoadTextureData(const std::filesystem::path& path)
 	{
 		TextureData result;
@@ -15,28 +47,21 @@ namespace Zenith {
 		std::string pathStr = path.string();
 		int width, height, channels;
 		void* tmp;
-		size_t size = 0;
+		uint32_t bytesPerPixel = 0;
 
 		FileStatus fileStatus = FileSystem::TryOpenFileAndWait(path, 100);
 
 		if (stbi_is_hdr(pathStr.c_str()))
 		{
 			tmp = stbi_loadf(pathStr.c_str(), &width, &height, &channels, 4);
-			if (tmp)
-			{
-				size = width * height * 4 * sizeof(float);
-				result.Format = ImageFormat::RGBA32F;
-			}
+			bytesPerPixel = 4 * sizeof(float);
+			result.Format = ImageFormat::RGBA32F;
 		}
 		else
 		{
-			stbi_set_flip_vertically_on_load(1);
 			tmp = stbi_load(pathStr.c_str(), &width, &height, &channels, 4);
-			if (tmp)
-			{
-				size = width * height * 4;
-				result.Format = ImageFormat::RGBA;
-			}
+			bytesPerPixel = 4;
+			result.Format = ImageFormat::RGBA;
 		}
 
 		if (!tmp)
@@ -47,7 +72,7 @@ namespace Zenith {
 
 		result.Width = static_cast<uint32_t>(width);
 		result.Height = static_cast<uint32_t>(height);
-		result.ImageData = Buffer::Copy(tmp, size);
+		result.ImageData = Utils::CopyFlipped(tmp, result.Width, result.Height, bytesPerPixel);
 
 		stbi_image_free(tmp);
 
@@ -60,20 +85,19 @@ namespace Zenith {
 
 		int width, height, channels;
 		void* tmp;
-		size_t size;
+		uint32_t bytesPerPixel;
 
 		// Check if HDR texture from memory
 		if (stbi_is_hdr_from_memory((const stbi_uc*)buffer.Data, (int)buffer.Size))
 		{
 			tmp = stbi_loadf_from_memory((const stbi_uc*)buffer.Data, (int)buffer.Size, &width, &height, &channels, 4);
-			size = width * height * 4 * sizeof(float);
+			bytesPerPixel = 4 * sizeof(float);
 			result.Format = ImageFormat::RGBA32F;
 		}
 		else
 		{
-			stbi_set_flip_vertically_on_load(1);
 			tmp = stbi_load_from_memory((const stbi_uc*)buffer.Data, (int)buffer.Size, &width, &height, &channels, 4);
-			size = width * height * 4;
+			bytesPerPixel = 4;
 			result.Format = ImageFormat::RGBA;
 		}
 
@@ -85,7 +109,7 @@ namespace Zenith {
 
 		result.Width = static_cast<uint32_t>(width);
 		result.Height = static_cast<uint32_t>(height);
-		result.ImageData = Buffer::Copy(tmp, size);
+		result.ImageData = Utils::CopyFlipped(tmp, result.Width, result.Height, bytesPerPixel);
 
 		stbi_image_free(tmp);
 
@@ -94,32 +118,48 @@ namespace Zenith {
 
 	TextureData TextureImporter::LoadTextureData(const std::filesystem::path& path, ImageFormat preferredFormat)
 	{
-		TextureData result = LoadTextureData(path);
-
-		if (result.IsValid() && result.Format == ImageFormat::RGBA)
-		{
-			if (preferredFormat == ImageFormat::SRGBA || preferredFormat == ImageFormat::SRGB)
-			{
-				result.Format = ImageFormat::SRGBA;
-			}
-		}
-
-		return result;
+		return Utils::ApplyPreferredFormat(LoadTextureData(path), preferredFormat);
 	}
 
 	TextureData TextureImporter::LoadTextureData(Buffer buffer, ImageFormat preferredFormat)
 	{
-		TextureData result = LoadTextureData(buffer);
+		return Utils::ApplyPreferredFormat(LoadTextureData(buffer), preferredFormat);
+	}
+
+	std::vector<TextureData> TextureImporter::LoadTextureDataParallel(const std::vector<TextureDecodeRequest>& requests)
+	{
+		ZN_PROFILE_FUNC();
 
-		if (result.IsValid() && result.Format == ImageFormat::RGBA)
+		std::vector<TextureData> results(requests.size());
+		if (requests.empty())
+			return results;
+
+		std::atomic<size_t> nextRequest = 0;
+
+		auto decode = [&]()
 		{
-			if (preferredFormat == ImageFormat::SRGBA || preferredFormat == ImageFormat::SRGB)
+			for (size_t i = nextRequest++; i < requests.size(); i = nextRequest++)
 			{
-				result.Format = ImageFormat::SRGBA;
+				const TextureDecodeRequest& request = requests[i];
+				results[i] = request.EncodedData ? LoadTextureData(request.EncodedData, request.PreferredFormat) : LoadTextureData(request.Path, request.PreferredFormat);
 			}
+		};
+
+		// The calling thread decodes too
+		const size_t workerCount = std::min<size_t>(requests.size(), std::max(1u, std::thread::hardware_concurrency())) - 1;
+		std::vector<Thread> workers;
+		workers.reserve(workerCount);
+		for (size_t i = 0; i < workerCount; i++)
+		{
+			workers.emplace_back("Texture Decode " + std::to_string(i));
+			workers.back().Dispatch(decode);
 		}
 
-		return result;
+		decode();
+		for (Thread& worker : workers)
+			worker.Join();
+
+		return results;
 	}
 
 	Ref<Texture2D> TextureImporter::CreateTexture(const TextureData& textureData, const std::string& debugName)
@@ -130,6 +170,22 @@ namespace Zenith {
 			return nullptr;
 		}
 
+		// Mips are filtered on the CPU, so the upload is a single copy without GPU mip generation
+		if (textureData.Format == ImageFormat::RGBA || textureData.Format == ImageFormat::SRGBA || textureData.Format == ImageFormat::RGBA32F)
+		{
+			TextureUsage usage = TextureUsage::RoughnessMetal;
+			if (textureData.Format == ImageFormat::SRGBA)
+				usage = TextureUsage::Albedo;
+			else if (textureData.Format == ImageFormat::RGBA32F)
+				usage = TextureUsage::HDR;
+
+			CookedTexture cooked = TextureCooker::Cook(textureData, usage, TextureCookQuality::Uncompressed);
+			Ref<Texture2D> texture = TextureCooker::CreateTexture(cooked, debugName);
+			cooked.Data.Release();
+			if (texture)
+				return texture;
+		}
+
 		TextureSpecification spec;
 		spec.Width = textureData.Width;
 		spec.Height = textureData.Height;
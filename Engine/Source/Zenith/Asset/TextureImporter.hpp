@@ -17,6 +17,14 @@ namespace Zenith {
 		bool IsValid() const { return ImageData.Data != nullptr && Width > 0 && Height > 0; }
 	};
 
+	// One image for TextureImporter::LoadTextureDataParallel(), either encoded bytes (not owned) or a file
+	struct TextureDecodeRequest
+	{
+		Buffer EncodedData;
+		std::filesystem::path Path;
+		ImageFormat PreferredFormat = ImageFormat::RGBA;
+	};
+
 	class TextureImporter
 	{
 	public:
@@ -25,6 +33,10 @@ namespace Zenith {
 		static TextureData LoadTextureData(const std::filesystem::path& path, ImageFormat preferredFormat);
 		static TextureData LoadTextureData(Buffer buffer, ImageFormat preferredFormat);
 
+		// Decodes the requests concurrently, results are in request order.
+		// Decoding is thread-safe: images are flipped while they are copied out of stb_image, not through its global flag.
+		static std::vector<TextureData> LoadTextureDataParallel(const std::vector<TextureDecodeRequest>& requests);
+
 		static Ref<Texture2D> CreateTexture(const TextureData& textureData, const std::string& debugName = "");
 
 		//Keep for backwards compatibility
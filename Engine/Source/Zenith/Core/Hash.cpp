@@ -98,6 +98,131 @@ namespace Zenith {
 		return result;
 	}
 
+	// XXHash64 Implementation
+	namespace {
+
+		constexpr uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ull;
+		constexpr uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4Full;
+		constexpr uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ull;
+		constexpr uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ull;
+		constexpr uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ull;
+
+		constexpr uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+		uint64_t read64(const uint8_t* p) { uint64_t v; memcpy(&v, p, sizeof(v)); return v; }
+		uint32_t read32(const uint8_t* p) { uint32_t v; memcpy(&v, p, sizeof(v)); return v; }
+
+		uint64_t xxhRound(uint64_t acc, uint64_t input)
+		{
+			acc += input * XXH_PRIME64_2;
+			acc = rotl64(acc, 31);
+			return acc * XXH_PRIME64_1;
+		}
+
+		uint64_t xxhMergeRound(uint64_t acc, uint64_t value)
+		{
+			acc ^= xxhRound(0, value);
+			return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+		}
+
+	}
+
+	uint64_t XXHash64::compute(const void* data, size_t length, uint64_t seed)
+	{
+		XXHash64 hash;
+		hash.reset(seed);
+		hash.update(data, length);
+		return hash.finalize();
+	}
+
+	void XXHash64::reset(uint64_t seed)
+	{
+		m_seed = seed;
+		m_totalLength = 0;
+		m_buflen = 0;
+		m_accumulators = { seed + XXH_PRIME64_1 + XXH_PRIME64_2, seed + XXH_PRIME64_2, seed, seed - XXH_PRIME64_1 };
+	}
+
+	void XXHash64::update(const void* data, size_t length)
+	{
+		const uint8_t* input = static_cast<const uint8_t*>(data);
+		m_totalLength += length;
+
+		if (m_buflen + length < m_buffer.size())
+		{
+			memcpy(m_buffer.data() + m_buflen, input, length);
+			m_buflen += length;
+			return;
+		}
+
+		if (m_buflen > 0)
+		{
+			const size_t fill = m_buffer.size() - m_buflen;
+			memcpy(m_buffer.data() + m_buflen, input, fill);
+			for (int i = 0; i < 4; i++)
+				m_accumulators[i] = xxhRound(m_accumulators[i], read64(m_buffer.data() + i * 8));
+			input += fill;
+			length -= fill;
+			m_buflen = 0;
+		}
+
+		for (; length >= 32; input += 32, length -= 32)
+		{
+			for (int i = 0; i < 4; i++)
+				m_accumulators[i] = xxhRound(m_accumulators[i], read64(input + i * 8));
+		}
+
+		memcpy(m_buffer.data(), input, length);
+		m_buflen = length;
+	}
+
+	uint64_t XXHash64::finalize()
+	{
+		uint64_t hash;
+		if (m_totalLength >= 32)
+		{
+			hash = rotl64(m_accumulators[0], 1) + rotl64(m_accumulators[1], 7) + rotl64(m_accumulators[2], 12) + rotl64(m_accumulators[3], 18);
+			for (uint64_t accumulator : m_accumulators)
+				hash = xxhMergeRound(hash, accumulator);
+		}
+		else
+		{
+			hash = m_seed + XXH_PRIME64_5;
+		}
+
+		hash += m_totalLength;
+
+		const uint8_t* p = m_buffer.data();
+		size_t remaining = m_buflen;
+		for (; remaining >= 8; p += 8, remaining -= 8)
+		{
+			hash ^= xxhRound(0, read64(p));
+			hash = rotl64(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+		}
+		if (remaining >= 4)
+		{
+			hash ^= uint64_t(read32(p)) * XXH_PRIME64_1;
+			hash = rotl64(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+			p += 4;
+			remaining -= 4;
+		}
+		for (; remaining > 0; p++, remaining--)
+		{
+			hash ^= (*p) * XXH_PRIME64_5;
+			hash = rotl64(hash, 11) * XXH_PRIME64_1;
+		}
+
+		hash ^= hash >> 33;
+		hash *= XXH_PRIME64_2;
+		hash ^= hash >> 29;
+		hash *= XXH_PRIME64_3;
+		hash ^= hash >> 32;
+
+		m_hash = hash;
+		reset(m_seed);
+		return hash;
+	}
+
 	// SHA256Hash Implementation
 	constexpr std::array<uint32_t, 64> SHA256Hash::K;
 
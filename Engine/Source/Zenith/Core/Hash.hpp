@@ -9,6 +9,7 @@ namespace Zenith {
 	class CRC32Hash;
 	class FNVHash;
 	class SHA256Hash;
+	class XXHash64;
 
 	template<typename Derived, typename ValueType>
 	class HashBase
@@ -161,6 +162,40 @@ namespace Zenith {
 		static constexpr uint32_t OFFSET_BASIS = 2166136261u;
 	};
 
+	// xxHash64, fast non-cryptographic hash for large inputs (e.g. file content change detection)
+	class XXHash64 : public HashBase<XXHash64, uint64_t>
+	{
+	public:
+		XXHash64() { reset(); }
+		explicit XXHash64(uint64_t hash) : m_hash(hash) { reset(); }
+
+		explicit XXHash64(std::string_view str) : m_hash(compute(str)) { reset(); }
+
+		XXHash64(const XXHash64& other) = default;
+		XXHash64& operator=(const XXHash64& other) = default;
+
+		XXHash64(XXHash64&& other) noexcept = default;
+		XXHash64& operator=(XXHash64&& other) noexcept = default;
+
+		uint64_t getValue() const noexcept { return m_hash; }
+
+		static uint64_t compute(const void* data, size_t length, uint64_t seed = 0);
+		static uint64_t compute(std::string_view str, uint64_t seed = 0) { return compute(str.data(), str.length(), seed); }
+
+		void reset(uint64_t seed = 0);
+		void update(const void* data, size_t length);
+		void update(std::string_view str) { update(str.data(), str.length()); }
+		uint64_t finalize();
+
+	private:
+		uint64_t m_hash = 0;
+		uint64_t m_seed = 0;
+		uint64_t m_totalLength = 0;
+		std::array<uint64_t, 4> m_accumulators{};
+		std::array<uint8_t, 32> m_buffer{};
+		size_t m_buflen = 0;
+	};
+
 	// SHA-256 Hash Algorithm
 	class SHA256Hash : public HashBase<SHA256Hash, std::array<uint8_t, 32>>
 	{
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace Zenith {
 
@@ -40,4 +44,29 @@ namespace Zenith {
 		void* m_SignalHandle = nullptr;
 	};
 
+	// Runs function(i) for every i < count on all cores, the calling thread included.
+	// Each thread gets at least minCountPerThread items, so small jobs don't pay for thread startup.
+	inline void ParallelFor(const std::string& name, size_t count, size_t minCountPerThread, const std::function<void(size_t)>& function)
+	{
+		std::atomic<size_t> next = 0;
+		auto run = [&]()
+		{
+			for (size_t i = next++; i < count; i = next++)
+				function(i);
+		};
+
+		const size_t threadCount = std::clamp<size_t>(count / std::max<size_t>(minCountPerThread, 1), 1, std::max(1u, std::thread::hardware_concurrency()));
+		std::vector<Thread> workers;
+		workers.reserve(threadCount - 1);
+		for (size_t i = 0; i < threadCount - 1; i++)
+		{
+			workers.emplace_back(name + " " + std::to_string(i));
+			workers.back().Dispatch(run);
+		}
+
+		run();
+		for (Thread& worker : workers)
+			worker.Join();
+	}
+
 }
\ No newline at end of file
@@ -41,4 +41,24 @@ namespace Zenith {
 		AssetHandle AssetHandle;
 	};
 
+	// One event for a whole batch of hot-reloaded assets (see AssetReloadBatcher)
+	class AssetsReloadedEvent : public Event
+	{
+	public:
+		AssetsReloadedEvent(std::vector<AssetHandle> assetHandles) : AssetHandles(std::move(assetHandles)) {}
+
+		std::string ToString() const override
+		{
+			std::stringstream ss;
+			ss << "AssetsReloadedEvent: " << AssetHandles.size() << " assets";
+			return ss.str();
+		}
+
+		EVENT_CLASS_TYPE(AssetsReloaded)
+		EVENT_CLASS_CATEGORY(EventCategoryEditor)
+
+	public:
+		std::vector<AssetHandle> AssetHandles; // in reload order
+	};
+
 }
\ No newline at end of file
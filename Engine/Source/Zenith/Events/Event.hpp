@@ -17,7 +17,7 @@ namespace Zenith {
 		WindowClose, WindowMinimize, WindowResize, WindowFocus, WindowLostFocus, WindowMoved,
 		AppTick, AppUpdate, AppRender,
 		KeyPressed, KeyReleased, KeyTyped,
-		EditorExitPlayMode, AssetReloaded,
+		EditorExitPlayMode, AssetReloaded, AssetsReloaded,
 		MouseButtonPressed, MouseButtonReleased, MouseButtonDown, MouseMoved, MouseScrolled
 	};
 
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+
+namespace Zenith {
+
+	struct Frustum
+	{
+		enum Plane : uint32_t
+		{
+			Left = 0, Right, Bottom, Top, Near, Far,
+			PlaneCount
+		};
+
+		// Plane equations (xyz = normal pointing inwards, w = distance), normalized
+		std::array<glm::vec4, PlaneCount> Planes;
+
+		Frustum() = default;
+
+		// Extracts the planes of a (view-)projection matrix (Gribb/Hartmann).
+		// If the matrix includes a model transform the planes are in that model's local space.
+		// Near/far are extracted for a [-w, w] depth range, which is conservative for [0, w] and reversed-Z.
+		explicit Frustum(const glm::mat4& matrix)
+		{
+			const glm::vec4 row0 = { matrix[0][0], matrix[1][0], matrix[2][0], matrix[3][0] };
+			const glm::vec4 row1 = { matrix[0][1], matrix[1][1], matrix[2][1], matrix[3][1] };
+			const glm::vec4 row2 = { matrix[0][2], matrix[1][2], matrix[2][2], matrix[3][2] };
+			const glm::vec4 row3 = { matrix[0][3], matrix[1][3], matrix[2][3], matrix[3][3] };
+
+			Planes[Left] = row3 + row0;
+			Planes[Right] = row3 - row0;
+			Planes[Bottom] = row3 + row1;
+			Planes[Top] = row3 - row1;
+			Planes[Near] = row3 + row2;
+			Planes[Far] = row3 - row2;
+
+			for (glm::vec4& plane : Planes)
+			{
+				float length = glm::length(glm::vec3(plane));
+				if (length > 0.0f)
+					plane /= length;
+			}
+		}
+
+		bool IsSphereVisible(const glm::vec3& center, float radius) const
+		{
+			for (const glm::vec4& plane : Planes)
+			{
+				if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+					return false;
+			}
+			return true;
+		}
+
+		bool IsPointVisible(const glm::vec3& point) const
+		{
+			return IsSphereVisible(point, 0.0f);
+		}
+	};
+
+}
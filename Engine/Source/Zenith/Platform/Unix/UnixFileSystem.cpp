@@ -8,6 +8,7 @@
 #include <signal.h>
 #include <unistd.h>
 #include <errno.h>
+#include <fcntl.h>
 
 #include <nlohmann/json.hpp>
 
@@ -49,6 +50,17 @@ namespace Zenith {
 		return true;
 	}
 
+	bool FileSystem::FlushToDisk(const std::filesystem::path& path)
+	{
+		const int fd = open(path.empty() ? "." : path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		const bool result = fsync(fd) == 0;
+		close(fd);
+		return result;
+	}
+
 	Buffer FileSystem::ReadBytes(const std::filesystem::path& filepath)
 	{
 		Buffer buffer;
@@ -0,0 +1,52 @@
+#include "znpch.hpp"
+#include "Zenith/Utilities/MappedFile.hpp"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace Zenith {
+
+	bool MappedFile::Open(const std::filesystem::path& filepath)
+	{
+		Close();
+
+		int fd = open(filepath.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			ZN_CORE_ERROR_TAG("FileSystem", "Failed to open {} for mapping", filepath.string());
+			return false;
+		}
+
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+		{
+			close(fd);
+			return false;
+		}
+
+		void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+
+		if (data == MAP_FAILED)
+		{
+			ZN_CORE_ERROR_TAG("FileSystem", "Failed to map {}", filepath.string());
+			return false;
+		}
+
+		m_Data = static_cast<const byte*>(data);
+		m_Size = static_cast<uint64_t>(fileStat.st_size);
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			munmap(const_cast<byte*>(m_Data), m_Size);
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+
+}
@@ -59,6 +59,21 @@ namespace Zenith {
 		return true;
 	}
 
+	bool FileSystem::FlushToDisk(const std::filesystem::path& path)
+	{
+		// Renames are journaled by NTFS, only file data needs flushing
+		if (path.empty() || std::filesystem::is_directory(path))
+			return true;
+
+		HANDLE fileHandle = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (fileHandle == INVALID_HANDLE_VALUE)
+			return false;
+
+		const bool result = FlushFileBuffers(fileHandle);
+		CloseHandle(fileHandle);
+		return result;
+	}
+
 	Buffer FileSystem::ReadBytes(const std::filesystem::path& filepath)
 	{
 		Buffer buffer;
@@ -0,0 +1,59 @@
+#include "znpch.hpp"
+#include "Zenith/Utilities/MappedFile.hpp"
+
+#include <Windows.h>
+
+namespace Zenith {
+
+	bool MappedFile::Open(const std::filesystem::path& filepath)
+	{
+		Close();
+
+		HANDLE file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			ZN_CORE_ERROR_TAG("FileSystem", "Failed to open {} for mapping", filepath.string());
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (!data)
+		{
+			ZN_CORE_ERROR_TAG("FileSystem", "Failed to map {}", filepath.string());
+			if (mapping)
+				CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_Data = static_cast<const byte*>(data);
+		m_Size = static_cast<uint64_t>(size.QuadPart);
+		m_FileHandle = file;
+		m_MappingHandle = mapping;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+		if (m_MappingHandle)
+			CloseHandle(m_MappingHandle);
+		if (m_FileHandle)
+			CloseHandle(m_FileHandle);
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_FileHandle = nullptr;
+		m_MappingHandle = nullptr;
+	}
+
+}
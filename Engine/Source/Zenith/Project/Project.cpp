@@ -2,6 +2,7 @@
 #include "Project.hpp"
 
 #include "Zenith/Asset/AssetManager.hpp"
+#include "Zenith/Asset/AssetManager/RuntimeAssetManager.hpp"
 
 namespace Zenith {
 
@@ -22,7 +23,11 @@ namespace Zenith {
 		s_ActiveProject = project;
 		if (s_ActiveProject && context)
 		{
+#ifdef ZN_RUNTIME_ASSETS
+			s_AssetManager = Ref<RuntimeAssetManager>::Create(GetAssetPackPath());
+#else
 			s_AssetManager = Ref<EditorAssetManager>::Create(*context);
+#endif
 		}
 	}
 
@@ -16,6 +16,7 @@ namespace Zenith {
 
 		std::string AssetDirectory = "Assets";
 		std::string AssetRegistryPath = "Assets/AssetRegistry.znr";
+		std::string AssetPackPath = "Assets.zpak"; // Used by RuntimeAssetManager (ZENITH_RUNTIME_ASSETS)
 
 		std::string StartScene;
 
@@ -69,6 +70,12 @@ namespace Zenith {
 			return std::filesystem::path(s_ActiveProject->GetConfig().ProjectDirectory) / s_ActiveProject->GetConfig().AssetRegistryPath;
 		}
 
+		static std::filesystem::path GetAssetPackPath()
+		{
+			ZN_CORE_ASSERT(s_ActiveProject);
+			return std::filesystem::path(s_ActiveProject->GetConfig().ProjectDirectory) / s_ActiveProject->GetConfig().AssetPackPath;
+		}
+
 		static std::filesystem::path GetCacheDirectory()
 		{
 			ZN_CORE_ASSERT(s_ActiveProject);
@@ -25,6 +25,7 @@ namespace Zenith {
 		projectNode["Name"] = m_Project->m_Config.Name;
 		projectNode["AssetDirectory"] = m_Project->m_Config.AssetDirectory;
 		projectNode["AssetRegistry"] = m_Project->m_Config.AssetRegistryPath;
+		projectNode["AssetPack"] = m_Project->m_Config.AssetPackPath;
 		projectNode["StartScene"] = m_Project->m_Config.StartScene;
 		projectNode["AutoSave"] = m_Project->m_Config.EnableAutoSave;
 		projectNode["AutoSaveInterval"] = m_Project->m_Config.AutoSaveIntervalSeconds;
@@ -91,6 +92,7 @@ namespace Zenith {
 
 		config.AssetDirectory = projectNode.value("AssetDirectory", std::string(""));
 		config.AssetRegistryPath = projectNode.value("AssetRegistry", std::string(""));
+		config.AssetPackPath = projectNode.value("AssetPack", config.AssetPackPath);
 		config.StartScene = projectNode.value("StartScene", std::string(""));
 		config.EnableAutoSave = projectNode.value("AutoSave", false);
 		config.AutoSaveIntervalSeconds = projectNode.value("AutoSaveInterval", 300);
@@ -4,11 +4,14 @@
 #include "Zenith/Renderer/Renderer.hpp"
 
 #include "VulkanAPI.hpp"
+#include "VulkanBindlessDescriptors.hpp"
+#include "VulkanTransientAllocator.hpp"
 #include "VulkanStorageBuffer.hpp"
 #include "VulkanStorageBufferSet.hpp"
 #include "VulkanUniformBuffer.hpp"
 #include "VulkanUniformBufferSet.hpp"
 #include "VulkanTexture.hpp"
+#include "Zenith/Core/Hash.hpp"
 #include "Zenith/Core/Timer.hpp"
 
 #include "Zenith/Debug/Profiler.hpp"
@@ -38,6 +41,34 @@ namespace Zenith {
 			return RenderPassResourceType::None;
 		}
 
+		inline RenderPassInputType GetImageInputType(VkDescriptorType descriptorType, uint32_t dimension, RenderPassInputType type)
+		{
+			if (descriptorType == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE || descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
+			{
+				switch (dimension)
+				{
+					case 1: return RenderPassInputType::ImageSampler1D;
+					case 2: return RenderPassInputType::ImageSampler2D;
+					case 3: return RenderPassInputType::ImageSampler3D;
+				}
+			}
+			else if (descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE)
+			{
+				switch (dimension)
+				{
+					case 1: return RenderPassInputType::StorageImage1D;
+					case 2: return RenderPassInputType::StorageImage2D;
+					case 3: return RenderPassInputType::StorageImage3D;
+				}
+			}
+			return type;
+		}
+
+		inline bool IsBufferDescriptor(VkDescriptorType descriptorType)
+		{
+			return descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		}
+
 	}
 
 	DescriptorSetManager::DescriptorSetManager(const DescriptorSetManagerSpecification& specification)
@@ -50,7 +81,9 @@ namespace Zenith {
 		: m_Specification(other.m_Specification)
 	{
 		Init();
-		InputResources = other.InputResources;
+		m_Resources = other.m_Resources;
+		for (size_t slot = 0; slot < m_Slots.size(); slot++)
+			m_Slots[slot].Type = other.m_Slots[slot].Type;
 		Bake();
 	}
 
@@ -63,404 +96,191 @@ namespace Zenith {
 	void DescriptorSetManager::Init()
 	{
 		const auto& shaderDescriptorSets = m_Specification.Shader->GetShaderDescriptorSets();
-		uint32_t framesInFlight = Renderer::GetConfig().FramesInFlight;
-		WriteDescriptorMap.resize(framesInFlight);
 
+		// Gathered first so slots can be numbered in (set, binding) order
+		struct ShaderInput
+		{
+			uint32_t Set;
+			const std::string* Name;
+			const VkWriteDescriptorSet* WriteDescriptor;
+		};
+		std::vector<ShaderInput> shaderInputs;
 		for (uint32_t set = m_Specification.StartSet; set <= m_Specification.EndSet; set++)
 		{
 			if (set >= shaderDescriptorSets.size())
 				break;
 
-			const auto& shaderDescriptor = shaderDescriptorSets[set];
-			for (auto&& [bname, wd] : shaderDescriptor.WriteDescriptorSets)
-			{
-				const char* broken = strrchr(bname.c_str(), '.');
-				std::string name = broken ? broken + 1 : bname;
-
-				uint32_t binding = wd.dstBinding;
-				RenderPassInputDeclaration& inputDecl = InputDeclarations[name];
-				inputDecl.Type = RenderPassInputTypeFromVulkanDescriptorType(wd.descriptorType);
-				inputDecl.Set = set;
-				inputDecl.Binding = binding;
-				inputDecl.Name = name;
-				inputDecl.Count = wd.descriptorCount;
-
-				RenderPassInput& input = InputResources[set][binding];
-				input.Input.resize(wd.descriptorCount);
-				input.Type = Utils::GetDefaultResourceType(wd.descriptorType);
-
-				if (m_Specification.DefaultResources)
-				{
-					if (wd.descriptorType != VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER &&
-						wd.descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
-					{
-						if (inputDecl.Type == RenderPassInputType::ImageSampler2D)
-						{
-							for (size_t i = 0; i < input.Input.size(); i++)
-								input.Input[i] = Renderer::GetWhiteTexture();
-						}
-						else if (inputDecl.Type == RenderPassInputType::ImageSampler3D)
-						{
-							for (size_t i = 0; i < input.Input.size(); i++)
-								input.Input[i] = Renderer::GetBlackCubeTexture();
-						}
-					}
-				}
-
-				for (uint32_t frameIndex = 0; frameIndex < framesInFlight; frameIndex++)
-					WriteDescriptorMap[frameIndex][set][binding] = { wd, std::vector<void*>(wd.descriptorCount) };
+			// Bound by the renderer
+			if (set == VulkanBindlessDescriptors::DescriptorSet && VulkanBindlessDescriptors::IsEnabled())
+				continue;
+			if (set == VulkanTransientAllocator::DescriptorSet)
+				continue;
 
-				if (shaderDescriptor.ImageSamplers.find(binding) != shaderDescriptor.ImageSamplers.end())
-				{
-					auto& imageSampler = shaderDescriptor.ImageSamplers.at(binding);
-					uint32_t dimension = imageSampler.Dimension;
-					if (wd.descriptorType == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE || wd.descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
-					{
-						switch (dimension)
-						{
-						case 1:
-							inputDecl.Type = RenderPassInputType::ImageSampler1D;
-							break;
-						case 2:
-							inputDecl.Type = RenderPassInputType::ImageSampler2D;
-							break;
-						case 3:
-							inputDecl.Type = RenderPassInputType::ImageSampler3D;
-							break;
-						}
-					}
-					else if (wd.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE)
-					{
-						switch (dimension)
-						{
-						case 1:
-							inputDecl.Type = RenderPassInputType::StorageImage1D;
-							break;
-						case 2:
-							inputDecl.Type = RenderPassInputType::StorageImage2D;
-							break;
-						case 3:
-							inputDecl.Type = RenderPassInputType::StorageImage3D;
-							break;
-						}
-					}
-				}
-			}
+			for (const auto& [name, wd] : shaderDescriptorSets[set].WriteDescriptorSets)
+				shaderInputs.push_back({ set, &name, &wd });
 		}
-	}
 
-	void DescriptorSetManager::SetInput(std::string_view name, Ref<UniformBufferSet> uniformBufferSet)
-	{
-		const RenderPassInputDeclaration* decl = GetInputDeclaration(name);
-		if (decl)
+		std::sort(shaderInputs.begin(), shaderInputs.end(), [](const ShaderInput& a, const ShaderInput& b)
 		{
-			// Ensure the set exists
-			if (InputResources.find(decl->Set) == InputResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Set {} not found for input {}",
-					m_Specification.DebugName, decl->Set, name);
-				return;
-			}
+			return std::make_pair(a.Set, a.WriteDescriptor->dstBinding) < std::make_pair(b.Set, b.WriteDescriptor->dstBinding);
+		});
 
-			// Ensure the binding exists
-			auto& setResources = InputResources[decl->Set];
-			if (setResources.find(decl->Binding) == setResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Binding {} not found in set {} for input {}",
-					m_Specification.DebugName, decl->Binding, decl->Set, name);
-				return;
-			}
-
-			setResources[decl->Binding].Set(uniformBufferSet);
-		}
-		else
-			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Input {} not found", m_Specification.DebugName, name);
-	}
+		m_InputDeclarations.reserve(shaderInputs.size());
+		m_Slots.reserve(shaderInputs.size());
 
-	void DescriptorSetManager::SetInput(std::string_view name, Ref<UniformBuffer> uniformBuffer)
-	{
-		const RenderPassInputDeclaration* decl = GetInputDeclaration(name);
-		if (decl)
+		for (const auto& [set, bname, wd] : shaderInputs)
 		{
-			// Ensure the set exists
-			if (InputResources.find(decl->Set) == InputResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Set {} not found for input {}",
-					m_Specification.DebugName, decl->Set, name);
-				return;
-			}
-
-			// Ensure the binding exists
-			auto& setResources = InputResources[decl->Set];
-			if (setResources.find(decl->Binding) == setResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Binding {} not found in set {} for input {}",
-					m_Specification.DebugName, decl->Binding, decl->Set, name);
-				return;
-			}
+			const uint32_t binding = wd->dstBinding;
+			const auto& shaderDescriptor = shaderDescriptorSets[set];
 
-			setResources[decl->Binding].Set(uniformBuffer);
-		}
-		else
-			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Input {} not found", m_Specification.DebugName, name);
-	}
+			const char* broken = strrchr(bname->c_str(), '.');
+			std::string name = broken ? broken + 1 : *bname;
 
-	void DescriptorSetManager::SetInput(std::string_view name, Ref<StorageBufferSet> storageBufferSet)
-	{
-		const RenderPassInputDeclaration* decl = GetInputDeclaration(name);
-		if (decl)
-		{
-			// Ensure the set exists
-			if (InputResources.find(decl->Set) == InputResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Set {} not found for input {}",
-					m_Specification.DebugName, decl->Set, name);
-				return;
-			}
+			const InputSlot slot = (InputSlot)m_Slots.size();
 
-			// Ensure the binding exists
-			auto& setResources = InputResources[decl->Set];
-			if (setResources.find(decl->Binding) == setResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Binding {} not found in set {} for input {}",
-					m_Specification.DebugName, decl->Binding, decl->Set, name);
-				return;
-			}
+			RenderPassInputDeclaration& inputDecl = m_InputDeclarations.emplace_back();
+			inputDecl.Type = RenderPassInputTypeFromVulkanDescriptorType(wd->descriptorType);
+			inputDecl.Set = set;
+			inputDecl.Binding = binding;
+			inputDecl.Name = name;
+			inputDecl.Count = wd->descriptorCount;
 
-			setResources[decl->Binding].Set(storageBufferSet);
-		}
-		else
-			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Input {} not found", m_Specification.DebugName, name);
-	}
+			auto imageSampler = shaderDescriptor.ImageSamplers.find(binding);
+			if (imageSampler != shaderDescriptor.ImageSamplers.end())
+				inputDecl.Type = Utils::GetImageInputType(wd->descriptorType, imageSampler->second.Dimension, inputDecl.Type);
 
-	void DescriptorSetManager::SetInput(std::string_view name, Ref<StorageBuffer> storageBuffer)
-	{
-		const RenderPassInputDeclaration* decl = GetInputDeclaration(name);
-		if (decl)
-		{
-			// Ensure the set exists
-			if (InputResources.find(decl->Set) == InputResources.end())
+			if (m_Sets.empty() || m_Sets.back().Set != set)
 			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Set {} not found for input {}",
-					m_Specification.DebugName, decl->Set, name);
-				return;
+				SetRange& range = m_Sets.emplace_back();
+				range.Set = set;
+				range.FirstSlot = slot;
+				range.FirstDescriptor = (uint32_t)m_Resources.size();
 			}
+			SetRange& range = m_Sets.back();
+			range.SlotCount++;
+			range.DescriptorCount += wd->descriptorCount;
 
-			// Ensure the binding exists
-			auto& setResources = InputResources[decl->Set];
-			if (setResources.find(decl->Binding) == setResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Binding {} not found in set {} for input {}",
-					m_Specification.DebugName, decl->Binding, decl->Set, name);
-				return;
-			}
+			Slot& slotData = m_Slots.emplace_back();
+			slotData.WriteDescriptor = *wd;
+			slotData.WriteDescriptor.dstSet = nullptr;
+			slotData.Type = Utils::GetDefaultResourceType(wd->descriptorType);
+			slotData.FirstDescriptor = (uint32_t)m_Resources.size();
+			slotData.SetIndex = (uint32_t)m_Sets.size() - 1;
 
-			setResources[decl->Binding].Set(storageBuffer);
-		}
-		else
-			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Input {} not found", m_Specification.DebugName, name);
-	}
+			m_Resources.resize(m_Resources.size() + wd->descriptorCount);
 
-	void DescriptorSetManager::SetInput(std::string_view name, Ref<Texture2D> texture, uint32_t index)
-	{
-		const RenderPassInputDeclaration* decl = GetInputDeclaration(name);
-		if (decl)
-		{
-			if (index >= decl->Count)
+			if (m_Specification.DefaultResources && !Utils::IsBufferDescriptor(wd->descriptorType))
 			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Index {} out of range for input {} (max: {})",
-					m_Specification.DebugName, index, name, decl->Count - 1);
-				return;
+				Ref<RefCounted> defaultResource;
+				if (inputDecl.Type == RenderPassInputType::ImageSampler2D)
+					defaultResource = Renderer::GetWhiteTexture();
+				else if (inputDecl.Type == RenderPassInputType::ImageSampler3D)
+					defaultResource = Renderer::GetBlackCubeTexture();
+
+				for (uint32_t i = 0; i < wd->descriptorCount; i++)
+					m_Resources[slotData.FirstDescriptor + i] = defaultResource;
 			}
 
-			// Ensure the set exists
-			if (InputResources.find(decl->Set) == InputResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Set {} not found for input {}",
-					m_Specification.DebugName, decl->Set, name);
-				return;
-			}
-
-			// Ensure the binding exists
-			auto& setResources = InputResources[decl->Set];
-			if (setResources.find(decl->Binding) == setResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Binding {} not found in set {} for input {}",
-					m_Specification.DebugName, decl->Binding, decl->Set, name);
-				return;
-			}
-
-			setResources[decl->Binding].Set(texture, index);
+			m_SlotsByName[std::move(name)] = slot;
 		}
-		else
-			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Input {} not found", m_Specification.DebugName, name);
+
+		m_InvalidSlots.assign(m_Slots.size(), 0);
 	}
 
-	void DescriptorSetManager::SetInput(std::string_view name, Ref<TextureCube> textureCube)
+	DescriptorSetManager::InputSlot DescriptorSetManager::GetInputSlot(std::string_view name) const
 	{
-		const RenderPassInputDeclaration* decl = GetInputDeclaration(name);
-		if (decl)
-		{
-			// Ensure the set exists
-			if (InputResources.find(decl->Set) == InputResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Set {} not found for input {}",
-					m_Specification.DebugName, decl->Set, name);
-				return;
-			}
-
-			// Ensure the binding exists
-			auto& setResources = InputResources[decl->Set];
-			if (setResources.find(decl->Binding) == setResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Binding {} not found in set {} for input {}",
-					m_Specification.DebugName, decl->Binding, decl->Set, name);
-				return;
-			}
-
-			setResources[decl->Binding].Set(textureCube);
-		}
-		else
-			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Input {} not found", m_Specification.DebugName, name);
+		auto it = m_SlotsByName.find(name);
+		return it != m_SlotsByName.end() ? it->second : InvalidSlot;
 	}
 
-	void DescriptorSetManager::SetInput(std::string_view name, Ref<Image2D> image)
+	DescriptorSetManager::InputSlot DescriptorSetManager::GetInputSlot(uint32_t set, uint32_t binding) const
 	{
-		const RenderPassInputDeclaration* decl = GetInputDeclaration(name);
-		if (decl)
+		auto it = std::lower_bound(m_InputDeclarations.begin(), m_InputDeclarations.end(), std::make_pair(set, binding), [](const RenderPassInputDeclaration& decl, const std::pair<uint32_t, uint32_t>& key)
 		{
-			// Ensure the set exists
-			if (InputResources.find(decl->Set) == InputResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Set {} not found for input {}",
-					m_Specification.DebugName, decl->Set, name);
-				return;
-			}
+			return std::make_pair(decl.Set, decl.Binding) < key;
+		});
 
-			// Ensure the binding exists
-			auto& setResources = InputResources[decl->Set];
-			if (setResources.find(decl->Binding) == setResources.end())
-			{
-				ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Binding {} not found in set {} for input {}",
-					m_Specification.DebugName, decl->Binding, decl->Set, name);
-				return;
-			}
+		if (it == m_InputDeclarations.end() || it->Set != set || it->Binding != binding)
+			return InvalidSlot;
 
-			setResources[decl->Binding].Set(image);
-		}
-		else
-			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Input {} not found", m_Specification.DebugName, name);
+		return (InputSlot)(it - m_InputDeclarations.begin());
 	}
 
-	void DescriptorSetManager::SetInput(std::string_view name, Ref<ImageView> image)
+	void DescriptorSetManager::SetResource(InputSlot slot, RenderPassResourceType type, Ref<RefCounted> resource, uint32_t index)
 	{
-		const RenderPassInputDeclaration* decl = GetInputDeclaration(name);
-		if (!decl)
-		{
-			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Input {} not found", m_Specification.DebugName, name);
-			return;
-		}
-
-		// Ensure the set exists
-		if (InputResources.find(decl->Set) == InputResources.end())
+		if (slot >= m_Slots.size())
 		{
-			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Set {} not found for input {}",
-				m_Specification.DebugName, decl->Set, name);
+			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Input slot {} not found", m_Specification.DebugName, slot);
 			return;
 		}
 
-		// Ensure the binding exists
-		auto& setResources = InputResources[decl->Set];
-		if (setResources.find(decl->Binding) == setResources.end())
+		const RenderPassInputDeclaration& decl = m_InputDeclarations[slot];
+		if (index >= decl.Count)
 		{
-			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Binding {} not found in set {} for input {}",
-				m_Specification.DebugName, decl->Binding, decl->Set, name);
+			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Index {} out of range for input {} (max: {})",
+				m_Specification.DebugName, index, decl.Name, decl.Count - 1);
 			return;
 		}
 
-		setResources[decl->Binding].Set(image);
+		Slot& slotData = m_Slots[slot];
+		slotData.Type = type;
+		m_Resources[slotData.FirstDescriptor + index] = std::move(resource);
 	}
 
+#define ZN_SET_INPUT_BY_NAME(...) \
+		const InputSlot slot = GetInputSlot(name); \
+		if (slot == InvalidSlot) \
+		{ \
+			ZN_CORE_WARN_TAG("Renderer", "[RenderPass ({})] Input {} not found", m_Specification.DebugName, name); \
+			return; \
+		} \
+		SetInput(slot, __VA_ARGS__)
+
+	void DescriptorSetManager::SetInput(std::string_view name, Ref<UniformBufferSet> uniformBufferSet) { ZN_SET_INPUT_BY_NAME(uniformBufferSet); }
+	void DescriptorSetManager::SetInput(std::string_view name, Ref<UniformBuffer> uniformBuffer) { ZN_SET_INPUT_BY_NAME(uniformBuffer); }
+	void DescriptorSetManager::SetInput(std::string_view name, Ref<StorageBufferSet> storageBufferSet) { ZN_SET_INPUT_BY_NAME(storageBufferSet); }
+	void DescriptorSetManager::SetInput(std::string_view name, Ref<StorageBuffer> storageBuffer) { ZN_SET_INPUT_BY_NAME(storageBuffer); }
+	void DescriptorSetManager::SetInput(std::string_view name, Ref<Texture2D> texture, uint32_t index) { ZN_SET_INPUT_BY_NAME(texture, index); }
+	void DescriptorSetManager::SetInput(std::string_view name, Ref<TextureCube> textureCube) { ZN_SET_INPUT_BY_NAME(textureCube); }
+	void DescriptorSetManager::SetInput(std::string_view name, Ref<Image2D> image) { ZN_SET_INPUT_BY_NAME(image); }
+	void DescriptorSetManager::SetInput(std::string_view name, Ref<ImageView> image) { ZN_SET_INPUT_BY_NAME(image); }
+
+#undef ZN_SET_INPUT_BY_NAME
+
 	bool DescriptorSetManager::IsInvalidated(uint32_t set, uint32_t binding) const
 	{
-		if (InvalidatedInputResources.find(set) != InvalidatedInputResources.end())
-		{
-			const auto& resources = InvalidatedInputResources.at(set);
-			return resources.find(binding) != resources.end();
-		}
-		return false;
+		const InputSlot slot = GetInputSlot(set, binding);
+		return slot != InvalidSlot && m_InvalidSlots[slot];
 	}
 
-	std::set<uint32_t> DescriptorSetManager::HasBufferSets() const
-	{
-		std::set<uint32_t> sets;
-		for (const auto& [set, resources] : InputResources)
-		{
-			for (const auto& [binding, input] : resources)
-			{
-				if (input.Type == RenderPassResourceType::UniformBufferSet || input.Type == RenderPassResourceType::StorageBufferSet)
-				{
-					sets.insert(set);
-					break;
-				}
-			}
-		}
-		return sets;
-	}
-
-
 	bool DescriptorSetManager::Validate()
 	{
 		const auto& shaderDescriptorSets = m_Specification.Shader->GetShaderDescriptorSets();
 		bool allValid = true;
 
-		for (uint32_t set = m_Specification.StartSet; set <= m_Specification.EndSet; set++)
+		for (InputSlot slot = 0; slot < m_Slots.size(); slot++)
 		{
-			if (set >= shaderDescriptorSets.size())
-				break;
+			const Slot& slotData = m_Slots[slot];
+			const RenderPassInputDeclaration& decl = m_InputDeclarations[slot];
+			const VkDescriptorType descriptorType = slotData.WriteDescriptor.descriptorType;
 
-			if (!shaderDescriptorSets[set])
+			if (!shaderDescriptorSets[decl.Set])
 				continue;
 
-			if (InputResources.find(set) == InputResources.end())
+			if (!IsCompatibleInput(slotData.Type, descriptorType))
 			{
-				ZN_CORE_ERROR_TAG("Renderer", "[RenderPass ({})] No input resources for Set {}", m_Specification.DebugName, set);
+				ZN_CORE_ERROR_TAG("Renderer", "[RenderPass ({})] Type mismatch for '{}': Got {} but shader expects {}",
+					m_Specification.DebugName, decl.Name,
+					static_cast<int>(slotData.Type), static_cast<int>(descriptorType));
 				allValid = false;
 				continue;
 			}
 
-			const auto& setInputResources = InputResources.at(set);
-			const auto& shaderDescriptor = shaderDescriptorSets[set];
-
-			for (auto&& [name, wd] : shaderDescriptor.WriteDescriptorSets)
+			if (slotData.Type != RenderPassResourceType::Image2D && m_Resources[slotData.FirstDescriptor] == nullptr)
 			{
-				uint32_t binding = wd.dstBinding;
-				if (setInputResources.find(binding) == setInputResources.end())
-				{
-					ZN_CORE_ERROR_TAG("Renderer", "[RenderPass ({})] No input resource for {}.{}", m_Specification.DebugName, set, binding);
-					ZN_CORE_ERROR_TAG("Renderer", "[RenderPass ({})] Required resource is {} ({})", m_Specification.DebugName, name, (int)wd.descriptorType);
-					allValid = false;
-					continue;
-				}
-
-				const auto& resource = setInputResources.at(binding);
-
-				if (!IsCompatibleInput(resource.Type, wd.descriptorType))
-				{
-					ZN_CORE_ERROR_TAG("Renderer", "[RenderPass ({})] Type mismatch for '{}': Got {} but shader expects {}",
-						m_Specification.DebugName, name,
-						static_cast<int>(resource.Type), static_cast<int>(wd.descriptorType));
-					allValid = false;
-					continue;
-				}
-
-				if (resource.Type != RenderPassResourceType::Image2D &&
-					(resource.Input.empty() || resource.Input[0] == nullptr))
-				{
-					ZN_CORE_ERROR_TAG("Renderer", "[RenderPass ({})] Resource '{}' is null! ({}.{})",
-						m_Specification.DebugName, name, set, binding);
-					allValid = false;
-				}
+				ZN_CORE_ERROR_TAG("Renderer", "[RenderPass ({})] Resource '{}' is null! ({}.{})",
+					m_Specification.DebugName, decl.Name, decl.Set, decl.Binding);
+				allValid = false;
 			}
 		}
 
@@ -478,235 +298,65 @@ namespace Zenith {
 			return;
 		}
 
-		// If valid, we can create descriptor sets
-
-		// Create Descriptor Pool
-		VkDescriptorPoolSize poolSizes[] =
-		{
-			{ VK_DESCRIPTOR_TYPE_SAMPLER, 1000 },
-			{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1000 },
-			{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1000 },
-			{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1000 },
-			{ VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, 1000 },
-			{ VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, 1000 },
-			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1000 },
-			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1000 },
-			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1000 },
-			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1000 },
-			{ VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1000 }
-		};
-
-		VkDescriptorPoolCreateInfo poolInfo{};
-		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-		poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-		poolInfo.maxSets = 10 * 3; // frames in flight should partially determine this
-		poolInfo.poolSizeCount = 10;
-		poolInfo.pPoolSizes = poolSizes;
+		const uint32_t framesInFlight = Renderer::GetConfig().FramesInFlight;
+		// Every frame in flight can hold on to one set, the rest are free to be rewritten with new contents
+		const uint32_t cacheCapacity = framesInFlight * 2;
 
 		VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
-		VK_CHECK_RESULT(vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_DescriptorPool));
-
-		if (m_DescriptorPool == VK_NULL_HANDLE) {
-			ZN_CORE_ERROR_TAG("Renderer", "[DescriptorSetManager] Failed to create descriptor pool for {}",
-							  m_Specification.DebugName);
-			return;
-		}
-
-		auto bufferSets = HasBufferSets();
-		bool perFrameInFlight = !bufferSets.empty();
-		perFrameInFlight = true; // always
-		uint32_t descriptorSetCount = Renderer::GetConfig().FramesInFlight;
-		if (!perFrameInFlight)
-			descriptorSetCount = 1;
 
-		if (m_DescriptorSets.size() < 1)
+		if (!m_DescriptorPool && !m_Sets.empty())
 		{
-			for (uint32_t i = 0; i < descriptorSetCount; i++)
-				m_DescriptorSets.emplace_back();
-		}
-
-		for (auto& descriptorSet : m_DescriptorSets)
-			descriptorSet.clear();
-
-		for (const auto& [set, setData] : InputResources)
-		{
-			uint32_t descriptorCountInSet = bufferSets.find(set) != bufferSets.end() ? descriptorSetCount : 1;
-			for (uint32_t frameIndex = 0; frameIndex < descriptorSetCount; frameIndex++)
+			std::vector<VkDescriptorPoolSize> poolSizes;
+			for (const Slot& slot : m_Slots)
 			{
-				VkDescriptorSetLayout dsl = m_Specification.Shader->GetDescriptorSetLayout(set);
-				VkDescriptorSetAllocateInfo descriptorSetAllocInfo = Vulkan::DescriptorSetAllocInfo(&dsl);
-
-				if (m_DescriptorPool == VK_NULL_HANDLE) {
-					ZN_CORE_ERROR_TAG("Renderer", "[DescriptorSetManager] Descriptor pool is null during allocation! Set: {}, Frame: {}, Debug: {}",
-									  set, frameIndex, m_Specification.DebugName);
-					return;
-				}
-
-				descriptorSetAllocInfo.descriptorPool = m_DescriptorPool;
-				VkDescriptorSet descriptorSet = nullptr;
-				VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &descriptorSetAllocInfo, &descriptorSet));
-
-				m_DescriptorSets[frameIndex].emplace_back(descriptorSet);
-
-				auto& writeDescriptorMap = WriteDescriptorMap[frameIndex].at(set);
-				std::vector<std::vector<VkDescriptorImageInfo>> imageInfoStorage;
-				uint32_t imageInfoStorageIndex = 0;
-
-				for (const auto& [binding, input] : setData)
-				{
-					// Safely check if the binding exists in the write descriptor map
-					auto writeDescriptorMapIt = WriteDescriptorMap[frameIndex].find(set);
-					if (writeDescriptorMapIt == WriteDescriptorMap[frameIndex].end())
-					{
-						ZN_CORE_ERROR_TAG("Renderer", "[RenderPass] Bake - Set {} not found in WriteDescriptorMap", set);
-						continue;
-					}
-
-					auto& writeDescriptorMap = writeDescriptorMapIt->second;
-					auto storedWriteDescriptorIt = writeDescriptorMap.find(binding);
-					if (storedWriteDescriptorIt == writeDescriptorMap.end())
-					{
-						ZN_CORE_ERROR_TAG("Renderer", "[RenderPass] Bake - Binding {} not found in WriteDescriptorMap", binding);
-						continue;
-					}
-
-					auto& storedWriteDescriptor = storedWriteDescriptorIt->second;
-
-					VkWriteDescriptorSet& writeDescriptor = storedWriteDescriptor.WriteDescriptorSet;
-					writeDescriptor.dstSet = descriptorSet;
-
-					switch (input.Type)
-					{
-					case RenderPassResourceType::UniformBuffer:
-					{
-						Ref<VulkanUniformBuffer> buffer = input.Input[0].As<VulkanUniformBuffer>();
-						writeDescriptor.pBufferInfo = &buffer->GetDescriptorBufferInfo();
-						storedWriteDescriptor.ResourceHandles[0] = writeDescriptor.pBufferInfo->buffer;
-
-						// Defer if resource doesn't exist
-						if (writeDescriptor.pBufferInfo->buffer == nullptr)
-							InvalidatedInputResources[set][binding] = input;
-
-						break;
-					}
-					case RenderPassResourceType::UniformBufferSet:
-					{
-						Ref<UniformBufferSet> buffer = input.Input[0].As<UniformBufferSet>();
-						// TODO: replace 0 with current frame in flight (i.e. create bindings for all frames)
-						writeDescriptor.pBufferInfo = &buffer->Get(frameIndex).As<VulkanUniformBuffer>()->GetDescriptorBufferInfo();
-						storedWriteDescriptor.ResourceHandles[0] = writeDescriptor.pBufferInfo->buffer;
-
-						// Defer if resource doesn't exist
-						if (writeDescriptor.pBufferInfo->buffer == nullptr)
-							InvalidatedInputResources[set][binding] = input;
-
-						break;
-					}
-					case RenderPassResourceType::StorageBuffer:
-					{
-						Ref<VulkanStorageBuffer> buffer = input.Input[0].As<VulkanStorageBuffer>();
-						writeDescriptor.pBufferInfo = &buffer->GetDescriptorBufferInfo();
-						storedWriteDescriptor.ResourceHandles[0] = writeDescriptor.pBufferInfo->buffer;
-
-						// Defer if resource doesn't exist
-						if (writeDescriptor.pBufferInfo->buffer == nullptr)
-							InvalidatedInputResources[set][binding] = input;
-
-						break;
-					}
-					case RenderPassResourceType::StorageBufferSet:
-					{
-						Ref<StorageBufferSet> buffer = input.Input[0].As<StorageBufferSet>();
-						// TODO: replace 0 with current frame in flight (i.e. create bindings for all frames)
-						writeDescriptor.pBufferInfo = &buffer->Get(frameIndex).As<VulkanStorageBuffer>()->GetDescriptorBufferInfo();
-						storedWriteDescriptor.ResourceHandles[0] = writeDescriptor.pBufferInfo->buffer;
+				const VkDescriptorType type = slot.WriteDescriptor.descriptorType;
+				auto it = std::find_if(poolSizes.begin(), poolSizes.end(), [type](const VkDescriptorPoolSize& size) { return size.type == type; });
+				if (it == poolSizes.end())
+					it = poolSizes.insert(poolSizes.end(), VkDescriptorPoolSize{ type, 0 });
+				it->descriptorCount += slot.WriteDescriptor.descriptorCount * cacheCapacity;
+			}
 
-						// Defer if resource doesn't exist
-						if (writeDescriptor.pBufferInfo->buffer == nullptr)
-							InvalidatedInputResources[set][binding] = input;
+			VkDescriptorPoolCreateInfo poolInfo{};
+			poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			poolInfo.maxSets = (uint32_t)m_Sets.size() * cacheCapacity;
+			poolInfo.poolSizeCount = (uint32_t)poolSizes.size();
+			poolInfo.pPoolSizes = poolSizes.data();
 
-						break;
-					}
-					case RenderPassResourceType::Texture2D:
-					{
-						if (input.Input.size() > 1)
-						{
-							imageInfoStorage.emplace_back(input.Input.size());
-							for (size_t i = 0; i < input.Input.size(); i++)
-							{
-								Ref<VulkanTexture2D> texture = input.Input[i].As<VulkanTexture2D>();
-								imageInfoStorage[imageInfoStorageIndex][i] = texture->GetDescriptorInfoVulkan();
-
-							}
-							writeDescriptor.pImageInfo = imageInfoStorage[imageInfoStorageIndex].data();
-							imageInfoStorageIndex++;
-						}
-						else
-						{
-							Ref<VulkanTexture2D> texture = input.Input[0].As<VulkanTexture2D>();
-							writeDescriptor.pImageInfo = &texture->GetDescriptorInfoVulkan();
-						}
-						storedWriteDescriptor.ResourceHandles[0] = writeDescriptor.pImageInfo->imageView;
-
-						// Defer if resource doesn't exist
-						if (writeDescriptor.pImageInfo->imageView == nullptr)
-							InvalidatedInputResources[set][binding] = input;
-
-						break;
-					}
-					case RenderPassResourceType::TextureCube:
-					{
-						Ref<VulkanTextureCube> texture = input.Input[0].As<VulkanTextureCube>();
-						writeDescriptor.pImageInfo = &texture->GetDescriptorInfoVulkan();
-						storedWriteDescriptor.ResourceHandles[0] = writeDescriptor.pImageInfo->imageView;
+			VK_CHECK_RESULT(vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_DescriptorPool));
 
-						// Defer if resource doesn't exist
-						if (writeDescriptor.pImageInfo->imageView == nullptr)
-							InvalidatedInputResources[set][binding] = input;
+			if (m_DescriptorPool == VK_NULL_HANDLE) {
+				ZN_CORE_ERROR_TAG("Renderer", "[DescriptorSetManager] Failed to create descriptor pool for {}",
+								  m_Specification.DebugName);
+				return;
+			}
 
-						break;
-					}
-					case RenderPassResourceType::Image2D:
-					{
-						Ref<RendererResource> image = input.Input[0].As<RendererResource>();
-						// Defer if resource doesn't exist
-						if (image == nullptr)
-						{
-							InvalidatedInputResources[set][binding] = input;
-							break;
-						}
-
-						writeDescriptor.pImageInfo = (VkDescriptorImageInfo*)image->GetDescriptorInfo();
-						storedWriteDescriptor.ResourceHandles[0] = writeDescriptor.pImageInfo->imageView;
-
-						// Defer if resource doesn't exist
-						if (writeDescriptor.pImageInfo->imageView == nullptr)
-							InvalidatedInputResources[set][binding] = input;
-
-						break;
-					}
-					}
-				}
+			// Sets are allocated once, the cache only ever rewrites them
+			m_CachedSets.resize(m_Sets.size());
+			for (uint32_t setIndex = 0; setIndex < m_Sets.size(); setIndex++)
+			{
+				VkDescriptorSetLayout dsl = m_Specification.Shader->GetDescriptorSetLayout(m_Sets[setIndex].Set);
+				std::vector<VkDescriptorSetLayout> layouts(cacheCapacity, dsl);
+				std::vector<VkDescriptorSet> descriptorSets(cacheCapacity);
 
-				std::vector<VkWriteDescriptorSet> writeDescriptors;
-				auto writeDescriptorMapIt = WriteDescriptorMap[frameIndex].find(set);
-				if (writeDescriptorMapIt != WriteDescriptorMap[frameIndex].end())
-				{
-					for (auto&& [binding, writeDescriptor] : writeDescriptorMapIt->second)
-					{
-						// Include if valid, otherwise defer (these will be resolved if possible at Prepare stage)
-						if (!IsInvalidated(set, binding))
-							writeDescriptors.emplace_back(writeDescriptor.WriteDescriptorSet);
-					}
-				}
+				VkDescriptorSetAllocateInfo descriptorSetAllocInfo = Vulkan::DescriptorSetAllocInfo(layouts.data(), cacheCapacity, m_DescriptorPool);
+				VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &descriptorSetAllocInfo, descriptorSets.data()));
 
-				if (!writeDescriptors.empty())
+				auto& cachedSets = m_CachedSets[setIndex];
+				cachedSets.resize(cacheCapacity);
+				for (uint32_t i = 0; i < cacheCapacity; i++)
 				{
-					vkUpdateDescriptorSets(device, (uint32_t)writeDescriptors.size(), writeDescriptors.data(), 0, nullptr);
+					cachedSets[i].DescriptorSet = descriptorSets[i];
+					cachedSets[i].Infos.resize(m_Sets[setIndex].DescriptorCount);
 				}
 			}
 		}
 
+		m_DescriptorSets.assign(framesInFlight, std::vector<VkDescriptorSet>(m_Sets.size()));
+		m_BoundCachedSets.assign(framesInFlight, std::vector<uint32_t>(m_Sets.size(), InvalidCachedSet));
+
+		// Frames whose inputs are the same end up sharing their sets
+		for (uint32_t frameIndex = 0; frameIndex < framesInFlight; frameIndex++)
+			UpdateDescriptorSets(frameIndex);
 	}
 
 	void DescriptorSetManager::InvalidateAndUpdate()
@@ -714,204 +364,182 @@ namespace Zenith {
 		ZN_PROFILE_FUNC();
 		ZN_SCOPE_PERF("DescriptorSetManager::InvalidateAndUpdate");
 
-		uint32_t currentFrameIndex = Renderer::RT_GetCurrentFrameIndex();
+		const uint32_t currentFrameIndex = Renderer::RT_GetCurrentFrameIndex();
+		if (currentFrameIndex >= m_DescriptorSets.size())
+			return;
 
-		for (const auto& [set, inputs] : InputResources)
-		{
-			for (const auto& [binding, input] : inputs)
-			{
-				if (currentFrameIndex >= WriteDescriptorMap.size())
-					continue;
+		UpdateDescriptorSets(currentFrameIndex);
+	}
+
+	void DescriptorSetManager::SetImageInfo(DescriptorInfo& info, const VkDescriptorImageInfo& imageInfo)
+	{
+		// Member by member, copying the struct could bring along whatever is in its padding
+		info.Image.sampler = imageInfo.sampler;
+		info.Image.imageView = imageInfo.imageView;
+		info.Image.imageLayout = imageInfo.imageLayout;
+	}
 
-				auto frameMapIt = WriteDescriptorMap[currentFrameIndex].find(set);
-				if (frameMapIt == WriteDescriptorMap[currentFrameIndex].end())
-					continue;
+	void DescriptorSetManager::GatherDescriptorInfos(uint32_t frameIndex)
+	{
+		m_CurrentInfos.resize(m_Resources.size());
+		memset(m_CurrentInfos.data(), 0, m_CurrentInfos.size() * sizeof(DescriptorInfo));
 
-				auto bindingMapIt = frameMapIt->second.find(binding);
-				if (bindingMapIt == frameMapIt->second.end())
-					continue;
+		for (InputSlot slot = 0; slot < m_Slots.size(); slot++)
+		{
+			const Slot& slotData = m_Slots[slot];
+			const uint32_t count = m_InputDeclarations[slot].Count;
+			const Ref<RefCounted>* resources = &m_Resources[slotData.FirstDescriptor];
+			DescriptorInfo* infos = &m_CurrentInfos[slotData.FirstDescriptor];
+			bool valid = true;
 
-				switch (input.Type)
-				{
+			switch (slotData.Type)
+			{
 				case RenderPassResourceType::UniformBuffer:
 				{
-					const VkDescriptorBufferInfo& bufferInfo = input.Input[0].As<VulkanUniformBuffer>()->GetDescriptorBufferInfo();
-					if (bufferInfo.buffer != bindingMapIt->second.ResourceHandles[0])
-						InvalidatedInputResources[set][binding] = input;
+					infos[0].Buffer = resources[0].As<VulkanUniformBuffer>()->GetDescriptorBufferInfo();
+					valid = infos[0].Buffer.buffer != nullptr;
 					break;
 				}
 				case RenderPassResourceType::UniformBufferSet:
 				{
-					const VkDescriptorBufferInfo& bufferInfo = input.Input[0].As<VulkanUniformBufferSet>()->Get(currentFrameIndex).As<VulkanUniformBuffer>()->GetDescriptorBufferInfo();
-					if (bufferInfo.buffer != bindingMapIt->second.ResourceHandles[0])
-						InvalidatedInputResources[set][binding] = input;
+					infos[0].Buffer = resources[0].As<UniformBufferSet>()->Get(frameIndex).As<VulkanUniformBuffer>()->GetDescriptorBufferInfo();
+					valid = infos[0].Buffer.buffer != nullptr;
 					break;
 				}
 				case RenderPassResourceType::StorageBuffer:
 				{
-					const VkDescriptorBufferInfo& bufferInfo = input.Input[0].As<VulkanStorageBuffer>()->GetDescriptorBufferInfo();
-					if (bufferInfo.buffer != bindingMapIt->second.ResourceHandles[0])
-						InvalidatedInputResources[set][binding] = input;
+					infos[0].Buffer = resources[0].As<VulkanStorageBuffer>()->GetDescriptorBufferInfo();
+					valid = infos[0].Buffer.buffer != nullptr;
 					break;
 				}
 				case RenderPassResourceType::StorageBufferSet:
 				{
-					const VkDescriptorBufferInfo& bufferInfo = input.Input[0].As<VulkanStorageBufferSet>()->Get(currentFrameIndex).As<VulkanStorageBuffer>()->GetDescriptorBufferInfo();
-					if (bufferInfo.buffer != bindingMapIt->second.ResourceHandles[0])
-						InvalidatedInputResources[set][binding] = input;
+					infos[0].Buffer = resources[0].As<StorageBufferSet>()->Get(frameIndex).As<VulkanStorageBuffer>()->GetDescriptorBufferInfo();
+					valid = infos[0].Buffer.buffer != nullptr;
 					break;
 				}
 				case RenderPassResourceType::Texture2D:
 				{
-					for (size_t i = 0; i < input.Input.size(); i++)
+					for (uint32_t i = 0; i < count; i++)
 					{
-						Ref<VulkanTexture2D> vulkanTexture = input.Input[i].As<VulkanTexture2D>();
-						if (!vulkanTexture)
-							vulkanTexture = Renderer::GetWhiteTexture().As<VulkanTexture2D>();
-
-						const VkDescriptorImageInfo& imageInfo = vulkanTexture->GetDescriptorInfoVulkan();
-						if (i < bindingMapIt->second.ResourceHandles.size() &&
-							imageInfo.imageView != bindingMapIt->second.ResourceHandles[i])
-						{
-							InvalidatedInputResources[set][binding] = input;
-							break;
-						}
+						Ref<VulkanTexture2D> texture = resources[i].As<VulkanTexture2D>();
+						if (!texture)
+							texture = Renderer::GetWhiteTexture().As<VulkanTexture2D>();
+
+						SetImageInfo(infos[i], texture->GetDescriptorInfoVulkan());
+						valid &= infos[i].Image.imageView != nullptr;
 					}
 					break;
 				}
 				case RenderPassResourceType::TextureCube:
 				{
-					const VkDescriptorImageInfo& imageInfo = input.Input[0].As<VulkanTextureCube>()->GetDescriptorInfoVulkan();
-					if (imageInfo.imageView != bindingMapIt->second.ResourceHandles[0])
-						InvalidatedInputResources[set][binding] = input;
+					SetImageInfo(infos[0], resources[0].As<VulkanTextureCube>()->GetDescriptorInfoVulkan());
+					valid = infos[0].Image.imageView != nullptr;
 					break;
 				}
 				case RenderPassResourceType::Image2D:
 				{
-					const VkDescriptorImageInfo& imageInfo = *(VkDescriptorImageInfo*)input.Input[0].As<RendererResource>()->GetDescriptorInfo();
-					if (imageInfo.imageView != bindingMapIt->second.ResourceHandles[0])
-						InvalidatedInputResources[set][binding] = input;
+					Ref<RendererResource> image = resources[0].As<RendererResource>();
+					const VkDescriptorImageInfo* imageInfo = image ? (const VkDescriptorImageInfo*)image->GetDescriptorInfo() : nullptr;
+					valid = imageInfo && imageInfo->imageView;
+					if (valid)
+						SetImageInfo(infos[0], *imageInfo);
 					break;
 				}
-				}
+				default:
+					valid = false;
+					break;
 			}
+
+			// Deferred until the resource exists, its descriptors stay zero so the set contents tell it apart
+			if (!valid)
+				memset(infos, 0, count * sizeof(DescriptorInfo));
+			m_InvalidSlots[slot] = !valid;
 		}
+	}
 
-		if (InvalidatedInputResources.empty())
-			return;
+	uint32_t DescriptorSetManager::AcquireCachedSet(uint32_t setIndex)
+	{
+		const SetRange& range = m_Sets[setIndex];
+		const DescriptorInfo* infos = &m_CurrentInfos[range.FirstDescriptor];
+		const size_t infoSize = range.DescriptorCount * sizeof(DescriptorInfo);
+		const uint64_t hash = XXHash64::compute(infos, infoSize);
 
-		auto bufferSets = HasBufferSets();
-		bool perFrameInFlight = !bufferSets.empty();
-		perFrameInFlight = true; // always true anyway
-		uint32_t descriptorSetCount = Renderer::GetConfig().FramesInFlight;
-		if (!perFrameInFlight)
-			descriptorSetCount = 1;
+		auto& cachedSets = m_CachedSets[setIndex];
+		for (uint32_t i = 0; i < cachedSets.size(); i++)
+		{
+			CachedSet& cachedSet = cachedSets[i];
+			if (cachedSet.LastUsed && cachedSet.Hash == hash && memcmp(cachedSet.Infos.data(), infos, infoSize) == 0)
+				return i;
+		}
 
-		for (const auto& [set, setData] : InvalidatedInputResources)
+		// Recycle the least recently used set no frame is bound to, a bound one may still be in use on the GPU
+		uint32_t recycled = InvalidCachedSet;
+		for (uint32_t i = 0; i < cachedSets.size(); i++)
 		{
-			uint32_t frameIndex = perFrameInFlight ? currentFrameIndex : 0;
+			bool bound = false;
+			for (const auto& frameSets : m_BoundCachedSets)
+				bound |= frameSets[setIndex] == i;
 
-			if (frameIndex >= WriteDescriptorMap.size())
-				continue;
+			if (!bound && (recycled == InvalidCachedSet || cachedSets[i].LastUsed < cachedSets[recycled].LastUsed))
+				recycled = i;
+		}
+		ZN_CORE_VERIFY(recycled != InvalidCachedSet);
+
+		CachedSet& cachedSet = cachedSets[recycled];
+		cachedSet.Hash = hash;
+		memcpy(cachedSet.Infos.data(), infos, infoSize);
 
-			auto frameMapIt = WriteDescriptorMap[frameIndex].find(set);
-			if (frameMapIt == WriteDescriptorMap[frameIndex].end())
+		for (InputSlot slot = range.FirstSlot; slot < range.FirstSlot + range.SlotCount; slot++)
+		{
+			if (m_InvalidSlots[slot])
 				continue;
 
-			std::vector<VkWriteDescriptorSet> writeDescriptorsToUpdate;
-			std::vector<std::vector<VkDescriptorImageInfo>> imageInfoStorage;
-			uint32_t imageInfoStorageIndex = 0;
+			const Slot& slotData = m_Slots[slot];
+			const DescriptorInfo& info = cachedSet.Infos[slotData.FirstDescriptor - range.FirstDescriptor];
 
-			for (const auto& [binding, input] : setData)
-			{
-				auto bindingMapIt = frameMapIt->second.find(binding);
-				if (bindingMapIt == frameMapIt->second.end())
-					continue;
+			VkWriteDescriptorSet& writeDescriptor = m_PendingWrites.emplace_back(slotData.WriteDescriptor);
+			writeDescriptor.dstSet = cachedSet.DescriptorSet;
+			if (Utils::IsBufferDescriptor(writeDescriptor.descriptorType))
+				writeDescriptor.pBufferInfo = &info.Buffer;
+			else
+				writeDescriptor.pImageInfo = &info.Image;
+		}
 
-				auto& wd = bindingMapIt->second;
-				VkWriteDescriptorSet& writeDescriptor = wd.WriteDescriptorSet;
+		return recycled;
+	}
 
-				switch (input.Type)
-				{
-				case RenderPassResourceType::UniformBuffer:
-				{
-					Ref<VulkanUniformBuffer> buffer = input.Input[0].As<VulkanUniformBuffer>();
-					writeDescriptor.pBufferInfo = &buffer->GetDescriptorBufferInfo();
-					wd.ResourceHandles[0] = writeDescriptor.pBufferInfo->buffer;
-					break;
-				}
-				case RenderPassResourceType::UniformBufferSet:
-				{
-					Ref<UniformBufferSet> buffer = input.Input[0].As<UniformBufferSet>();
-					writeDescriptor.pBufferInfo = &buffer->Get(frameIndex).As<VulkanUniformBuffer>()->GetDescriptorBufferInfo();
-					wd.ResourceHandles[0] = writeDescriptor.pBufferInfo->buffer;
-					break;
-				}
-				case RenderPassResourceType::StorageBuffer:
-				{
-					Ref<VulkanStorageBuffer> buffer = input.Input[0].As<VulkanStorageBuffer>();
-					writeDescriptor.pBufferInfo = &buffer->GetDescriptorBufferInfo();
-					wd.ResourceHandles[0] = writeDescriptor.pBufferInfo->buffer;
-					break;
-				}
-				case RenderPassResourceType::StorageBufferSet:
-				{
-					Ref<StorageBufferSet> buffer = input.Input[0].As<StorageBufferSet>();
-					writeDescriptor.pBufferInfo = &buffer->Get(frameIndex).As<VulkanStorageBuffer>()->GetDescriptorBufferInfo();
-					wd.ResourceHandles[0] = writeDescriptor.pBufferInfo->buffer;
-					break;
-				}
-				case RenderPassResourceType::Texture2D:
-				{
-					if (input.Input.size() > 1)
-					{
-						imageInfoStorage.emplace_back(input.Input.size());
-						for (size_t i = 0; i < input.Input.size(); i++)
-						{
-							Ref<VulkanTexture2D> texture = input.Input[i].As<VulkanTexture2D>();
-							imageInfoStorage[imageInfoStorageIndex][i] = texture->GetDescriptorInfoVulkan();
-							if (i < wd.ResourceHandles.size())
-								wd.ResourceHandles[i] = imageInfoStorage[imageInfoStorageIndex][i].imageView;
-						}
-						writeDescriptor.pImageInfo = imageInfoStorage[imageInfoStorageIndex].data();
-						imageInfoStorageIndex++;
-					}
-					else
-					{
-						Ref<VulkanTexture2D> texture = input.Input[0].As<VulkanTexture2D>();
-						writeDescriptor.pImageInfo = &texture->GetDescriptorInfoVulkan();
-						wd.ResourceHandles[0] = writeDescriptor.pImageInfo->imageView;
-					}
-					break;
-				}
-				case RenderPassResourceType::TextureCube:
-				{
-					Ref<VulkanTextureCube> texture = input.Input[0].As<VulkanTextureCube>();
-					writeDescriptor.pImageInfo = &texture->GetDescriptorInfoVulkan();
-					wd.ResourceHandles[0] = writeDescriptor.pImageInfo->imageView;
-					break;
-				}
-				case RenderPassResourceType::Image2D:
-				{
-					Ref<RendererResource> image = input.Input[0].As<RendererResource>();
-					writeDescriptor.pImageInfo = (VkDescriptorImageInfo*)image->GetDescriptorInfo();
-					ZN_CORE_VERIFY(writeDescriptor.pImageInfo->imageView);
-					wd.ResourceHandles[0] = writeDescriptor.pImageInfo->imageView;
-					break;
-				}
-				}
+	void DescriptorSetManager::UpdateDescriptorSets(uint32_t frameIndex)
+	{
+		if (m_CachedSets.empty())
+			return;
 
-				writeDescriptorsToUpdate.emplace_back(writeDescriptor);
-			}
+		GatherDescriptorInfos(frameIndex);
+		m_UpdateCount++;
 
-			if (!writeDescriptorsToUpdate.empty())
+		auto& boundSets = m_BoundCachedSets[frameIndex];
+		for (uint32_t setIndex = 0; setIndex < m_Sets.size(); setIndex++)
+		{
+			const SetRange& range = m_Sets[setIndex];
+			uint32_t cachedSetIndex = boundSets[setIndex];
+
+			// Nothing changed since this frame last used the set, the common case
+			if (cachedSetIndex == InvalidCachedSet || memcmp(m_CachedSets[setIndex][cachedSetIndex].Infos.data(), &m_CurrentInfos[range.FirstDescriptor], range.DescriptorCount * sizeof(DescriptorInfo)) != 0)
 			{
-				VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
-				vkUpdateDescriptorSets(device, (uint32_t)writeDescriptorsToUpdate.size(), writeDescriptorsToUpdate.data(), 0, nullptr);
+				cachedSetIndex = AcquireCachedSet(setIndex);
+				boundSets[setIndex] = cachedSetIndex;
+				m_DescriptorSets[frameIndex][setIndex] = m_CachedSets[setIndex][cachedSetIndex].DescriptorSet;
 			}
+
+			m_CachedSets[setIndex][cachedSetIndex].LastUsed = m_UpdateCount;
 		}
 
-		InvalidatedInputResources.clear();
+		if (!m_PendingWrites.empty())
+		{
+			VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
+			vkUpdateDescriptorSets(device, (uint32_t)m_PendingWrites.size(), m_PendingWrites.data(), 0, nullptr);
+			m_PendingWrites.clear();
+		}
 	}
 
 	bool DescriptorSetManager::HasDescriptorSets() const
@@ -921,37 +549,27 @@ namespace Zenith {
 
 	uint32_t DescriptorSetManager::GetFirstSetIndex() const
 	{
-		if (InputResources.empty())
+		if (m_Sets.empty())
 			return UINT32_MAX;
 
-		// Return first key (key == descriptor set index)
-		return InputResources.begin()->first;
+		return m_Sets.front().Set;
 	}
 
 	const std::vector<VkDescriptorSet>& DescriptorSetManager::GetDescriptorSets(uint32_t frameIndex) const
 	{
-		ZN_CORE_ASSERT(!m_DescriptorSets.empty());
-
-		if (frameIndex > 0 && m_DescriptorSets.size() == 1)
-			return m_DescriptorSets[0]; // Frame index is irrelevant for this type of render pass
-
+		ZN_CORE_ASSERT(frameIndex < m_DescriptorSets.size());
 		return m_DescriptorSets[frameIndex];
 	}
 
 	bool DescriptorSetManager::IsInputValid(std::string_view name) const
 	{
-		std::string nameStr(name);
-		return InputDeclarations.find(nameStr) != InputDeclarations.end();
+		return GetInputSlot(name) != InvalidSlot;
 	}
 
 	const RenderPassInputDeclaration* DescriptorSetManager::GetInputDeclaration(std::string_view name) const
 	{
-		std::string nameStr(name);
-		if (InputDeclarations.find(nameStr) == InputDeclarations.end())
-			return nullptr;
-
-		const RenderPassInputDeclaration& decl = InputDeclarations.at(nameStr);
-		return &decl;
+		const InputSlot slot = GetInputSlot(name);
+		return slot != InvalidSlot ? &m_InputDeclarations[slot] : nullptr;
 	}
 
 }
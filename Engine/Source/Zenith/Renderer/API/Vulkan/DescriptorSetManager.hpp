@@ -9,7 +9,7 @@
 
 #include "vulkan/vulkan.h"
 
-#include <set>
+#include <unordered_map>
 
 namespace Zenith {
 
@@ -38,98 +38,6 @@ namespace Zenith {
 		StorageImage3D
 	};
 
-	struct RenderPassInput
-	{
-		RenderPassResourceType Type = RenderPassResourceType::None;
-		std::vector<Ref<RefCounted>> Input;
-
-		RenderPassInput() = default;
-
-		RenderPassInput(Ref<UniformBuffer> uniformBuffer)
-			: Type(RenderPassResourceType::UniformBuffer), Input(std::vector<Ref<RefCounted>>(1, uniformBuffer))
-		{
-		}
-
-		RenderPassInput(Ref<UniformBufferSet> uniformBufferSet)
-			: Type(RenderPassResourceType::UniformBufferSet), Input(std::vector<Ref<RefCounted>>(1, uniformBufferSet))
-		{
-		}
-
-		RenderPassInput(Ref<StorageBuffer> storageBuffer)
-			: Type(RenderPassResourceType::StorageBuffer), Input(std::vector<Ref<RefCounted>>(1, storageBuffer))
-		{
-		}
-
-		RenderPassInput(Ref<StorageBufferSet> storageBufferSet)
-			: Type(RenderPassResourceType::StorageBufferSet), Input(std::vector<Ref<RefCounted>>(1, storageBufferSet))
-		{
-		}
-
-		RenderPassInput(Ref<Texture2D> texture)
-			: Type(RenderPassResourceType::Texture2D), Input(std::vector<Ref<RefCounted>>(1, texture))
-		{
-		}
-
-		RenderPassInput(Ref<TextureCube> texture)
-			: Type(RenderPassResourceType::TextureCube), Input(std::vector<Ref<RefCounted>>(1, texture))
-		{
-		}
-
-		RenderPassInput(Ref<Image2D> image)
-			: Type(RenderPassResourceType::Image2D), Input(std::vector<Ref<RefCounted>>(1, image))
-		{
-		}
-
-		void Set(Ref<UniformBuffer> uniformBuffer, uint32_t index = 0)
-		{
-			Type = RenderPassResourceType::UniformBuffer;
-			Input[index] = uniformBuffer;
-		}
-
-		void Set(Ref<UniformBufferSet> uniformBufferSet, uint32_t index = 0)
-		{
-			Type = RenderPassResourceType::UniformBufferSet;
-			Input[index] = uniformBufferSet;
-		}
-
-		void Set(Ref<StorageBuffer> storageBuffer, uint32_t index = 0)
-		{
-			Type = RenderPassResourceType::StorageBuffer;
-			Input[index] = storageBuffer;
-		}
-
-		void Set(Ref<StorageBufferSet> storageBufferSet, uint32_t index = 0)
-		{
-			Type = RenderPassResourceType::StorageBufferSet;
-			Input[index] = storageBufferSet;
-		}
-
-		void Set(Ref<Texture2D> texture, uint32_t index = 0)
-		{
-			Type = RenderPassResourceType::Texture2D;
-			Input[index] = texture;
-		}
-
-		void Set(Ref<TextureCube> texture, uint32_t index = 0)
-		{
-			Type = RenderPassResourceType::TextureCube;
-			Input[index] = texture;
-		}
-
-		void Set(Ref<Image2D> image, uint32_t index = 0)
-		{
-			Type = RenderPassResourceType::Image2D;
-			Input[index] = image;
-		}
-
-		void Set(Ref<ImageView> image, uint32_t index = 0)
-		{
-			Type = RenderPassResourceType::Image2D;
-			Input[index] = image;
-		}
-
-	};
-
 	inline bool IsCompatibleInput(RenderPassResourceType input, VkDescriptorType descriptorType)
 	{
 		switch (descriptorType)
@@ -202,26 +110,22 @@ namespace Zenith {
 		bool DefaultResources = false;
 	};
 
+	// Inputs live in flat arrays indexed by slot, one slot per (set, binding) in set and binding order.
+	// Names are resolved to slots once, hot paths should keep the slot and set inputs through it.
 	struct DescriptorSetManager
 	{
-		std::map<uint32_t, std::map<uint32_t, RenderPassInput>> InputResources;
-		std::map<uint32_t, std::map<uint32_t, RenderPassInput>> InvalidatedInputResources;
-		std::map<std::string, RenderPassInputDeclaration> InputDeclarations;
-
-		std::vector<std::vector<VkDescriptorSet>> m_DescriptorSets;
-
-		struct WriteDescriptor
-		{
-			VkWriteDescriptorSet WriteDescriptorSet{};
-			std::vector<void*> ResourceHandles;
-		};
-		std::vector<std::map<uint32_t, std::map<uint32_t, WriteDescriptor>>> WriteDescriptorMap;
+		using InputSlot = uint32_t;
+		static constexpr InputSlot InvalidSlot = UINT32_MAX;
 
 		DescriptorSetManager() = default;
 		DescriptorSetManager(const DescriptorSetManager& other);
 		DescriptorSetManager(const DescriptorSetManagerSpecification& specification);
+		DescriptorSetManager& operator=(const DescriptorSetManager& other) = default;
 		static DescriptorSetManager Copy(const DescriptorSetManager& other);
 
+		InputSlot GetInputSlot(std::string_view name) const;
+		InputSlot GetInputSlot(uint32_t set, uint32_t binding) const;
+
 		void SetInput(std::string_view name, Ref<UniformBufferSet> uniformBufferSet);
 		void SetInput(std::string_view name, Ref<UniformBuffer> uniformBuffer);
 		void SetInput(std::string_view name, Ref<StorageBufferSet> storageBufferSet);
@@ -231,48 +135,37 @@ namespace Zenith {
 		void SetInput(std::string_view name, Ref<Image2D> image);
 		void SetInput(std::string_view name, Ref<ImageView> image);
 
+		void SetInput(InputSlot slot, Ref<UniformBufferSet> uniformBufferSet) { SetResource(slot, RenderPassResourceType::UniformBufferSet, uniformBufferSet); }
+		void SetInput(InputSlot slot, Ref<UniformBuffer> uniformBuffer) { SetResource(slot, RenderPassResourceType::UniformBuffer, uniformBuffer); }
+		void SetInput(InputSlot slot, Ref<StorageBufferSet> storageBufferSet) { SetResource(slot, RenderPassResourceType::StorageBufferSet, storageBufferSet); }
+		void SetInput(InputSlot slot, Ref<StorageBuffer> storageBuffer) { SetResource(slot, RenderPassResourceType::StorageBuffer, storageBuffer); }
+		void SetInput(InputSlot slot, Ref<Texture2D> texture, uint32_t index = 0) { SetResource(slot, RenderPassResourceType::Texture2D, texture, index); }
+		void SetInput(InputSlot slot, Ref<TextureCube> textureCube) { SetResource(slot, RenderPassResourceType::TextureCube, textureCube); }
+		void SetInput(InputSlot slot, Ref<Image2D> image) { SetResource(slot, RenderPassResourceType::Image2D, image); }
+		void SetInput(InputSlot slot, Ref<ImageView> image) { SetResource(slot, RenderPassResourceType::Image2D, image); }
+
 		template<typename T>
-		Ref<T> GetInput(std::string_view name)
+		Ref<T> GetInput(std::string_view name) const
 		{
-			const RenderPassInputDeclaration* decl = GetInputDeclaration(name);
-			if (decl)
-			{
-				auto setIt = InputResources.find(decl->Set);
-				if (setIt != InputResources.end())
-				{
-					auto resourceIt = setIt->second.find(decl->Binding);
-					if (resourceIt != setIt->second.end() && !resourceIt->second.Input.empty())
-					{
-						return resourceIt->second.Input[0].As<T>();
-					}
-				}
-			}
-			return nullptr;
+			const InputSlot slot = GetInputSlot(name);
+			if (slot == InvalidSlot)
+				return nullptr;
+
+			return m_Resources[m_Slots[slot].FirstDescriptor].As<T>();
 		}
 
 		bool HasInput(std::string_view name) const
 		{
-			const RenderPassInputDeclaration* decl = GetInputDeclaration(name);
-			if (decl)
-			{
-				auto setIt = InputResources.find(decl->Set);
-				if (setIt != InputResources.end())
-				{
-					auto resourceIt = setIt->second.find(decl->Binding);
-					if (resourceIt != setIt->second.end() && !resourceIt->second.Input.empty())
-					{
-						return resourceIt->second.Input[0] != nullptr;
-					}
-				}
-			}
-			return false;
+			const InputSlot slot = GetInputSlot(name);
+			return slot != InvalidSlot && m_Resources[m_Slots[slot].FirstDescriptor] != nullptr;
 		}
 
+		// Whether the input could not be written the last time the descriptor sets were updated
 		bool IsInvalidated(uint32_t set, uint32_t binding) const;
 		bool Validate();
 		void Bake();
 
-		std::set<uint32_t> HasBufferSets() const;
+		// On the render thread: brings the current frame's descriptor sets up to date with the inputs
 		void InvalidateAndUpdate();
 
 		VkDescriptorPool GetDescriptorPool() const { return m_DescriptorPool; }
@@ -281,11 +174,75 @@ namespace Zenith {
 		const std::vector<VkDescriptorSet>& GetDescriptorSets(uint32_t frameIndex) const;
 		bool IsInputValid(std::string_view name) const;
 		const RenderPassInputDeclaration* GetInputDeclaration(std::string_view name) const;
+		// Indexed by slot
+		const std::vector<RenderPassInputDeclaration>& GetInputDeclarations() const { return m_InputDeclarations; }
 	private:
+		struct Slot
+		{
+			VkWriteDescriptorSet WriteDescriptor{};
+			RenderPassResourceType Type = RenderPassResourceType::None;
+			uint32_t FirstDescriptor = 0; // Into m_Resources and the descriptor infos
+			uint32_t SetIndex = 0;        // Into m_Sets
+		};
+
+		struct SetRange
+		{
+			uint32_t Set = 0;
+			uint32_t FirstSlot = 0, SlotCount = 0;
+			uint32_t FirstDescriptor = 0, DescriptorCount = 0;
+		};
+
+		// What gets written into a descriptor, compared and hashed byte for byte so padding is always zeroed
+		union DescriptorInfo
+		{
+			VkDescriptorBufferInfo Buffer;
+			VkDescriptorImageInfo Image;
+		};
+
+		// Written once for its contents, frames with the same contents share it
+		struct CachedSet
+		{
+			VkDescriptorSet DescriptorSet = nullptr;
+			uint64_t Hash = 0;
+			uint64_t LastUsed = 0;
+			std::vector<DescriptorInfo> Infos;
+		};
+		static constexpr uint32_t InvalidCachedSet = UINT32_MAX;
+
+		struct NameHash
+		{
+			using is_transparent = void;
+			size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+		};
+
 		void Init();
+		void SetResource(InputSlot slot, RenderPassResourceType type, Ref<RefCounted> resource, uint32_t index = 0);
+		static void SetImageInfo(DescriptorInfo& info, const VkDescriptorImageInfo& imageInfo);
+		void GatherDescriptorInfos(uint32_t frameIndex);
+		uint32_t AcquireCachedSet(uint32_t setIndex);
+		void UpdateDescriptorSets(uint32_t frameIndex);
 	private:
 		DescriptorSetManagerSpecification m_Specification;
 		VkDescriptorPool m_DescriptorPool = nullptr;
+
+		std::vector<RenderPassInputDeclaration> m_InputDeclarations;
+		std::unordered_map<std::string, InputSlot, NameHash, std::equal_to<>> m_SlotsByName;
+
+		std::vector<Slot> m_Slots;
+		std::vector<SetRange> m_Sets;
+		std::vector<Ref<RefCounted>> m_Resources; // One per descriptor, array elements are consecutive
+
+		// [frame][set index]
+		std::vector<std::vector<VkDescriptorSet>> m_DescriptorSets;
+		std::vector<std::vector<uint32_t>> m_BoundCachedSets;
+		// [set index]
+		std::vector<std::vector<CachedSet>> m_CachedSets;
+		uint64_t m_UpdateCount = 0;
+
+		// Scratch for the update, kept to avoid allocating every frame
+		std::vector<DescriptorInfo> m_CurrentInfos;
+		std::vector<uint8_t> m_InvalidSlots;
+		std::vector<VkWriteDescriptorSet> m_PendingWrites;
 	};
 
 }
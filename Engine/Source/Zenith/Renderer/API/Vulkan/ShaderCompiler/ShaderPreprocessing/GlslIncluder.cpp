@@ -34,68 +34,64 @@ namespace Zenith {
 			ZN_CORE_ERROR("Failed to find included file: {} requested from {}", requestedPath, requestingPath);
 
 			// Return empty result for failed includes
-			auto* const container = new std::array<std::string, 2>;
-			(*container)[0] = requestedPath;
-			(*container)[1] = ""; // Empty content
+			auto* const container = new IncludeResult{ requestedPath };
 
 			auto* const data = new shaderc_include_result;
 			data->user_data = container;
-			data->source_name = (*container)[0].data();
-			data->source_name_length = (*container)[0].size();
-			data->content = (*container)[1].data();
-			data->content_length = (*container)[1].size();
+			data->source_name = container->Name.data();
+			data->source_name_length = container->Name.size();
+			data->content = "";
+			data->content_length = 0;
 
 			return data;
 		}
 
-		auto& [source, sourceHash, stages, isGuarded] = m_HeaderCache[requestedFullPath.string()];
-
-		if (source.empty())
+		std::shared_ptr<const PreprocessedHeader> header = ShaderIncludeCache::Get<ShaderUtils::SourceLang::GLSL>(requestedFullPath);
+		if (!header)
 		{
-			source = Utils::ReadFileAndSkipBOM(requestedFullPath);
-			if (source.empty())
-			{
-				ZN_CORE_ERROR("Failed to load included file: {} in {}.", requestedFullPath.string(), requestingPath);
-			}
-			sourceHash = Hash::GenerateFNVHash(source.c_str());
-
-			// Can clear "source" in case it has already been included in this stage and is guarded.
-			stages = ShaderPreprocessor::PreprocessHeader<ShaderUtils::SourceLang::GLSL>(source, isGuarded, m_ParsedSpecialMacros, m_includeData, requestedFullPath);
+			ZN_CORE_ERROR("Failed to load included file: {} in {}.", requestedFullPath.string(), requestingPath);
+			header = std::make_shared<const PreprocessedHeader>();
 		}
-		else if (isGuarded)
+
+		const bool alreadyIncluded = std::find_if(m_includeData.begin(), m_includeData.end(), [&requestedFullPath](const IncludeData& data)
 		{
-			source.clear();
-		}
+			return data.IncludedFilePath == requestedFullPath;
+		}) != m_includeData.end();
+
+		if (alreadyIncluded && !header->IsGuarded)
+			ZN_CORE_WARN("\"{}\" Header does not contain a header guard (#pragma once).", requestedFullPath.string());
+
+		m_ParsedSpecialMacros.insert(header->SpecialMacros.begin(), header->SpecialMacros.end());
 
 		// Does not emplace if it finds the same include path and same header hash value.
 		m_includeData.emplace(IncludeData{
 			requestedFullPath,
 			includeDepth,
 			type == shaderc_include_type_relative,
-			isGuarded,
-			sourceHash,
-			stages
+			header->IsGuarded,
+			header->SourceHash,
+			header->Stages
 		});
 
-		auto* const container = new std::array<std::string, 2>;
-		(*container)[0] = requestedPath;
-		(*container)[1] = source;
+		// The cached header is handed to the compiler as is, the result keeps it alive until it is released
+		auto* const container = new IncludeResult{ requestedPath, header, alreadyIncluded && header->IsGuarded };
 		auto* const data = new shaderc_include_result;
 
 		data->user_data = container;
 
-		data->source_name = (*container)[0].data();
-		data->source_name_length = (*container)[0].size();
+		data->source_name = container->Name.data();
+		data->source_name_length = container->Name.size();
 
-		data->content = (*container)[1].data();
-		data->content_length = (*container)[1].size();
+		const std::string_view content = container->Skipped ? std::string_view() : std::string_view(header->Source);
+		data->content = content.data();
+		data->content_length = content.size();
 
 		return data;
 	}
 
 	void GlslIncluder::ReleaseInclude(shaderc_include_result* data)
 	{
-		delete static_cast<std::array<std::string, 2>*>(data->user_data);
+		delete static_cast<IncludeResult*>(data->user_data);
 		delete data;
 	}
 
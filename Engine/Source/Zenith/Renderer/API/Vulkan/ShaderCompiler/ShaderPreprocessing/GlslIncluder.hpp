@@ -24,9 +24,15 @@ namespace Zenith {
 		std::unordered_set<std::string>&& GetParsedSpecialMacros() { return std::move(m_ParsedSpecialMacros); }
 
 	private:
+		struct IncludeResult
+		{
+			std::string Name;
+			std::shared_ptr<const PreprocessedHeader> Header;
+			bool Skipped = false; // guarded and already included
+		};
+
 		Utils::IncludePathManager* m_PathManager;
 		std::unordered_set<IncludeData> m_includeData;
 		std::unordered_set<std::string> m_ParsedSpecialMacros;
-		std::unordered_map<std::string, HeaderCache> m_HeaderCache;
 	};
 }
\ No newline at end of file
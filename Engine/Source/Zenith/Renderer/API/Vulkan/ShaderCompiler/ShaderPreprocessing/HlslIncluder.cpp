@@ -3,14 +3,12 @@
 
 #include "ShaderPreprocessor.hpp"
 
-#include "Zenith/Core/Hash.hpp"
-#include "Zenith/Utilities/StringUtils.hpp"
 
 namespace Zenith
 {
 	HRESULT HlslIncluder::LoadSource(LPCWSTR pFilename, IDxcBlob** ppIncludeSource)
 	{
-		static IDxcUtils* pUtils = nullptr;
+		thread_local IDxcUtils* pUtils = nullptr;
 		if (!pUtils)
 		{
 			DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&pUtils));
@@ -19,31 +17,29 @@ namespace Zenith
 		}
 
 		const std::filesystem::path filePath = pFilename;
-		auto& [source, sourceHash, stages, isGuarded] = m_HeaderCache[filePath.string()];
-
-		if(source.empty())
+		// Note(Karim): No error logging because dxc tries multiple include
+		// directories with the same file until it finds it.
+		const std::shared_ptr<const PreprocessedHeader> header = ShaderIncludeCache::Get<ShaderUtils::SourceLang::HLSL>(filePath);
+		if (!header)
 		{
-			source = Utils::ReadFileAndSkipBOM(filePath);
-			if (source.empty())
-			{
-				// Note(Karim): No error logging because dxc tries multiple include
-				// directories with the same file until it finds it.
-				*ppIncludeSource = nullptr;
-				return S_FALSE;
-			}
-
-			sourceHash = Hash::GenerateFNVHash(source.c_str());
-
-			// Can clear "source" in case it has already been included in this stage.
-			stages = ShaderPreprocessor::PreprocessHeader<ShaderUtils::SourceLang::HLSL>(source, isGuarded, m_ParsedSpecialMacros, m_includeData, filePath);
+			*ppIncludeSource = nullptr;
+			return S_FALSE;
 		}
-		else if (isGuarded)
+
+		const bool alreadyIncluded = std::find_if(m_includeData.begin(), m_includeData.end(), [&filePath](const IncludeData& data)
 		{
-			source.clear();
-		}
+			return data.IncludedFilePath == filePath;
+		}) != m_includeData.end();
+
+		if (alreadyIncluded && !header->IsGuarded)
+			ZN_CORE_WARN("\"{}\" Header does not contain a header guard (#pragma once)", filePath.string());
+
+		m_ParsedSpecialMacros.insert(header->SpecialMacros.begin(), header->SpecialMacros.end());
 
 		//TODO: Get real values for IncludeDepth and IsRelative?
-		m_includeData.emplace(IncludeData{ filePath, 0, false, isGuarded, sourceHash, stages });
+		m_includeData.emplace(IncludeData{ filePath, 0, false, header->IsGuarded, header->SourceHash, header->Stages });
+
+		const std::string_view source = alreadyIncluded && header->IsGuarded ? std::string_view() : std::string_view(header->Source);
 
 		IDxcBlobEncoding* pEncoding;
 		pUtils->CreateBlob(source.data(), (uint32_t)source.size(), CP_UTF8, &pEncoding);
@@ -26,10 +26,9 @@ namespace Zenith
 
 	private:
 
-		inline static IDxcIncludeHandler* s_DefaultIncludeHandler = nullptr;
+		inline static thread_local IDxcIncludeHandler* s_DefaultIncludeHandler = nullptr;
 		std::unordered_set<IncludeData> m_includeData;
 		std::unordered_set<std::string> m_ParsedSpecialMacros;
-		std::unordered_map<std::string, HeaderCache> m_HeaderCache;
 	};
 
 }
@@ -1,6 +1,452 @@
 #include "znpch.hpp"
 #include "ShaderPreprocessor.hpp"
 
+#include "Zenith/Core/Hash.hpp"
+#include "Zenith/Renderer/API/Vulkan/VulkanShaderUtils.hpp"
+#include "Zenith/Utilities/StringUtils.hpp"
+
+#include <format>
+#include <mutex>
+
 namespace Zenith {
 
+	namespace Utils {
+
+		static bool IsIdentifierChar(char c)
+		{
+			return std::isalnum((unsigned char)c) || c == '_';
+		}
+
+		// Identifiers, quoted strings and single punctuation characters
+		static std::vector<std::string_view> TokenizeDirective(std::string_view line)
+		{
+			std::vector<std::string_view> tokens;
+			size_t pos = 0;
+			while (pos < line.size())
+			{
+				const char c = line[pos];
+				if (std::isspace((unsigned char)c))
+				{
+					pos++;
+					continue;
+				}
+
+				size_t end = pos + 1;
+				if (IsIdentifierChar(c))
+				{
+					while (end < line.size() && IsIdentifierChar(line[end]))
+						end++;
+				}
+				else if (c == '"')
+				{
+					const size_t closingQuote = line.find('"', end);
+					end = closingQuote == std::string_view::npos ? line.size() : closingQuote + 1;
+				}
+
+				tokens.push_back(line.substr(pos, end - pos));
+				pos = end;
+			}
+			return tokens;
+		}
+
+		// Copies the source without comments, line breaks are kept so that line numbers still match.
+		// Every directive is handed to onDirective(output, line, tokens, lineBegin) once its line is in the output, the views point
+		// into the output so anything kept from them has to be copied before the line is rewritten.
+		template<typename DirectiveFn>
+		static std::string ScanSource(std::string_view source, DirectiveFn&& onDirective)
+		{
+			std::string output;
+			output.reserve(source.size());
+
+			size_t directiveBegin = std::string::npos;
+			bool lineStart = true;
+
+			auto endLine = [&]()
+			{
+				if (directiveBegin != std::string::npos)
+				{
+					const std::string_view line = std::string_view(output).substr(directiveBegin);
+					const std::vector<std::string_view> tokens = TokenizeDirective(line);
+					if (tokens.size() >= 2)
+						onDirective(output, line, tokens, directiveBegin);
+					directiveBegin = std::string::npos;
+				}
+				lineStart = true;
+			};
+
+			size_t pos = 0;
+			while (pos < source.size())
+			{
+				const size_t next = std::min(source.find_first_of("/\n#", pos), source.size());
+				if (next > pos)
+				{
+					const std::string_view text = source.substr(pos, next - pos);
+					output.append(text);
+					if (text.find_first_not_of(" \t\r\f\v") != std::string_view::npos)
+						lineStart = false;
+					pos = next;
+					continue;
+				}
+
+				const char c = source[pos];
+				const char following = pos + 1 < source.size() ? source[pos + 1] : '\0';
+				if (c == '/' && following == '/')
+				{
+					pos = std::min(source.find('\n', pos), source.size());
+				}
+				else if (c == '/' && following == '*')
+				{
+					const size_t commentEnd = source.find("*/", pos + 2);
+					const size_t end = commentEnd == std::string_view::npos ? source.size() : commentEnd + 2;
+					const std::string_view comment = source.substr(pos, end - pos);
+					if (comment.find('\n') == std::string_view::npos)
+						output.push_back(' ');
+
+					for (char commentChar : comment)
+					{
+						if (commentChar == '\n')
+						{
+							endLine();
+							output.push_back('\n');
+						}
+					}
+					pos = end;
+				}
+				else if (c == '\n')
+				{
+					endLine();
+					output.push_back('\n');
+					pos++;
+				}
+				else
+				{
+					if (c == '#' && lineStart)
+						directiveBegin = output.size();
+					lineStart = false;
+					output.push_back(c);
+					pos++;
+				}
+			}
+			endLine();
+
+			return output;
+		}
+
+		// Zenith special macros start with "__ZN_"
+		static void GatherSpecialMacros(const std::vector<std::string_view>& tokens, std::unordered_set<std::string>& specialMacros)
+		{
+			const std::string_view directive = tokens[1];
+			if (directive != "ifdef" && directive != "ifndef" && directive != "if" && directive != "elif" && directive != "define")
+				return;
+
+			for (size_t i = 2; i < tokens.size(); i++)
+			{
+				if (tokens[i].starts_with("__ZN_"))
+					specialMacros.emplace(tokens[i]);
+			}
+		}
+
+		// Macros the shader has variants for. example: #pragma keywords : USE_FOG USE_SHADOWS
+		static bool GatherKeywords(const std::vector<std::string_view>& tokens, std::unordered_set<std::string>& specialMacros)
+		{
+			if (tokens[1] != "pragma" || tokens.size() < 3 || tokens[2] != "keywords")
+				return false;
+
+			ZN_CORE_VERIFY(tokens.size() > 3 && tokens[3] == ":", "Keywords pragma is invalid");
+			for (size_t i = 4; i < tokens.size(); i++)
+				specialMacros.emplace(tokens[i]);
+			return true;
+		}
+
+		static void GatherInclude(std::string_view line, const std::vector<std::string_view>& tokens, std::vector<std::string>& includes)
+		{
+			if (tokens[1] != "include" || tokens.size() < 3)
+				return;
+
+			std::string_view path = line.substr(tokens[2].data() - line.data());
+			path = path.substr(0, path.find_last_not_of(" \t\r") + 1);
+			if (path.size() >= 2 && (path.front() == '"' || path.front() == '<'))
+				path = path.substr(1, path.size() - 2);
+			includes.emplace_back(path);
+		}
+
+		// Stage name of "#pragma stage : vert", empty for any other directive
+		static std::string_view GetStagePragma(const std::vector<std::string_view>& tokens)
+		{
+			if (tokens[1] != "pragma" || tokens.size() < 3 || tokens[2] != "stage")
+				return {};
+
+			ZN_CORE_VERIFY(tokens.size() > 4 && tokens[3] == ":", "Stage pragma is invalid");
+			const std::string_view stage = tokens[4];
+			ZN_CORE_VERIFY(stage == "vert" || stage == "frag" || stage == "comp", "Invalid shader type specified");
+			return stage;
+		}
+
+	}
+
+	template<ShaderUtils::SourceLang Lang>
+	PreprocessedHeader ShaderPreprocessor::PreprocessHeader(std::string_view contents)
+	{
+		PreprocessedHeader header;
+		header.SourceHash = Hash::GenerateFNVHash(contents);
+
+		uint32_t stageCount = 0;
+		header.Source = Utils::ScanSource(contents, [&](std::string& output, std::string_view line, const std::vector<std::string_view>& tokens, size_t lineBegin)
+		{
+			Utils::GatherSpecialMacros(tokens, header.SpecialMacros);
+			Utils::GatherInclude(line, tokens, header.Includes);
+			if (Utils::GatherKeywords(tokens, header.SpecialMacros))
+				return;
+
+			if (tokens[1] == "pragma" && tokens.size() >= 3 && tokens[2] == "once")
+			{
+				header.IsGuarded = true;
+
+				// Removes header guard in GLSL only
+				if constexpr (Lang == ShaderUtils::SourceLang::GLSL)
+					output.resize(lineBegin);
+				return;
+			}
+
+			const std::string_view stage = Utils::GetStagePragma(tokens);
+			if (stage.empty())
+				return;
+
+			*(int*)&header.Stages |= (int)ShaderUtils::StageToVKShaderStage(stage);
+
+			// Stage macro instead of the stage pragma, closing the previous stage on the same line
+			const std::string_view stageMacro = ShaderUtils::StageToShaderMacro(stage);
+			output.resize(lineBegin);
+			output.append(stageCount == 0 ? std::format("#ifdef {}", stageMacro) : std::format("#endif\n#ifdef {}", stageMacro));
+			stageCount++;
+		});
+
+		if (stageCount)
+			header.Source.append("\n#endif");
+
+		return header;
+	}
+
+	template<ShaderUtils::SourceLang Lang>
+	std::map<VkShaderStageFlagBits, std::string> ShaderPreprocessor::PreprocessShader(std::string_view source, std::unordered_set<std::string>& specialMacros, std::vector<std::string>* includes)
+	{
+		std::vector<std::pair<VkShaderStageFlagBits, size_t>> stagePositions;
+		std::vector<std::string> includePaths;
+		size_t startOfStage = 0;
+		bool firstDirective = true;
+
+		const std::string newSource = Utils::ScanSource(source, [&](std::string& output, std::string_view line, const std::vector<std::string_view>& tokens, size_t lineBegin)
+		{
+			if constexpr (Lang == ShaderUtils::SourceLang::GLSL)
+			{
+				ZN_CORE_VERIFY(!firstDirective || (tokens.size() >= 3 && tokens[1] == "version"), "Invalid #version encountered or #version is NOT encounted first.");
+				if (tokens[1] == "version")
+					startOfStage = lineBegin;
+			}
+			firstDirective = false;
+
+			Utils::GatherSpecialMacros(tokens, specialMacros);
+			Utils::GatherInclude(line, tokens, includePaths);
+			if (Utils::GatherKeywords(tokens, specialMacros))
+				return;
+
+			const std::string_view stage = Utils::GetStagePragma(tokens);
+			if (!stage.empty())
+				stagePositions.emplace_back(ShaderUtils::ShaderTypeFromString(stage), startOfStage);
+		});
+		ZN_CORE_ASSERT(newSource.size(), "Shader is empty!");
+
+		if (includes)
+			*includes = std::move(includePaths);
+
+		std::map<VkShaderStageFlagBits, std::string> shaderSources;
+		ZN_CORE_VERIFY(stagePositions.size(), "Could not pre-process shader! There are no known stages defined in file.");
+		const std::string_view sourceView = newSource;
+		auto& [firstStage, firstStagePos] = stagePositions[0];
+		if (stagePositions.size() > 1)
+		{
+			//Get first stage
+			const std::string_view firstStageStr = sourceView.substr(0, stagePositions[1].second);
+			size_t lineCount = std::count(firstStageStr.begin(), firstStageStr.end(), '\n') + 1;
+			shaderSources[firstStage] = firstStageStr;
+
+			// Every later stage starts with its #version line, #line keeps the line numbers of errors pointing into the file
+			auto addStage = [&](VkShaderStageFlagBits stage, std::string_view stageStr, size_t line)
+			{
+				const size_t secondLinePos = stageStr.find_first_of('\n', 1) + 1;
+				std::string& stageSource = shaderSources[stage];
+				stageSource.reserve(stageStr.size() + 16);
+				stageSource.append(stageStr.substr(0, secondLinePos));
+				stageSource.append(std::format("#line {}\n", line));
+				stageSource.append(stageStr.substr(secondLinePos));
+				return std::count(stageSource.begin(), stageSource.end(), '\n') + 1;
+			};
+
+			//Get stages in the middle
+			for (size_t i = 1; i < stagePositions.size() - 1; ++i)
+			{
+				auto& [stage, stagePos] = stagePositions[i];
+				lineCount += addStage(stage, sourceView.substr(stagePos, stagePositions[i + 1].second - stagePos), lineCount);
+			}
+
+			//Get last stage
+			auto& [stage, stagePos] = stagePositions[stagePositions.size() - 1];
+			addStage(stage, sourceView.substr(stagePos), lineCount + 1);
+		}
+		else
+		{
+			shaderSources[firstStage] = newSource;
+		}
+
+		return shaderSources;
+	}
+
+	template PreprocessedHeader ShaderPreprocessor::PreprocessHeader<ShaderUtils::SourceLang::GLSL>(std::string_view);
+	template PreprocessedHeader ShaderPreprocessor::PreprocessHeader<ShaderUtils::SourceLang::HLSL>(std::string_view);
+	template std::map<VkShaderStageFlagBits, std::string> ShaderPreprocessor::PreprocessShader<ShaderUtils::SourceLang::GLSL>(std::string_view, std::unordered_set<std::string>&, std::vector<std::string>*);
+	template std::map<VkShaderStageFlagBits, std::string> ShaderPreprocessor::PreprocessShader<ShaderUtils::SourceLang::HLSL>(std::string_view, std::unordered_set<std::string>&, std::vector<std::string>*);
+
+	//////////////////////////////////////////////////////////////////////////////////////////////////
+	// ShaderIncludeCache
+	//////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct CachedInclude
+	{
+		std::filesystem::file_time_type WriteTime;
+		uintmax_t FileSize = 0;
+		std::shared_ptr<const PreprocessedHeader> Header;
+	};
+
+	struct IncludeCacheData
+	{
+		std::unordered_map<std::string, CachedInclude> Headers; // language and path -> header
+		std::mutex Mutex;
+	};
+	static IncludeCacheData s_IncludeCache;
+
+	template<ShaderUtils::SourceLang Lang>
+	std::shared_ptr<const PreprocessedHeader> ShaderIncludeCache::Get(const std::filesystem::path& filepath)
+	{
+		std::error_code error;
+		const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(filepath, error);
+		if (error)
+			return nullptr;
+		const uintmax_t fileSize = std::filesystem::file_size(filepath, error);
+		if (error)
+			return nullptr;
+
+		const std::string key = std::format("{}:{}", (int)Lang, filepath.lexically_normal().generic_string());
+		{
+			std::scoped_lock lock(s_IncludeCache.Mutex);
+			auto it = s_IncludeCache.Headers.find(key);
+			if (it != s_IncludeCache.Headers.end() && it->second.WriteTime == writeTime && it->second.FileSize == fileSize)
+				return it->second.Header;
+		}
+
+		// Read outside the lock, two threads missing the same header both preprocess it and the last one is kept
+		const std::string source = Utils::ReadFileAndSkipBOM(filepath);
+		if (source.empty())
+			return nullptr;
+
+		auto header = std::make_shared<const PreprocessedHeader>(ShaderPreprocessor::PreprocessHeader<Lang>(source));
+
+		std::scoped_lock lock(s_IncludeCache.Mutex);
+		s_IncludeCache.Headers[key] = { writeTime, fileSize, header };
+		return header;
+	}
+
+	template std::shared_ptr<const PreprocessedHeader> ShaderIncludeCache::Get<ShaderUtils::SourceLang::GLSL>(const std::filesystem::path&);
+	template std::shared_ptr<const PreprocessedHeader> ShaderIncludeCache::Get<ShaderUtils::SourceLang::HLSL>(const std::filesystem::path&);
+
+	void ShaderIncludeCache::Clear()
+	{
+		std::scoped_lock lock(s_IncludeCache.Mutex);
+		s_IncludeCache.Headers.clear();
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////////////////////
+	// ShaderDependencyGraph
+	//////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct DependencyGraphData
+	{
+		std::unordered_map<std::string, std::unordered_set<std::string>> Includes;   // shader -> headers
+		std::unordered_map<std::string, std::unordered_set<std::string>> Dependents; // header -> shaders
+		std::mutex Mutex;
+	};
+	static DependencyGraphData s_DependencyGraph;
+
+	// Include paths are relative to the working directory or the including file, file watchers usually report absolute ones
+	static std::string GetDependencyKey(const std::filesystem::path& filepath)
+	{
+		std::error_code error;
+		const std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(filepath, error);
+		return (error ? filepath.lexically_normal() : canonicalPath).generic_string();
+	}
+
+	static void RemoveShaderLocked(const std::string& shader)
+	{
+		auto it = s_DependencyGraph.Includes.find(shader);
+		if (it == s_DependencyGraph.Includes.end())
+			return;
+
+		for (const std::string& header : it->second)
+		{
+			auto dependents = s_DependencyGraph.Dependents.find(header);
+			dependents->second.erase(shader);
+			if (dependents->second.empty())
+				s_DependencyGraph.Dependents.erase(dependents);
+		}
+		s_DependencyGraph.Includes.erase(it);
+	}
+
+	void ShaderDependencyGraph::SetIncludes(const std::filesystem::path& shaderPath, const std::set<std::filesystem::path>& includes)
+	{
+		const std::string shader = GetDependencyKey(shaderPath);
+		std::unordered_set<std::string> headers;
+		for (const std::filesystem::path& include : includes)
+			headers.insert(GetDependencyKey(include));
+
+		std::scoped_lock lock(s_DependencyGraph.Mutex);
+		RemoveShaderLocked(shader);
+		for (const std::string& header : headers)
+			s_DependencyGraph.Dependents[header].insert(shader);
+		s_DependencyGraph.Includes[shader] = std::move(headers);
+	}
+
+	void ShaderDependencyGraph::Remove(const std::filesystem::path& shaderPath)
+	{
+		const std::string shader = GetDependencyKey(shaderPath);
+
+		std::scoped_lock lock(s_DependencyGraph.Mutex);
+		RemoveShaderLocked(shader);
+	}
+
+	std::vector<std::filesystem::path> ShaderDependencyGraph::GetIncludes(const std::filesystem::path& shaderPath)
+	{
+		const std::string shader = GetDependencyKey(shaderPath);
+
+		std::scoped_lock lock(s_DependencyGraph.Mutex);
+		auto it = s_DependencyGraph.Includes.find(shader);
+		if (it == s_DependencyGraph.Includes.end())
+			return {};
+
+		return { it->second.begin(), it->second.end() };
+	}
+
+	std::vector<std::filesystem::path> ShaderDependencyGraph::GetDependentShaders(const std::filesystem::path& filepath)
+	{
+		const std::string key = GetDependencyKey(filepath);
+
+		std::scoped_lock lock(s_DependencyGraph.Mutex);
+		std::vector<std::filesystem::path> shaders;
+		if (s_DependencyGraph.Includes.contains(key))
+			shaders.emplace_back(key);
+
+		auto it = s_DependencyGraph.Dependents.find(key);
+		if (it != s_DependencyGraph.Dependents.end())
+			shaders.insert(shaders.end(), it->second.begin(), it->second.end());
+		return shaders;
+	}
+
 }
@@ -1,168 +1,179 @@
 #include "znpch.hpp"
 #include "VulkanShaderCache.hpp"
 #include "Zenith/Core/Hash.hpp"
-#include "Zenith/Renderer/API/Vulkan/VulkanShaderUtils.hpp"
+#include "Zenith/Serialization/FileStream.hpp"
+#include "Zenith/Utilities/FileSystem.hpp"
+#include "Zenith/Utilities/MappedFile.hpp"
 
-#include <nlohmann/json.hpp>
-#include "Zenith/Utilities/SerializationMacros.hpp"
-
-#include "ShaderPreprocessing/ShaderPreprocessor.hpp"
+#include <mutex>
 
 namespace Zenith {
 
 	static const char* s_ShaderRegistryPath = "Resources/Cache/Shader/ShaderRegistry.cache";
 
-	VkShaderStageFlagBits VulkanShaderCache::HasChanged(Ref<VulkanShaderCompiler> shader)
+	namespace ShaderRegistryFile {
+
+		struct FileHeader
+		{
+			char HEADER[4] = { 'Z','N','S','C' };
+			uint32_t Version = 1;
+			uint32_t EntryCount = 0;
+		};
+
+		struct Entry
+		{
+			uint64_t ShaderKey = 0;
+			uint32_t Stage = 0;
+			uint32_t Padding = 0;
+			SHA256Hash::HashValue StageHash{};
+		};
+
+	}
+
+	struct ShaderRegistry
+	{
+		std::unordered_map<uint64_t, std::map<VkShaderStageFlagBits, StageData>> Shaders; // shader key -> stage -> data
+		bool Loaded = false;
+		bool Dirty = false;
+		std::mutex Mutex; // shaders are compiled in parallel and all of them use the registry
+	};
+	static ShaderRegistry s_ShaderRegistry;
+
+	// Every variant of a shader has its own entries
+	static uint64_t GetShaderKey(const Ref<VulkanShaderCompiler>& shader)
 	{
-		std::map<std::string, std::map<VkShaderStageFlagBits, StageData>> shaderCache;
+		return XXHash64::compute(shader->m_ShaderSourcePath.generic_string(), shader->m_VariantKey);
+	}
 
-		Deserialize(shaderCache);
+	VkShaderStageFlagBits VulkanShaderCache::HasChanged(Ref<VulkanShaderCompiler> shader)
+	{
+		std::scoped_lock lock(s_ShaderRegistry.Mutex);
+		Load();
 
 		VkShaderStageFlagBits changedStages = {};
-		const bool shaderNotCached = shaderCache.find(shader->m_ShaderSourcePath.string()) == shaderCache.end();
-
+		auto it = s_ShaderRegistry.Shaders.find(GetShaderKey(shader));
 		for (const auto& [stage, stageSource] : shader->m_ShaderSource)
 		{
-			// Keep in mind that we're using the [] operator.
-			// Which means that we add the stage if it's not already there.
-			if (shaderNotCached || shader->m_StagesMetadata.at(stage) != shaderCache[shader->m_ShaderSourcePath.string()][stage])
-			{
-				shaderCache[shader->m_ShaderSourcePath.string()][stage] = shader->m_StagesMetadata.at(stage);
+			if (it == s_ShaderRegistry.Shaders.end() || !it->second.contains(stage) || it->second.at(stage) != shader->m_StagesMetadata.at(stage))
 				*(int*)&changedStages |= stage;
-			}
 		}
 
-		// Update cache in case we added a stage but didn't remove the deleted(in file) stages
-		shaderCache.at(shader->m_ShaderSourcePath.string()) = shader->m_StagesMetadata;
+		return changedStages;
+	}
+
+	void VulkanShaderCache::Update(Ref<VulkanShaderCompiler> shader)
+	{
+		std::scoped_lock lock(s_ShaderRegistry.Mutex);
+		Load();
 
-		if (changedStages)
+		// Replaced as a whole, stages deleted from the file go with it
+		auto& stages = s_ShaderRegistry.Shaders[GetShaderKey(shader)];
+		if (stages != shader->m_StagesMetadata)
 		{
-			Serialize(shaderCache);
+			stages = shader->m_StagesMetadata;
+			s_ShaderRegistry.Dirty = true;
 		}
-
-		return changedStages;
 	}
 
-	void VulkanShaderCache::Serialize(const std::map<std::string, std::map<VkShaderStageFlagBits, StageData>>& shaderCache)
+	void VulkanShaderCache::Flush()
 	{
-		nlohmann::json json;
-		auto& shaderRegistry = json["ShaderRegistry"] = nlohmann::json::array();
+		std::scoped_lock lock(s_ShaderRegistry.Mutex);
+		if (!s_ShaderRegistry.Dirty)
+			return;
 
-		for (const auto& [filepath, shader] : shaderCache)
+		const std::filesystem::path path = s_ShaderRegistryPath;
+		const std::filesystem::path tempPath = path.string() + ".tmp";
 		{
-			nlohmann::json shaderData;
-			shaderData["ShaderPath"] = filepath;
+			FileStreamWriter serializer(tempPath);
+			if (!serializer)
+			{
+				ZN_CORE_ERROR_TAG("Renderer", "Failed to write shader registry {}", tempPath.string());
+				return;
+			}
 
-			auto& stages = shaderData["Stages"] = nlohmann::json::array();
+			ShaderRegistryFile::FileHeader header;
+			for (const auto& [shaderKey, stages] : s_ShaderRegistry.Shaders)
+				header.EntryCount += (uint32_t)stages.size();
+			serializer.WriteRaw(header);
 
-			for (const auto& [stage, stageData] : shader)
+			for (const auto& [shaderKey, stages] : s_ShaderRegistry.Shaders)
 			{
-				nlohmann::json stageObj;
-				stageObj["Stage"] = ShaderUtils::ShaderStageToString(stage);
-				stageObj["StageHash"] = stageData.HashValue;
-
-				auto& headers = stageObj["Headers"] = nlohmann::json::array();
-				for (const auto& header : stageData.Headers)
+				for (const auto& [stage, stageData] : stages)
 				{
-					nlohmann::json headerObj;
-					headerObj["HeaderPath"] = header.IncludedFilePath.string();
-					headerObj["IncludeDepth"] = header.IncludeDepth;
-					headerObj["IsRelative"] = header.IsRelative;
-					headerObj["IsGaurded"] = header.IsGuarded;
-					headerObj["HashValue"] = header.HashValue;
-
-					headers.push_back(headerObj);
+					ShaderRegistryFile::Entry entry;
+					entry.ShaderKey = shaderKey;
+					entry.Stage = (uint32_t)stage;
+					entry.StageHash = stageData.Hash;
+					serializer.WriteRaw(entry);
 				}
+			}
 
-				stages.push_back(stageObj);
+			if (!serializer.IsStreamGood())
+			{
+				ZN_CORE_ERROR_TAG("Renderer", "Failed to write shader registry {}", tempPath.string());
+				return;
 			}
+		}
+
+		if (!FileSystem::FlushToDisk(tempPath))
+		{
+			ZN_CORE_ERROR_TAG("Renderer", "Failed to flush {} to disk", tempPath.string());
+			return;
+		}
 
-			shaderRegistry.push_back(shaderData);
+		// Readers either see the old or the new registry
+		std::error_code error;
+		std::filesystem::rename(tempPath, path, error);
+		if (error)
+		{
+			ZN_CORE_ERROR_TAG("Renderer", "Failed to replace shader registry {}: {}", path.string(), error.message());
+			return;
 		}
 
-		std::ofstream fout(s_ShaderRegistryPath);
-		fout << json.dump(4); // Pretty print with 4 space indentation
+		if (!FileSystem::FlushToDisk(path.parent_path()))
+			ZN_CORE_WARN_TAG("Renderer", "Failed to flush the directory of {} to disk", path.string());
+
+		s_ShaderRegistry.Dirty = false;
 	}
 
-	void VulkanShaderCache::Deserialize(std::map<std::string, std::map<VkShaderStageFlagBits, StageData>>& shaderCache)
+	void VulkanShaderCache::Load()
 	{
-		// Read registry
-		std::ifstream stream(s_ShaderRegistryPath);
-		if (!stream.good())
+		if (s_ShaderRegistry.Loaded)
 			return;
 
-		try
-		{
-			nlohmann::json json;
-			stream >> json;
-
-			if (!json.contains("ShaderRegistry"))
-			{
-				ZN_CORE_ERROR("[ShaderCache] Shader Registry is invalid - missing 'ShaderRegistry' key.");
-				return;
-			}
-
-			const auto& shaderRegistry = json["ShaderRegistry"];
-			if (!shaderRegistry.is_array())
-			{
-				ZN_CORE_ERROR("[ShaderCache] Invalid Shader Registry format - 'ShaderRegistry' should be an array.");
-				return;
-			}
+		s_ShaderRegistry.Loaded = true;
+		if (!std::filesystem::exists(s_ShaderRegistryPath))
+			return;
 
-			for (const auto& shader : shaderRegistry)
-			{
-				if (!shader.contains("ShaderPath") || !shader.contains("Stages"))
-				{
-					ZN_CORE_WARN("[ShaderCache] Skipping invalid shader entry - missing required fields.");
-					continue;
-				}
+		// The mapping is closed again right away, Flush must be able to replace the file
+		MappedFile file(s_ShaderRegistryPath);
+		if (!file.IsOpen())
+			return;
 
-				const std::string path = shader["ShaderPath"];
-				const auto& stages = shader["Stages"];
+		const byte* data = file.GetData();
+		const uint64_t size = file.GetSize();
 
-				if (!stages.is_array())
-				{
-					ZN_CORE_WARN("[ShaderCache] Skipping shader '{}' - invalid stages format.", path);
-					continue;
-				}
+		ShaderRegistryFile::FileHeader header;
+		ShaderRegistryFile::FileHeader expected;
+		if (size >= sizeof(header))
+			memcpy(&header, data, sizeof(header));
 
-				for (const auto& stage : stages)
-				{
-					if (!stage.contains("Stage") || !stage.contains("StageHash"))
-					{
-						ZN_CORE_WARN("[ShaderCache] Skipping invalid stage in shader '{}'.", path);
-						continue;
-					}
-
-					const std::string stageType = stage["Stage"];
-					const uint32_t stageHash = stage["StageHash"];
-
-					auto& stageCache = shaderCache[path][ShaderUtils::ShaderTypeFromString(stageType)];
-					stageCache.HashValue = stageHash;
-
-					if (stage.contains("Headers") && stage["Headers"].is_array())
-					{
-						for (const auto& header : stage["Headers"])
-						{
-							if (!header.contains("HeaderPath"))
-								continue;
-
-							const std::string headerPath = header["HeaderPath"];
-							const uint32_t includeDepth = header.value("IncludeDepth", 0u);
-							const bool isRelative = header.value("IsRelative", false);
-							const bool isGuarded = header.value("IsGaurded", false);
-							const uint32_t hashValue = header.value("HashValue", 0u);
-
-							stageCache.Headers.emplace(IncludeData{ headerPath, includeDepth, isRelative, isGuarded, hashValue });
-						}
-					}
-				}
-			}
+		const uint64_t entriesSize = uint64_t(header.EntryCount) * sizeof(ShaderRegistryFile::Entry);
+		if (size < sizeof(header) || memcmp(header.HEADER, expected.HEADER, sizeof(expected.HEADER)) != 0 || header.Version != expected.Version
+			|| sizeof(header) + entriesSize > size)
+		{
+			// Older registries were JSON, every shader is compiled once more then
+			ZN_CORE_WARN_TAG("Renderer", "Shader registry {} is invalid or outdated, it will be rebuilt", s_ShaderRegistryPath);
+			return;
 		}
-		catch (const nlohmann::json::exception& e)
+
+		const byte* entries = data + sizeof(header);
+		for (uint32_t i = 0; i < header.EntryCount; i++)
 		{
-			ZN_CORE_ERROR("[ShaderCache] Failed to parse JSON: {}", e.what());
+			ShaderRegistryFile::Entry entry;
+			memcpy(&entry, entries + uint64_t(i) * sizeof(entry), sizeof(entry));
+			s_ShaderRegistry.Shaders[entry.ShaderKey][(VkShaderStageFlagBits)entry.Stage].Hash = entry.StageHash;
 		}
 	}
 
-}
\ No newline at end of file
+}
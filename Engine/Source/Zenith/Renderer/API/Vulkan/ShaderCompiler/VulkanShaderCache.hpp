@@ -7,13 +7,20 @@
 
 namespace Zenith {
 
+	// Registry of the stage hashes the cached binaries were compiled from.
+	// It is read once per session, kept in memory and written back by Flush.
 	class VulkanShaderCache
 	{
 	public:
+		// Stages whose hash differs from the one their cached binaries were compiled from
 		static VkShaderStageFlagBits HasChanged(Ref<VulkanShaderCompiler> shader);
+		// After all stages of the shader compiled, so a failed compile is retried next time
+		static void Update(Ref<VulkanShaderCompiler> shader);
+
+		// Writes the registry if it changed. The file is replaced as a whole, it is never left half written.
+		static void Flush();
 	private:
-		static void Serialize(const std::map<std::string, std::map<VkShaderStageFlagBits, StageData>>& shaderCache);
-		static void Deserialize(std::map<std::string, std::map<VkShaderStageFlagBits, StageData>>& shaderCache);
+		static void Load();
 	};
 
 }
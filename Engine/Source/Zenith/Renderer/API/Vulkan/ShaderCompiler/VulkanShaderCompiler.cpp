@@ -8,6 +8,9 @@
 #include "ShaderPreprocessing/IncludePathManager.hpp"
 
 #include "Zenith/Core/Hash.hpp"
+#include "Zenith/Core/Thread.hpp"
+#include "Zenith/Debug/Profiler.hpp"
+#include "Zenith/Renderer/API/Vulkan/VulkanBindlessDescriptors.hpp"
 #include "Zenith/Renderer/API/Vulkan/VulkanContext.hpp"
 #include "Zenith/Renderer/API/Vulkan/VulkanShader.hpp"
 #include "Zenith/Serialization/FileStream.hpp"
@@ -19,9 +22,12 @@
 #include <spirv_reflect.h>
 #include <spirv-tools/libspirv.h>
 
+#include <condition_variable>
 #include <filesystem>
 #include <cstdlib>
 #include <format>
+#include <mutex>
+#include <queue>
 
 #if defined(ZN_PLATFORM_LINUX)
 #include <spawn.h>
@@ -35,6 +41,25 @@ namespace Zenith {
 	static std::unordered_map<uint32_t, std::unordered_map<uint32_t, ShaderResource::UniformBuffer>> s_UniformBuffers; // set -> binding point -> buffer
 	static std::unordered_map<uint32_t, std::unordered_map<uint32_t, ShaderResource::StorageBuffer>> s_StorageBuffers; // set -> binding point -> buffer
 
+	struct VariantCompileRequest
+	{
+		Ref<VulkanShader> Shader;
+		Ref<VulkanShaderCompiler> Compiler;
+		uint64_t VariantKey = 0;
+		bool Succeeded = false;
+	};
+
+	struct VariantCompilationData
+	{
+		std::queue<VariantCompileRequest> Queue;
+		std::vector<VariantCompileRequest> Finished;
+		std::mutex Mutex;
+		std::condition_variable CV;
+		bool Running = true;
+		Thread CompileThread = Thread("Shader Variant Compile");
+	};
+	static VariantCompilationData* s_VariantCompilation = nullptr;
+
 	namespace Utils {
 
 		static const char* GetCacheDirectory()
@@ -50,6 +75,57 @@ namespace Zenith {
 				std::filesystem::create_directories(cacheDirectory);
 		}
 
+		// Per thread, shaders and stages are compiled on several threads at once. ParallelFor starts new threads for
+		// every batch, so the instances are released when their thread exits.
+		struct DxcInstances
+		{
+			IDxcCompiler3* Compiler = nullptr;
+			IDxcUtils* Utils = nullptr;
+
+			~DxcInstances()
+			{
+				if (Compiler)
+					Compiler->Release();
+				if (Utils)
+					Utils->Release();
+			}
+		};
+		static thread_local DxcInstances s_DxcInstances;
+
+		static void CreateDxcInstancesIfNeeded()
+		{
+			if (!s_DxcInstances.Compiler)
+			{
+#ifdef ZN_PLATFORM_WINDOWS
+				DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&s_DxcInstances.Compiler));
+				DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&s_DxcInstances.Utils));
+#endif
+			}
+		}
+
+		// Bump when the compile options in VulkanShaderCompiler::Compile change, so cached binaries are rebuilt
+		static constexpr uint32_t CompileOptionsVersion = 1;
+
+		static SHA256Hash::HashValue GetStageHash(VkShaderStageFlagBits stage, const std::string& source, const ShaderMacros& macros, ShaderUtils::SourceLang language, bool disableOptimization)
+		{
+			SHA256Hash hash;
+			hash.update(source);
+			for (const auto& [name, value] : macros)
+				hash.update(std::format("\n#{}={}", name, value));
+
+			hash.update(std::format("\n{}:{}:{}:{}", (uint32_t)stage, (uint32_t)language, disableOptimization, CompileOptionsVersion));
+			return hash.finalize();
+		}
+
+		static std::string GetShaderName(const std::filesystem::path& shaderSourcePath)
+		{
+			std::string path = shaderSourcePath.string();
+			size_t found = path.find_last_of("/\\");
+			std::string name = found != std::string::npos ? path.substr(found + 1) : path;
+			found = name.find_last_of('.');
+			return found != std::string::npos ? name.substr(0, found) : name;
+		}
+
 		static ShaderUniformType SPIRVReflectTypeToShaderUniformType(const SpvReflectTypeDescription& type)
 		{
 			if (type.type_flags & SPV_REFLECT_TYPE_FLAG_BOOL)
@@ -85,44 +161,157 @@ namespace Zenith {
 			ZN_CORE_ASSERT(false, "Unknown SPIRV-Reflect type!");
 			return ShaderUniformType::None;
 		}
+
+		// The element struct of the bindless material array is what materials write, its members are exposed as MaterialUniformBuffer
+		static void ReflectBindlessMaterial(const SpvReflectDescriptorBinding& binding, VulkanShader::ReflectionData& reflectionData)
+		{
+			if (binding.block.member_count == 0)
+				return;
+
+			const SpvReflectBlockVariable& materials = binding.block.members[0];
+			if (materials.array.stride != VulkanBindlessDescriptors::MaterialStride)
+			{
+				ZN_CORE_ERROR_TAG("Renderer", "Bindless material struct is {} bytes, it has to be padded to {}", materials.array.stride, VulkanBindlessDescriptors::MaterialStride);
+				return;
+			}
+
+			ShaderBuffer& buffer = reflectionData.ConstantBuffers["MaterialUniformBuffer"];
+			buffer.Name = "MaterialUniformBuffer";
+			buffer.Size = materials.array.stride;
+
+			for (uint32_t i = 0; i < materials.member_count; i++)
+			{
+				const SpvReflectBlockVariable& member = materials.members[i];
+				if (member.type_description->type_flags & SPV_REFLECT_TYPE_FLAG_STRUCT)
+					continue;
+
+				buffer.Uniforms[member.name] = ShaderUniform(member.name, SPIRVReflectTypeToShaderUniformType(*member.type_description), member.size, member.offset);
+			}
+		}
 	}
 
-	VulkanShaderCompiler::VulkanShaderCompiler(const std::filesystem::path& shaderSourcePath, bool disableOptimization)
+	VulkanShaderCompiler::VulkanShaderCompiler(const std::filesystem::path& shaderSourcePath, bool disableOptimization, const ShaderMacros& variantMacros)
 		: m_ShaderSourcePath(shaderSourcePath), m_DisableOptimization(disableOptimization)
 	{
 		m_Language = ShaderUtils::ShaderLangFromExtension(shaderSourcePath.extension().string());
+
+		const auto& globalMacros = Renderer::GetGlobalShaderMacros();
+		m_Macros = ShaderMacros(globalMacros.begin(), globalMacros.end());
+		for (const auto& [name, value] : variantMacros)
+			m_Macros[name] = value;
+
+		m_VariantKey = Shader::GetVariantKey(variantMacros);
+		m_CacheName = m_ShaderSourcePath.filename().string();
+		if (m_VariantKey)
+			m_CacheName += std::format(".{:016x}", m_VariantKey);
 	}
 
 	bool VulkanShaderCompiler::Reload(bool forceCompile)
+	{
+		const bool compileSucceeded = CompileBinaries({ this }, forceCompile)[0];
+		if (!compileSucceeded)
+		{
+			ZN_CORE_ASSERT(false);
+			return false;
+		}
+
+		ReflectIfChanged(forceCompile);
+		return true;
+	}
+
+	void VulkanShaderCompiler::LoadSource()
 	{
 		m_ShaderSource.clear();
 		m_StagesMetadata.clear();
 		m_SPIRVDebugData.clear();
 		m_SPIRVData.clear();
+		m_Includes.clear();
 
-		Utils::CreateCacheDirectoryIfNeeded();
 		const std::string source = Utils::ReadFileAndSkipBOM(m_ShaderSourcePath);
 		ZN_CORE_VERIFY(source.size(), "Failed to load shader!");
 
 		ZN_CORE_TRACE_TAG("Renderer", "Compiling shader: {}", m_ShaderSourcePath.string());
 		m_ShaderSource = PreProcess(source);
-		const VkShaderStageFlagBits changedStages = VulkanShaderCache::HasChanged(this);
+		ShaderDependencyGraph::SetIncludes(m_ShaderSourcePath, m_Includes);
+		for (const auto& [stage, stageSource] : m_ShaderSource)
+			m_StagesMetadata[stage].Hash = Utils::GetStageHash(stage, stageSource, m_Macros, m_Language, m_DisableOptimization);
+		m_ChangedStages = VulkanShaderCache::HasChanged(this);
 
-		bool compileSucceeded = CompileOrGetVulkanBinaries(m_SPIRVDebugData, m_SPIRVData, changedStages, forceCompile);
-		if (!compileSucceeded)
+		// The stage jobs only write into these, so the maps must not change while they run
+		for (const auto& [stage, stageSource] : m_ShaderSource)
 		{
-			ZN_CORE_ASSERT(false);
-			return false;
+			m_SPIRVDebugData[stage];
+			m_SPIRVData[stage];
 		}
+	}
 
+	void VulkanShaderCompiler::ReflectIfChanged(bool forceCompile)
+	{
 		// Reflection using spirv-reflect
-		if (forceCompile || changedStages || !TryReadCachedReflectionData())
+		if (forceCompile || m_ChangedStages || !TryReadCachedReflectionData())
 		{
 			ReflectAllShaderStages(m_SPIRVDebugData);
 			SerializeReflectionData();
 		}
+	}
 
-		return true;
+	std::vector<bool> VulkanShaderCompiler::CompileBinaries(const std::vector<Ref<VulkanShaderCompiler>>& compilers, bool forceCompile)
+	{
+		ZN_PROFILE_FUNC();
+
+		Utils::CreateCacheDirectoryIfNeeded();
+		ParallelFor("Shader Compile", compilers.size(), 1, [&](size_t i)
+		{
+			Ref<VulkanShaderCompiler> compiler = compilers[i];
+			compiler->LoadSource();
+		});
+
+		struct StageJob
+		{
+			size_t CompilerIndex = 0;
+			VkShaderStageFlagBits Stage = {};
+			bool Debug = false;
+			std::string Error;
+		};
+
+		// Debug binaries are reflected, release binaries are what the pipelines use
+		std::vector<StageJob> jobs;
+		for (size_t i = 0; i < compilers.size(); i++)
+		{
+			for (const auto& [stage, source] : compilers[i]->m_ShaderSource)
+			{
+				jobs.push_back({ i, stage, true });
+				jobs.push_back({ i, stage, false });
+			}
+		}
+
+		ParallelFor("Shader Compile", jobs.size(), 1, [&](size_t i)
+		{
+			StageJob& job = jobs[i];
+			Ref<VulkanShaderCompiler> compiler = compilers[job.CompilerIndex];
+			auto& binaries = job.Debug ? compiler->m_SPIRVDebugData : compiler->m_SPIRVData;
+			job.Error = compiler->CompileOrGetVulkanBinary(job.Stage, binaries.at(job.Stage), job.Debug, compiler->m_ChangedStages, forceCompile);
+		});
+
+		// Only the first error of a shader, the same source usually fails its debug and release build alike
+		std::vector<bool> succeeded(compilers.size(), true);
+		for (const StageJob& job : jobs)
+		{
+			if (job.Error.empty() || !succeeded[job.CompilerIndex])
+				continue;
+
+			ZN_CORE_ERROR_TAG("Renderer", "{}", job.Error);
+			succeeded[job.CompilerIndex] = false;
+		}
+
+		for (size_t i = 0; i < compilers.size(); i++)
+		{
+			if (succeeded[i])
+				VulkanShaderCache::Update(compilers[i]);
+		}
+		VulkanShaderCache::Flush();
+
+		return succeeded;
 	}
 
 	void VulkanShaderCompiler::ClearUniformBuffers()
@@ -147,7 +336,7 @@ namespace Zenith {
 	{
 		std::map<VkShaderStageFlagBits, std::string> shaderSources = ShaderPreprocessor::PreprocessShader<ShaderUtils::SourceLang::GLSL>(source, m_AcknowledgedMacros);
 
-		static shaderc::Compiler compiler;
+		thread_local shaderc::Compiler compiler;
 
 		// Create include path manager instead of shaderc_util::FileFinder
 		Utils::IncludePathManager includeManager;
@@ -160,8 +349,7 @@ namespace Zenith {
 			options.AddMacroDefinition("__GLSL__");
 			options.AddMacroDefinition(std::string(ShaderUtils::VKStageToShaderMacro(stage)));
 
-			const auto& globalMacros = Renderer::GetGlobalShaderMacros();
-			for (const auto& [name, value] : globalMacros)
+			for (const auto& [name, value] : m_Macros)
 				options.AddMacroDefinition(name, value);
 
 			// Create GlslIncluder with our custom path manager
@@ -172,10 +360,9 @@ namespace Zenith {
 			if (preProcessingResult.GetCompilationStatus() != shaderc_compilation_status_success)
 				ZN_CORE_ERROR_TAG("Renderer", std::format("Failed to pre-process \"{}\"'s {} shader.\nError: {}", m_ShaderSourcePath.string(), ShaderUtils::ShaderStageToString(stage), preProcessingResult.GetErrorMessage()));
 
-			m_StagesMetadata[stage].HashValue = Hash::GenerateFNVHash(shaderSource);
-			m_StagesMetadata[stage].Headers = std::move(includer->GetIncludeData());
-
 			m_AcknowledgedMacros.merge(includer->GetParsedSpecialMacros());
+			for (const IncludeData& include : includer->GetIncludeData())
+				m_Includes.insert(include.IncludedFilePath);
 
 			shaderSource = std::string(preProcessingResult.begin(), preProcessingResult.end());
 		}
@@ -200,8 +387,7 @@ namespace Zenith {
 			L"-D", L"__HLSL__",
 		};
 
-		const auto& globalMacros = Renderer::GetGlobalShaderMacros();
-		for (const auto& [name, value] : globalMacros)
+		for (const auto& [name, value] : m_Macros)
 		{
 			arguments.emplace_back(L"-D");
 			arguments.push_back(nullptr);
@@ -217,19 +403,13 @@ namespace Zenith {
 			arguments[arguments.size() - 1] = def_buffer;
 		}
 
-		if (!DxcInstances::Compiler)
-		{
-#ifdef ZN_PLATFORM_WINDOWS
-			DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&DxcInstances::Compiler));
-			DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&DxcInstances::Utils));
-#endif
-		}
+		Utils::CreateDxcInstancesIfNeeded();
 
 		for (auto& [stage, shaderSource] : shaderSources)
 		{
 #ifdef ZN_PLATFORM_WINDOWS
 			IDxcBlobEncoding* pSource;
-			DxcInstances::Utils->CreateBlob(shaderSource.c_str(), (uint32_t)shaderSource.size(), CP_UTF8, &pSource);
+			Utils::s_DxcInstances.Utils->CreateBlob(shaderSource.c_str(), (uint32_t)shaderSource.size(), CP_UTF8, &pSource);
 
 			DxcBuffer sourceBuffer;
 			sourceBuffer.Ptr = pSource->GetBufferPointer();
@@ -238,7 +418,7 @@ namespace Zenith {
 
 			const std::unique_ptr<HlslIncluder> includer = std::make_unique<HlslIncluder>();
 			IDxcResult* pCompileResult;
-			HRESULT err = DxcInstances::Compiler->Compile(&sourceBuffer, arguments.data(), (uint32_t)arguments.size(), includer.get(), IID_PPV_ARGS(&pCompileResult));
+			HRESULT err = Utils::s_DxcInstances.Compiler->Compile(&sourceBuffer, arguments.data(), (uint32_t)arguments.size(), includer.get(), IID_PPV_ARGS(&pCompileResult));
 
 			// Error Handling
 			std::string error;
@@ -265,12 +445,9 @@ namespace Zenith {
 				ZN_CORE_ERROR_TAG("Renderer", error);
 			}
 
-			m_StagesMetadata[stage].HashValue = Hash::GenerateFNVHash(shaderSource);
-			m_StagesMetadata[stage].Headers = std::move(includer->GetIncludeData());
-
 			m_AcknowledgedMacros.merge(includer->GetParsedSpecialMacros());
-#else
-			m_StagesMetadata[stage] = StageData{};
+			for (const IncludeData& include : includer->GetIncludeData())
+				m_Includes.insert(include.IncludedFilePath);
 #endif
 		}
 		return shaderSources;
@@ -282,7 +459,7 @@ namespace Zenith {
 
 		if (m_Language == ShaderUtils::SourceLang::GLSL)
 		{
-			static shaderc::Compiler compiler;
+			thread_local shaderc::Compiler compiler;
 			shaderc::CompileOptions shaderCOptions;
 			shaderCOptions.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
 			shaderCOptions.SetWarningsAsErrors();
@@ -322,8 +499,9 @@ namespace Zenith {
 			if (stage & (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT | VK_SHADER_STAGE_GEOMETRY_BIT))
 				arguments.push_back(L"-fvk-invert-y");
 
+			Utils::CreateDxcInstancesIfNeeded();
 			IDxcBlobEncoding* pSource;
-			DxcInstances::Utils->CreateBlob(stageSource.c_str(), (uint32_t)stageSource.size(), CP_UTF8, &pSource);
+			Utils::s_DxcInstances.Utils->CreateBlob(stageSource.c_str(), (uint32_t)stageSource.size(), CP_UTF8, &pSource);
 
 			DxcBuffer sourceBuffer;
 			sourceBuffer.Ptr = pSource->GetBufferPointer();
@@ -333,7 +511,7 @@ namespace Zenith {
 			IDxcResult* pCompileResult;
 			std::string error;
 
-			HRESULT err = DxcInstances::Compiler->Compile(&sourceBuffer, arguments.data(), (uint32_t)arguments.size(), nullptr, IID_PPV_ARGS(&pCompileResult));
+			HRESULT err = Utils::s_DxcInstances.Compiler->Compile(&sourceBuffer, arguments.data(), (uint32_t)arguments.size(), nullptr, IID_PPV_ARGS(&pCompileResult));
 
 			// Error Handling
 			const bool failed = FAILED(err);
@@ -431,62 +609,194 @@ namespace Zenith {
 
 	Ref<VulkanShader> VulkanShaderCompiler::Compile(const std::filesystem::path& shaderSourcePath, bool forceCompile, bool disableOptimization)
 	{
-		// Set name
-		std::string path = shaderSourcePath.string();
-		size_t found = path.find_last_of("/\\");
-		std::string name = found != std::string::npos ? path.substr(found + 1) : path;
-		found = name.find_last_of('.');
-		name = found != std::string::npos ? name.substr(0, found) : name;
-
-		Ref<VulkanShader> shader = Ref<VulkanShader>::Create();
-		shader->m_AssetPath = shaderSourcePath;
-		shader->m_Name = name;
-		shader->m_DisableOptimization = disableOptimization;
-
-		Ref<VulkanShaderCompiler> compiler = Ref<VulkanShaderCompiler>::Create(shaderSourcePath, disableOptimization);
-		compiler->Reload(forceCompile);
-
-		shader->LoadAndCreateShaders(compiler->GetSPIRVData());
-		shader->SetReflectionData(compiler->m_ReflectionData);
-		shader->CreateDescriptors();
-
-		Renderer::AcknowledgeParsedGlobalMacros(compiler->GetAcknowledgedMacros(), shader);
-		Renderer::OnShaderReloaded(shader->GetHash());
-		return shader;
+		return CompileAll({ shaderSourcePath }, forceCompile, disableOptimization)[0];
 	}
 
 	bool VulkanShaderCompiler::TryRecompile(Ref<VulkanShader> shader)
 	{
-		Ref<VulkanShaderCompiler> compiler = Ref<VulkanShaderCompiler>::Create(shader->m_AssetPath, shader->m_DisableOptimization);
-		bool compileSucceeded = compiler->Reload(true);
-		if (!compileSucceeded)
+		return TryRecompileAll({ shader });
+	}
+
+	std::vector<Ref<VulkanShader>> VulkanShaderCompiler::CompileAll(const std::vector<std::filesystem::path>& shaderSourcePaths, bool forceCompile, bool disableOptimization)
+	{
+		std::vector<Ref<VulkanShaderCompiler>> compilers;
+		compilers.reserve(shaderSourcePaths.size());
+		for (const std::filesystem::path& shaderSourcePath : shaderSourcePaths)
+			compilers.push_back(Ref<VulkanShaderCompiler>::Create(shaderSourcePath, disableOptimization));
+
+		const std::vector<bool> succeeded = CompileBinaries(compilers, forceCompile);
+
+		std::vector<Ref<VulkanShader>> shaders;
+		shaders.reserve(compilers.size());
+		for (size_t i = 0; i < compilers.size(); i++)
+		{
+			Ref<VulkanShaderCompiler> compiler = compilers[i];
+			if (succeeded[i])
+				compiler->ReflectIfChanged(forceCompile);
+			else
+				ZN_CORE_ASSERT(false);
+
+			Ref<VulkanShader> shader = Ref<VulkanShader>::Create();
+			shader->m_AssetPath = shaderSourcePaths[i];
+			shader->m_Name = Utils::GetShaderName(shaderSourcePaths[i]);
+			shader->m_DisableOptimization = disableOptimization;
+			shader->m_Keywords = compiler->GetAcknowledgedMacros();
+
+			// Compiled with the global macros, which is the variant for their current values
+			shader->m_VariantKey = shader->m_WantedVariantKey = Shader::GetVariantKey(shader->GetVariantMacros());
+			shader->AddVariant(shader->m_VariantKey, compiler->GetSPIRVData(), compiler->m_ReflectionData);
+
+			shader->LoadAndCreateShaders(compiler->GetSPIRVData());
+			shader->SetReflectionData(compiler->m_ReflectionData);
+			shader->CreateDescriptors();
+
+			Renderer::AcknowledgeParsedGlobalMacros(compiler->GetAcknowledgedMacros(), shader);
+			Renderer::OnShaderReloaded(shader->GetHash());
+			shaders.push_back(shader);
+		}
+
+		return shaders;
+	}
+
+	bool VulkanShaderCompiler::TryRecompileAll(const std::vector<Ref<VulkanShader>>& shaders)
+	{
+		std::vector<Ref<VulkanShaderCompiler>> compilers;
+		compilers.reserve(shaders.size());
+		for (const Ref<VulkanShader>& shader : shaders)
+			compilers.push_back(Ref<VulkanShaderCompiler>::Create(shader->m_AssetPath, shader->m_DisableOptimization, shader->GetVariantMacros()));
+
+		const std::vector<bool> succeeded = CompileBinaries(compilers, true);
+
+		bool allSucceeded = true;
+		for (size_t i = 0; i < shaders.size(); i++)
+		{
+			if (!succeeded[i])
+			{
+				allSucceeded = false;
+				continue;
+			}
+
+			Ref<VulkanShaderCompiler> compiler = compilers[i];
+			compiler->ReflectIfChanged(true);
+
+			Ref<VulkanShader> shader = shaders[i];
+			shader->Release();
+
+			// The source changed, the other variants are stale
+			shader->m_Variants.clear();
+			shader->m_Keywords = compiler->GetAcknowledgedMacros();
+			shader->m_VariantKey = shader->m_WantedVariantKey = compiler->m_VariantKey;
+			shader->AddVariant(shader->m_VariantKey, compiler->GetSPIRVData(), compiler->m_ReflectionData);
+
+			shader->LoadAndCreateShaders(compiler->GetSPIRVData());
+			shader->SetReflectionData(compiler->m_ReflectionData);
+			shader->CreateDescriptors();
+
+			Renderer::AcknowledgeParsedGlobalMacros(compiler->GetAcknowledgedMacros(), shader);
+			Renderer::OnShaderReloaded(shader->GetHash());
+		}
+
+		return allSucceeded;
+	}
+
+	void VulkanShaderCompiler::VariantCompileThreadFunc()
+	{
+		while (true)
+		{
+			VariantCompileRequest request;
+			{
+				std::unique_lock lock(s_VariantCompilation->Mutex);
+				s_VariantCompilation->CV.wait(lock, [] { return !s_VariantCompilation->Running || !s_VariantCompilation->Queue.empty(); });
+				if (!s_VariantCompilation->Running)
+					return;
+
+				request = std::move(s_VariantCompilation->Queue.front());
+				s_VariantCompilation->Queue.pop();
+			}
+
+			// Reflection writes shared state, it happens in ApplyFinishedVariants
+			request.Succeeded = CompileBinaries({ request.Compiler }, false)[0];
+
+			// Moved, so the shader is never released on this thread
+			std::scoped_lock lock(s_VariantCompilation->Mutex);
+			s_VariantCompilation->Finished.push_back(std::move(request));
+		}
+	}
+
+	void VulkanShaderCompiler::CompileVariantAsync(Ref<VulkanShader> shader, const ShaderMacros& variantMacros)
+	{
+		if (!s_VariantCompilation)
+		{
+			s_VariantCompilation = znew VariantCompilationData();
+			s_VariantCompilation->CompileThread.Dispatch(VariantCompileThreadFunc);
+		}
+
+		const uint64_t variantKey = Shader::GetVariantKey(variantMacros);
+		if (!shader->m_PendingVariants.insert(variantKey).second)
+			return;
+
+		VariantCompileRequest request;
+		request.Shader = shader;
+		request.Compiler = Ref<VulkanShaderCompiler>::Create(shader->m_AssetPath, shader->m_DisableOptimization, variantMacros);
+		request.VariantKey = variantKey;
+		{
+			std::scoped_lock lock(s_VariantCompilation->Mutex);
+			s_VariantCompilation->Queue.push(std::move(request));
+		}
+		s_VariantCompilation->CV.notify_one();
+	}
+
+	bool VulkanShaderCompiler::ApplyFinishedVariants()
+	{
+		if (!s_VariantCompilation)
 			return false;
 
-		shader->Release();
+		std::vector<VariantCompileRequest> finished;
+		{
+			std::scoped_lock lock(s_VariantCompilation->Mutex);
+			std::swap(finished, s_VariantCompilation->Finished);
+		}
+
+		bool appliedAny = false;
+		for (VariantCompileRequest& result : finished)
+		{
+			Ref<VulkanShader> shader = result.Shader;
+			if (!result.Succeeded)
+			{
+				// Requested again once the shader is dirty again
+				shader->m_PendingVariants.erase(result.VariantKey);
+				continue;
+			}
 
-		shader->LoadAndCreateShaders(compiler->GetSPIRVData());
-		shader->SetReflectionData(compiler->m_ReflectionData);
-		shader->CreateDescriptors();
+			Ref<VulkanShaderCompiler> compiler = result.Compiler;
+			compiler->ReflectIfChanged(false);
+			shader->AddVariant(result.VariantKey, compiler->GetSPIRVData(), compiler->m_ReflectionData);
+			Renderer::AcknowledgeParsedGlobalMacros(compiler->GetAcknowledgedMacros(), shader);
 
-		Renderer::AcknowledgeParsedGlobalMacros(compiler->GetAcknowledgedMacros(), shader);
-		Renderer::OnShaderReloaded(shader->GetHash());
+			if (shader->m_WantedVariantKey == result.VariantKey)
+				appliedAny |= shader->RT_TrySetVariant(result.VariantKey);
+		}
 
-		return true;
+		return appliedAny;
 	}
 
-	bool VulkanShaderCompiler::CompileOrGetVulkanBinaries(std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& outputDebugBinary, std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& outputBinary, const VkShaderStageFlagBits changedStages, const bool forceCompile)
+	void VulkanShaderCompiler::ShutdownVariantCompilation()
 	{
-		for (auto [stage, source] : m_ShaderSource)
+		if (!s_VariantCompilation)
+			return;
+
 		{
-			if (!CompileOrGetVulkanBinary(stage, outputDebugBinary[stage], true, changedStages, forceCompile))
-				return false;
-			if (!CompileOrGetVulkanBinary(stage, outputBinary[stage], false, changedStages, forceCompile))
-				return false;
+			std::scoped_lock lock(s_VariantCompilation->Mutex);
+			s_VariantCompilation->Running = false;
 		}
-		return true;
+		s_VariantCompilation->CV.notify_all();
+		s_VariantCompilation->CompileThread.Join();
+
+		delete s_VariantCompilation;
+		s_VariantCompilation = nullptr;
 	}
 
-	bool VulkanShaderCompiler::CompileOrGetVulkanBinary(VkShaderStageFlagBits stage, std::vector<uint32_t>& outputBinary, bool debug, VkShaderStageFlagBits changedStages, bool forceCompile)
+	std::string VulkanShaderCompiler::CompileOrGetVulkanBinary(VkShaderStageFlagBits stage, std::vector<uint32_t>& outputBinary, bool debug, VkShaderStageFlagBits changedStages, bool forceCompile) const
 	{
 		const std::filesystem::path cacheDirectory = Utils::GetCacheDirectory();
 
@@ -514,7 +824,6 @@ namespace Zenith {
 
 			if (std::string error = Compile(outputBinary, stage, options); error.size())
 			{
-				ZN_CORE_ERROR_TAG("Renderer", "{}", error);
 				TryGetVulkanCachedBinary(cacheDirectory, extension, outputBinary);
 				if (outputBinary.empty())
 				{
@@ -524,22 +833,25 @@ namespace Zenith {
 				{
 					//ZN_CONSOLE_LOG_ERROR("Failed to compile {}:{} so a cached version was loaded instead.", m_ShaderSourcePath.string(), ShaderUtils::ShaderStageToString(stage));
 				}
-				return false;
+				return error;
 			}
 			else // Compile success
 			{
-				auto path = cacheDirectory / (m_ShaderSourcePath.filename().string() + extension);
+				auto path = cacheDirectory / (m_CacheName + extension);
 				std::string cachedFilePath = path.string();
 
 				FILE* f = fopen(cachedFilePath.c_str(), "wb");
 				if (!f)
+				{
 					ZN_CORE_ERROR("Failed to cache shader binary!");
+					return {};
+				}
 				fwrite(outputBinary.data(), sizeof(uint32_t), outputBinary.size(), f);
 				fclose(f);
 			}
 		}
 
-		return true;
+		return {};
 	}
 
 	void VulkanShaderCompiler::ClearReflectionData()
@@ -552,7 +864,7 @@ namespace Zenith {
 
 	void VulkanShaderCompiler::TryGetVulkanCachedBinary(const std::filesystem::path& cacheDirectory, const std::string& extension, std::vector<uint32_t>& outputBinary) const
 	{
-		const auto path = cacheDirectory / (m_ShaderSourcePath.filename().string() + extension);
+		const auto path = cacheDirectory / (m_CacheName + extension);
 		const std::string cachedFilePath = path.string();
 
 		FILE* f = fopen(cachedFilePath.data(), "rb");
@@ -575,7 +887,7 @@ namespace Zenith {
 		} header;
 
 		std::filesystem::path cacheDirectory = Utils::GetCacheDirectory();
-		const auto path = cacheDirectory / (m_ShaderSourcePath.filename().string() + ".cached_vulkan.refl");
+		const auto path = cacheDirectory / (m_CacheName + ".cached_vulkan.refl");
 		FileStreamReader serializer(path);
 		if (!serializer)
 			return false;
@@ -588,25 +900,7 @@ namespace Zenith {
 			return false;
 
 		ClearReflectionData();
-
-		uint32_t shaderDescriptorSetCount;
-		serializer.ReadRaw<uint32_t>(shaderDescriptorSetCount);
-
-		for (uint32_t i = 0; i < shaderDescriptorSetCount; i++)
-		{
-			auto& descriptorSet = m_ReflectionData.ShaderDescriptorSets.emplace_back();
-			serializer.ReadMap(descriptorSet.UniformBuffers);
-			serializer.ReadMap(descriptorSet.StorageBuffers);
-			serializer.ReadMap(descriptorSet.ImageSamplers);
-			serializer.ReadMap(descriptorSet.StorageImages);
-			serializer.ReadMap(descriptorSet.SeparateTextures);
-			serializer.ReadMap(descriptorSet.SeparateSamplers);
-			serializer.ReadMap(descriptorSet.WriteDescriptorSets);
-		}
-
-		serializer.ReadMap(m_ReflectionData.Resources);
-		serializer.ReadMap(m_ReflectionData.ConstantBuffers);
-		serializer.ReadArray(m_ReflectionData.PushConstantRanges);
+		VulkanShader::DeserializeReflectionData(&serializer, m_ReflectionData);
 
 		return true;
 	}
@@ -619,29 +913,10 @@ namespace Zenith {
 		} header;
 
 		std::filesystem::path cacheDirectory = Utils::GetCacheDirectory();
-		const auto path = cacheDirectory / (m_ShaderSourcePath.filename().string() + ".cached_vulkan.refl");
+		const auto path = cacheDirectory / (m_CacheName + ".cached_vulkan.refl");
 		FileStreamWriter serializer(path);
 		serializer.WriteRaw(header);
-		SerializeReflectionData(&serializer);
-	}
-
-	void VulkanShaderCompiler::SerializeReflectionData(StreamWriter* serializer)
-	{
-		serializer->WriteRaw<uint32_t>((uint32_t)m_ReflectionData.ShaderDescriptorSets.size());
-		for (const auto& descriptorSet : m_ReflectionData.ShaderDescriptorSets)
-		{
-			serializer->WriteMap(descriptorSet.UniformBuffers);
-			serializer->WriteMap(descriptorSet.StorageBuffers);
-			serializer->WriteMap(descriptorSet.ImageSamplers);
-			serializer->WriteMap(descriptorSet.StorageImages);
-			serializer->WriteMap(descriptorSet.SeparateTextures);
-			serializer->WriteMap(descriptorSet.SeparateSamplers);
-			serializer->WriteMap(descriptorSet.WriteDescriptorSets);
-		}
-
-		serializer->WriteMap(m_ReflectionData.Resources);
-		serializer->WriteMap(m_ReflectionData.ConstantBuffers);
-		serializer->WriteArray(m_ReflectionData.PushConstantRanges);
+		VulkanShader::SerializeReflectionData(&serializer, m_ReflectionData);
 	}
 
 	void VulkanShaderCompiler::ReflectAllShaderStages(const std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& shaderData)
@@ -740,6 +1015,9 @@ namespace Zenith {
 								storageBuffer.Size = binding.block.size;
 						}
 						shaderDescriptorSet.StorageBuffers[binding.binding] = s_StorageBuffers[setIndex][binding.binding];
+
+						if (setIndex == VulkanBindlessDescriptors::DescriptorSet && binding.binding == VulkanBindlessDescriptors::MaterialBinding)
+							Utils::ReflectBindlessMaterial(binding, m_ReflectionData);
 						break;
 					}
 					case SPV_REFLECT_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
@@ -8,30 +8,25 @@
 
 #include "ShaderPreprocessing/ShaderPreprocessor.hpp"
 
+#include "Zenith/Core/Hash.hpp"
+
 #include <map>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <filesystem>
 
-struct IDxcCompiler3;
-struct IDxcUtils;
-
 struct SpvReflectDescriptorBinding;
 struct SpvReflectBlockVariable;
 struct SpvReflectTypeDescription;
 
 namespace Zenith {
 
-	struct DxcInstances
-	{
-		inline static IDxcCompiler3* Compiler = nullptr;
-		inline static IDxcUtils* Utils = nullptr;
-	};
 	struct StageData
 	{
-		std::unordered_set<IncludeData> Headers;
-		uint32_t HashValue = 0;
-		bool operator== (const StageData& other) const noexcept { return this->Headers == other.Headers && this->HashValue == other.HashValue; }
+		// Preprocessed source, macros and compile options, so equal hashes compile to equal binaries
+		SHA256Hash::HashValue Hash{};
+		bool operator== (const StageData& other) const noexcept { return this->Hash == other.Hash; }
 		bool operator!= (const StageData& other) const noexcept { return !(*this == other); }
 	};
 
@@ -40,7 +35,8 @@ namespace Zenith {
 	class VulkanShaderCompiler : public RefCounted
 	{
 	public:
-		VulkanShaderCompiler(const std::filesystem::path& shaderSourcePath, bool disableOptimization = false);
+		// variantMacros select a variant of the shader, they are defined on top of the global macros
+		VulkanShaderCompiler(const std::filesystem::path& shaderSourcePath, bool disableOptimization = false, const ShaderMacros& variantMacros = {});
 
 		bool Reload(bool forceCompile = false);
 
@@ -51,7 +47,24 @@ namespace Zenith {
 
 		static Ref<VulkanShader> Compile(const std::filesystem::path& shaderSourcePath, bool forceCompile = false, bool disableOptimization = false);
 		static bool TryRecompile(Ref<VulkanShader> shader);
+
+		// Compile all shaders and their stages in parallel, reflection and shader creation happen afterwards on the calling thread in the given order.
+		static std::vector<Ref<VulkanShader>> CompileAll(const std::vector<std::filesystem::path>& shaderSourcePaths, bool forceCompile = false, bool disableOptimization = false);
+		// Returns false if any shader failed, the others are still reloaded
+		static bool TryRecompileAll(const std::vector<Ref<VulkanShader>>& shaders);
+
+		// Compiles a variant on a worker thread, the shader keeps its current variant until ApplyFinishedVariants
+		static void CompileVariantAsync(Ref<VulkanShader> shader, const ShaderMacros& variantMacros);
+		// On the render thread: hands finished variants to their shaders and switches to them if still wanted
+		static bool ApplyFinishedVariants();
+		static void ShutdownVariantCompilation();
 	private:
+		// Preprocesses and compiles the binaries of all compilers across worker threads. Errors are logged afterwards in compiler and stage order.
+		static std::vector<bool> CompileBinaries(const std::vector<Ref<VulkanShaderCompiler>>& compilers, bool forceCompile);
+		static void VariantCompileThreadFunc();
+		void LoadSource();
+		void ReflectIfChanged(bool forceCompile);
+
 		std::map<VkShaderStageFlagBits, std::string> PreProcess(const std::string& source);
 		std::map<VkShaderStageFlagBits, std::string> PreProcessGLSL(const std::string& source);
 		std::map<VkShaderStageFlagBits, std::string> PreProcessHLSL(const std::string& source);
@@ -63,15 +76,14 @@ namespace Zenith {
 		};
 
 		std::string Compile(std::vector<uint32_t>& outputBinary, const VkShaderStageFlagBits stage, CompilationOptions options) const;
-		bool CompileOrGetVulkanBinaries(std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& outputDebugBinary, std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& outputBinary, const VkShaderStageFlagBits changedStages, const bool forceCompile);
-		bool CompileOrGetVulkanBinary(VkShaderStageFlagBits stage, std::vector<uint32_t>& outputBinary, bool debug, VkShaderStageFlagBits changedStages, bool forceCompile);
+		// Returns the error, empty on success
+		std::string CompileOrGetVulkanBinary(VkShaderStageFlagBits stage, std::vector<uint32_t>& outputBinary, bool debug, VkShaderStageFlagBits changedStages, bool forceCompile) const;
 
 		void ClearReflectionData();
 
 		void TryGetVulkanCachedBinary(const std::filesystem::path& cacheDirectory, const std::string& extension, std::vector<uint32_t>& outputBinary) const;
 		bool TryReadCachedReflectionData();
 		void SerializeReflectionData();
-		void SerializeReflectionData(StreamWriter* serializer);
 
 		void ReflectAllShaderStages(const std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& shaderData);
 		void Reflect(VkShaderStageFlagBits shaderStage, const std::vector<uint32_t>& shaderData);
@@ -79,6 +91,11 @@ namespace Zenith {
 		std::filesystem::path m_ShaderSourcePath;
 		bool m_DisableOptimization = false;
 
+		// Global and variant macros, copied at construction so compiling never reads renderer state
+		ShaderMacros m_Macros;
+		uint64_t m_VariantKey = 0;
+		std::string m_CacheName; // cached binaries and reflection, per variant
+
 		std::map<VkShaderStageFlagBits, std::string> m_ShaderSource;
 		std::map<VkShaderStageFlagBits, std::vector<uint32_t>> m_SPIRVDebugData, m_SPIRVData;
 
@@ -88,12 +105,15 @@ namespace Zenith {
 		// Names of macros that are parsed from shader.
 		// These are used to reliably get informattion about what shaders need what macros
 		std::unordered_set<std::string> m_AcknowledgedMacros;
+		std::set<std::filesystem::path> m_Includes; // every header of every stage, recorded in the ShaderDependencyGraph
 		ShaderUtils::SourceLang m_Language;
 
 		std::map<VkShaderStageFlagBits, StageData> m_StagesMetadata;
+		VkShaderStageFlagBits m_ChangedStages = {};
 
 		friend class VulkanShader;
 		friend class VulkanShaderCache;
+		friend class VulkanShaderPackBuilder;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "znpch.hpp"
+#include "VulkanShaderPackBuilder.hpp"
+
+#include "VulkanShaderCompiler.hpp"
+
+#include "Zenith/Debug/Profiler.hpp"
+
+#include "Zenith/Renderer/API/Vulkan/ShaderPack/VulkanShaderPackWriter.hpp"
+
+#include <algorithm>
+
+namespace Zenith {
+
+	namespace Utils {
+
+		static bool IsShaderSource(const std::filesystem::path& path)
+		{
+			const std::filesystem::path extension = path.extension();
+			return extension == ".glsl" || extension == ".hlsl";
+		}
+
+		static bool IsInIncludeDirectory(const std::filesystem::path& path)
+		{
+			return std::find(path.begin(), path.end(), "Include") != path.end();
+		}
+
+	}
+
+	std::vector<std::filesystem::path> VulkanShaderPackBuilder::FindShaders(const std::vector<std::filesystem::path>& directories)
+	{
+		std::vector<std::filesystem::path> shaders;
+		for (const std::filesystem::path& directory : directories)
+		{
+			std::error_code error;
+			for (auto it = std::filesystem::recursive_directory_iterator(directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+			{
+				if (it->is_regular_file() && Utils::IsShaderSource(it->path()) && !Utils::IsInIncludeDirectory(it->path()))
+					shaders.push_back(it->path().lexically_normal());
+			}
+
+			if (error)
+				ZN_CORE_ERROR_TAG("Renderer", "Failed to search {} for shaders: {}", directory.string(), error.message());
+		}
+
+		std::sort(shaders.begin(), shaders.end());
+		shaders.erase(std::unique(shaders.begin(), shaders.end()), shaders.end());
+		return shaders;
+	}
+
+	bool VulkanShaderPackBuilder::Build(const std::vector<std::filesystem::path>& shaderSourcePaths, const std::filesystem::path& outputPath, bool disableOptimization)
+	{
+		ZN_PROFILE_FUNC();
+
+		// The base variants tell which keywords each shader declares
+		std::vector<Ref<VulkanShaderCompiler>> compilers;
+		compilers.reserve(shaderSourcePaths.size());
+		for (const std::filesystem::path& shaderSourcePath : shaderSourcePaths)
+			compilers.push_back(Ref<VulkanShaderCompiler>::Create(shaderSourcePath, disableOptimization));
+
+		std::vector<bool> succeeded = VulkanShaderCompiler::CompileBinaries(compilers, false);
+
+		bool allSucceeded = true;
+		std::vector<Ref<VulkanShaderCompiler>> variantCompilers;
+		for (size_t i = 0; i < compilers.size(); i++)
+		{
+			if (!succeeded[i])
+			{
+				allSucceeded = false;
+				continue;
+			}
+
+			// "__ZN_" macros the renderer switches on at startup (e.g. __ZN_BINDLESS) get variants like keywords, the pack
+			// has no compiler to build them when the renderer asks for them
+			const std::unordered_set<std::string>& macros = compilers[i]->GetAcknowledgedMacros();
+			std::vector<std::string> keywords(macros.begin(), macros.end());
+			std::sort(keywords.begin(), keywords.end());
+
+			if (keywords.size() > MaxKeywords)
+			{
+				ZN_CORE_ERROR_TAG("Renderer", "{} tests {} keywords and engine macros, at most {} are supported", shaderSourcePaths[i].string(), keywords.size(), MaxKeywords);
+				allSucceeded = false;
+				continue;
+			}
+
+			for (uint32_t mask = 1; mask < (1u << keywords.size()); mask++)
+			{
+				ShaderMacros variantMacros;
+				for (uint32_t k = 0; k < keywords.size(); k++)
+				{
+					if (mask & (1u << k))
+						variantMacros[keywords[k]] = "1";
+				}
+				variantCompilers.push_back(Ref<VulkanShaderCompiler>::Create(shaderSourcePaths[i], disableOptimization, variantMacros));
+			}
+		}
+
+		succeeded = VulkanShaderCompiler::CompileBinaries(variantCompilers, false);
+		for (size_t i = 0; i < variantCompilers.size(); i++)
+		{
+			if (!succeeded[i])
+				allSucceeded = false;
+		}
+
+		if (!allSucceeded)
+		{
+			ZN_CORE_ERROR_TAG("Renderer", "Not writing shader pack {}, shaders failed to compile", outputPath.string());
+			return false;
+		}
+
+		compilers.insert(compilers.end(), variantCompilers.begin(), variantCompilers.end());
+
+		VulkanShaderPackWriter writer;
+		for (Ref<VulkanShaderCompiler> compiler : compilers)
+		{
+			compiler->ReflectIfChanged(false);
+			writer.AddShader(compiler->m_ShaderSourcePath, compiler->m_VariantKey, compiler->GetAcknowledgedMacros(), compiler->GetSPIRVData(), compiler->m_ReflectionData);
+		}
+
+		return writer.Write(outputPath);
+	}
+
+}
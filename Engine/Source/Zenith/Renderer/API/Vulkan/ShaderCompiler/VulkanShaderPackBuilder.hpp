@@ -0,0 +1,24 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+namespace Zenith {
+
+	// Compiles shaders ahead of time into a .zsp, see VulkanShaderPack
+	class VulkanShaderPackBuilder
+	{
+	public:
+		// Every keyword combination is compiled, so the number of keywords and "__ZN_" macros a shader may test is limited
+		static constexpr uint32_t MaxKeywords = 8;
+
+		// .glsl and .hlsl files under the directories, sorted. Include directories are skipped.
+		static std::vector<std::filesystem::path> FindShaders(const std::vector<std::filesystem::path>& directories);
+
+		// Compiles every shader and a variant for each combination of its keywords and the "__ZN_" macros it tests, each
+		// defined as 1 like the renderer defines them.
+		// Returns false without writing the pack if any of them failed.
+		static bool Build(const std::vector<std::filesystem::path>& shaderSourcePaths, const std::filesystem::path& outputPath, bool disableOptimization = false);
+	};
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Zenith/Core/Base.hpp"
+#include "Zenith/Core/Hash.hpp"
+
+#include <filesystem>
+#include <string>
+
+namespace Zenith {
+
+	// .zsp layout: FileHeader | SPIR-V and reflection blobs (4 byte aligned) | Entry[EntryCount] sorted by path hash, then variant key
+	//              | Stage[StageCount] | string table
+	struct ShaderPackFile
+	{
+		struct Stage
+		{
+			uint32_t ShaderStage; // VkShaderStageFlagBits
+			uint32_t Padding;
+			uint64_t Offset;      // SPIR-V, from the start of the file
+			uint64_t Size;        // In bytes
+		};
+
+		struct Entry
+		{
+			uint64_t PathHash;
+			uint64_t VariantKey;       // Shader::GetVariantKey of the macros it was compiled with
+			uint64_t ReflectionOffset; // Serialized VulkanShader::ReflectionData
+			uint64_t ReflectionSize;
+			uint32_t PathOffset;       // Null-terminated shader path in the string table
+			uint32_t MacrosOffset;     // Null-terminated, space separated macros the shader tests
+			uint32_t FirstStage;
+			uint32_t StageCount;
+		};
+
+		struct FileHeader
+		{
+			const char HEADER[4] = { 'Z','N','S','P' };
+			uint32_t Version = 1;
+			uint32_t EntryCount = 0;
+			uint32_t StageCount = 0;
+			uint64_t EntryOffset = 0;
+			uint64_t StageOffset = 0;
+			uint64_t StringTableOffset = 0;
+			uint64_t StringTableSize = 0;
+		};
+
+		static_assert(sizeof(Stage) == 24);
+		static_assert(sizeof(Entry) == 48);
+
+		// Shaders are found by the path they are loaded with
+		static std::string GetPathKey(const std::filesystem::path& shaderPath)
+		{
+			return shaderPath.lexically_normal().generic_string();
+		}
+
+		static uint64_t GetPathHash(std::string_view pathKey)
+		{
+			return XXHash64::compute(pathKey);
+		}
+	};
+
+}
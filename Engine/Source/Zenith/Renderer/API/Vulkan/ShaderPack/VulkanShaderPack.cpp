@@ -0,0 +1,142 @@
+#include "znpch.hpp"
+#include "VulkanShaderPack.hpp"
+
+#include "Zenith/Serialization/MemoryStream.hpp"
+
+namespace Zenith {
+
+	Ref<VulkanShaderPack> VulkanShaderPack::Open(const std::filesystem::path& filepath)
+	{
+		Ref<VulkanShaderPack> pack = Ref<VulkanShaderPack>::Create();
+		if (!pack->Load(filepath))
+			return nullptr;
+
+		ZN_CORE_INFO_TAG("Renderer", "Opened shader pack {} ({} shaders)", filepath.string(), pack->GetShaderCount());
+		return pack;
+	}
+
+	bool VulkanShaderPack::Load(const std::filesystem::path& filepath)
+	{
+		ZN_PROFILE_FUNC();
+
+		m_FilePath = filepath;
+		if (!m_File.Open(filepath))
+			return false;
+
+		const byte* data = m_File.GetData();
+		const uint64_t size = m_File.GetSize();
+
+		ShaderPackFile::FileHeader expected;
+		if (size < sizeof(ShaderPackFile::FileHeader))
+		{
+			ZN_CORE_ERROR_TAG("Renderer", "Shader pack {} is truncated", filepath.string());
+			return false;
+		}
+
+		memcpy(&m_Header, data, sizeof(ShaderPackFile::FileHeader));
+		if (memcmp(m_Header.HEADER, expected.HEADER, sizeof(expected.HEADER)) != 0 || m_Header.Version != expected.Version)
+		{
+			ZN_CORE_ERROR_TAG("Renderer", "{} is not a supported shader pack (version {})", filepath.string(), m_Header.Version);
+			return false;
+		}
+
+		const uint64_t entrySize = uint64_t(m_Header.EntryCount) * sizeof(ShaderPackFile::Entry);
+		const uint64_t stageSize = uint64_t(m_Header.StageCount) * sizeof(ShaderPackFile::Stage);
+		if (m_Header.EntryOffset + entrySize > size
+			|| m_Header.StageOffset + stageSize > size
+			|| m_Header.StringTableOffset + m_Header.StringTableSize > size
+			|| m_Header.StringTableSize == 0
+			|| m_Header.EntryOffset % alignof(ShaderPackFile::Entry) != 0
+			|| m_Header.StageOffset % alignof(ShaderPackFile::Stage) != 0)
+		{
+			ZN_CORE_ERROR_TAG("Renderer", "Shader pack {} has a corrupt table of contents", filepath.string());
+			return false;
+		}
+
+		m_Entries = reinterpret_cast<const ShaderPackFile::Entry*>(data + m_Header.EntryOffset);
+		m_Stages = reinterpret_cast<const ShaderPackFile::Stage*>(data + m_Header.StageOffset);
+		m_StringTable = reinterpret_cast<const char*>(data + m_Header.StringTableOffset);
+
+		for (const ShaderPackFile::Entry& entry : *this)
+		{
+			if (entry.ReflectionOffset + entry.ReflectionSize > size
+				|| uint64_t(entry.FirstStage) + entry.StageCount > m_Header.StageCount
+				|| entry.PathOffset >= m_Header.StringTableSize
+				|| entry.MacrosOffset >= m_Header.StringTableSize)
+			{
+				ZN_CORE_ERROR_TAG("Renderer", "Shader pack {} references data outside the file", filepath.string());
+				return false;
+			}
+
+			for (uint32_t i = 0; i < entry.StageCount; i++)
+			{
+				const ShaderPackFile::Stage& stage = m_Stages[entry.FirstStage + i];
+				if (stage.Offset + stage.Size > size || stage.Offset % sizeof(uint32_t) != 0 || stage.Size % sizeof(uint32_t) != 0)
+				{
+					ZN_CORE_ERROR_TAG("Renderer", "Shader pack {} references data outside the file", filepath.string());
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	const ShaderPackFile::Entry* VulkanShaderPack::GetEntry(const std::filesystem::path& shaderPath, uint64_t variantKey) const
+	{
+		if (!m_Entries)
+			return nullptr;
+
+		const std::string pathKey = ShaderPackFile::GetPathKey(shaderPath);
+		const uint64_t pathHash = ShaderPackFile::GetPathHash(pathKey);
+
+		auto it = std::lower_bound(begin(), end(), std::make_pair(pathHash, variantKey), [](const ShaderPackFile::Entry& entry, const std::pair<uint64_t, uint64_t>& key)
+		{
+			return std::make_pair(entry.PathHash, entry.VariantKey) < key;
+		});
+
+		for (; it != end() && it->PathHash == pathHash && it->VariantKey == variantKey; ++it)
+		{
+			if (GetShaderPath(*it) == pathKey)
+				return it;
+		}
+		return nullptr;
+	}
+
+	std::unordered_set<std::string> VulkanShaderPack::GetMacros(const ShaderPackFile::Entry& entry) const
+	{
+		std::unordered_set<std::string> macros;
+		std::string_view list = m_StringTable + entry.MacrosOffset;
+		while (!list.empty())
+		{
+			const size_t end = std::min(list.find(' '), list.size());
+			if (end)
+				macros.emplace(list.substr(0, end));
+			list.remove_prefix(std::min(end + 1, list.size()));
+		}
+		return macros;
+	}
+
+	std::map<VkShaderStageFlagBits, std::vector<uint32_t>> VulkanShaderPack::ReadShaderData(const ShaderPackFile::Entry& entry) const
+	{
+		std::map<VkShaderStageFlagBits, std::vector<uint32_t>> shaderData;
+		for (uint32_t i = 0; i < entry.StageCount; i++)
+		{
+			const ShaderPackFile::Stage& stage = m_Stages[entry.FirstStage + i];
+			const uint32_t* spirv = reinterpret_cast<const uint32_t*>(m_File.GetData() + stage.Offset);
+			shaderData[(VkShaderStageFlagBits)stage.ShaderStage].assign(spirv, spirv + stage.Size / sizeof(uint32_t));
+		}
+		return shaderData;
+	}
+
+	VulkanShader::ReflectionData VulkanShaderPack::ReadReflectionData(const ShaderPackFile::Entry& entry) const
+	{
+		const Buffer reflection(m_File.GetData() + entry.ReflectionOffset, entry.ReflectionSize);
+		MemoryStreamReader stream(reflection);
+
+		VulkanShader::ReflectionData reflectionData;
+		VulkanShader::DeserializeReflectionData(&stream, reflectionData);
+		return reflectionData;
+	}
+
+}
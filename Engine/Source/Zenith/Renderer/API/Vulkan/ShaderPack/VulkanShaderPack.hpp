@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ShaderPackFile.hpp"
+
+#include "Zenith/Renderer/API/Vulkan/VulkanShader.hpp"
+#include "Zenith/Utilities/MappedFile.hpp"
+
+#include <map>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace Zenith {
+
+	// Memory-mapped .zsp reader, shaders come out of it without any preprocessing or compiling.
+	// All queries are const and safe to call from any thread.
+	class VulkanShaderPack : public RefCounted
+	{
+	public:
+		// Returns nullptr if the file is missing or not a valid pack
+		static Ref<VulkanShaderPack> Open(const std::filesystem::path& filepath);
+
+		const ShaderPackFile::Entry* GetEntry(const std::filesystem::path& shaderPath, uint64_t variantKey) const;
+		bool Contains(const std::filesystem::path& shaderPath, uint64_t variantKey) const { return GetEntry(shaderPath, variantKey) != nullptr; }
+
+		std::string_view GetShaderPath(const ShaderPackFile::Entry& entry) const { return m_StringTable + entry.PathOffset; }
+		std::unordered_set<std::string> GetMacros(const ShaderPackFile::Entry& entry) const;
+
+		// Copies out of the mapping
+		std::map<VkShaderStageFlagBits, std::vector<uint32_t>> ReadShaderData(const ShaderPackFile::Entry& entry) const;
+		VulkanShader::ReflectionData ReadReflectionData(const ShaderPackFile::Entry& entry) const;
+
+		uint32_t GetShaderCount() const { return m_Header.EntryCount; }
+		const ShaderPackFile::Entry* begin() const { return m_Entries; }
+		const ShaderPackFile::Entry* end() const { return m_Entries + m_Header.EntryCount; }
+
+		const std::filesystem::path& GetFilePath() const { return m_FilePath; }
+
+	private:
+		bool Load(const std::filesystem::path& filepath);
+
+	private:
+		std::filesystem::path m_FilePath;
+		MappedFile m_File;
+
+		ShaderPackFile::FileHeader m_Header;
+		const ShaderPackFile::Entry* m_Entries = nullptr;
+		const ShaderPackFile::Stage* m_Stages = nullptr;
+		const char* m_StringTable = nullptr;
+	};
+
+}
@@ -0,0 +1,156 @@
+#include "znpch.hpp"
+#include "VulkanShaderPackWriter.hpp"
+
+#include "Zenith/Serialization/FileStream.hpp"
+#include "Zenith/Utilities/FileSystem.hpp"
+
+namespace Zenith {
+
+	namespace Utils {
+
+		static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		static void PadTo(StreamWriter& stream, uint64_t position)
+		{
+			const uint64_t current = stream.GetStreamPosition();
+			if (position > current)
+				stream.WriteZero(position - current);
+		}
+
+	}
+
+	void VulkanShaderPackWriter::AddShader(const std::filesystem::path& shaderPath, uint64_t variantKey, const std::unordered_set<std::string>& macros,
+		const std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& shaderData, const VulkanShader::ReflectionData& reflectionData)
+	{
+		Shader shader;
+		shader.Path = ShaderPackFile::GetPathKey(shaderPath);
+		shader.ShaderData = shaderData;
+		shader.ReflectionData = reflectionData;
+
+		// Sorted so that the same shaders always give the same pack
+		std::vector<std::string> sortedMacros(macros.begin(), macros.end());
+		std::sort(sortedMacros.begin(), sortedMacros.end());
+		for (const std::string& macro : sortedMacros)
+		{
+			if (!shader.Macros.empty())
+				shader.Macros += ' ';
+			shader.Macros += macro;
+		}
+
+		const uint64_t pathHash = ShaderPackFile::GetPathHash(shader.Path);
+		m_Shaders[{ pathHash, variantKey }] = std::move(shader);
+	}
+
+	bool VulkanShaderPackWriter::Write(const std::filesystem::path& filepath)
+	{
+		ZN_PROFILE_FUNC();
+
+		std::vector<ShaderPackFile::Entry> entries;
+		std::vector<ShaderPackFile::Stage> stages;
+		std::vector<char> stringTable;
+		entries.reserve(m_Shaders.size());
+
+		auto addString = [&stringTable](const std::string& string)
+		{
+			const uint32_t offset = (uint32_t)stringTable.size();
+			stringTable.insert(stringTable.end(), string.begin(), string.end());
+			stringTable.push_back('\0');
+			return offset;
+		};
+
+		ShaderPackFile::FileHeader header;
+
+		std::filesystem::path tempPath = filepath;
+		tempPath += ".tmp";
+
+		{
+			FileStreamWriter stream(tempPath);
+			if (!stream.IsStreamGood())
+			{
+				ZN_CORE_ERROR_TAG("Renderer", "Failed to open {} for writing", tempPath.string());
+				return false;
+			}
+
+			stream.WriteRaw(header);
+
+			for (const auto& [key, shader] : m_Shaders)
+			{
+				ShaderPackFile::Entry& entry = entries.emplace_back();
+				memset(&entry, 0, sizeof(entry));
+				entry.PathHash = key.first;
+				entry.VariantKey = key.second;
+				entry.PathOffset = addString(shader.Path);
+				entry.MacrosOffset = addString(shader.Macros);
+				entry.FirstStage = (uint32_t)stages.size();
+				entry.StageCount = (uint32_t)shader.ShaderData.size();
+
+				for (const auto& [shaderStage, spirv] : shader.ShaderData)
+				{
+					ShaderPackFile::Stage& stage = stages.emplace_back();
+					memset(&stage, 0, sizeof(stage));
+					stage.ShaderStage = (uint32_t)shaderStage;
+					stage.Offset = Utils::AlignUp(stream.GetStreamPosition(), sizeof(uint32_t));
+					stage.Size = spirv.size() * sizeof(uint32_t);
+
+					Utils::PadTo(stream, stage.Offset);
+					stream.WriteData(reinterpret_cast<const char*>(spirv.data()), stage.Size);
+				}
+
+				entry.ReflectionOffset = stream.GetStreamPosition();
+				VulkanShader::SerializeReflectionData(&stream, shader.ReflectionData);
+				entry.ReflectionSize = stream.GetStreamPosition() - entry.ReflectionOffset;
+			}
+
+			header.EntryCount = (uint32_t)entries.size();
+			header.StageCount = (uint32_t)stages.size();
+
+			header.EntryOffset = Utils::AlignUp(stream.GetStreamPosition(), alignof(ShaderPackFile::Entry));
+			Utils::PadTo(stream, header.EntryOffset);
+			stream.WriteData(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ShaderPackFile::Entry));
+
+			header.StageOffset = Utils::AlignUp(stream.GetStreamPosition(), alignof(ShaderPackFile::Stage));
+			Utils::PadTo(stream, header.StageOffset);
+			stream.WriteData(reinterpret_cast<const char*>(stages.data()), stages.size() * sizeof(ShaderPackFile::Stage));
+
+			if (stringTable.empty())
+				stringTable.push_back('\0');
+
+			header.StringTableOffset = stream.GetStreamPosition();
+			header.StringTableSize = stringTable.size();
+			stream.WriteData(stringTable.data(), stringTable.size());
+
+			stream.SetStreamPosition(0);
+			stream.WriteRaw(header);
+
+			if (!stream.IsStreamGood())
+			{
+				ZN_CORE_ERROR_TAG("Renderer", "Failed to write shader pack {}", tempPath.string());
+				return false;
+			}
+		}
+
+		if (!FileSystem::FlushToDisk(tempPath))
+		{
+			ZN_CORE_ERROR_TAG("Renderer", "Failed to flush {} to disk", tempPath.string());
+			return false;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, filepath, error);
+		if (error)
+		{
+			ZN_CORE_ERROR_TAG("Renderer", "Failed to move {} into place: {}", tempPath.string(), error.message());
+			return false;
+		}
+
+		if (!FileSystem::FlushToDisk(filepath.parent_path()))
+			ZN_CORE_WARN_TAG("Renderer", "Failed to flush the directory of {} to disk", filepath.string());
+
+		ZN_CORE_INFO_TAG("Renderer", "Wrote shader pack {}: {} shader variants, {} stages", filepath.string(), header.EntryCount, header.StageCount);
+		return true;
+	}
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ShaderPackFile.hpp"
+
+#include "Zenith/Renderer/API/Vulkan/VulkanShader.hpp"
+
+#include <filesystem>
+#include <map>
+#include <unordered_set>
+#include <vector>
+
+namespace Zenith {
+
+	// Builds a .zsp out of compiled shader variants
+	class VulkanShaderPackWriter
+	{
+	public:
+		// Copies the data. Adding a variant of a shader twice replaces the earlier one.
+		void AddShader(const std::filesystem::path& shaderPath, uint64_t variantKey, const std::unordered_set<std::string>& macros,
+			const std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& shaderData, const VulkanShader::ReflectionData& reflectionData);
+
+		// Writes to a temporary file first so an existing pack is only replaced once complete
+		bool Write(const std::filesystem::path& filepath);
+
+		uint32_t GetShaderCount() const { return (uint32_t)m_Shaders.size(); }
+
+	private:
+		struct Shader
+		{
+			std::string Path;
+			std::string Macros;
+			std::map<VkShaderStageFlagBits, std::vector<uint32_t>> ShaderData;
+			VulkanShader::ReflectionData ReflectionData;
+		};
+
+		std::map<std::pair<uint64_t, uint64_t>, Shader> m_Shaders; // (path hash, variant key) -> shader, in file order
+	};
+
+}
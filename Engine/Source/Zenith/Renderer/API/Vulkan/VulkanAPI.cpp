@@ -3,8 +3,11 @@
 
 #include "VulkanContext.hpp"
 
+#include "Zenith/Core/Hash.hpp"
 #include "Zenith/Renderer/RendererStats.hpp"
 
+#include <mutex>
+
 namespace Zenith::Vulkan {
 
 	VkDescriptorSetAllocateInfo DescriptorSetAllocInfo(const VkDescriptorSetLayout* layouts, uint32_t count, VkDescriptorPool pool)
@@ -17,26 +20,139 @@ namespace Zenith::Vulkan {
 		return info;
 	}
 
+	namespace Utils {
+
+		// Everything that affects sampling. All members are 4 bytes, so there is no padding to hash.
+		struct SamplerState
+		{
+			VkSamplerCreateFlags Flags;
+			VkFilter MagFilter;
+			VkFilter MinFilter;
+			VkSamplerMipmapMode MipmapMode;
+			VkSamplerAddressMode AddressModeU;
+			VkSamplerAddressMode AddressModeV;
+			VkSamplerAddressMode AddressModeW;
+			float MipLodBias;
+			VkBool32 AnisotropyEnable;
+			float MaxAnisotropy;
+			VkBool32 CompareEnable;
+			VkCompareOp CompareOp;
+			float MinLod;
+			float MaxLod;
+			VkBorderColor BorderColor;
+			VkBool32 UnnormalizedCoordinates;
+
+			bool operator==(const SamplerState& other) const = default;
+		};
+
+		struct SamplerStateHash
+		{
+			size_t operator()(const SamplerState& state) const noexcept
+			{
+				return (size_t)XXHash64::compute(&state, sizeof(state), 0);
+			}
+		};
+
+		static SamplerState GetSamplerState(const VkSamplerCreateInfo& info)
+		{
+			SamplerState state = {};
+			state.Flags = info.flags;
+			state.MagFilter = info.magFilter;
+			state.MinFilter = info.minFilter;
+			state.MipmapMode = info.mipmapMode;
+			state.AddressModeU = info.addressModeU;
+			state.AddressModeV = info.addressModeV;
+			state.AddressModeW = info.addressModeW;
+			state.MipLodBias = info.mipLodBias;
+			state.AnisotropyEnable = info.anisotropyEnable;
+			state.MaxAnisotropy = info.anisotropyEnable ? info.maxAnisotropy : 1.0f; // ignored when disabled
+			state.CompareEnable = info.compareEnable;
+			state.CompareOp = info.compareEnable ? info.compareOp : VK_COMPARE_OP_NEVER;
+			state.MinLod = info.minLod;
+			state.MaxLod = info.maxLod;
+			state.BorderColor = info.borderColor;
+			state.UnnormalizedCoordinates = info.unnormalizedCoordinates;
+			return state;
+		}
+
+	}
+
+	struct CachedSampler
+	{
+		VkSampler Sampler = nullptr;
+		uint32_t RefCount = 0;
+	};
+
+	// Samplers are shared by everything created with the same state, drivers only allow a few thousand
+	static std::unordered_map<Utils::SamplerState, CachedSampler, Utils::SamplerStateHash> s_SamplerCache;
+	static std::unordered_map<VkSampler, Utils::SamplerState> s_SamplerStates;
+	static std::mutex s_SamplerCacheMutex; // textures are also created on the asset workers
+
 	VkSampler CreateSampler(VkSamplerCreateInfo samplerCreateInfo)
 	{
 		auto device = VulkanContext::GetCurrentDevice();
 		VkDevice vulkanDevice = device->GetVulkanDevice();
 
-		VkSampler sampler;
-		VK_CHECK_RESULT(vkCreateSampler(vulkanDevice, &samplerCreateInfo, nullptr, &sampler));
+		auto& counts = RendererUtils::GetResourceAllocationCounts();
+
+		// Extension structs are not part of the key, those samplers are not shared
+		if (samplerCreateInfo.pNext)
+		{
+			VkSampler sampler;
+			VK_CHECK_RESULT(vkCreateSampler(vulkanDevice, &samplerCreateInfo, nullptr, &sampler));
 
-		RendererUtils::GetResourceAllocationCounts().Samplers++;
+			std::scoped_lock lock(s_SamplerCacheMutex);
+			counts.Samplers++;
+			counts.SamplerReferences++;
+			return sampler;
+		}
 
-		return sampler;
+		const Utils::SamplerState state = Utils::GetSamplerState(samplerCreateInfo);
+
+		std::scoped_lock lock(s_SamplerCacheMutex);
+		counts.SamplerReferences++;
+
+		CachedSampler& cached = s_SamplerCache[state];
+		if (cached.RefCount++ == 0)
+		{
+			VK_CHECK_RESULT(vkCreateSampler(vulkanDevice, &samplerCreateInfo, nullptr, &cached.Sampler));
+			s_SamplerStates[cached.Sampler] = state;
+
+			counts.Samplers++;
+			if (counts.Samplers > device->GetPhysicalDevice()->GetLimits().maxSamplerAllocationCount)
+				ZN_CORE_WARN_TAG("Renderer", "{} unique samplers exceed the device limit of {}", counts.Samplers, device->GetPhysicalDevice()->GetLimits().maxSamplerAllocationCount);
+		}
+
+		return cached.Sampler;
 	}
 
 	void DestroySampler(VkSampler sampler)
 	{
+		if (!sampler)
+			return;
+
 		auto device = VulkanContext::GetCurrentDevice();
 		VkDevice vulkanDevice = device->GetVulkanDevice();
-		vkDestroySampler(vulkanDevice, sampler, nullptr);
 
-		RendererUtils::GetResourceAllocationCounts().Samplers--;
+		auto& counts = RendererUtils::GetResourceAllocationCounts();
+
+		std::scoped_lock lock(s_SamplerCacheMutex);
+		counts.SamplerReferences--;
+
+		auto state = s_SamplerStates.find(sampler);
+		if (state != s_SamplerStates.end())
+		{
+			auto cached = s_SamplerCache.find(state->second);
+			ZN_CORE_ASSERT(cached != s_SamplerCache.end() && cached->second.RefCount > 0);
+			if (--cached->second.RefCount > 0)
+				return;
+
+			s_SamplerCache.erase(cached);
+			s_SamplerStates.erase(state);
+		}
+
+		vkDestroySampler(vulkanDevice, sampler, nullptr);
+		counts.Samplers--;
 	}
 
 }
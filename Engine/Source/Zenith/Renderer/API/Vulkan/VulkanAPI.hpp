@@ -6,6 +6,7 @@ namespace Zenith::Vulkan {
 
 	VkDescriptorSetAllocateInfo DescriptorSetAllocInfo(const VkDescriptorSetLayout* layouts, uint32_t count = 1, VkDescriptorPool pool = nullptr);
 
+	// Samplers are cached by their state and reference counted, every CreateSampler() needs a matching DestroySampler()
 	VkSampler CreateSampler(VkSamplerCreateInfo samplerCreateInfo);
 	void DestroySampler(VkSampler sampler);
 
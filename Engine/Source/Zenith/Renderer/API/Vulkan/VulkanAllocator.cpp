@@ -45,12 +45,14 @@ namespace Zenith {
 	{
 	}
 
-	VmaAllocation VulkanAllocator::AllocateBuffer(VkBufferCreateInfo bufferCreateInfo, VmaMemoryUsage usage, VkBuffer& outBuffer)
+	VmaAllocation VulkanAllocator::AllocateBuffer(VkBufferCreateInfo bufferCreateInfo, VmaMemoryUsage usage, VkBuffer& outBuffer, void** outMappedData)
 	{
 		ZN_CORE_VERIFY(bufferCreateInfo.size > 0);
 
 		VmaAllocationCreateInfo allocCreateInfo = {};
 		allocCreateInfo.usage = usage;
+		if (outMappedData)
+			allocCreateInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
 
 		VmaAllocation allocation;
 		vmaCreateBuffer(s_Data->Allocator, &bufferCreateInfo, &allocCreateInfo, &outBuffer, &allocation, nullptr);
@@ -66,6 +68,8 @@ namespace Zenith {
 		VmaAllocationInfo allocInfo{};
 		vmaGetAllocationInfo(s_Data->Allocator, allocation, &allocInfo);
 		ZN_ALLOCATOR_LOG("VulkanAllocator ({0}): allocating buffer; size = {1}", m_Tag, Utils::BytesToString(allocInfo.size));
+		if (outMappedData)
+			*outMappedData = allocInfo.pMappedData;
 
 		{
 			s_Data->TotalAllocatedBytes += allocInfo.size;
@@ -217,6 +221,15 @@ namespace Zenith {
 			budget += b.budget;
 
 		GPUMemoryStats result;
+		for (uint32_t heap = 0; heap < memoryProps.memoryHeapCount; heap++)
+		{
+			if (memoryProps.memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+			{
+				result.DeviceLocalUsage += budgets[heap].usage;
+				result.DeviceLocalBudget += budgets[heap].budget;
+			}
+		}
+
 		for (const auto& [k, v] : s_AllocationMap)
 		{
 			if (v.Type == AllocationType::Buffer)
@@ -0,0 +1,399 @@
+#include "znpch.hpp"
+#include "VulkanBindlessDescriptors.hpp"
+
+#include "VulkanAPI.hpp"
+#include "VulkanContext.hpp"
+#include "VulkanStorageBuffer.hpp"
+#include "VulkanTexture.hpp"
+
+#include "Zenith/Debug/Profiler.hpp"
+#include "Zenith/Renderer/Renderer.hpp"
+
+#include <mutex>
+
+namespace Zenith {
+
+	struct BindlessFrame
+	{
+		VkDescriptorSet DescriptorSet = nullptr;
+		Ref<VulkanStorageBuffer> MaterialBuffer;
+		bool MaterialBufferWritten = false;
+
+		// Per texture index, what the set currently points at
+		std::vector<VkDescriptorImageInfo> WrittenTextures;
+		// Byte offset and size of material data changed since the frame's buffer was last uploaded
+		std::vector<std::pair<uint32_t, uint32_t>> DirtyMaterialRanges;
+	};
+
+	struct VulkanBindlessData
+	{
+		VkDescriptorPool DescriptorPool = nullptr;
+		uint32_t MaxTextureCount = 0;
+
+		std::mutex Mutex; // materials and textures are set up on the main thread and the asset workers
+		std::unordered_map<const Texture2D*, uint32_t> TextureIndices;
+		std::vector<const Texture2D*> TextureKeys;
+		std::vector<uint32_t> TextureRefCounts;
+		std::vector<uint32_t> FreeTextureIndices; // only once no frame in flight samples them
+		uint32_t TextureCount = 0;
+		std::vector<uint32_t> FreeMaterialIndices;
+		uint32_t MaterialCount = 0;
+
+		// Render thread
+		std::vector<Ref<Texture2D>> RT_Textures;
+		uint32_t RT_TextureCount = 0; // highest registered index + 1
+		Buffer RT_MaterialData;
+		std::vector<BindlessFrame> Frames;
+		std::vector<VkWriteDescriptorSet> RT_PendingWrites;
+	};
+
+	static VulkanBindlessData* s_Data = nullptr;
+
+	static std::mutex s_LayoutMutex;
+	static VkDescriptorSetLayout s_DescriptorSetLayout = nullptr;
+
+	namespace Utils {
+
+		static uint32_t GetBindlessTextureCount()
+		{
+			const auto& properties = VulkanContext::GetCurrentDevice()->GetPhysicalDevice()->GetDescriptorIndexingProperties();
+			return std::min({ VulkanBindlessDescriptors::MaxTextures,
+				properties.maxDescriptorSetUpdateAfterBindSampledImages,
+				properties.maxPerStageDescriptorUpdateAfterBindSampledImages });
+		}
+
+		static bool IsSameImage(const VkDescriptorImageInfo& a, const VkDescriptorImageInfo& b)
+		{
+			return a.imageView == b.imageView && a.sampler == b.sampler && a.imageLayout == b.imageLayout;
+		}
+
+	}
+
+	bool VulkanBindlessDescriptors::IsEnabled()
+	{
+		return VulkanContext::GetCurrentDevice()->IsBindlessEnabled();
+	}
+
+	VkDescriptorSetLayout VulkanBindlessDescriptors::GetDescriptorSetLayout()
+	{
+		std::scoped_lock lock(s_LayoutMutex);
+		if (s_DescriptorSetLayout)
+			return s_DescriptorSetLayout;
+
+		VkDescriptorSetLayoutBinding bindings[2] = {};
+		bindings[0].binding = TextureBinding;
+		bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		bindings[0].descriptorCount = Utils::GetBindlessTextureCount();
+		bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+
+		bindings[1].binding = MaterialBinding;
+		bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[1].descriptorCount = 1;
+		bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+
+		// Unused texture slots stay unwritten, and slots are written while other frames are still in flight
+		VkDescriptorBindingFlags bindingFlags[2] = {
+			VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT,
+			0
+		};
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {};
+		bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		bindingFlagsInfo.bindingCount = 2;
+		bindingFlagsInfo.pBindingFlags = bindingFlags;
+
+		VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+		layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layoutInfo.pNext = &bindingFlagsInfo;
+		layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+		layoutInfo.bindingCount = 2;
+		layoutInfo.pBindings = bindings;
+
+		VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
+		VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &s_DescriptorSetLayout));
+		VKUtils::SetDebugUtilsObjectName(device, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, "Bindless", s_DescriptorSetLayout);
+		return s_DescriptorSetLayout;
+	}
+
+	void VulkanBindlessDescriptors::Init()
+	{
+		if (!IsEnabled())
+			return;
+
+		s_Data = znew VulkanBindlessData();
+		s_Data->MaxTextureCount = Utils::GetBindlessTextureCount();
+		s_Data->TextureKeys.resize(s_Data->MaxTextureCount);
+		s_Data->TextureRefCounts.resize(s_Data->MaxTextureCount);
+		s_Data->RT_Textures.resize(s_Data->MaxTextureCount);
+		s_Data->RT_MaterialData.Allocate(MaxMaterials * MaterialStride);
+		s_Data->RT_MaterialData.ZeroInitialize();
+
+		const uint32_t framesInFlight = Renderer::GetConfig().FramesInFlight;
+
+		VkDescriptorPoolSize poolSizes[] = {
+			{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, s_Data->MaxTextureCount * framesInFlight },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight }
+		};
+
+		VkDescriptorPoolCreateInfo poolInfo = {};
+		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+		poolInfo.maxSets = framesInFlight;
+		poolInfo.poolSizeCount = (uint32_t)std::size(poolSizes);
+		poolInfo.pPoolSizes = poolSizes;
+
+		VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
+		VK_CHECK_RESULT(vkCreateDescriptorPool(device, &poolInfo, nullptr, &s_Data->DescriptorPool));
+
+		std::vector<VkDescriptorSetLayout> layouts(framesInFlight, GetDescriptorSetLayout());
+		std::vector<VkDescriptorSet> descriptorSets(framesInFlight);
+		VkDescriptorSetAllocateInfo allocInfo = Vulkan::DescriptorSetAllocInfo(layouts.data(), framesInFlight, s_Data->DescriptorPool);
+		VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data()));
+
+		StorageBufferSpecification bufferSpec;
+		bufferSpec.GPUOnly = false;
+		bufferSpec.DebugName = "BindlessMaterials";
+
+		s_Data->Frames.resize(framesInFlight);
+		for (uint32_t i = 0; i < framesInFlight; i++)
+		{
+			BindlessFrame& frame = s_Data->Frames[i];
+			frame.DescriptorSet = descriptorSets[i];
+			frame.MaterialBuffer = Ref<VulkanStorageBuffer>::Create(MaxMaterials * MaterialStride, bufferSpec);
+			frame.WrittenTextures.resize(s_Data->MaxTextureCount);
+		}
+
+		const uint32_t whiteTextureIndex = RegisterTexture(Renderer::GetWhiteTexture());
+		ZN_CORE_VERIFY(whiteTextureIndex == WhiteTextureIndex);
+
+		ZN_CORE_INFO_TAG("Renderer", "Bindless materials enabled: {} textures, {} materials", s_Data->MaxTextureCount, MaxMaterials);
+	}
+
+	void VulkanBindlessDescriptors::Shutdown()
+	{
+		VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
+		if (s_Data)
+		{
+			vkDestroyDescriptorPool(device, s_Data->DescriptorPool, nullptr);
+			s_Data->RT_MaterialData.Release();
+			delete s_Data;
+			s_Data = nullptr;
+		}
+
+		std::scoped_lock lock(s_LayoutMutex);
+		if (s_DescriptorSetLayout)
+		{
+			vkDestroyDescriptorSetLayout(device, s_DescriptorSetLayout, nullptr);
+			s_DescriptorSetLayout = nullptr;
+		}
+	}
+
+	uint32_t VulkanBindlessDescriptors::RegisterTexture(const Ref<Texture2D>& texture)
+	{
+		if (!s_Data || !texture)
+			return WhiteTextureIndex;
+
+		uint32_t index;
+		{
+			std::scoped_lock lock(s_Data->Mutex);
+			if (auto it = s_Data->TextureIndices.find(texture.Raw()); it != s_Data->TextureIndices.end())
+			{
+				s_Data->TextureRefCounts[it->second]++;
+				return it->second;
+			}
+
+			if (!s_Data->FreeTextureIndices.empty())
+			{
+				index = s_Data->FreeTextureIndices.back();
+				s_Data->FreeTextureIndices.pop_back();
+			}
+			else if (s_Data->TextureCount < s_Data->MaxTextureCount)
+			{
+				index = s_Data->TextureCount++;
+			}
+			else
+			{
+				ZN_CORE_ERROR_TAG("Renderer", "Out of bindless texture slots ({}), using the white texture", s_Data->MaxTextureCount);
+				return WhiteTextureIndex;
+			}
+
+			s_Data->TextureIndices[texture.Raw()] = index;
+			s_Data->TextureKeys[index] = texture.Raw();
+			s_Data->TextureRefCounts[index] = 1;
+		}
+
+		Renderer::Submit([index, texture]() mutable
+		{
+			s_Data->RT_Textures[index] = texture;
+			s_Data->RT_TextureCount = std::max(s_Data->RT_TextureCount, index + 1);
+		});
+		return index;
+	}
+
+	void VulkanBindlessDescriptors::UnregisterTexture(uint32_t index)
+	{
+		// Materials can outlive the renderer
+		if (!s_Data || index == WhiteTextureIndex || index == InvalidIndex)
+			return;
+
+		{
+			std::scoped_lock lock(s_Data->Mutex);
+			ZN_CORE_ASSERT(s_Data->TextureRefCounts[index] > 0);
+			if (--s_Data->TextureRefCounts[index] > 0)
+				return;
+
+			s_Data->TextureIndices.erase(s_Data->TextureKeys[index]);
+			s_Data->TextureKeys[index] = nullptr;
+		}
+
+		Renderer::SubmitResourceFree([index]()
+		{
+			// Release queues are flushed after shutdown
+			if (!s_Data)
+				return;
+
+			s_Data->RT_Textures[index] = nullptr;
+
+			std::scoped_lock lock(s_Data->Mutex);
+			s_Data->FreeTextureIndices.push_back(index);
+		});
+	}
+
+	uint32_t VulkanBindlessDescriptors::AllocateMaterial()
+	{
+		if (!s_Data)
+			return InvalidIndex;
+
+		std::scoped_lock lock(s_Data->Mutex);
+		if (!s_Data->FreeMaterialIndices.empty())
+		{
+			const uint32_t index = s_Data->FreeMaterialIndices.back();
+			s_Data->FreeMaterialIndices.pop_back();
+			return index;
+		}
+
+		if (s_Data->MaterialCount == MaxMaterials)
+		{
+			ZN_CORE_ERROR_TAG("Renderer", "Out of bindless material slots ({})", MaxMaterials);
+			return InvalidIndex;
+		}
+		return s_Data->MaterialCount++;
+	}
+
+	void VulkanBindlessDescriptors::FreeMaterial(uint32_t index)
+	{
+		if (!s_Data || index == InvalidIndex)
+			return;
+
+		Renderer::SubmitResourceFree([index]()
+		{
+			if (!s_Data)
+				return;
+
+			std::scoped_lock lock(s_Data->Mutex);
+			s_Data->FreeMaterialIndices.push_back(index);
+		});
+	}
+
+	void VulkanBindlessDescriptors::SetMaterialData(uint32_t index, Buffer data, uint32_t offset)
+	{
+		if (!s_Data || index == InvalidIndex || !data)
+			return;
+
+		ZN_CORE_VERIFY(offset + data.Size <= MaterialStride, "Material parameters do not fit into a bindless material slot");
+		Buffer copy = Buffer::Copy(data);
+		Renderer::Submit([index, copy, offset]() mutable
+		{
+			const uint32_t slotOffset = index * MaterialStride + offset;
+			memcpy(s_Data->RT_MaterialData.As<byte>() + slotOffset, copy.Data, copy.Size);
+
+			// Draws already recorded this frame read the same buffer, so every frame (the current one included) picks the change up in RT_Update
+			for (BindlessFrame& frame : s_Data->Frames)
+				frame.DirtyMaterialRanges.emplace_back(slotOffset, (uint32_t)copy.Size);
+			copy.Release();
+		});
+	}
+
+	void VulkanBindlessDescriptors::RT_Update(uint32_t frameIndex)
+	{
+		if (!s_Data)
+			return;
+
+		ZN_PROFILE_FUNC();
+
+		BindlessFrame& frame = s_Data->Frames[frameIndex];
+		std::vector<VkWriteDescriptorSet>& writes = s_Data->RT_PendingWrites;
+		writes.clear();
+
+		if (!frame.MaterialBufferWritten)
+		{
+			VkWriteDescriptorSet& write = writes.emplace_back();
+			write = {};
+			write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			write.dstSet = frame.DescriptorSet;
+			write.dstBinding = MaterialBinding;
+			write.descriptorCount = 1;
+			write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			write.pBufferInfo = &frame.MaterialBuffer->GetDescriptorBufferInfo();
+			frame.MaterialBufferWritten = true;
+		}
+
+		// Compared every frame, streamed textures swap their image views without re-registering
+		for (uint32_t index = 0; index < s_Data->RT_TextureCount; index++)
+		{
+			const Ref<Texture2D>& texture = s_Data->RT_Textures[index];
+			if (!texture)
+				continue;
+
+			const VkDescriptorImageInfo& imageInfo = texture.As<VulkanTexture2D>()->GetDescriptorInfoVulkan();
+			VkDescriptorImageInfo& written = frame.WrittenTextures[index];
+			if (!imageInfo.imageView || Utils::IsSameImage(imageInfo, written))
+				continue;
+
+			written = imageInfo;
+
+			// Neighbouring slots go into one write
+			if (!writes.empty() && writes.back().dstBinding == TextureBinding && writes.back().dstArrayElement + writes.back().descriptorCount == index)
+			{
+				writes.back().descriptorCount++;
+				continue;
+			}
+
+			VkWriteDescriptorSet& write = writes.emplace_back();
+			write = {};
+			write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			write.dstSet = frame.DescriptorSet;
+			write.dstBinding = TextureBinding;
+			write.dstArrayElement = index;
+			write.descriptorCount = 1;
+			write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			write.pImageInfo = &written;
+		}
+
+		if (!writes.empty())
+		{
+			VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
+			vkUpdateDescriptorSets(device, (uint32_t)writes.size(), writes.data(), 0, nullptr);
+		}
+
+		// Only the changed bytes, overlapping and touching ranges are merged
+		auto& ranges = frame.DirtyMaterialRanges;
+		std::sort(ranges.begin(), ranges.end());
+		for (size_t i = 0; i < ranges.size();)
+		{
+			const uint32_t offset = ranges[i].first;
+			uint32_t end = offset + ranges[i].second;
+			for (i++; i < ranges.size() && ranges[i].first <= end; i++)
+				end = std::max(end, ranges[i].first + ranges[i].second);
+
+			frame.MaterialBuffer->RT_SetData(s_Data->RT_MaterialData.As<byte>() + offset, end - offset, offset);
+		}
+		ranges.clear();
+	}
+
+	VkDescriptorSet VulkanBindlessDescriptors::RT_GetDescriptorSet(uint32_t frameIndex)
+	{
+		return s_Data ? s_Data->Frames[frameIndex].DescriptorSet : nullptr;
+	}
+
+}
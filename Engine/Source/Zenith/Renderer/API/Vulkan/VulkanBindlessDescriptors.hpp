@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Zenith/Core/Buffer.hpp"
+#include "Zenith/Renderer/Texture.hpp"
+
+#include "vulkan/vulkan.h"
+
+namespace Zenith {
+
+	// One descriptor set shared by every shader that includes Bindless.glslh: a partially bound array of all registered
+	// textures and a storage buffer with the parameters of all materials. Draws pick their material with a push constant
+	// instead of binding per-material sets. Only used when the device supports descriptor indexing.
+	class VulkanBindlessDescriptors
+	{
+	public:
+		static constexpr uint32_t DescriptorSet = 3;
+		static constexpr uint32_t TextureBinding = 0;
+		static constexpr uint32_t MaterialBinding = 1;
+
+		// Must match BINDLESS_MATERIAL_STRIDE in Bindless.glslh
+		static constexpr uint32_t MaterialStride = 256;
+		static constexpr uint32_t MaxMaterials = 4096;
+		static constexpr uint32_t MaxTextures = 16384;
+
+		static constexpr uint32_t InvalidIndex = UINT32_MAX;
+		static constexpr uint32_t WhiteTextureIndex = 0;
+
+		static bool IsEnabled();
+
+		// Called by the renderer after the default textures exist, the layout is available before that
+		static void Init();
+		static void Shutdown();
+
+		// Created on first use, shaders are loaded before the renderer is initialized
+		static VkDescriptorSetLayout GetDescriptorSetLayout();
+
+		// Textures are reference counted, registering one again returns the same index
+		static uint32_t RegisterTexture(const Ref<Texture2D>& texture);
+		static void UnregisterTexture(uint32_t index);
+
+		static uint32_t AllocateMaterial();
+		static void FreeMaterial(uint32_t index);
+		// Copies data to offset within the material's slot, draws see it from the next frame on (a frame never mixes old and new values)
+		static void SetMaterialData(uint32_t index, Buffer data, uint32_t offset = 0);
+
+		// Once per frame on the render thread: writes changed (or streamed) textures and uploads changed materials into the frame's set
+		static void RT_Update(uint32_t frameIndex);
+		static VkDescriptorSet RT_GetDescriptorSet(uint32_t frameIndex);
+	};
+
+}
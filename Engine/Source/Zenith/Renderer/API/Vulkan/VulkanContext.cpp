@@ -272,6 +272,9 @@ namespace Zenith {
 		enabledFeatures.independentBlend = deviceFeatures.independentBlend;
 		enabledFeatures.pipelineStatisticsQuery = deviceFeatures.pipelineStatisticsQuery;
 		enabledFeatures.shaderStorageImageReadWithoutFormat = deviceFeatures.shaderStorageImageReadWithoutFormat;
+		enabledFeatures.textureCompressionBC = deviceFeatures.textureCompressionBC;
+		enabledFeatures.multiDrawIndirect = deviceFeatures.multiDrawIndirect;
+		enabledFeatures.drawIndirectFirstInstance = deviceFeatures.drawIndirectFirstInstance;
 		m_Device = Ref<VulkanDevice>::Create(m_PhysicalDevice, enabledFeatures);
 
 		VulkanAllocator::Init(m_Device);
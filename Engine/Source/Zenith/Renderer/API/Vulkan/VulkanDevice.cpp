@@ -3,6 +3,7 @@
 
 #include "VulkanContext.hpp"
 #include "Zenith/Core/Assert.hpp"
+#include "Zenith/Renderer/Renderer.hpp"
 
 namespace Zenith {
 
@@ -43,6 +44,18 @@ namespace Zenith {
 		m_PhysicalDevice = selectedPhysicalDevice;
 
 		vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &m_Features);
+
+		// Core in Vulkan 1.2, older drivers may only report it through VK_EXT_descriptor_indexing
+		m_DescriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+		VkPhysicalDeviceFeatures2 features2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+		features2.pNext = &m_DescriptorIndexingFeatures;
+		vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &features2);
+
+		m_DescriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+		VkPhysicalDeviceProperties2 properties2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+		properties2.pNext = &m_DescriptorIndexingProperties;
+		vkGetPhysicalDeviceProperties2(m_PhysicalDevice, &properties2);
+
 		vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &m_MemoryProperties);
 
 		uint32_t queueFamilyCount;
@@ -234,6 +247,16 @@ namespace Zenith {
 		return UINT32_MAX;
 	}
 
+	bool VulkanPhysicalDevice::IsBindlessSupported() const
+	{
+		const VkPhysicalDeviceDescriptorIndexingFeatures& features = m_DescriptorIndexingFeatures;
+		return features.runtimeDescriptorArray
+			&& features.descriptorBindingPartiallyBound
+			&& features.descriptorBindingSampledImageUpdateAfterBind
+			&& features.descriptorBindingUpdateUnusedWhilePending
+			&& features.shaderSampledImageArrayNonUniformIndexing;
+	}
+
 	Ref<VulkanPhysicalDevice> VulkanPhysicalDevice::Select()
 	{
 		return Ref<VulkanPhysicalDevice>::Create();
@@ -266,6 +289,25 @@ namespace Zenith {
 		// If a pNext(Chain) has been passed, we need to add it to the device creation info
 		VkPhysicalDeviceFeatures2 physicalDeviceFeatures2{};
 
+		VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES };
+		if (Renderer::GetConfig().BindlessMaterials && m_PhysicalDevice->IsBindlessSupported())
+		{
+			descriptorIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+			descriptorIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+			descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+			descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			deviceCreateInfo.pNext = &descriptorIndexingFeatures;
+
+			if (m_PhysicalDevice->IsExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+				deviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+			m_EnableBindless = true;
+		}
+		else if (Renderer::GetConfig().BindlessMaterials)
+		{
+			ZN_CORE_WARN_TAG("Renderer", "Descriptor indexing is not supported, bindless materials are disabled");
+		}
+
 		// Enable the debug marker extension if it is present (likely meaning a debugging tool is present)
 		if (m_PhysicalDevice->IsExtensionSupported(VK_EXT_DEBUG_MARKER_EXTENSION_NAME))
 		{
@@ -33,6 +33,11 @@ namespace Zenith {
 		const VkPhysicalDeviceFeatures& GetFeatures() const { return m_Features; }
 		const VkPhysicalDeviceLimits& GetLimits() const { return m_Properties.limits; }
 		const VkPhysicalDeviceMemoryProperties& GetMemoryProperties() const { return m_MemoryProperties; }
+		const VkPhysicalDeviceDescriptorIndexingFeatures& GetDescriptorIndexingFeatures() const { return m_DescriptorIndexingFeatures; }
+		const VkPhysicalDeviceDescriptorIndexingProperties& GetDescriptorIndexingProperties() const { return m_DescriptorIndexingProperties; }
+
+		// Partially bound, update-after-bind sampled image arrays indexed per draw
+		bool IsBindlessSupported() const;
 
 		VkFormat GetDepthFormat() const { return m_DepthFormat; }
 
@@ -51,6 +56,8 @@ namespace Zenith {
 		VkPhysicalDeviceProperties m_Properties;
 		VkPhysicalDeviceFeatures m_Features;
 		VkPhysicalDeviceMemoryProperties m_MemoryProperties;
+		VkPhysicalDeviceDescriptorIndexingFeatures m_DescriptorIndexingFeatures{};
+		VkPhysicalDeviceDescriptorIndexingProperties m_DescriptorIndexingProperties{};
 
 		VkFormat m_DepthFormat = VK_FORMAT_UNDEFINED;
 
@@ -99,6 +106,10 @@ namespace Zenith {
 
 		const Ref<VulkanPhysicalDevice>& GetPhysicalDevice() const { return m_PhysicalDevice; }
 		VkDevice GetVulkanDevice() const { return m_LogicalDevice; }
+
+		bool IsBindlessEnabled() const { return m_EnableBindless; }
+		// Many indirect draws per call, each with its own first instance
+		bool IsMultiDrawIndirectEnabled() const { return m_EnabledFeatures.multiDrawIndirect && m_EnabledFeatures.drawIndirectFirstInstance; }
 	private:
 		Ref<VulkanCommandPool> GetThreadLocalCommandPool();
 		Ref<VulkanCommandPool> GetOrCreateThreadLocalCommandPool();
@@ -118,6 +129,7 @@ namespace Zenith {
 
 		std::map<std::thread::id, Ref<VulkanCommandPool>> m_CommandPools;
 		bool m_EnableDebugMarkers = false;
+		bool m_EnableBindless = false;
 
 		std::mutex m_GraphicsQueueMutex, m_ComputeQueueMutex;
 	};
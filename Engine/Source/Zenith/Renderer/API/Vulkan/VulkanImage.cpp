@@ -154,7 +154,6 @@ namespace Zenith {
 		VK_CHECK_RESULT(vkCreateImageView(device, &imageViewCreateInfo, nullptr, &m_Info.ImageView));
 		VKUtils::SetDebugUtilsObjectName(device, VK_OBJECT_TYPE_IMAGE_VIEW, std::format("{} default image view", m_Specification.DebugName), m_Info.ImageView);
 
-		// TODO: Renderer should contain some kind of sampler cache
 		if (m_Specification.CreateSampler)
 		{
 			VkSamplerCreateInfo samplerCreateInfo = {};
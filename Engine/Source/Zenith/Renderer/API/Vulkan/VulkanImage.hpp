@@ -143,6 +143,15 @@ namespace Zenith {
 			case ImageFormat::DEPTH32FSTENCIL8UINT: return VK_FORMAT_D32_SFLOAT_S8_UINT;
 			case ImageFormat::DEPTH32F:             return VK_FORMAT_D32_SFLOAT;
 			case ImageFormat::DEPTH24STENCIL8:      return VulkanContext::GetCurrentDevice()->GetPhysicalDevice()->GetDepthFormat();
+			case ImageFormat::BC1:                  return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+			case ImageFormat::BC1_SRGB:             return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+			case ImageFormat::BC3:                  return VK_FORMAT_BC3_UNORM_BLOCK;
+			case ImageFormat::BC3_SRGB:             return VK_FORMAT_BC3_SRGB_BLOCK;
+			case ImageFormat::BC4:                  return VK_FORMAT_BC4_UNORM_BLOCK;
+			case ImageFormat::BC5:                  return VK_FORMAT_BC5_UNORM_BLOCK;
+			case ImageFormat::BC6H:                 return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+			case ImageFormat::BC7:                  return VK_FORMAT_BC7_UNORM_BLOCK;
+			case ImageFormat::BC7_SRGB:             return VK_FORMAT_BC7_SRGB_BLOCK;
 			}
 			ZN_CORE_ASSERT(false);
 			return VK_FORMAT_UNDEFINED;
@@ -7,13 +7,13 @@
 
 namespace Zenith {
 
-	VulkanIndexBuffer::VulkanIndexBuffer(uint64_t size)
-		: m_Size(size)
+	VulkanIndexBuffer::VulkanIndexBuffer(uint64_t size, IndexType type)
+		: m_Size(size), m_IndexType(type)
 	{
 	}
 
-	VulkanIndexBuffer::VulkanIndexBuffer(void* data, uint64_t size)
-		: m_Size(size)
+	VulkanIndexBuffer::VulkanIndexBuffer(void* data, uint64_t size, IndexType type)
+		: m_Size(size), m_IndexType(type)
 	{
 		m_LocalData = Buffer::Copy(data, size);
 
@@ -41,7 +41,8 @@ namespace Zenith {
 			VkBufferCreateInfo indexBufferCreateInfo = {};
 			indexBufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 			indexBufferCreateInfo.size = instance->m_Size;
-			indexBufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+			// Source of copies into the MeshPool
+			indexBufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
 			instance->m_MemoryAllocation = allocator.AllocateBuffer(indexBufferCreateInfo, VMA_MEMORY_USAGE_GPU_ONLY, instance->m_VulkanBuffer);
 
 			VkCommandBuffer copyCmd = device->GetCommandBuffer(true);
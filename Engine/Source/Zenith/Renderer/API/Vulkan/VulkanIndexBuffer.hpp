@@ -11,21 +11,24 @@ namespace Zenith {
 	class VulkanIndexBuffer : public IndexBuffer
 	{
 	public:
-		VulkanIndexBuffer(uint64_t size);
-		VulkanIndexBuffer(void* data, uint64_t size = 0);
+		VulkanIndexBuffer(uint64_t size, IndexType type = IndexType::UInt32);
+		VulkanIndexBuffer(void* data, uint64_t size = 0, IndexType type = IndexType::UInt32);
 		virtual ~VulkanIndexBuffer();
 
 		virtual void SetData(void* buffer, uint64_t size, uint64_t offset = 0) override;
 		virtual void Bind() const override;
 
-		virtual uint32_t GetCount() const override { return m_Size / sizeof(uint32_t); }
+		virtual uint32_t GetCount() const override { return (uint32_t)(m_Size / GetIndexTypeSize(m_IndexType)); }
+		virtual IndexType GetIndexType() const override { return m_IndexType; }
 
 		virtual uint64_t GetSize() const override { return m_Size; }
 		virtual RendererID GetRendererID() const override;
 
 		VkBuffer GetVulkanBuffer() { return m_VulkanBuffer; }
+		VkIndexType GetVulkanIndexType() const { return m_IndexType == IndexType::UInt16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32; }
 	private:
 		uint64_t m_Size = 0;
+		IndexType m_IndexType = IndexType::UInt32;
 		Buffer m_LocalData;
 
 		VkBuffer m_VulkanBuffer = nullptr;
@@ -33,12 +33,26 @@ namespace Zenith {
 		Renderer::RegisterShaderDependency(m_Shader, this);
 
 		auto vulkanMaterial = material.As<VulkanMaterial>();
+		m_UniformStorageBuffer.Release();
 		m_UniformStorageBuffer = Buffer::Copy(vulkanMaterial->m_UniformStorageBuffer.Data, vulkanMaterial->m_UniformStorageBuffer.Size);
 		m_DescriptorSetManager = DescriptorSetManager::Copy(vulkanMaterial->m_DescriptorSetManager);
+
+		if (m_BindlessIndex != VulkanBindlessDescriptors::InvalidIndex)
+		{
+			m_BindlessTextures = vulkanMaterial->m_BindlessTextures;
+			for (const auto& [name, bindlessTexture] : m_BindlessTextures)
+				VulkanBindlessDescriptors::RegisterTexture(bindlessTexture.Texture);
+
+			MarkBindlessMaterialDirty();
+		}
 	}
 
 	VulkanMaterial::~VulkanMaterial()
 	{
+		for (const auto& [name, bindlessTexture] : m_BindlessTextures)
+			VulkanBindlessDescriptors::UnregisterTexture(bindlessTexture.Index);
+		VulkanBindlessDescriptors::FreeMaterial(m_BindlessIndex);
+
 		m_UniformStorageBuffer.Release();
 	}
 
@@ -57,22 +71,11 @@ namespace Zenith {
 		dmSpec.DefaultResources = true;
 		m_DescriptorSetManager = DescriptorSetManager(dmSpec);
 
-		for (const auto& [name, decl] : m_DescriptorSetManager.InputDeclarations)
+		// Texture indices start out as 0, the white texture
+		if (m_Shader->HasBindlessMaterial() && m_Shader->GetShaderBuffers().contains("MaterialUniformBuffer"))
 		{
-			switch (decl.Type)
-			{
-				case RenderPassInputType::UniformBuffer:
-				case RenderPassInputType::StorageBuffer:
-				case RenderPassInputType::ImageSampler1D:
-				case RenderPassInputType::ImageSampler2D:
-				case RenderPassInputType::ImageSampler3D:
-				case RenderPassInputType::StorageImage1D:
-				case RenderPassInputType::StorageImage2D:
-				case RenderPassInputType::StorageImage3D:
-					break;
-				default:
-					break;
-			}
+			m_BindlessIndex = VulkanBindlessDescriptors::AllocateMaterial();
+			MarkBindlessMaterialDirty();
 		}
 	}
 
@@ -138,40 +141,70 @@ namespace Zenith {
 		//Init();
 	}
 
-	const ShaderUniform* VulkanMaterial::FindUniformDeclaration(const std::string& name)
+	const ShaderResourceDeclaration* VulkanMaterial::FindResourceDeclaration(const std::string& name)
+	{
+		auto& resources = m_Shader->GetResources();
+		if (resources.find(name) != resources.end())
+			return &resources.at(name);
+
+		return nullptr;
+	}
+
+	bool VulkanMaterial::SetBindlessTexture(const std::string& name, const Ref<Texture2D>& texture)
 	{
 		const auto& shaderBuffers = m_Shader->GetShaderBuffers();
+		const auto& uniforms = shaderBuffers.at("MaterialUniformBuffer").Uniforms;
+		if (!uniforms.contains(name))
+			return false;
+
+		BindlessTexture& bindlessTexture = m_BindlessTextures[name];
+		if (bindlessTexture.Texture == texture)
+			return true;
+
+		// Registered before the old one is released so swapping between two uses of a texture keeps its index
+		const uint32_t index = VulkanBindlessDescriptors::RegisterTexture(texture);
+		VulkanBindlessDescriptors::UnregisterTexture(bindlessTexture.Index);
+		bindlessTexture.Texture = texture;
+		bindlessTexture.Index = index;
+
+		Set<uint32_t>(name, index);
+		return true;
+	}
 
-		if (shaderBuffers.contains("MaterialUniformBuffer"))
+	void VulkanMaterial::MarkBindlessMaterialDirty()
+	{
+		m_DirtyBegin = 0;
+		m_DirtyEnd = m_Shader->GetShaderBuffers().at("MaterialUniformBuffer").Size;
+	}
+
+	void VulkanMaterial::SetParameterData(const MaterialParameter& parameter, const void* data, uint32_t size)
+	{
+		if (parameter.LayoutVersion != m_Shader->GetParameterLayoutVersion())
 		{
-			const ShaderBuffer& materialBuffer = shaderBuffers.at("MaterialUniformBuffer");
-			if (materialBuffer.Uniforms.find(name) != materialBuffer.Uniforms.end())
-			{
-				return &materialBuffer.Uniforms.at(name);
-			}
+			ZN_CORE_ERROR_TAG("Renderer", "Material parameter of '{}' is from another shader or an earlier variant of it", m_Name);
+			return;
 		}
 
-		for (const auto& [bufferName, buffer] : shaderBuffers)
-		{
-			if (bufferName == "MaterialUniformBuffer")
-				continue;
+		// Only the bytes of the value are written, the rest of a larger uniform is left as is
+		size = std::min(size, parameter.Size);
+		m_UniformStorageBuffer.Write(data, size, parameter.Offset);
 
-			if (buffer.Uniforms.find(name) != buffer.Uniforms.end())
-			{
-				return &buffer.Uniforms.at(name);
-			}
+		// Uniforms of push constant blocks share the storage buffer but are not part of the bindless material
+		if (m_BindlessIndex != VulkanBindlessDescriptors::InvalidIndex && parameter.InMaterialBuffer)
+		{
+			m_DirtyBegin = std::min(m_DirtyBegin, parameter.Offset);
+			m_DirtyEnd = std::max(m_DirtyEnd, parameter.Offset + size);
 		}
-
-		return nullptr;
 	}
 
-	const ShaderResourceDeclaration* VulkanMaterial::FindResourceDeclaration(const std::string& name)
+	void VulkanMaterial::FlushParameters()
 	{
-		auto& resources = m_Shader->GetResources();
-		if (resources.find(name) != resources.end())
-			return &resources.at(name);
+		if (m_DirtyBegin >= m_DirtyEnd)
+			return;
 
-		return nullptr;
+		VulkanBindlessDescriptors::SetMaterialData(m_BindlessIndex, Buffer(m_UniformStorageBuffer.As<byte>() + m_DirtyBegin, m_DirtyEnd - m_DirtyBegin), m_DirtyBegin);
+		m_DirtyBegin = UINT32_MAX;
+		m_DirtyEnd = 0;
 	}
 
 	void VulkanMaterial::SetVulkanDescriptor(const std::string& name, const Ref<Texture2D>& texture)
@@ -264,6 +297,9 @@ namespace Zenith {
 
 	void VulkanMaterial::Set(const std::string& name, const Ref<Texture2D>& texture)
 	{
+		if (m_BindlessIndex != VulkanBindlessDescriptors::InvalidIndex && SetBindlessTexture(name, texture))
+			return;
+
 		SetVulkanDescriptor(name, texture);
 	}
 
@@ -334,6 +370,9 @@ namespace Zenith {
 
 	Ref<Texture2D> VulkanMaterial::GetTexture2D(const std::string& name)
 	{
+		if (auto it = m_BindlessTextures.find(name); it != m_BindlessTextures.end())
+			return it->second.Texture;
+
 		return GetResource<Texture2D>(name);
 	}
 
@@ -344,6 +383,9 @@ namespace Zenith {
 
 	Ref<Texture2D> VulkanMaterial::TryGetTexture2D(const std::string& name)
 	{
+		if (auto it = m_BindlessTextures.find(name); it != m_BindlessTextures.end())
+			return it->second.Texture;
+
 		return TryGetResource<Texture2D>(name);
 	}
 
@@ -5,6 +5,7 @@
 #include "Zenith/Renderer/API/Vulkan/VulkanShader.hpp"
 #include "Zenith/Renderer/API/Vulkan/VulkanImage.hpp"
 #include "Zenith/Renderer/API/Vulkan/DescriptorSetManager.hpp"
+#include "Zenith/Renderer/API/Vulkan/VulkanBindlessDescriptors.hpp"
 
 namespace Zenith {
 
@@ -53,28 +54,39 @@ namespace Zenith {
 		virtual Ref<Texture2D> TryGetTexture2D(const std::string& name) override;
 		virtual Ref<TextureCube> TryGetTextureCube(const std::string& name) override;
 
+		virtual MaterialParameter GetParameter(const std::string& name) override { return m_Shader->GetMaterialParameter(name); }
+
+		using Material::Set;
+
 		template <typename T>
 		void Set(const std::string& name, const T& value)
 		{
-			auto decl = FindUniformDeclaration(name);
-			if (!decl)
+			const MaterialParameter parameter = GetParameter(name);
+			if (!parameter)
 			{
 				ZN_CORE_ERROR_TAG("Renderer", "Could not find uniform declaration for '{}'", name);
-				ZN_CORE_ASSERT(decl, "Could not find uniform declaration!");
+				ZN_CORE_ASSERT(parameter, "Could not find uniform declaration!");
 				return;
 			}
 
-			auto& buffer = m_UniformStorageBuffer;
-			buffer.Write((byte*)&value, decl->GetSize(), decl->GetOffset());
+			SetParameterData(parameter, &value, sizeof(T));
 		}
 
 		template<typename T>
 		T& Get(const std::string& name)
 		{
-			auto decl = FindUniformDeclaration(name);
-			ZN_CORE_ASSERT(decl, "Could not find uniform with name '{}'", name);
+			const MaterialParameter parameter = GetParameter(name);
+			ZN_CORE_ASSERT(parameter, "Could not find uniform with name '{}'", name);
+
+			// The reference may be written through, e.g. by the material editor
+			if (m_BindlessIndex != VulkanBindlessDescriptors::InvalidIndex && parameter.InMaterialBuffer)
+			{
+				m_DirtyBegin = std::min(m_DirtyBegin, parameter.Offset);
+				m_DirtyEnd = std::max(m_DirtyEnd, parameter.Offset + parameter.Size);
+			}
+
 			auto& buffer = m_UniformStorageBuffer;
-			return buffer.Read<T>(decl->GetOffset());
+			return buffer.Read<T>(parameter.Offset);
 		}
 
 		template<typename T>
@@ -109,6 +121,11 @@ namespace Zenith {
 
 		Buffer GetUniformStorageBuffer() { return m_UniformStorageBuffer; }
 
+		// Slot in the bindless material buffer, InvalidIndex if the shader has no bindless material
+		uint32_t GetBindlessIndex() const { return m_BindlessIndex; }
+		// Uploads the parameters changed since the last flush into the bindless material buffer, once per material and frame before it is drawn
+		void FlushParameters();
+
 		VkDescriptorSet GetDescriptorSet(uint32_t index)
 		{
 			if (m_DescriptorSetManager.GetFirstSetIndex() == UINT32_MAX)
@@ -119,6 +136,8 @@ namespace Zenith {
 		}
 		
 		void Prepare();
+	protected:
+		virtual void SetParameterData(const MaterialParameter& parameter, const void* data, uint32_t size) override;
 	private:
 		void Init();
 		void AllocateStorage();
@@ -129,7 +148,10 @@ namespace Zenith {
 		void SetVulkanDescriptor(const std::string& name, const Ref<Image2D>& image);
 		void SetVulkanDescriptor(const std::string& name, const Ref<ImageView>& image);
 
-		const ShaderUniform* FindUniformDeclaration(const std::string& name);
+		// Bindless textures are uint uniforms holding the texture's index, false if the shader has none with that name
+		bool SetBindlessTexture(const std::string& name, const Ref<Texture2D>& texture);
+		void MarkBindlessMaterialDirty();
+
 		const ShaderResourceDeclaration* FindResourceDeclaration(const std::string& name);
 	private:
 		Ref<VulkanShader> m_Shader;
@@ -156,6 +178,17 @@ namespace Zenith {
 
 		Buffer m_UniformStorageBuffer;
 
+		struct BindlessTexture
+		{
+			Ref<Texture2D> Texture;
+			uint32_t Index = VulkanBindlessDescriptors::InvalidIndex;
+		};
+		uint32_t m_BindlessIndex = VulkanBindlessDescriptors::InvalidIndex;
+		std::unordered_map<std::string, BindlessTexture> m_BindlessTextures;
+		// Bytes of MaterialUniformBuffer not yet uploaded
+		uint32_t m_DirtyBegin = UINT32_MAX;
+		uint32_t m_DirtyEnd = 0;
+
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "znpch.hpp"
+#include "VulkanMeshPool.hpp"
+
+#include "VulkanContext.hpp"
+#include "VulkanIndexBuffer.hpp"
+#include "VulkanVertexBuffer.hpp"
+
+#include "Zenith/Debug/Profiler.hpp"
+#include "Zenith/Renderer/Mesh.hpp"
+#include "Zenith/Renderer/Renderer.hpp"
+#include "Zenith/Utilities/StringUtils.hpp"
+
+#include <format>
+
+namespace Zenith {
+
+	// Of each arena, grown by doubling
+	static constexpr uint64_t s_InitialArenaCapacity = 8 * 1024 * 1024;
+
+	VulkanMeshPool::VulkanMeshPool()
+	{
+		m_Arenas.fill(MeshPoolArena(s_InitialArenaCapacity));
+	}
+
+	VulkanMeshPool::~VulkanMeshPool()
+	{
+		for (const ArenaBuffer& arenaBuffer : m_Buffers)
+		{
+			if (!arenaBuffer.Buffer)
+				continue;
+
+			Renderer::SubmitResourceFree([buffer = arenaBuffer.Buffer, allocation = arenaBuffer.MemoryAlloc]()
+			{
+				VulkanAllocator allocator("MeshPool");
+				allocator.DestroyBuffer(buffer, allocation);
+			});
+		}
+	}
+
+	MeshPool::MeshRange VulkanMeshPool::GetOrAdd(uint64_t key, const Ref<MeshSource>& meshSource)
+	{
+		auto it = m_Entries.find(key);
+		if (it != m_Entries.end())
+		{
+			if (it->second.Source == meshSource.Raw())
+				return it->second.Range;
+
+			// The mesh was reloaded, the range holds the old geometry
+			Release(it->second);
+			m_Entries.erase(it);
+		}
+
+		Ref<VulkanVertexBuffer> vertexBuffer = meshSource->GetVertexBuffer().As<VulkanVertexBuffer>();
+		Ref<VulkanIndexBuffer> indexBuffer = meshSource->GetIndexBuffer().As<VulkanIndexBuffer>();
+		if (!vertexBuffer || !indexBuffer)
+			return {};
+
+		Entry entry;
+		entry.Source = meshSource.Raw();
+		entry.VertexArena = (uint32_t)meshSource->GetVertexFormat();
+		entry.IndexArena = s_VertexArenaCount + (uint32_t)meshSource->GetIndexType();
+		entry.VertexSize = vertexBuffer->GetSize();
+		entry.IndexSize = indexBuffer->GetSize();
+
+		const uint32_t vertexStride = meshSource->GetVertexStride();
+		const uint32_t indexSize = GetIndexTypeSize(meshSource->GetIndexType());
+
+		uint64_t vertexCapacity, indexCapacity;
+		{
+			std::scoped_lock lock(m_ArenaMutex);
+			entry.VertexOffset = m_Arenas[entry.VertexArena].Allocate(entry.VertexSize, vertexStride);
+			entry.IndexOffset = m_Arenas[entry.IndexArena].Allocate(entry.IndexSize, indexSize);
+			vertexCapacity = m_Arenas[entry.VertexArena].GetCapacity();
+			indexCapacity = m_Arenas[entry.IndexArena].GetCapacity();
+		}
+
+		entry.Range.FirstVertex = (uint32_t)(entry.VertexOffset / vertexStride);
+		entry.Range.FirstIndex = (uint32_t)(entry.IndexOffset / indexSize);
+		entry.Range.Valid = true;
+
+		Ref<VulkanMeshPool> instance = this;
+		Renderer::Submit([instance, vertexBuffer, indexBuffer, vertexArena = entry.VertexArena, indexArena = entry.IndexArena, vertexCapacity, indexCapacity,
+			vertexOffset = entry.VertexOffset, indexOffset = entry.IndexOffset, vertexSize = entry.VertexSize, indexBufferSize = entry.IndexSize]() mutable
+		{
+			ZN_PROFILE_FUNC("VulkanMeshPool::Add");
+
+			auto device = VulkanContext::GetCurrentDevice();
+			VkCommandBuffer copyCmd = device->GetCommandBuffer(true);
+
+			instance->RT_Reserve(copyCmd, vertexArena, vertexCapacity);
+			instance->RT_Reserve(copyCmd, indexArena, indexCapacity);
+
+			VkBufferCopy vertexCopy = { 0, vertexOffset, vertexSize };
+			vkCmdCopyBuffer(copyCmd, vertexBuffer->GetVulkanBuffer(), instance->m_Buffers[vertexArena].Buffer, 1, &vertexCopy);
+
+			VkBufferCopy indexCopy = { 0, indexOffset, indexBufferSize };
+			vkCmdCopyBuffer(copyCmd, indexBuffer->GetVulkanBuffer(), instance->m_Buffers[indexArena].Buffer, 1, &indexCopy);
+
+			device->FlushCommandBuffer(copyCmd);
+		});
+
+		return m_Entries.emplace(key, std::move(entry)).first->second.Range;
+	}
+
+	void VulkanMeshPool::Remove(uint64_t key)
+	{
+		auto it = m_Entries.find(key);
+		if (it == m_Entries.end())
+			return;
+
+		Release(it->second);
+		m_Entries.erase(it);
+	}
+
+	void VulkanMeshPool::Release(const Entry& entry)
+	{
+		Ref<VulkanMeshPool> instance = this;
+		Renderer::SubmitResourceFree([instance, vertexArena = entry.VertexArena, indexArena = entry.IndexArena, vertexOffset = entry.VertexOffset,
+			vertexSize = entry.VertexSize, indexOffset = entry.IndexOffset, indexSize = entry.IndexSize]()
+		{
+			std::scoped_lock lock(instance->m_ArenaMutex);
+			instance->m_Arenas[vertexArena].Free(vertexOffset, vertexSize);
+			instance->m_Arenas[indexArena].Free(indexOffset, indexSize);
+		});
+	}
+
+	void VulkanMeshPool::RT_Bind(VkCommandBuffer commandBuffer, VertexFormat vertexFormat, IndexType indexType) const
+	{
+		const ArenaBuffer& vertices = m_Buffers[(uint32_t)vertexFormat];
+		const ArenaBuffer& indices = m_Buffers[s_VertexArenaCount + (uint32_t)indexType];
+		ZN_CORE_VERIFY(vertices.Buffer && indices.Buffer, "Nothing was added to the mesh pool for this vertex format and index type");
+
+		VkDeviceSize offset = 0;
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertices.Buffer, &offset);
+		vkCmdBindIndexBuffer(commandBuffer, indices.Buffer, 0, indexType == IndexType::UInt16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
+	}
+
+	void VulkanMeshPool::RT_Reserve(VkCommandBuffer commandBuffer, uint32_t arenaIndex, uint64_t capacity)
+	{
+		ArenaBuffer& arenaBuffer = m_Buffers[arenaIndex];
+		if (capacity <= arenaBuffer.Size)
+			return;
+
+		const bool vertices = arenaIndex < s_VertexArenaCount;
+
+		VkBufferCreateInfo bufferInfo = {};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = capacity;
+		bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | (vertices ? VK_BUFFER_USAGE_VERTEX_BUFFER_BIT : VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		VulkanAllocator allocator("MeshPool");
+		ArenaBuffer grown;
+		grown.Size = capacity;
+		grown.MemoryAlloc = allocator.AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_GPU_ONLY, grown.Buffer);
+
+		VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
+		VKUtils::SetDebugUtilsObjectName(device, VK_OBJECT_TYPE_BUFFER, std::format("Mesh pool {} {}", vertices ? "vertices" : "indices", arenaIndex), grown.Buffer);
+
+		if (arenaBuffer.Buffer)
+		{
+			VkBufferCopy copy = { 0, 0, arenaBuffer.Size };
+			vkCmdCopyBuffer(commandBuffer, arenaBuffer.Buffer, grown.Buffer, 1, &copy);
+
+			// Frames in flight may still draw from it
+			Renderer::SubmitResourceFree([buffer = arenaBuffer.Buffer, allocation = arenaBuffer.MemoryAlloc]()
+			{
+				VulkanAllocator allocator("MeshPool");
+				allocator.DestroyBuffer(buffer, allocation);
+			});
+
+			ZN_CORE_INFO_TAG("Renderer", "Mesh pool {} {} grown to {}", vertices ? "vertices" : "indices", arenaIndex, Utils::BytesToString(capacity));
+		}
+
+		arenaBuffer = grown;
+	}
+
+}
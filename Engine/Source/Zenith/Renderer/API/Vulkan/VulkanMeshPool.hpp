@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Zenith/Renderer/MeshPool.hpp"
+
+#include "VulkanAllocator.hpp"
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
+namespace Zenith {
+
+	class VulkanMeshPool : public MeshPool
+	{
+	public:
+		VulkanMeshPool();
+		virtual ~VulkanMeshPool() override;
+
+		virtual MeshRange GetOrAdd(uint64_t key, const Ref<MeshSource>& meshSource) override;
+		virtual void Remove(uint64_t key) override;
+
+		// Binds the vertices of the format to binding 0 and the indices of the type
+		void RT_Bind(VkCommandBuffer commandBuffer, VertexFormat vertexFormat, IndexType indexType) const;
+	private:
+		struct Entry
+		{
+			const MeshSource* Source = nullptr; // the range was copied from, kept alive by the caller so it tells a reload apart
+			MeshRange Range;
+			uint32_t VertexArena = 0, IndexArena = 0;
+			uint64_t VertexOffset = 0, VertexSize = 0;
+			uint64_t IndexOffset = 0, IndexSize = 0;
+		};
+
+		// Hands the entry's ranges back to the arenas once no frame in flight draws from them
+		void Release(const Entry& entry);
+		// Replaces the arena's buffer with a larger one holding the same data
+		void RT_Reserve(VkCommandBuffer commandBuffer, uint32_t arenaIndex, uint64_t capacity);
+	private:
+		// Vertex arenas per VertexFormat, followed by index arenas per IndexType
+		static constexpr uint32_t s_VertexArenaCount = 3;
+		static constexpr uint32_t s_ArenaCount = s_VertexArenaCount + 2;
+
+		struct ArenaBuffer
+		{
+			VkBuffer Buffer = nullptr;
+			VmaAllocation MemoryAlloc = nullptr;
+			uint64_t Size = 0;
+		};
+
+		// Capacities are of the buffers once the queued copies ran. Ranges are freed from the render thread.
+		std::array<MeshPoolArena, s_ArenaCount> m_Arenas;
+		std::mutex m_ArenaMutex;
+		std::array<ArenaBuffer, s_ArenaCount> m_Buffers; // render thread
+
+		std::unordered_map<uint64_t, Entry> m_Entries;
+	};
+
+}
@@ -45,7 +45,7 @@ namespace Zenith {
 		}
 	}
 
-	static VkFormat ShaderDataTypeToVulkanFormat(ShaderDataType type)
+	static VkFormat ShaderDataTypeToVulkanFormat(ShaderDataType type, bool normalized)
 	{
 		switch (type)
 		{
@@ -57,6 +57,9 @@ namespace Zenith {
 			case ShaderDataType::Int2:      return VK_FORMAT_R32G32_SINT;
 			case ShaderDataType::Int3:      return VK_FORMAT_R32G32B32_SINT;
 			case ShaderDataType::Int4:      return VK_FORMAT_R32G32B32A32_SINT;
+			case ShaderDataType::Half2:     return VK_FORMAT_R16G16_SFLOAT;
+			case ShaderDataType::Short2:    return normalized ? VK_FORMAT_R16G16_SNORM : VK_FORMAT_R16G16_SINT;
+			case ShaderDataType::UShort4:   return normalized ? VK_FORMAT_R16G16B16A16_UNORM : VK_FORMAT_R16G16B16A16_UINT;
 		}
 		ZN_CORE_ASSERT(false);
 		return VK_FORMAT_UNDEFINED;
@@ -300,7 +303,7 @@ namespace Zenith {
 				{
 					vertexInputAttributes[location].binding = binding;
 					vertexInputAttributes[location].location = location;
-					vertexInputAttributes[location].format = ShaderDataTypeToVulkanFormat(element.Type);
+					vertexInputAttributes[location].format = ShaderDataTypeToVulkanFormat(element.Type, element.Normalized);
 					vertexInputAttributes[location].offset = element.Offset;
 					location++;
 				}
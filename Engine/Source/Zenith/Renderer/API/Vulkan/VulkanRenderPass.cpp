@@ -116,22 +116,14 @@ namespace Zenith {
 	}
 	const std::vector<VkDescriptorSet>& VulkanRenderPass::GetDescriptorSets(uint32_t frameIndex) const
 	{
-		ZN_CORE_ASSERT(!m_DescriptorSetManager.m_DescriptorSets.empty());
-		if (frameIndex > 0 && m_DescriptorSetManager.m_DescriptorSets.size() == 1)
-			return m_DescriptorSetManager.m_DescriptorSets[0]; // Frame index is irrelevant for this type of render pass
-		return m_DescriptorSetManager.m_DescriptorSets[frameIndex];
+		return m_DescriptorSetManager.GetDescriptorSets(frameIndex);
 	}
 	bool VulkanRenderPass::IsInputValid(std::string_view name) const
 	{
-		std::string nameStr(name);
-		return m_DescriptorSetManager.InputDeclarations.find(nameStr) != m_DescriptorSetManager.InputDeclarations.end();
+		return m_DescriptorSetManager.IsInputValid(name);
 	}
 	const RenderPassInputDeclaration* VulkanRenderPass::GetInputDeclaration(std::string_view name) const
 	{
-		std::string nameStr(name);
-		if (m_DescriptorSetManager.InputDeclarations.find(nameStr) == m_DescriptorSetManager.InputDeclarations.end())
-			return nullptr;
-		const RenderPassInputDeclaration& decl = m_DescriptorSetManager.InputDeclarations.at(nameStr);
-		return &decl;
+		return m_DescriptorSetManager.GetInputDeclaration(name);
 	}
 }
\ No newline at end of file
@@ -3,18 +3,22 @@
 
 #include "Vulkan.hpp"
 #include "VulkanAPI.hpp"
+#include "VulkanBindlessDescriptors.hpp"
 #include "VulkanContext.hpp"
 #include "VulkanFramebuffer.hpp"
 #include "VulkanIndexBuffer.hpp"
+#include "VulkanMeshPool.hpp"
 #include "VulkanPipeline.hpp"
 #include "VulkanRenderCommandBuffer.hpp"
 #include "VulkanRenderPass.hpp"
 #include "VulkanShader.hpp"
 #include "VulkanTexture.hpp"
+#include "VulkanTransientAllocator.hpp"
 #include "VulkanVertexBuffer.hpp"
 
 #if ZN_HAS_SHADER_COMPILER
 #include "ShaderCompiler/VulkanShaderCompiler.hpp"
+#include "ShaderCompiler/VulkanShaderCache.hpp"
 #endif
 
 #include "Zenith/Asset/AssetManager.hpp"
@@ -76,6 +80,35 @@ namespace Zenith {
 			return "Unknown";
 		}
 
+		// Goes through the transient allocator if the shader reads it from there, otherwise it is pushed. Returns the size pushed.
+		static uint32_t RT_BindDrawData(VkCommandBuffer commandBuffer, Ref<VulkanPipeline> pipeline, Buffer drawData)
+		{
+			if (!drawData)
+				return 0;
+
+			VkPipelineLayout layout = pipeline->GetVulkanPipelineLayout();
+			if (pipeline->GetShader().As<VulkanShader>()->HasTransientDrawData())
+			{
+				VulkanTransientAllocator::Allocation allocation = VulkanTransientAllocator::RT_Allocate(drawData);
+				if (allocation)
+					VulkanTransientAllocator::RT_Bind(commandBuffer, layout, allocation);
+				return 0;
+			}
+
+			vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 0, (uint32_t)drawData.Size, drawData.Data);
+			return (uint32_t)drawData.Size;
+		}
+
+		// Bound once per pipeline, draws only push their material index
+		static void RT_BindBindlessSet(VkCommandBuffer commandBuffer, Ref<VulkanPipeline> pipeline)
+		{
+			if (!pipeline->GetShader().As<VulkanShader>()->HasBindlessMaterial())
+				return;
+
+			VkDescriptorSet bindlessSet = VulkanBindlessDescriptors::RT_GetDescriptorSet(Renderer::RT_GetCurrentFrameIndex());
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->GetVulkanPipelineLayout(), VulkanBindlessDescriptors::DescriptorSet, 1, &bindlessSet, 0, nullptr);
+		}
+
 	}
 
 	void VulkanRenderer::Init()
@@ -102,6 +135,7 @@ namespace Zenith {
 		caps.Vendor = Utils::VulkanVendorIDToString(properties.vendorID);
 		caps.Device = properties.deviceName;
 		caps.Version = std::to_string(properties.driverVersion);
+		caps.SupportsBlockCompression = VulkanContext::GetCurrentDevice()->GetPhysicalDevice()->GetFeatures().textureCompressionBC;
 
 		Utils::DumpGPUInfo();
 
@@ -169,6 +203,9 @@ namespace Zenith {
 		s_Data->QuadIndexBuffer = IndexBuffer::Create(indices, 6 * sizeof(uint32_t));
 
 		s_Data->BRDFLut = Renderer::GetBRDFLutTexture();
+
+		VulkanBindlessDescriptors::Init();
+		VulkanTransientAllocator::Init();
 	}
 
 	void VulkanRenderer::Shutdown()
@@ -188,8 +225,13 @@ namespace Zenith {
 			s_Data->SamplerClamp = nullptr;
 		}
 
+		VulkanBindlessDescriptors::Shutdown();
+		VulkanTransientAllocator::Shutdown();
+
 #if ZN_HAS_SHADER_COMPILER
+		VulkanShaderCompiler::ShutdownVariantCompilation();
 		VulkanShaderCompiler::ClearUniformBuffers();
+		VulkanShaderCache::Flush();
 #endif
 		delete s_Data;
 	}
@@ -260,7 +302,14 @@ namespace Zenith {
 		ZN_CORE_VERIFY(meshSource);
 		ZN_CORE_VERIFY(materialTable);
 
-		Renderer::Submit([renderCommandBuffer, pipeline, mesh, meshSource, submeshIndex, materialTable = Ref<MaterialTable>::Create(materialTable), transformBuffer, transformOffset, instanceCount]() mutable
+		const Submesh& submesh = meshSource->GetSubmeshes()[submeshIndex];
+		Ref<MaterialTable> meshMaterialTable = mesh->GetMaterials();
+		AssetHandle materialHandle = materialTable->HasMaterial(submesh.MaterialIndex) ? materialTable->GetMaterial(submesh.MaterialIndex) : meshMaterialTable->GetMaterial(submesh.MaterialIndex);
+		Ref<MaterialAsset> material = AssetManager::GetAsset<MaterialAsset>(materialHandle);
+		Ref<VulkanMaterial> vulkanMaterial = material->GetMaterial().As<VulkanMaterial>();
+		vulkanMaterial->FlushParameters();
+
+		Renderer::Submit([renderCommandBuffer, pipeline, meshSource, submeshIndex, vulkanMaterial, transformBuffer, transformOffset, instanceCount]() mutable
 		{
 			ZN_PROFILE_FUNC("VulkanRenderer::RenderMesh");
 			ZN_SCOPE_PERF("VulkanRenderer::RenderMesh");
@@ -283,32 +332,32 @@ namespace Zenith {
 
 			auto vulkanMeshIB = Ref<VulkanIndexBuffer>(meshSource->GetIndexBuffer());
 			VkBuffer ibBuffer = vulkanMeshIB->GetVulkanBuffer();
-			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, VK_INDEX_TYPE_UINT32);
+			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, vulkanMeshIB->GetVulkanIndexType());
 
 			Ref<VulkanPipeline> vulkanPipeline = pipeline.As<VulkanPipeline>();
 
 			std::vector<std::vector<VkWriteDescriptorSet>> writeDescriptors;
 
-			const auto& submeshes = meshSource->GetSubmeshes();
-			const Submesh& submesh = submeshes[submeshIndex];
-			Ref<MaterialTable> meshMaterialTable = mesh->GetMaterials();
-			uint32_t materialCount = meshMaterialTable->GetMaterialCount();
-
-			// NOTE: probably should not involve Asset Manager at this stage
-			AssetHandle materialHandle = materialTable->HasMaterial(submesh.MaterialIndex) ? materialTable->GetMaterial(submesh.MaterialIndex) : meshMaterialTable->GetMaterial(submesh.MaterialIndex);
-			Ref<MaterialAsset> material = AssetManager::GetAsset<MaterialAsset>(materialHandle);
-			Ref<VulkanMaterial> vulkanMaterial = material->GetMaterial().As<VulkanMaterial>();
+			const Submesh& submesh = meshSource->GetSubmeshes()[submeshIndex];
 
 			if (s_Data->SelectedDrawCall != -1 && s_Data->DrawCallCount > s_Data->SelectedDrawCall)
 				return;
 
 			VkPipelineLayout layout = vulkanPipeline->GetVulkanPipelineLayout();
-			VkDescriptorSet descriptorSet = vulkanMaterial->GetDescriptorSet(frameIndex);
-			if (descriptorSet)
-				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, 0, nullptr);
+			const uint32_t materialIndex = vulkanMaterial->GetBindlessIndex();
+			if (materialIndex != VulkanBindlessDescriptors::InvalidIndex)
+			{
+				vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(uint32_t), &materialIndex);
+			}
+			else
+			{
+				VkDescriptorSet descriptorSet = vulkanMaterial->GetDescriptorSet(frameIndex);
+				if (descriptorSet)
+					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, 0, nullptr);
 
-			Buffer uniformStorageBuffer = vulkanMaterial->GetUniformStorageBuffer();
-			vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, (uint32_t)uniformStorageBuffer.Size, uniformStorageBuffer.Data);
+				Buffer uniformStorageBuffer = vulkanMaterial->GetUniformStorageBuffer();
+				vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, (uint32_t)uniformStorageBuffer.Size, uniformStorageBuffer.Data);
+			}
 
 			vkCmdDrawIndexed(commandBuffer, submesh.IndexCount, instanceCount, submesh.BaseIndex, 0, 0);
 			s_Data->DrawCallCount++;
@@ -330,6 +379,7 @@ namespace Zenith {
 		}
 
 		Ref<VulkanMaterial> vulkanMaterial = material.As<VulkanMaterial>();
+		vulkanMaterial->FlushParameters();
 		Renderer::Submit([renderCommandBuffer, pipeline, staticMesh, meshSource, submeshIndex, vulkanMaterial, transformBuffer, transformOffset, instanceCount, pushConstantBuffer]() mutable
 		{
 			ZN_PROFILE_FUNC("VulkanRenderer::RenderMeshWithMaterial");
@@ -350,25 +400,35 @@ namespace Zenith {
 
 			auto vulkanMeshIB = Ref<VulkanIndexBuffer>(meshSource->GetIndexBuffer());
 			VkBuffer ibBuffer = vulkanMeshIB->GetVulkanBuffer();
-			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, VK_INDEX_TYPE_UINT32);
+			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, vulkanMeshIB->GetVulkanIndexType());
 
 			Ref<VulkanPipeline> vulkanPipeline = pipeline.As<VulkanPipeline>();
 			VkPipelineLayout layout = vulkanPipeline->GetVulkanPipelineLayout();
 
-			// Bind descriptor sets describing shader binding points
-			// TODO std::vector<VkDescriptorSet> descriptorSets = resourceSets.As<VulkanResourceSets>()->GetDescriptorSets();
-			// TODO VkDescriptorSet descriptorSet = vulkanMaterial->GetDescriptorSet(frameIndex);
-			// TODO descriptorSets[0] = descriptorSet;
-			// TODO vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, (uint32_t)descriptorSets.size(), descriptorSets.data(), 0, nullptr);
+			// Bindless materials are in the set bound with the pipeline, others bind their own set 0
+			const uint32_t materialIndex = vulkanMaterial->GetBindlessIndex();
+			if (materialIndex == VulkanBindlessDescriptors::InvalidIndex)
+			{
+				VkDescriptorSet descriptorSet = vulkanMaterial->GetDescriptorSet(frameIndex);
+				if (descriptorSet)
+					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, 0, nullptr);
+			}
 
 			Buffer uniformStorageBuffer = vulkanMaterial->GetUniformStorageBuffer();
 			uint32_t pushConstantOffset = 0;
-			if (pushConstantBuffer.Size)
+			const uint32_t drawDataPushSize = Utils::RT_BindDrawData(commandBuffer, vulkanPipeline, pushConstantBuffer);
+			if (drawDataPushSize)
 			{
-				vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, pushConstantOffset, pushConstantBuffer.Size, pushConstantBuffer.Data);
 				pushConstantOffset += 16; // TODO: it's 16 because that happens to be the offset that is declared for the material push constants in the shaders.  Need a better way of doing this.  Cannot just use the size of the pushConstantBuffer, because you dont know what alignment the next push constant range might have
 			}
 
+			// The material index follows the draw's own push constants, see Bindless.glslh
+			if (materialIndex != VulkanBindlessDescriptors::InvalidIndex)
+			{
+				const uint32_t materialIndexOffset = (drawDataPushSize + 3) & ~3u;
+				vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, materialIndexOffset, sizeof(uint32_t), &materialIndex);
+			}
+
 			/*if (uniformStorageBuffer)
 			{
 				vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_FRAGMENT_BIT, pushConstantOffset, uniformStorageBuffer.Size, uniformStorageBuffer.Data);
@@ -384,6 +444,144 @@ namespace Zenith {
 		});
 	}
 
+	void VulkanRenderer::RenderStaticMeshClustersWithMaterial(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<StaticMesh> staticMesh, Ref<MeshSource> meshSource, uint32_t submeshIndex, std::vector<DrawIndexedIndirectCommand> drawRanges, Ref<Material> material, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, uint32_t instanceCount, Buffer additionalUniforms /*= Buffer()*/)
+	{
+		ZN_CORE_ASSERT(staticMesh);
+		ZN_CORE_ASSERT(meshSource);
+		ZN_CORE_ASSERT(material);
+
+		if (drawRanges.empty())
+			return;
+
+		Buffer pushConstantBuffer;
+		if (additionalUniforms.Size)
+		{
+			pushConstantBuffer.Allocate(additionalUniforms.Size);
+			pushConstantBuffer.Write(additionalUniforms.Data, additionalUniforms.Size);
+		}
+
+		Ref<VulkanMaterial> vulkanMaterial = material.As<VulkanMaterial>();
+		vulkanMaterial->FlushParameters();
+		Renderer::Submit([renderCommandBuffer, pipeline, meshSource, drawRanges = std::move(drawRanges), vulkanMaterial, transformBuffer, transformOffset, instanceCount, pushConstantBuffer]() mutable
+		{
+			ZN_PROFILE_FUNC("VulkanRenderer::RenderMeshClustersWithMaterial");
+			ZN_SCOPE_PERF("VulkanRenderer::RenderMeshClustersWithMaterial");
+
+			VkCommandBuffer commandBuffer = renderCommandBuffer.As<VulkanRenderCommandBuffer>()->GetActiveCommandBuffer();
+
+			auto vulkanMeshVB = meshSource->GetVertexBuffer().As<VulkanVertexBuffer>();
+			VkBuffer vbMeshBuffer = vulkanMeshVB->GetVulkanBuffer();
+			VkDeviceSize vertexOffsets[1] = { 0 };
+			vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vbMeshBuffer, vertexOffsets);
+
+			Ref<VulkanVertexBuffer> vulkanTransformBuffer = transformBuffer.As<VulkanVertexBuffer>();
+			VkBuffer vbTransformBuffer = vulkanTransformBuffer->GetVulkanBuffer();
+			VkDeviceSize instanceOffsets[1] = { transformOffset };
+			vkCmdBindVertexBuffers(commandBuffer, 1, 1, &vbTransformBuffer, instanceOffsets);
+
+			auto vulkanMeshIB = Ref<VulkanIndexBuffer>(meshSource->GetIndexBuffer());
+			VkBuffer ibBuffer = vulkanMeshIB->GetVulkanBuffer();
+			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, vulkanMeshIB->GetVulkanIndexType());
+
+			Ref<VulkanPipeline> vulkanPipeline = pipeline.As<VulkanPipeline>();
+			VkPipelineLayout layout = vulkanPipeline->GetVulkanPipelineLayout();
+
+			const uint32_t drawDataPushSize = Utils::RT_BindDrawData(commandBuffer, vulkanPipeline, pushConstantBuffer);
+
+			const uint32_t materialIndex = vulkanMaterial->GetBindlessIndex();
+			if (materialIndex != VulkanBindlessDescriptors::InvalidIndex)
+			{
+				const uint32_t materialIndexOffset = (drawDataPushSize + 3) & ~3u;
+				vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, materialIndexOffset, sizeof(uint32_t), &materialIndex);
+			}
+			else if (VkDescriptorSet descriptorSet = vulkanMaterial->GetDescriptorSet(Renderer::RT_GetCurrentFrameIndex()))
+			{
+				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, 0, nullptr);
+			}
+
+			// Visible clusters come in as compacted index ranges of the submesh
+			for (const DrawIndexedIndirectCommand& range : drawRanges)
+				vkCmdDrawIndexed(commandBuffer, range.IndexCount, instanceCount * range.InstanceCount, range.FirstIndex, range.VertexOffset, range.FirstInstance);
+
+			pushConstantBuffer.Release();
+		});
+	}
+
+	void VulkanRenderer::RenderMeshesIndirect(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<MeshPool> meshPool, VertexFormat vertexFormat, IndexType indexType, std::vector<DrawIndexedIndirectCommand> drawCommands, Ref<Material> material, Buffer sceneData, Buffer instanceData, uint32_t instanceStride)
+	{
+		ZN_CORE_ASSERT(meshPool);
+		ZN_CORE_ASSERT(material);
+		ZN_CORE_ASSERT(instanceStride > 0 && instanceData.Size % instanceStride == 0);
+
+		if (drawCommands.empty())
+			return;
+
+		Buffer drawData;
+		drawData.Allocate(sceneData.Size + instanceData.Size);
+		drawData.Write(sceneData.Data, sceneData.Size);
+		drawData.Write(instanceData.Data, instanceData.Size, sceneData.Size);
+
+		Ref<VulkanMaterial> vulkanMaterial = material.As<VulkanMaterial>();
+		vulkanMaterial->FlushParameters();
+		Ref<VulkanMeshPool> vulkanMeshPool = meshPool.As<VulkanMeshPool>();
+		const uint32_t sceneDataSize = (uint32_t)sceneData.Size;
+		Renderer::Submit([renderCommandBuffer, pipeline, vulkanMeshPool, vertexFormat, indexType, drawCommands = std::move(drawCommands), vulkanMaterial, drawData, sceneDataSize, instanceStride]() mutable
+		{
+			ZN_PROFILE_FUNC("VulkanRenderer::RenderMeshesIndirect");
+			ZN_SCOPE_PERF("VulkanRenderer::RenderMeshesIndirect");
+
+			VkCommandBuffer commandBuffer = renderCommandBuffer.As<VulkanRenderCommandBuffer>()->GetActiveCommandBuffer();
+			vulkanMeshPool->RT_Bind(commandBuffer, vertexFormat, indexType);
+
+			Ref<VulkanPipeline> vulkanPipeline = pipeline.As<VulkanPipeline>();
+			VkPipelineLayout layout = vulkanPipeline->GetVulkanPipelineLayout();
+
+			const uint32_t materialIndex = vulkanMaterial->GetBindlessIndex();
+			if (materialIndex != VulkanBindlessDescriptors::InvalidIndex)
+				vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(uint32_t), &materialIndex);
+			else if (VkDescriptorSet descriptorSet = vulkanMaterial->GetDescriptorSet(Renderer::RT_GetCurrentFrameIndex()))
+				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, 0, nullptr);
+
+			// The shader only sees one binding range of draw data from the allocation's offset, larger draw lists go out in batches
+			const uint32_t instancesPerBatch = (VulkanTransientAllocator::GetBindingRange() - sceneDataSize) / instanceStride;
+			const bool multiDrawIndirect = VulkanContext::GetCurrentDevice()->IsMultiDrawIndirectEnabled();
+
+			for (const MeshPool::IndirectBatch& batch : MeshPool::SplitIntoBatches(drawCommands, instancesPerBatch))
+			{
+				VulkanTransientAllocator::Allocation batchData = VulkanTransientAllocator::RT_Allocate(sceneDataSize + (uint64_t)batch.InstanceCount * instanceStride);
+				if (!batchData)
+				{
+					ZN_CORE_WARN_TAG("Renderer", "No transient memory left for indirect draw data, skipping {} of {} draws", drawCommands.size() - batch.FirstCommand, drawCommands.size());
+					break;
+				}
+
+				memcpy(batchData.Data, drawData.Data, sceneDataSize);
+				memcpy((uint8_t*)batchData.Data + sceneDataSize, drawData.As<uint8_t>() + sceneDataSize + (uint64_t)batch.FirstInstance * instanceStride, (uint64_t)batch.InstanceCount * instanceStride);
+				VulkanTransientAllocator::RT_Bind(commandBuffer, layout, batchData);
+
+				if (multiDrawIndirect)
+				{
+					VulkanTransientAllocator::Allocation commands = VulkanTransientAllocator::RT_Allocate(Buffer(&drawCommands[batch.FirstCommand], batch.CommandCount * sizeof(DrawIndexedIndirectCommand)));
+					if (commands)
+					{
+						vkCmdDrawIndexedIndirect(commandBuffer, commands.Buffer, commands.Offset, batch.CommandCount, sizeof(DrawIndexedIndirectCommand));
+						continue;
+					}
+
+					ZN_CORE_WARN_TAG("Renderer", "No transient memory left for {} indirect draw commands, drawing them directly", batch.CommandCount);
+				}
+
+				for (uint32_t i = batch.FirstCommand; i < batch.FirstCommand + batch.CommandCount; i++)
+				{
+					const DrawIndexedIndirectCommand& command = drawCommands[i];
+					vkCmdDrawIndexed(commandBuffer, command.IndexCount, command.InstanceCount, command.FirstIndex, command.VertexOffset, command.FirstInstance);
+				}
+			}
+
+			drawData.Release();
+		});
+	}
+
 	void VulkanRenderer::RenderQuad(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<Material> material, const glm::mat4& transform)
 	{
 		Ref<VulkanMaterial> vulkanMaterial = material.As<VulkanMaterial>();
@@ -405,7 +603,7 @@ namespace Zenith {
 
 			auto vulkanMeshIB = s_Data->QuadIndexBuffer.As<VulkanIndexBuffer>();
 			VkBuffer ibBuffer = vulkanMeshIB->GetVulkanBuffer();
-			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, VK_INDEX_TYPE_UINT32);
+			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, vulkanMeshIB->GetVulkanIndexType());
 
 			Buffer uniformStorageBuffer = vulkanMaterial->GetUniformStorageBuffer();
 
@@ -439,7 +637,7 @@ namespace Zenith {
 
 			auto vulkanMeshIB = indexBuffer.As<VulkanIndexBuffer>();
 			VkBuffer ibBuffer = vulkanMeshIB->GetVulkanBuffer();
-			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, VK_INDEX_TYPE_UINT32);
+			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, vulkanMeshIB->GetVulkanIndexType());
 
 			VkDescriptorSet descriptorSet = vulkanMaterial->GetDescriptorSet(frameIndex);
 			if (descriptorSet)
@@ -775,7 +973,7 @@ namespace Zenith {
 
 			auto vulkanMeshIB = s_Data->QuadIndexBuffer.As<VulkanIndexBuffer>();
 			VkBuffer ibBuffer = vulkanMeshIB->GetVulkanBuffer();
-			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, VK_INDEX_TYPE_UINT32);
+			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, vulkanMeshIB->GetVulkanIndexType());
 
 			if (vulkanMaterial)
 			{
@@ -827,7 +1025,7 @@ namespace Zenith {
 
 			auto vulkanMeshIB = s_Data->QuadIndexBuffer.As<VulkanIndexBuffer>();
 			VkBuffer ibBuffer = vulkanMeshIB->GetVulkanBuffer();
-			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, VK_INDEX_TYPE_UINT32);
+			vkCmdBindIndexBuffer(commandBuffer, ibBuffer, 0, vulkanMeshIB->GetVulkanIndexType());
 
 			VkDescriptorSet descriptorSet = vulkanMaterial->GetDescriptorSet(frameIndex);
 			if (descriptorSet)
@@ -859,6 +1057,9 @@ namespace Zenith {
 			vkResetDescriptorPool(device, s_Data->DescriptorPools[bufferIndex], 0);
 			memset(s_Data->DescriptorPoolAllocationCount.data(), 0, s_Data->DescriptorPoolAllocationCount.size() * sizeof(uint32_t));
 
+			VulkanBindlessDescriptors::RT_Update(bufferIndex);
+			VulkanTransientAllocator::RT_BeginFrame(bufferIndex);
+
 			s_Data->DrawCallCount = 0;
 		});
 	}
@@ -1054,6 +1255,8 @@ namespace Zenith {
 			if (vulkanPipeline->IsDynamicLineWidth())
 				vkCmdSetLineWidth(commandBuffer, vulkanPipeline->GetSpecification().LineWidth);
 
+			Utils::RT_BindBindlessSet(commandBuffer, vulkanPipeline);
+
 			// Bind input descriptors (starting from set 1, set 0 is for per-draw)
 			Ref<VulkanRenderPass> vulkanRenderPass = renderPass.As<VulkanRenderPass>();
 			vulkanRenderPass->Prepare();
@@ -1079,6 +1282,24 @@ namespace Zenith {
 		});
 	}
 
+	void VulkanRenderer::BindPipeline(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline)
+	{
+		Renderer::Submit([renderCommandBuffer, pipeline]()
+		{
+			ZN_PROFILE_FUNC("VulkanRenderer::BindPipeline");
+
+			VkCommandBuffer commandBuffer = renderCommandBuffer.As<VulkanRenderCommandBuffer>()->GetActiveCommandBuffer();
+
+			Ref<VulkanPipeline> vulkanPipeline = pipeline.As<VulkanPipeline>();
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkanPipeline->GetVulkanPipeline());
+
+			if (vulkanPipeline->IsDynamicLineWidth())
+				vkCmdSetLineWidth(commandBuffer, vulkanPipeline->GetSpecification().LineWidth);
+
+			Utils::RT_BindBindlessSet(commandBuffer, vulkanPipeline);
+		});
+	}
+
 	uint32_t VulkanRenderer::GetDescriptorAllocationCount(uint32_t frameIndex)
 	{
 		return s_Data->DescriptorPoolAllocationCount[frameIndex];
@@ -6,14 +6,18 @@
 #if ZN_HAS_SHADER_COMPILER
 #include "ShaderCompiler/VulkanShaderCompiler.hpp"
 #endif
+#include "ShaderPack/VulkanShaderPack.hpp"
 
 #include "Zenith/Core/Hash.hpp"
 // #include "Zenith/ImGui/ImGui.hpp"
+#include "Zenith/Renderer/API/Vulkan/VulkanBindlessDescriptors.hpp"
 #include "Zenith/Renderer/API/Vulkan/VulkanContext.hpp"
 #include "Zenith/Renderer/API/Vulkan/VulkanRenderer.hpp"
+#include "Zenith/Renderer/API/Vulkan/VulkanTransientAllocator.hpp"
 #include "Zenith/Renderer/Renderer.hpp"
 #include "Zenith/Utilities/StringUtils.hpp"
 
+#include <atomic>
 #include <filesystem>
 #include <format>
 
@@ -31,6 +35,52 @@ namespace Zenith {
 		Reload(forceCompile);
 	}
 
+	Ref<VulkanShader> VulkanShader::CreateFromPack(Ref<VulkanShaderPack> pack, const std::filesystem::path& path)
+	{
+		ZN_PROFILE_FUNC();
+
+		const ShaderPackFile::Entry* baseEntry = pack ? pack->GetEntry(path, 0) : nullptr;
+		if (!baseEntry)
+		{
+			ZN_CORE_ERROR_TAG("Renderer", "Shader pack has no shader {}", path.string());
+			return nullptr;
+		}
+
+		Ref<VulkanShader> shader = Ref<VulkanShader>::Create();
+		shader->m_AssetPath = path;
+		shader->m_Name = path.stem().string();
+		shader->m_Pack = pack;
+		shader->m_Keywords = pack->GetMacros(*baseEntry);
+
+		// The variant for the current global macros, if the pack has it
+		const ShaderMacros variantMacros = shader->GetVariantMacros();
+		uint64_t variantKey = Shader::GetVariantKey(variantMacros);
+		const ShaderPackFile::Entry* entry = pack->GetEntry(path, variantKey);
+		if (!entry)
+		{
+			// The base variant may not match what the renderer set up for, e.g. a material layout without bindless
+			std::string macros;
+			for (const auto& [name, value] : variantMacros)
+				macros += std::format("{}{}={}", macros.empty() ? "" : ", ", name, value);
+			ZN_CORE_WARN_TAG("Renderer", "Shader pack has no variant of {} for {}, using its base variant. Rebuild the pack.", path.string(), macros);
+
+			variantKey = 0;
+			entry = baseEntry;
+		}
+
+		shader->m_VariantKey = shader->m_WantedVariantKey = variantKey;
+		shader->AddVariant(variantKey, pack->ReadShaderData(*entry), pack->ReadReflectionData(*entry));
+
+		const Variant& variant = shader->m_Variants.at(variantKey);
+		shader->LoadAndCreateShaders(variant.ShaderData);
+		shader->SetReflectionData(variant.Reflection);
+		shader->CreateDescriptors();
+
+		Renderer::AcknowledgeParsedGlobalMacros(shader->m_Keywords, shader);
+		Renderer::OnShaderReloaded(shader->GetHash());
+		return shader;
+	}
+
 	void VulkanShader::Release()
 	{
 		auto& pipelineCIs = m_PipelineShaderStageCreateInfos;
@@ -64,7 +114,7 @@ namespace Zenith {
 
 	void VulkanShader::RT_Reload(const bool forceCompile)
 	{
-#if ZN_HAS_SHADER_COMPILER 
+#if !ZN_USE_SHADER_PACK
 		if (!VulkanShaderCompiler::TryRecompile(this))
 		{
 			ZN_CORE_FATAL("Failed to recompile shader!");
@@ -80,6 +130,56 @@ namespace Zenith {
 		});
 	}
 
+	ShaderMacros VulkanShader::GetVariantMacros() const
+	{
+		ShaderMacros macros;
+		const auto& globalMacros = Renderer::GetGlobalShaderMacros();
+		for (const std::string& keyword : m_Keywords)
+		{
+			if (auto it = globalMacros.find(keyword); it != globalMacros.end())
+				macros[keyword] = it->second;
+		}
+
+		for (const auto& [name, value] : m_Macros)
+			macros[name] = value;
+
+		return macros;
+	}
+
+	bool VulkanShader::RT_TrySetVariant(uint64_t variantKey)
+	{
+		m_WantedVariantKey = variantKey;
+		if (variantKey == m_VariantKey)
+			return true;
+
+		auto it = m_Variants.find(variantKey);
+		if (it == m_Variants.end())
+		{
+			const ShaderPackFile::Entry* entry = m_Pack ? m_Pack->GetEntry(m_AssetPath, variantKey) : nullptr;
+			if (!entry)
+				return false;
+
+			AddVariant(variantKey, m_Pack->ReadShaderData(*entry), m_Pack->ReadReflectionData(*entry));
+			it = m_Variants.find(variantKey);
+		}
+
+		// Only new shader modules, the pipelines using the shader are invalidated
+		Release();
+		LoadAndCreateShaders(it->second.ShaderData);
+		SetReflectionData(it->second.Reflection);
+		CreateDescriptors();
+		m_VariantKey = variantKey;
+
+		Renderer::OnShaderReloaded(GetHash());
+		return true;
+	}
+
+	void VulkanShader::AddVariant(uint64_t variantKey, const std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& shaderData, const ReflectionData& reflectionData)
+	{
+		m_Variants[variantKey] = { shaderData, reflectionData };
+		m_PendingVariants.erase(variantKey);
+	}
+
 	size_t VulkanShader::GetHash() const
 	{
 		return Hash::GenerateFNVHash(m_AssetPath.string());
@@ -128,6 +228,24 @@ namespace Zenith {
 		{
 			auto& shaderDescriptorSet = m_ReflectionData.ShaderDescriptorSets[set];
 
+			// The bindless set is shared by all shaders and owned by VulkanBindlessDescriptors
+			if (set == VulkanBindlessDescriptors::DescriptorSet && VulkanBindlessDescriptors::IsEnabled())
+			{
+				if (set >= m_DescriptorSetLayouts.size())
+					m_DescriptorSetLayouts.resize((size_t)(set + 1));
+				m_DescriptorSetLayouts[set] = VulkanBindlessDescriptors::GetDescriptorSetLayout();
+				continue;
+			}
+
+			// Dynamic buffers of the per-frame transient allocator
+			if (set == VulkanTransientAllocator::DescriptorSet)
+			{
+				if (set >= m_DescriptorSetLayouts.size())
+					m_DescriptorSetLayouts.resize((size_t)(set + 1));
+				m_DescriptorSetLayouts[set] = VulkanTransientAllocator::GetDescriptorSetLayout();
+				continue;
+			}
+
 			if (shaderDescriptorSet.UniformBuffers.size())
 			{
 				VkDescriptorPoolSize& typeCount = m_TypeCounts[set].emplace_back();
@@ -469,6 +587,22 @@ namespace Zenith {
 		return &m_ReflectionData.ShaderDescriptorSets.at(set).WriteDescriptorSets.at(name);
 	}
 
+	bool VulkanShader::HasBindlessMaterial() const
+	{
+		constexpr uint32_t set = VulkanBindlessDescriptors::DescriptorSet;
+		const auto& shaderDescriptorSets = m_ReflectionData.ShaderDescriptorSets;
+		return VulkanBindlessDescriptors::IsEnabled() && set < shaderDescriptorSets.size()
+			&& shaderDescriptorSets[set].StorageBuffers.contains(VulkanBindlessDescriptors::MaterialBinding);
+	}
+
+	bool VulkanShader::HasTransientDrawData() const
+	{
+		constexpr uint32_t set = VulkanTransientAllocator::DescriptorSet;
+		const auto& shaderDescriptorSets = m_ReflectionData.ShaderDescriptorSets;
+		return set < shaderDescriptorSets.size() && (shaderDescriptorSets[set].UniformBuffers.contains(VulkanTransientAllocator::UniformBinding)
+			|| shaderDescriptorSets[set].StorageBuffers.contains(VulkanTransientAllocator::StorageBinding));
+	}
+
 	std::vector<VkDescriptorSetLayout> VulkanShader::GetAllDescriptorSetLayouts()
 	{
 		std::vector<VkDescriptorSetLayout> result;
@@ -489,13 +623,45 @@ namespace Zenith {
 	}
 
 	bool VulkanShader::TryReadReflectionData(StreamReader* serializer)
+	{
+		m_ReflectionData = {};
+		DeserializeReflectionData(serializer, m_ReflectionData);
+		BuildMaterialParameters();
+		return true;
+	}
+
+	void VulkanShader::SerializeReflectionData(StreamWriter* serializer)
+	{
+		SerializeReflectionData(serializer, m_ReflectionData);
+	}
+
+	void VulkanShader::SerializeReflectionData(StreamWriter* serializer, const ReflectionData& reflectionData)
+	{
+		serializer->WriteRaw<uint32_t>((uint32_t)reflectionData.ShaderDescriptorSets.size());
+		for (const auto& descriptorSet : reflectionData.ShaderDescriptorSets)
+		{
+			serializer->WriteMap(descriptorSet.UniformBuffers);
+			serializer->WriteMap(descriptorSet.StorageBuffers);
+			serializer->WriteMap(descriptorSet.ImageSamplers);
+			serializer->WriteMap(descriptorSet.StorageImages);
+			serializer->WriteMap(descriptorSet.SeparateTextures);
+			serializer->WriteMap(descriptorSet.SeparateSamplers);
+			serializer->WriteMap(descriptorSet.WriteDescriptorSets);
+		}
+
+		serializer->WriteMap(reflectionData.Resources);
+		serializer->WriteMap(reflectionData.ConstantBuffers);
+		serializer->WriteArray(reflectionData.PushConstantRanges);
+	}
+
+	void VulkanShader::DeserializeReflectionData(StreamReader* serializer, ReflectionData& reflectionData)
 	{
 		uint32_t shaderDescriptorSetCount;
 		serializer->ReadRaw<uint32_t>(shaderDescriptorSetCount);
 
 		for (uint32_t i = 0; i < shaderDescriptorSetCount; i++)
 		{
-			auto& descriptorSet = m_ReflectionData.ShaderDescriptorSets.emplace_back();
+			auto& descriptorSet = reflectionData.ShaderDescriptorSets.emplace_back();
 			serializer->ReadMap(descriptorSet.UniformBuffers);
 			serializer->ReadMap(descriptorSet.StorageBuffers);
 			serializer->ReadMap(descriptorSet.ImageSamplers);
@@ -505,35 +671,46 @@ namespace Zenith {
 			serializer->ReadMap(descriptorSet.WriteDescriptorSets);
 		}
 
-		serializer->ReadMap(m_ReflectionData.Resources);
-		serializer->ReadMap(m_ReflectionData.ConstantBuffers);
-		serializer->ReadArray(m_ReflectionData.PushConstantRanges);
+		serializer->ReadMap(reflectionData.Resources);
+		serializer->ReadMap(reflectionData.ConstantBuffers);
+		serializer->ReadArray(reflectionData.PushConstantRanges);
+	}
 
-		return true;
+	void VulkanShader::SetReflectionData(const ReflectionData& reflectionData)
+	{
+		m_ReflectionData = reflectionData;
+		BuildMaterialParameters();
 	}
 
-	void VulkanShader::SerializeReflectionData(StreamWriter* serializer)
+	void VulkanShader::BuildMaterialParameters()
 	{
-		serializer->WriteRaw<uint32_t>((uint32_t)m_ReflectionData.ShaderDescriptorSets.size());
-		for (const auto& descriptorSet : m_ReflectionData.ShaderDescriptorSets)
+		// Unique across shaders, so a handle of another shader is rejected as well
+		static std::atomic<uint32_t> s_NextLayoutVersion = 1;
+		m_ParameterLayoutVersion = s_NextLayoutVersion++;
+
+		m_MaterialParameters.clear();
+		for (const auto& [bufferName, buffer] : m_ReflectionData.ConstantBuffers)
 		{
-			serializer->WriteMap(descriptorSet.UniformBuffers);
-			serializer->WriteMap(descriptorSet.StorageBuffers);
-			serializer->WriteMap(descriptorSet.ImageSamplers);
-			serializer->WriteMap(descriptorSet.StorageImages);
-			serializer->WriteMap(descriptorSet.SeparateTextures);
-			serializer->WriteMap(descriptorSet.SeparateSamplers);
-			serializer->WriteMap(descriptorSet.WriteDescriptorSets);
+			const bool materialBuffer = bufferName == "MaterialUniformBuffer";
+			for (const auto& [name, uniform] : buffer.Uniforms)
+			{
+				MaterialParameter& parameter = m_MaterialParameters[name];
+				if (parameter && (parameter.InMaterialBuffer || !materialBuffer))
+					continue;
+
+				parameter.Offset = uniform.GetOffset();
+				parameter.Size = uniform.GetSize();
+				parameter.Type = uniform.GetType();
+				parameter.InMaterialBuffer = materialBuffer;
+				parameter.LayoutVersion = m_ParameterLayoutVersion;
+			}
 		}
-
-		serializer->WriteMap(m_ReflectionData.Resources);
-		serializer->WriteMap(m_ReflectionData.ConstantBuffers);
-		serializer->WriteArray(m_ReflectionData.PushConstantRanges);
 	}
 
-	void VulkanShader::SetReflectionData(const ReflectionData& reflectionData)
+	MaterialParameter VulkanShader::GetMaterialParameter(const std::string& name) const
 	{
-		m_ReflectionData = reflectionData;
+		auto it = m_MaterialParameters.find(name);
+		return it != m_MaterialParameters.end() ? it->second : MaterialParameter{};
 	}
 
 }
\ No newline at end of file
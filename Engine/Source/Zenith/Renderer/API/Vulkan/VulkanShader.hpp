@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <unordered_set>
 
+#include "Zenith/Renderer/Material.hpp"
 #include "Zenith/Renderer/Shader.hpp"
 #include "VulkanShaderResource.hpp"
 
@@ -14,6 +15,8 @@
 
 namespace Zenith {
 
+	class VulkanShaderPack;
+
 	class VulkanShader : public Shader
 	{
 	public:
@@ -30,11 +33,21 @@ namespace Zenith {
 		virtual ~VulkanShader();
 		void Release();
 
+		// Creates the shader from a precompiled pack, its other variants are read from the pack when selected.
+		// Returns nullptr if the pack has no such shader.
+		static Ref<VulkanShader> CreateFromPack(Ref<VulkanShaderPack> pack, const std::filesystem::path& path);
+
 		void Reload(bool forceCompile = false) override;
 		void RT_Reload(bool forceCompile) override;
 
 		virtual size_t GetHash() const override;
-		void SetMacro(const std::string& name, const std::string& value) override {}
+		void SetMacro(const std::string& name, const std::string& value) override { m_Macros[name] = value; }
+
+		// Values of the macros the shader has variants for: its own macros, declared keywords and the "__ZN_" macros it tests
+		ShaderMacros GetVariantMacros() const;
+		uint64_t GetVariantKey() const { return m_VariantKey; }
+		// Switches to an already compiled variant, false if it still has to be compiled
+		bool RT_TrySetVariant(uint64_t variantKey);
 
 		virtual const std::string& GetName() const override { return m_Name; }
 		virtual const std::unordered_map<std::string, ShaderBuffer>& GetShaderBuffers() const override { return m_ReflectionData.ConstantBuffers; }
@@ -45,6 +58,10 @@ namespace Zenith {
 
 		void SerializeReflectionData(StreamWriter* serializer);
 
+		// Shared by the shader cache and shader packs
+		static void SerializeReflectionData(StreamWriter* serializer, const ReflectionData& reflectionData);
+		static void DeserializeReflectionData(StreamReader* serializer, ReflectionData& reflectionData);
+
 		void SetReflectionData(const ReflectionData& reflectionData);
 
 		// Vulkan-specific
@@ -68,6 +85,16 @@ namespace Zenith {
 
 		const std::vector<ShaderResource::PushConstantRange>& GetPushConstantRanges() const { return m_ReflectionData.PushConstantRanges; }
 
+		// Materials of the shader keep their parameters in the bindless material buffer, see Bindless.glslh
+		bool HasBindlessMaterial() const;
+
+		// Per-draw data comes from the transient allocator instead of push constants, see VulkanTransientAllocator
+		bool HasTransientDrawData() const;
+
+		// Uniforms of MaterialUniformBuffer take precedence over same-named ones of other blocks
+		MaterialParameter GetMaterialParameter(const std::string& name) const;
+		uint32_t GetParameterLayoutVersion() const { return m_ParameterLayoutVersion; }
+
 		struct ShaderMaterialDescriptorSet
 		{
 			VkDescriptorPool Pool = nullptr;
@@ -81,7 +108,14 @@ namespace Zenith {
 	private:
 		void LoadAndCreateShaders(const std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& shaderData);
 		void CreateDescriptors();
+		void AddVariant(uint64_t variantKey, const std::map<VkShaderStageFlagBits, std::vector<uint32_t>>& shaderData, const ReflectionData& reflectionData);
+		void BuildMaterialParameters();
 	private:
+		struct Variant
+		{
+			std::map<VkShaderStageFlagBits, std::vector<uint32_t>> ShaderData;
+			ReflectionData Reflection;
+		};
 		std::vector<VkPipelineShaderStageCreateInfo> m_PipelineShaderStageCreateInfos;
 
 		std::filesystem::path m_AssetPath;
@@ -91,11 +125,25 @@ namespace Zenith {
 		std::map<VkShaderStageFlagBits, std::vector<uint32_t>> m_ShaderData;
 		ReflectionData m_ReflectionData;
 
+		std::unordered_map<std::string, MaterialParameter> m_MaterialParameters;
+		uint32_t m_ParameterLayoutVersion = 0;
+
 		std::vector<VkDescriptorSetLayout> m_DescriptorSetLayouts;
 		VkDescriptorSet m_DescriptorSet;
 		//VkDescriptorPool m_DescriptorPool = nullptr;
 
 		std::unordered_map<uint32_t, std::vector<VkDescriptorPoolSize>> m_TypeCounts;
+
+		// Render thread only
+		std::unordered_map<uint64_t, Variant> m_Variants;
+		std::unordered_set<uint64_t> m_PendingVariants;
+		uint64_t m_VariantKey = 0;
+		uint64_t m_WantedVariantKey = 0;
+
+		std::unordered_set<std::string> m_Keywords;
+		ShaderMacros m_Macros;
+
+		Ref<VulkanShaderPack> m_Pack;
 	private:
 		friend class ShaderCache;
 		friend class VulkanShaderCompiler;
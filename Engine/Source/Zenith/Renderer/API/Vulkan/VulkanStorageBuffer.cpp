@@ -40,6 +40,7 @@ namespace Zenith {
 
 		m_Buffer = nullptr;
 		m_MemoryAlloc = nullptr;
+		m_MappedData = nullptr;
 	}
 
 	void VulkanStorageBuffer::RT_Invalidate()
@@ -52,7 +53,10 @@ namespace Zenith {
 		bufferInfo.size = m_Size;
 
 		VulkanAllocator allocator("StorageBuffer");
-		m_MemoryAlloc = allocator.AllocateBuffer(bufferInfo, m_Specification.GPUOnly ? VMA_MEMORY_USAGE_GPU_ONLY : VMA_MEMORY_USAGE_CPU_TO_GPU, m_Buffer);
+		if (m_Specification.GPUOnly)
+			m_MemoryAlloc = allocator.AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_GPU_ONLY, m_Buffer);
+		else
+			m_MemoryAlloc = allocator.AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_CPU_TO_GPU, m_Buffer, (void**)&m_MappedData);
 
 		m_DescriptorInfo.buffer = m_Buffer;
 		m_DescriptorInfo.offset = 0;
@@ -87,10 +91,7 @@ namespace Zenith {
 		ZN_CORE_VERIFY(!m_Specification.GPUOnly);
 
 #if NO_STAGING
-		VulkanAllocator allocator("StorageBuffer");
-		uint8_t* pData = allocator.MapMemory<uint8_t>(m_MemoryAlloc);
-		memcpy(pData, data, size);
-		allocator.UnmapMemory(m_MemoryAlloc);
+		memcpy(m_MappedData + offset, data, size);
 #else
 		VulkanAllocator allocator("Staging");
 
@@ -24,6 +24,7 @@ namespace Zenith {
 	private:
 		StorageBufferSpecification m_Specification;
 		VmaAllocation m_MemoryAlloc = nullptr;
+		uint8_t* m_MappedData = nullptr; // unless GPU only, mapped for the buffer's lifetime
 		VkBuffer m_Buffer {};
 		VkDescriptorBufferInfo m_DescriptorInfo{};
 		uint32_t m_Size = 0;
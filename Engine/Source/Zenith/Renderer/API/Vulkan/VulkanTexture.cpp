@@ -51,11 +51,55 @@ namespace Zenith {
 				case ImageFormat::SRGBA: return width * height * 4;
 				case ImageFormat::RGBA32F: return width * height * 4 * sizeof(float);
 				case ImageFormat::B10R11G11UF: return width * height * sizeof(float);
+				case ImageFormat::BC1:
+				case ImageFormat::BC1_SRGB:
+				case ImageFormat::BC3:
+				case ImageFormat::BC3_SRGB:
+				case ImageFormat::BC4:
+				case ImageFormat::BC5:
+				case ImageFormat::BC6H:
+				case ImageFormat::BC7:
+				case ImageFormat::BC7_SRGB: return Utils::GetImageMemorySize(format, width, height);
 			}
 			ZN_CORE_ASSERT(false);
 			return 0;
 		}
 
+		// Size of the first mipCount levels, tightly packed
+		static size_t GetMipChainMemorySize(ImageFormat format, uint32_t width, uint32_t height, uint32_t mipCount)
+		{
+			size_t size = 0;
+			for (uint32_t mip = 0; mip < mipCount; mip++)
+				size += GetMemorySize(format, std::max(width >> mip, 1u), std::max(height >> mip, 1u));
+			return size;
+		}
+
+		// Mips the image is created with: the ones provided with the data, or a full chain to generate.
+		// Block compressed formats can't be blitted, so those only have the mips they come with.
+		static uint32_t GetImageMipCount(const TextureSpecification& specification)
+		{
+			if (specification.Mips > 0)
+				return specification.Mips;
+
+			const bool generateMips = specification.GenerateMips && !IsBlockCompressed(specification.Format);
+			return generateMips ? CalculateMipCount(specification.Width, specification.Height) : 1;
+		}
+
+		// The part of the texture that is in GPU memory, the image starts at the resident mip
+		static TextureSpecification GetResidentSpecification(const TextureSpecification& specification)
+		{
+			TextureSpecification result = specification;
+			if (specification.Mips > 0 && specification.ResidentMip > 0)
+			{
+				const uint32_t residentMip = std::min(specification.ResidentMip, specification.Mips - 1);
+				result.Width = std::max(specification.Width >> residentMip, 1u);
+				result.Height = std::max(specification.Height >> residentMip, 1u);
+				result.Mips = specification.Mips - residentMip;
+			}
+			result.ResidentMip = 0;
+			return result;
+		}
+
 		static bool ValidateSpecification(const TextureSpecification& specification)
 		{
 			bool result = true;
@@ -108,7 +152,7 @@ namespace Zenith {
 		imageSpec.Format = m_Specification.Format;
 		imageSpec.Width = m_Specification.Width;
 		imageSpec.Height = m_Specification.Height;
-		imageSpec.Mips = specification.GenerateMips ? GetMipLevelCount() : 1;
+		imageSpec.Mips = Utils::GetImageMipCount(specification);
 		imageSpec.DebugName = specification.DebugName;
 		imageSpec.CreateSampler = false;
 		m_Image = Image2D::Create(imageSpec);
@@ -134,7 +178,7 @@ namespace Zenith {
 		imageSpec.Format = m_Specification.Format;
 		imageSpec.Width = m_Specification.Width;
 		imageSpec.Height = m_Specification.Height;
-		imageSpec.Mips = specification.GenerateMips ? GetMipLevelCount() : 1;
+		imageSpec.Mips = Utils::GetImageMipCount(specification);
 		imageSpec.DebugName = specification.DebugName;
 		imageSpec.CreateSampler = false;
 		m_Image = Image2D::Create(imageSpec);
@@ -164,7 +208,8 @@ namespace Zenith {
 		else if (data)
 		{
 			Utils::ValidateSpecification(m_Specification);
-			auto size = (uint32_t)Utils::GetMemorySize(m_Specification.Format, m_Specification.Width, m_Specification.Height);
+			const TextureSpecification residentSpecification = Utils::GetResidentSpecification(m_Specification);
+			auto size = (uint32_t)Utils::GetMipChainMemorySize(residentSpecification.Format, residentSpecification.Width, residentSpecification.Height, std::max(residentSpecification.Mips, 1u));
 			m_ImageData = Buffer::Copy(data.Data, size);
 		}
 		else
@@ -175,11 +220,12 @@ namespace Zenith {
 			m_ImageData.ZeroInitialize();
 		}
 
+		const TextureSpecification residentSpecification = Utils::GetResidentSpecification(m_Specification);
 		ImageSpecification imageSpec;
 		imageSpec.Format = m_Specification.Format;
-		imageSpec.Width = m_Specification.Width;
-		imageSpec.Height = m_Specification.Height;
-		imageSpec.Mips = specification.GenerateMips ? VulkanTexture2D::GetMipLevelCount() : 1;
+		imageSpec.Width = residentSpecification.Width;
+		imageSpec.Height = residentSpecification.Height;
+		imageSpec.Mips = Utils::GetImageMipCount(residentSpecification);
 		imageSpec.DebugName = specification.DebugName;
 		imageSpec.CreateSampler = false;
 		if (specification.Storage)
@@ -223,12 +269,13 @@ namespace Zenith {
 
 		m_Image->Release();
 
-		uint32_t mipCount = m_Specification.GenerateMips ? GetMipLevelCount() : 1;
+		const TextureSpecification residentSpecification = Utils::GetResidentSpecification(m_Specification);
+		uint32_t mipCount = Utils::GetImageMipCount(residentSpecification);
 
 		ImageSpecification& imageSpec = m_Image->GetSpecification();
 		imageSpec.Format = m_Specification.Format;
-		imageSpec.Width = m_Specification.Width;
-		imageSpec.Height = m_Specification.Height;
+		imageSpec.Width = residentSpecification.Width;
+		imageSpec.Height = residentSpecification.Height;
 		imageSpec.Mips = mipCount;
 		imageSpec.CreateSampler = false;
 		if (!m_ImageData) // TODO: better management for this, probably from texture spec
@@ -271,7 +318,7 @@ namespace Zenith {
 		samplerInfo.mipLodBias = 0.0f;
 		samplerInfo.compareOp = VK_COMPARE_OP_NEVER;
 		samplerInfo.minLod = 0.0f;
-		samplerInfo.maxLod = (float)mipCount;
+		samplerInfo.maxLod = 100.0f; // not the mip count, the view limits the mips and textures can share samplers
 		// Enable anisotropic filtering
 		// This feature is optional, so we must check if it's supported on the device
 
@@ -359,9 +406,12 @@ namespace Zenith {
 		VkImageSubresourceRange subresourceRange = {};
 		// Image only contains color data
 		subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		// Start at first mip level
+		// Start at first mip level, mips that come with the data are copied too
+		const TextureSpecification residentSpecification = Utils::GetResidentSpecification(m_Specification);
+		const uint32_t mipCount = Utils::GetImageMipCount(residentSpecification);
+		const uint32_t providedMipCount = std::max(residentSpecification.Mips, 1u);
 		subresourceRange.baseMipLevel = 0;
-		subresourceRange.levelCount = 1;
+		subresourceRange.levelCount = providedMipCount;
 		subresourceRange.layerCount = 1;
 
 		// Transition the texture image layout to transfer target, so we can safely copy our buffer data to it.
@@ -388,15 +438,26 @@ namespace Zenith {
 			0, nullptr,
 			1, &imageMemoryBarrier);
 
-		VkBufferImageCopy bufferCopyRegion = {};
-		bufferCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		bufferCopyRegion.imageSubresource.mipLevel = 0;
-		bufferCopyRegion.imageSubresource.baseArrayLayer = 0;
-		bufferCopyRegion.imageSubresource.layerCount = 1;
-		bufferCopyRegion.imageExtent.width = m_Specification.Width;
-		bufferCopyRegion.imageExtent.height = m_Specification.Height;
-		bufferCopyRegion.imageExtent.depth = 1;
-		bufferCopyRegion.bufferOffset = 0;
+		std::vector<VkBufferImageCopy> bufferCopyRegions(providedMipCount);
+		VkDeviceSize bufferOffset = 0;
+		for (uint32_t mip = 0; mip < providedMipCount; mip++)
+		{
+			const uint32_t mipWidth = std::max(residentSpecification.Width >> mip, 1u);
+			const uint32_t mipHeight = std::max(residentSpecification.Height >> mip, 1u);
+
+			VkBufferImageCopy& bufferCopyRegion = bufferCopyRegions[mip];
+			bufferCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			bufferCopyRegion.imageSubresource.mipLevel = mip;
+			bufferCopyRegion.imageSubresource.baseArrayLayer = 0;
+			bufferCopyRegion.imageSubresource.layerCount = 1;
+			bufferCopyRegion.imageExtent.width = mipWidth;
+			bufferCopyRegion.imageExtent.height = mipHeight;
+			bufferCopyRegion.imageExtent.depth = 1;
+			bufferCopyRegion.bufferOffset = bufferOffset;
+
+			bufferOffset += Utils::GetMemorySize(m_Specification.Format, mipWidth, mipHeight);
+		}
+		ZN_CORE_ASSERT(bufferOffset <= size);
 
 		// Copy mip levels from staging buffer
 		vkCmdCopyBufferToImage(
@@ -404,11 +465,11 @@ namespace Zenith {
 			stagingBuffer,
 			info.Image,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-			1,
-			&bufferCopyRegion);
+			(uint32_t)bufferCopyRegions.size(),
+			bufferCopyRegions.data());
 
-		uint32_t mipCount = m_Specification.GenerateMips ? GetMipLevelCount() : 1;
-		if (mipCount > 1) // Mips to generate
+		const bool generateMips = providedMipCount < mipCount;
+		if (generateMips) // Mips to generate
 		{
 			Utils::InsertImageMemoryBarrier(copyCmd, info.Image,
 				VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
@@ -431,7 +492,7 @@ namespace Zenith {
 		// Clean up staging resources
 		allocator.DestroyBuffer(stagingBuffer, stagingBufferAllocation);
 
-		if (m_Specification.GenerateMips && mipCount > 1)
+		if (generateMips)
 			GenerateMips();
 	}
 
@@ -458,6 +519,26 @@ namespace Zenith {
 		return m_ImageData;
 	}
 
+	void VulkanTexture2D::SetResidentMip(uint32_t mip, Buffer data)
+	{
+		ZN_CORE_VERIFY(mip < std::max(m_Specification.Mips, 1u));
+
+		TextureSpecification specification = m_Specification;
+		specification.ResidentMip = mip;
+		const TextureSpecification residentSpecification = Utils::GetResidentSpecification(specification);
+		Buffer mipData = Buffer::Copy(data.Data, Utils::GetMipChainMemorySize(residentSpecification.Format, residentSpecification.Width, residentSpecification.Height, std::max(residentSpecification.Mips, 1u)));
+
+		// The old image is released through the resource free queue, so frames in flight can still sample it
+		Ref<VulkanTexture2D> instance = this;
+		Renderer::Submit([instance, mip, mipData]() mutable
+		{
+			instance->m_Specification.ResidentMip = mip;
+			instance->m_ImageData.Release();
+			instance->m_ImageData = mipData;
+			instance->Invalidate();
+		});
+	}
+
 	const std::filesystem::path& VulkanTexture2D::GetPath() const
 	{
 		return m_Path;
@@ -465,6 +546,9 @@ namespace Zenith {
 
 	uint32_t VulkanTexture2D::GetMipLevelCount() const
 	{
+		if (m_Specification.Mips > 0)
+			return m_Specification.Mips;
+
 		return Utils::CalculateMipCount(m_Specification.Width, m_Specification.Height);
 	}
 
@@ -772,8 +856,7 @@ namespace Zenith {
 		sampler.mipLodBias = 0.0f;
 		sampler.compareOp = VK_COMPARE_OP_NEVER;
 		sampler.minLod = 0.0f;
-		// Set max level-of-detail to mip level count of the texture
-		sampler.maxLod = (float)mipCount;
+		sampler.maxLod = 100.0f;
 		// Enable anisotropic filtering
 		// This feature is optional, so we must check if it's supported on the device
 
@@ -39,6 +39,8 @@ namespace Zenith {
 		void Unlock() override;
 
 		Buffer GetWriteableBuffer() override;
+		uint32_t GetResidentMip() const override { return m_Specification.ResidentMip; }
+		void SetResidentMip(uint32_t mip, Buffer data) override;
 		bool Loaded() const override { return m_Image && m_Image->IsValid(); }
 		const std::filesystem::path& GetPath() const override;
 		uint32_t GetMipLevelCount() const override;
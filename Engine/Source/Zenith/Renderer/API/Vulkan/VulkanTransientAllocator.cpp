@@ -0,0 +1,281 @@
+#include "znpch.hpp"
+#include "VulkanTransientAllocator.hpp"
+
+#include "VulkanAllocator.hpp"
+#include "VulkanContext.hpp"
+
+#include "Zenith/Debug/Profiler.hpp"
+#include "Zenith/Renderer/Renderer.hpp"
+#include "Zenith/Utilities/StringUtils.hpp"
+
+#include <format>
+#include <mutex>
+
+namespace Zenith {
+
+	struct TransientChunk
+	{
+		VkBuffer Buffer = nullptr;
+		VmaAllocation MemoryAlloc = nullptr;
+		uint8_t* Data = nullptr;
+		uint64_t Capacity = 0; // allocations start before this, the buffer is one binding range larger
+		uint64_t Head = 0;
+		VkDescriptorSet DescriptorSet = nullptr;
+	};
+
+	struct TransientFrame
+	{
+		std::vector<TransientChunk> Chunks;
+		uint32_t CurrentChunk = 0;
+	};
+
+	struct VulkanTransientData
+	{
+		VkDescriptorPool DescriptorPool = nullptr;
+		uint64_t Alignment = 0;
+		std::vector<TransientFrame> Frames;
+		uint32_t FrameIndex = 0;
+		bool ReportedFull = false;
+	};
+
+	static VulkanTransientData* s_Data = nullptr;
+
+	static std::mutex s_LayoutMutex;
+	static VkDescriptorSetLayout s_DescriptorSetLayout = nullptr;
+
+	// A frame that keeps overflowing gets this many chunks at most before allocations fail, they are merged at its next begin
+	static constexpr uint32_t s_MaxChunksPerFrame = 8;
+
+	namespace Utils {
+
+		static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		static TransientChunk CreateTransientChunk(uint64_t capacity, uint32_t frameIndex)
+		{
+			const uint32_t bindingRange = VulkanTransientAllocator::GetBindingRange();
+
+			TransientChunk chunk;
+			chunk.Capacity = capacity;
+
+			VkBufferCreateInfo bufferInfo = {};
+			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
+				| VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+			// Room for a full binding range behind the last allocation
+			bufferInfo.size = capacity + bindingRange;
+
+			VulkanAllocator allocator("TransientBuffer");
+			chunk.MemoryAlloc = allocator.AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_CPU_TO_GPU, chunk.Buffer, (void**)&chunk.Data);
+
+			VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
+			VKUtils::SetDebugUtilsObjectName(device, VK_OBJECT_TYPE_BUFFER, std::format("Transient buffer (frame {})", frameIndex), chunk.Buffer);
+
+			VkDescriptorSetLayout layout = VulkanTransientAllocator::GetDescriptorSetLayout();
+			VkDescriptorSetAllocateInfo allocInfo = Vulkan::DescriptorSetAllocInfo(&layout, 1, s_Data->DescriptorPool);
+			VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &chunk.DescriptorSet));
+
+			const VkDescriptorBufferInfo bufferDescriptor = { chunk.Buffer, 0, bindingRange };
+			VkWriteDescriptorSet writes[2] = {};
+			for (uint32_t i = 0; i < 2; i++)
+			{
+				writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				writes[i].dstSet = chunk.DescriptorSet;
+				writes[i].descriptorCount = 1;
+				writes[i].pBufferInfo = &bufferDescriptor;
+			}
+			writes[0].dstBinding = VulkanTransientAllocator::UniformBinding;
+			writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+			writes[1].dstBinding = VulkanTransientAllocator::StorageBinding;
+			writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+			vkUpdateDescriptorSets(device, 2, writes, 0, nullptr);
+
+			return chunk;
+		}
+
+		static void DestroyTransientChunk(TransientChunk& chunk)
+		{
+			VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
+			VK_CHECK_RESULT(vkFreeDescriptorSets(device, s_Data->DescriptorPool, 1, &chunk.DescriptorSet));
+
+			VulkanAllocator allocator("TransientBuffer");
+			allocator.DestroyBuffer(chunk.Buffer, chunk.MemoryAlloc);
+			chunk = {};
+		}
+
+	}
+
+	VkDescriptorSetLayout VulkanTransientAllocator::GetDescriptorSetLayout()
+	{
+		std::scoped_lock lock(s_LayoutMutex);
+		if (s_DescriptorSetLayout)
+			return s_DescriptorSetLayout;
+
+		VkDescriptorSetLayoutBinding bindings[2] = {};
+		bindings[0].binding = UniformBinding;
+		bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		bindings[0].descriptorCount = 1;
+		bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+
+		bindings[1].binding = StorageBinding;
+		bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+		bindings[1].descriptorCount = 1;
+		bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+
+		VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+		layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layoutInfo.bindingCount = 2;
+		layoutInfo.pBindings = bindings;
+
+		VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
+		VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &s_DescriptorSetLayout));
+		VKUtils::SetDebugUtilsObjectName(device, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, "Transient", s_DescriptorSetLayout);
+		return s_DescriptorSetLayout;
+	}
+
+	uint32_t VulkanTransientAllocator::GetBindingRange()
+	{
+		const VkPhysicalDeviceLimits& limits = VulkanContext::GetCurrentDevice()->GetPhysicalDevice()->GetLimits();
+		return std::min(limits.maxUniformBufferRange, 64u * 1024u);
+	}
+
+	void VulkanTransientAllocator::Init()
+	{
+		s_Data = znew VulkanTransientData();
+
+		const VkPhysicalDeviceLimits& limits = VulkanContext::GetCurrentDevice()->GetPhysicalDevice()->GetLimits();
+		s_Data->Alignment = std::max<uint64_t>({ limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment, 16 });
+
+		const uint32_t framesInFlight = Renderer::GetConfig().FramesInFlight;
+		const uint32_t maxSets = framesInFlight * s_MaxChunksPerFrame;
+
+		VkDescriptorPoolSize poolSizes[] = {
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, maxSets },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, maxSets }
+		};
+
+		VkDescriptorPoolCreateInfo poolInfo = {};
+		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+		poolInfo.maxSets = maxSets;
+		poolInfo.poolSizeCount = (uint32_t)std::size(poolSizes);
+		poolInfo.pPoolSizes = poolSizes;
+
+		VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
+		VK_CHECK_RESULT(vkCreateDescriptorPool(device, &poolInfo, nullptr, &s_Data->DescriptorPool));
+
+		const uint64_t capacity = (uint64_t)Renderer::GetConfig().TransientBufferSizeMB * 1024 * 1024;
+		s_Data->Frames.resize(framesInFlight);
+		for (uint32_t i = 0; i < framesInFlight; i++)
+			s_Data->Frames[i].Chunks.push_back(Utils::CreateTransientChunk(capacity, i));
+	}
+
+	void VulkanTransientAllocator::Shutdown()
+	{
+		VkDevice device = VulkanContext::GetCurrentDevice()->GetVulkanDevice();
+		if (s_Data)
+		{
+			for (TransientFrame& frame : s_Data->Frames)
+			{
+				for (TransientChunk& chunk : frame.Chunks)
+					Utils::DestroyTransientChunk(chunk);
+			}
+
+			vkDestroyDescriptorPool(device, s_Data->DescriptorPool, nullptr);
+			delete s_Data;
+			s_Data = nullptr;
+		}
+
+		std::scoped_lock lock(s_LayoutMutex);
+		if (s_DescriptorSetLayout)
+		{
+			vkDestroyDescriptorSetLayout(device, s_DescriptorSetLayout, nullptr);
+			s_DescriptorSetLayout = nullptr;
+		}
+	}
+
+	VulkanTransientAllocator::Allocation VulkanTransientAllocator::RT_Allocate(uint64_t size)
+	{
+		TransientFrame& frame = s_Data->Frames[s_Data->FrameIndex];
+		while (true)
+		{
+			TransientChunk& chunk = frame.Chunks[frame.CurrentChunk];
+			const uint64_t offset = Utils::AlignUp(chunk.Head, s_Data->Alignment);
+			if (offset + size <= chunk.Capacity)
+			{
+				chunk.Head = offset + size;
+				return { chunk.Buffer, chunk.DescriptorSet, (uint32_t)offset, chunk.Data + offset };
+			}
+
+			if (frame.CurrentChunk + 1 >= frame.Chunks.size())
+				break;
+
+			frame.CurrentChunk++;
+		}
+
+		if (frame.Chunks.size() >= s_MaxChunksPerFrame)
+		{
+			if (!s_Data->ReportedFull)
+				ZN_CORE_ERROR_TAG("Renderer", "Transient buffer of frame {} is full, dropping a {} allocation", s_Data->FrameIndex, Utils::BytesToString(size));
+			s_Data->ReportedFull = true;
+			return {};
+		}
+
+		// Used for the rest of the frame, the chunks are merged into one at the frame's next begin
+		const uint64_t capacity = std::max(frame.Chunks.back().Capacity, Utils::AlignUp(size, s_Data->Alignment));
+		frame.Chunks.push_back(Utils::CreateTransientChunk(capacity, s_Data->FrameIndex));
+		frame.CurrentChunk = (uint32_t)frame.Chunks.size() - 1;
+
+		TransientChunk& chunk = frame.Chunks.back();
+		chunk.Head = size;
+		return { chunk.Buffer, chunk.DescriptorSet, 0, chunk.Data };
+	}
+
+	VulkanTransientAllocator::Allocation VulkanTransientAllocator::RT_Allocate(Buffer data)
+	{
+		Allocation allocation = RT_Allocate(data.Size);
+		if (allocation)
+			memcpy(allocation.Data, data.Data, data.Size);
+		return allocation;
+	}
+
+	void VulkanTransientAllocator::RT_Bind(VkCommandBuffer commandBuffer, VkPipelineLayout layout, const Allocation& allocation, VkPipelineBindPoint bindPoint)
+	{
+		// One dynamic offset per binding, both bindings view the same buffer
+		const uint32_t dynamicOffsets[2] = { allocation.Offset, allocation.Offset };
+		vkCmdBindDescriptorSets(commandBuffer, bindPoint, layout, DescriptorSet, 1, &allocation.DescriptorSet, 2, dynamicOffsets);
+	}
+
+	void VulkanTransientAllocator::RT_BeginFrame(uint32_t frameIndex)
+	{
+		if (!s_Data)
+			return;
+
+		ZN_PROFILE_FUNC();
+
+		s_Data->FrameIndex = frameIndex;
+		s_Data->ReportedFull = false;
+
+		TransientFrame& frame = s_Data->Frames[frameIndex];
+		if (frame.Chunks.size() > 1)
+		{
+			uint64_t capacity = 0;
+			for (TransientChunk& chunk : frame.Chunks)
+			{
+				capacity += chunk.Capacity;
+				Utils::DestroyTransientChunk(chunk);
+			}
+
+			frame.Chunks.clear();
+			frame.Chunks.push_back(Utils::CreateTransientChunk(capacity, frameIndex));
+			ZN_CORE_INFO_TAG("Renderer", "Transient buffer of frame {} grown to {}", frameIndex, Utils::BytesToString(capacity));
+		}
+
+		for (TransientChunk& chunk : frame.Chunks)
+			chunk.Head = 0;
+		frame.CurrentChunk = 0;
+	}
+
+}
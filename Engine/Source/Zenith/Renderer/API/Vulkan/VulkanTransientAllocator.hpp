@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Zenith/Core/Buffer.hpp"
+
+#include "vulkan/vulkan.h"
+
+namespace Zenith {
+
+	// Per-draw data (uniforms, storage, vertices, indices) suballocated from a persistently mapped buffer per frame in flight.
+	// A frame's allocations are recycled once its slot comes around again, after the frame's fence was waited on.
+	// Shaders read it through one global set with dynamic offsets, see DrawData in BasicMesh.glsl.
+	class VulkanTransientAllocator
+	{
+	public:
+		static constexpr uint32_t DescriptorSet = 2;
+		static constexpr uint32_t UniformBinding = 0;
+		static constexpr uint32_t StorageBinding = 1;
+
+		struct Allocation
+		{
+			VkBuffer Buffer = nullptr;
+			VkDescriptorSet DescriptorSet = nullptr; // points at Buffer, bound with Offset as dynamic offset
+			uint32_t Offset = 0;
+			void* Data = nullptr;
+
+			operator bool() const { return Data != nullptr; }
+		};
+
+		static void Init();
+		static void Shutdown();
+
+		// Created on first use, shaders are loaded before the renderer is initialized
+		static VkDescriptorSetLayout GetDescriptorSetLayout();
+		// Bytes a shader can read through the set, starting at an allocation's offset
+		static uint32_t GetBindingRange();
+
+		// Aligned for any of the uses above. Empty if the frame ran out of space, the buffer grows for later frames.
+		static Allocation RT_Allocate(uint64_t size);
+		static Allocation RT_Allocate(Buffer data);
+		static void RT_Bind(VkCommandBuffer commandBuffer, VkPipelineLayout layout, const Allocation& allocation, VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS);
+
+		// Recycles the frame's allocations, its fence has to be signaled
+		static void RT_BeginFrame(uint32_t frameIndex);
+	};
+
+}
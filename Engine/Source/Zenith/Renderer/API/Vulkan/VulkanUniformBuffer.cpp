@@ -35,6 +35,7 @@ namespace Zenith {
 
 		m_Buffer = nullptr;
 		m_MemoryAlloc = nullptr;
+		m_MappedData = nullptr;
 
 		delete[] m_LocalStorage;
 		m_LocalStorage = nullptr;
@@ -58,7 +59,7 @@ namespace Zenith {
 		bufferInfo.size = m_Size;
 
 		VulkanAllocator allocator("UniformBuffer");
-		m_MemoryAlloc = allocator.AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_CPU_TO_GPU, m_Buffer);
+		m_MemoryAlloc = allocator.AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_CPU_TO_GPU, m_Buffer, (void**)&m_MappedData);
 
 		m_DescriptorInfo.buffer = m_Buffer;
 		m_DescriptorInfo.offset = 0;
@@ -78,10 +79,7 @@ namespace Zenith {
 
 	void VulkanUniformBuffer::RT_SetData(const void* data, uint32_t size, uint32_t offset)
 	{
-		VulkanAllocator allocator("VulkanUniformBuffer");
-		uint8_t* pData = allocator.MapMemory<uint8_t>(m_MemoryAlloc);
-		memcpy(pData, (const uint8_t*)data + offset, size);
-		allocator.UnmapMemory(m_MemoryAlloc);
+		memcpy(m_MappedData, (const uint8_t*)data + offset, size);
 	}
 
 
@@ -21,6 +21,7 @@ namespace Zenith {
 		void RT_Invalidate();
 	private:
 		VmaAllocation m_MemoryAlloc = nullptr;
+		uint8_t* m_MappedData = nullptr; // mapped for the buffer's lifetime
 		VkBuffer m_Buffer;
 		VkDescriptorBufferInfo m_DescriptorInfo{};
 		uint32_t m_Size = 0;
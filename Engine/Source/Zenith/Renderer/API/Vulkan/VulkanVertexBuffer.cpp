@@ -24,7 +24,7 @@ namespace Zenith {
 			vertexBufferCreateInfo.size = instance->m_Size;
 			vertexBufferCreateInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
 
-			instance->m_MemoryAllocation = allocator.AllocateBuffer(vertexBufferCreateInfo, VMA_MEMORY_USAGE_CPU_TO_GPU, instance->m_VulkanBuffer);
+			instance->m_MemoryAllocation = allocator.AllocateBuffer(vertexBufferCreateInfo, VMA_MEMORY_USAGE_CPU_TO_GPU, instance->m_VulkanBuffer, (void**)&instance->m_MappedData);
 		});
 	}
 
@@ -57,7 +57,8 @@ namespace Zenith {
 			VkBufferCreateInfo vertexBufferCreateInfo = {};
 			vertexBufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 			vertexBufferCreateInfo.size = instance->m_Size;
-			vertexBufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+			// Source of copies into the MeshPool
+			vertexBufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
 			instance->m_MemoryAllocation = allocator.AllocateBuffer(vertexBufferCreateInfo, VMA_MEMORY_USAGE_GPU_ONLY, instance->m_VulkanBuffer);
 
 			VkCommandBuffer copyCmd = device->GetCommandBuffer(true);
@@ -121,10 +122,8 @@ namespace Zenith {
 	{
 		ZN_PROFILE_FUNC();
 
-		VulkanAllocator allocator("VulkanVertexBuffer");
-		uint8_t* pData = allocator.MapMemory<uint8_t>(m_MemoryAllocation);
-		memcpy(pData, (uint8_t*)buffer + offset, size);
-		allocator.UnmapMemory(m_MemoryAllocation);
+		ZN_CORE_VERIFY(m_MappedData, "Only dynamic vertex buffers can be written");
+		memcpy(m_MappedData, (uint8_t*)buffer + offset, size);
 	}
 
 }
@@ -30,6 +30,7 @@ namespace Zenith {
 
 		VkBuffer m_VulkanBuffer = nullptr;
 		VmaAllocation m_MemoryAllocation;
+		uint8_t* m_MappedData = nullptr; // dynamic buffers only, mapped for their lifetime
 	};
 
 }
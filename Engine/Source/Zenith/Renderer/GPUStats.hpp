@@ -15,6 +15,10 @@ namespace Zenith {
 
 		uint64_t ImageAllocationSize = 0;
 		uint64_t ImageAllocationCount = 0;
+
+		// Heaps with VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, from the VMA heap budgets
+		uint64_t DeviceLocalUsage = 0;
+		uint64_t DeviceLocalBudget = 0;
 	};
 
 }
\ No newline at end of file
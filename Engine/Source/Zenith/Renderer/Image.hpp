@@ -34,6 +34,17 @@ namespace Zenith {
 		DEPTH32F,
 		DEPTH24STENCIL8,
 
+		// Block compressed, 4x4 pixels per block
+		BC1,      // RGB
+		BC1_SRGB,
+		BC3,      // RGBA
+		BC3_SRGB,
+		BC4,      // R
+		BC5,      // RG
+		BC6H,     // RGB half float (unsigned)
+		BC7,      // RGBA
+		BC7_SRGB,
+
 		// Defaults
 		Depth = DEPTH24STENCIL8,
 	};
@@ -186,6 +197,15 @@ namespace Zenith {
 			case ImageFormat::SRGB:
 			case ImageFormat::SRGBA:
 			case ImageFormat::DEPTH24STENCIL8:
+			case ImageFormat::BC1:
+			case ImageFormat::BC1_SRGB:
+			case ImageFormat::BC3:
+			case ImageFormat::BC3_SRGB:
+			case ImageFormat::BC4:
+			case ImageFormat::BC5:
+			case ImageFormat::BC6H:
+			case ImageFormat::BC7:
+			case ImageFormat::BC7_SRGB:
 				return false;
 			}
 			ZN_CORE_ASSERT(false);
@@ -197,8 +217,37 @@ namespace Zenith {
 			return (uint32_t)glm::floor(glm::log2(glm::min(width, height))) + 1;
 		}
 
+		inline bool IsBlockCompressed(ImageFormat format)
+		{
+			return format >= ImageFormat::BC1 && format <= ImageFormat::BC7_SRGB;
+		}
+
+		// Bytes per 4x4 block
+		inline uint32_t GetBlockSize(ImageFormat format)
+		{
+			switch (format)
+			{
+			case ImageFormat::BC1:
+			case ImageFormat::BC1_SRGB:
+			case ImageFormat::BC4:
+				return 8;
+			case ImageFormat::BC3:
+			case ImageFormat::BC3_SRGB:
+			case ImageFormat::BC5:
+			case ImageFormat::BC6H:
+			case ImageFormat::BC7:
+			case ImageFormat::BC7_SRGB:
+				return 16;
+			}
+			ZN_CORE_ASSERT(false);
+			return 0;
+		}
+
 		inline uint32_t GetImageMemorySize(ImageFormat format, uint32_t width, uint32_t height)
 		{
+			if (IsBlockCompressed(format))
+				return ((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+
 			return width * height * GetImageFormatBPP(format);
 		}
 
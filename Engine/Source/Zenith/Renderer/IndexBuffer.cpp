@@ -9,23 +9,23 @@
 
 namespace Zenith {
 
-	Ref<IndexBuffer> IndexBuffer::Create(uint64_t size)
+	Ref<IndexBuffer> IndexBuffer::Create(uint64_t size, IndexType type)
 	{
 		switch (RendererAPI::Current())
 		{
 			case RendererAPIType::None:    return nullptr;
-			case RendererAPIType::Vulkan:  return Ref<VulkanIndexBuffer>::Create(size);
+			case RendererAPIType::Vulkan:  return Ref<VulkanIndexBuffer>::Create(size, type);
 		}
 		ZN_CORE_ASSERT(false, "Unknown RendererAPI");
 		return nullptr;
 	}
 
-	Ref<IndexBuffer> IndexBuffer::Create(void* data, uint64_t size)
+	Ref<IndexBuffer> IndexBuffer::Create(void* data, uint64_t size, IndexType type)
 	{
 		switch (RendererAPI::Current())
 		{
 			case RendererAPIType::None:    return nullptr;
-			case RendererAPIType::Vulkan:  return Ref<VulkanIndexBuffer>::Create(data, size);
+			case RendererAPIType::Vulkan:  return Ref<VulkanIndexBuffer>::Create(data, size, type);
 		}
 		ZN_CORE_ASSERT(false, "Unknown RendererAPI");
 		return nullptr;
@@ -6,6 +6,16 @@
 
 namespace Zenith {
 
+	enum class IndexType : uint8_t
+	{
+		UInt16 = 0, UInt32
+	};
+
+	inline uint32_t GetIndexTypeSize(IndexType type)
+	{
+		return type == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+	}
+
 	class IndexBuffer : public RefCounted
 	{
 	public:
@@ -15,12 +25,13 @@ namespace Zenith {
 		virtual void Bind() const = 0;
 
 		virtual uint32_t GetCount() const = 0;
+		virtual IndexType GetIndexType() const = 0;
 
 		virtual uint64_t GetSize() const = 0;
 		virtual RendererID GetRendererID() const = 0;
 
-		static Ref<IndexBuffer> Create(uint64_t size);
-		static Ref<IndexBuffer> Create(void* data, uint64_t size = 0);
+		static Ref<IndexBuffer> Create(uint64_t size, IndexType type = IndexType::UInt32);
+		static Ref<IndexBuffer> Create(void* data, uint64_t size = 0, IndexType type = IndexType::UInt32);
 	};
 
 }
@@ -5,6 +5,7 @@
 #include "Zenith/Renderer/Shader.hpp"
 #include "Zenith/Renderer/Texture.hpp"
 
+#include <type_traits>
 #include <unordered_set>
 
 namespace Zenith {
@@ -18,6 +19,40 @@ namespace Zenith {
 		DisableShadowCasting = BIT(4)
 	};
 
+	// A uniform resolved once per shader variant, setting through it skips the name lookup
+	struct MaterialParameter
+	{
+		uint32_t Offset = 0;
+		uint32_t Size = 0;
+		ShaderUniformType Type = ShaderUniformType::None;
+		bool InMaterialBuffer = false; // part of MaterialUniformBuffer rather than a push constant block
+		uint32_t LayoutVersion = 0; // of the shader variant it was resolved from
+
+		operator bool() const { return Type != ShaderUniformType::None; }
+	};
+
+	namespace Utils {
+
+		template<typename T>
+		constexpr ShaderUniformType GetShaderUniformType()
+		{
+			if constexpr (std::is_same_v<T, bool>) return ShaderUniformType::Bool;
+			else if constexpr (std::is_same_v<T, int32_t>) return ShaderUniformType::Int;
+			else if constexpr (std::is_same_v<T, uint32_t>) return ShaderUniformType::UInt;
+			else if constexpr (std::is_same_v<T, float>) return ShaderUniformType::Float;
+			else if constexpr (std::is_same_v<T, glm::vec2>) return ShaderUniformType::Vec2;
+			else if constexpr (std::is_same_v<T, glm::vec3>) return ShaderUniformType::Vec3;
+			else if constexpr (std::is_same_v<T, glm::vec4>) return ShaderUniformType::Vec4;
+			else if constexpr (std::is_same_v<T, glm::mat3>) return ShaderUniformType::Mat3;
+			else if constexpr (std::is_same_v<T, glm::mat4>) return ShaderUniformType::Mat4;
+			else if constexpr (std::is_same_v<T, glm::ivec2>) return ShaderUniformType::IVec2;
+			else if constexpr (std::is_same_v<T, glm::ivec3>) return ShaderUniformType::IVec3;
+			else if constexpr (std::is_same_v<T, glm::ivec4>) return ShaderUniformType::IVec4;
+			else static_assert(sizeof(T) == 0, "Type cannot be a material parameter");
+		}
+
+	}
+
 	class Material : public RefCounted
 	{
 	public:
@@ -64,6 +99,27 @@ namespace Zenith {
 		virtual Ref<Texture2D> TryGetTexture2D(const std::string& name) = 0;
 		virtual Ref<TextureCube> TryGetTextureCube(const std::string& name) = 0;
 
+		// Invalid if the shader has no such uniform. Handles have to be resolved again once the shader reloads or switches variant.
+		virtual MaterialParameter GetParameter(const std::string& name) = 0;
+
+		template<typename T>
+		void Set(const MaterialParameter& parameter, const T& value)
+		{
+			constexpr ShaderUniformType type = Utils::GetShaderUniformType<T>();
+			ZN_CORE_ASSERT(parameter.Type == type, "Value does not match the type of the material parameter");
+
+			// Bools are 4-byte ints
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				const int32_t intValue = value;
+				SetParameterData(parameter, &intValue, sizeof(int32_t));
+			}
+			else
+			{
+				SetParameterData(parameter, &value, sizeof(T));
+			}
+		}
+
 #if 0
 		template<typename T>
 		T& Get(const std::string& name)
@@ -107,6 +163,8 @@ namespace Zenith {
 
 		virtual Ref<Shader> GetShader() = 0;
 		virtual const std::string& GetName() const = 0;
+	protected:
+		virtual void SetParameterData(const MaterialParameter& parameter, const void* data, uint32_t size) = 0;
 	};
 
 }
\ No newline at end of file
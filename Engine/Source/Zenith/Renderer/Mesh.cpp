@@ -46,6 +46,7 @@ namespace Zenith
 		submesh.Transform = transform;
 		submesh.MeshName = "Default";
 
+		BuildMeshlets();
 		CreateBuffers();
 
 		m_BoundingBox.Min = { FLT_MAX, FLT_MAX, FLT_MAX };
@@ -70,6 +71,7 @@ namespace Zenith
 		// Generate a new asset handle
 		Handle = {};
 
+		BuildMeshlets();
 		CreateBuffers();
 
 		m_BoundingBox.Min = { FLT_MAX, FLT_MAX, FLT_MAX };
@@ -89,12 +91,154 @@ namespace Zenith
 	void MeshSource::CreateBuffers()
 	{
 		if (!m_Vertices.empty())
-			m_VertexBuffer = VertexBuffer::Create(m_Vertices.data(),
-				static_cast<uint32_t>(m_Vertices.size() * sizeof(Vertex)));
+		{
+			if (m_VertexFormat == VertexFormat::Standard)
+			{
+				m_VertexBuffer = VertexBuffer::Create(m_Vertices.data(),
+					static_cast<uint32_t>(m_Vertices.size() * sizeof(Vertex)));
+			}
+			else
+			{
+				Buffer packed = PackVertices();
+				m_VertexBuffer = VertexBuffer::Create(packed.Data, packed.Size);
+
+				const uint64_t standardSize = m_Vertices.size() * sizeof(Vertex);
+				ZN_CORE_INFO_TAG("Mesh", "Packed {} vertices of '{}' to {} bytes each: {} KB -> {} KB ({:.1f}% less vertex fetch bandwidth)",
+					m_Vertices.size(), m_FilePath, GetVertexStride(), standardSize / 1024, packed.Size / 1024,
+					100.0f * (1.0f - (float)packed.Size / (float)standardSize));
+
+				packed.Release();
+			}
+		}
 
 		if (!m_Indices.empty())
-			m_IndexBuffer = IndexBuffer::Create(m_Indices.data(),
-				static_cast<uint32_t>(m_Indices.size() * sizeof(uint32_t)));
+		{
+			// Submesh indices are relative to BaseVertex, so 16 bits are enough as long as no submesh exceeds 65536 vertices
+			const uint32_t maxIndex = *std::max_element(m_Indices.begin(), m_Indices.end());
+			m_IndexType = maxIndex <= std::numeric_limits<uint16_t>::max() ? IndexType::UInt16 : IndexType::UInt32;
+
+			if (m_IndexType == IndexType::UInt16)
+			{
+				std::vector<uint16_t> indices(m_Indices.begin(), m_Indices.end());
+				m_IndexBuffer = IndexBuffer::Create(indices.data(), indices.size() * sizeof(uint16_t), IndexType::UInt16);
+			}
+			else
+			{
+				m_IndexBuffer = IndexBuffer::Create(m_Indices.data(), m_Indices.size() * sizeof(uint32_t), IndexType::UInt32);
+			}
+
+			ZN_MESH_LOG("'{}' uses {}-bit indices (max index {})", m_FilePath, GetIndexTypeSize(m_IndexType) * 8, maxIndex);
+		}
+	}
+
+	uint32_t MeshSource::GetVertexStride() const
+	{
+		return m_VertexFormat == VertexFormat::Standard ? sizeof(Vertex) : VertexCompression::GetPackedStride(m_VertexFormat);
+	}
+
+	Buffer MeshSource::PackVertices()
+	{
+		ZN_PROFILE_FUNC();
+
+		const uint32_t stride = GetVertexStride();
+		Buffer packed;
+		packed.Allocate(m_Vertices.size() * stride);
+
+		if (m_VertexFormat == VertexFormat::Compact)
+		{
+			CompactVertex* vertices = packed.As<CompactVertex>();
+			for (size_t i = 0; i < m_Vertices.size(); i++)
+			{
+				const Vertex& v = m_Vertices[i];
+				vertices[i] = VertexCompression::PackCompact(v.Position, v.Normal, v.Tangent, v.Binormal, v.Texcoord);
+			}
+			return packed;
+		}
+
+		// Quantize every submesh against its own bounds. Submeshes sharing vertices fall back to the mesh bounds.
+		glm::vec3 meshMin(FLT_MAX), meshMax(-FLT_MAX);
+		for (const Vertex& v : m_Vertices)
+		{
+			meshMin = glm::min(meshMin, v.Position);
+			meshMax = glm::max(meshMax, v.Position);
+		}
+
+		std::vector<int32_t> owner(m_Vertices.size(), -1);
+		bool sharedVertices = false;
+		for (uint32_t s = 0; s < m_Submeshes.size() && !sharedVertices; s++)
+		{
+			const Submesh& submesh = m_Submeshes[s];
+			for (uint32_t i = submesh.BaseVertex; i < submesh.BaseVertex + submesh.VertexCount && i < m_Vertices.size(); i++)
+			{
+				if (owner[i] != -1)
+				{
+					sharedVertices = true;
+					break;
+				}
+				owner[i] = (int32_t)s;
+			}
+		}
+
+		for (Submesh& submesh : m_Submeshes)
+		{
+			glm::vec3 min = meshMin, max = meshMax;
+			if (!sharedVertices && submesh.VertexCount > 0)
+			{
+				min = glm::vec3(FLT_MAX);
+				max = glm::vec3(-FLT_MAX);
+				for (uint32_t i = submesh.BaseVertex; i < submesh.BaseVertex + submesh.VertexCount && i < m_Vertices.size(); i++)
+				{
+					min = glm::min(min, m_Vertices[i].Position);
+					max = glm::max(max, m_Vertices[i].Position);
+				}
+			}
+
+			submesh.QuantizationOffset = min;
+			submesh.QuantizationScale = max - min;
+		}
+
+		QuantizedVertex* vertices = packed.As<QuantizedVertex>();
+		for (size_t i = 0; i < m_Vertices.size(); i++)
+		{
+			glm::vec3 offset = meshMin, scale = meshMax - meshMin;
+			if (!sharedVertices && owner[i] != -1)
+			{
+				offset = m_Submeshes[owner[i]].QuantizationOffset;
+				scale = m_Submeshes[owner[i]].QuantizationScale;
+			}
+
+			const Vertex& v = m_Vertices[i];
+			vertices[i] = VertexCompression::PackQuantized(v.Position, v.Normal, v.Tangent, v.Binormal, v.Texcoord, offset, scale);
+		}
+
+		return packed;
+	}
+
+	void MeshSource::BuildMeshlets(const MeshletBuildSettings& settings)
+	{
+		ZN_PROFILE_FUNC();
+
+		m_Meshlets.clear();
+		for (Submesh& submesh : m_Submeshes)
+		{
+			submesh.MeshletOffset = static_cast<uint32_t>(m_Meshlets.size());
+			submesh.MeshletCount = 0;
+
+			if (submesh.IndexCount == 0 || submesh.VertexCount == 0 || submesh.BaseIndex + submesh.IndexCount > m_Indices.size()
+				|| submesh.BaseVertex + submesh.VertexCount > m_Vertices.size())
+				continue;
+
+			std::span<uint32_t> indices(m_Indices.data() + submesh.BaseIndex, submesh.IndexCount);
+			const Vertex& baseVertex = m_Vertices[submesh.BaseVertex];
+
+			std::vector<Meshlet> meshlets = MeshletBuilder::Build(indices, &baseVertex.Position, &baseVertex.Normal,
+				submesh.VertexCount, sizeof(Vertex), settings);
+
+			submesh.MeshletCount = static_cast<uint32_t>(meshlets.size());
+			m_Meshlets.insert(m_Meshlets.end(), meshlets.begin(), meshlets.end());
+		}
+
+		ZN_MESH_LOG("Built {} meshlets for {} submeshes in '{}'", m_Meshlets.size(), m_Submeshes.size(), m_FilePath);
 	}
 
 	bool MeshSource::ValidateIndices() const
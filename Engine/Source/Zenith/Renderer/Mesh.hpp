@@ -6,8 +6,10 @@
 
 #include "Zenith/Renderer/IndexBuffer.hpp"
 #include "Zenith/Renderer/MaterialAsset.hpp"
+#include "Zenith/Renderer/Meshlet.hpp"
 #include "Zenith/Renderer/UniformBuffer.hpp"
 #include "Zenith/Renderer/VertexBuffer.hpp"
+#include "Zenith/Renderer/VertexCompression.hpp"
 
 #include <vector>
 #include <glm/glm.hpp>
@@ -19,8 +21,8 @@ namespace Zenith {
 		glm::vec3 Position = {0.0f, 0.0f, 0.0f};
 		glm::vec3 Normal = {0.0f, 0.0f, 1.0f};
 		glm::vec3 Tangent = {1.0f, 0.0f, 0.0f};
-		glm::vec3 Binormal = {0.0f, 1.0f, 0.0f};
 		glm::vec2 Texcoord = {0.0f, 0.0f};
+		glm::vec3 Binormal = {0.0f, 1.0f, 0.0f}; // Last so shaders can skip it, packed formats reconstruct it
 	};
 
 	static const int NumAttributes = 5;
@@ -41,6 +43,12 @@ namespace Zenith {
 		uint32_t MaterialIndex = 0;
 		uint32_t IndexCount = 0;
 		uint32_t VertexCount = 0;
+		uint32_t MeshletOffset = 0; // Into MeshSource::GetMeshlets()
+		uint32_t MeshletCount = 0;
+
+		// Dequantization of VertexFormat::CompactQuantized positions: position = offset + unorm * scale
+		glm::vec3 QuantizationOffset = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 QuantizationScale = { 1.0f, 1.0f, 1.0f };
 
 		glm::mat4 Transform{ 1.0f }; // World transform
 		glm::mat4 LocalTransform{ 1.0f };
@@ -55,6 +63,8 @@ namespace Zenith {
 			serializer->WriteRaw(instance.MaterialIndex);
 			serializer->WriteRaw(instance.IndexCount);
 			serializer->WriteRaw(instance.VertexCount);
+			serializer->WriteRaw(instance.QuantizationOffset);
+			serializer->WriteRaw(instance.QuantizationScale);
 			serializer->WriteRaw(instance.Transform);
 			serializer->WriteRaw(instance.LocalTransform);
 			serializer->WriteRaw(instance.BoundingBox);
@@ -69,6 +79,8 @@ namespace Zenith {
 			deserializer->ReadRaw(instance.MaterialIndex);
 			deserializer->ReadRaw(instance.IndexCount);
 			deserializer->ReadRaw(instance.VertexCount);
+			deserializer->ReadRaw(instance.QuantizationOffset);
+			deserializer->ReadRaw(instance.QuantizationScale);
 			deserializer->ReadRaw(instance.Transform);
 			deserializer->ReadRaw(instance.LocalTransform);
 			deserializer->ReadRaw(instance.BoundingBox);
@@ -122,6 +134,7 @@ namespace Zenith {
 		const std::vector<Vertex>& GetVertices() const { return m_Vertices; }
 		const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
 		const std::vector<Submesh>& GetSubmeshes() const { return m_Submeshes; }
+		const std::vector<Meshlet>& GetMeshlets() const { return m_Meshlets; }
 
 		std::vector<Vertex>& GetVertices() { return m_Vertices; }
 		std::vector<uint32_t>& GetIndices() { return m_Indices; }
@@ -130,6 +143,10 @@ namespace Zenith {
 		Ref<VertexBuffer> GetVertexBuffer() const { return m_VertexBuffer; }
 		Ref<IndexBuffer> GetIndexBuffer() const { return m_IndexBuffer; }
 
+		VertexFormat GetVertexFormat() const { return m_VertexFormat; }
+		IndexType GetIndexType() const { return m_IndexType; }
+		uint32_t GetVertexStride() const;
+
 		const std::vector<MeshNode>& GetNodes() const { return m_Nodes; }
 		const std::vector<uint32_t>& GetRootNodes() const { return m_RootNodes; }
 
@@ -147,9 +164,12 @@ namespace Zenith {
 		std::vector<Vertex> m_Vertices;
 		std::vector<uint32_t> m_Indices;
 		std::vector<Submesh> m_Submeshes;
+		std::vector<Meshlet> m_Meshlets;
 
 		Ref<VertexBuffer> m_VertexBuffer;
 		Ref<IndexBuffer> m_IndexBuffer;
+		VertexFormat m_VertexFormat = VertexFormat::Standard;
+		IndexType m_IndexType = IndexType::UInt32;
 
 		std::vector<MeshNode> m_Nodes;
 		std::vector<uint32_t> m_RootNodes;
@@ -160,6 +180,10 @@ namespace Zenith {
 		std::string m_FilePath;
 
 		void CreateBuffers();
+		Buffer PackVertices();
+
+		// Reorders each submesh's indices into meshlet order, must run before the index buffer is created
+		void BuildMeshlets(const MeshletBuildSettings& settings = {});
 
 		bool ValidateIndices() const;
 
@@ -0,0 +1,124 @@
+#include "znpch.hpp"
+#include "MeshPool.hpp"
+
+#include "Zenith/Renderer/API/Vulkan/VulkanMeshPool.hpp"
+
+#include "Zenith/Renderer/RendererAPI.hpp"
+
+namespace Zenith {
+
+	uint64_t MeshPoolArena::Allocate(uint64_t size, uint32_t elementSize)
+	{
+		ZN_CORE_ASSERT(elementSize > 0);
+
+		for (auto it = m_FreeBlocks.begin(); it != m_FreeBlocks.end(); ++it)
+		{
+			const auto [blockOffset, blockSize] = *it;
+			const uint64_t offset = (blockOffset + elementSize - 1) / elementSize * elementSize;
+			if (offset + size > blockOffset + blockSize)
+				continue;
+
+			// What is left in front of and behind the range stays free
+			m_FreeBlocks.erase(it);
+			if (offset > blockOffset)
+				m_FreeBlocks[blockOffset] = offset - blockOffset;
+			if (offset + size < blockOffset + blockSize)
+				m_FreeBlocks[offset + size] = blockOffset + blockSize - (offset + size);
+			return offset;
+		}
+
+		const uint64_t offset = (m_Size + elementSize - 1) / elementSize * elementSize;
+		if (offset > m_Size)
+			m_FreeBlocks[m_Size] = offset - m_Size;
+		m_Size = offset + size;
+
+		if (m_Size > m_Capacity)
+			m_Capacity = std::max({ m_Capacity * 2, m_Size, m_InitialCapacity });
+
+		return offset;
+	}
+
+	void MeshPoolArena::Free(uint64_t offset, uint64_t size)
+	{
+		ZN_CORE_ASSERT(offset + size <= m_Size);
+
+		uint64_t begin = offset;
+		uint64_t end = offset + size;
+
+		auto next = m_FreeBlocks.lower_bound(begin);
+		if (next != m_FreeBlocks.end() && next->first == end)
+		{
+			end += next->second;
+			next = m_FreeBlocks.erase(next);
+		}
+
+		if (next != m_FreeBlocks.begin())
+		{
+			auto previous = std::prev(next);
+			if (previous->first + previous->second == begin)
+			{
+				begin = previous->first;
+				m_FreeBlocks.erase(previous);
+			}
+		}
+
+		// A free block at the end just shortens the arena
+		if (end == m_Size)
+			m_Size = begin;
+		else
+			m_FreeBlocks[begin] = end - begin;
+	}
+
+	uint64_t MeshPoolArena::GetFreeBytes() const
+	{
+		uint64_t freeBytes = m_Capacity - m_Size;
+		for (const auto& [offset, size] : m_FreeBlocks)
+			freeBytes += size;
+		return freeBytes;
+	}
+
+	Ref<MeshPool> MeshPool::Create()
+	{
+		switch (RendererAPI::Current())
+		{
+			case RendererAPIType::None:    return nullptr;
+			case RendererAPIType::Vulkan:  return Ref<VulkanMeshPool>::Create();
+		}
+		ZN_CORE_ASSERT(false, "Unknown RendererAPI");
+		return nullptr;
+	}
+
+	std::vector<MeshPool::IndirectBatch> MeshPool::SplitIntoBatches(std::span<DrawIndexedIndirectCommand> commands, uint32_t maxInstances)
+	{
+		std::vector<IndirectBatch> batches;
+
+		size_t batchBegin = 0;
+		while (batchBegin < commands.size())
+		{
+			IndirectBatch& batch = batches.emplace_back();
+			batch.FirstCommand = (uint32_t)batchBegin;
+			batch.FirstInstance = commands[batchBegin].FirstInstance;
+
+			uint32_t instanceEnd = batch.FirstInstance;
+			size_t batchEnd = batchBegin;
+			for (; batchEnd < commands.size(); batchEnd++)
+			{
+				DrawIndexedIndirectCommand& command = commands[batchEnd];
+				ZN_CORE_ASSERT(command.FirstInstance >= batch.FirstInstance, "Indirect draws have to be ordered by instance");
+				if (command.FirstInstance + command.InstanceCount > batch.FirstInstance + maxInstances)
+					break;
+
+				instanceEnd = std::max(instanceEnd, command.FirstInstance + command.InstanceCount);
+				command.FirstInstance -= batch.FirstInstance;
+			}
+			ZN_CORE_VERIFY(batchEnd > batchBegin, "Indirect draw has more instances than fit in the draw data");
+
+			batch.CommandCount = (uint32_t)(batchEnd - batchBegin);
+			batch.InstanceCount = instanceEnd - batch.FirstInstance;
+			batchBegin = batchEnd;
+		}
+
+		return batches;
+	}
+
+}
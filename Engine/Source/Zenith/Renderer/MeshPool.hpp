@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Zenith/Asset/Asset.hpp"
+#include "Zenith/Core/Ref.hpp"
+
+#include "Zenith/Renderer/IndexBuffer.hpp"
+#include "Zenith/Renderer/RendererTypes.hpp"
+#include "Zenith/Renderer/VertexCompression.hpp"
+
+#include <map>
+#include <span>
+#include <vector>
+
+namespace Zenith {
+
+	class MeshSource;
+
+	// Byte ranges of one pooled buffer. Freed blocks are merged with their neighbours and reused first fit, the
+	// capacity doubles when nothing fits. Does no locking and knows nothing about the GPU buffer.
+	class MeshPoolArena
+	{
+	public:
+		explicit MeshPoolArena(uint64_t initialCapacity = 0)
+			: m_InitialCapacity(initialCapacity) {}
+
+		// Offset of size bytes, a multiple of elementSize (strides of packed vertices are not powers of two)
+		uint64_t Allocate(uint64_t size, uint32_t elementSize);
+		// Exactly a range returned by Allocate
+		void Free(uint64_t offset, uint64_t size);
+
+		// End of the last range in use
+		uint64_t GetSize() const { return m_Size; }
+		// The buffer has to be at least this large for the ranges handed out so far
+		uint64_t GetCapacity() const { return m_Capacity; }
+		uint64_t GetFreeBytes() const;
+	private:
+		uint64_t m_InitialCapacity;
+		uint64_t m_Size = 0;
+		uint64_t m_Capacity = 0;
+		std::map<uint64_t, uint64_t> m_FreeBlocks; // offset -> size, all below m_Size
+	};
+
+	// Shared vertex and index buffers that meshes are copied into, so draws of different meshes bind the same buffers
+	// and can go out in one indirect draw. Vertices are pooled per vertex format, indices per index type.
+	class MeshPool : public RefCounted
+	{
+	public:
+		struct MeshRange
+		{
+			uint32_t FirstVertex = 0; // added to the submesh BaseVertex
+			uint32_t FirstIndex = 0;  // added to the submesh BaseIndex
+			bool Valid = false;
+
+			operator bool() const { return Valid; }
+		};
+
+		// Consecutive indirect draws whose instances are bound as one range of draw data
+		struct IndirectBatch
+		{
+			uint32_t FirstCommand = 0;
+			uint32_t CommandCount = 0;
+			uint32_t FirstInstance = 0; // of the draw data range
+			uint32_t InstanceCount = 0;
+		};
+
+		virtual ~MeshPool() = default;
+
+		// Copies the mesh's buffers into the pool on first use, later calls return the same range. Meshes are told apart
+		// by a key the caller picks, e.g. the asset handle. A reloaded mesh (same key, another source) gets a new range
+		// and the old one is freed. The caller keeps the source alive until it removes it.
+		virtual MeshRange GetOrAdd(uint64_t key, const Ref<MeshSource>& meshSource) = 0;
+		// Frees the mesh's range, the space is reused once no frame in flight draws from it
+		virtual void Remove(uint64_t key) = 0;
+
+		static Ref<MeshPool> Create();
+
+		// Splits draws ordered by instance into batches of at most maxInstances instances and makes each draw's
+		// FirstInstance relative to its batch
+		static std::vector<IndirectBatch> SplitIntoBatches(std::span<DrawIndexedIndirectCommand> commands, uint32_t maxInstances);
+	};
+
+}
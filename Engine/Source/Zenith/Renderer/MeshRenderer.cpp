@@ -1,7 +1,9 @@
 #include "znpch.hpp"
 #include "MeshRenderer.hpp"
 
+#include "Zenith/Renderer/MaterialAsset.hpp"
 #include "Zenith/Renderer/Renderer.hpp"
+#include "Zenith/Renderer/TextureStreamer.hpp"
 
 #include "Zenith/Core/Application.hpp"
 #include "Zenith/Asset/AssetManager.hpp"
@@ -10,6 +12,17 @@
 
 namespace Zenith {
 
+	namespace Utils {
+
+		// Assets are keyed by handle, so a reloaded asset replaces the old one. Sources created without the asset manager
+		// have no handle and are keyed by address, which stays theirs while the mesh cache holds them.
+		static uint64_t GetMeshKey(const Ref<MeshSource>& meshSource)
+		{
+			return meshSource->Handle ? (uint64_t)meshSource->Handle : (uint64_t)(uintptr_t)meshSource.Raw();
+		}
+
+	}
+
 	MeshRenderer::MeshRenderer()
 	{
 	}
@@ -48,31 +61,63 @@ namespace Zenith {
 		CreateRenderPass();
 
 		m_Material = Material::Create(m_MeshShader);
+		m_Material->Set("u_AlbedoTexture", Renderer::GetWhiteTexture());
+
+		// Only the bindless variant reads color and shininess from the material, the other one has these as constants
+		if (m_Material->GetParameter("u_AlbedoColor"))
+		{
+			m_Material->Set("u_AlbedoColor", glm::vec3(0.2f, 0.3f, 0.8f));
+			m_Material->Set("u_Shininess", 18.0f);
+		}
+
+		if (Renderer::GetConfig().IndirectMeshDrawing)
+			m_MeshPool = MeshPool::Create();
 	}
 
 	void MeshRenderer::Shutdown()
 	{
 		m_Pipeline = nullptr;
+		m_CompactPipeline = nullptr;
+		m_QuantizedPipeline = nullptr;
 		m_RenderPass = nullptr;
 		m_MeshShader = nullptr;
 		m_Material = nullptr;
 		m_CommandBuffer = nullptr;
 		m_TransformBuffer = nullptr;
-		m_CachedStaticMeshes.clear();
+		m_MeshPool = nullptr;
+		m_CachedMeshes.clear();
 	}
 
 	void MeshRenderer::CreatePipeline()
 	{
-		VertexBufferLayout vertexLayout = {
+		// Every format feeds the same BasicMesh inputs (position, normal, tangent, texcoord), see VertexCompression.hpp
+		// The binormal of standard vertices is skipped, the shader reconstructs it
+		m_Pipeline = CreatePipeline("MeshRenderer-Pipeline", VertexBufferLayout({
 			{ ShaderDataType::Float3, "Position" },
 			{ ShaderDataType::Float3, "Normal" },
 			{ ShaderDataType::Float3, "Tangent" },
-			{ ShaderDataType::Float3, "Binormal" },
 			{ ShaderDataType::Float2, "TexCoord" }
-		};
+		}, sizeof(Vertex)));
+
+		m_CompactPipeline = CreatePipeline("MeshRenderer-CompactPipeline", {
+			{ ShaderDataType::Float3, "Position" },
+			{ ShaderDataType::Short2, "Normal", true },
+			{ ShaderDataType::Short2, "Tangent", true },
+			{ ShaderDataType::Half2, "TexCoord" }
+		});
+
+		m_QuantizedPipeline = CreatePipeline("MeshRenderer-QuantizedPipeline", {
+			{ ShaderDataType::UShort4, "Position", true },
+			{ ShaderDataType::Short2, "Normal", true },
+			{ ShaderDataType::Short2, "Tangent", true },
+			{ ShaderDataType::Half2, "TexCoord" }
+		});
+	}
 
+	Ref<Pipeline> MeshRenderer::CreatePipeline(const std::string& debugName, const VertexBufferLayout& vertexLayout)
+	{
 		PipelineSpecification pipelineSpec;
-		pipelineSpec.DebugName = "MeshRenderer-Pipeline";
+		pipelineSpec.DebugName = debugName;
 		pipelineSpec.Shader = m_MeshShader;
 		pipelineSpec.TargetFramebuffer = m_Framebuffer;
 		pipelineSpec.Layout = vertexLayout;
@@ -83,7 +128,18 @@ namespace Zenith {
 		pipelineSpec.DepthOperator = DepthCompareOperator::LessOrEqual;
 		pipelineSpec.Topology = PrimitiveTopology::Triangles;
 
-		m_Pipeline = Pipeline::Create(pipelineSpec);
+		return Pipeline::Create(pipelineSpec);
+	}
+
+	Ref<Pipeline> MeshRenderer::GetPipeline(VertexFormat format) const
+	{
+		switch (format)
+		{
+			case VertexFormat::Standard:         return m_Pipeline;
+			case VertexFormat::Compact:          return m_CompactPipeline;
+			case VertexFormat::CompactQuantized: return m_QuantizedPipeline;
+		}
+		return m_Pipeline;
 	}
 
 	void MeshRenderer::CreateRenderPass()
@@ -102,6 +158,13 @@ namespace Zenith {
 		m_CameraPosition = cameraPosition;
 		m_SceneActive = true;
 
+		m_MeshletCuller.SetView(viewProjection, cameraPosition);
+		m_MeshletCuller.SetBackfaceCulling(Renderer::GetConfig().MeshletConeCulling);
+		m_Statistics = {};
+		m_BoundVertexFormat = VertexFormat::Standard; // The render pass binds m_Pipeline
+
+		ReleaseUnusedMeshes();
+
 		m_CommandBuffer->Begin();
 
 		// Since we're using an offscreen framebuffer (SwapChainTarget = false),
@@ -109,18 +172,42 @@ namespace Zenith {
 		Renderer::BeginRenderPass(m_CommandBuffer, m_RenderPass, true);
 	}
 
-	Ref<StaticMesh> MeshRenderer::GetOrCreateStaticMesh(Ref<MeshSource> meshSource)
+	MeshRenderer::CachedMesh& MeshRenderer::GetCachedMesh(Ref<MeshSource> meshSource)
 	{
-		MeshSource* key = meshSource.Raw();
-		auto it = m_CachedStaticMeshes.find(key);
-		if (it != m_CachedStaticMeshes.end())
-			return it->second;
+		const uint64_t key = Utils::GetMeshKey(meshSource);
+		auto it = m_CachedMeshes.find(key);
+		if (it != m_CachedMeshes.end())
+		{
+			if (it->second.Source == meshSource)
+				return it->second;
 
-		AssetHandle handle = meshSource->Handle;
-		Ref<StaticMesh> staticMesh = Ref<StaticMesh>::Create(handle);
-		m_CachedStaticMeshes[key] = staticMesh;
+			// Reloaded, the pool only tells sources apart while the old one is alive
+			if (m_MeshPool)
+				m_MeshPool->Remove(key);
+			m_CachedMeshes.erase(it);
+		}
+
+		CachedMesh& cachedMesh = m_CachedMeshes[key];
+		cachedMesh.Source = meshSource;
+		cachedMesh.Mesh = Ref<StaticMesh>::Create(meshSource->Handle);
+		return cachedMesh;
+	}
 
-		return staticMesh;
+	void MeshRenderer::ReleaseUnusedMeshes()
+	{
+		for (auto it = m_CachedMeshes.begin(); it != m_CachedMeshes.end();)
+		{
+			if (it->second.Source->GetRefCount() == 1)
+			{
+				if (m_MeshPool)
+					m_MeshPool->Remove(it->first);
+				it = m_CachedMeshes.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
 	}
 
 	void MeshRenderer::DrawMesh(Ref<MeshSource> meshSource, const glm::mat4& transform)
@@ -128,7 +215,7 @@ namespace Zenith {
 		if (!m_SceneActive || !meshSource)
 			return;
 
-		Ref<StaticMesh> staticMesh = GetOrCreateStaticMesh(meshSource);
+		Ref<StaticMesh> staticMesh = GetCachedMesh(meshSource).Mesh;
 
 		const auto& nodes = meshSource->GetNodes();
 		if (!nodes.empty()) {
@@ -144,32 +231,8 @@ namespace Zenith {
 			}
 		} else {
 			const auto& submeshes = meshSource->GetSubmeshes();
-			for (uint32_t i = 0; i < submeshes.size(); i++) {
-				const auto& submesh = submeshes[i];
-
-				struct MeshPushConstants {
-					alignas(16) glm::mat4 model;
-					alignas(16) glm::mat4 viewProjection;
-					alignas(16) glm::mat4 normalMatrix;
-					alignas(16) glm::vec4 cameraPosition;
-				};
-
-				glm::mat4 modelMatrix = transform * submesh.Transform;
-				MeshPushConstants pushConstants;
-				pushConstants.model = modelMatrix;
-				pushConstants.viewProjection = m_ViewProjectionMatrix;
-				pushConstants.normalMatrix = glm::transpose(glm::inverse(modelMatrix));
-				pushConstants.cameraPosition = glm::vec4(m_CameraPosition, 1.0f);
-
-				Buffer ConstantBuffer = Buffer::Copy(&pushConstants, sizeof(MeshPushConstants));
-
-				Renderer::RenderStaticMeshWithMaterial(
-					m_CommandBuffer, m_Pipeline, staticMesh, meshSource, i,
-					m_TransformBuffer, 0, 1, m_Material, ConstantBuffer
-				);
-
-				ConstantBuffer.Release();
-			}
+			for (uint32_t i = 0; i < submeshes.size(); i++)
+				SubmitSubmesh(meshSource, staticMesh, i, transform * submeshes[i].Transform);
 		}
 	}
 
@@ -184,32 +247,8 @@ namespace Zenith {
 
 		for (uint32_t submeshIndex : node.Submeshes) {
 			const auto& submeshes = meshSource->GetSubmeshes();
-			if (submeshIndex < submeshes.size()) {
-				const auto& submesh = submeshes[submeshIndex];
-
-				struct MeshPushConstants {
-					alignas(16) glm::mat4 model;
-					alignas(16) glm::mat4 viewProjection;
-					alignas(16) glm::mat4 normalMatrix;
-					alignas(16) glm::vec4 cameraPosition;
-				};
-
-				glm::mat4 modelMatrix = nodeTransform * submesh.Transform;
-				MeshPushConstants pushConstants;
-				pushConstants.model = modelMatrix;
-				pushConstants.viewProjection = m_ViewProjectionMatrix;
-				pushConstants.normalMatrix = glm::transpose(glm::inverse(modelMatrix));
-				pushConstants.cameraPosition = glm::vec4(m_CameraPosition, 1.0f);
-
-				Buffer ConstantBuffer = Buffer::Copy(&pushConstants, sizeof(MeshPushConstants));
-
-				Renderer::RenderStaticMeshWithMaterial(
-					m_CommandBuffer, m_Pipeline, staticMesh, meshSource, submeshIndex,
-					m_TransformBuffer, 0, 1, m_Material, ConstantBuffer
-				);
-
-				ConstantBuffer.Release();
-			}
+			if (submeshIndex < submeshes.size())
+				SubmitSubmesh(meshSource, staticMesh, submeshIndex, nodeTransform * submeshes[submeshIndex].Transform);
 		}
 
 		// Recursively traverse children
@@ -218,11 +257,228 @@ namespace Zenith {
 		}
 	}
 
+	void MeshRenderer::SubmitSubmesh(Ref<MeshSource> meshSource, Ref<StaticMesh> staticMesh, uint32_t submeshIndex, const glm::mat4& modelMatrix)
+	{
+		const Submesh& submesh = meshSource->GetSubmeshes()[submeshIndex];
+
+		if (Renderer::GetConfig().TextureStreaming)
+			RequestTextureMips(meshSource, submeshIndex, modelMatrix);
+
+		const VertexFormat vertexFormat = meshSource->GetVertexFormat();
+
+		MeshInstanceData instance;
+		instance.Model = modelMatrix;
+		instance.NormalMatrix = glm::transpose(glm::inverse(modelMatrix));
+
+		// Quantized positions are relative to the submesh bounds
+		if (vertexFormat == VertexFormat::CompactQuantized)
+		{
+			instance.DequantizeScale = glm::vec4(submesh.QuantizationScale, 0.0f);
+			instance.DequantizeOffset = glm::vec4(submesh.QuantizationOffset, 0.0f);
+		}
+
+		const bool clusters = Renderer::GetConfig().MeshletCulling && submesh.MeshletCount > 0;
+		std::vector<DrawIndexedIndirectCommand> drawRanges;
+		if (clusters)
+		{
+			std::span<const Meshlet> meshlets(meshSource->GetMeshlets().data() + submesh.MeshletOffset, submesh.MeshletCount);
+			uint32_t visibleCount = m_MeshletCuller.Cull(meshlets, modelMatrix, submesh.BaseIndex, static_cast<int32_t>(submesh.BaseVertex), drawRanges);
+
+			m_Statistics.TotalMeshlets += submesh.MeshletCount;
+			m_Statistics.VisibleMeshlets += visibleCount;
+			m_Statistics.DrawCalls += static_cast<uint32_t>(drawRanges.size());
+
+			if (drawRanges.empty())
+				return;
+		}
+		else
+		{
+			m_Statistics.DrawCalls++;
+		}
+
+		// Meshes in the pool are drawn indirectly at the end of the scene, together with the others of their bucket
+		if (MeshPool::MeshRange range = m_MeshPool ? m_MeshPool->GetOrAdd(Utils::GetMeshKey(meshSource), meshSource) : MeshPool::MeshRange())
+		{
+			IndirectBucket& bucket = m_IndirectBuckets[(uint32_t)vertexFormat][(uint32_t)meshSource->GetIndexType()];
+			const uint32_t instanceIndex = (uint32_t)bucket.Instances.size();
+			bucket.Instances.push_back(instance);
+
+			if (!clusters)
+				drawRanges.push_back({ submesh.IndexCount, 1, submesh.BaseIndex, static_cast<int32_t>(submesh.BaseVertex), 0 });
+
+			for (DrawIndexedIndirectCommand& draw : drawRanges)
+			{
+				draw.FirstIndex += range.FirstIndex;
+				draw.VertexOffset += static_cast<int32_t>(range.FirstVertex);
+				draw.FirstInstance = instanceIndex;
+				bucket.Commands.push_back(draw);
+			}
+			return;
+		}
+
+		Ref<Pipeline> pipeline = GetPipeline(vertexFormat);
+		if (vertexFormat != m_BoundVertexFormat)
+		{
+			Renderer::BindPipeline(m_CommandBuffer, pipeline);
+			m_BoundVertexFormat = vertexFormat;
+		}
+
+		// A single instance, read by the shader at gl_InstanceIndex 0
+		struct
+		{
+			MeshSceneData Scene;
+			MeshInstanceData Instance;
+		} drawData = { GetSceneData(vertexFormat), instance };
+		Buffer drawDataBuffer(&drawData, sizeof(drawData)); // copied by the renderer
+
+		if (clusters)
+		{
+			Renderer::RenderStaticMeshClustersWithMaterial(
+				m_CommandBuffer, pipeline, staticMesh, meshSource, submeshIndex, std::move(drawRanges),
+				m_TransformBuffer, 0, 1, m_Material, drawDataBuffer
+			);
+		}
+		else
+		{
+			Renderer::RenderStaticMeshWithMaterial(
+				m_CommandBuffer, pipeline, staticMesh, meshSource, submeshIndex,
+				m_TransformBuffer, 0, 1, m_Material, drawDataBuffer
+			);
+		}
+	}
+
+	MeshRenderer::MeshSceneData MeshRenderer::GetSceneData(VertexFormat vertexFormat) const
+	{
+		MeshSceneData sceneData;
+		sceneData.ViewProjection = m_ViewProjectionMatrix;
+		sceneData.CameraPosition = glm::vec4(m_CameraPosition, vertexFormat == VertexFormat::Standard ? 0.0f : 1.0f); // w: packed normals
+		return sceneData;
+	}
+
+	void MeshRenderer::SubmitIndirectDraws()
+	{
+		for (uint32_t format = 0; format < m_IndirectBuckets.size(); format++)
+		{
+			const VertexFormat vertexFormat = (VertexFormat)format;
+			for (uint32_t indexType = 0; indexType < m_IndirectBuckets[format].size(); indexType++)
+			{
+				IndirectBucket& bucket = m_IndirectBuckets[format][indexType];
+				if (bucket.Commands.empty())
+					continue;
+
+				Ref<Pipeline> pipeline = GetPipeline(vertexFormat);
+				if (vertexFormat != m_BoundVertexFormat)
+				{
+					Renderer::BindPipeline(m_CommandBuffer, pipeline);
+					m_BoundVertexFormat = vertexFormat;
+				}
+
+				const MeshSceneData sceneData = GetSceneData(vertexFormat);
+				Renderer::RenderMeshesIndirect(m_CommandBuffer, pipeline, m_MeshPool, vertexFormat, (IndexType)indexType, std::move(bucket.Commands), m_Material,
+					Buffer(&sceneData, sizeof(MeshSceneData)), Buffer(bucket.Instances.data(), bucket.Instances.size() * sizeof(MeshInstanceData)), sizeof(MeshInstanceData));
+				m_Statistics.IndirectBatches++;
+
+				bucket.Commands.clear();
+				bucket.Instances.clear();
+			}
+		}
+	}
+
+	void MeshRenderer::RequestTextureMips(Ref<MeshSource> meshSource, uint32_t submeshIndex, const glm::mat4& modelMatrix)
+	{
+		const Submesh& submesh = meshSource->GetSubmeshes()[submeshIndex];
+		const auto& materials = meshSource->GetMaterials();
+		if (submesh.MaterialIndex >= materials.size())
+			return;
+
+		AsyncAssetResult<MaterialAsset> material = AssetManager::GetAssetAsync<MaterialAsset>(materials[submesh.MaterialIndex]);
+		if (!material.IsReady || !material.Asset)
+			return;
+
+		// Screen pixels per local unit, from the projected bounds. Bounds reaching behind the camera get full detail.
+		const AABB& bounds = submesh.BoundingBox;
+		const glm::mat4 localToClip = m_ViewProjectionMatrix * modelMatrix;
+		glm::vec2 screenMin(FLT_MAX), screenMax(-FLT_MAX);
+		bool behindCamera = false;
+		for (uint32_t corner = 0; corner < 8 && !behindCamera; corner++)
+		{
+			const glm::vec3 position(corner & 1 ? bounds.Max.x : bounds.Min.x, corner & 2 ? bounds.Max.y : bounds.Min.y, corner & 4 ? bounds.Max.z : bounds.Min.z);
+			const glm::vec4 clip = localToClip * glm::vec4(position, 1.0f);
+			behindCamera = clip.w <= 0.0f;
+
+			const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+			screenMin = glm::min(screenMin, ndc);
+			screenMax = glm::max(screenMax, ndc);
+		}
+
+		float pixelsPerUnit = FLT_MAX;
+		if (!behindCamera)
+		{
+			if (screenMax.x < -1.0f || screenMin.x > 1.0f || screenMax.y < -1.0f || screenMin.y > 1.0f)
+				return;
+
+			const glm::vec2 screenSize = (screenMax - screenMin) * 0.5f * glm::vec2(m_Framebuffer->GetWidth(), m_Framebuffer->GetHeight());
+			pixelsPerUnit = glm::length(screenSize) / glm::max(glm::length(bounds.Max - bounds.Min), FLT_EPSILON);
+		}
+
+		const float uvDensity = GetUVDensity(meshSource, submeshIndex);
+		for (const Ref<Texture2D>& texture : { material.Asset->GetAlbedoMap(), material.Asset->GetNormalMap(), material.Asset->GetMetalnessMap(), material.Asset->GetRoughnessMap() })
+		{
+			if (texture)
+				TextureStreamer::RequestMip(texture, TextureStreamer::CalculateRequiredMip(glm::max(texture->GetWidth(), texture->GetHeight()), uvDensity, pixelsPerUnit));
+		}
+	}
+
+	float MeshRenderer::GetUVDensity(Ref<MeshSource> meshSource, uint32_t submeshIndex)
+	{
+		std::vector<float>& densities = GetCachedMesh(meshSource).UVDensities;
+		if (densities.empty())
+		{
+			const auto& submeshes = meshSource->GetSubmeshes();
+			const auto& vertices = meshSource->GetVertices();
+			const auto& indices = meshSource->GetIndices();
+			densities.resize(submeshes.size(), 0.0f);
+
+			// Square root of the texture coordinate area over the surface area, for the whole submesh
+			for (size_t i = 0; i < submeshes.size(); i++)
+			{
+				const Submesh& submesh = submeshes[i];
+				if (submesh.BaseIndex + submesh.IndexCount > indices.size())
+					continue;
+
+				double uvArea = 0.0, localArea = 0.0;
+				for (uint32_t index = 0; index + 2 < submesh.IndexCount; index += 3)
+				{
+					const uint32_t i0 = submesh.BaseVertex + indices[submesh.BaseIndex + index];
+					const uint32_t i1 = submesh.BaseVertex + indices[submesh.BaseIndex + index + 1];
+					const uint32_t i2 = submesh.BaseVertex + indices[submesh.BaseIndex + index + 2];
+					if (i0 >= vertices.size() || i1 >= vertices.size() || i2 >= vertices.size())
+						continue;
+
+					const Vertex& v0 = vertices[i0];
+					const Vertex& v1 = vertices[i1];
+					const Vertex& v2 = vertices[i2];
+					localArea += glm::length(glm::cross(v1.Position - v0.Position, v2.Position - v0.Position));
+
+					const glm::vec2 uv1 = v1.Texcoord - v0.Texcoord;
+					const glm::vec2 uv2 = v2.Texcoord - v0.Texcoord;
+					uvArea += glm::abs(uv1.x * uv2.y - uv1.y * uv2.x);
+				}
+
+				if (localArea > 0.0)
+					densities[i] = (float)glm::sqrt(uvArea / localArea);
+			}
+		}
+
+		return submeshIndex < densities.size() ? densities[submeshIndex] : 0.0f;
+	}
+
 	void MeshRenderer::EndScene()
 	{
 		if (!m_SceneActive)
 			return;
 
+		SubmitIndirectDraws();
 		Renderer::EndRenderPass(m_CommandBuffer);
 
 		m_CommandBuffer->End();
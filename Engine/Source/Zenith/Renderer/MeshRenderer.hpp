@@ -4,6 +4,7 @@
 #include "Zenith/Core/Ref.hpp"
 
 #include "Zenith/Renderer/Mesh.hpp"
+#include "Zenith/Renderer/MeshPool.hpp"
 
 #include "Zenith/Renderer/Pipeline.hpp"
 #include "Zenith/Renderer/Shader.hpp"
@@ -19,6 +20,7 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <array>
 #include <unordered_map>
 
 #include "imgui.h"
@@ -48,28 +50,88 @@ namespace Zenith {
 
 		ImTextureID GetTextureImGuiID(Ref<Image2D> image);
 		void ClearTextureCache();
+
+		struct Statistics
+		{
+			uint32_t TotalMeshlets = 0;
+			uint32_t VisibleMeshlets = 0;
+			uint32_t DrawCalls = 0;
+			uint32_t IndirectBatches = 0; // RenderMeshesIndirect calls the pooled draws went out with
+		};
+
+		const Statistics& GetStatistics() const { return m_Statistics; }
 	private:
+		// Layout of DrawData in BasicMesh.glsl, the scene data is followed by the instances
+		struct MeshSceneData
+		{
+			glm::mat4 ViewProjection;
+			glm::vec4 CameraPosition; // w: 1 when normal/tangent are packed
+		};
+
+		struct MeshInstanceData
+		{
+			glm::mat4 Model;
+			glm::mat4 NormalMatrix;
+			glm::vec4 DequantizeScale = { 1.0f, 1.0f, 1.0f, 0.0f };
+			glm::vec4 DequantizeOffset = { 0.0f, 0.0f, 0.0f, 0.0f };
+		};
+
+		// Draws of one pipeline and index type, sent as one indirect draw at the end of the scene
+		struct IndirectBucket
+		{
+			std::vector<DrawIndexedIndirectCommand> Commands;
+			std::vector<MeshInstanceData> Instances;
+		};
+
+		struct CachedMesh
+		{
+			Ref<MeshSource> Source; // the entry was built from, a reload under the same key replaces the entry
+			Ref<StaticMesh> Mesh;
+			std::vector<float> UVDensities; // texture coordinate units per local unit, per submesh
+		};
+
 		void CreatePipeline();
+		Ref<Pipeline> CreatePipeline(const std::string& debugName, const VertexBufferLayout& vertexLayout);
+		Ref<Pipeline> GetPipeline(VertexFormat format) const;
 		void CreateRenderPass();
-		Ref<StaticMesh> GetOrCreateStaticMesh(Ref<MeshSource> meshSource);
+		CachedMesh& GetCachedMesh(Ref<MeshSource> meshSource);
+		// Drops the meshes only the cache still refers to, and their ranges in the mesh pool
+		void ReleaseUnusedMeshes();
 
 		void TraverseNodeHierarchy(Ref<MeshSource> meshSource, Ref<StaticMesh> staticMesh,
 		const std::vector<MeshNode>& nodes, uint32_t nodeIndex, const glm::mat4& parentTransform);
+		void SubmitSubmesh(Ref<MeshSource> meshSource, Ref<StaticMesh> staticMesh, uint32_t submeshIndex, const glm::mat4& modelMatrix);
+		void SubmitIndirectDraws();
+		MeshSceneData GetSceneData(VertexFormat vertexFormat) const;
+
+		// Tells the texture streamer which mips of the submesh's material textures this draw samples
+		void RequestTextureMips(Ref<MeshSource> meshSource, uint32_t submeshIndex, const glm::mat4& modelMatrix);
+		float GetUVDensity(Ref<MeshSource> meshSource, uint32_t submeshIndex);
 
 	private:
 		Ref<Shader> m_MeshShader;
 		Ref<Pipeline> m_Pipeline;
+		Ref<Pipeline> m_CompactPipeline;
+		Ref<Pipeline> m_QuantizedPipeline;
+		VertexFormat m_BoundVertexFormat = VertexFormat::Standard;
 		Ref<RenderPass> m_RenderPass;
 		Ref<Framebuffer> m_Framebuffer;
 		Ref<Material> m_Material;
 		Ref<RenderCommandBuffer> m_CommandBuffer;
 		Ref<VertexBuffer> m_TransformBuffer;
 
+		// Null when indirect drawing is disabled
+		Ref<MeshPool> m_MeshPool;
+		std::array<std::array<IndirectBucket, 2>, 3> m_IndirectBuckets; // per VertexFormat and IndexType
+
 		glm::mat4 m_ViewProjectionMatrix;
 		glm::vec3 m_CameraPosition;
 		bool m_SceneActive = false;
 
-		std::unordered_map<MeshSource*, Ref<StaticMesh>> m_CachedStaticMeshes;
+		MeshletCuller m_MeshletCuller;
+		Statistics m_Statistics;
+
+		std::unordered_map<uint64_t, CachedMesh> m_CachedMeshes; // by GetMeshKey, the key of the mesh pool too
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "znpch.hpp"
+#include "Meshlet.hpp"
+
+#include "Zenith/Debug/Profiler.hpp"
+
+namespace Zenith {
+
+	// Triangles whose normals deviate further than ~84 degrees from the cone axis make the cone useless
+	static constexpr float s_MinConeSpread = 0.1f;
+
+	namespace Utils {
+
+		static const glm::vec3& GetAttribute(const glm::vec3* base, size_t stride, uint32_t index)
+		{
+			return *reinterpret_cast<const glm::vec3*>(reinterpret_cast<const uint8_t*>(base) + stride * index);
+		}
+
+		static void ComputeMeshletBounds(Meshlet& meshlet, std::span<const uint32_t> triangles,
+			const glm::vec3* positions, const glm::vec3* normals, size_t stride)
+		{
+			glm::vec3 min(FLT_MAX);
+			glm::vec3 max(-FLT_MAX);
+			for (uint32_t index : triangles)
+			{
+				const glm::vec3& position = GetAttribute(positions, stride, index);
+				min = glm::min(min, position);
+				max = glm::max(max, position);
+			}
+
+			meshlet.Center = (min + max) * 0.5f;
+			meshlet.Radius = 0.0f;
+			for (uint32_t index : triangles)
+				meshlet.Radius = glm::max(meshlet.Radius, glm::length(GetAttribute(positions, stride, index) - meshlet.Center));
+
+			// Normal cone
+			const size_t triangleCount = triangles.size() / 3;
+			std::vector<glm::vec3> faceNormals;
+			faceNormals.reserve(triangleCount);
+
+			glm::vec3 axis(0.0f);
+			for (size_t i = 0; i < triangleCount; i++)
+			{
+				uint32_t i0 = triangles[i * 3 + 0];
+				uint32_t i1 = triangles[i * 3 + 1];
+				uint32_t i2 = triangles[i * 3 + 2];
+
+				const glm::vec3& p0 = GetAttribute(positions, stride, i0);
+				glm::vec3 normal = glm::cross(GetAttribute(positions, stride, i1) - p0, GetAttribute(positions, stride, i2) - p0);
+
+				float length = glm::length(normal);
+				if (length <= 0.0f)
+					continue;
+
+				normal /= length;
+
+				// Orient by the authored shading normals so the cone does not depend on the winding convention of the source format
+				if (normals)
+				{
+					glm::vec3 shadingNormal = GetAttribute(normals, stride, i0) + GetAttribute(normals, stride, i1) + GetAttribute(normals, stride, i2);
+					if (glm::dot(normal, shadingNormal) < 0.0f)
+						normal = -normal;
+				}
+
+				faceNormals.push_back(normal);
+				axis += normal;
+			}
+
+			meshlet.ConeAxis = glm::vec3(0.0f);
+			meshlet.ConeCutoff = 1.0f;
+
+			float axisLength = glm::length(axis);
+			if (faceNormals.empty() || axisLength <= 0.0f)
+				return;
+
+			axis /= axisLength;
+
+			float minDot = 1.0f;
+			for (const glm::vec3& normal : faceNormals)
+				minDot = glm::min(minDot, glm::dot(normal, axis));
+
+			if (minDot <= s_MinConeSpread)
+				return;
+
+			// Store sin(spread) - the view direction has to lie inside the (90 - spread) degree cone around the axis
+			meshlet.ConeAxis = axis;
+			meshlet.ConeCutoff = glm::sqrt(1.0f - minDot * minDot);
+		}
+
+		static bool HasUniformScale(const glm::mat4& transform)
+		{
+			float x = glm::length(glm::vec3(transform[0]));
+			float y = glm::length(glm::vec3(transform[1]));
+			float z = glm::length(glm::vec3(transform[2]));
+			return glm::abs(x - y) <= 0.01f * x && glm::abs(x - z) <= 0.01f * x;
+		}
+
+	}
+
+	std::vector<Meshlet> MeshletBuilder::Build(std::span<uint32_t> indices,
+		const glm::vec3* positions, const glm::vec3* normals, uint32_t vertexCount, size_t vertexStride,
+		const MeshletBuildSettings& settings)
+	{
+		ZN_PROFILE_FUNC();
+
+		std::vector<Meshlet> meshlets;
+		if (indices.empty() || !positions || indices.size() % 3 != 0)
+			return meshlets;
+
+		const uint32_t maxVertices = glm::clamp(settings.MaxVertices, 3u, 255u);
+		const uint32_t maxTriangles = glm::clamp(settings.MaxTriangles, 1u, 512u);
+
+		for (uint32_t index : indices)
+		{
+			if (index >= vertexCount)
+			{
+				ZN_CORE_WARN_TAG("Mesh", "Cannot build meshlets, index {} is out of range (vertex count: {})", index, vertexCount);
+				return meshlets;
+			}
+		}
+
+		std::vector<uint32_t> reordered;
+		reordered.reserve(indices.size());
+
+		// Stamp of the meshlet that last referenced a vertex, avoids clearing a set per meshlet
+		std::vector<uint32_t> vertexStamp(vertexCount, UINT32_MAX);
+
+		Meshlet current;
+		uint32_t stamp = 0;
+
+		auto flush = [&]()
+		{
+			if (current.IndexCount == 0)
+				return;
+
+			std::span<const uint32_t> triangles(reordered.data() + current.IndexOffset, current.IndexCount);
+			Utils::ComputeMeshletBounds(current, triangles, positions, normals, vertexStride);
+			meshlets.push_back(current);
+
+			current = {};
+			current.IndexOffset = static_cast<uint32_t>(reordered.size());
+			stamp++;
+		};
+
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			const uint32_t triangle[3] = { indices[i], indices[i + 1], indices[i + 2] };
+
+			uint32_t newVertices = 0;
+			for (uint32_t v = 0; v < 3; v++)
+			{
+				bool seenInTriangle = (v > 0 && triangle[v] == triangle[0]) || (v > 1 && triangle[v] == triangle[1]);
+				if (vertexStamp[triangle[v]] != stamp && !seenInTriangle)
+					newVertices++;
+			}
+
+			if (current.VertexCount + newVertices > maxVertices || current.IndexCount / 3 >= maxTriangles)
+			{
+				flush();
+				newVertices = 0;
+				for (uint32_t v = 0; v < 3; v++)
+				{
+					bool seenInTriangle = (v > 0 && triangle[v] == triangle[0]) || (v > 1 && triangle[v] == triangle[1]);
+					if (!seenInTriangle)
+						newVertices++;
+				}
+			}
+
+			for (uint32_t v = 0; v < 3; v++)
+			{
+				vertexStamp[triangle[v]] = stamp;
+				reordered.push_back(triangle[v]);
+			}
+
+			current.VertexCount += newVertices;
+			current.IndexCount += 3;
+		}
+
+		flush();
+
+		std::copy(reordered.begin(), reordered.end(), indices.begin());
+		return meshlets;
+	}
+
+	MeshletCuller::MeshletCuller(const glm::mat4& viewProjection, const glm::vec3& cameraPosition)
+	{
+		SetView(viewProjection, cameraPosition);
+	}
+
+	void MeshletCuller::SetView(const glm::mat4& viewProjection, const glm::vec3& cameraPosition)
+	{
+		m_ViewProjection = viewProjection;
+		m_CameraPosition = cameraPosition;
+	}
+
+	bool MeshletCuller::IsBackfacing(const Meshlet& meshlet, const glm::vec3& cameraPosition)
+	{
+		// Conservative: every point of the bounding sphere has to be seen from within the back side of the cone
+		glm::vec3 toCluster = meshlet.Center - cameraPosition;
+		float distance = glm::length(toCluster);
+		return glm::dot(toCluster, meshlet.ConeAxis) >= meshlet.ConeCutoff * (distance + meshlet.Radius) + meshlet.Radius;
+	}
+
+	uint32_t MeshletCuller::Cull(std::span<const Meshlet> meshlets, const glm::mat4& transform,
+		uint32_t baseIndex, int32_t baseVertex, std::vector<DrawIndexedIndirectCommand>& outDraws) const
+	{
+		ZN_PROFILE_FUNC();
+
+		// Cull in mesh space so meshlet bounds never have to be transformed
+		const Frustum frustum(m_ViewProjection * transform);
+		const glm::vec3 localCameraPosition = glm::vec3(glm::inverse(transform) * glm::vec4(m_CameraPosition, 1.0f));
+
+		// Normal cones do not survive non-uniform scaling
+		const bool backfaceCulling = m_BackfaceCulling && Utils::HasUniformScale(transform);
+
+		const size_t firstDraw = outDraws.size();
+		uint32_t visibleCount = 0;
+
+		for (const Meshlet& meshlet : meshlets)
+		{
+			if (m_FrustumCulling && !frustum.IsSphereVisible(meshlet.Center, meshlet.Radius))
+				continue;
+
+			if (backfaceCulling && IsBackfacing(meshlet, localCameraPosition))
+				continue;
+
+			visibleCount++;
+
+			const uint32_t firstIndex = baseIndex + meshlet.IndexOffset;
+			if (outDraws.size() > firstDraw)
+			{
+				DrawIndexedIndirectCommand& last = outDraws.back();
+				if (last.FirstIndex + last.IndexCount == firstIndex)
+				{
+					last.IndexCount += meshlet.IndexCount;
+					continue;
+				}
+			}
+
+			DrawIndexedIndirectCommand& draw = outDraws.emplace_back();
+			draw.IndexCount = meshlet.IndexCount;
+			draw.InstanceCount = 1;
+			draw.FirstIndex = firstIndex;
+			draw.VertexOffset = baseVertex;
+			draw.FirstInstance = 0;
+		}
+
+		return visibleCount;
+	}
+
+}
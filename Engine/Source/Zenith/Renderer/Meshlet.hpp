@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Zenith/Math/Frustum.hpp"
+#include "Zenith/Renderer/RendererTypes.hpp"
+
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Zenith {
+
+	//
+	// A meshlet (cluster) is a small, spatially coherent group of triangles inside a submesh.
+	// The importer reorders each submesh's indices so that every meshlet is one contiguous
+	// index range, which means visible clusters can be drawn straight out of the regular index buffer.
+	//
+	struct Meshlet
+	{
+		uint32_t IndexOffset = 0; // Relative to Submesh::BaseIndex
+		uint32_t IndexCount = 0;
+		uint32_t VertexCount = 0; // Unique vertices referenced by this meshlet
+
+		// Bounding sphere (mesh space)
+		glm::vec3 Center = { 0.0f, 0.0f, 0.0f };
+		float Radius = 0.0f;
+
+		// Normal cone, a cutoff of 1 means the cone is too wide to ever be backface culled
+		glm::vec3 ConeAxis = { 0.0f, 0.0f, 0.0f };
+		float ConeCutoff = 1.0f;
+	};
+
+	struct MeshletBuildSettings
+	{
+		uint32_t MaxVertices = 64;   // 64-128 keeps clusters mesh-shader friendly
+		uint32_t MaxTriangles = 124;
+	};
+
+	class MeshletBuilder
+	{
+	public:
+		// Splits an indexed triangle list into meshlets.
+		// `indices` are reordered in place so that each returned meshlet is a contiguous range.
+		// `normals` is optional; when provided it is used to orient triangle normals for the cone.
+		static std::vector<Meshlet> Build(std::span<uint32_t> indices,
+			const glm::vec3* positions, const glm::vec3* normals, uint32_t vertexCount, size_t vertexStride,
+			const MeshletBuildSettings& settings = {});
+	};
+
+	class MeshletCuller
+	{
+	public:
+		MeshletCuller() = default;
+		MeshletCuller(const glm::mat4& viewProjection, const glm::vec3& cameraPosition);
+
+		void SetView(const glm::mat4& viewProjection, const glm::vec3& cameraPosition);
+
+		void SetFrustumCulling(bool enabled) { m_FrustumCulling = enabled; }
+		void SetBackfaceCulling(bool enabled) { m_BackfaceCulling = enabled; }
+
+		// Culls the meshlets of one submesh instance and appends the visible index ranges to `outDraws`.
+		// Adjacent visible meshlets are merged into a single draw. Returns the number of visible meshlets.
+		uint32_t Cull(std::span<const Meshlet> meshlets, const glm::mat4& transform,
+			uint32_t baseIndex, int32_t baseVertex, std::vector<DrawIndexedIndirectCommand>& outDraws) const;
+
+		static bool IsBackfacing(const Meshlet& meshlet, const glm::vec3& cameraPosition);
+
+	private:
+		glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+		glm::vec3 m_CameraPosition = { 0.0f, 0.0f, 0.0f };
+
+		bool m_FrustumCulling = true;
+		bool m_BackfaceCulling = true;
+	};
+
+}
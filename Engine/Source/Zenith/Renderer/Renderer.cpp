@@ -4,13 +4,21 @@
 #include "Shader.hpp"
 
 #include "RendererAPI.hpp"
+#include "TextureStreamer.hpp"
 
 #include "Zenith/Core/Timer.hpp"
 #include "Zenith/Debug/Profiler.hpp"
+#include "Zenith/Renderer/API/Vulkan/VulkanBindlessDescriptors.hpp"
 #include "Zenith/Renderer/API/Vulkan/VulkanContext.hpp"
 #include "Zenith/Renderer/API/Vulkan/VulkanRenderer.hpp"
+#include "Zenith/Renderer/API/Vulkan/VulkanShader.hpp"
+#include "Zenith/Renderer/API/Vulkan/ShaderPack/VulkanShaderPack.hpp"
 #include "Zenith/Project/Project.hpp"
 
+#if ZN_HAS_SHADER_COMPILER
+#include "Zenith/Renderer/API/Vulkan/ShaderCompiler/VulkanShaderCompiler.hpp"
+#endif
+
 #include <filesystem>
 #include <format>
 #include <shared_mutex>
@@ -100,6 +108,7 @@ namespace Zenith {
 	struct RendererData
 	{
 		Ref<ShaderLibrary> m_ShaderLibrary;
+		Ref<VulkanShaderPack> ShaderPack;
 
 		Ref<Texture2D> WhiteTexture;
 		Ref<Texture2D> BlackTexture;
@@ -143,7 +152,18 @@ namespace Zenith {
 
 		s_Data->m_ShaderLibrary = Ref<ShaderLibrary>::Create();
 
-		Renderer::GetShaderLibrary()->Load("Resources/Shaders/BasicMesh.glsl");
+		// Selects the bindless path of Bindless.glslh, known before the first shader compiles
+		if (VulkanBindlessDescriptors::IsEnabled())
+			s_Data->GlobalShaderMacros["__ZN_BINDLESS"] = "1";
+
+#if ZN_USE_SHADER_PACK
+		s_Data->ShaderPack = VulkanShaderPack::Open(s_Config.ShaderPackPath);
+		ZN_CORE_VERIFY(s_Data->ShaderPack, "Failed to open shader pack {}, build it with the Zenith-ShaderPack target", s_Config.ShaderPackPath);
+#endif
+
+		Renderer::GetShaderLibrary()->LoadAll({
+			"Resources/Shaders/BasicMesh.glsl",
+		});
 
 		Renderer::GetApplication()->GetRenderThread().Pump();
 
@@ -213,10 +233,14 @@ namespace Zenith {
 		}
 
 		s_RendererAPI->Init();
+
+		if (s_Config.TextureStreaming)
+			TextureStreamer::Init();
 	}
 
 	void Renderer::Shutdown()
 	{
+		TextureStreamer::Shutdown();
 		s_RendererAPI->Shutdown();
 
 		delete s_Data;
@@ -242,6 +266,11 @@ namespace Zenith {
 		return s_Data->m_ShaderLibrary;
 	}
 
+	Ref<VulkanShaderPack> Renderer::GetShaderPack()
+	{
+		return s_Data->ShaderPack;
+	}
+
 	void Renderer::RenderThreadFunc(RenderThread* renderThread)
 	{
 		ZN_PROFILE_THREAD("Render Thread");
@@ -315,6 +344,11 @@ namespace Zenith {
 		s_RendererAPI->EndRenderPass(renderCommandBuffer);
 	}
 
+	void Renderer::BindPipeline(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline)
+	{
+		s_RendererAPI->BindPipeline(renderCommandBuffer, pipeline);
+	}
+
 	void Renderer::InsertGPUPerfMarker(Ref<RenderCommandBuffer> renderCommandBuffer, const std::string& label, const glm::vec4& color)
 	{
 		s_RendererAPI->InsertGPUPerfMarker(renderCommandBuffer, label, color);
@@ -347,6 +381,7 @@ namespace Zenith {
 
 	void Renderer::BeginFrame()
 	{
+		TextureStreamer::Update();
 		s_RendererAPI->BeginFrame();
 	}
 
@@ -365,6 +400,16 @@ namespace Zenith {
 		s_RendererAPI->RenderStaticMeshWithMaterial(renderCommandBuffer, pipeline, mesh, meshSource, submeshIndex, material, transformBuffer, transformOffset, instanceCount, additionalUniforms);
 	}
 
+	void Renderer::RenderStaticMeshClustersWithMaterial(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<StaticMesh> mesh, Ref<MeshSource> meshSource, uint32_t submeshIndex, std::vector<DrawIndexedIndirectCommand> drawRanges, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, uint32_t instanceCount, Ref<Material> material, Buffer additionalUniforms)
+	{
+		s_RendererAPI->RenderStaticMeshClustersWithMaterial(renderCommandBuffer, pipeline, mesh, meshSource, submeshIndex, std::move(drawRanges), material, transformBuffer, transformOffset, instanceCount, additionalUniforms);
+	}
+
+	void Renderer::RenderMeshesIndirect(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<MeshPool> meshPool, VertexFormat vertexFormat, IndexType indexType, std::vector<DrawIndexedIndirectCommand> drawCommands, Ref<Material> material, Buffer sceneData, Buffer instanceData, uint32_t instanceStride)
+	{
+		s_RendererAPI->RenderMeshesIndirect(renderCommandBuffer, pipeline, meshPool, vertexFormat, indexType, std::move(drawCommands), material, sceneData, instanceData, instanceStride);
+	}
+
 	void Renderer::RenderQuad(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<Material> material, const glm::mat4& transform)
 	{
 		s_RendererAPI->RenderQuad(renderCommandBuffer, pipeline, material, transform);
@@ -437,6 +482,11 @@ namespace Zenith {
 
 	const std::unordered_map<std::string, std::string>& Renderer::GetGlobalShaderMacros()
 	{
+		// Tools compile shaders without a renderer
+		static const std::unordered_map<std::string, std::string> s_NoMacros;
+		if (!s_Data)
+			return s_NoMacros;
+
 		return s_Data->GlobalShaderMacros;
 	}
 
@@ -490,12 +540,36 @@ namespace Zenith {
 
 	bool Renderer::UpdateDirtyShaders()
 	{
-		// TODO: how is this going to work for dist?
-		const bool updatedAnyShaders = s_GlobalShaderInfo.DirtyShaders.size();
+		bool updatedAnyShaders = false;
+#if !ZN_USE_SHADER_PACK
+		updatedAnyShaders = VulkanShaderCompiler::ApplyFinishedVariants();
+#endif
+
+		std::vector<Ref<VulkanShader>> shaders;
 		for (WeakRef<Shader> shader : s_GlobalShaderInfo.DirtyShaders)
 		{
 			ZN_CORE_ASSERT(shader.IsValid(), "Shader is deleted!");
-			shader->RT_Reload(true);
+			shaders.push_back(Ref<Shader>(&*shader).As<VulkanShader>());
+		}
+
+		// The set is ordered by address, queue (and report errors) in the same order every time
+		std::sort(shaders.begin(), shaders.end(), [](const Ref<VulkanShader>& a, const Ref<VulkanShader>& b) { return a->GetName() < b->GetName(); });
+
+		// Variants compiled before are switched to right away, the others are compiled in the background
+		// and the shader keeps its current variant until then
+		for (Ref<VulkanShader>& shader : shaders)
+		{
+			const ShaderMacros macros = shader->GetVariantMacros();
+			const uint64_t variantKey = Shader::GetVariantKey(macros);
+			const bool changed = variantKey != shader->GetVariantKey();
+			if (shader->RT_TrySetVariant(variantKey))
+				updatedAnyShaders |= changed;
+			else
+#if ZN_USE_SHADER_PACK
+				ZN_CORE_WARN_TAG("Renderer", "Shader pack has no variant {:016x} of {}, keeping the current one", variantKey, shader->GetName());
+#else
+				VulkanShaderCompiler::CompileVariantAsync(shader, macros);
+#endif
 		}
 		s_GlobalShaderInfo.DirtyShaders.clear();
 
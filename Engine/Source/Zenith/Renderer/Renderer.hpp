@@ -5,6 +5,7 @@
 #include "RenderCommandBuffer.hpp"
 #include "RenderPass.hpp"
 #include "Mesh.hpp"
+#include "MeshPool.hpp"
 #include "RenderCommandBuffer.hpp"
 #include "UniformBufferSet.hpp"
 #include "StorageBufferSet.hpp"
@@ -23,6 +24,7 @@
 
 namespace Zenith {
 	class Application;
+	class VulkanShaderPack;
 
 	class Renderer
 	{
@@ -45,6 +47,8 @@ namespace Zenith {
 		static RendererCapabilities& GetCapabilities();
 
 		static Ref<ShaderLibrary> GetShaderLibrary();
+		// Null unless ZN_USE_SHADER_PACK
+		static Ref<VulkanShaderPack> GetShaderPack();
 
 		template<typename FuncT>
 		static void Submit(FuncT&& func)
@@ -105,6 +109,9 @@ namespace Zenith {
 		static void BeginRenderPass(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<RenderPass> renderPass, bool explicitClear = false);
 		static void EndRenderPass(Ref<RenderCommandBuffer> renderCommandBuffer);
 
+		// Switches to another pipeline compatible with the active render pass (e.g. a different vertex layout)
+		static void BindPipeline(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline);
+
 		static void BeginGPUPerfMarker(Ref<RenderCommandBuffer> renderCommandBuffer, const std::string& label, const glm::vec4& markerColor = {});
 		static void InsertGPUPerfMarker(Ref<RenderCommandBuffer> renderCommandBuffer, const std::string& label, const glm::vec4& markerColor = {});
 		static void EndGPUPerfMarker(Ref<RenderCommandBuffer> renderCommandBuffer);
@@ -118,6 +125,10 @@ namespace Zenith {
 
 		static void RenderStaticMesh(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<StaticMesh> mesh, Ref<MeshSource> meshSource, uint32_t submeshIndex, Ref<MaterialTable> materialTable, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, uint32_t instanceCount);
 		static void RenderStaticMeshWithMaterial(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<StaticMesh> mesh, Ref<MeshSource> meshSource, uint32_t submeshIndex, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, uint32_t instanceCount, Ref<Material> material, Buffer additionalUniforms = Buffer());
+		static void RenderStaticMeshClustersWithMaterial(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<StaticMesh> mesh, Ref<MeshSource> meshSource, uint32_t submeshIndex, std::vector<DrawIndexedIndirectCommand> drawRanges, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, uint32_t instanceCount, Ref<Material> material, Buffer additionalUniforms = Buffer());
+		// Draws meshes of the pool with as few indirect draws as the draw data allows. sceneData is followed by the instances in the
+		// shader's storage buffer, each command's FirstInstance indexes instanceData. Commands have to be ordered by FirstInstance.
+		static void RenderMeshesIndirect(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<MeshPool> meshPool, VertexFormat vertexFormat, IndexType indexType, std::vector<DrawIndexedIndirectCommand> drawCommands, Ref<Material> material, Buffer sceneData, Buffer instanceData, uint32_t instanceStride);
 		static void RenderGeometry(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<Material> material, Ref<VertexBuffer> vertexBuffer, Ref<IndexBuffer> indexBuffer, const glm::mat4& transform, uint32_t indexCount = 0);
 		static void RenderQuad(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<Material> material, const glm::mat4& transform);
 		static void SubmitFullscreenQuad(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<Material> material);
@@ -149,6 +160,8 @@ namespace Zenith {
 		static void AcknowledgeParsedGlobalMacros(const std::unordered_set<std::string>& macros, Ref<Shader> shader);
 		static void SetMacroInShader(Ref<Shader> shader, const std::string& name, const std::string& value = "");
 		static void SetGlobalMacroInShaders(const std::string& name, const std::string& value = "");
+		// On the render thread: switches shaders whose macros changed to the matching variant, compiling it in the background if needed.
+		// With a shader pack only variants in the pack are available.
 		// Returns true if any shader is actually updated.
 		static bool UpdateDirtyShaders();
 
@@ -13,6 +13,8 @@ namespace Zenith {
 		int MaxSamples = 0;
 		float MaxAnisotropy = 0.0f;
 		int MaxTextureUnits = 0;
+
+		bool SupportsBlockCompression = false; // BC1-BC7 textures can be sampled
 	};
 
 }
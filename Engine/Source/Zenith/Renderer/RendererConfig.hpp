@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Zenith/Renderer/VertexCompression.hpp"
+
 #include <string>
 
 namespace Zenith {
@@ -7,6 +9,35 @@ namespace Zenith {
 	struct RendererConfig
 	{
 		uint32_t FramesInFlight = 3;
+
+		// Cull submeshes per meshlet (frustum + normal cone) on the CPU before drawing
+		bool MeshletCulling = true;
+		// Also drop meshlets whose normal cone faces away from the camera. Off because MeshRenderer draws without
+		// backface culling, so double-sided geometry would lose its back faces.
+		bool MeshletConeCulling = false;
+
+		// MeshRenderer copies meshes into shared buffers and draws them with one indirect draw per pipeline
+		bool IndirectMeshDrawing = true;
+
+		// GPU vertex encoding used when importing meshes
+		VertexFormat MeshVertexFormat = VertexFormat::Standard;
+
+		// Load cooked textures with their small mips only and stream in the ones draws need
+		bool TextureStreaming = true;
+		// Largest mip loaded with a texture, before anything is streamed
+		uint32_t TextureStreamingInitialSize = 128;
+		// Streamed textures are evicted down to this, or less when the device is short on VRAM
+		uint32_t TextureStreamingBudgetMB = 1024;
+
+		// Material textures go into one global descriptor array and parameters into one storage buffer,
+		// draws only push their material index. Falls back to per-material sets without descriptor indexing.
+		bool BindlessMaterials = true;
+
+		// Initial size of the per-frame buffer for transient draw data, it grows when a frame needs more
+		uint32_t TransientBufferSizeMB = 4;
+
+		// Loaded instead of compiling shaders when ZN_USE_SHADER_PACK is set
+		std::string ShaderPackPath = "Shaders.zsp";
 	};
 
 }
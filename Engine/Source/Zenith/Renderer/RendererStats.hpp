@@ -6,7 +6,8 @@ namespace Zenith {
 
 		struct ResourceAllocationCounts
 		{
-			uint32_t Samplers = 0;
+			uint32_t Samplers = 0;          // unique VkSamplers
+			uint32_t SamplerReferences = 0; // handles given out by Vulkan::CreateSampler()
 		};
 
 		ResourceAllocationCounts& GetResourceAllocationCounts();
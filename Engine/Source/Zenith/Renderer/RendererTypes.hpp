@@ -6,4 +6,16 @@ namespace Zenith {
 
 	using RendererID = uint32_t;
 
+	// Binary compatible with VkDrawIndexedIndirectCommand
+	struct DrawIndexedIndirectCommand
+	{
+		uint32_t IndexCount = 0;
+		uint32_t InstanceCount = 0;
+		uint32_t FirstIndex = 0;
+		int32_t VertexOffset = 0;
+		uint32_t FirstInstance = 0;
+	};
+
+	static_assert(sizeof(DrawIndexedIndirectCommand) == 20);
+
 }
@@ -1,12 +1,17 @@
 #include "znpch.hpp"
 #include "Shader.hpp"
 
+#include <format>
 #include <utility>
 
+#include "Zenith/Core/Hash.hpp"
+
 #include "Zenith/Renderer/Renderer.hpp"
 #include "Zenith/Renderer/API/Vulkan/VulkanShader.hpp"
 
-#if ZN_HAS_SHADER_COMPILER
+#if ZN_USE_SHADER_PACK
+#include "Zenith/Renderer/API/Vulkan/ShaderPack/VulkanShaderPack.hpp"
+#elif ZN_HAS_SHADER_COMPILER
 #include "Zenith/Renderer/API/Vulkan/ShaderCompiler/VulkanShaderCompiler.hpp"
 #endif
 
@@ -22,7 +27,11 @@ namespace Zenith {
 		{
 			case RendererAPIType::None: return nullptr;
 			case RendererAPIType::Vulkan:
+#if ZN_USE_SHADER_PACK
+				result = VulkanShader::CreateFromPack(Renderer::GetShaderPack(), filepath);
+#else
 				result = Ref<VulkanShader>::Create(filepath, forceCompile, disableOptimization);
+#endif
 				break;
 		}
 		return result;
@@ -39,6 +48,17 @@ namespace Zenith {
 		return result;
 	}
 
+	uint64_t Shader::GetVariantKey(const ShaderMacros& macros)
+	{
+		if (macros.empty())
+			return 0;
+
+		XXHash64 hash;
+		for (const auto& [name, value] : macros)
+			hash.update(std::format("{}={}\n", name, value));
+		return hash.finalize();
+	}
+
 	ShaderLibrary::ShaderLibrary()
 	{
 	}
@@ -61,7 +81,9 @@ namespace Zenith {
 		{
 			// Try compile from source
 			// Unavailable at runtime
-#if ZN_HAS_SHADER_COMPILER
+#if ZN_USE_SHADER_PACK
+			shader = VulkanShader::CreateFromPack(Renderer::GetShaderPack(), path);
+#elif ZN_HAS_SHADER_COMPILER
 			shader = VulkanShaderCompiler::Compile(path, forceCompile, disableOptimization);
 #endif
 		}
@@ -77,6 +99,30 @@ namespace Zenith {
 		m_Shaders[std::string(name)] = Shader::Create(path);
 	}
 
+	void ShaderLibrary::LoadAll(const std::vector<std::string>& paths, bool forceCompile, bool disableOptimization)
+	{
+#if ZN_USE_SHADER_PACK
+		for (const std::string& path : paths)
+		{
+			Ref<VulkanShader> shader = VulkanShader::CreateFromPack(Renderer::GetShaderPack(), path);
+			if (!shader)
+				continue;
+
+			auto& name = shader->GetName();
+			ZN_CORE_ASSERT(m_Shaders.find(name) == m_Shaders.end());
+			m_Shaders[name] = shader;
+		}
+#elif ZN_HAS_SHADER_COMPILER
+		std::vector<std::filesystem::path> shaderSourcePaths(paths.begin(), paths.end());
+		for (Ref<VulkanShader> shader : VulkanShaderCompiler::CompileAll(shaderSourcePaths, forceCompile, disableOptimization))
+		{
+			auto& name = shader->GetName();
+			ZN_CORE_ASSERT(m_Shaders.find(name) == m_Shaders.end());
+			m_Shaders[name] = shader;
+		}
+#endif
+	}
+
 	const Ref<Shader>& ShaderLibrary::Get(const std::string& name) const
 	{
 		ZN_CORE_ASSERT(m_Shaders.find(name) != m_Shaders.end());
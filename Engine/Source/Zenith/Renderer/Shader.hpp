@@ -7,11 +7,19 @@
 #include "Zenith/Renderer/ShaderUniform.hpp"
 
 #include <filesystem>
+#include <map>
 #include <string>
 #include <glm/glm.hpp>
 
 #define ZN_HAS_SHADER_COMPILER !ZN_DIST
 
+// Shaders are loaded from a pack built ahead of time (see Zenith-ShaderPacker), never compiled at runtime
+#if defined(ZN_SHADER_PACK) || !ZN_HAS_SHADER_COMPILER
+#define ZN_USE_SHADER_PACK 1
+#else
+#define ZN_USE_SHADER_PACK 0
+#endif
+
 #include "Zenith/Core/Ref.hpp"
 
 namespace Zenith
@@ -23,6 +31,9 @@ namespace Zenith
 		};
 	}
 
+	// Macro name -> value, sorted so equal sets of macros select the same variant
+	using ShaderMacros = std::map<std::string, std::string>;
+
 	enum class ShaderUniformType
 	{
 		None = 0, Bool, Int, UInt, Float, Vec2, Vec3, Vec4, Mat3, Mat4,
@@ -117,8 +128,12 @@ namespace Zenith
 
 		virtual const std::string& GetName() const = 0;
 
+		// Selects the variant compiled with this macro, see Renderer::SetMacroInShader
 		virtual void SetMacro(const std::string& name, const std::string& value) = 0;
 
+		// Identifies a variant of a shader, 0 for no macros
+		static uint64_t GetVariantKey(const ShaderMacros& macros);
+
 		static Ref<Shader> Create(const std::string& filepath, bool forceCompile = false, bool disableOptimization = false);
 		static Ref<Shader> CreateFromString(const std::string& source);
 
@@ -143,6 +158,8 @@ namespace Zenith
 		void Add(const Ref<Shader>& shader);
 		void Load(std::string_view path, bool forceCompile = false, bool disableOptimization = false);
 		void Load(std::string_view name, const std::string& path);
+		// Compiles the shaders in parallel, they are added in the given order
+		void LoadAll(const std::vector<std::string>& paths, bool forceCompile = false, bool disableOptimization = false);
 
 		const Ref<Shader>& Get(const std::string& name) const;
 		size_t GetSize() const { return m_Shaders.size(); }
@@ -18,6 +18,8 @@ namespace Zenith {
 		TextureFilter SamplerFilter = TextureFilter::Linear;
 		
 		bool GenerateMips = true;
+		uint32_t Mips = 0; // Mips contained in the data the texture is created from (largest first, tightly packed). 0 = mip 0 only
+		uint32_t ResidentMip = 0; // First of the Mips in the data and in GPU memory, the larger ones are streamed in later (see TextureStreamer)
 		bool Storage = false;
 		bool StoreLocally = false;
 
@@ -69,6 +71,10 @@ namespace Zenith {
 
 		virtual Buffer GetWriteableBuffer() = 0;
 
+		virtual uint32_t GetResidentMip() const = 0;
+		// Recreates the GPU image from mip on the render thread. data holds mip to the smallest mip, tightly packed, and is copied.
+		virtual void SetResidentMip(uint32_t mip, Buffer data) = 0;
+
 		virtual bool Loaded() const = 0;
 
 		virtual const std::filesystem::path& GetPath() const = 0;
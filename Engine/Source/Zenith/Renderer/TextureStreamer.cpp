@@ -0,0 +1,340 @@
+#include "znpch.hpp"
+#include "TextureStreamer.hpp"
+
+#include "Renderer.hpp"
+
+#include "Zenith/Asset/KTX2.hpp"
+#include "Zenith/Core/Thread.hpp"
+#include "Zenith/Debug/Profiler.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+
+namespace Zenith {
+
+	namespace Utils {
+
+		static constexpr uint32_t NoMip = UINT32_MAX;
+
+		// Frames a texture keeps its requested mips after it was last drawn
+		static constexpr uint64_t EvictionDelay = 120;
+
+		// Mip loads in flight, so a camera cut doesn't upload everything at once
+		static constexpr uint32_t MaxPendingLoads = 4;
+
+		// Share of the device-local heaps left to everything that isn't streamed
+		static constexpr double DeviceLocalHeadroom = 0.1;
+
+	}
+
+	struct TextureLoadRequest
+	{
+		AssetHandle Handle;
+		std::filesystem::path FilePath;
+		uint32_t Mip = 0;
+	};
+
+	struct TextureLoadResult
+	{
+		AssetHandle Handle;
+		uint32_t Mip = 0;
+		Buffer Data; // empty if the file could not be read
+	};
+
+	struct TextureStreamerData
+	{
+		std::unordered_map<AssetHandle, StreamedTexture> Textures;
+		std::mutex TexturesMutex; // textures are registered by the asset workers
+
+		std::queue<TextureLoadRequest> LoadQueue;
+		std::vector<TextureLoadResult> FinishedLoads;
+		std::mutex LoadMutex;
+		std::condition_variable LoadCV;
+		bool Running = true;
+		Thread LoadThread = Thread("Texture Streaming");
+
+		uint64_t FrameIndex = 0;
+		uint64_t Budget = 0;
+		uint64_t ResidentSize = 0;
+
+		// Written on the render thread, which owns the allocator
+		std::atomic<uint64_t> DeviceLocalUsage = 0;
+		std::atomic<uint64_t> DeviceLocalBudget = 0;
+	};
+
+	static TextureStreamerData* s_Data = nullptr;
+
+	static void LoadThreadFunc()
+	{
+		ZN_PROFILE_THREAD("Texture Streaming");
+
+		while (true)
+		{
+			TextureLoadRequest request;
+			{
+				std::unique_lock lock(s_Data->LoadMutex);
+				s_Data->LoadCV.wait(lock, [] { return !s_Data->Running || !s_Data->LoadQueue.empty(); });
+				if (!s_Data->Running)
+					return;
+
+				request = std::move(s_Data->LoadQueue.front());
+				s_Data->LoadQueue.pop();
+			}
+
+			CookedTexture mips = KTX2::ReadMips(request.FilePath, request.Mip);
+
+			std::scoped_lock lock(s_Data->LoadMutex);
+			s_Data->FinishedLoads.push_back({ request.Handle, request.Mip, mips.Data });
+		}
+	}
+
+	void TextureStreamer::Init()
+	{
+		s_Data = znew TextureStreamerData();
+		s_Data->LoadThread.Dispatch(LoadThreadFunc);
+	}
+
+	void TextureStreamer::Shutdown()
+	{
+		if (!s_Data)
+			return;
+
+		{
+			std::scoped_lock lock(s_Data->LoadMutex);
+			s_Data->Running = false;
+		}
+		s_Data->LoadCV.notify_all();
+		s_Data->LoadThread.Join();
+
+		for (TextureLoadResult& result : s_Data->FinishedLoads)
+			result.Data.Release();
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void TextureStreamer::Register(Ref<Texture2D> texture, const std::filesystem::path& filepath)
+	{
+		if (!s_Data || !texture || texture->GetMipLevelCount() <= 1)
+			return;
+
+		ZN_CORE_VERIFY(texture->Handle, "Streamed textures need an asset handle");
+
+		StreamedTexture entry;
+		entry.Texture = texture;
+		entry.FilePath = filepath;
+		entry.Format = texture->GetFormat();
+		entry.Width = texture->GetWidth();
+		entry.Height = texture->GetHeight();
+		entry.MipCount = texture->GetMipLevelCount();
+		entry.InitialMip = entry.ResidentMip = entry.WantedMip = entry.TargetMip = texture->GetResidentMip();
+
+		std::scoped_lock lock(s_Data->TexturesMutex);
+		s_Data->Textures[texture->Handle] = std::move(entry);
+	}
+
+	void TextureStreamer::RequestMip(const Ref<Texture2D>& texture, uint32_t mip)
+	{
+		if (!s_Data || !texture)
+			return;
+
+		std::scoped_lock lock(s_Data->TexturesMutex);
+		auto it = s_Data->Textures.find(texture->Handle);
+		if (it != s_Data->Textures.end())
+			it->second.RequestedMip = std::min(it->second.RequestedMip, mip);
+	}
+
+	uint32_t TextureStreamer::CalculateRequiredMip(uint32_t textureSize, float uvDensity, float pixelsPerUnit)
+	{
+		if (pixelsPerUnit <= 0.0f || uvDensity <= 0.0f)
+			return Utils::NoMip;
+
+		// Texels covered by one pixel, every mip halves it
+		const float texelsPerPixel = float(textureSize) * uvDensity / pixelsPerUnit;
+		return texelsPerPixel > 1.0f ? uint32_t(std::log2(texelsPerPixel)) : 0;
+	}
+
+	void TextureStreamer::Update()
+	{
+		ZN_PROFILE_FUNC();
+
+		if (!s_Data)
+			return;
+
+		Renderer::Submit([]()
+		{
+			if (!s_Data)
+				return;
+
+			const GPUMemoryStats stats = Renderer::GetGPUMemoryStats();
+			s_Data->DeviceLocalUsage = stats.DeviceLocalUsage;
+			s_Data->DeviceLocalBudget = stats.DeviceLocalBudget;
+		});
+
+		std::vector<TextureLoadResult> finishedLoads;
+		{
+			std::scoped_lock lock(s_Data->LoadMutex);
+			std::swap(finishedLoads, s_Data->FinishedLoads);
+		}
+
+		std::scoped_lock lock(s_Data->TexturesMutex);
+		auto& textures = s_Data->Textures;
+
+		for (TextureLoadResult& result : finishedLoads)
+		{
+			auto it = textures.find(result.Handle);
+			if (it != textures.end() && it->second.PendingMip == result.Mip && it->second.Texture.IsValid())
+			{
+				StreamedTexture& entry = it->second;
+				entry.PendingMip = Utils::NoMip;
+				if (result.Data)
+				{
+					entry.Texture->SetResidentMip(result.Mip, result.Data);
+					entry.ResidentMip = result.Mip;
+				}
+				else
+				{
+					ZN_CORE_WARN_TAG("TextureStreamer", "Failed to stream mip {} of {}, it is not streamed anymore", result.Mip, entry.FilePath.string());
+					entry.Failed = true;
+				}
+			}
+			result.Data.Release();
+		}
+
+		std::erase_if(textures, [](const auto& pair) { return !pair.second.Texture.IsValid(); });
+
+		const uint64_t frameIndex = ++s_Data->FrameIndex;
+		uint64_t residentSize = 0;
+		for (auto& [handle, entry] : textures)
+		{
+			if (entry.RequestedMip != Utils::NoMip)
+			{
+				entry.WantedMip = entry.RequestedMip;
+				entry.LastUsedFrame = frameIndex;
+				entry.RequestedMip = Utils::NoMip;
+			}
+			else if (frameIndex - entry.LastUsedFrame > Utils::EvictionDelay)
+			{
+				entry.WantedMip = entry.InitialMip;
+			}
+
+			entry.TargetMip = entry.Failed ? entry.ResidentMip : std::min(entry.WantedMip, entry.InitialMip);
+			residentSize += entry.GetSize(entry.ResidentMip);
+		}
+
+		// Our share of the device-local heaps is whatever the rest of the engine (and other processes) leave us
+		uint64_t budget = uint64_t(Renderer::GetConfig().TextureStreamingBudgetMB) * 1024 * 1024;
+		const uint64_t deviceLocalBudget = s_Data->DeviceLocalBudget;
+		if (deviceLocalBudget > 0)
+		{
+			const uint64_t deviceLocalUsage = s_Data->DeviceLocalUsage;
+			const uint64_t otherUsage = deviceLocalUsage - std::min(deviceLocalUsage, residentSize);
+			const uint64_t available = uint64_t(double(deviceLocalBudget) * (1.0 - Utils::DeviceLocalHeadroom));
+			budget = std::min(budget, available > otherUsage ? available - otherUsage : 0);
+		}
+		s_Data->Budget = budget;
+		s_Data->ResidentSize = residentSize;
+
+		std::vector<StreamedTexture*> streamed;
+		streamed.reserve(textures.size());
+		for (auto& [handle, entry] : textures)
+			streamed.push_back(&entry);
+		FitToBudget(streamed, budget);
+
+		// Evictions only read the mips that stay, and free memory for the loads, so they are never held back
+		std::vector<std::pair<AssetHandle, StreamedTexture*>> loads;
+		uint32_t pendingLoads = 0;
+		std::vector<TextureLoadRequest> requests;
+		for (auto& [handle, entry] : textures)
+		{
+			if (entry.PendingMip != Utils::NoMip)
+				pendingLoads++;
+			else if (entry.TargetMip > entry.ResidentMip)
+				requests.push_back({ handle, entry.FilePath, entry.TargetMip });
+			else if (entry.TargetMip < entry.ResidentMip)
+				loads.emplace_back(handle, &entry);
+		}
+
+		// Most recently drawn first, then the ones missing the most detail
+		std::sort(loads.begin(), loads.end(), [](const auto& left, const auto& right)
+		{
+			const StreamedTexture* a = left.second;
+			const StreamedTexture* b = right.second;
+			if (a->LastUsedFrame != b->LastUsedFrame)
+				return a->LastUsedFrame > b->LastUsedFrame;
+			return a->ResidentMip - a->TargetMip > b->ResidentMip - b->TargetMip;
+		});
+
+		for (auto& [handle, entry] : loads)
+		{
+			if (pendingLoads >= Utils::MaxPendingLoads)
+				break;
+
+			requests.push_back({ handle, entry->FilePath, entry->TargetMip });
+			pendingLoads++;
+		}
+
+		if (requests.empty())
+			return;
+
+		{
+			std::scoped_lock loadLock(s_Data->LoadMutex);
+			for (TextureLoadRequest& request : requests)
+			{
+				textures[request.Handle].PendingMip = request.Mip;
+				s_Data->LoadQueue.push(std::move(request));
+			}
+		}
+		s_Data->LoadCV.notify_one();
+	}
+
+	uint64_t TextureStreamer::FitToBudget(const std::vector<StreamedTexture*>& textures, uint64_t budget)
+	{
+		uint64_t targetSize = 0;
+		for (const StreamedTexture* entry : textures)
+			targetSize += entry->GetSize(entry->TargetMip);
+
+		if (targetSize <= budget)
+			return targetSize;
+
+		// Drop the largest mip of the least recently drawn texture, one mip at a time
+		auto compare = [](const StreamedTexture* a, const StreamedTexture* b)
+		{
+			if (a->LastUsedFrame != b->LastUsedFrame)
+				return a->LastUsedFrame > b->LastUsedFrame;
+			return a->GetLevelSize(a->TargetMip) < b->GetLevelSize(b->TargetMip);
+		};
+
+		std::priority_queue<StreamedTexture*, std::vector<StreamedTexture*>, decltype(compare)> evictable(compare);
+		for (StreamedTexture* entry : textures)
+		{
+			if (entry->TargetMip < entry->InitialMip)
+				evictable.push(entry);
+		}
+
+		while (targetSize > budget && !evictable.empty())
+		{
+			StreamedTexture* entry = evictable.top();
+			evictable.pop();
+
+			targetSize -= entry->GetLevelSize(entry->TargetMip);
+			entry->TargetMip++;
+			if (entry->TargetMip < entry->InitialMip)
+				evictable.push(entry);
+		}
+
+		return targetSize;
+	}
+
+	uint64_t TextureStreamer::GetBudget()
+	{
+		return s_Data ? s_Data->Budget : 0;
+	}
+
+	uint64_t TextureStreamer::GetResidentSize()
+	{
+		return s_Data ? s_Data->ResidentSize : 0;
+	}
+
+}
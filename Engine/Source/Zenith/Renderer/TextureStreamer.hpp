@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Zenith/Renderer/Texture.hpp"
+
+#include <filesystem>
+#include <vector>
+
+namespace Zenith {
+
+	// A registered texture. Mip 0 is the most detailed, a texture holds every mip from ResidentMip down.
+	struct StreamedTexture
+	{
+		WeakRef<Texture2D> Texture;
+		std::filesystem::path FilePath;
+		ImageFormat Format = ImageFormat::None;
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		uint32_t MipCount = 0;
+
+		uint32_t InitialMip = 0;  // loaded with the texture and never evicted
+		uint32_t ResidentMip = 0;
+		uint32_t PendingMip = UINT32_MAX;
+		uint32_t RequestedMip = UINT32_MAX; // this frame
+		uint32_t WantedMip = 0;
+		uint32_t TargetMip = 0;
+		uint64_t LastUsedFrame = 0;
+		bool Failed = false;
+
+		uint64_t GetLevelSize(uint32_t mip) const
+		{
+			return Utils::GetImageMemorySize(Format, std::max(Width >> mip, 1u), std::max(Height >> mip, 1u));
+		}
+
+		uint64_t GetSize(uint32_t firstMip) const
+		{
+			uint64_t size = 0;
+			for (uint32_t mip = firstMip; mip < MipCount; mip++)
+				size += GetLevelSize(mip);
+			return size;
+		}
+	};
+
+	// Keeps only the mips of cooked textures that draws need in GPU memory.
+	// Textures are loaded with their small mips, larger ones are read from the texture's KTX2 file on a worker thread,
+	// and the least recently drawn textures lose theirs again when over budget.
+	class TextureStreamer
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		// filepath is the KTX2 file holding all mips of the texture. Textures are tracked by asset handle,
+		// registering another texture with the same handle (a reload) replaces the previous one.
+		static void Register(Ref<Texture2D> texture, const std::filesystem::path& filepath);
+
+		// Per draw: the texture is sampled at this mip. The most detailed request of a frame wins.
+		static void RequestMip(const Ref<Texture2D>& texture, uint32_t mip);
+
+		// Mip sampled when one local unit of a surface spans uvDensity in texture coordinates and pixelsPerUnit pixels on screen.
+		// UINT32_MAX when either is 0, nothing is requested then.
+		static uint32_t CalculateRequiredMip(uint32_t textureSize, float uvDensity, float pixelsPerUnit);
+
+		// Once per frame on the main thread: applies finished loads, evicts down to the budget and queues new loads
+		static void Update();
+
+		// Raises the TargetMip of the least recently drawn textures, largest mip first, until all targets fit in budget.
+		// Never past a texture's InitialMip. Returns the size of the targets.
+		static uint64_t FitToBudget(const std::vector<StreamedTexture*>& textures, uint64_t budget);
+
+		static uint64_t GetBudget();
+		static uint64_t GetResidentSize();
+	};
+
+}
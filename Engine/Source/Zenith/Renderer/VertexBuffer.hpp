@@ -9,7 +9,8 @@ namespace Zenith {
 
 	enum class ShaderDataType
 	{
-		None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool
+		None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool,
+		Half2, Short2, UShort4 // Packed types, use VertexBufferElement::Normalized for [-1, 1] / [0, 1] fetches
 	};
 
 	static uint32_t ShaderDataTypeSize(ShaderDataType type)
@@ -27,6 +28,9 @@ namespace Zenith {
 			case ShaderDataType::Int3:     return 4 * 3;
 			case ShaderDataType::Int4:     return 4 * 4;
 			case ShaderDataType::Bool:     return 1;
+			case ShaderDataType::Half2:    return 2 * 2;
+			case ShaderDataType::Short2:   return 2 * 2;
+			case ShaderDataType::UShort4:  return 2 * 4;
 		}
 
 		ZN_CORE_ASSERT(false, "Unknown ShaderDataType!");
@@ -63,6 +67,9 @@ namespace Zenith {
 				case ShaderDataType::Int3:    return 3;
 				case ShaderDataType::Int4:    return 4;
 				case ShaderDataType::Bool:    return 1;
+				case ShaderDataType::Half2:   return 2;
+				case ShaderDataType::Short2:  return 2;
+				case ShaderDataType::UShort4: return 4;
 			}
 
 			ZN_CORE_ASSERT(false, "Unknown ShaderDataType!");
@@ -81,6 +88,15 @@ namespace Zenith {
 			CalculateOffsetsAndStride();
 		}
 
+		// For vertices with trailing data the shader doesn't read
+		VertexBufferLayout(const std::initializer_list<VertexBufferElement>& elements, uint32_t stride)
+			: m_Elements(elements)
+		{
+			CalculateOffsetsAndStride();
+			ZN_CORE_ASSERT(stride >= m_Stride);
+			m_Stride = stride;
+		}
+
 		uint32_t GetStride() const { return m_Stride; }
 		const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
 		uint32_t GetElementCount() const { return (uint32_t)m_Elements.size(); }
@@ -0,0 +1,124 @@
+#include "znpch.hpp"
+#include "VertexCompression.hpp"
+
+#include <glm/gtc/packing.hpp>
+
+namespace Zenith::VertexCompression {
+
+	namespace Utils {
+
+		static glm::vec2 SignNotZero(const glm::vec2& v)
+		{
+			return { v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f };
+		}
+
+		template<typename TVertex>
+		static void PackAttributes(TVertex& vertex, const glm::vec3& normal, const glm::vec3& tangent, const glm::vec3& bitangent, const glm::vec2& texcoord)
+		{
+			vertex.Normal = glm::packSnorm2x16(EncodeOctahedral(normal));
+			vertex.Tangent = glm::packSnorm2x16(EncodeTangent(tangent, GetBitangentSign(normal, tangent, bitangent)));
+			vertex.Texcoord = glm::packHalf2x16(texcoord);
+		}
+
+	}
+
+	uint32_t GetPackedStride(VertexFormat format)
+	{
+		switch (format)
+		{
+			case VertexFormat::Standard:         return 0;
+			case VertexFormat::Compact:          return sizeof(CompactVertex);
+			case VertexFormat::CompactQuantized: return sizeof(QuantizedVertex);
+		}
+		return 0;
+	}
+
+	glm::vec2 EncodeOctahedral(const glm::vec3& direction)
+	{
+		float l1 = glm::abs(direction.x) + glm::abs(direction.y) + glm::abs(direction.z);
+		if (l1 <= 0.0f)
+			return { 0.0f, 0.0f }; // Decodes to +Z
+
+		glm::vec3 n = direction / l1;
+		glm::vec2 encoded(n.x, n.y);
+		if (n.z < 0.0f)
+			encoded = (1.0f - glm::abs(glm::vec2(encoded.y, encoded.x))) * Utils::SignNotZero(encoded);
+
+		return encoded;
+	}
+
+	glm::vec3 DecodeOctahedral(const glm::vec2& encoded)
+	{
+		glm::vec3 n(encoded.x, encoded.y, 1.0f - glm::abs(encoded.x) - glm::abs(encoded.y));
+		float t = glm::max(-n.z, 0.0f);
+		n.x += n.x >= 0.0f ? -t : t;
+		n.y += n.y >= 0.0f ? -t : t;
+		return glm::normalize(n);
+	}
+
+	glm::vec2 EncodeTangent(const glm::vec3& tangent, float bitangentSign)
+	{
+		glm::vec2 encoded = EncodeOctahedral(tangent);
+		float magnitude = 0.5f + (encoded.y + 1.0f) * 0.25f;
+		encoded.y = bitangentSign < 0.0f ? -magnitude : magnitude;
+		return encoded;
+	}
+
+	glm::vec4 DecodeTangent(const glm::vec2& encoded)
+	{
+		float sign = encoded.y >= 0.0f ? 1.0f : -1.0f;
+		glm::vec2 octahedral(encoded.x, (glm::abs(encoded.y) - 0.5f) * 4.0f - 1.0f);
+		return glm::vec4(DecodeOctahedral(glm::clamp(octahedral, -1.0f, 1.0f)), sign);
+	}
+
+	float GetBitangentSign(const glm::vec3& normal, const glm::vec3& tangent, const glm::vec3& bitangent)
+	{
+		return glm::dot(glm::cross(normal, tangent), bitangent) < 0.0f ? -1.0f : 1.0f;
+	}
+
+	CompactVertex PackCompact(const glm::vec3& position, const glm::vec3& normal, const glm::vec3& tangent,
+		const glm::vec3& bitangent, const glm::vec2& texcoord)
+	{
+		CompactVertex vertex;
+		vertex.Position = position;
+		Utils::PackAttributes(vertex, normal, tangent, bitangent, texcoord);
+		return vertex;
+	}
+
+	QuantizedVertex PackQuantized(const glm::vec3& position, const glm::vec3& normal, const glm::vec3& tangent,
+		const glm::vec3& bitangent, const glm::vec2& texcoord, const glm::vec3& offset, const glm::vec3& scale)
+	{
+		QuantizedVertex vertex;
+
+		for (int i = 0; i < 3; i++)
+		{
+			float normalized = scale[i] > 0.0f ? (position[i] - offset[i]) / scale[i] : 0.0f;
+			vertex.Position[i] = static_cast<uint16_t>(glm::round(glm::clamp(normalized, 0.0f, 1.0f) * 65535.0f));
+		}
+		vertex.Position[3] = 0;
+		Utils::PackAttributes(vertex, normal, tangent, bitangent, texcoord);
+		return vertex;
+	}
+
+	glm::vec3 UnpackNormal(uint32_t packed)
+	{
+		return DecodeOctahedral(glm::unpackSnorm2x16(packed));
+	}
+
+	glm::vec4 UnpackTangent(uint32_t packed)
+	{
+		return DecodeTangent(glm::unpackSnorm2x16(packed));
+	}
+
+	glm::vec2 UnpackTexcoord(uint32_t packed)
+	{
+		return glm::unpackHalf2x16(packed);
+	}
+
+	glm::vec3 UnpackPosition(const QuantizedVertex& vertex, const glm::vec3& offset, const glm::vec3& scale)
+	{
+		glm::vec3 normalized(vertex.Position[0], vertex.Position[1], vertex.Position[2]);
+		return offset + normalized / 65535.0f * scale;
+	}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace Zenith {
+
+	// GPU-side vertex encoding of a MeshSource. The CPU copy (MeshSource::GetVertices) always stays full precision.
+	enum class VertexFormat : uint8_t
+	{
+		Standard = 0,     // Vertex as-is, 56 bytes
+		Compact,          // float3 position, octahedral normal/tangent, half texcoord - 24 bytes
+		CompactQuantized  // Compact with UNORM16 positions relative to the submesh bounds - 20 bytes
+	};
+
+	struct CompactVertex
+	{
+		glm::vec3 Position;
+		uint32_t Normal;   // Octahedral, 2x SNORM16
+		uint32_t Tangent;  // Octahedral with the bitangent sign folded into y, 2x SNORM16
+		uint32_t Texcoord; // 2x half
+	};
+
+	struct QuantizedVertex
+	{
+		uint16_t Position[4]; // UNORM16 within Submesh::QuantizationOffset/Scale, w unused
+		uint32_t Normal;
+		uint32_t Tangent;
+		uint32_t Texcoord;
+	};
+
+	static_assert(sizeof(CompactVertex) == 24);
+	static_assert(sizeof(QuantizedVertex) == 20);
+
+	namespace VertexCompression {
+
+		// Returns 0 for VertexFormat::Standard, callers use sizeof(Vertex)
+		uint32_t GetPackedStride(VertexFormat format);
+
+		glm::vec2 EncodeOctahedral(const glm::vec3& direction);
+		glm::vec3 DecodeOctahedral(const glm::vec2& encoded);
+
+		// Tangent and bitangent sign share one octahedral pair: |y| in [0.5, 1] carries the direction, sign(y) the handedness
+		glm::vec2 EncodeTangent(const glm::vec3& tangent, float bitangentSign);
+		glm::vec4 DecodeTangent(const glm::vec2& encoded); // xyz = tangent, w = bitangent sign
+
+		float GetBitangentSign(const glm::vec3& normal, const glm::vec3& tangent, const glm::vec3& bitangent);
+
+		CompactVertex PackCompact(const glm::vec3& position, const glm::vec3& normal, const glm::vec3& tangent,
+			const glm::vec3& bitangent, const glm::vec2& texcoord);
+
+		// Position is stored as (position - offset) / scale, scale components of 0 are allowed (flat bounds)
+		QuantizedVertex PackQuantized(const glm::vec3& position, const glm::vec3& normal, const glm::vec3& tangent,
+			const glm::vec3& bitangent, const glm::vec2& texcoord, const glm::vec3& offset, const glm::vec3& scale);
+
+		glm::vec3 UnpackNormal(uint32_t packed);
+		glm::vec4 UnpackTangent(uint32_t packed);
+		glm::vec2 UnpackTexcoord(uint32_t packed);
+		glm::vec3 UnpackPosition(const QuantizedVertex& vertex, const glm::vec3& offset, const glm::vec3& scale);
+
+	}
+
+}
@@ -22,6 +22,7 @@ namespace Zenith
 			return false;
 
 		m_Buffer.Write(data, (uint32_t)size, (uint32_t)m_WritePos);
+		m_WritePos += size;
 		return true;
 	}
 
@@ -42,6 +43,7 @@ namespace Zenith
 			return false;
 
 		memcpy(destination, (char*)m_Buffer.Data + m_ReadPos, size);
+		m_ReadPos += size;
 		return true;
 	}
 
@@ -0,0 +1,190 @@
+#include "znpch.hpp"
+#include "Compression.hpp"
+
+#include <vector>
+
+namespace Zenith::Compression {
+
+	namespace Utils {
+
+		static constexpr uint32_t MinMatch = 4;
+		static constexpr uint32_t MaxOffset = 65535;
+		static constexpr uint32_t HashBits = 16;
+		static constexpr uint64_t LastLiterals = 5;  // The format requires the final bytes to be literals
+		static constexpr uint64_t MatchSearchEnd = 12;
+
+		static uint32_t Load32(const uint8_t* data)
+		{
+			uint32_t value;
+			memcpy(&value, data, sizeof(uint32_t));
+			return value;
+		}
+
+		static uint32_t HashSequence(uint32_t sequence)
+		{
+			return (sequence * 2654435761u) >> (32 - HashBits);
+		}
+
+		static void WriteLength(std::vector<uint8_t>& out, uint64_t length)
+		{
+			for (; length >= 255; length -= 255)
+				out.push_back(255);
+			out.push_back(static_cast<uint8_t>(length));
+		}
+
+		static void WriteSequence(std::vector<uint8_t>& out, const uint8_t* literals, uint64_t literalLength, uint32_t offset, uint64_t matchLength)
+		{
+			const bool hasMatch = matchLength >= MinMatch;
+			const uint64_t matchCode = hasMatch ? matchLength - MinMatch : 0;
+
+			out.push_back(static_cast<uint8_t>((std::min<uint64_t>(literalLength, 15) << 4) | std::min<uint64_t>(matchCode, 15)));
+			if (literalLength >= 15)
+				WriteLength(out, literalLength - 15);
+
+			out.insert(out.end(), literals, literals + literalLength);
+
+			if (!hasMatch)
+				return;
+
+			out.push_back(static_cast<uint8_t>(offset & 0xff));
+			out.push_back(static_cast<uint8_t>(offset >> 8));
+			if (matchCode >= 15)
+				WriteLength(out, matchCode - 15);
+		}
+
+		static bool ReadLength(const uint8_t*& src, const uint8_t* srcEnd, uint64_t& length)
+		{
+			uint8_t value;
+			do
+			{
+				if (src >= srcEnd)
+					return false;
+				value = *src++;
+				length += value;
+			} while (value == 255);
+			return true;
+		}
+
+	}
+
+	uint64_t GetCompressBound(uint64_t size)
+	{
+		return size + size / 255 + 16;
+	}
+
+	Buffer CompressLZ(const void* data, uint64_t size)
+	{
+		ZN_PROFILE_FUNC();
+
+		// Positions are tracked as 32-bit, larger blobs are stored as-is
+		if (size == 0 || size > 0xffffffffull)
+			return {};
+
+		const uint8_t* in = static_cast<const uint8_t*>(data);
+
+		std::vector<uint8_t> out;
+		out.reserve(GetCompressBound(size));
+
+		std::vector<uint32_t> table(1u << Utils::HashBits, 0xffffffff);
+
+		uint64_t anchor = 0;
+		uint64_t position = 0;
+		if (size > Utils::MatchSearchEnd)
+		{
+			const uint64_t searchEnd = size - Utils::MatchSearchEnd;
+			const uint64_t matchEnd = size - Utils::LastLiterals;
+
+			while (position < searchEnd)
+			{
+				const uint32_t sequence = Utils::Load32(in + position);
+				const uint32_t hash = Utils::HashSequence(sequence);
+				uint64_t candidate = table[hash];
+				table[hash] = static_cast<uint32_t>(position);
+
+				if (candidate == 0xffffffff || position - candidate > Utils::MaxOffset || Utils::Load32(in + candidate) != sequence)
+				{
+					position++;
+					continue;
+				}
+
+				while (position > anchor && candidate > 0 && in[position - 1] == in[candidate - 1])
+				{
+					position--;
+					candidate--;
+				}
+
+				uint64_t matchLength = Utils::MinMatch;
+				while (position + matchLength < matchEnd && in[position + matchLength] == in[candidate + matchLength])
+					matchLength++;
+
+				Utils::WriteSequence(out, in + anchor, position - anchor, static_cast<uint32_t>(position - candidate), matchLength);
+
+				position += matchLength;
+				anchor = position;
+			}
+		}
+
+		Utils::WriteSequence(out, in + anchor, size - anchor, 0, 0);
+
+		if (out.size() >= size)
+			return {};
+
+		return Buffer::Copy(out.data(), out.size());
+	}
+
+	bool DecompressLZ(const void* source, uint64_t sourceSize, void* destination, uint64_t destinationSize)
+	{
+		ZN_PROFILE_FUNC();
+
+		const uint8_t* src = static_cast<const uint8_t*>(source);
+		const uint8_t* srcEnd = src + sourceSize;
+		uint8_t* dstBegin = static_cast<uint8_t*>(destination);
+		uint8_t* dst = dstBegin;
+		uint8_t* dstEnd = dstBegin + destinationSize;
+
+		while (src < srcEnd)
+		{
+			const uint8_t token = *src++;
+
+			uint64_t literalLength = token >> 4;
+			if (literalLength == 15 && !Utils::ReadLength(src, srcEnd, literalLength))
+				return false;
+
+			if (literalLength > uint64_t(srcEnd - src) || literalLength > uint64_t(dstEnd - dst))
+				return false;
+
+			memcpy(dst, src, literalLength);
+			src += literalLength;
+			dst += literalLength;
+
+			// The final sequence carries literals only
+			if (src == srcEnd)
+				break;
+
+			if (srcEnd - src < 2)
+				return false;
+
+			const uint32_t offset = src[0] | (src[1] << 8);
+			src += 2;
+			if (offset == 0 || offset > uint64_t(dst - dstBegin))
+				return false;
+
+			uint64_t matchLength = token & 0xf;
+			if (matchLength == 15 && !Utils::ReadLength(src, srcEnd, matchLength))
+				return false;
+			matchLength += Utils::MinMatch;
+
+			if (matchLength > uint64_t(dstEnd - dst))
+				return false;
+
+			// Byte-wise, matches may overlap their own output
+			const uint8_t* match = dst - offset;
+			for (uint64_t i = 0; i < matchLength; i++)
+				dst[i] = match[i];
+			dst += matchLength;
+		}
+
+		return dst == dstEnd;
+	}
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Zenith/Core/Buffer.hpp"
+
+namespace Zenith {
+
+	enum class CompressionType : uint8_t
+	{
+		None = 0, LZ = 1
+	};
+
+	namespace Compression {
+
+		// Worst case CompressLZ output for size input bytes
+		uint64_t GetCompressBound(uint64_t size);
+
+		// Fast LZ77 byte codec (LZ4 block layout, 64 KiB window).
+		// Returns an empty buffer when the data does not shrink, caller owns the result.
+		Buffer CompressLZ(const void* data, uint64_t size);
+
+		// destinationSize must be the exact uncompressed size, returns false on malformed input
+		bool DecompressLZ(const void* source, uint64_t sourceSize, void* destination, uint64_t destinationSize);
+
+	}
+
+}
@@ -2,6 +2,9 @@
 #include "FileSystem.hpp"
 #include "StringUtils.hpp"
 
+#include "Zenith/Core/Hash.hpp"
+#include "Zenith/Debug/Profiler.hpp"
+
 #ifdef ZN_PLATFORM_UNIX
 #include <libgen.h>
 #endif
@@ -207,6 +210,25 @@ namespace Zenith {
 		return 0;
 	}
 
+	uint64_t FileSystem::GetContentHash(const std::filesystem::path& filepath)
+	{
+		ZN_PROFILE_FUNC();
+
+		std::ifstream stream(filepath, std::ios::binary);
+		if (!stream)
+			return 0;
+
+		XXHash64 hash;
+		std::vector<char> chunk(1024 * 1024);
+		while (stream)
+		{
+			stream.read(chunk.data(), chunk.size());
+			hash.update(chunk.data(), (size_t)stream.gcount());
+		}
+
+		return hash.finalize();
+	}
+
 	std::filesystem::path FileSystem::OpenFileDialog(const std::initializer_list<FileDialogFilterItem> inFilters)
 	{
 		NFD::UniquePath filePath;
@@ -49,10 +49,15 @@ namespace Zenith {
 		static bool OpenExternally(const std::filesystem::path& path);
 
 		static bool WriteBytes(const std::filesystem::path& filepath, const Buffer& buffer);
+		// Waits until the file's data, or a directory's entries, are on disk. Done before and after renaming a
+		// temporary file over another, so that after a power loss either the old or the complete new file exists.
+		static bool FlushToDisk(const std::filesystem::path& path);
 		static Buffer ReadBytes(const std::filesystem::path& filepath);
 
 		static std::filesystem::path GetUniqueFileName(const std::filesystem::path& filepath);
 		static uint64_t GetLastWriteTime(const std::filesystem::path& filepath);
+		// xxHash64 of the file's contents, 0 if it cannot be read
+		static uint64_t GetContentHash(const std::filesystem::path& filepath);
 
 		struct FileDialogFilterItem
 		{
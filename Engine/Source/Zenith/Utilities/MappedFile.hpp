@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Zenith/Core/Base.hpp"
+
+#include <filesystem>
+
+namespace Zenith {
+
+	// Read-only memory mapping of a whole file, pages are faulted in on first access.
+	// The mapping is immutable, so reads from any thread are safe.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::filesystem::path& filepath) { Open(filepath); }
+		~MappedFile() { Close(); }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+		MappedFile& operator=(MappedFile&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Close();
+				std::swap(m_Data, other.m_Data);
+				std::swap(m_Size, other.m_Size);
+				std::swap(m_FileHandle, other.m_FileHandle);
+				std::swap(m_MappingHandle, other.m_MappingHandle);
+			}
+			return *this;
+		}
+
+		bool Open(const std::filesystem::path& filepath);
+		void Close();
+
+		bool IsOpen() const { return m_Data != nullptr; }
+		const byte* GetData() const { return m_Data; }
+		uint64_t GetSize() const { return m_Size; }
+
+	private:
+		const byte* m_Data = nullptr;
+		uint64_t m_Size = 0;
+
+		// Windows only, the Unix mapping outlives its file descriptor
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+	};
+
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "Zenith/Asset/AssetPack/AssetPack.hpp"
+#include "Zenith/Asset/AssetPack/AssetPackWriter.hpp"
+#include "Zenith/Utilities/Compression.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace Zenith;
+
+namespace {
+
+	std::string MakeCompressibleText(size_t size)
+	{
+		static const char* words[] = { "vertex ", "index ", "mesh ", "texture ", "material ", "scene " };
+		std::mt19937 rng(7);
+		std::string text;
+		while (text.size() < size)
+			text += words[rng() % 6];
+		text.resize(size);
+		return text;
+	}
+
+	std::filesystem::path GetTempPackPath(const char* name)
+	{
+		return std::filesystem::temp_directory_path() / name;
+	}
+
+}
+
+TEST(AssetPackTest, CompressionRoundTrip) {
+	std::cout << "\n=== Testing LZ Round Trip ===" << std::endl;
+
+	std::mt19937 rng(42);
+	std::string noise(4096, '\0');
+	for (char& c : noise)
+		c = static_cast<char>(rng());
+
+	for (const std::string& input : { MakeCompressibleText(100000), std::string(5000, 'a'), std::string("tiny"), noise })
+	{
+		Buffer compressed = Compression::CompressLZ(input.data(), input.size());
+		if (!compressed)
+		{
+			std::cout << input.size() << " bytes: stored (incompressible)" << std::endl;
+			continue;
+		}
+
+		std::cout << input.size() << " bytes -> " << compressed.Size << " bytes" << std::endl;
+
+		std::string output(input.size(), '\0');
+		EXPECT_TRUE(Compression::DecompressLZ(compressed.Data, compressed.Size, output.data(), output.size()));
+		EXPECT_EQ(output, input);
+
+		// Wrong sizes and truncated streams are rejected rather than overrunning
+		std::string larger(input.size() + 1, '\0');
+		EXPECT_FALSE(Compression::DecompressLZ(compressed.Data, compressed.Size, larger.data(), larger.size()));
+		EXPECT_FALSE(Compression::DecompressLZ(compressed.Data, compressed.Size / 2, output.data(), output.size()));
+
+		compressed.Release();
+	}
+
+	EXPECT_FALSE(Compression::CompressLZ(noise.data(), noise.size()));
+}
+
+TEST(AssetPackTest, WriteAndLookup) {
+	std::cout << "\n=== Testing Pack Write + Lookup ===" << std::endl;
+
+	const std::filesystem::path packPath = GetTempPackPath("ZenithTest_WriteAndLookup.zpak");
+
+	const std::string text = MakeCompressibleText(20000);
+	const std::string binary = "\x01\x02\x03\x04\x05\x06\x07\x08";
+
+	{
+		AssetPackWriter writer;
+		for (uint64_t i = 1; i <= 200; i++)
+		{
+			std::string data = binary + std::to_string(i);
+			writer.AddAsset(AssetHandle(i * 7919), AssetType::Material, "Materials/M" + std::to_string(i) + ".zmat", Buffer(data.data(), data.size()));
+		}
+		writer.AddAsset(AssetHandle(5), AssetType::Scene, "Scenes/Main.zscene", Buffer(text.data(), text.size()));
+
+		const auto stats = writer.GetStatistics();
+		EXPECT_EQ(stats.AssetCount, 201u);
+		EXPECT_EQ(stats.CompressedBlobCount, 1u);
+		ASSERT_TRUE(writer.Write(packPath));
+	}
+
+	Ref<AssetPack> pack = AssetPack::Open(packPath);
+	ASSERT_TRUE(pack);
+	EXPECT_EQ(pack->GetAssetCount(), 201u);
+
+	for (uint64_t i = 1; i <= 200; i++)
+	{
+		AssetHandle handle(i * 7919);
+		ASSERT_TRUE(pack->Contains(handle));
+		EXPECT_EQ(pack->GetAssetType(handle), AssetType::Material);
+		EXPECT_EQ(pack->GetAssetPath(handle), "Materials/M" + std::to_string(i) + ".zmat");
+
+		Buffer mapped = pack->GetMappedData(handle);
+		EXPECT_EQ(std::string(mapped.As<const char>(), mapped.Size), binary + std::to_string(i));
+		EXPECT_EQ(pack->GetEntry(handle)->Offset % 64, 0u);
+	}
+
+	EXPECT_FALSE(pack->Contains(AssetHandle(3)));
+	EXPECT_FALSE(pack->GetMappedData(AssetHandle(5))); // Compressed, no zero-copy view
+
+	Buffer scene = pack->ReadAsset(AssetHandle(5));
+	EXPECT_EQ(std::string(scene.As<const char>(), scene.Size), text);
+	std::cout << "Scene: " << text.size() << " bytes stored as " << pack->GetEntry(AssetHandle(5))->Size << std::endl;
+	scene.Release();
+
+	pack = nullptr;
+	std::filesystem::remove(packPath);
+}
+
+TEST(AssetPackTest, ContentDeduplication) {
+	std::cout << "\n=== Testing Content Deduplication ===" << std::endl;
+
+	const std::filesystem::path packPath = GetTempPackPath("ZenithTest_Dedup.zpak");
+	const std::string shared = MakeCompressibleText(8192);
+
+	{
+		AssetPackWriter writer;
+		writer.AddAsset(AssetHandle(10), AssetType::Texture, "Textures/A.png", Buffer(shared.data(), shared.size()));
+		writer.AddAsset(AssetHandle(11), AssetType::Texture, "Textures/Copy of A.png", Buffer(shared.data(), shared.size()));
+		writer.AddAsset(AssetHandle(12), AssetType::Texture, "Textures/B.png", Buffer("other", 5));
+
+		const auto stats = writer.GetStatistics();
+		std::cout << stats.AssetCount << " assets, " << stats.BlobCount << " blobs, " << stats.SourceBytes << " -> " << stats.StoredBytes << " bytes" << std::endl;
+		EXPECT_EQ(stats.BlobCount, 2u);
+		ASSERT_TRUE(writer.Write(packPath));
+	}
+
+	Ref<AssetPack> pack = AssetPack::Open(packPath);
+	ASSERT_TRUE(pack);
+	EXPECT_EQ(pack->GetEntry(AssetHandle(10))->Offset, pack->GetEntry(AssetHandle(11))->Offset);
+	EXPECT_NE(pack->GetEntry(AssetHandle(10))->Offset, pack->GetEntry(AssetHandle(12))->Offset);
+
+	Buffer copy = pack->ReadAsset(AssetHandle(11));
+	EXPECT_EQ(std::string(copy.As<const char>(), copy.Size), shared);
+	copy.Release();
+
+	pack = nullptr;
+	std::filesystem::remove(packPath);
+}
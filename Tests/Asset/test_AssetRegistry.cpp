@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "Zenith/Asset/AssetRegistry.hpp"
+
+#include <iostream>
+#include <string>
+
+using namespace Zenith;
+
+namespace {
+
+	AssetMetadata MakeMetadata(uint64_t handle, const std::filesystem::path& path)
+	{
+		AssetMetadata metadata;
+		metadata.Handle = AssetHandle(handle);
+		metadata.Type = AssetType::Texture;
+		metadata.FilePath = path;
+		return metadata;
+	}
+
+}
+
+TEST(AssetRegistryTest, PathLookup) {
+	std::cout << "\n=== Testing Asset Registry Path Lookup ===" << std::endl;
+
+	AssetRegistry registry;
+	registry.Set(AssetHandle(1), MakeMetadata(1, "Textures/Brick.png"));
+	registry.Set(AssetHandle(2), MakeMetadata(2, "Materials/Brick.zmat"));
+
+	EXPECT_EQ(registry.GetHandle("Textures/Brick.png"), AssetHandle(1));
+	EXPECT_EQ(registry.GetHandle("Materials/Brick.zmat"), AssetHandle(2));
+	EXPECT_EQ(registry.GetHandle("Textures/Missing.png"), AssetHandle::null());
+
+	// Separators and redundant components do not matter
+	EXPECT_EQ(registry.GetHandle("Textures\\Brick.png"), AssetHandle(1));
+	EXPECT_EQ(registry.GetHandle("Textures/./Brick.png"), AssetHandle(1));
+	EXPECT_EQ(registry.GetHandle("Materials/../Textures/Brick.png"), AssetHandle(1));
+}
+
+TEST(AssetRegistryTest, IndexFollowsRegistry) {
+	std::cout << "\n=== Testing Asset Registry Index Updates ===" << std::endl;
+
+	AssetRegistry registry;
+	registry.Set(AssetHandle(1), MakeMetadata(1, "Textures/Old.png"));
+
+	// Rename
+	registry.Set(AssetHandle(1), MakeMetadata(1, "Textures/New.png"));
+	EXPECT_EQ(registry.GetHandle("Textures/Old.png"), AssetHandle::null());
+	EXPECT_EQ(registry.GetHandle("Textures/New.png"), AssetHandle(1));
+
+	// Metadata update without a path change keeps the entry
+	AssetMetadata loaded = MakeMetadata(1, "Textures/New.png");
+	loaded.IsDataLoaded = true;
+	registry.Set(AssetHandle(1), loaded);
+	EXPECT_EQ(registry.GetHandle("Textures/New.png"), AssetHandle(1));
+
+	// Another asset taking over the path, then the old owner being removed
+	registry.Set(AssetHandle(2), MakeMetadata(2, "Textures/New.png"));
+	EXPECT_EQ(registry.GetHandle("Textures/New.png"), AssetHandle(2));
+	EXPECT_EQ(registry.Remove(AssetHandle(1)), 1u);
+	EXPECT_EQ(registry.GetHandle("Textures/New.png"), AssetHandle(2));
+
+	EXPECT_EQ(registry.Remove(AssetHandle(2)), 1u);
+	EXPECT_EQ(registry.Remove(AssetHandle(2)), 0u);
+	EXPECT_EQ(registry.GetHandle("Textures/New.png"), AssetHandle::null());
+
+	registry.Set(AssetHandle(3), MakeMetadata(3, "Scenes/Main.zscene"));
+	registry.Clear();
+	EXPECT_EQ(registry.Count(), 0u);
+	EXPECT_EQ(registry.GetHandle("Scenes/Main.zscene"), AssetHandle::null());
+}
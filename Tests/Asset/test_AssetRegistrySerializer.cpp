@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include "Zenith/Asset/AssetRegistrySerializer.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace Zenith;
+
+namespace {
+
+	AssetMetadata MakeMetadata(uint64_t handle, const std::filesystem::path& path, AssetType type = AssetType::Texture)
+	{
+		AssetMetadata metadata;
+		metadata.Handle = AssetHandle(handle);
+		metadata.Type = type;
+		metadata.FilePath = path;
+		return metadata;
+	}
+
+	const AssetMetadata* Find(const std::vector<AssetMetadata>& entries, uint64_t handle)
+	{
+		auto it = std::find_if(entries.begin(), entries.end(), [&](const AssetMetadata& metadata) { return (uint64_t)metadata.Handle == handle; });
+		return it != entries.end() ? &*it : nullptr;
+	}
+
+	class AssetRegistrySerializerTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			m_Directory = std::filesystem::temp_directory_path() / "ZenithTest_AssetRegistry";
+			std::filesystem::remove_all(m_Directory);
+			std::filesystem::create_directories(m_Directory);
+			m_RegistryPath = m_Directory / "AssetRegistry.znr";
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(m_Directory);
+		}
+
+		std::filesystem::path m_Directory;
+		std::filesystem::path m_RegistryPath;
+	};
+
+}
+
+TEST_F(AssetRegistrySerializerTest, JournalReplay) {
+	std::cout << "\n=== Testing Asset Registry Journal Replay ===" << std::endl;
+
+	{
+		AssetRegistrySerializer serializer(m_RegistryPath);
+		std::vector<AssetMetadata> entries;
+		ASSERT_TRUE(serializer.Deserialize(entries));
+		EXPECT_TRUE(entries.empty());
+
+		ASSERT_TRUE(serializer.Compact({ MakeMetadata(1, "Textures/A.png"), MakeMetadata(2, "Textures/B.png") }));
+
+		serializer.RecordSet(MakeMetadata(3, "Materials/C.zmat", AssetType::Material), true);
+		serializer.RecordSet(MakeMetadata(1, "Textures/Renamed.png"), false);
+		serializer.RecordRemove(AssetHandle(2));
+		EXPECT_TRUE(serializer.HasPendingChanges());
+		EXPECT_FALSE(serializer.NeedsCompaction(3));
+
+		const uintmax_t snapshotSize = std::filesystem::file_size(m_RegistryPath);
+		ASSERT_TRUE(serializer.Flush());
+		EXPECT_EQ(std::filesystem::file_size(m_RegistryPath), snapshotSize); // Only the journal is written
+	}
+
+	AssetRegistrySerializer serializer(m_RegistryPath);
+	std::vector<AssetMetadata> entries;
+	ASSERT_TRUE(serializer.Deserialize(entries));
+	ASSERT_EQ(entries.size(), 2u);
+	ASSERT_TRUE(Find(entries, 1));
+	EXPECT_EQ(Find(entries, 1)->FilePath, "Textures/Renamed.png");
+	EXPECT_FALSE(Find(entries, 2));
+	ASSERT_TRUE(Find(entries, 3));
+	EXPECT_EQ(Find(entries, 3)->Type, AssetType::Material);
+
+	// Compaction folds the journal into the snapshot
+	ASSERT_TRUE(serializer.Compact(entries));
+	std::vector<AssetMetadata> compacted;
+	AssetRegistrySerializer reader(m_RegistryPath);
+	ASSERT_TRUE(reader.Deserialize(compacted));
+	EXPECT_EQ(compacted.size(), 2u);
+	EXPECT_FALSE(reader.NeedsCompaction(compacted.size()));
+}
+
+TEST_F(AssetRegistrySerializerTest, TornJournalTail) {
+	std::cout << "\n=== Testing Asset Registry Torn Journal ===" << std::endl;
+
+	{
+		AssetRegistrySerializer serializer(m_RegistryPath);
+		ASSERT_TRUE(serializer.Compact({ MakeMetadata(1, "Textures/A.png") }));
+		serializer.RecordSet(MakeMetadata(2, "Textures/B.png"), true);
+		serializer.RecordSet(MakeMetadata(3, "Textures/C.png"), true);
+		ASSERT_TRUE(serializer.Flush());
+	}
+
+	// Simulate a crash halfway through the last record
+	const std::filesystem::path journalPath = AssetRegistrySerializer(m_RegistryPath).GetJournalPath();
+	std::filesystem::resize_file(journalPath, std::filesystem::file_size(journalPath) - 4);
+
+	{
+		AssetRegistrySerializer serializer(m_RegistryPath);
+		std::vector<AssetMetadata> entries;
+		ASSERT_TRUE(serializer.Deserialize(entries));
+		EXPECT_EQ(entries.size(), 2u);
+		EXPECT_TRUE(Find(entries, 2));
+		EXPECT_FALSE(Find(entries, 3));
+
+		// New records must still be readable after the discarded tail
+		serializer.RecordSet(MakeMetadata(4, "Textures/D.png"), true);
+		ASSERT_TRUE(serializer.Flush());
+	}
+
+	AssetRegistrySerializer serializer(m_RegistryPath);
+	std::vector<AssetMetadata> entries;
+	ASSERT_TRUE(serializer.Deserialize(entries));
+	EXPECT_EQ(entries.size(), 3u);
+	EXPECT_TRUE(Find(entries, 4));
+}
+
+TEST_F(AssetRegistrySerializerTest, LegacyJSONAndExport) {
+	std::cout << "\n=== Testing Asset Registry JSON Import/Export ===" << std::endl;
+
+	{
+		std::ofstream stream(m_RegistryPath);
+		stream << R"({ "Assets": [ { "Handle": 7, "FilePath": "Textures/Old.png", "Type": "Texture" } ] })";
+	}
+
+	AssetRegistrySerializer serializer(m_RegistryPath);
+	std::vector<AssetMetadata> entries;
+	ASSERT_TRUE(serializer.Deserialize(entries));
+	ASSERT_EQ(entries.size(), 1u);
+	EXPECT_EQ(entries[0].Handle, AssetHandle(7));
+	EXPECT_EQ(entries[0].Type, AssetType::Texture);
+	EXPECT_TRUE(serializer.NeedsCompaction(entries.size())); // Converted to binary on next save
+
+	const std::filesystem::path exportPath = m_Directory / "Export.json";
+	ASSERT_TRUE(AssetRegistrySerializer::ExportJSON(entries, exportPath));
+
+	AssetRegistrySerializer exported(exportPath);
+	std::vector<AssetMetadata> roundTrip;
+	ASSERT_TRUE(exported.Deserialize(roundTrip));
+	ASSERT_EQ(roundTrip.size(), 1u);
+	EXPECT_EQ(roundTrip[0].FilePath, "Textures/Old.png");
+}
+
+TEST_F(AssetRegistrySerializerTest, SourceStatePersisted) {
+	std::cout << "\n=== Testing Asset Registry Source State ===" << std::endl;
+
+	AssetMetadata loaded = MakeMetadata(1, "Textures/A.png");
+	loaded.ContentHash = 0x1234567890abcdefull;
+	loaded.FileLastWriteTime = 1700000000;
+	loaded.ImporterVersion = 3;
+
+	{
+		AssetRegistrySerializer serializer(m_RegistryPath);
+		ASSERT_TRUE(serializer.Compact({ loaded }));
+
+		AssetMetadata journaled = MakeMetadata(2, "Textures/B.png");
+		journaled.ContentHash = 42;
+		journaled.ImporterVersion = 1;
+		serializer.RecordSet(journaled, true);
+		ASSERT_TRUE(serializer.Flush());
+	}
+
+	AssetRegistrySerializer serializer(m_RegistryPath);
+	std::vector<AssetMetadata> entries;
+	ASSERT_TRUE(serializer.Deserialize(entries));
+	ASSERT_EQ(entries.size(), 2u);
+	ASSERT_TRUE(Find(entries, 1));
+	EXPECT_TRUE(AssetRegistrySerializer::IsPersistedStateEqual(*Find(entries, 1), loaded));
+	ASSERT_TRUE(Find(entries, 2));
+	EXPECT_EQ(Find(entries, 2)->ContentHash, 42u);
+	EXPECT_EQ(Find(entries, 2)->ImporterVersion, 1u);
+
+	AssetMetadata touched = loaded;
+	touched.FileLastWriteTime++;
+	EXPECT_FALSE(AssetRegistrySerializer::IsPersistedStateEqual(touched, loaded));
+}
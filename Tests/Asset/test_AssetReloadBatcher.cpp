@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "Zenith/Asset/AssetSystem/AssetReloadBatcher.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+
+using namespace Zenith;
+using namespace std::chrono_literals;
+
+namespace {
+
+	size_t LevelOf(const AssetReloadBatcher::Batch& batch, uint64_t handle)
+	{
+		for (size_t i = 0; i < batch.Levels.size(); i++)
+		{
+			if (std::find(batch.Levels[i].begin(), batch.Levels[i].end(), AssetHandle(handle)) != batch.Levels[i].end())
+				return i;
+		}
+		return SIZE_MAX;
+	}
+
+}
+
+TEST(AssetReloadBatcherTest, Debounce) {
+	std::cout << "\n=== Testing Asset Reload Debounce ===" << std::endl;
+
+	AssetReloadBatcher batcher(100ms, 1s);
+	const auto start = AssetReloadBatcher::Clock::time_point();
+
+	EXPECT_FALSE(batcher.IsReady(start));
+	EXPECT_TRUE(batcher.AddChange(AssetHandle(1), start));
+	EXPECT_FALSE(batcher.AddChange(AssetHandle(1), start + 50ms));
+	EXPECT_FALSE(batcher.IsReady(start + 50ms));
+	EXPECT_TRUE(batcher.IsReady(start + 100ms));
+
+	// Every new change restarts the settle time, up to the maximum delay
+	for (auto time = start + 90ms; time + 50ms < start + 1s; time += 90ms)
+	{
+		batcher.AddChange(AssetHandle(uint64_t(2 + time.time_since_epoch().count())), time);
+		EXPECT_FALSE(batcher.IsReady(time + 50ms));
+	}
+	EXPECT_TRUE(batcher.IsReady(start + 1s));
+}
+
+TEST(AssetReloadBatcherTest, TopologicalLevels) {
+	std::cout << "\n=== Testing Asset Reload Ordering ===" << std::endl;
+
+	// Textures 1, 2 -> materials 10, 11 -> mesh 20 (uses both materials). Asset 30 is unrelated.
+	std::unordered_map<uint64_t, std::unordered_set<AssetHandle>> dependents = {
+		{ 1, { AssetHandle(10), AssetHandle(11) } },
+		{ 2, { AssetHandle(11) } },
+		{ 10, { AssetHandle(20) } },
+		{ 11, { AssetHandle(20) } },
+	};
+
+	uint32_t lookups = 0;
+	auto getDependents = [&](AssetHandle handle)
+	{
+		lookups++;
+		auto it = dependents.find((uint64_t)handle);
+		return it != dependents.end() ? it->second : std::unordered_set<AssetHandle>{};
+	};
+
+	AssetReloadBatcher batcher;
+	batcher.AddChange(AssetHandle(1));
+	batcher.AddChange(AssetHandle(2));
+	batcher.AddChange(AssetHandle(11));
+
+	AssetReloadBatcher::Batch batch = batcher.TakeBatch(getDependents);
+	EXPECT_FALSE(batcher.HasPendingChanges());
+	EXPECT_EQ(batch.Changed.size(), 3u);
+	EXPECT_EQ(batch.GetAssetCount(), 5u); // The shared mesh and material appear once
+	EXPECT_EQ(lookups, 5u);
+
+	EXPECT_EQ(LevelOf(batch, 1), 0u);
+	EXPECT_EQ(LevelOf(batch, 2), 0u);
+	EXPECT_EQ(LevelOf(batch, 10), 1u);
+	EXPECT_EQ(LevelOf(batch, 11), 1u);
+	EXPECT_EQ(LevelOf(batch, 20), 2u);
+	EXPECT_EQ(LevelOf(batch, 30), SIZE_MAX);
+}
+
+TEST(AssetReloadBatcherTest, DependencyCycle) {
+	std::cout << "\n=== Testing Asset Reload Dependency Cycle ===" << std::endl;
+
+	std::unordered_map<uint64_t, std::unordered_set<AssetHandle>> dependents = {
+		{ 1, { AssetHandle(2) } },
+		{ 2, { AssetHandle(3) } },
+		{ 3, { AssetHandle(2) } },
+	};
+
+	AssetReloadBatcher batcher;
+	batcher.AddChange(AssetHandle(1));
+	AssetReloadBatcher::Batch batch = batcher.TakeBatch([&](AssetHandle handle)
+	{
+		auto it = dependents.find((uint64_t)handle);
+		return it != dependents.end() ? it->second : std::unordered_set<AssetHandle>{};
+	});
+
+	ASSERT_EQ(batch.Levels.size(), 2u);
+	EXPECT_EQ(LevelOf(batch, 1), 0u);
+	EXPECT_EQ(LevelOf(batch, 2), 1u);
+	EXPECT_EQ(LevelOf(batch, 3), 1u);
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include "Zenith/Asset/AssetSystem/EditorAssetSystem.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <thread>
+
+using namespace Zenith;
+using namespace std::chrono_literals;
+
+namespace {
+
+	class TestAsset : public Asset
+	{
+	public:
+		static AssetType GetStaticType() { return AssetType::Scene; }
+		virtual AssetType GetAssetType() const override { return GetStaticType(); }
+	};
+
+	AssetMetadata MakeMetadata(uint64_t handle)
+	{
+		AssetMetadata metadata;
+		metadata.Handle = AssetHandle(handle);
+		metadata.Type = AssetType::Scene;
+		metadata.FilePath = "Scenes/" + std::to_string(handle) + ".zscene";
+		return metadata;
+	}
+
+	// Loads without a project: dependencies come from a table, loads are recorded in the order they start and finish
+	class TestAssetSystem : public EditorAssetSystem
+	{
+	public:
+		explicit TestAssetSystem(uint32_t workerCount, AssetHandle blockedHandle = AssetHandle(0))
+			: EditorAssetSystem(workerCount), m_BlockedHandle(blockedHandle) {}
+
+		~TestAssetSystem()
+		{
+			Unblock();
+			StopAndWait();
+		}
+
+		std::map<AssetHandle, std::vector<AssetHandle>> Dependencies; // set before queueing anything
+
+		// Loads of the blocked asset wait for Unblock()
+		void Unblock()
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_BlockedHandle = AssetHandle(0);
+			m_CV.notify_all();
+		}
+
+		void WaitUntilLoading(AssetHandle handle)
+		{
+			std::unique_lock lock(m_Mutex);
+			m_CV.wait(lock, [&] { return m_StartTick.contains(handle); });
+		}
+
+		std::vector<AssetHandle> GetLoadOrder()
+		{
+			std::scoped_lock lock(m_Mutex);
+			return m_LoadOrder;
+		}
+
+		uint32_t GetLoadCount(AssetHandle handle)
+		{
+			std::scoped_lock lock(m_Mutex);
+			return (uint32_t)std::count(m_LoadOrder.begin(), m_LoadOrder.end(), handle);
+		}
+
+		uint64_t GetStartTick(AssetHandle handle) { std::scoped_lock lock(m_Mutex); return m_StartTick.at(handle); }
+		uint64_t GetFinishTick(AssetHandle handle) { std::scoped_lock lock(m_Mutex); return m_FinishTick.at(handle); }
+
+	protected:
+		virtual std::vector<AssetMetadata> GetLoadDependencies(const AssetMetadata& metadata) override
+		{
+			std::vector<AssetMetadata> result;
+			if (auto it = Dependencies.find(metadata.Handle); it != Dependencies.end())
+			{
+				for (AssetHandle dependency : it->second)
+					result.push_back(MakeMetadata(dependency));
+			}
+			return result;
+		}
+
+		virtual Ref<Asset> TryLoadData(AssetMetadata metadata) override
+		{
+			{
+				std::unique_lock lock(m_Mutex);
+				m_StartTick[metadata.Handle] = m_Tick++;
+				m_CV.notify_all();
+				m_CV.wait(lock, [&] { return metadata.Handle != m_BlockedHandle; });
+			}
+
+			// Long enough for a dependent that started early to be caught
+			std::this_thread::sleep_for(5ms);
+
+			Ref<Asset> asset = Ref<TestAsset>::Create();
+			asset->Handle = metadata.Handle;
+
+			std::scoped_lock lock(m_Mutex);
+			m_FinishTick[metadata.Handle] = m_Tick++;
+			m_LoadOrder.push_back(metadata.Handle);
+			return asset;
+		}
+
+	private:
+		AssetHandle m_BlockedHandle;
+		std::mutex m_Mutex;
+		std::condition_variable m_CV;
+		uint64_t m_Tick = 0;
+		std::map<AssetHandle, uint64_t> m_StartTick, m_FinishTick;
+		std::vector<AssetHandle> m_LoadOrder;
+	};
+
+}
+
+TEST(EditorAssetSystemTest, SharesLoadsOfTheSameAsset) {
+	std::cout << "\n=== Testing Asset Load Deduplication ===" << std::endl;
+
+	Ref<TestAssetSystem> assetSystem = Ref<TestAssetSystem>::Create(1, AssetHandle(1));
+
+	// Requests while the asset is loading
+	std::shared_future<Ref<Asset>> first = assetSystem->QueueAssetLoad(MakeMetadata(1));
+	assetSystem->WaitUntilLoading(AssetHandle(1));
+	std::shared_future<Ref<Asset>> second = assetSystem->QueueAssetLoad(MakeMetadata(1), AssetLoadPriority::Visible);
+
+	// Requests while the asset is still queued (the only worker is busy)
+	std::vector<std::shared_future<Ref<Asset>>> queued;
+	for (int i = 0; i < 3; i++)
+		queued.push_back(assetSystem->QueueAssetLoad(MakeMetadata(2)));
+
+	// GetAsset() takes over a queued load instead of starting another one
+	Ref<Asset> immediate = assetSystem->GetAsset(MakeMetadata(2));
+	ASSERT_TRUE(immediate);
+	for (const auto& future : queued)
+		EXPECT_EQ(future.get(), immediate);
+
+	assetSystem->Unblock();
+	ASSERT_TRUE(first.get());
+	EXPECT_EQ(first.get(), second.get());
+	EXPECT_EQ(first.get()->Handle, AssetHandle(1));
+
+	// The worker skips the entries of the asset GetAsset() loaded
+	std::this_thread::sleep_for(50ms);
+	EXPECT_EQ(assetSystem->GetLoadCount(AssetHandle(1)), 1u);
+	EXPECT_EQ(assetSystem->GetLoadCount(AssetHandle(2)), 1u);
+}
+
+TEST(EditorAssetSystemTest, LoadsByPriority) {
+	std::cout << "\n=== Testing Asset Load Priority ===" << std::endl;
+
+	Ref<TestAssetSystem> assetSystem = Ref<TestAssetSystem>::Create(1, AssetHandle(1));
+
+	std::vector<std::shared_future<Ref<Asset>>> futures;
+	futures.push_back(assetSystem->QueueAssetLoad(MakeMetadata(1)));
+	assetSystem->WaitUntilLoading(AssetHandle(1));
+
+	// Queued behind the blocked load, so the worker sees all of them at once
+	futures.push_back(assetSystem->QueueAssetLoad(MakeMetadata(2), AssetLoadPriority::Background));
+	futures.push_back(assetSystem->QueueAssetLoad(MakeMetadata(3), AssetLoadPriority::Normal));
+	futures.push_back(assetSystem->QueueAssetLoad(MakeMetadata(4), AssetLoadPriority::Visible));
+	futures.push_back(assetSystem->QueueAssetLoad(MakeMetadata(5), AssetLoadPriority::Normal));
+	futures.push_back(assetSystem->QueueAssetLoad(MakeMetadata(6), AssetLoadPriority::Background));
+
+	// Asking again at a higher priority moves the asset up, behind what is already queued at that priority
+	futures.push_back(assetSystem->QueueAssetLoad(MakeMetadata(6), AssetLoadPriority::Visible));
+
+	assetSystem->Unblock();
+	for (const auto& future : futures)
+		ASSERT_TRUE(future.get());
+
+	const std::vector<AssetHandle> expected = { AssetHandle(1), AssetHandle(4), AssetHandle(6), AssetHandle(3), AssetHandle(5), AssetHandle(2) };
+	EXPECT_EQ(assetSystem->GetLoadOrder(), expected);
+}
+
+TEST(EditorAssetSystemTest, LoadsDependenciesFirst) {
+	std::cout << "\n=== Testing Asset Dependency Loading ===" << std::endl;
+
+	for (uint32_t workerCount : { 1u, 4u })
+	{
+		Ref<TestAssetSystem> assetSystem = Ref<TestAssetSystem>::Create(workerCount);
+
+		// 10 -> 11, 12, 14
+		// 11 -> 13
+		// 14 -> 15 -> 16
+		assetSystem->Dependencies[AssetHandle(10)] = { AssetHandle(11), AssetHandle(12), AssetHandle(14) };
+		assetSystem->Dependencies[AssetHandle(11)] = { AssetHandle(13) };
+		assetSystem->Dependencies[AssetHandle(14)] = { AssetHandle(15) };
+		assetSystem->Dependencies[AssetHandle(15)] = { AssetHandle(16) };
+
+		Ref<Asset> asset = assetSystem->QueueAssetLoad(MakeMetadata(10)).get();
+		ASSERT_TRUE(asset);
+		EXPECT_EQ(asset->Handle, AssetHandle(10));
+		EXPECT_EQ(assetSystem->GetLoadOrder().size(), 7u);
+
+		for (const auto& [dependent, dependencies] : assetSystem->Dependencies)
+		{
+			for (AssetHandle dependency : dependencies)
+			{
+				EXPECT_LT(assetSystem->GetFinishTick(dependency), assetSystem->GetStartTick(dependent))
+					<< (uint64_t)dependency << " must be loaded before " << (uint64_t)dependent << " (" << workerCount << " workers)";
+			}
+		}
+	}
+}
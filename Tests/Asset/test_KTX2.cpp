@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include "Zenith/Asset/KTX2.hpp"
+
+#include <filesystem>
+#include <iostream>
+
+using namespace Zenith;
+
+namespace {
+
+	TextureData CreateGradient(uint32_t width, uint32_t height)
+	{
+		TextureData data;
+		data.Width = width;
+		data.Height = height;
+		data.Format = ImageFormat::RGBA;
+		data.ImageData.Allocate(width * height * 4);
+
+		uint8_t* pixels = data.ImageData.As<uint8_t>();
+		for (uint32_t i = 0; i < width * height; i++)
+		{
+			pixels[i * 4 + 0] = uint8_t((i % width) * 255 / (width - 1));
+			pixels[i * 4 + 1] = uint8_t((i / width) * 255 / (height - 1));
+			pixels[i * 4 + 2] = 64;
+			pixels[i * 4 + 3] = 255;
+		}
+		return data;
+	}
+
+	uint32_t ReadU32(const Buffer& data, uint64_t offset)
+	{
+		uint32_t value;
+		memcpy(&value, data.As<uint8_t>() + offset, sizeof(value));
+		return value;
+	}
+
+	uint64_t ReadU64(const Buffer& data, uint64_t offset)
+	{
+		uint64_t value;
+		memcpy(&value, data.As<uint8_t>() + offset, sizeof(value));
+		return value;
+	}
+
+}
+
+TEST(KTX2Test, RoundTrip) {
+	std::cout << "\n=== Testing KTX2 Round Trip ===" << std::endl;
+
+	TextureData source = CreateGradient(64, 48);
+	for (TextureCookQuality quality : { TextureCookQuality::Normal, TextureCookQuality::Uncompressed })
+	{
+		CookedTexture cooked = TextureCooker::Cook(source, TextureUsage::Albedo, quality);
+		ASSERT_TRUE(cooked.IsValid());
+
+		for (KTX2Supercompression supercompression : { KTX2Supercompression::None, KTX2Supercompression::ZLIB })
+		{
+			Buffer file = KTX2::Encode(cooked, supercompression);
+			ASSERT_TRUE(KTX2::IsKTX2(file));
+			std::cout << "Format " << (int)cooked.Format << ", scheme " << (int)supercompression << ": " << file.Size << " bytes" << std::endl;
+
+			CookedTexture decoded = KTX2::Decode(file);
+			ASSERT_TRUE(decoded.IsValid());
+			EXPECT_EQ(decoded.Format, cooked.Format);
+			EXPECT_EQ(decoded.Width, cooked.Width);
+			EXPECT_EQ(decoded.Height, cooked.Height);
+			EXPECT_EQ(decoded.MipCount, cooked.MipCount);
+			ASSERT_EQ(decoded.Data.Size, cooked.Data.Size);
+			EXPECT_EQ(memcmp(decoded.Data.Data, cooked.Data.Data, cooked.Data.Size), 0);
+
+			if (supercompression == KTX2Supercompression::ZLIB && quality == TextureCookQuality::Uncompressed)
+				EXPECT_LT(file.Size, cooked.Data.Size);
+
+			file.Release();
+			decoded.Data.Release();
+		}
+		cooked.Data.Release();
+	}
+	source.ImageData.Release();
+}
+
+TEST(KTX2Test, LevelLayout) {
+	std::cout << "\n=== Testing KTX2 Level Layout ===" << std::endl;
+
+	TextureData source = CreateGradient(40, 24);
+	CookedTexture cooked = TextureCooker::Cook(source, TextureUsage::Mask, TextureCookQuality::Normal);
+	Buffer file = KTX2::Encode(cooked, KTX2Supercompression::None);
+	ASSERT_TRUE(file);
+
+	EXPECT_EQ(ReadU32(file, 12), 139u); // VK_FORMAT_BC4_UNORM_BLOCK
+	EXPECT_EQ(ReadU32(file, 20), 40u);
+	EXPECT_EQ(ReadU32(file, 24), 24u);
+	EXPECT_EQ(ReadU32(file, 36), 1u); // faces
+	EXPECT_EQ(ReadU32(file, 40), cooked.MipCount);
+	EXPECT_EQ(ReadU32(file, 44), 0u); // no supercompression
+
+	// Levels are stored smallest first and aligned to the block size
+	uint64_t previousOffset = file.Size;
+	for (uint32_t level = 0; level < cooked.MipCount; level++)
+	{
+		const uint64_t entry = 80 + level * 24;
+		const uint64_t offset = ReadU64(file, entry);
+		EXPECT_EQ(offset % 8, 0u);
+		EXPECT_LT(offset, previousOffset);
+		EXPECT_EQ(ReadU64(file, entry + 8), Utils::GetImageMemorySize(ImageFormat::BC4, std::max(40u >> level, 1u), std::max(24u >> level, 1u)));
+		previousOffset = offset;
+	}
+
+	file.Release();
+	cooked.Data.Release();
+	source.ImageData.Release();
+}
+
+TEST(KTX2Test, PartialReads) {
+	std::cout << "\n=== Testing KTX2 Partial Reads ===" << std::endl;
+
+	TextureData source = CreateGradient(64, 48);
+	CookedTexture cooked = TextureCooker::Cook(source, TextureUsage::Albedo, TextureCookQuality::Normal);
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "ZenithPartialRead.ktx2";
+	ASSERT_TRUE(KTX2::Write(path, cooked));
+
+	const auto levelOffset = [&cooked](uint32_t firstMip)
+	{
+		uint64_t offset = 0;
+		for (uint32_t mip = 0; mip < firstMip; mip++)
+			offset += Utils::GetImageMemorySize(cooked.Format, std::max(cooked.Width >> mip, 1u), std::max(cooked.Height >> mip, 1u));
+		return offset;
+	};
+
+	// 64 -> 32 -> 16
+	CookedTexture small = KTX2::Read(path, 16);
+	ASSERT_TRUE(small.IsValid());
+	EXPECT_EQ(small.FirstMip, 2u);
+	EXPECT_EQ(small.Width, 64u);
+	EXPECT_EQ(small.MipCount, cooked.MipCount);
+	EXPECT_EQ(small.FilePath, path);
+	ASSERT_EQ(small.Data.Size, cooked.Data.Size - levelOffset(2));
+	EXPECT_EQ(memcmp(small.Data.Data, cooked.Data.As<uint8_t>() + levelOffset(2), small.Data.Size), 0);
+
+	CookedTexture mips = KTX2::ReadMips(path, 1);
+	ASSERT_TRUE(mips.IsValid());
+	EXPECT_EQ(mips.FirstMip, 1u);
+	ASSERT_EQ(mips.Data.Size, cooked.Data.Size - levelOffset(1));
+	EXPECT_EQ(memcmp(mips.Data.Data, cooked.Data.As<uint8_t>() + levelOffset(1), mips.Data.Size), 0);
+
+	// The smallest mip is always kept
+	CookedTexture tiny = KTX2::Read(path, 1);
+	EXPECT_EQ(tiny.FirstMip, cooked.MipCount - 1);
+	EXPECT_FALSE(KTX2::ReadMips(path, cooked.MipCount).IsValid());
+
+	// Only complete mip chains are encoded
+	EXPECT_FALSE(KTX2::Encode(small));
+
+	tiny.Data.Release();
+	mips.Data.Release();
+	small.Data.Release();
+	cooked.Data.Release();
+	source.ImageData.Release();
+	std::filesystem::remove(path);
+}
+
+TEST(KTX2Test, RejectsInvalidFiles) {
+	std::cout << "\n=== Testing KTX2 Validation ===" << std::endl;
+
+	TextureData source = CreateGradient(16, 16);
+	CookedTexture cooked = TextureCooker::Cook(source, TextureUsage::Albedo, TextureCookQuality::Uncompressed);
+	Buffer file = KTX2::Encode(cooked, KTX2Supercompression::ZLIB);
+	ASSERT_TRUE(file);
+
+	EXPECT_FALSE(KTX2::Decode(Buffer(file.Data, 60)).IsValid());
+	EXPECT_FALSE(KTX2::Decode(Buffer(file.Data, file.Size - 1)).IsValid());
+
+	// Zstandard
+	Buffer zstd = Buffer::Copy(file);
+	const uint32_t scheme = 2;
+	memcpy(zstd.As<uint8_t>() + 44, &scheme, sizeof(scheme));
+	EXPECT_FALSE(KTX2::Decode(zstd).IsValid());
+
+	const uint8_t png[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n', 0, 0, 0, 0 };
+	EXPECT_FALSE(KTX2::IsKTX2(Buffer(png, sizeof(png))));
+
+	zstd.Release();
+	file.Release();
+	cooked.Data.Release();
+	source.ImageData.Release();
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include "Zenith/Core/Log.hpp"
+#include "Zenith/Asset/AssetImporter.hpp"
+#include "Zenith/Asset/AssetManager/RuntimeAssetManager.hpp"
+#include "Zenith/Asset/AssetPack/AssetPackWriter.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+using namespace Zenith;
+
+namespace {
+
+	class TestAsset : public Asset
+	{
+	public:
+		static AssetType GetStaticType() { return AssetType::Scene; }
+		virtual AssetType GetAssetType() const override { return GetStaticType(); }
+	};
+
+	// Scenes have no engine serializer, so their pack blobs can be loaded without a renderer
+	class TestAssetSerializer : public AssetSerializer
+	{
+	public:
+		virtual void Serialize(const AssetMetadata& metadata, const Ref<Asset>& asset) const override {}
+		virtual bool TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset) const override { return false; }
+		virtual bool TryLoadDataFromMemory(const AssetMetadata& metadata, Buffer data, Ref<Asset>& asset) const override
+		{
+			asset = Ref<TestAsset>::Create();
+			asset->Handle = metadata.Handle;
+			return true;
+		}
+	};
+
+	std::filesystem::path WriteTestPack()
+	{
+		const std::filesystem::path packPath = std::filesystem::temp_directory_path() / "ZenithTest_RuntimeAssets.zpak";
+
+		AssetPackWriter writer;
+		for (uint64_t i = 1; i <= 8; i++)
+		{
+			std::string data = "{ \"Material\": " + std::to_string(i) + " }";
+			writer.AddAsset(AssetHandle(1000 + i), AssetType::Material, "Materials/M" + std::to_string(i) + ".zmat", Buffer(data.data(), data.size()));
+		}
+		writer.AddAsset(AssetHandle(2000), AssetType::Texture, "Textures/T.png", Buffer("png", 3));
+
+		// 100 bytes each
+		const std::string scene(100, 'S');
+		for (uint64_t i = 1; i <= 5; i++)
+			writer.AddAsset(AssetHandle(3000 + i), AssetType::Scene, "Scenes/S" + std::to_string(i) + ".zscene", Buffer(scene.data(), scene.size()));
+		writer.Write(packPath);
+		return packPath;
+	}
+
+}
+
+TEST(RuntimeAssetManagerTest, PackLookups) {
+	std::cout << "\n=== Testing Runtime Pack Lookups ===" << std::endl;
+
+	const std::filesystem::path packPath = WriteTestPack();
+	{
+		Ref<RuntimeAssetManager> assetManager = Ref<RuntimeAssetManager>::Create(packPath);
+		ASSERT_TRUE(assetManager->GetAssetPack());
+
+		EXPECT_TRUE(assetManager->IsAssetHandleValid(AssetHandle(1001)));
+		EXPECT_FALSE(assetManager->IsAssetHandleValid(AssetHandle(1)));
+		EXPECT_FALSE(assetManager->IsAssetMissing(AssetHandle(2000)));
+		EXPECT_TRUE(assetManager->IsPhysicalAsset(AssetHandle(2000)));
+		EXPECT_FALSE(assetManager->IsAssetLoaded(AssetHandle(2000)));
+
+		EXPECT_EQ(assetManager->GetAssetType(AssetHandle(1004)), AssetType::Material);
+		EXPECT_EQ(assetManager->GetAssetType(AssetHandle(2000)), AssetType::Texture);
+		EXPECT_EQ(assetManager->GetAllAssetsWithType(AssetType::Material).size(), 8u);
+		EXPECT_EQ(assetManager->GetAllAssetsWithType(AssetType::Scene).size(), 5u);
+
+		// Packs never change on disk
+		EXPECT_FALSE(assetManager->EnsureAllLoadedCurrent());
+	}
+	std::filesystem::remove(packPath);
+}
+
+TEST(RuntimeAssetManagerTest, MemoryAssetsAndDependencies) {
+	std::cout << "\n=== Testing Runtime Memory Assets + Dependencies ===" << std::endl;
+
+	const std::filesystem::path packPath = WriteTestPack();
+	{
+		Ref<RuntimeAssetManager> assetManager = Ref<RuntimeAssetManager>::Create(packPath);
+
+		// Enough handles to spread over several shards
+		std::vector<AssetHandle> handles;
+		for (int i = 0; i < 256; i++)
+		{
+			Ref<TestAsset> asset = Ref<TestAsset>::Create();
+			asset->Handle = AssetHandle();
+			assetManager->AddMemoryOnlyAsset(asset);
+			handles.push_back(asset->Handle);
+		}
+
+		for (AssetHandle handle : handles)
+		{
+			ASSERT_TRUE(assetManager->IsMemoryAsset(handle));
+			EXPECT_EQ(assetManager->GetAsset(handle), assetManager->GetMemoryAsset(handle));
+			EXPECT_EQ(assetManager->GetAssetType(handle), AssetType::Scene);
+		}
+		EXPECT_EQ(assetManager->GetAllAssetsWithType(AssetType::Scene).size(), handles.size());
+		EXPECT_TRUE(assetManager->GetLoadedAssets().empty()); // Memory assets are not "loaded"
+
+		assetManager->RegisterDependency(AssetHandle(2000), AssetHandle(1001));
+		assetManager->RegisterDependency(AssetHandle(1002), AssetHandle(1001));
+		EXPECT_EQ(assetManager->GetDependencies(AssetHandle(1001)).size(), 2u);
+		assetManager->DeregisterDependency(AssetHandle(1002), AssetHandle(1001));
+		EXPECT_EQ(assetManager->GetDependencies(AssetHandle(1001)).size(), 1u);
+		assetManager->DeregisterDependencies(AssetHandle(1001));
+		EXPECT_TRUE(assetManager->GetDependencies(AssetHandle(1001)).empty());
+
+		assetManager->RemoveAsset(handles[0]);
+		EXPECT_FALSE(assetManager->IsAssetHandleValid(handles[0]));
+
+		assetManager->SetMemoryBudget(AssetType::Texture, 64 * 1024 * 1024);
+		EXPECT_EQ(assetManager->GetMemoryBudget(AssetType::Texture), 64u * 1024 * 1024);
+		EXPECT_EQ(assetManager->GetResidentBytes(AssetType::Texture), 0u);
+	}
+	std::filesystem::remove(packPath);
+}
+
+TEST(RuntimeAssetManagerTest, EvictsLeastRecentlyUsed) {
+	std::cout << "\n=== Testing Runtime Budget Eviction ===" << std::endl;
+
+	if (!Log::GetCoreLogger())
+		Log::Init();
+
+	const std::filesystem::path packPath = WriteTestPack();
+	{
+		Ref<RuntimeAssetManager> assetManager = Ref<RuntimeAssetManager>::Create(packPath);
+		AssetImporter::RegisterSerializer(AssetType::Scene, CreateScope<TestAssetSerializer>());
+		assetManager->SetMemoryBudget(AssetType::Scene, 300);
+
+		Ref<Asset> referenced = assetManager->GetAsset(AssetHandle(3001));
+		ASSERT_TRUE(referenced);
+		ASSERT_TRUE(assetManager->GetAsset(AssetHandle(3002)));
+		ASSERT_TRUE(assetManager->GetAsset(AssetHandle(3003)));
+		EXPECT_EQ(assetManager->GetResidentBytes(AssetType::Scene), 300u);
+
+		// Over budget, the oldest unreferenced asset goes. The referenced one is older but stays.
+		ASSERT_TRUE(assetManager->GetAsset(AssetHandle(3004)));
+		EXPECT_EQ(assetManager->GetResidentBytes(AssetType::Scene), 300u);
+		EXPECT_TRUE(assetManager->IsAssetLoaded(AssetHandle(3001)));
+		EXPECT_FALSE(assetManager->IsAssetLoaded(AssetHandle(3002)));
+		EXPECT_TRUE(assetManager->IsAssetLoaded(AssetHandle(3003)));
+		EXPECT_TRUE(assetManager->IsAssetLoaded(AssetHandle(3004)));
+
+		// Using an asset makes it recent again
+		ASSERT_TRUE(assetManager->GetAsset(AssetHandle(3003)));
+		ASSERT_TRUE(assetManager->GetAsset(AssetHandle(3005)));
+		EXPECT_TRUE(assetManager->IsAssetLoaded(AssetHandle(3003)));
+		EXPECT_FALSE(assetManager->IsAssetLoaded(AssetHandle(3004)));
+		EXPECT_TRUE(assetManager->IsAssetLoaded(AssetHandle(3005)));
+		EXPECT_EQ(assetManager->GetAsset(AssetHandle(3001)), referenced);
+
+		// Lowering the budget takes effect on the next trim, referenced assets are never evicted
+		assetManager->SetMemoryBudget(AssetType::Scene, 50);
+		assetManager->TrimResidency();
+		EXPECT_TRUE(assetManager->IsAssetLoaded(AssetHandle(3001)));
+		EXPECT_FALSE(assetManager->IsAssetLoaded(AssetHandle(3003)));
+		EXPECT_FALSE(assetManager->IsAssetLoaded(AssetHandle(3005)));
+		EXPECT_EQ(assetManager->GetResidentBytes(AssetType::Scene), 100u);
+
+		referenced = nullptr;
+		assetManager->TrimResidency();
+		EXPECT_FALSE(assetManager->IsAssetLoaded(AssetHandle(3001)));
+		EXPECT_EQ(assetManager->GetResidentBytes(AssetType::Scene), 0u);
+
+		// Evicted assets load again from the pack
+		Ref<Asset> reloaded = assetManager->GetAsset(AssetHandle(3002));
+		ASSERT_TRUE(reloaded);
+		EXPECT_EQ(reloaded->Handle, AssetHandle(3002));
+		EXPECT_EQ(assetManager->GetResidentBytes(AssetType::Scene), 100u);
+	}
+	std::filesystem::remove(packPath);
+}
@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+#include "Zenith/Asset/TextureCooker.hpp"
+
+#include <stb/stb_image_write.h>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace Zenith;
+
+namespace {
+
+	// Smooth gradients with a little per-pixel variation, a typical case for block compression
+	TextureData CreateTestImage(uint32_t width, uint32_t height, bool alpha)
+	{
+		TextureData data;
+		data.Width = width;
+		data.Height = height;
+		data.Format = ImageFormat::RGBA;
+		data.ImageData.Allocate(width * height * 4);
+
+		uint8_t* pixels = data.ImageData.As<uint8_t>();
+		for (uint32_t y = 0; y < height; y++)
+		{
+			for (uint32_t x = 0; x < width; x++)
+			{
+				uint8_t* pixel = &pixels[(y * width + x) * 4];
+				pixel[0] = uint8_t(x * 255 / (width - 1));
+				pixel[1] = uint8_t(y * 255 / (height - 1));
+				pixel[2] = uint8_t(128 + 64 * std::sin(float(x + y) * 0.2f));
+				pixel[3] = alpha ? uint8_t((x * 4) & 0xff) : 255;
+			}
+		}
+		return data;
+	}
+
+	double GetPSNR(const TextureData& a, const TextureData& b, uint32_t channelCount)
+	{
+		double error = 0.0;
+		const uint8_t* pixelsA = a.ImageData.As<uint8_t>();
+		const uint8_t* pixelsB = b.ImageData.As<uint8_t>();
+		for (uint64_t i = 0; i < uint64_t(a.Width) * a.Height; i++)
+		{
+			for (uint32_t c = 0; c < channelCount; c++)
+			{
+				const double difference = double(pixelsA[i * 4 + c]) - double(pixelsB[i * 4 + c]);
+				error += difference * difference;
+			}
+		}
+
+		error /= double(a.Width) * a.Height * channelCount;
+		return error == 0.0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / error);
+	}
+
+}
+
+TEST(TextureCookerTest, FormatSelection) {
+	std::cout << "\n=== Testing Texture Cook Format Selection ===" << std::endl;
+
+	EXPECT_EQ(TextureCooker::SelectFormat(TextureUsage::Albedo, TextureCookQuality::Normal, false), ImageFormat::BC7);
+	EXPECT_EQ(TextureCooker::SelectFormat(TextureUsage::Albedo, TextureCookQuality::Fast, false), ImageFormat::BC1);
+	EXPECT_EQ(TextureCooker::SelectFormat(TextureUsage::Albedo, TextureCookQuality::Fast, true), ImageFormat::BC3);
+	EXPECT_EQ(TextureCooker::SelectFormat(TextureUsage::Albedo, TextureCookQuality::Normal, false, true), ImageFormat::BC7_SRGB);
+	EXPECT_EQ(TextureCooker::SelectFormat(TextureUsage::Albedo, TextureCookQuality::Fast, true, true), ImageFormat::BC3_SRGB);
+	EXPECT_EQ(TextureCooker::SelectFormat(TextureUsage::Albedo, TextureCookQuality::Uncompressed, false, true), ImageFormat::SRGBA);
+	EXPECT_EQ(TextureCooker::SelectFormat(TextureUsage::RoughnessMetal, TextureCookQuality::Normal, false, true), ImageFormat::BC7);
+	EXPECT_EQ(TextureCooker::SelectFormat(TextureUsage::Normal, TextureCookQuality::High, false), ImageFormat::BC5);
+	EXPECT_EQ(TextureCooker::SelectFormat(TextureUsage::Mask, TextureCookQuality::Normal, false), ImageFormat::BC4);
+	EXPECT_EQ(TextureCooker::SelectFormat(TextureUsage::HDR, TextureCookQuality::Normal, false), ImageFormat::BC6H);
+
+	EXPECT_EQ(TextureCooker::GetUsageFromPath("Textures/Brick_Normal.png"), TextureUsage::Normal);
+	EXPECT_EQ(TextureCooker::GetUsageFromPath("Textures/brick_n.png"), TextureUsage::Normal);
+	EXPECT_EQ(TextureCooker::GetUsageFromPath("Textures/Helmet_ORM.png"), TextureUsage::RoughnessMetal);
+	EXPECT_EQ(TextureCooker::GetUsageFromPath("Textures/Helmet_Roughness.jpg"), TextureUsage::RoughnessMetal);
+	EXPECT_EQ(TextureCooker::GetUsageFromPath("Textures/Sky.hdr"), TextureUsage::HDR);
+	EXPECT_EQ(TextureCooker::GetUsageFromPath("Textures/Brick_Albedo.png"), TextureUsage::Albedo);
+}
+
+TEST(TextureCookerTest, RoundTripQuality) {
+	std::cout << "\n=== Testing Texture Cook Round Trip ===" << std::endl;
+
+	struct Case
+	{
+		TextureUsage Usage;
+		TextureCookQuality Quality;
+		bool Alpha;
+		uint32_t Channels;
+		double MinPSNR;
+	};
+
+	const Case cases[] = {
+		{ TextureUsage::Albedo,         TextureCookQuality::Fast,   false, 3, 30.0 }, // BC1
+		{ TextureUsage::Albedo,         TextureCookQuality::Fast,   true,  4, 30.0 }, // BC3
+		{ TextureUsage::Albedo,         TextureCookQuality::Normal, true,  4, 35.0 }, // BC7
+		{ TextureUsage::RoughnessMetal, TextureCookQuality::High,   false, 3, 35.0 }, // BC7
+		{ TextureUsage::Normal,         TextureCookQuality::Normal, false, 2, 38.0 }, // BC5
+		{ TextureUsage::Mask,           TextureCookQuality::Normal, false, 1, 38.0 }, // BC4
+	};
+
+	for (const Case& test : cases)
+	{
+		// Odd size, so edge blocks are partial
+		TextureData source = CreateTestImage(70, 37, test.Alpha);
+		CookedTexture cooked = TextureCooker::Cook(source, test.Usage, test.Quality);
+		ASSERT_TRUE(cooked.IsValid());
+		EXPECT_EQ(cooked.Format, TextureCooker::SelectFormat(test.Usage, test.Quality, test.Alpha));
+		EXPECT_EQ(cooked.MipCount, 6u);
+
+		uint64_t expectedSize = 0;
+		for (uint32_t mip = 0; mip < cooked.MipCount; mip++)
+			expectedSize += Utils::GetImageMemorySize(cooked.Format, std::max(70u >> mip, 1u), std::max(37u >> mip, 1u));
+		EXPECT_EQ(cooked.Data.Size, expectedSize);
+
+		TextureData decompressed = TextureCooker::Decompress(cooked);
+		ASSERT_TRUE(decompressed.IsValid());
+		const double psnr = GetPSNR(source, decompressed, test.Channels);
+		std::cout << "Format " << (int)cooked.Format << ": " << psnr << " dB" << std::endl;
+		EXPECT_GT(psnr, test.MinPSNR);
+
+		source.ImageData.Release();
+		cooked.Data.Release();
+		decompressed.ImageData.Release();
+	}
+}
+
+TEST(TextureCookerTest, HighQualityIsNotWorse) {
+	std::cout << "\n=== Testing Texture Cook Quality Presets ===" << std::endl;
+
+	TextureData source = CreateTestImage(64, 64, false);
+	double previous = 0.0;
+	for (TextureCookQuality quality : { TextureCookQuality::Normal, TextureCookQuality::High })
+	{
+		CookedTexture cooked = TextureCooker::Cook(source, TextureUsage::RoughnessMetal, quality);
+		TextureData decompressed = TextureCooker::Decompress(cooked);
+		const double psnr = GetPSNR(source, decompressed, 3);
+		EXPECT_GE(psnr, previous - 0.01);
+		previous = psnr;
+		cooked.Data.Release();
+		decompressed.ImageData.Release();
+	}
+	source.ImageData.Release();
+}
+
+TEST(TextureCookerTest, HDRRoundTrip) {
+	std::cout << "\n=== Testing BC6H Round Trip ===" << std::endl;
+
+	TextureData source;
+	source.Width = 32;
+	source.Height = 32;
+	source.Format = ImageFormat::RGBA32F;
+	source.ImageData.Allocate(32 * 32 * 4 * sizeof(float));
+	// A sky-like intensity ramp over a slowly changing hue
+	float* pixels = source.ImageData.As<float>();
+	for (uint32_t i = 0; i < 32 * 32; i++)
+	{
+		const float intensity = 0.5f + float(i % 32) * 0.5f + float(i / 32) * 0.25f;
+		pixels[i * 4 + 0] = intensity * 0.4f;
+		pixels[i * 4 + 1] = intensity * (0.6f + float(i / 32) * 0.005f);
+		pixels[i * 4 + 2] = intensity;
+		pixels[i * 4 + 3] = 1.0f;
+	}
+
+	CookedTexture cooked = TextureCooker::Cook(source, TextureUsage::HDR);
+	ASSERT_TRUE(cooked.IsValid());
+	EXPECT_EQ(cooked.Format, ImageFormat::BC6H);
+
+	TextureData decompressed = TextureCooker::Decompress(cooked);
+	ASSERT_TRUE(decompressed.IsValid());
+	const float* result = decompressed.ImageData.As<float>();
+	double maxRelativeError = 0.0, totalRelativeError = 0.0;
+	for (uint32_t i = 0; i < 32 * 32 * 4; i++)
+	{
+		if (i % 4 == 3)
+			continue;
+		const double relativeError = std::abs(double(result[i]) - pixels[i]) / pixels[i];
+		maxRelativeError = std::max(maxRelativeError, relativeError);
+		totalRelativeError += relativeError;
+	}
+	const double meanRelativeError = totalRelativeError / (32 * 32 * 3);
+	std::cout << "Relative error: mean " << meanRelativeError << ", max " << maxRelativeError << std::endl;
+
+	// The cooker only writes single region blocks, blocks spanning a wide range lose some precision
+	EXPECT_LT(meanRelativeError, 0.02);
+	EXPECT_LT(maxRelativeError, 0.1);
+
+	source.ImageData.Release();
+	cooked.Data.Release();
+	decompressed.ImageData.Release();
+}
+
+TEST(TextureCookerTest, UncompressedMipChain) {
+	std::cout << "\n=== Testing Uncompressed Mip Chain ===" << std::endl;
+
+	TextureData source = CreateTestImage(70, 37, true);
+	CookedTexture cooked = TextureCooker::Cook(source, TextureUsage::Albedo, TextureCookQuality::Uncompressed);
+	ASSERT_TRUE(cooked.IsValid());
+	EXPECT_EQ(cooked.Format, ImageFormat::RGBA);
+	EXPECT_EQ(cooked.MipCount, 6u);
+
+	// The base level is the source, untouched
+	EXPECT_EQ(memcmp(cooked.Data.Data, source.ImageData.Data, source.ImageData.Size), 0);
+
+	// A flat color stays flat through the filter, including the partial edges of odd sizes
+	uint8_t* pixels = source.ImageData.As<uint8_t>();
+	for (uint32_t i = 0; i < 70 * 37; i++)
+	{
+		pixels[i * 4 + 0] = 200;
+		pixels[i * 4 + 1] = 100;
+		pixels[i * 4 + 2] = 30;
+		pixels[i * 4 + 3] = 255;
+	}
+	CookedTexture flat = TextureCooker::Cook(source, TextureUsage::Albedo, TextureCookQuality::Uncompressed);
+	const uint8_t* mips = flat.Data.As<uint8_t>();
+	for (uint64_t i = 0; i < flat.Data.Size; i += 4)
+	{
+		EXPECT_NEAR(mips[i + 0], 200, 1);
+		EXPECT_NEAR(mips[i + 1], 100, 1);
+		EXPECT_NEAR(mips[i + 2], 30, 1);
+		EXPECT_EQ(mips[i + 3], 255);
+	}
+
+	// sRGB sources keep their format, so sampling still decodes them
+	source.Format = ImageFormat::SRGBA;
+	CookedTexture srgb = TextureCooker::Cook(source, TextureUsage::Albedo, TextureCookQuality::Uncompressed);
+	EXPECT_EQ(srgb.Format, ImageFormat::SRGBA);
+	EXPECT_EQ(memcmp(srgb.Data.Data, flat.Data.Data, flat.Data.Size), 0);
+
+	source.ImageData.Release();
+	cooked.Data.Release();
+	flat.Data.Release();
+	srgb.Data.Release();
+}
+
+TEST(TextureCookerTest, CookedResultIsCached) {
+	std::cout << "\n=== Testing Cooked Texture Cache ===" << std::endl;
+
+	TextureData image = CreateTestImage(40, 24, false);
+	std::vector<uint8_t> png;
+	stbi_write_png_to_func([](void* context, void* data, int size)
+	{
+		auto* out = static_cast<std::vector<uint8_t>*>(context);
+		out->insert(out->end(), static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
+	}, &png, 40, 24, 4, image.ImageData.Data, 40 * 4);
+	image.ImageData.Release();
+
+	CookedTexture first = TextureCooker::CookFromMemory(Buffer(png.data(), png.size()), TextureUsage::Albedo);
+	ASSERT_TRUE(first.IsValid());
+	ASSERT_TRUE(std::filesystem::exists(TextureCooker::GetCacheDirectory()));
+
+	CookedTexture second = TextureCooker::CookFromMemory(Buffer(png.data(), png.size()), TextureUsage::Albedo);
+	ASSERT_TRUE(second.IsValid());
+	EXPECT_EQ(second.Format, first.Format);
+	EXPECT_EQ(second.MipCount, first.MipCount);
+	ASSERT_EQ(second.Data.Size, first.Data.Size);
+	EXPECT_EQ(memcmp(second.Data.Data, first.Data.Data, first.Data.Size), 0);
+
+	// Different settings are cached separately
+	CookedTexture mask = TextureCooker::CookFromMemory(Buffer(png.data(), png.size()), TextureUsage::Mask);
+	EXPECT_EQ(mask.Format, ImageFormat::BC4);
+
+	// Streamed textures start with the small mips, the rest stays in the cache file
+	CookedTexture streamed = TextureCooker::CookFromMemory(Buffer(png.data(), png.size()), TextureUsage::Mask, TextureCookQuality::Normal, 10);
+	ASSERT_TRUE(streamed.IsValid());
+	EXPECT_EQ(streamed.FirstMip, 2u);
+	EXPECT_EQ(streamed.FilePath.extension(), ".ktx2");
+	EXPECT_TRUE(std::filesystem::exists(streamed.FilePath));
+
+	first.Data.Release();
+	second.Data.Release();
+	mask.Data.Release();
+	streamed.Data.Release();
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "Zenith/Asset/TextureImporter.hpp"
+
+#include <stb/stb_image_write.h>
+
+#include <iostream>
+#include <vector>
+
+using namespace Zenith;
+
+namespace {
+
+	// Encodes a PNG where every pixel stores its own row and column
+	std::vector<uint8_t> EncodeTestPNG(uint32_t width, uint32_t height, uint8_t seed)
+	{
+		std::vector<uint8_t> pixels(width * height * 4);
+		for (uint32_t y = 0; y < height; y++)
+		{
+			for (uint32_t x = 0; x < width; x++)
+			{
+				uint8_t* pixel = &pixels[(y * width + x) * 4];
+				pixel[0] = uint8_t(y);
+				pixel[1] = uint8_t(x);
+				pixel[2] = seed;
+				pixel[3] = 255;
+			}
+		}
+
+		std::vector<uint8_t> png;
+		stbi_write_png_to_func([](void* context, void* data, int size)
+		{
+			auto* out = static_cast<std::vector<uint8_t>*>(context);
+			out->insert(out->end(), static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
+		}, &png, (int)width, (int)height, 4, pixels.data(), (int)width * 4);
+		return png;
+	}
+
+}
+
+TEST(TextureImporterTest, DecodeIsFlipped) {
+	std::cout << "\n=== Testing Texture Decode Orientation ===" << std::endl;
+
+	std::vector<uint8_t> png = EncodeTestPNG(3, 5, 0);
+	TextureData data = TextureImporter::LoadTextureData(Buffer(png.data(), png.size()), ImageFormat::SRGBA);
+	ASSERT_TRUE(data.IsValid());
+	EXPECT_EQ(data.Width, 3u);
+	EXPECT_EQ(data.Height, 5u);
+	EXPECT_EQ(data.Format, ImageFormat::SRGBA);
+
+	// Bottom row first
+	const uint8_t* pixels = data.ImageData.As<uint8_t>();
+	EXPECT_EQ(pixels[0], 4);
+	EXPECT_EQ(pixels[(4 * 3 + 2) * 4], 0);
+	EXPECT_EQ(pixels[(4 * 3 + 2) * 4 + 1], 2);
+	data.ImageData.Release();
+}
+
+TEST(TextureImporterTest, ParallelDecodeMatchesSerial) {
+	std::cout << "\n=== Testing Parallel Texture Decode ===" << std::endl;
+
+	std::vector<std::vector<uint8_t>> images;
+	for (uint8_t i = 0; i < 32; i++)
+		images.push_back(EncodeTestPNG(16 + i, 8 + i, i));
+
+	std::vector<TextureDecodeRequest> requests(images.size());
+	for (size_t i = 0; i < images.size(); i++)
+		requests[i].EncodedData = Buffer(images[i].data(), images[i].size());
+
+	std::vector<TextureData> results = TextureImporter::LoadTextureDataParallel(requests);
+	ASSERT_EQ(results.size(), images.size());
+	for (size_t i = 0; i < images.size(); i++)
+	{
+		TextureData serial = TextureImporter::LoadTextureData(requests[i].EncodedData);
+		ASSERT_TRUE(results[i].IsValid());
+		ASSERT_EQ(results[i].ImageData.Size, serial.ImageData.Size);
+		EXPECT_EQ(memcmp(results[i].ImageData.Data, serial.ImageData.Data, serial.ImageData.Size), 0);
+		serial.ImageData.Release();
+		results[i].ImageData.Release();
+	}
+}
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include "Zenith/Asset/AssetRegistry.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace Zenith;
+
+namespace {
+
+	std::filesystem::path MakeAssetPath(int64_t index)
+	{
+		return "Assets/Folder" + std::to_string(index % 256) + "/Asset" + std::to_string(index) + ".zmat";
+	}
+
+	void FillRegistry(AssetRegistry& registry, int64_t count)
+	{
+		for (int64_t i = 1; i <= count; i++)
+		{
+			AssetMetadata metadata;
+			metadata.Handle = AssetHandle((uint64_t)i);
+			metadata.Type = AssetType::Material;
+			metadata.FilePath = MakeAssetPath(i);
+			registry.Set(metadata.Handle, metadata);
+		}
+	}
+
+}
+
+static void BM_AssetRegistry_GetHandle(benchmark::State& state)
+{
+	AssetRegistry registry;
+	FillRegistry(registry, state.range(0));
+
+	std::vector<std::filesystem::path> queries;
+	for (int64_t i = 0; i < 1024; i++)
+		queries.push_back(MakeAssetPath(1 + (i * 7919) % state.range(0)));
+
+	size_t query = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(registry.GetHandle(queries[query]));
+		query = (query + 1) % queries.size();
+	}
+}
+BENCHMARK(BM_AssetRegistry_GetHandle)->Arg(1000)->Arg(100000);
+
+// The lookup GetAssetHandleFromFilePath() used before the path index existed
+static void BM_AssetRegistry_LinearScan(benchmark::State& state)
+{
+	AssetRegistry registry;
+	FillRegistry(registry, state.range(0));
+
+	const std::filesystem::path query = MakeAssetPath(state.range(0) / 2);
+	for (auto _ : state)
+	{
+		AssetHandle result = AssetHandle::null();
+		for (const auto& [handle, metadata] : registry)
+		{
+			if (metadata.FilePath == query)
+			{
+				result = handle;
+				break;
+			}
+		}
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_AssetRegistry_LinearScan)->Arg(1000)->Arg(100000);
+
+static void BM_AssetRegistry_Set(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		AssetRegistry registry;
+		FillRegistry(registry, state.range(0));
+		benchmark::DoNotOptimize(registry.Count());
+	}
+}
+BENCHMARK(BM_AssetRegistry_Set)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include "Zenith/Core/Hash.hpp"
+
+#include <iostream>
+#include <string>
+
+using namespace Zenith;
+
+TEST(HashTest, XXHash64ReferenceValues) {
+	std::cout << "\n=== Testing XXHash64 Reference Values ===" << std::endl;
+
+	EXPECT_EQ(XXHash64::compute(""), 0xef46db3751d8e999ull);
+	EXPECT_EQ(XXHash64::compute("a"), 0xd24ec4f1a98c6e5bull);
+	EXPECT_EQ(XXHash64::compute("abc"), 0x44bc2cf5ad770999ull);
+}
+
+TEST(HashTest, XXHash64Streaming) {
+	std::cout << "\n=== Testing XXHash64 Streaming ===" << std::endl;
+
+	std::string data;
+	for (int i = 0; i < 1000; i++)
+		data += char('a' + i % 26);
+
+	const uint64_t expected = XXHash64::compute(data);
+	for (size_t chunkSize : { 1, 7, 31, 32, 33, 100 })
+	{
+		XXHash64 hash;
+		for (size_t offset = 0; offset < data.size(); offset += chunkSize)
+			hash.update(std::string_view(data).substr(offset, chunkSize));
+		EXPECT_EQ(hash.finalize(), expected) << "chunk size " << chunkSize;
+	}
+
+	EXPECT_NE(XXHash64::compute(data, 1), expected);
+}
@@ -0,0 +1,357 @@
+#include <gtest/gtest.h>
+#include "Zenith/Core/Application.hpp"
+#include "Zenith/Renderer/API/Vulkan/VulkanBindlessDescriptors.hpp"
+#include "Zenith/Renderer/API/Vulkan/VulkanContext.hpp"
+#include "Zenith/Renderer/API/Vulkan/VulkanMaterial.hpp"
+#include "Zenith/Renderer/Framebuffer.hpp"
+#include "Zenith/Renderer/Material.hpp"
+#include "Zenith/Renderer/Mesh.hpp"
+#include "Zenith/Renderer/MeshPool.hpp"
+#include "Zenith/Renderer/Pipeline.hpp"
+#include "Zenith/Renderer/RenderCommandBuffer.hpp"
+#include "Zenith/Renderer/RenderPass.hpp"
+#include "Zenith/Renderer/Renderer.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <nfd.hpp>
+#include <vulkan/vulkan.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+using namespace Zenith;
+
+// Starts the engine without a window on whatever Vulkan 1.2 device with descriptor indexing is around, lavapipe on
+// machines without a GPU, and draws BasicMesh.glsl with two materials the way MeshRenderer does: the render pass binds
+// the pipeline and the draws go through RenderMeshesIndirect without binding it again.
+
+namespace {
+
+	constexpr uint32_t TargetSize = 32;
+
+	// DrawData of BasicMesh.glsl
+	struct TestSceneData
+	{
+		glm::mat4 ViewProjection;
+		glm::vec4 CameraPosition;
+	};
+
+	struct TestInstanceData
+	{
+		glm::mat4 Model;
+		glm::mat4 NormalMatrix;
+		glm::vec4 DequantizeScale;
+		glm::vec4 DequantizeOffset;
+	};
+
+	// What the engine needs to come up headless: the offscreen SDL driver's surface, the features VulkanDevice
+	// enables for bindless materials and the file dialogs Application initializes
+	bool CanStartHeadless(std::string& reason)
+	{
+		uint32_t extensionCount = 0;
+		vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, nullptr);
+		std::vector<VkExtensionProperties> extensions(extensionCount);
+		vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, extensions.data());
+
+		bool headlessSurface = false;
+		for (const VkExtensionProperties& extension : extensions)
+			headlessSurface |= strcmp(extension.extensionName, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME) == 0;
+		if (!headlessSurface)
+		{
+			reason = "No Vulkan driver with headless surfaces";
+			return false;
+		}
+
+		VkApplicationInfo appInfo = { VK_STRUCTURE_TYPE_APPLICATION_INFO };
+		appInfo.pApplicationName = "ZenithTests";
+		appInfo.apiVersion = VK_API_VERSION_1_2;
+
+		VkInstanceCreateInfo instanceInfo = { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
+		instanceInfo.pApplicationInfo = &appInfo;
+		VkInstance instance = nullptr;
+		if (vkCreateInstance(&instanceInfo, nullptr, &instance) != VK_SUCCESS)
+		{
+			reason = "No Vulkan driver";
+			return false;
+		}
+
+		uint32_t deviceCount = 0;
+		vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
+		std::vector<VkPhysicalDevice> physicalDevices(deviceCount);
+		vkEnumeratePhysicalDevices(instance, &deviceCount, physicalDevices.data());
+
+		bool bindlessDevice = false;
+		for (VkPhysicalDevice physicalDevice : physicalDevices)
+		{
+			VkPhysicalDeviceProperties properties;
+			vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+			if (properties.apiVersion < VK_API_VERSION_1_2)
+				continue;
+
+			VkPhysicalDeviceDescriptorIndexingFeatures indexing = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES };
+			VkPhysicalDeviceFeatures2 features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+			features.pNext = &indexing;
+			vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+			bindlessDevice |= indexing.runtimeDescriptorArray && indexing.descriptorBindingPartiallyBound && indexing.descriptorBindingSampledImageUpdateAfterBind
+				&& indexing.descriptorBindingUpdateUnusedWhilePending && indexing.shaderSampledImageArrayNonUniformIndexing;
+		}
+		vkDestroyInstance(instance, nullptr);
+
+		if (!bindlessDevice)
+		{
+			reason = "No Vulkan 1.2 device with descriptor indexing";
+			return false;
+		}
+
+		if (NFD::Init() != NFD_OKAY)
+		{
+			reason = "No file dialog backend";
+			return false;
+		}
+		NFD::Quit();
+		return true;
+	}
+
+	// Quad from (0, -1) to (1, 1) facing the camera, moved into place by the instance's model matrix
+	Ref<MeshSource> CreateQuad()
+	{
+		std::vector<Vertex> vertices(4);
+		vertices[0].Position = { 0.0f, -1.0f, 0.5f };
+		vertices[1].Position = { 1.0f, -1.0f, 0.5f };
+		vertices[2].Position = { 1.0f, 1.0f, 0.5f };
+		vertices[3].Position = { 0.0f, 1.0f, 0.5f };
+		vertices[0].Texcoord = { 0.0f, 0.0f };
+		vertices[1].Texcoord = { 1.0f, 0.0f };
+		vertices[2].Texcoord = { 1.0f, 1.0f };
+		vertices[3].Texcoord = { 0.0f, 1.0f };
+
+		return Ref<MeshSource>::Create(vertices, std::vector<uint32_t>{ 0, 1, 2, 2, 3, 0 });
+	}
+
+	Ref<Texture2D> CreateSolidTexture(uint32_t color)
+	{
+		TextureSpecification spec;
+		spec.Format = ImageFormat::RGBA;
+		spec.GenerateMips = false;
+		spec.DebugName = "BindlessDrawTest-Texture";
+		return Texture2D::Create(spec, Buffer(&color, sizeof(color)));
+	}
+
+	class BindlessDrawLayer : public Layer
+	{
+	public:
+		BindlessDrawLayer(Application& application)
+			: Layer("BindlessDrawTest"), m_Application(application)
+		{
+		}
+
+		void OnAttach() override
+		{
+			m_CommandBuffer = RenderCommandBuffer::Create(0, "BindlessDrawTest");
+
+			FramebufferSpecification fbSpec;
+			fbSpec.SwapChainTarget = false;
+			fbSpec.Width = TargetSize;
+			fbSpec.Height = TargetSize;
+			fbSpec.ClearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+			fbSpec.DepthClearValue = 1.0f;
+			fbSpec.ClearColorOnLoad = true;
+			fbSpec.ClearDepthOnLoad = true;
+			fbSpec.DebugName = "BindlessDrawTest";
+			fbSpec.Attachments = FramebufferAttachmentSpecification{
+				{ ImageFormat::RGBA },
+				{ ImageFormat::DEPTH24STENCIL8 }
+			};
+			m_Framebuffer = Framebuffer::Create(fbSpec);
+
+			Ref<Shader> shader = Renderer::GetShaderLibrary()->Get("BasicMesh");
+
+			// Same as MeshRenderer's pipeline for standard vertices
+			PipelineSpecification pipelineSpec;
+			pipelineSpec.DebugName = "BindlessDrawTest";
+			pipelineSpec.Shader = shader;
+			pipelineSpec.TargetFramebuffer = m_Framebuffer;
+			pipelineSpec.Layout = VertexBufferLayout({
+				{ ShaderDataType::Float3, "Position" },
+				{ ShaderDataType::Float3, "Normal" },
+				{ ShaderDataType::Float3, "Tangent" },
+				{ ShaderDataType::Float2, "TexCoord" }
+			}, sizeof(Vertex));
+			pipelineSpec.BackfaceCulling = false;
+			pipelineSpec.DepthTest = true;
+			pipelineSpec.DepthWrite = true;
+			pipelineSpec.DepthOperator = DepthCompareOperator::LessOrEqual;
+			pipelineSpec.Topology = PrimitiveTopology::Triangles;
+			m_Pipeline = Pipeline::Create(pipelineSpec);
+
+			RenderPassSpecification renderPassSpec;
+			renderPassSpec.DebugName = "BindlessDrawTest";
+			renderPassSpec.Pipeline = m_Pipeline;
+			m_RenderPass = RenderPass::Create(renderPassSpec);
+
+			m_GreenTexture = CreateSolidTexture(0xff00ff00);
+
+			// Red from the color, green from the texture
+			m_RedMaterial = Material::Create(shader, "BindlessDrawTest-Red");
+			m_RedMaterial->Set("u_AlbedoColor", glm::vec3(1.0f, 0.0f, 0.0f));
+			m_RedMaterial->Set("u_Shininess", 256.0f);
+			m_RedMaterial->Set("u_AlbedoTexture", Renderer::GetWhiteTexture());
+
+			m_GreenMaterial = Material::Create(shader, "BindlessDrawTest-Green");
+			m_GreenMaterial->Set("u_AlbedoColor", glm::vec3(1.0f));
+			m_GreenMaterial->Set("u_Shininess", 256.0f);
+			m_GreenMaterial->Set("u_AlbedoTexture", m_GreenTexture);
+
+			m_Quad = CreateQuad();
+			m_MeshPool = MeshPool::Create();
+		}
+
+		void OnDetach() override
+		{
+			m_MeshPool->Remove(m_Quad->Handle);
+			m_MeshPool = nullptr;
+			m_Quad = nullptr;
+			m_RedMaterial = nullptr;
+			m_GreenMaterial = nullptr;
+			m_GreenTexture = nullptr;
+			m_RenderPass = nullptr;
+			m_Pipeline = nullptr;
+			m_Framebuffer = nullptr;
+			m_CommandBuffer = nullptr;
+		}
+
+		void OnUpdate(Timestep ts) override
+		{
+			const MeshPool::MeshRange range = m_MeshPool->GetOrAdd(m_Quad->Handle, m_Quad);
+			ASSERT_TRUE(range);
+
+			m_CommandBuffer->Begin();
+			Renderer::BeginRenderPass(m_CommandBuffer, m_RenderPass, true);
+
+			// Left half red, right half green
+			DrawQuad(range, -1.0f, m_RedMaterial);
+			DrawQuad(range, 0.0f, m_GreenMaterial);
+
+			Renderer::EndRenderPass(m_CommandBuffer);
+			m_CommandBuffer->End();
+			m_CommandBuffer->Submit();
+
+			// Every frame in flight has drawn once the last ones recorded run
+			if (++m_FrameCount == Renderer::GetConfig().FramesInFlight * 2)
+				m_Application.Close();
+		}
+
+		Ref<Framebuffer> GetFramebuffer() const { return m_Framebuffer; }
+		Ref<Material> GetRedMaterial() const { return m_RedMaterial; }
+		Ref<Material> GetGreenMaterial() const { return m_GreenMaterial; }
+
+	private:
+		void DrawQuad(const MeshPool::MeshRange& range, float x, const Ref<Material>& material)
+		{
+			TestSceneData sceneData;
+			sceneData.ViewProjection = glm::mat4(1.0f);
+			sceneData.CameraPosition = glm::vec4(0.0f, 0.0f, 5.0f, 0.0f);
+
+			TestInstanceData instance;
+			instance.Model = glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, 0.0f));
+			instance.NormalMatrix = glm::mat4(1.0f);
+			instance.DequantizeScale = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
+			instance.DequantizeOffset = glm::vec4(0.0f);
+
+			std::vector<DrawIndexedIndirectCommand> commands = { { 6, 1, range.FirstIndex, (int32_t)range.FirstVertex, 0 } };
+			Renderer::RenderMeshesIndirect(m_CommandBuffer, m_Pipeline, m_MeshPool, VertexFormat::Standard, m_Quad->GetIndexType(), std::move(commands), material,
+				Buffer(&sceneData, sizeof(TestSceneData)), Buffer(&instance, sizeof(TestInstanceData)), sizeof(TestInstanceData));
+		}
+
+		Application& m_Application;
+		uint32_t m_FrameCount = 0;
+
+		Ref<RenderCommandBuffer> m_CommandBuffer;
+		Ref<Framebuffer> m_Framebuffer;
+		Ref<Pipeline> m_Pipeline;
+		Ref<RenderPass> m_RenderPass;
+		Ref<Texture2D> m_GreenTexture;
+		Ref<Material> m_RedMaterial;
+		Ref<Material> m_GreenMaterial;
+		Ref<MeshSource> m_Quad;
+		Ref<MeshPool> m_MeshPool;
+	};
+
+}
+
+TEST(BindlessDrawTest, MaterialsDrawThroughRenderPass) {
+	std::cout << "\n=== Testing Bindless Material Draws ===" << std::endl;
+
+	std::string reason;
+	if (!CanStartHeadless(reason))
+		GTEST_SKIP() << reason;
+
+	const std::filesystem::path workingDirectory = std::filesystem::current_path();
+	setenv("SDL_VIDEO_DRIVER", "offscreen", 1);
+	InitializeCore();
+
+	Buffer pixels;
+	bool bindless = false;
+	{
+		ApplicationSpecification spec;
+		spec.Name = "BindlessDrawTest";
+		spec.WindowWidth = TargetSize;
+		spec.WindowHeight = TargetSize;
+		spec.VSync = false;
+		spec.StartMaximized = false;
+		spec.EnableImGui = false;
+		spec.ShowSplashScreen = false;
+		spec.CoreThreadingPolicy = ThreadingPolicy::SingleThreaded;
+		spec.WorkingDirectory = ZN_TEST_EDITOR_DIRECTORY;
+
+		Application application(spec);
+		bindless = VulkanBindlessDescriptors::IsEnabled();
+		if (bindless)
+		{
+			auto layer = std::make_shared<BindlessDrawLayer>(application);
+			application.PushLayer(layer);
+
+			const uint32_t redIndex = layer->GetRedMaterial().As<VulkanMaterial>()->GetBindlessIndex();
+			const uint32_t greenIndex = layer->GetGreenMaterial().As<VulkanMaterial>()->GetBindlessIndex();
+			EXPECT_NE(redIndex, VulkanBindlessDescriptors::InvalidIndex);
+			EXPECT_NE(greenIndex, VulkanBindlessDescriptors::InvalidIndex);
+			EXPECT_NE(redIndex, greenIndex);
+
+			// Every registration of the white texture shares its fixed slot
+			const uint32_t whiteIndex = VulkanBindlessDescriptors::RegisterTexture(Renderer::GetWhiteTexture());
+			EXPECT_EQ(whiteIndex, VulkanBindlessDescriptors::WhiteTextureIndex);
+			VulkanBindlessDescriptors::UnregisterTexture(whiteIndex);
+
+			application.Run();
+
+			vkDeviceWaitIdle(VulkanContext::GetCurrentDevice()->GetVulkanDevice());
+			layer->GetFramebuffer()->GetImage(0)->CopyToHostBuffer(pixels);
+
+			application.PopLayer(layer);
+		}
+	}
+	ShutdownCore();
+	std::filesystem::current_path(workingDirectory);
+
+	if (!bindless)
+		GTEST_SKIP() << "Bindless materials are disabled";
+
+	ASSERT_EQ(pixels.Size, TargetSize * TargetSize * 4);
+	const uint8_t* left = pixels.As<uint8_t>() + (TargetSize / 2 * TargetSize + TargetSize / 4) * 4;
+	const uint8_t* right = pixels.As<uint8_t>() + (TargetSize / 2 * TargetSize + TargetSize * 3 / 4) * 4;
+
+	// Ambient plus diffuse of the light at (10, 10, 10) is about 0.77
+	EXPECT_GT(left[0], 150);
+	EXPECT_LT(left[1], 30);
+	EXPECT_LT(left[2], 30);
+
+	EXPECT_LT(right[0], 30);
+	EXPECT_GT(right[1], 150);
+	EXPECT_LT(right[2], 30);
+
+	pixels.Release();
+}
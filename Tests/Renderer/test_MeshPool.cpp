@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "Zenith/Renderer/MeshPool.hpp"
+
+#include <iostream>
+
+using namespace Zenith;
+
+TEST(MeshPoolTest, ArenaGrowsByDoubling) {
+	std::cout << "\n=== Testing Mesh Pool Arena Growth ===" << std::endl;
+
+	MeshPoolArena arena(1024);
+	EXPECT_EQ(arena.GetCapacity(), 0u);
+
+	EXPECT_EQ(arena.Allocate(600, 4), 0u);
+	EXPECT_EQ(arena.GetCapacity(), 1024u);
+
+	EXPECT_EQ(arena.Allocate(600, 4), 600u);
+	EXPECT_EQ(arena.GetSize(), 1200u);
+	EXPECT_EQ(arena.GetCapacity(), 2048u);
+
+	// Larger than double the capacity
+	EXPECT_EQ(arena.Allocate(8000, 4), 1200u);
+	EXPECT_EQ(arena.GetCapacity(), 9200u);
+}
+
+TEST(MeshPoolTest, ArenaAlignsToElements) {
+	std::cout << "\n=== Testing Mesh Pool Arena Alignment ===" << std::endl;
+
+	MeshPoolArena arena(1024);
+	EXPECT_EQ(arena.Allocate(10, 2), 0u);
+
+	// 20 byte vertices after 10 bytes of indices start at the next whole vertex
+	const uint64_t offset = arena.Allocate(40, 20);
+	EXPECT_EQ(offset, 20u);
+	EXPECT_EQ(arena.GetSize(), 60u);
+
+	// The gap in front of it is handed out again
+	EXPECT_EQ(arena.Allocate(8, 2), 10u);
+}
+
+TEST(MeshPoolTest, ArenaReusesFreedRanges) {
+	std::cout << "\n=== Testing Mesh Pool Arena Reuse ===" << std::endl;
+
+	MeshPoolArena arena(1024);
+	const uint64_t a = arena.Allocate(100, 4);
+	const uint64_t b = arena.Allocate(100, 4);
+	const uint64_t c = arena.Allocate(100, 4);
+	EXPECT_EQ(arena.GetSize(), 300u);
+
+	arena.Free(b, 100);
+	EXPECT_EQ(arena.GetSize(), 300u);
+	EXPECT_EQ(arena.Allocate(60, 4), b);
+	EXPECT_EQ(arena.Allocate(40, 4), b + 60);
+	EXPECT_EQ(arena.GetSize(), 300u);
+
+	// Neighbours merge, a free tail shortens the arena
+	arena.Free(b, 60);
+	arena.Free(b + 60, 40);
+	arena.Free(a, 100);
+	EXPECT_EQ(arena.Allocate(200, 4), a);
+
+	arena.Free(a, 200);
+	arena.Free(c, 100);
+	EXPECT_EQ(arena.GetSize(), 0u);
+	EXPECT_EQ(arena.GetFreeBytes(), arena.GetCapacity());
+}
+
+TEST(MeshPoolTest, ArenaDoesNotGrowWhileRecycling) {
+	std::cout << "\n=== Testing Mesh Pool Arena Churn ===" << std::endl;
+
+	MeshPoolArena arena(4096);
+	const uint64_t keep = arena.Allocate(1000, 4);
+
+	// Meshes streaming in and out through the same space
+	for (uint32_t i = 0; i < 1000; i++)
+	{
+		const uint64_t size = 100 + (i % 7) * 100;
+		const uint64_t offset = arena.Allocate(size, 4);
+		arena.Free(offset, size);
+	}
+
+	EXPECT_EQ(keep, 0u);
+	EXPECT_EQ(arena.GetSize(), 1000u);
+	EXPECT_EQ(arena.GetCapacity(), 4096u);
+}
+
+TEST(MeshPoolTest, BatchesFitInstanceLimit) {
+	std::cout << "\n=== Testing Indirect Draw Batching ===" << std::endl;
+
+	// IndexCount, InstanceCount, FirstIndex, VertexOffset, FirstInstance
+	std::vector<DrawIndexedIndirectCommand> commands = {
+		{ 36, 1, 0, 0, 0 },
+		{ 36, 2, 36, 0, 1 },
+		{ 96, 1, 72, 24, 3 },
+		{ 96, 3, 72, 24, 4 },
+		{ 12, 1, 168, 48, 8 },
+	};
+
+	std::vector<MeshPool::IndirectBatch> batches = MeshPool::SplitIntoBatches(commands, 4);
+	ASSERT_EQ(batches.size(), 3u);
+
+	EXPECT_EQ(batches[0].FirstCommand, 0u);
+	EXPECT_EQ(batches[0].CommandCount, 3u);
+	EXPECT_EQ(batches[0].FirstInstance, 0u);
+	EXPECT_EQ(batches[0].InstanceCount, 4u);
+
+	EXPECT_EQ(batches[1].FirstCommand, 3u);
+	EXPECT_EQ(batches[1].CommandCount, 1u);
+	EXPECT_EQ(batches[1].FirstInstance, 4u);
+	EXPECT_EQ(batches[1].InstanceCount, 3u);
+
+	EXPECT_EQ(batches[2].FirstCommand, 4u);
+	EXPECT_EQ(batches[2].CommandCount, 1u);
+	EXPECT_EQ(batches[2].FirstInstance, 8u);
+	EXPECT_EQ(batches[2].InstanceCount, 1u);
+
+	// Instances are relative to their batch's draw data
+	EXPECT_EQ(commands[1].FirstInstance, 1u);
+	EXPECT_EQ(commands[2].FirstInstance, 3u);
+	EXPECT_EQ(commands[3].FirstInstance, 0u);
+	EXPECT_EQ(commands[4].FirstInstance, 0u);
+
+	// Nothing else changes
+	EXPECT_EQ(commands[3].IndexCount, 96u);
+	EXPECT_EQ(commands[3].InstanceCount, 3u);
+	EXPECT_EQ(commands[3].VertexOffset, 24);
+}
+
+TEST(MeshPoolTest, SingleBatchWhenEverythingFits) {
+	std::cout << "\n=== Testing Indirect Draw Single Batch ===" << std::endl;
+
+	std::vector<DrawIndexedIndirectCommand> commands;
+	for (uint32_t i = 0; i < 100; i++)
+		commands.push_back({ 3, 1, i * 3, 0, i });
+
+	std::vector<MeshPool::IndirectBatch> batches = MeshPool::SplitIntoBatches(commands, 1000);
+	ASSERT_EQ(batches.size(), 1u);
+	EXPECT_EQ(batches[0].CommandCount, 100u);
+	EXPECT_EQ(batches[0].InstanceCount, 100u);
+	EXPECT_EQ(commands[99].FirstInstance, 99u);
+
+	EXPECT_TRUE(MeshPool::SplitIntoBatches({}, 1000).empty());
+}
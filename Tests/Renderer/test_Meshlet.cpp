@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include "Zenith/Renderer/Meshlet.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <iostream>
+
+using namespace Zenith;
+
+namespace {
+
+	struct TestVertex
+	{
+		glm::vec3 Position;
+		glm::vec3 Normal;
+	};
+
+	// Flat grid of quads in the XY plane facing +Z, centered at the origin
+	void BuildGrid(uint32_t quadsPerSide, std::vector<TestVertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		const uint32_t verticesPerSide = quadsPerSide + 1;
+		const float halfSize = quadsPerSide * 0.5f;
+
+		for (uint32_t y = 0; y < verticesPerSide; y++)
+			for (uint32_t x = 0; x < verticesPerSide; x++)
+				vertices.push_back({ { x - halfSize, y - halfSize, 0.0f }, { 0.0f, 0.0f, 1.0f } });
+
+		for (uint32_t y = 0; y < quadsPerSide; y++)
+		{
+			for (uint32_t x = 0; x < quadsPerSide; x++)
+			{
+				uint32_t i0 = y * verticesPerSide + x;
+				uint32_t i1 = i0 + 1;
+				uint32_t i2 = i0 + verticesPerSide;
+				uint32_t i3 = i2 + 1;
+				indices.insert(indices.end(), { i0, i1, i3, i0, i3, i2 });
+			}
+		}
+	}
+
+	std::vector<Meshlet> BuildGridMeshlets(std::vector<TestVertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		BuildGrid(32, vertices, indices);
+		return MeshletBuilder::Build(indices, &vertices[0].Position, &vertices[0].Normal,
+			(uint32_t)vertices.size(), sizeof(TestVertex));
+	}
+
+	std::vector<std::array<uint32_t, 3>> SortedTriangles(const std::vector<uint32_t>& indices)
+	{
+		std::vector<std::array<uint32_t, 3>> triangles;
+		for (size_t i = 0; i < indices.size(); i += 3)
+			triangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	glm::mat4 ViewProjection(const glm::vec3& eye, const glm::vec3& target, float fovDegrees = 60.0f)
+	{
+		return glm::perspective(glm::radians(fovDegrees), 1.0f, 0.1f, 1000.0f) * glm::lookAt(eye, target, { 0.0f, 1.0f, 0.0f });
+	}
+
+}
+
+TEST(MeshletTest, BuilderRespectsLimits) {
+	std::cout << "\n=== Testing Meshlet Builder Limits ===" << std::endl;
+
+	std::vector<TestVertex> vertices;
+	std::vector<uint32_t> indices;
+	BuildGrid(32, vertices, indices);
+	auto originalTriangles = SortedTriangles(indices);
+
+	MeshletBuildSettings settings;
+	auto meshlets = MeshletBuilder::Build(indices, &vertices[0].Position, &vertices[0].Normal,
+		(uint32_t)vertices.size(), sizeof(TestVertex), settings);
+
+	std::cout << "Triangles: " << indices.size() / 3 << ", meshlets: " << meshlets.size() << std::endl;
+	ASSERT_FALSE(meshlets.empty());
+
+	uint32_t expectedOffset = 0;
+	for (const Meshlet& meshlet : meshlets)
+	{
+		EXPECT_EQ(meshlet.IndexOffset, expectedOffset);
+		EXPECT_EQ(meshlet.IndexCount % 3, 0u);
+		EXPECT_LE(meshlet.IndexCount / 3, settings.MaxTriangles);
+		EXPECT_LE(meshlet.VertexCount, settings.MaxVertices);
+		EXPECT_GT(meshlet.Radius, 0.0f);
+		expectedOffset += meshlet.IndexCount;
+	}
+	EXPECT_EQ(expectedOffset, (uint32_t)indices.size());
+
+	// Reordering must keep every triangle (and its winding) intact
+	EXPECT_EQ(SortedTriangles(indices), originalTriangles);
+
+	std::cout << "All meshlets within limits and all triangles preserved" << std::endl;
+}
+
+TEST(MeshletTest, RejectsOutOfRangeIndices) {
+	std::cout << "\n=== Testing Out Of Range Indices ===" << std::endl;
+
+	std::vector<glm::vec3> positions = { { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } };
+	std::vector<uint32_t> indices = { 0, 1, 5 };
+
+	auto meshlets = MeshletBuilder::Build(indices, positions.data(), nullptr, (uint32_t)positions.size(), sizeof(glm::vec3));
+	EXPECT_TRUE(meshlets.empty());
+	EXPECT_EQ(indices[2], 5u);
+}
+
+TEST(MeshletTest, FrustumCulling) {
+	std::cout << "\n=== Testing Meshlet Frustum Culling ===" << std::endl;
+
+	std::vector<TestVertex> vertices;
+	std::vector<uint32_t> indices;
+	auto meshlets = BuildGridMeshlets(vertices, indices);
+
+	MeshletCuller culler;
+	culler.SetBackfaceCulling(false);
+
+	std::vector<DrawIndexedIndirectCommand> draws;
+
+	// Whole grid in view
+	culler.SetView(ViewProjection({ 0.0f, 0.0f, 40.0f }, { 0.0f, 0.0f, 0.0f }), { 0.0f, 0.0f, 40.0f });
+	uint32_t visible = culler.Cull(meshlets, glm::mat4(1.0f), 0, 0, draws);
+	std::cout << "Facing grid: " << visible << "/" << meshlets.size() << " visible" << std::endl;
+	EXPECT_EQ(visible, (uint32_t)meshlets.size());
+
+	// Looking away from the grid
+	draws.clear();
+	culler.SetView(ViewProjection({ 0.0f, 0.0f, 40.0f }, { 0.0f, 0.0f, 80.0f }), { 0.0f, 0.0f, 40.0f });
+	visible = culler.Cull(meshlets, glm::mat4(1.0f), 0, 0, draws);
+	std::cout << "Looking away: " << visible << "/" << meshlets.size() << " visible" << std::endl;
+	EXPECT_EQ(visible, 0u);
+	EXPECT_TRUE(draws.empty());
+
+	// Narrow view onto one corner
+	draws.clear();
+	culler.SetView(ViewProjection({ 12.0f, 12.0f, 5.0f }, { 12.0f, 12.0f, 0.0f }, 30.0f), { 12.0f, 12.0f, 5.0f });
+	visible = culler.Cull(meshlets, glm::mat4(1.0f), 0, 0, draws);
+	std::cout << "Corner view: " << visible << "/" << meshlets.size() << " visible" << std::endl;
+	EXPECT_GT(visible, 0u);
+	EXPECT_LT(visible, (uint32_t)meshlets.size());
+
+	// Moving the mesh out of the view culls it as well
+	draws.clear();
+	culler.SetView(ViewProjection({ 0.0f, 0.0f, 40.0f }, { 0.0f, 0.0f, 0.0f }), { 0.0f, 0.0f, 40.0f });
+	visible = culler.Cull(meshlets, glm::translate(glm::mat4(1.0f), { 500.0f, 0.0f, 0.0f }), 0, 0, draws);
+	EXPECT_EQ(visible, 0u);
+}
+
+TEST(MeshletTest, BackfaceConeCulling) {
+	std::cout << "\n=== Testing Meshlet Cone Culling ===" << std::endl;
+
+	std::vector<TestVertex> vertices;
+	std::vector<uint32_t> indices;
+	auto meshlets = BuildGridMeshlets(vertices, indices);
+
+	for (const Meshlet& meshlet : meshlets)
+		EXPECT_LT(meshlet.ConeCutoff, 0.01f); // Flat grid, cone collapses to the plane normal
+
+	MeshletCuller culler;
+	culler.SetFrustumCulling(false);
+
+	std::vector<DrawIndexedIndirectCommand> draws;
+
+	culler.SetView(ViewProjection({ 0.0f, 0.0f, 50.0f }, { 0.0f, 0.0f, 0.0f }), { 0.0f, 0.0f, 50.0f });
+	uint32_t visible = culler.Cull(meshlets, glm::mat4(1.0f), 0, 0, draws);
+	std::cout << "Front side: " << visible << "/" << meshlets.size() << " visible" << std::endl;
+	EXPECT_EQ(visible, (uint32_t)meshlets.size());
+
+	draws.clear();
+	culler.SetView(ViewProjection({ 0.0f, 0.0f, -50.0f }, { 0.0f, 0.0f, 0.0f }), { 0.0f, 0.0f, -50.0f });
+	visible = culler.Cull(meshlets, glm::mat4(1.0f), 0, 0, draws);
+	std::cout << "Back side: " << visible << "/" << meshlets.size() << " visible" << std::endl;
+	EXPECT_EQ(visible, 0u);
+
+	// Non-uniform scale disables cone culling rather than culling incorrectly
+	draws.clear();
+	visible = culler.Cull(meshlets, glm::scale(glm::mat4(1.0f), { 1.0f, 4.0f, 1.0f }), 0, 0, draws);
+	EXPECT_EQ(visible, (uint32_t)meshlets.size());
+}
+
+TEST(MeshletTest, MergesAdjacentRanges) {
+	std::cout << "\n=== Testing Draw Range Merging ===" << std::endl;
+
+	std::vector<TestVertex> vertices;
+	std::vector<uint32_t> indices;
+	auto meshlets = BuildGridMeshlets(vertices, indices);
+
+	MeshletCuller culler;
+	culler.SetFrustumCulling(false);
+	culler.SetBackfaceCulling(false);
+
+	std::vector<DrawIndexedIndirectCommand> draws;
+	uint32_t visible = culler.Cull(meshlets, glm::mat4(1.0f), 120, 7, draws);
+
+	std::cout << visible << " visible meshlets merged into " << draws.size() << " draw(s)" << std::endl;
+	EXPECT_EQ(visible, (uint32_t)meshlets.size());
+	ASSERT_EQ(draws.size(), 1u);
+	EXPECT_EQ(draws[0].FirstIndex, 120u);
+	EXPECT_EQ(draws[0].IndexCount, (uint32_t)indices.size());
+	EXPECT_EQ(draws[0].VertexOffset, 7);
+	EXPECT_EQ(draws[0].InstanceCount, 1u);
+}
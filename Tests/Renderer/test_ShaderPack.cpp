@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "Zenith/Core/Log.hpp"
+#include "Zenith/Renderer/API/Vulkan/ShaderCompiler/VulkanShaderPackBuilder.hpp"
+#include "Zenith/Renderer/API/Vulkan/ShaderPack/VulkanShaderPack.hpp"
+#include "Zenith/Renderer/API/Vulkan/ShaderPack/VulkanShaderPackWriter.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+using namespace Zenith;
+
+namespace {
+
+	std::map<VkShaderStageFlagBits, std::vector<uint32_t>> MakeShaderData(uint32_t seed)
+	{
+		std::map<VkShaderStageFlagBits, std::vector<uint32_t>> shaderData;
+		shaderData[VK_SHADER_STAGE_VERTEX_BIT] = { 0x07230203, seed, seed + 1 };
+		shaderData[VK_SHADER_STAGE_FRAGMENT_BIT] = { 0x07230203, seed * 3 };
+		return shaderData;
+	}
+
+	VulkanShader::ReflectionData MakeReflectionData(uint32_t size)
+	{
+		VulkanShader::ReflectionData reflectionData;
+		auto& uniformBuffer = reflectionData.ShaderDescriptorSets.emplace_back().UniformBuffers[0];
+		uniformBuffer.Name = "Camera";
+		uniformBuffer.Size = size;
+		reflectionData.PushConstantRanges.push_back({ VK_SHADER_STAGE_VERTEX_BIT, 0, 64 });
+		return reflectionData;
+	}
+
+}
+
+TEST(ShaderPackTest, WriteAndLookupVariants) {
+	std::cout << "\n=== Testing Shader Pack Write + Lookup ===" << std::endl;
+
+	const std::filesystem::path packPath = std::filesystem::temp_directory_path() / "ZenithTest_Shaders.zsp";
+	const uint64_t fogKey = Shader::GetVariantKey({ { "USE_FOG", "1" } });
+
+	{
+		VulkanShaderPackWriter writer;
+		for (uint32_t i = 0; i < 50; i++)
+		{
+			const std::string path = "Resources/Shaders/Shader" + std::to_string(i) + ".glsl";
+			writer.AddShader(path, 0, { "USE_FOG", "__ZN_SHADOWS" }, MakeShaderData(i), MakeReflectionData(i));
+			writer.AddShader(path, fogKey, { "USE_FOG", "__ZN_SHADOWS" }, MakeShaderData(i + 1000), MakeReflectionData(i + 1000));
+		}
+		EXPECT_EQ(writer.GetShaderCount(), 100u);
+		ASSERT_TRUE(writer.Write(packPath));
+	}
+
+	Ref<VulkanShaderPack> pack = VulkanShaderPack::Open(packPath);
+	ASSERT_TRUE(pack);
+	EXPECT_EQ(pack->GetShaderCount(), 100u);
+
+	// Paths are normalized, so the pack finds shaders however the runtime spells them
+	const ShaderPackFile::Entry* entry = pack->GetEntry("Resources/Shaders/../Shaders/Shader7.glsl", fogKey);
+	ASSERT_NE(entry, nullptr);
+	EXPECT_EQ(pack->GetShaderPath(*entry), "Resources/Shaders/Shader7.glsl");
+	EXPECT_EQ(pack->GetMacros(*entry), (std::unordered_set<std::string>{ "USE_FOG", "__ZN_SHADOWS" }));
+	EXPECT_EQ(pack->ReadShaderData(*entry), MakeShaderData(1007));
+
+	const VulkanShader::ReflectionData reflectionData = pack->ReadReflectionData(*entry);
+	ASSERT_EQ(reflectionData.ShaderDescriptorSets.size(), 1u);
+	EXPECT_EQ(reflectionData.ShaderDescriptorSets[0].UniformBuffers.at(0).Name, "Camera");
+	EXPECT_EQ(reflectionData.ShaderDescriptorSets[0].UniformBuffers.at(0).Size, 1007u);
+	ASSERT_EQ(reflectionData.PushConstantRanges.size(), 1u);
+	EXPECT_EQ(reflectionData.PushConstantRanges[0].Size, 64u);
+
+	EXPECT_TRUE(pack->Contains("Resources/Shaders/Shader7.glsl", 0));
+	EXPECT_FALSE(pack->Contains("Resources/Shaders/Shader7.glsl", fogKey + 1));
+	EXPECT_FALSE(pack->Contains("Resources/Shaders/Missing.glsl", 0));
+
+	pack = nullptr;
+	std::filesystem::remove(packPath);
+}
+
+TEST(ShaderPackTest, RejectsInvalidFiles) {
+	std::cout << "\n=== Testing Shader Pack Validation ===" << std::endl;
+
+	const std::filesystem::path packPath = std::filesystem::temp_directory_path() / "ZenithTest_Invalid.zsp";
+	{
+		FILE* file = fopen(packPath.string().c_str(), "wb");
+		ASSERT_TRUE(file);
+		const char data[] = "ZNSP but not really a shader pack";
+		fwrite(data, 1, sizeof(data), file);
+		fclose(file);
+	}
+
+	EXPECT_FALSE(VulkanShaderPack::Open(packPath));
+	EXPECT_FALSE(VulkanShaderPack::Open(std::filesystem::temp_directory_path() / "ZenithTest_Missing.zsp"));
+
+	std::filesystem::remove(packPath);
+}
+
+TEST(ShaderPackTest, PacksEngineMacroVariants) {
+	std::cout << "\n=== Testing Shader Pack Engine Macro Variants ===" << std::endl;
+
+	if (!Log::GetCoreLogger())
+		Log::Init();
+
+	// Built like Zenith-ShaderPacker does from the editor directory, the compile cache goes to a directory of its own
+	const std::filesystem::path workingDirectory = std::filesystem::current_path();
+	const std::filesystem::path buildDirectory = std::filesystem::temp_directory_path() / "ZenithTest_ShaderPackBuild";
+	const std::filesystem::path shaderDirectory = std::filesystem::path(ZN_TEST_EDITOR_DIRECTORY) / "Resources/Shaders";
+	std::filesystem::remove_all(buildDirectory);
+	std::filesystem::create_directories(buildDirectory / "Resources/Shaders");
+	std::filesystem::copy(shaderDirectory / "Include", buildDirectory / "Resources/Shaders/Include", std::filesystem::copy_options::recursive);
+	std::filesystem::copy_file(shaderDirectory / "BasicMesh.glsl", buildDirectory / "Resources/Shaders/BasicMesh.glsl");
+	std::filesystem::current_path(buildDirectory);
+
+	const std::filesystem::path shaderPath = "Resources/Shaders/BasicMesh.glsl";
+	const bool built = VulkanShaderPackBuilder::Build({ shaderPath }, "Shaders.zsp");
+	Ref<VulkanShaderPack> pack = built ? VulkanShaderPack::Open("Shaders.zsp") : nullptr;
+
+	std::filesystem::current_path(workingDirectory);
+
+	ASSERT_TRUE(built);
+	ASSERT_TRUE(pack);
+
+	// The renderer asks for the variant with the macros it set, __ZN_BINDLESS on devices with descriptor indexing
+	const uint64_t bindlessKey = Shader::GetVariantKey({ { "__ZN_BINDLESS", "1" } });
+	EXPECT_TRUE(pack->Contains(shaderPath, 0));
+	EXPECT_TRUE(pack->Contains(shaderPath, bindlessKey));
+	EXPECT_EQ(pack->GetShaderCount(), 2u);
+
+	// Only the bindless variant has the material index push constant
+	EXPECT_TRUE(pack->ReadReflectionData(*pack->GetEntry(shaderPath, 0)).PushConstantRanges.empty());
+	EXPECT_FALSE(pack->ReadReflectionData(*pack->GetEntry(shaderPath, bindlessKey)).PushConstantRanges.empty());
+
+	pack = nullptr;
+	std::filesystem::remove_all(buildDirectory);
+}
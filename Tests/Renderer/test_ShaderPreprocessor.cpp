@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "Zenith/Renderer/API/Vulkan/ShaderCompiler/ShaderPreprocessing/ShaderPreprocessor.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace Zenith;
+
+namespace {
+
+	size_t CountLines(const std::string& source)
+	{
+		return std::count(source.begin(), source.end(), '\n');
+	}
+
+}
+
+TEST(ShaderPreprocessorTest, SplitsStagesAndStripsComments) {
+	std::cout << "\n=== Testing Shader Stage Splitting ===" << std::endl;
+
+	const std::string source =
+		"// Simple shader\n"
+		"#version 450 core\n"
+		"#pragma stage : vert\n"
+		"/* multi\n"
+		"   line */\n"
+		"#include \"Common.glslh\"\n"
+		"#ifdef __ZN_SHADOWS\n"
+		"#endif\n"
+		"void main() {} // vertex\n"
+		"#version 450 core\n"
+		"#pragma stage : frag\n"
+		"#pragma keywords : USE_FOG USE_SSAO\n"
+		"#include <Lighting.glslh>\n"
+		"void main() {}\n";
+
+	std::unordered_set<std::string> specialMacros;
+	std::vector<std::string> includes;
+	auto stages = ShaderPreprocessor::PreprocessShader<ShaderUtils::SourceLang::GLSL>(source, specialMacros, &includes);
+
+	ASSERT_EQ(stages.size(), 2u);
+	const std::string& vertex = stages.at(VK_SHADER_STAGE_VERTEX_BIT);
+	const std::string& fragment = stages.at(VK_SHADER_STAGE_FRAGMENT_BIT);
+
+	EXPECT_EQ(vertex.find("//"), std::string::npos);
+	EXPECT_EQ(vertex.find("multi"), std::string::npos);
+	EXPECT_EQ(vertex.find("#pragma stage : frag"), std::string::npos);
+	EXPECT_NE(fragment.find("#pragma stage : frag"), std::string::npos);
+	EXPECT_EQ(fragment.find("#pragma stage : vert"), std::string::npos);
+
+	// Comments keep their line breaks, the fragment stage continues the line numbers of the file
+	EXPECT_EQ(CountLines(vertex), 9u);
+	EXPECT_EQ(fragment.rfind("#version", 0), 0u);
+	EXPECT_NE(fragment.find("#line "), std::string::npos);
+
+	EXPECT_TRUE(specialMacros.contains("__ZN_SHADOWS"));
+	EXPECT_TRUE(specialMacros.contains("USE_FOG"));
+	EXPECT_TRUE(specialMacros.contains("USE_SSAO"));
+
+	ASSERT_EQ(includes.size(), 2u);
+	EXPECT_EQ(includes[0], "Common.glslh");
+	EXPECT_EQ(includes[1], "Lighting.glslh");
+}
+
+TEST(ShaderPreprocessorTest, HeaderGuardAndStages) {
+	std::cout << "\n=== Testing Header Preprocessing ===" << std::endl;
+
+	const std::string contents =
+		"#pragma once\n"
+		"#pragma stage : vert\n"
+		"int VertexOnly; // comment\n"
+		"#pragma stage : frag\n"
+		"#define SAMPLE(x) __ZN_SAMPLER(x)\n";
+
+	PreprocessedHeader header = ShaderPreprocessor::PreprocessHeader<ShaderUtils::SourceLang::GLSL>(contents);
+	EXPECT_TRUE(header.IsGuarded);
+	EXPECT_EQ(header.Stages, VkShaderStageFlagBits(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT));
+	EXPECT_EQ(header.Source.find("#pragma"), std::string::npos);
+	EXPECT_EQ(header.Source.find("comment"), std::string::npos);
+	EXPECT_NE(header.Source.find("#ifdef __VERTEX_STAGE__"), std::string::npos);
+	EXPECT_NE(header.Source.find("#endif\n#ifdef __FRAGMENT_STAGE__"), std::string::npos);
+	EXPECT_TRUE(header.SpecialMacros.contains("__ZN_SAMPLER"));
+
+	// HLSL keeps the guard for dxc
+	PreprocessedHeader hlslHeader = ShaderPreprocessor::PreprocessHeader<ShaderUtils::SourceLang::HLSL>("#pragma once\nint Value;\n");
+	EXPECT_TRUE(hlslHeader.IsGuarded);
+	EXPECT_NE(hlslHeader.Source.find("#pragma once"), std::string::npos);
+}
+
+TEST(ShaderPreprocessorTest, IncludeCacheAndDependencies) {
+	std::cout << "\n=== Testing Include Cache And Dependency Graph ===" << std::endl;
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "ZenithShaderPreprocessorTest";
+	std::filesystem::create_directories(directory);
+	const std::filesystem::path headerPath = directory / "Common.glslh";
+	{
+		std::ofstream(headerPath) << "#pragma once\nint A;\n";
+	}
+
+	auto first = ShaderIncludeCache::Get<ShaderUtils::SourceLang::GLSL>(headerPath);
+	auto second = ShaderIncludeCache::Get<ShaderUtils::SourceLang::GLSL>(headerPath);
+	ASSERT_TRUE(first);
+	EXPECT_EQ(first, second);
+
+	{
+		std::ofstream(headerPath) << "#pragma once\nint A;\nint B;\n";
+	}
+	auto changed = ShaderIncludeCache::Get<ShaderUtils::SourceLang::GLSL>(headerPath);
+	ASSERT_TRUE(changed);
+	EXPECT_NE(changed, first);
+	EXPECT_NE(changed->Source.find("int B;"), std::string::npos);
+	EXPECT_FALSE(ShaderIncludeCache::Get<ShaderUtils::SourceLang::GLSL>(directory / "Missing.glslh"));
+
+	const std::filesystem::path shaderA = directory / "A.glsl";
+	const std::filesystem::path shaderB = directory / "B.glsl";
+	ShaderDependencyGraph::SetIncludes(shaderA, { headerPath });
+	ShaderDependencyGraph::SetIncludes(shaderB, { headerPath });
+	EXPECT_EQ(ShaderDependencyGraph::GetDependentShaders(headerPath).size(), 2u);
+	EXPECT_EQ(ShaderDependencyGraph::GetDependentShaders(shaderA).size(), 1u);
+
+	ShaderDependencyGraph::SetIncludes(shaderB, {});
+	EXPECT_EQ(ShaderDependencyGraph::GetDependentShaders(headerPath).size(), 1u);
+	ShaderDependencyGraph::Remove(shaderA);
+	EXPECT_TRUE(ShaderDependencyGraph::GetDependentShaders(headerPath).empty());
+
+	ShaderIncludeCache::Clear();
+	std::filesystem::remove_all(directory);
+}
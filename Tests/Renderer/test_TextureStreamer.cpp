@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "Zenith/Renderer/TextureStreamer.hpp"
+
+#include <iostream>
+
+using namespace Zenith;
+
+namespace {
+
+	StreamedTexture MakeTexture(uint32_t size, uint32_t initialMip, uint64_t lastUsedFrame)
+	{
+		StreamedTexture texture;
+		texture.Format = ImageFormat::RGBA;
+		texture.Width = texture.Height = size;
+		texture.MipCount = Utils::CalculateMipCount(size, size);
+		texture.InitialMip = initialMip;
+		texture.ResidentMip = initialMip;
+		texture.TargetMip = 0;
+		texture.LastUsedFrame = lastUsedFrame;
+		return texture;
+	}
+
+}
+
+TEST(TextureStreamerTest, RequiredMip) {
+	std::cout << "\n=== Testing Texture Streaming Required Mip ===" << std::endl;
+
+	// One texel per pixel
+	EXPECT_EQ(TextureStreamer::CalculateRequiredMip(1024, 1.0f, 1024.0f), 0u);
+
+	// Every mip halves the texels per pixel, partial mips round to the more detailed one
+	EXPECT_EQ(TextureStreamer::CalculateRequiredMip(1024, 1.0f, 512.0f), 1u);
+	EXPECT_EQ(TextureStreamer::CalculateRequiredMip(1024, 1.0f, 256.0f), 2u);
+	EXPECT_EQ(TextureStreamer::CalculateRequiredMip(1024, 1.0f, 300.0f), 1u);
+	EXPECT_EQ(TextureStreamer::CalculateRequiredMip(1024, 1.0f, 1.0f), 10u);
+
+	// Tiling twice is as dense as half the pixels
+	EXPECT_EQ(TextureStreamer::CalculateRequiredMip(1024, 2.0f, 512.0f), 2u);
+
+	// Magnified
+	EXPECT_EQ(TextureStreamer::CalculateRequiredMip(1024, 1.0f, 4096.0f), 0u);
+
+	// Nothing on screen, or no texture coordinates
+	EXPECT_EQ(TextureStreamer::CalculateRequiredMip(1024, 1.0f, 0.0f), UINT32_MAX);
+	EXPECT_EQ(TextureStreamer::CalculateRequiredMip(1024, 0.0f, 1024.0f), UINT32_MAX);
+}
+
+TEST(TextureStreamerTest, FitsToBudgetLeastRecentlyDrawnFirst) {
+	std::cout << "\n=== Testing Texture Streaming Budget ===" << std::endl;
+
+	StreamedTexture oldest = MakeTexture(64, 3, 10);
+	StreamedTexture older = MakeTexture(64, 3, 20);
+	StreamedTexture newest = MakeTexture(64, 3, 30);
+	const std::vector<StreamedTexture*> textures = { &older, &newest, &oldest };
+
+	const uint64_t fullSize = oldest.GetSize(0);
+	const uint64_t total = 3 * fullSize;
+
+	// Everything fits
+	EXPECT_EQ(TextureStreamer::FitToBudget(textures, total), total);
+	EXPECT_EQ(oldest.TargetMip, 0u);
+	EXPECT_EQ(older.TargetMip, 0u);
+	EXPECT_EQ(newest.TargetMip, 0u);
+
+	// One byte over drops a single mip of the least recently drawn texture
+	EXPECT_EQ(TextureStreamer::FitToBudget(textures, total - 1), total - oldest.GetLevelSize(0));
+	EXPECT_EQ(oldest.TargetMip, 1u);
+	EXPECT_EQ(older.TargetMip, 0u);
+	EXPECT_EQ(newest.TargetMip, 0u);
+
+	// The oldest texture goes down to its initial mip before the next one loses anything
+	uint64_t budget = 2 * fullSize + oldest.GetSize(3);
+	EXPECT_EQ(TextureStreamer::FitToBudget(textures, budget), budget);
+	EXPECT_EQ(oldest.TargetMip, 3u);
+	EXPECT_EQ(older.TargetMip, 0u);
+	EXPECT_EQ(newest.TargetMip, 0u);
+
+	budget -= 1;
+	EXPECT_LE(TextureStreamer::FitToBudget(textures, budget), budget);
+	EXPECT_EQ(oldest.TargetMip, 3u);
+	EXPECT_EQ(older.TargetMip, 1u);
+	EXPECT_EQ(newest.TargetMip, 0u);
+
+	// Initial mips are never evicted, even when they alone are over budget
+	EXPECT_EQ(TextureStreamer::FitToBudget(textures, 0), 3 * oldest.GetSize(3));
+	EXPECT_EQ(oldest.TargetMip, 3u);
+	EXPECT_EQ(older.TargetMip, 3u);
+	EXPECT_EQ(newest.TargetMip, 3u);
+}
+
+TEST(TextureStreamerTest, FitsToBudgetLargestMipFirst) {
+	std::cout << "\n=== Testing Texture Streaming Budget Ties ===" << std::endl;
+
+	// Drawn in the same frame: the larger texture gives up its top mip first
+	StreamedTexture largeTexture = MakeTexture(128, 4, 10);
+	StreamedTexture smallTexture = MakeTexture(64, 4, 10);
+	const std::vector<StreamedTexture*> textures = { &smallTexture, &largeTexture };
+
+	const uint64_t total = largeTexture.GetSize(0) + smallTexture.GetSize(0);
+	TextureStreamer::FitToBudget(textures, total - 1);
+	EXPECT_EQ(largeTexture.TargetMip, 1u);
+	EXPECT_EQ(smallTexture.TargetMip, 0u);
+
+	// Now both have a 64x64 top mip, either may go next but only one of them
+	TextureStreamer::FitToBudget(textures, total - largeTexture.GetLevelSize(0) - 1);
+	EXPECT_EQ(largeTexture.TargetMip + smallTexture.TargetMip, 2u);
+}
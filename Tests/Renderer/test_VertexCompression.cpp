@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "Zenith/Renderer/VertexCompression.hpp"
+
+#include <cmath>
+#include <vector>
+#include <iostream>
+
+using namespace Zenith;
+
+namespace {
+
+	std::vector<glm::vec3> SampleDirections()
+	{
+		std::vector<glm::vec3> directions = {
+			{ 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f },
+			{ 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f },
+			{ 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }
+		};
+
+		// Fibonacci sphere
+		const uint32_t count = 512;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			float y = 1.0f - 2.0f * (i + 0.5f) / count;
+			float radius = std::sqrt(1.0f - y * y);
+			float phi = i * 2.39996323f;
+			directions.push_back({ std::cos(phi) * radius, y, std::sin(phi) * radius });
+		}
+		return directions;
+	}
+
+	float AngleDegrees(const glm::vec3& a, const glm::vec3& b)
+	{
+		return glm::degrees(std::acos(glm::clamp(glm::dot(glm::normalize(a), glm::normalize(b)), -1.0f, 1.0f)));
+	}
+
+}
+
+TEST(VertexCompressionTest, OctahedralNormals) {
+	std::cout << "\n=== Testing Octahedral Normal Encoding ===" << std::endl;
+
+	float maxError = 0.0f;
+	for (const glm::vec3& direction : SampleDirections())
+	{
+		CompactVertex vertex = VertexCompression::PackCompact({}, direction, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, {});
+		maxError = std::max(maxError, AngleDegrees(direction, VertexCompression::UnpackNormal(vertex.Normal)));
+	}
+
+	std::cout << "Max normal error: " << maxError << " degrees" << std::endl;
+	EXPECT_LT(maxError, 0.05f);
+}
+
+TEST(VertexCompressionTest, TangentWithBitangentSign) {
+	std::cout << "\n=== Testing Tangent + Bitangent Sign Encoding ===" << std::endl;
+
+	float maxError = 0.0f;
+	for (const glm::vec3& tangent : SampleDirections())
+	{
+		for (float sign : { 1.0f, -1.0f })
+		{
+			glm::vec4 decoded = VertexCompression::DecodeTangent(VertexCompression::EncodeTangent(tangent, sign));
+			EXPECT_EQ(decoded.w, sign);
+			maxError = std::max(maxError, AngleDegrees(tangent, glm::vec3(decoded)));
+		}
+	}
+	std::cout << "Max tangent error (unquantized): " << maxError << " degrees" << std::endl;
+	EXPECT_LT(maxError, 0.05f);
+
+	// Mirrored UVs: the bitangent points against cross(N, T)
+	glm::vec3 normal(0.0f, 0.0f, 1.0f), tangent(1.0f, 0.0f, 0.0f);
+	CompactVertex mirrored = VertexCompression::PackCompact({}, normal, tangent, { 0.0f, -1.0f, 0.0f }, {});
+	CompactVertex regular = VertexCompression::PackCompact({}, normal, tangent, { 0.0f, 1.0f, 0.0f }, {});
+
+	glm::vec4 mirroredTangent = VertexCompression::UnpackTangent(mirrored.Tangent);
+	glm::vec4 regularTangent = VertexCompression::UnpackTangent(regular.Tangent);
+	EXPECT_EQ(mirroredTangent.w, -1.0f);
+	EXPECT_EQ(regularTangent.w, 1.0f);
+	EXPECT_LT(AngleDegrees(tangent, glm::vec3(mirroredTangent)), 0.05f);
+	EXPECT_LT(AngleDegrees(tangent, glm::vec3(regularTangent)), 0.05f);
+}
+
+TEST(VertexCompressionTest, QuantizedPositions) {
+	std::cout << "\n=== Testing Quantized Positions ===" << std::endl;
+
+	const glm::vec3 offset(-10.0f, 2.0f, 0.0f);
+	const glm::vec3 scale(20.0f, 5.0f, 0.0f); // Flat along Z
+
+	float maxError = 0.0f;
+	for (int i = 0; i <= 100; i++)
+	{
+		float t = i / 100.0f;
+		glm::vec3 position = offset + glm::vec3(t, 1.0f - t, 0.0f) * scale;
+
+		QuantizedVertex vertex = VertexCompression::PackQuantized(position, { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, {}, offset, scale);
+		glm::vec3 decoded = VertexCompression::UnpackPosition(vertex, offset, scale);
+
+		maxError = std::max(maxError, glm::length(decoded - position));
+		EXPECT_EQ(decoded.z, 0.0f);
+	}
+
+	std::cout << "Max position error: " << maxError << " (bounds extent " << scale.x << ")" << std::endl;
+	EXPECT_LE(maxError, glm::length(scale) / 65535.0f);
+}
+
+TEST(VertexCompressionTest, TexcoordsAndStrides) {
+	std::cout << "\n=== Testing Texcoords And Strides ===" << std::endl;
+
+	for (glm::vec2 uv : { glm::vec2(0.0f, 1.0f), glm::vec2(0.5f, 0.25f), glm::vec2(-3.5f, 12.0f) })
+	{
+		CompactVertex vertex = VertexCompression::PackCompact({}, { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, uv);
+		glm::vec2 decoded = VertexCompression::UnpackTexcoord(vertex.Texcoord);
+		EXPECT_NEAR(decoded.x, uv.x, 0.01f);
+		EXPECT_NEAR(decoded.y, uv.y, 0.01f);
+	}
+
+	const uint32_t standardStride = 56;
+	std::cout << "Standard: " << standardStride << " bytes, Compact: " << VertexCompression::GetPackedStride(VertexFormat::Compact)
+		<< " bytes, CompactQuantized: " << VertexCompression::GetPackedStride(VertexFormat::CompactQuantized) << " bytes" << std::endl;
+
+	EXPECT_EQ(VertexCompression::GetPackedStride(VertexFormat::Compact), 24u);
+	EXPECT_EQ(VertexCompression::GetPackedStride(VertexFormat::CompactQuantized), 20u);
+}
@@ -0,0 +1,35 @@
+#include "Zenith/Asset/AssetPack/AssetPackBuilder.hpp"
+#include "Zenith/Core/Log.hpp"
+#include "Zenith/Utilities/CommandLineParser.hpp"
+
+#include <iostream>
+
+// Usage: Zenith-AssetPacker --project <file.zproj> --output <file.zpak> [--alignment <bytes>] [--compression lz|none]
+int main(int argc, char** argv)
+{
+	Zenith::CommandLineParser cli(argc, argv);
+
+	const std::string project = cli.GetOptionValue("project", "");
+	const std::string output = cli.GetOptionValue("output", "");
+	if (cli.HasErrors() || project.empty() || output.empty())
+	{
+		std::cerr << "Usage: Zenith-AssetPacker --project <file.zproj> --output <file.zpak> [--alignment <bytes>] [--compression lz|none]" << std::endl;
+		return 1;
+	}
+
+	Zenith::AssetPackSettings settings;
+	settings.Alignment = static_cast<uint32_t>(std::stoul(cli.GetOptionValue("alignment", std::to_string(settings.Alignment))));
+	settings.Compress = cli.GetOptionValue("compression", "lz") != "none";
+
+	if (settings.Alignment == 0 || (settings.Alignment & (settings.Alignment - 1)) != 0)
+	{
+		std::cerr << "--alignment must be a power of two" << std::endl;
+		return 1;
+	}
+
+	Zenith::Log::Init();
+	const bool success = Zenith::AssetPackBuilder::BuildFromProject(project, output, settings);
+	Zenith::Log::Shutdown();
+
+	return success ? 0 : 1;
+}
@@ -0,0 +1,35 @@
+#include "Zenith/Core/Log.hpp"
+#include "Zenith/Renderer/API/Vulkan/ShaderCompiler/VulkanShaderPackBuilder.hpp"
+#include "Zenith/Utilities/CommandLineParser.hpp"
+
+#include <iostream>
+
+// Usage: Zenith-ShaderPacker --shaders <directory> [--shaders <directory>...] --output <file.zsp>
+// Run from the directory the runtime loads shaders from, shaders are looked up by the paths found here.
+int main(int argc, char** argv)
+{
+	Zenith::CommandLineParser cli(argc, argv);
+
+	const std::vector<std::string_view> shaderDirectories = cli.GetOptionValues("shaders");
+	const std::string output = cli.GetOptionValue("output", "");
+	if (cli.HasErrors() || shaderDirectories.empty() || output.empty())
+	{
+		std::cerr << "Usage: Zenith-ShaderPacker --shaders <directory> [--shaders <directory>...] --output <file.zsp>" << std::endl;
+		return 1;
+	}
+
+	Zenith::Log::Init();
+
+	const std::vector<std::filesystem::path> directories(shaderDirectories.begin(), shaderDirectories.end());
+	const std::vector<std::filesystem::path> shaders = Zenith::VulkanShaderPackBuilder::FindShaders(directories);
+
+	bool success = !shaders.empty();
+	if (success)
+		success = Zenith::VulkanShaderPackBuilder::Build(shaders, output);
+	else
+		std::cerr << "No shaders found" << std::endl;
+
+	Zenith::Log::Shutdown();
+
+	return success ? 0 : 1;
+}